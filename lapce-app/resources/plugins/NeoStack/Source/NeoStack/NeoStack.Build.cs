@@ -62,8 +62,15 @@ public class NeoStack : ModuleRules
 				"UMGEditor",
 				// Asset creation
 				"AssetTools",
+				// @-context index
+				"AssetRegistry",
+				"DirectoryWatcher",
 				// Physics (for UPhysicalMaterial)
 				"PhysicsCore",
+				// Viewport and graph capture
+				"LevelEditor",
+				"RenderCore",
+				"RHI",
 				// ... add private dependencies that you statically link with here ...
 			}
 			);
@@ -4,6 +4,23 @@
 #include "NeoStackStyle.h"
 #include "NeoStackCommands.h"
 #include "SNeoStackWidget.h"
+#include "NeoStackConversation.h"
+#include "NeoStackContextIndex.h"
+#include "NeoStackProjectCatalog.h"
+#include "NeoStackIndexArtifacts.h"
+#include "NeoStackLogCapture.h"
+#include "NeoStackMentionPrefetcher.h"
+#include "NeoStackSettings.h"
+#include "Tools/NeoStackToolRegistry.h"
+#include "Tools/NodeSpawnerIndex.h"
+#include "Tools/CodeSearchIndex.h"
+#include "Tools/AssetReadCache.h"
+#include "Tools/AssetDependencyGraph.h"
+#include "Tools/NodeNameRegistry.h"
+#include "Tools/ToolResultCache.h"
+#include "Tools/DataTableColumnLayout.h"
+#include "Tools/PropertyPathCache.h"
+#include "Tools/TurnCheckpoint.h"
 #include "LevelEditor.h"
 #include "Widgets/Docking/SDockTab.h"
 #include "ToolMenus.h"
@@ -15,7 +32,15 @@ static const FName NeoStackTabName("NeoStack");
 void FNeoStackModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_StartupModule);
+	const double StartTime = FPlatformTime::Seconds();
 	
+	// Early, so read_log sees the startup lines GLog still has in its backlog
+	FNeoStackLogCapture::Get().Install();
+
+	// Before anything loads an index file; a no-op unless a shared path is set and a file is missing
+	FNeoStackIndexArtifacts::Pull(FNeoStackIndexArtifacts::GetSharedDir());
+
 	FNeoStackStyle::Initialize();
 	FNeoStackStyle::ReloadTextures();
 
@@ -33,6 +58,18 @@ void FNeoStackModule::StartupModule()
 	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(NeoStackTabName, FOnSpawnTab::CreateRaw(this, &FNeoStackModule::OnSpawnPluginTab))
 		.SetDisplayName(LOCTEXT("FNeoStackTabTitle", "NeoStack"))
 		.SetMenuType(ETabSpawnerMenuType::Hidden);
+
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	if (Settings && !Settings->bLazyInitialization)
+	{
+		// Eager mode: pay for tools and conversation metadata now rather than on first use
+		FNeoStackToolRegistry::Get();
+		FNeoStackConversationManager::Get();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Module startup took %.1f ms (%s initialization)"),
+		(FPlatformTime::Seconds() - StartTime) * 1000.0,
+		Settings && !Settings->bLazyInitialization ? TEXT("eager") : TEXT("lazy"));
 }
 
 void FNeoStackModule::ShutdownModule()
@@ -49,6 +86,34 @@ void FNeoStackModule::ShutdownModule()
 	FNeoStackCommands::Unregister();
 
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(NeoStackTabName);
+
+	// Before the registry fails the prefetches' tool calls
+	FNeoStackMentionPrefetcher::Get().Shutdown();
+
+	// Running tool tasks may still use the indexes below (never created with lazy initialization)
+	if (FNeoStackToolRegistry::IsCreated())
+	{
+		FNeoStackToolRegistry::Get().Shutdown();
+	}
+
+	FNeoStackContextIndex::Get().Shutdown();
+	FNeoStackProjectCatalog::Get().Shutdown();
+	FNodeSpawnerIndex::Get().Shutdown();
+	FCodeSearchIndex::Get().Shutdown();
+	FAssetReadCache::Get().Shutdown();
+	FAssetDependencyGraph::Get().Shutdown();
+	FToolResultCache::Get().Shutdown();
+	FDataTableColumnLayoutCache::Get().Shutdown();
+	FPropertyPathCache::Get().Shutdown();
+	FNodeNameRegistry::Get().Shutdown();
+	FTurnCheckpoint::Get().Shutdown();
+	FNeoStackLogCapture::Get().Uninstall();
+
+	// Fold the metadata journal back into metadata.json (never created if the tab was never opened)
+	if (FNeoStackConversationManager::IsCreated())
+	{
+		FNeoStackConversationManager::Get().Shutdown();
+	}
 }
 
 TSharedRef<SDockTab> FNeoStackModule::OnSpawnPluginTab(const FSpawnTabArgs& SpawnTabArgs)
@@ -3,17 +3,167 @@
 #include "NeoStackAPIClient.h"
 #include "NeoStackSettings.h"
 #include "NeoStackConversation.h"
+#include "NeoStackBlobStore.h"
+#include "NeoStackToolResultQueue.h"
+#include "NeoStackTokenBudget.h"
+#include "NeoStackStreamRecording.h"
+#include "NeoStackTrace.h"
 #include "UI/SNeoStackChatInput.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Json.h"
 #include "JsonUtilities.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 
-// Static buffer for tracking processed content
-FString FNeoStackAPIClient::LastProcessedContent = TEXT("");
-FString FNeoStackAPIClient::CurrentSessionID = TEXT("");
+namespace
+{
+	/** Given the index of an opening quote, return the index of the closing quote (or Len) */
+	int32 SkipJsonString(const TCHAR* Chars, int32 Len, int32 QuoteIndex)
+	{
+		for (int32 i = QuoteIndex + 1; i < Len; ++i)
+		{
+			if (Chars[i] == TEXT('\\'))
+			{
+				++i;
+			}
+			else if (Chars[i] == TEXT('"'))
+			{
+				return i;
+			}
+		}
+		return Len;
+	}
+
+	/** Given the index of an opening brace, return the index of its matching close (or INDEX_NONE) */
+	int32 FindMatchingBrace(const TCHAR* Chars, int32 Len, int32 OpenIndex)
+	{
+		int32 Depth = 0;
+		for (int32 i = OpenIndex; i < Len; ++i)
+		{
+			const TCHAR C = Chars[i];
+			if (C == TEXT('"'))
+			{
+				i = SkipJsonString(Chars, Len, i);
+			}
+			else if (C == TEXT('{') || C == TEXT('['))
+			{
+				++Depth;
+			}
+			else if ((C == TEXT('}') || C == TEXT(']')) && --Depth == 0)
+			{
+				return i;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * Slice the raw text of a top-level object field out of an event line.
+	 * The line already holds exactly what the backend sent, so display and history
+	 * can use it directly instead of writing the parsed object back out to a string.
+	 */
+	bool FindRawObjectField(const FString& Json, const TCHAR* FieldName, FString& OutRaw)
+	{
+		const TCHAR* Chars = *Json;
+		const int32 Len = Json.Len();
+		const int32 FieldNameLen = FCString::Strlen(FieldName);
+		int32 Depth = 0;
+
+		for (int32 i = 0; i < Len; ++i)
+		{
+			const TCHAR C = Chars[i];
+			if (C == TEXT('"'))
+			{
+				const int32 KeyStart = i + 1;
+				i = SkipJsonString(Chars, Len, i);
+				if (i >= Len)
+				{
+					return false;
+				}
+
+				if (Depth != 1 || i - KeyStart != FieldNameLen || FCString::Strncmp(Chars + KeyStart, FieldName, FieldNameLen) != 0)
+				{
+					continue;
+				}
+
+				int32 ValueStart = i + 1;
+				while (ValueStart < Len && FChar::IsWhitespace(Chars[ValueStart]))
+				{
+					++ValueStart;
+				}
+				if (ValueStart >= Len || Chars[ValueStart] != TEXT(':'))
+				{
+					continue; // A string value that happens to match the name, not a key
+				}
+
+				++ValueStart;
+				while (ValueStart < Len && FChar::IsWhitespace(Chars[ValueStart]))
+				{
+					++ValueStart;
+				}
+				if (ValueStart >= Len || Chars[ValueStart] != TEXT('{'))
+				{
+					return false;
+				}
+
+				const int32 ValueEnd = FindMatchingBrace(Chars, Len, ValueStart);
+				if (ValueEnd == INDEX_NONE)
+				{
+					return false;
+				}
+
+				OutRaw = Json.Mid(ValueStart, ValueEnd - ValueStart + 1);
+				return true;
+			}
+			else if (C == TEXT('{') || C == TEXT('['))
+			{
+				++Depth;
+			}
+			else if (C == TEXT('}') || C == TEXT(']'))
+			{
+				--Depth;
+			}
+		}
+
+		return false;
+	}
+
+	/** Get the args of a tool call event as text, preferring the raw slice over re-serializing */
+	FString GetToolArgsString(const FString& JsonString, const TSharedPtr<FJsonObject>& ArgsObject)
+	{
+		FString ArgsString;
+		if (ArgsObject.IsValid() && !FindRawObjectField(JsonString, TEXT("args"), ArgsString))
+		{
+			TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> ArgsWriter =
+				TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&ArgsString);
+			FJsonSerializer::Serialize(ArgsObject.ToSharedRef(), ArgsWriter);
+		}
+		return ArgsString;
+	}
+}
+
+void FNeoStackStreamSession::Cancel()
+{
+	bCancelled = true;
+	bFinished = true;
+
+	if (ReplayTicker.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ReplayTicker);
+		ReplayTicker.Reset();
+	}
 
-void FNeoStackAPIClient::SendMessage(
+	if (HttpRequest.IsValid())
+	{
+		// Reset first - CancelRequest fires the completion callback synchronously on some platforms
+		FHttpRequestPtr Request = HttpRequest;
+		HttpRequest.Reset();
+		Request->CancelRequest();
+	}
+}
+
+TSharedPtr<FNeoStackStreamSession> FNeoStackAPIClient::SendMessage(
 	const FString& Message,
 	const FString& AgentName,
 	const FString& ModelID,
@@ -28,11 +178,11 @@ void FNeoStackAPIClient::SendMessage(
 {
 	// Delegate to SendMessageWithHistory with empty history
 	TArray<FConversationMessage> EmptyHistory;
-	SendMessageWithHistory(Message, EmptyHistory, AgentName, ModelID,
+	return SendMessageWithHistory(Message, EmptyHistory, AgentName, ModelID,
 		OnContent, OnReasoning, OnToolCall, OnUE5ToolCall, OnToolResult, OnComplete, OnCost, OnError);
 }
 
-void FNeoStackAPIClient::SendMessageWithHistory(
+TSharedPtr<FNeoStackStreamSession> FNeoStackAPIClient::SendMessageWithHistory(
 	const FString& Message,
 	const TArray<FConversationMessage>& History,
 	const FString& AgentName,
@@ -46,143 +196,316 @@ void FNeoStackAPIClient::SendMessageWithHistory(
 	FOnAICost OnCost,
 	FOnAPIError OnError)
 {
-	// Reset buffer for new request
-	LastProcessedContent.Empty();
-
-	// Generate a unique session ID for this request
-	CurrentSessionID = FGuid::NewGuid().ToString();
+	// Each request gets its own stream session (parser, callbacks, session ID)
+	FNeoStackStreamCallbacks Callbacks;
+	Callbacks.OnContent = OnContent;
+	Callbacks.OnReasoning = OnReasoning;
+	Callbacks.OnToolCall = OnToolCall;
+	Callbacks.OnUE5ToolCall = OnUE5ToolCall;
+	Callbacks.OnToolResult = OnToolResult;
+	Callbacks.OnComplete = OnComplete;
+	Callbacks.OnCost = OnCost;
+	Callbacks.OnError = OnError;
+
+	TSharedRef<FNeoStackStreamSession> Session = MakeShared<FNeoStackStreamSession>(FGuid::NewGuid().ToString(), Callbacks);
 
 	// Get settings
 	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
 	if (!Settings)
 	{
 		OnError.ExecuteIfBound(TEXT("Failed to get NeoStack settings"));
-		return;
+		return nullptr;
 	}
 
 	// Validate API key
 	if (Settings->APIKey.IsEmpty())
 	{
 		OnError.ExecuteIfBound(TEXT("API Key not configured. Please set it in Project Settings > Game > NeoStack"));
-		return;
+		return nullptr;
 	}
 
 	// Validate backend URL
 	if (Settings->BackendURL.IsEmpty())
 	{
 		OnError.ExecuteIfBound(TEXT("Backend URL not configured"));
-		return;
+		return nullptr;
 	}
 
-	// Create HTTP request
-	FHttpModule& HttpModule = FHttpModule::Get();
-	TSharedRef<IHttpRequest> Request = HttpModule.CreateRequest();
-
 	// Build JSON payload
 	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
 	JsonObject->SetStringField(TEXT("prompt"), Message);
 	JsonObject->SetStringField(TEXT("agent"), AgentName);
 	JsonObject->SetStringField(TEXT("model"), ModelID);
-	JsonObject->SetStringField(TEXT("session_id"), CurrentSessionID);
+	JsonObject->SetStringField(TEXT("session_id"), Session->GetSessionID());
+
+	// Add conversation history (only the unacknowledged tail in delta mode)
+	AddHistoryToPayload(JsonObject.ToSharedRef(), History, *Session);
+
+	// Add runtime settings (parsed once, reloaded only when the file changes)
+	TSharedPtr<FJsonObject> SettingsObject = BuildSettingsObject(ModelID);
+	if (SettingsObject.IsValid())
+	{
+		JsonObject->SetObjectField(TEXT("settings"), SettingsObject);
+	}
 
-	// Add conversation history if present
-	if (History.Num() > 0)
+	Session->Payload = JsonObject;
+	return SendPayload(Session);
+}
+
+TSet<FString> FNeoStackAPIClient::AcknowledgedHistoryIDs;
+TSet<FString> FNeoStackAPIClient::UploadedImageHashes;
+TSet<FString> FNeoStackAPIClient::CompactedHistoryIDs;
+
+TSharedPtr<FJsonObject> FNeoStackAPIClient::BuildSettingsObject(const FString& ModelID)
+{
+	// settings.json is written by the settings panel; parse it once and only again after it changed on disk
+	static TSharedPtr<FJsonObject> RuntimeSettings;
+	static FDateTime CachedTimeStamp = FDateTime::MinValue();
+	static int64 CachedSize = INDEX_NONE;
+
+	const FString SettingsPath = FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("settings.json");
+	const FDateTime TimeStamp = IFileManager::Get().GetTimeStamp(*SettingsPath);
+	const int64 Size = IFileManager::Get().FileSize(*SettingsPath);
+
+	if (TimeStamp != CachedTimeStamp || Size != CachedSize)
 	{
-		TArray<TSharedPtr<FJsonValue>> MessagesArray;
-		for (const FConversationMessage& Msg : History)
+		CachedTimeStamp = TimeStamp;
+		CachedSize = Size;
+		RuntimeSettings.Reset();
+
+		FString SettingsJson;
+		if (Size >= 0 && FFileHelper::LoadFileToString(SettingsJson, *SettingsPath))
 		{
-			MessagesArray.Add(MakeShareable(new FJsonValueObject(Msg.ToJson())));
+			TSharedRef<TJsonReader<>> SettingsReader = TJsonReaderFactory<>::Create(SettingsJson);
+			if (!FJsonSerializer::Deserialize(SettingsReader, RuntimeSettings))
+			{
+				RuntimeSettings.Reset();
+			}
 		}
-		JsonObject->SetArrayField(TEXT("messages"), MessagesArray);
 	}
 
-	// Load and add runtime settings
-	FString SettingsFilePath = FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("settings.json");
-	FString SettingsContent;
-	if (FFileHelper::LoadFileToString(SettingsContent, *SettingsFilePath))
+	if (!RuntimeSettings.IsValid())
+	{
+		return nullptr;
+	}
+
+	// Translate into the request settings the backend expects
+	TSharedPtr<FJsonObject> SettingsObject = MakeShareable(new FJsonObject());
+
+	// Max cost per query
+	double MaxCostPerQuery = 0.0;
+	if (RuntimeSettings->TryGetNumberField(TEXT("MaxCostPerQuery"), MaxCostPerQuery) && MaxCostPerQuery > 0.0)
+	{
+		SettingsObject->SetNumberField(TEXT("max_cost_per_query"), MaxCostPerQuery);
+	}
+
+	// Max tokens
+	int32 MaxTokens = 0;
+	if (RuntimeSettings->TryGetNumberField(TEXT("MaxTokens"), MaxTokens) && MaxTokens > 0)
+	{
+		SettingsObject->SetNumberField(TEXT("max_tokens"), MaxTokens);
+	}
+
+	// Enable thinking
+	bool bEnableThinking = false;
+	if (RuntimeSettings->TryGetBoolField(TEXT("EnableThinking"), bEnableThinking))
+	{
+		SettingsObject->SetBoolField(TEXT("enable_thinking"), bEnableThinking);
+	}
+
+	// Max thinking tokens
+	int32 MaxThinkingTokens = 0;
+	if (RuntimeSettings->TryGetNumberField(TEXT("MaxThinkingTokens"), MaxThinkingTokens) && MaxThinkingTokens > 0)
 	{
-		TSharedPtr<FJsonObject> SettingsJsonObject;
-		TSharedRef<TJsonReader<>> SettingsReader = TJsonReaderFactory<>::Create(SettingsContent);
+		SettingsObject->SetNumberField(TEXT("max_thinking_tokens"), MaxThinkingTokens);
+	}
 
-		if (FJsonSerializer::Deserialize(SettingsReader, SettingsJsonObject) && SettingsJsonObject.IsValid())
+	// Reasoning effort
+	FString ReasoningEffort;
+	if (RuntimeSettings->TryGetStringField(TEXT("ReasoningEffort"), ReasoningEffort) && !ReasoningEffort.IsEmpty())
+	{
+		SettingsObject->SetStringField(TEXT("reasoning_effort"), ReasoningEffort);
+	}
+
+	// Provider routing - load from per-model preferences
+	const TSharedPtr<FJsonObject>* RoutingObj;
+	if (RuntimeSettings->TryGetObjectField(TEXT("ProviderRouting"), RoutingObj) && RoutingObj->IsValid())
+	{
+		// Look up routing for the current model
+		const TSharedPtr<FJsonObject>* ModelRoutingObj;
+		if ((*RoutingObj)->TryGetObjectField(ModelID, ModelRoutingObj) && ModelRoutingObj->IsValid())
 		{
-			// Add settings to request
-			TSharedPtr<FJsonObject> SettingsObject = MakeShareable(new FJsonObject());
+			TSharedPtr<FJsonObject> ProviderRoutingObject = MakeShareable(new FJsonObject());
 
-			// Max cost per query
-			double MaxCostPerQuery = 0.0;
-			if (SettingsJsonObject->TryGetNumberField(TEXT("MaxCostPerQuery"), MaxCostPerQuery) && MaxCostPerQuery > 0.0)
+			FString Provider;
+			if ((*ModelRoutingObj)->TryGetStringField(TEXT("provider"), Provider))
 			{
-				SettingsObject->SetNumberField(TEXT("max_cost_per_query"), MaxCostPerQuery);
+				ProviderRoutingObject->SetStringField(TEXT("provider"), Provider);
 			}
 
-			// Max tokens
-			int32 MaxTokens = 0;
-			if (SettingsJsonObject->TryGetNumberField(TEXT("MaxTokens"), MaxTokens) && MaxTokens > 0)
+			FString SortBy;
+			if ((*ModelRoutingObj)->TryGetStringField(TEXT("sort_by"), SortBy))
 			{
-				SettingsObject->SetNumberField(TEXT("max_tokens"), MaxTokens);
+				ProviderRoutingObject->SetStringField(TEXT("sort_by"), SortBy);
 			}
 
-			// Enable thinking
-			bool bEnableThinking = false;
-			if (SettingsJsonObject->TryGetBoolField(TEXT("EnableThinking"), bEnableThinking))
+			bool bAllowFallbacks = true;
+			if ((*ModelRoutingObj)->TryGetBoolField(TEXT("allow_fallbacks"), bAllowFallbacks))
 			{
-				SettingsObject->SetBoolField(TEXT("enable_thinking"), bEnableThinking);
+				ProviderRoutingObject->SetBoolField(TEXT("allow_fallbacks"), bAllowFallbacks);
 			}
 
-			// Max thinking tokens
-			int32 MaxThinkingTokens = 0;
-			if (SettingsJsonObject->TryGetNumberField(TEXT("MaxThinkingTokens"), MaxThinkingTokens) && MaxThinkingTokens > 0)
-			{
-				SettingsObject->SetNumberField(TEXT("max_thinking_tokens"), MaxThinkingTokens);
-			}
+			SettingsObject->SetObjectField(TEXT("provider_routing"), ProviderRoutingObject);
+		}
+	}
+
 
-			// Reasoning effort
-			FString ReasoningEffort;
-			if (SettingsJsonObject->TryGetStringField(TEXT("ReasoningEffort"), ReasoningEffort) && !ReasoningEffort.IsEmpty())
+	return SettingsObject;
+}
+
+void FNeoStackAPIClient::AddHistoryToPayload(
+	const TSharedRef<FJsonObject>& Payload,
+	const TArray<FConversationMessage>& History,
+	FNeoStackStreamSession& Session)
+{
+	Session.HistoryNum = 0;
+	if (History.Num() == 0)
+	{
+		return;
+	}
+
+	// The backend's caches are only relied on for history a cache miss can read back
+	const bool bCanUseBackendCache = IsCurrentConversationPrefix(History);
+
+	// Find the newest message the backend already has cached
+	int32 CursorIndex = INDEX_NONE;
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	if (Settings && Settings->bDeltaHistoryUpload && bCanUseBackendCache)
+	{
+		for (int32 i = History.Num() - 1; i >= 0; --i)
+		{
+			if (!History[i].ID.IsEmpty() && AcknowledgedHistoryIDs.Contains(History[i].ID))
 			{
-				SettingsObject->SetStringField(TEXT("reasoning_effort"), ReasoningEffort);
+				CursorIndex = i;
+				break;
 			}
+		}
+	}
 
-			// Provider routing - load from per-model preferences
-			const TSharedPtr<FJsonObject>* RoutingObj;
-			if (SettingsJsonObject->TryGetObjectField(TEXT("ProviderRouting"), RoutingObj) && RoutingObj->IsValid())
+	// Shorten old tool results once the history outgrows the token budget (the log on disk keeps them whole)
+	TMap<int32, FString> Digests;
+	const int32 EstimatedTokens = FNeoStackHistoryCompactor::Compact(History, Settings ? Settings->HistoryTokenBudget : 0, Digests);
+	if (Digests.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Compacted %d tool result(s), history ~%d tokens"), Digests.Num(), EstimatedTokens);
+	}
+
+	// A digest for a message the backend cached in full only takes effect if the cache is rebuilt
+	for (const TPair<int32, FString>& Digest : Digests)
+	{
+		if (Digest.Key <= CursorIndex && !CompactedHistoryIDs.Contains(History[Digest.Key].ID))
+		{
+			UE_LOG(LogTemp, Log, TEXT("[NeoStack] Re-sending the full history to compact the backend's copy"));
+			CursorIndex = INDEX_NONE;
+			break;
+		}
+	}
+	Session.bSentFullHistory = CursorIndex == INDEX_NONE;
+	Session.CompactedHistoryIDs.Reset();
+
+	bool bUsedImageRefs = false;
+	TArray<TSharedPtr<FJsonValue>> MessagesArray;
+	MessagesArray.Reserve(History.Num() - CursorIndex - 1);
+	for (int32 i = CursorIndex + 1; i < History.Num(); ++i)
+	{
+		TSharedPtr<FJsonObject> MessageJson = History[i].ToJson();
+		if (const FString* Digest = Digests.Find(i))
+		{
+			MessageJson->SetStringField(TEXT("content"), *Digest);
+			Session.CompactedHistoryIDs.Add(History[i].ID);
+		}
+
+		// Images the backend acknowledged only travel as their hash
+		const TArray<TSharedPtr<FJsonValue>>* ImagesArray;
+		if (bCanUseBackendCache && UploadedImageHashes.Num() > 0 && MessageJson->TryGetArrayField(TEXT("images"), ImagesArray))
+		{
+			for (const TSharedPtr<FJsonValue>& ImageValue : *ImagesArray)
 			{
-				// Look up routing for the current model
-				const TSharedPtr<FJsonObject>* ModelRoutingObj;
-				if ((*RoutingObj)->TryGetObjectField(ModelID, ModelRoutingObj) && ModelRoutingObj->IsValid())
+				const TSharedPtr<FJsonObject>* ImageObject;
+				FString Hash;
+				if (ImageValue->TryGetObject(ImageObject) && (*ImageObject)->TryGetStringField(TEXT("hash"), Hash)
+					&& UploadedImageHashes.Contains(Hash))
 				{
-					TSharedPtr<FJsonObject> ProviderRoutingObject = MakeShareable(new FJsonObject());
+					(*ImageObject)->RemoveField(TEXT("base64"));
+					bUsedImageRefs = true;
+				}
+			}
+		}
 
-					FString Provider;
-					if ((*ModelRoutingObj)->TryGetStringField(TEXT("provider"), Provider))
-					{
-						ProviderRoutingObject->SetStringField(TEXT("provider"), Provider);
-					}
+		MessagesArray.Add(MakeShareable(new FJsonValueObject(MessageJson)));
+	}
+	Payload->SetArrayField(TEXT("messages"), MessagesArray);
 
-					FString SortBy;
-					if ((*ModelRoutingObj)->TryGetStringField(TEXT("sort_by"), SortBy))
-					{
-						ProviderRoutingObject->SetStringField(TEXT("sort_by"), SortBy);
-					}
+	if (CursorIndex != INDEX_NONE)
+	{
+		Payload->SetStringField(TEXT("history_mode"), TEXT("delta"));
+		Payload->SetStringField(TEXT("history_cursor"), History[CursorIndex].ID);
+	}
 
-					bool bAllowFallbacks = true;
-					if ((*ModelRoutingObj)->TryGetBoolField(TEXT("allow_fallbacks"), bAllowFallbacks))
-					{
-						ProviderRoutingObject->SetBoolField(TEXT("allow_fallbacks"), bAllowFallbacks);
-					}
+	if (CursorIndex != INDEX_NONE || bUsedImageRefs)
+	{
+		// Remember where the history came from in case the backend evicted its copy (409)
+		Session.HistoryConversationID = FNeoStackConversationManager::Get().GetCurrentConversationID();
+		Session.HistoryNum = History.Num();
+		Session.HistoryLastID = History.Last().ID;
+	}
+}
 
-					SettingsObject->SetObjectField(TEXT("provider_routing"), ProviderRoutingObject);
-				}
-			}
+bool FNeoStackAPIClient::IsCurrentConversationPrefix(const TArray<FConversationMessage>& History)
+{
+	const FNeoStackConversationManager& ConversationMgr = FNeoStackConversationManager::Get();
+	const TArray<FConversationMessage>& Messages = ConversationMgr.GetCurrentMessages();
+	return History.Num() > 0 && !History.Last().ID.IsEmpty() && !ConversationMgr.HasOlderMessages()
+		&& Messages.IsValidIndex(History.Num() - 1) && Messages[History.Num() - 1].ID == History.Last().ID;
+}
 
-			JsonObject->SetObjectField(TEXT("settings"), SettingsObject);
-		}
+bool FNeoStackAPIClient::RebuildHistory(const FNeoStackStreamSession& Session, TArray<FConversationMessage>& OutHistory)
+{
+	FNeoStackConversationManager& ConversationMgr = FNeoStackConversationManager::Get();
+	if (Session.HistoryNum <= 0 || ConversationMgr.GetCurrentConversationID() != Session.HistoryConversationID)
+	{
+		return false;
 	}
 
+	const TArray<FConversationMessage>& Messages = ConversationMgr.GetFullCurrentMessages();
+	if (!Messages.IsValidIndex(Session.HistoryNum - 1) || Messages[Session.HistoryNum - 1].ID != Session.HistoryLastID)
+	{
+		return false;
+	}
+
+	OutHistory.Append(Messages.GetData(), Session.HistoryNum);
+	FNeoStackBlobStore::ResolveAll(OutHistory);
+	return true;
+}
+
+TSharedPtr<FNeoStackStreamSession> FNeoStackAPIClient::SendPayload(const TSharedRef<FNeoStackStreamSession>& Session)
+{
 	FString RequestBody;
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	FJsonSerializer::Serialize(Session->Payload.ToSharedRef(), Writer);
+
+	return StartStream(Session, RequestBody);
+}
+
+TSharedPtr<FNeoStackStreamSession> FNeoStackAPIClient::StartStream(
+	const TSharedRef<FNeoStackStreamSession>& Session,
+	const FString& RequestBody)
+{
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+
+	// Create HTTP request
+	FHttpModule& HttpModule = FHttpModule::Get();
+	TSharedRef<IHttpRequest> Request = HttpModule.CreateRequest();
 
 	// Configure request
 	FString URL = Settings->BackendURL + TEXT("/ai");
@@ -192,212 +515,375 @@ void FNeoStackAPIClient::SendMessageWithHistory(
 	Request->SetHeader(TEXT("X-API-Key"), Settings->APIKey);
 	Request->SetContentAsString(RequestBody);
 
-	// Capture session ID for callbacks
-	FString SessionID = CurrentSessionID;
-
-	// Bind response callback
-	Request->OnProcessRequestComplete().BindStatic(
-		&FNeoStackAPIClient::OnResponseReceived,
-		SessionID,
-		OnContent,
-		OnReasoning,
-		OnToolCall,
-		OnUE5ToolCall,
-		OnToolResult,
-		OnComplete,
-		OnCost,
-		OnError
-	);
-
-	// Bind progress callback for streaming
-	Request->OnRequestProgress64().BindStatic(
-		&FNeoStackAPIClient::OnRequestProgress,
-		SessionID,
-		OnContent,
-		OnReasoning,
-		OnToolCall,
-		OnUE5ToolCall,
-		OnToolResult,
-		OnComplete,
-		OnCost
-	);
+	// The request's delegates hold the session until the response completes
+	Request->OnProcessRequestComplete().BindStatic(&FNeoStackAPIClient::OnResponseReceived, Session);
+	Request->OnRequestProgress64().BindStatic(&FNeoStackAPIClient::OnRequestProgress, Session);
+
+	Session->HttpRequest = Request;
+	Session->RequestStartTime = FPlatformTime::Seconds();
+
+	// A retry after a cache miss starts a fresh recording, only the body that was decoded is kept
+	Session->Recording.Reset();
+	if (FNeoStackStreamRecording::IsRecordingEnabled())
+	{
+		Session->Recording = MakeShared<FNeoStackStreamRecording>();
+	}
 
 	// Send request
 	if (!Request->ProcessRequest())
 	{
-		OnError.ExecuteIfBound(TEXT("Failed to send HTTP request"));
+		Session->HttpRequest.Reset();
+		Session->bFinished = true;
+		Session->Callbacks.OnError.ExecuteIfBound(TEXT("Failed to send HTTP request"));
+		return nullptr;
 	}
+
+	return Session;
 }
 
-void FNeoStackAPIClient::ParseSSEEvent(
-	const FString& EventData,
-	FString SessionID,
-	FOnAIContent OnContent,
-	FOnAIReasoning OnReasoning,
-	FOnAIToolCall OnToolCall,
-	FOnAIUE5ToolCall OnUE5ToolCall,
-	FOnAIToolResult OnToolResult,
-	FOnAIComplete OnComplete,
-	FOnAICost OnCost)
+bool FNeoStackAPIClient::TryParseTextDelta(const FString& JsonString, FNeoStackStreamSession& Session)
 {
-	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Raw event data: %s"), *EventData);
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+
+	EJsonNotation Notation;
+	if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		return false;
+	}
 
-	// SSE format: "data: {json}\n\n"
-	TArray<FString> Lines;
-	EventData.ParseIntoArray(Lines, TEXT("\n"));
+	FString Type;
+	FString Content;
+	FString Reasoning;
+	bool bHasContent = false;
+	bool bHasReasoning = false;
 
-	for (const FString& Line : Lines)
+	while (Reader->ReadNext(Notation))
 	{
-		if (Line.StartsWith(TEXT("data: ")))
+		switch (Notation)
+		{
+		case EJsonNotation::String:
+		{
+			const FString& Identifier = Reader->GetIdentifier();
+			if (Identifier == TEXT("type"))
+			{
+				Type = Reader->GetValueAsString();
+				if (Type != TEXT("content") && Type != TEXT("reasoning"))
+				{
+					return false; // Not a text delta - let the DOM path handle it
+				}
+			}
+			else if (Identifier == TEXT("content"))
+			{
+				Content = Reader->GetValueAsString();
+				bHasContent = true;
+			}
+			else if (Identifier == TEXT("reasoning"))
+			{
+				Reasoning = Reader->GetValueAsString();
+				bHasReasoning = true;
+			}
+			break;
+		}
+
+		case EJsonNotation::ObjectEnd:
 		{
-			FString JsonString = Line.RightChop(6); // Remove "data: " prefix
-			UE_LOG(LogTemp, Log, TEXT("[NeoStack] Parsed JSON: %s"), *JsonString);
+			// Only reachable for the top-level object because nested values bail out below
+			if (Type == TEXT("content") && bHasContent)
+			{
+				Session.Callbacks.OnContent.ExecuteIfBound(Content);
+				return true;
+			}
+			if (Type == TEXT("reasoning") && bHasReasoning)
+			{
+				Session.Callbacks.OnReasoning.ExecuteIfBound(Reasoning);
+				return true;
+			}
+			return false;
+		}
+
+		case EJsonNotation::ObjectStart:
+		case EJsonNotation::ArrayStart:
+		case EJsonNotation::Error:
+			// Nested values only appear on non-text events
+			return false;
+
+		default:
+			break;
+		}
+	}
+
+	return false;
+}
+
+void FNeoStackAPIClient::ParseSSEEvent(const FString& JsonString, FNeoStackStreamSession& Session)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("NeoStack_ParseSSEEvent", NeoStackNetChannel);
+
+	const FNeoStackStreamCallbacks& Callbacks = Session.Callbacks;
+	const FString& SessionID = Session.SessionID;
+
+	UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Parsed JSON: %s"), *JsonString);
+
+	// Hot path: content/reasoning deltas are decoded token by token without a DOM
+	if (TryParseTextDelta(JsonString, Session))
+	{
+		return;
+	}
 
-			// Parse JSON
-			TSharedPtr<FJsonObject> JsonObject;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	// Parse JSON
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
 
-			if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+	{
+		FString Type;
+		if (JsonObject->TryGetStringField(TEXT("type"), Type))
+		{
+			UE_LOG(LogTemp, Log, TEXT("[NeoStack] Event type: %s"), *Type);
+			if (Type == TEXT("content"))
 			{
-				FString Type;
-				if (JsonObject->TryGetStringField(TEXT("type"), Type))
+				FString Content;
+				if (JsonObject->TryGetStringField(TEXT("content"), Content))
 				{
-					UE_LOG(LogTemp, Log, TEXT("[NeoStack] Event type: %s"), *Type);
-					if (Type == TEXT("content"))
-					{
-						FString Content;
-						if (JsonObject->TryGetStringField(TEXT("content"), Content))
-						{
-							OnContent.ExecuteIfBound(Content);
-						}
-					}
-					else if (Type == TEXT("reasoning"))
-					{
-						FString Reasoning;
-						if (JsonObject->TryGetStringField(TEXT("reasoning"), Reasoning))
-						{
-							OnReasoning.ExecuteIfBound(Reasoning);
-						}
-					}
-					else if (Type == TEXT("tool_call_backend"))
-					{
-						FString ToolName;
-						FString CallID;
-						JsonObject->TryGetStringField(TEXT("tool"), ToolName);
-						JsonObject->TryGetStringField(TEXT("call_id"), CallID);
-
-						UE_LOG(LogTemp, Log, TEXT("[NeoStack] Backend tool call - Name: %s, CallID: %s"), *ToolName, *CallID);
-
-						// Convert args object to string
-						FString ArgsString;
-						const TSharedPtr<FJsonObject>* ArgsObject;
-						if (JsonObject->TryGetObjectField(TEXT("args"), ArgsObject))
-						{
-							TSharedRef<TJsonWriter<>> ArgsWriter = TJsonWriterFactory<>::Create(&ArgsString);
-							FJsonSerializer::Serialize((*ArgsObject).ToSharedRef(), ArgsWriter);
-							UE_LOG(LogTemp, Log, TEXT("[NeoStack] Tool args: %s"), *ArgsString);
-						}
-
-						OnToolCall.ExecuteIfBound(ToolName, ArgsString, CallID);
-					}
-					else if (Type == TEXT("tool_call_ue5"))
-					{
-						FString ToolName;
-						FString CallID;
-						JsonObject->TryGetStringField(TEXT("tool"), ToolName);
-						JsonObject->TryGetStringField(TEXT("call_id"), CallID);
-
-						UE_LOG(LogTemp, Log, TEXT("[NeoStack] UE5 tool call - Name: %s, CallID: %s, SessionID: %s"), *ToolName, *CallID, *SessionID);
-
-						// Convert args object to string
-						FString ArgsString;
-						const TSharedPtr<FJsonObject>* ArgsObject;
-						if (JsonObject->TryGetObjectField(TEXT("args"), ArgsObject))
-						{
-							TSharedRef<TJsonWriter<>> ArgsWriter = TJsonWriterFactory<>::Create(&ArgsString);
-							FJsonSerializer::Serialize((*ArgsObject).ToSharedRef(), ArgsWriter);
-							UE_LOG(LogTemp, Log, TEXT("[NeoStack] Tool args: %s"), *ArgsString);
-						}
-
-						// UE5 tools get the session ID for result submission
-						OnUE5ToolCall.ExecuteIfBound(SessionID, ToolName, ArgsString, CallID);
-					}
-					else if (Type == TEXT("tool_result"))
-					{
-						FString CallID;
-						FString Result;
-						JsonObject->TryGetStringField(TEXT("call_id"), CallID);
-						JsonObject->TryGetStringField(TEXT("result"), Result);
+					Callbacks.OnContent.ExecuteIfBound(Content);
+				}
+			}
+			else if (Type == TEXT("reasoning"))
+			{
+				FString Reasoning;
+				if (JsonObject->TryGetStringField(TEXT("reasoning"), Reasoning))
+				{
+					Callbacks.OnReasoning.ExecuteIfBound(Reasoning);
+				}
+			}
+			else if (Type == TEXT("tool_call_backend"))
+			{
+				FString ToolName;
+				FString CallID;
+				JsonObject->TryGetStringField(TEXT("tool"), ToolName);
+				JsonObject->TryGetStringField(TEXT("call_id"), CallID);
 
-						UE_LOG(LogTemp, Log, TEXT("[NeoStack] Tool result - CallID: %s, Result: %s"), *CallID, *Result);
-						OnToolResult.ExecuteIfBound(CallID, Result);
-					}
-					else if (Type == TEXT("cost"))
-					{
-						double Cost = 0.0;
-						if (JsonObject->TryGetNumberField(TEXT("cost"), Cost))
-						{
-							UE_LOG(LogTemp, Log, TEXT("[NeoStack] Cost update: $%.6f"), Cost);
-							OnCost.ExecuteIfBound(static_cast<float>(Cost));
-						}
-					}
-					else if (Type == TEXT("final"))
+				UE_LOG(LogTemp, Log, TEXT("[NeoStack] Backend tool call - Name: %s, CallID: %s"), *ToolName, *CallID);
+
+				// Args text is sliced from the event line, not re-serialized
+				const TSharedPtr<FJsonObject>* ArgsObject = nullptr;
+				JsonObject->TryGetObjectField(TEXT("args"), ArgsObject);
+				const FString ArgsString = GetToolArgsString(JsonString, ArgsObject ? *ArgsObject : nullptr);
+				UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Tool args: %s"), *ArgsString);
+
+				Callbacks.OnToolCall.ExecuteIfBound(ToolName, ArgsString, CallID);
+			}
+			else if (Type == TEXT("tool_call_ue5"))
+			{
+				FString ToolName;
+				FString CallID;
+				JsonObject->TryGetStringField(TEXT("tool"), ToolName);
+				JsonObject->TryGetStringField(TEXT("call_id"), CallID);
+
+				UE_LOG(LogTemp, Log, TEXT("[NeoStack] UE5 tool call - Name: %s, CallID: %s, SessionID: %s"), *ToolName, *CallID, *SessionID);
+
+				// Keep the parsed args object for execution; the text is sliced from the event line
+				const TSharedPtr<FJsonObject>* ArgsObjectPtr = nullptr;
+				JsonObject->TryGetObjectField(TEXT("args"), ArgsObjectPtr);
+				const TSharedPtr<FJsonObject> ArgsObject = ArgsObjectPtr ? *ArgsObjectPtr : MakeShared<FJsonObject>();
+				const FString ArgsString = GetToolArgsString(JsonString, ArgsObject);
+				UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Tool args: %s"), *ArgsString);
+
+				// UE5 tools get the session ID for result submission
+				Callbacks.OnUE5ToolCall.ExecuteIfBound(SessionID, ToolName, ArgsString, ArgsObject, CallID);
+			}
+			else if (Type == TEXT("tool_result"))
+			{
+				FString CallID;
+				FString Result;
+				JsonObject->TryGetStringField(TEXT("call_id"), CallID);
+				JsonObject->TryGetStringField(TEXT("result"), Result);
+
+				UE_LOG(LogTemp, Log, TEXT("[NeoStack] Tool result - CallID: %s, Result: %s"), *CallID, *Result);
+				Callbacks.OnToolResult.ExecuteIfBound(CallID, Result);
+			}
+			else if (Type == TEXT("cost"))
+			{
+				double Cost = 0.0;
+				if (JsonObject->TryGetNumberField(TEXT("cost"), Cost))
+				{
+					UE_LOG(LogTemp, Log, TEXT("[NeoStack] Cost update: $%.6f"), Cost);
+					Callbacks.OnCost.ExecuteIfBound(static_cast<float>(Cost));
+				}
+			}
+			else if (Type == TEXT("image_ack"))
+			{
+				// Backend stored this image, later turns reference it by hash
+				FString Hash;
+				if (!Session.bReplay && JsonObject->TryGetStringField(TEXT("hash"), Hash) && !Hash.IsEmpty())
+				{
+					UploadedImageHashes.Add(Hash);
+				}
+			}
+			else if (Type == TEXT("history_ack"))
+			{
+				// Backend cached the history up to this message, later turns only send what follows it
+				FString Cursor;
+				if (!Session.bReplay && JsonObject->TryGetStringField(TEXT("cursor"), Cursor) && !Cursor.IsEmpty())
+				{
+					AcknowledgedHistoryIDs.Add(Cursor);
+
+					// A full upload replaced whatever the backend had; a delta only added to it
+					if (Session.bSentFullHistory)
 					{
-						UE_LOG(LogTemp, Log, TEXT("[NeoStack] Stream complete"));
-						OnComplete.ExecuteIfBound();
+						CompactedHistoryIDs = Session.CompactedHistoryIDs;
 					}
-					else if (Type == TEXT("error"))
+					else
 					{
-						// Handle error in stream
-						FString ErrorMsg;
-						if (JsonObject->TryGetStringField(TEXT("content"), ErrorMsg))
-						{
-							UE_LOG(LogTemp, Error, TEXT("[NeoStack] Stream error: %s"), *ErrorMsg);
-						}
+						CompactedHistoryIDs.Append(Session.CompactedHistoryIDs);
 					}
 				}
 			}
-			else
+			else if (Type == TEXT("final"))
 			{
-				UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to deserialize JSON: %s"), *JsonString);
+				UE_LOG(LogTemp, Log, TEXT("[NeoStack] Stream complete - SessionID: %s"), *SessionID);
+				Session.bFinished = true;
+				Callbacks.OnComplete.ExecuteIfBound();
+			}
+			else if (Type == TEXT("error"))
+			{
+				// Handle error in stream
+				FString ErrorMsg;
+				if (JsonObject->TryGetStringField(TEXT("content"), ErrorMsg))
+				{
+					UE_LOG(LogTemp, Error, TEXT("[NeoStack] Stream error: %s"), *ErrorMsg);
+				}
 			}
 		}
 	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to deserialize JSON: %s"), *JsonString);
+	}
 }
 
 void FNeoStackAPIClient::OnRequestProgress(
 	FHttpRequestPtr Request,
 	uint64 BytesSent,
 	uint64 BytesReceived,
-	FString SessionID,
-	FOnAIContent OnContent,
-	FOnAIReasoning OnReasoning,
-	FOnAIToolCall OnToolCall,
-	FOnAIUE5ToolCall OnUE5ToolCall,
-	FOnAIToolResult OnToolResult,
-	FOnAIComplete OnComplete,
-	FOnAICost OnCost)
+	TSharedRef<FNeoStackStreamSession> Session)
 {
+	if (Session->bCancelled)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("NeoStack_SSEConsume", NeoStackNetChannel);
+
 	// Get partial response for streaming
 	if (Request.IsValid())
 	{
 		FHttpResponsePtr Response = Request->GetResponse();
 		if (Response.IsValid())
 		{
-			FString FullContent = Response->GetContentAsString();
+			RecordNewBytes(*Session, Response->GetContent());
 
-			// Only process new content
-			if (FullContent.Len() > LastProcessedContent.Len())
+			// Only the bytes received since the last tick are scanned; split lines carry over
+			Session->Parser.Consume(Response->GetContent(), [&Session](const FString& Data)
 			{
-				FString NewContent = FullContent.RightChop(LastProcessedContent.Len());
+				ParseSSEEvent(Data, *Session);
+			});
+		}
+	}
+}
 
-				// Parse SSE events
-				ParseSSEEvent(NewContent, SessionID, OnContent, OnReasoning, OnToolCall, OnUE5ToolCall, OnToolResult, OnComplete, OnCost);
+void FNeoStackAPIClient::ReplayStream(const TArray<uint8>& Body, int32 ChunkSize, const FNeoStackStreamCallbacks& Callbacks)
+{
+	TSharedRef<FNeoStackStreamSession> Session = MakeShared<FNeoStackStreamSession>(TEXT("replay"), Callbacks);
+	Session->bReplay = true;
+	auto OnData = [&Session](const FString& Data)
+	{
+		ParseSSEEvent(Data, *Session);
+	};
 
-				// Update processed content
-				LastProcessedContent = FullContent;
-			}
+	ChunkSize = FMath::Max(1, ChunkSize);
+	for (int32 Offset = 0; Offset < Body.Num(); Offset += ChunkSize)
+	{
+		Session->Parser.ConsumeBytes(Body.GetData() + Offset, FMath::Min(ChunkSize, Body.Num() - Offset), OnData);
+	}
+	Session->Parser.Finish(OnData);
+}
+
+TSharedRef<FNeoStackStreamSession> FNeoStackAPIClient::ReplayRecording(
+	const TSharedRef<const FNeoStackStreamRecording>& Recording,
+	float Speed,
+	const FNeoStackStreamCallbacks& Callbacks)
+{
+	TSharedRef<FNeoStackStreamSession> Session = MakeShared<FNeoStackStreamSession>(TEXT("replay"), Callbacks);
+	Session->bReplay = true;
+
+	if (Speed <= 0.0f)
+	{
+		auto OnData = [&Session](const FString& Data)
+		{
+			ParseSSEEvent(Data, *Session);
+		};
+		for (const FNeoStackStreamRecording::FChunk& Chunk : Recording->Chunks)
+		{
+			Session->Parser.ConsumeBytes(Chunk.Bytes.GetData(), Chunk.Bytes.Num(), OnData);
 		}
+		Session->Parser.Finish(OnData);
+		Session->bFinished = true;
+		return Session;
+	}
+
+	// The ticker holds the session until the last chunk is fed or the replay is cancelled
+	const double StartTime = FPlatformTime::Seconds();
+	int32 NextChunk = 0;
+	Session->ReplayTicker = FTSTicker::GetCoreTicker().AddTicker(TEXT("NeoStackStreamReplay"), 0.0f,
+		[Session, Recording, Speed, StartTime, NextChunk](float) mutable
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("NeoStack_SSEConsume", NeoStackNetChannel);
+
+			auto OnData = [&Session](const FString& Data)
+			{
+				ParseSSEEvent(Data, *Session);
+			};
+
+			// Like a progress tick, everything that arrived since the last frame is decoded at once
+			const double Elapsed = (FPlatformTime::Seconds() - StartTime) * Speed;
+			while (!Session->bCancelled && Recording->Chunks.IsValidIndex(NextChunk) && Recording->Chunks[NextChunk].Time <= Elapsed)
+			{
+				const FNeoStackStreamRecording::FChunk& Chunk = Recording->Chunks[NextChunk++];
+				Session->Parser.ConsumeBytes(Chunk.Bytes.GetData(), Chunk.Bytes.Num(), OnData);
+			}
+
+			if (Session->bCancelled)
+			{
+				return false;
+			}
+			if (NextChunk < Recording->Chunks.Num())
+			{
+				return true;
+			}
+
+			Session->Parser.Finish(OnData);
+			Session->bFinished = true;
+			Session->ReplayTicker.Reset();
+			return false;
+		});
+
+	return Session;
+}
+
+void FNeoStackAPIClient::RecordNewBytes(FNeoStackStreamSession& Session, const TArray<uint8>& Content)
+{
+	if (!Session.Recording.IsValid())
+	{
+		return;
+	}
+
+	// The parser has consumed exactly the bytes recorded so far
+	const int64 Recorded = Session.Parser.GetProcessedBytes();
+	if (Content.Num() > Recorded)
+	{
+		Session.Recording->AddChunk(FPlatformTime::Seconds() - Session.RequestStartTime,
+			Content.GetData() + Recorded, Content.Num() - Recorded);
 	}
 }
 
@@ -405,23 +891,71 @@ void FNeoStackAPIClient::OnResponseReceived(
 	FHttpRequestPtr Request,
 	FHttpResponsePtr Response,
 	bool bWasSuccessful,
-	FString SessionID,
-	FOnAIContent OnContent,
-	FOnAIReasoning OnReasoning,
-	FOnAIToolCall OnToolCall,
-	FOnAIUE5ToolCall OnUE5ToolCall,
-	FOnAIToolResult OnToolResult,
-	FOnAIComplete OnComplete,
-	FOnAICost OnCost,
-	FOnAPIError OnError)
+	TSharedRef<FNeoStackStreamSession> Session)
 {
+	// Break the session <-> request reference cycle, the stream is over either way
+	Session->HttpRequest.Reset();
+
+	if (Session->bCancelled)
+	{
+		return;
+	}
+
+	const FNeoStackStreamCallbacks& Callbacks = Session->Callbacks;
+
 	if (!bWasSuccessful || !Response.IsValid())
 	{
-		OnError.ExecuteIfBound(TEXT("Request failed or invalid response"));
+		Session->bFinished = true;
+		Callbacks.OnError.ExecuteIfBound(TEXT("Request failed or invalid response"));
 		return;
 	}
 
 	int32 ResponseCode = Response->GetResponseCode();
+	// Cache miss (history cursor or image hash) - retry once with everything inline, if the history can be read back
+	TArray<FConversationMessage> FullHistory;
+	const bool bUsedBackendCache = Session->HistoryNum > 0 || Session->ReferencedImages.Num() > 0;
+	if (ResponseCode == 409 && bUsedBackendCache && Session->Payload.IsValid()
+		&& (Session->HistoryNum == 0 || RebuildHistory(*Session, FullHistory)))
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Backend cache miss, re-sending full history and images"));
+		AcknowledgedHistoryIDs.Reset();
+		UploadedImageHashes.Reset();
+		CompactedHistoryIDs.Reset();
+
+		if (FullHistory.Num() > 0)
+		{
+			Session->Payload->RemoveField(TEXT("history_mode"));
+			Session->Payload->RemoveField(TEXT("history_cursor"));
+			AddHistoryToPayload(Session->Payload.ToSharedRef(), FullHistory, *Session);
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* ContentArray;
+		if (Session->ReferencedImages.Num() > 0 && Session->Payload->TryGetArrayField(TEXT("content"), ContentArray))
+		{
+			TArray<TSharedPtr<FJsonValue>> InlineContent;
+			for (const TSharedPtr<FJsonValue>& Part : *ContentArray)
+			{
+				const TSharedPtr<FJsonObject>* PartObject;
+				FString Hash;
+				const FConversationImage* Image = nullptr;
+				if (Part->TryGetObject(PartObject) && (*PartObject)->TryGetStringField(TEXT("hash"), Hash))
+				{
+					Image = Session->ReferencedImages.Find(Hash);
+				}
+
+				InlineContent.Add(Image
+					? MakeShareable(new FJsonValueObject(MakeInlineImageContent(Image->MimeType, Image->Base64Data, Image->Hash)))
+					: Part);
+			}
+			Session->Payload->SetArrayField(TEXT("content"), InlineContent);
+			Session->ReferencedImages.Reset();
+		}
+
+		Session->Parser.Reset();
+		SendPayload(Session);
+		return;
+	}
+
 	if (ResponseCode != 200)
 	{
 		FString ErrorMsg = FString::Printf(
@@ -429,76 +963,71 @@ void FNeoStackAPIClient::OnResponseReceived(
 			ResponseCode,
 			*Response->GetContentAsString()
 		);
-		OnError.ExecuteIfBound(ErrorMsg);
+		Session->bFinished = true;
+		Callbacks.OnError.ExecuteIfBound(ErrorMsg);
 		return;
 	}
 
 	// Final processing of any remaining content
 	// Note: OnComplete is called by ParseSSEEvent when it receives the "final" event
-	FString FullContent = Response->GetContentAsString();
-	if (FullContent.Len() > LastProcessedContent.Len())
+	auto HandleData = [&Session](const FString& Data)
 	{
-		FString NewContent = FullContent.RightChop(LastProcessedContent.Len());
-		ParseSSEEvent(NewContent, SessionID, OnContent, OnReasoning, OnToolCall, OnUE5ToolCall, OnToolResult, OnComplete, OnCost);
+		ParseSSEEvent(Data, *Session);
+	};
+	RecordNewBytes(*Session, Response->GetContent());
+	Session->Parser.Consume(Response->GetContent(), HandleData);
+	Session->Parser.Finish(HandleData);
+	Session->bFinished = true;
+
+	if (Session->Recording.IsValid())
+	{
+		const FString RecordingPath = FNeoStackStreamRecording::GetRecordingDir()
+			/ FString::Printf(TEXT("%s_%s.nsrec"), *FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")), *Session->SessionID);
+		if (Session->Recording->SaveToFile(RecordingPath))
+		{
+			UE_LOG(LogTemp, Log, TEXT("[NeoStack] Recorded stream: %d chunks, %lld bytes -> %s"),
+				Session->Recording->Chunks.Num(), Session->Recording->GetNumBytes(), *RecordingPath);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Failed to write stream recording %s"), *RecordingPath);
+		}
+		Session->Recording.Reset();
 	}
 }
 
-void FNeoStackAPIClient::SubmitToolResult(
-	const FString& SessionID,
-	const FString& CallID,
-	const FString& Result)
+TSharedRef<FJsonObject> FNeoStackAPIClient::MakeInlineImageContent(const FString& MimeType, const FString& Base64Data, const FString& Hash)
 {
-	// Get settings
-	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
-	if (!Settings)
-	{
-		UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to get settings for tool result submission"));
-		return;
-	}
-
-	// Create HTTP request
-	FHttpModule& HttpModule = FHttpModule::Get();
-	TSharedRef<IHttpRequest> Request = HttpModule.CreateRequest();
+	TSharedRef<FJsonObject> ImageContent = MakeShared<FJsonObject>();
+	ImageContent->SetStringField(TEXT("type"), TEXT("image_url"));
 
-	// Build JSON payload
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
-	JsonObject->SetStringField(TEXT("session_id"), SessionID);
-	JsonObject->SetStringField(TEXT("call_id"), CallID);
-	JsonObject->SetStringField(TEXT("result"), Result);
+	TSharedPtr<FJsonObject> ImageUrl = MakeShareable(new FJsonObject());
+	// Format: data:image/png;base64,<base64data>
+	FString DataUrl = FString::Printf(TEXT("data:%s;base64,%s"), *MimeType, *Base64Data);
+	ImageUrl->SetStringField(TEXT("url"), DataUrl);
+	ImageContent->SetObjectField(TEXT("image_url"), ImageUrl);
 
-	FString RequestBody;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-
-	// Configure request
-	FString URL = Settings->BackendURL + TEXT("/ai/tool-result");
-	Request->SetURL(URL);
-	Request->SetVerb(TEXT("POST"));
-	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	Request->SetHeader(TEXT("X-API-Key"), Settings->APIKey);
-	Request->SetContentAsString(RequestBody);
+	if (!Hash.IsEmpty())
+	{
+		ImageContent->SetStringField(TEXT("hash"), Hash);
+	}
 
-	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Submitting tool result - SessionID: %s, CallID: %s"), *SessionID, *CallID);
+	return ImageContent;
+}
 
-	// Bind response callback
-	Request->OnProcessRequestComplete().BindLambda([CallID](FHttpRequestPtr Req, FHttpResponsePtr Resp, bool bSuccess)
-	{
-		if (bSuccess && Resp.IsValid() && Resp->GetResponseCode() == 200)
-		{
-			UE_LOG(LogTemp, Log, TEXT("[NeoStack] Tool result submitted successfully for CallID: %s"), *CallID);
-		}
-		else
-		{
-			FString Error = Resp.IsValid() ? Resp->GetContentAsString() : TEXT("Request failed");
-			UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to submit tool result for CallID: %s - %s"), *CallID, *Error);
-		}
-	});
+void FNeoStackAPIClient::SubmitToolResult(
+	const FString& SessionID,
+	const FString& CallID,
+	const FString& Result,
+	const TArray<TSharedPtr<const FNeoStackProcessedImage>>& Images)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("NeoStack_SubmitToolResult", NeoStackNetChannel);
 
-	// Send request
-	Request->ProcessRequest();
+	// Results from the same frame go out together, in order, with retries
+	FNeoStackToolResultQueue::Get().Enqueue(SessionID, CallID, Result, Images);
 }
 
-void FNeoStackAPIClient::SendMessageWithImages(
+TSharedPtr<FNeoStackStreamSession> FNeoStackAPIClient::SendMessageWithImages(
 	const FString& Message,
 	const TArray<FAttachedImage>& Images,
 	const TArray<FConversationMessage>& History,
@@ -516,48 +1045,50 @@ void FNeoStackAPIClient::SendMessageWithImages(
 	// If no images, delegate to regular method
 	if (Images.Num() == 0)
 	{
-		SendMessageWithHistory(Message, History, AgentName, ModelID,
+		return SendMessageWithHistory(Message, History, AgentName, ModelID,
 			OnContent, OnReasoning, OnToolCall, OnUE5ToolCall, OnToolResult, OnComplete, OnCost, OnError);
-		return;
 	}
 
-	// Reset buffer for new request
-	LastProcessedContent.Empty();
+	// Each request gets its own stream session (parser, callbacks, session ID)
+	FNeoStackStreamCallbacks Callbacks;
+	Callbacks.OnContent = OnContent;
+	Callbacks.OnReasoning = OnReasoning;
+	Callbacks.OnToolCall = OnToolCall;
+	Callbacks.OnUE5ToolCall = OnUE5ToolCall;
+	Callbacks.OnToolResult = OnToolResult;
+	Callbacks.OnComplete = OnComplete;
+	Callbacks.OnCost = OnCost;
+	Callbacks.OnError = OnError;
 
-	// Generate a unique session ID for this request
-	CurrentSessionID = FGuid::NewGuid().ToString();
+	TSharedRef<FNeoStackStreamSession> Session = MakeShared<FNeoStackStreamSession>(FGuid::NewGuid().ToString(), Callbacks);
 
 	// Get settings
 	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
 	if (!Settings)
 	{
 		OnError.ExecuteIfBound(TEXT("Failed to get NeoStack settings"));
-		return;
+		return nullptr;
 	}
 
 	// Validate API key
 	if (Settings->APIKey.IsEmpty())
 	{
 		OnError.ExecuteIfBound(TEXT("API Key not configured. Please set it in Project Settings > Game > NeoStack"));
-		return;
+		return nullptr;
 	}
 
 	// Validate backend URL
 	if (Settings->BackendURL.IsEmpty())
 	{
 		OnError.ExecuteIfBound(TEXT("Backend URL not configured"));
-		return;
+		return nullptr;
 	}
 
-	// Create HTTP request
-	FHttpModule& HttpModule = FHttpModule::Get();
-	TSharedRef<IHttpRequest> Request = HttpModule.CreateRequest();
-
 	// Build JSON payload
 	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
 	JsonObject->SetStringField(TEXT("agent"), AgentName);
 	JsonObject->SetStringField(TEXT("model"), ModelID);
-	JsonObject->SetStringField(TEXT("session_id"), CurrentSessionID);
+	JsonObject->SetStringField(TEXT("session_id"), Session->GetSessionID());
 
 	// Build content array for multimodal message (OpenRouter/OpenAI format)
 	TArray<TSharedPtr<FJsonValue>> ContentArray;
@@ -571,19 +1102,25 @@ void FNeoStackAPIClient::SendMessageWithImages(
 		ContentArray.Add(MakeShareable(new FJsonValueObject(TextContent)));
 	}
 
-	// Add image content
+	// Add image content - images the backend already has are referenced by hash
 	for (const FAttachedImage& Img : Images)
 	{
-		TSharedPtr<FJsonObject> ImageContent = MakeShareable(new FJsonObject());
-		ImageContent->SetStringField(TEXT("type"), TEXT("image_url"));
-
-		TSharedPtr<FJsonObject> ImageUrl = MakeShareable(new FJsonObject());
-		// Format: data:image/png;base64,<base64data>
-		FString DataUrl = FString::Printf(TEXT("data:%s;base64,%s"), *Img.MimeType, *Img.Base64Data);
-		ImageUrl->SetStringField(TEXT("url"), DataUrl);
-		ImageContent->SetObjectField(TEXT("image_url"), ImageUrl);
+		if (!Img.Hash.IsEmpty() && UploadedImageHashes.Contains(Img.Hash))
+		{
+			TSharedPtr<FJsonObject> ImageRef = MakeShareable(new FJsonObject());
+			ImageRef->SetStringField(TEXT("type"), TEXT("image_ref"));
+			ImageRef->SetStringField(TEXT("hash"), Img.Hash);
+			ContentArray.Add(MakeShareable(new FJsonValueObject(ImageRef)));
+
+			// Kept so a cache miss can be answered with the bytes
+			FConversationImage& Referenced = Session->ReferencedImages.Add(Img.Hash);
+			Referenced.Base64Data = Img.Base64Data;
+			Referenced.MimeType = Img.MimeType;
+			Referenced.Hash = Img.Hash;
+			continue;
+		}
 
-		ContentArray.Add(MakeShareable(new FJsonValueObject(ImageContent)));
+		ContentArray.Add(MakeShareable(new FJsonValueObject(MakeInlineImageContent(Img.MimeType, Img.Base64Data, Img.Hash))));
 	}
 
 	// Set multimodal content (backend expects this for images)
@@ -591,138 +1128,16 @@ void FNeoStackAPIClient::SendMessageWithImages(
 	// Also set prompt for backwards compatibility
 	JsonObject->SetStringField(TEXT("prompt"), Message);
 
-	// Add conversation history if present
-	if (History.Num() > 0)
-	{
-		TArray<TSharedPtr<FJsonValue>> MessagesArray;
-		for (const FConversationMessage& Msg : History)
-		{
-			MessagesArray.Add(MakeShareable(new FJsonValueObject(Msg.ToJson())));
-		}
-		JsonObject->SetArrayField(TEXT("messages"), MessagesArray);
-	}
+	// Add conversation history (only the unacknowledged tail in delta mode)
+	AddHistoryToPayload(JsonObject.ToSharedRef(), History, *Session);
 
-	// Load and add runtime settings (same as SendMessageWithHistory)
-	FString SettingsFilePath = FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("settings.json");
-	FString SettingsContent;
-	if (FFileHelper::LoadFileToString(SettingsContent, *SettingsFilePath))
+	// Add runtime settings (parsed once, reloaded only when the file changes)
+	TSharedPtr<FJsonObject> SettingsObject = BuildSettingsObject(ModelID);
+	if (SettingsObject.IsValid())
 	{
-		TSharedPtr<FJsonObject> SettingsJsonObject;
-		TSharedRef<TJsonReader<>> SettingsReader = TJsonReaderFactory<>::Create(SettingsContent);
-
-		if (FJsonSerializer::Deserialize(SettingsReader, SettingsJsonObject) && SettingsJsonObject.IsValid())
-		{
-			TSharedPtr<FJsonObject> SettingsObject = MakeShareable(new FJsonObject());
-
-			double MaxCostPerQuery = 0.0;
-			if (SettingsJsonObject->TryGetNumberField(TEXT("MaxCostPerQuery"), MaxCostPerQuery) && MaxCostPerQuery > 0.0)
-			{
-				SettingsObject->SetNumberField(TEXT("max_cost_per_query"), MaxCostPerQuery);
-			}
-
-			int32 MaxTokens = 0;
-			if (SettingsJsonObject->TryGetNumberField(TEXT("MaxTokens"), MaxTokens) && MaxTokens > 0)
-			{
-				SettingsObject->SetNumberField(TEXT("max_tokens"), MaxTokens);
-			}
-
-			bool bEnableThinking = false;
-			if (SettingsJsonObject->TryGetBoolField(TEXT("EnableThinking"), bEnableThinking))
-			{
-				SettingsObject->SetBoolField(TEXT("enable_thinking"), bEnableThinking);
-			}
-
-			int32 MaxThinkingTokens = 0;
-			if (SettingsJsonObject->TryGetNumberField(TEXT("MaxThinkingTokens"), MaxThinkingTokens) && MaxThinkingTokens > 0)
-			{
-				SettingsObject->SetNumberField(TEXT("max_thinking_tokens"), MaxThinkingTokens);
-			}
-
-			FString ReasoningEffort;
-			if (SettingsJsonObject->TryGetStringField(TEXT("ReasoningEffort"), ReasoningEffort) && !ReasoningEffort.IsEmpty())
-			{
-				SettingsObject->SetStringField(TEXT("reasoning_effort"), ReasoningEffort);
-			}
-
-			const TSharedPtr<FJsonObject>* RoutingObj;
-			if (SettingsJsonObject->TryGetObjectField(TEXT("ProviderRouting"), RoutingObj) && RoutingObj->IsValid())
-			{
-				const TSharedPtr<FJsonObject>* ModelRoutingObj;
-				if ((*RoutingObj)->TryGetObjectField(ModelID, ModelRoutingObj) && ModelRoutingObj->IsValid())
-				{
-					TSharedPtr<FJsonObject> ProviderRoutingObject = MakeShareable(new FJsonObject());
-
-					FString Provider;
-					if ((*ModelRoutingObj)->TryGetStringField(TEXT("provider"), Provider))
-					{
-						ProviderRoutingObject->SetStringField(TEXT("provider"), Provider);
-					}
-
-					FString SortBy;
-					if ((*ModelRoutingObj)->TryGetStringField(TEXT("sort_by"), SortBy))
-					{
-						ProviderRoutingObject->SetStringField(TEXT("sort_by"), SortBy);
-					}
-
-					bool bAllowFallbacks = true;
-					if ((*ModelRoutingObj)->TryGetBoolField(TEXT("allow_fallbacks"), bAllowFallbacks))
-					{
-						ProviderRoutingObject->SetBoolField(TEXT("allow_fallbacks"), bAllowFallbacks);
-					}
-
-					SettingsObject->SetObjectField(TEXT("provider_routing"), ProviderRoutingObject);
-				}
-			}
-
-			JsonObject->SetObjectField(TEXT("settings"), SettingsObject);
-		}
+		JsonObject->SetObjectField(TEXT("settings"), SettingsObject);
 	}
 
-	FString RequestBody;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&RequestBody);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-
-	// Configure request
-	FString URL = Settings->BackendURL + TEXT("/ai");
-	Request->SetURL(URL);
-	Request->SetVerb(TEXT("POST"));
-	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
-	Request->SetHeader(TEXT("X-API-Key"), Settings->APIKey);
-	Request->SetContentAsString(RequestBody);
-
-	// Capture session ID for callbacks
-	FString SessionID = CurrentSessionID;
-
-	// Bind response callback
-	Request->OnProcessRequestComplete().BindStatic(
-		&FNeoStackAPIClient::OnResponseReceived,
-		SessionID,
-		OnContent,
-		OnReasoning,
-		OnToolCall,
-		OnUE5ToolCall,
-		OnToolResult,
-		OnComplete,
-		OnCost,
-		OnError
-	);
-
-	// Bind progress callback for streaming
-	Request->OnRequestProgress64().BindStatic(
-		&FNeoStackAPIClient::OnRequestProgress,
-		SessionID,
-		OnContent,
-		OnReasoning,
-		OnToolCall,
-		OnUE5ToolCall,
-		OnToolResult,
-		OnComplete,
-		OnCost
-	);
-
-	// Send request
-	if (!Request->ProcessRequest())
-	{
-		OnError.ExecuteIfBound(TEXT("Failed to send HTTP request"));
-	}
+	Session->Payload = JsonObject;
+	return SendPayload(Session);
 }
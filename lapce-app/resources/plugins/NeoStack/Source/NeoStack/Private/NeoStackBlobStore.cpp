@@ -0,0 +1,178 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackBlobStore.h"
+#include "NeoStackConversation.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Base64.h"
+#include "Misc/SecureHash.h"
+
+namespace
+{
+	FString HashBytes(const uint8* Data, int64 Num)
+	{
+		FSHA1 Sha;
+		Sha.Update(Data, static_cast<uint64>(Num));
+		Sha.Final();
+
+		FSHAHash Hash;
+		Sha.GetHash(Hash.Hash);
+		return Hash.ToString();
+	}
+}
+
+FString FNeoStackBlobStore::GetBlobsDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("Blobs");
+}
+
+FString FNeoStackBlobStore::GetBlobPath(const FString& Hash)
+{
+	return GetBlobsDir() / Hash.Left(2) / Hash;
+}
+
+FString FNeoStackBlobStore::StoreBytes(const TArray<uint8>& Bytes, const FString& KnownHash)
+{
+	const FString Hash = KnownHash.IsEmpty() ? HashBytes(Bytes.GetData(), Bytes.Num()) : KnownHash;
+	const FString Path = GetBlobPath(Hash);
+
+	IFileManager& FileManager = IFileManager::Get();
+	if (FileManager.FileExists(*Path))
+	{
+		// Same hash, same content - nothing to do
+		return Hash;
+	}
+
+	// Write to a temporary name first so a crash never leaves a truncated blob under its hash
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !FileManager.Move(*Path, *TempPath, true, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to write blob %s"), *Hash);
+		FileManager.Delete(*TempPath, false, false, true);
+		return FString();
+	}
+
+	return Hash;
+}
+
+FString FNeoStackBlobStore::StoreText(const FString& Text)
+{
+	FTCHARToUTF8 Utf8(*Text);
+	TArray<uint8> Bytes(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	return StoreBytes(Bytes);
+}
+
+bool FNeoStackBlobStore::LoadBytes(const FString& Hash, TArray<uint8>& OutBytes)
+{
+	if (Hash.IsEmpty() || !FFileHelper::LoadFileToArray(OutBytes, *GetBlobPath(Hash), FILEREAD_Silent))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Missing blob %s"), *Hash);
+		return false;
+	}
+	return true;
+}
+
+bool FNeoStackBlobStore::LoadText(const FString& Hash, FString& OutText)
+{
+	TArray<uint8> Bytes;
+	if (!LoadBytes(Hash, Bytes))
+	{
+		return false;
+	}
+
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+	OutText = FString(Converted.Length(), Converted.Get());
+	return true;
+}
+
+void FNeoStackBlobStore::Externalize(FConversationMessage& Message, int32 Threshold)
+{
+	if (Threshold <= 0)
+	{
+		return;
+	}
+
+	// Tool results are the only free-form content that gets large; prose stays inline for search and titles
+	if (Message.Role == TEXT("tool") && Message.Content.Len() > Threshold)
+	{
+		const FString Hash = StoreText(Message.Content);
+		if (!Hash.IsEmpty())
+		{
+			Message.ContentBlob = Hash;
+			Message.Content.Empty();
+		}
+	}
+
+	for (FConversationImage& Image : Message.Images)
+	{
+		if (Image.Base64Data.Len() <= Threshold)
+		{
+			continue;
+		}
+
+		// Images are stored as their PNG bytes, keyed by the hash the pipeline already computed
+		TArray<uint8> Png;
+		if (!FBase64::Decode(Image.Base64Data, Png))
+		{
+			continue;
+		}
+
+		const FString Hash = StoreBytes(Png, Image.Hash);
+		if (!Hash.IsEmpty())
+		{
+			Image.Hash = Hash;
+			Image.Blob = Hash;
+			Image.Base64Data.Empty();
+		}
+	}
+}
+
+bool FNeoStackBlobStore::NeedsResolve(const FConversationMessage& Message)
+{
+	if (!Message.ContentBlob.IsEmpty() && Message.Content.IsEmpty())
+	{
+		return true;
+	}
+
+	for (const FConversationImage& Image : Message.Images)
+	{
+		if (!Image.Blob.IsEmpty() && Image.Base64Data.IsEmpty())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FNeoStackBlobStore::Resolve(FConversationMessage& Message)
+{
+	if (!Message.ContentBlob.IsEmpty() && Message.Content.IsEmpty())
+	{
+		LoadText(Message.ContentBlob, Message.Content);
+	}
+
+	for (FConversationImage& Image : Message.Images)
+	{
+		if (!Image.Blob.IsEmpty() && Image.Base64Data.IsEmpty())
+		{
+			TArray<uint8> Png;
+			if (LoadBytes(Image.Blob, Png))
+			{
+				Image.Base64Data = FBase64::Encode(Png);
+			}
+		}
+	}
+}
+
+void FNeoStackBlobStore::ResolveAll(TArray<FConversationMessage>& Messages)
+{
+	for (FConversationMessage& Message : Messages)
+	{
+		if (NeedsResolve(Message))
+		{
+			Resolve(Message);
+		}
+	}
+}
@@ -0,0 +1,657 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackContextIndex.h"
+#include "NeoStackProjectCatalog.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "Engine/Blueprint.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstance.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Async/Async.h"
+#include "Tools/FuzzyMatchingUtils.h"
+
+namespace
+{
+	constexpr int32 MatchScore = 16;
+	constexpr int32 ConsecutiveBonus = 12;
+	constexpr int32 WordStartBonus = 10;
+	constexpr int32 SubstringBonus = 24;
+	constexpr int32 PrefixBonus = 24;
+	constexpr int32 ExactBonus = 64;
+	constexpr int32 MaxGapPenalty = 8;
+
+	/** Cheap-score candidates kept per result slot for the FFuzzyMatchingUtils pass */
+	constexpr int32 RerankFactor = 4;
+
+	/** Points an enhanced fuzzy score of 1.0 is worth next to ScoreFuzzy */
+	constexpr float EnhancedScoreWeight = 200.0f;
+
+	bool IsWordStart(const FString& Text, int32 Index)
+	{
+		if (Index == 0)
+		{
+			return true;
+		}
+
+		const TCHAR Prev = Text[Index - 1];
+		const TCHAR Cur = Text[Index];
+		if (Prev == TEXT('_') || Prev == TEXT('-') || Prev == TEXT('.') || Prev == TEXT('/') || Prev == TEXT(' '))
+		{
+			return true;
+		}
+
+		// camelCase boundary
+		return FChar::IsUpper(Cur) && FChar::IsLower(Prev);
+	}
+}
+
+FNeoStackContextIndex& FNeoStackContextIndex::Get()
+{
+	static FNeoStackContextIndex Instance;
+	return Instance;
+}
+
+void FNeoStackContextIndex::EnsureBuilt()
+{
+	check(IsInGameThread());
+
+	if (bStarted || bShutdown)
+	{
+		return;
+	}
+	bStarted = true;
+
+	// Assets come from the shared catalog, which rebuilds itself once the initial discovery is complete
+	FNeoStackProjectCatalog& Catalog = FNeoStackProjectCatalog::Get();
+	Catalog.EnsureBuilt();
+	Catalog.OnAssetChanged().AddRaw(this, &FNeoStackContextIndex::HandleCatalogAssetChanged);
+	Catalog.OnRebuilt().AddRaw(this, &FNeoStackContextIndex::HandleCatalogRebuilt);
+
+	WatchSourceDirectories();
+
+	StartBuild();
+}
+
+void FNeoStackContextIndex::Shutdown()
+{
+	if (bShutdown)
+	{
+		return;
+	}
+	bShutdown = true;
+
+	if (!bStarted)
+	{
+		return;
+	}
+
+	FNeoStackProjectCatalog::Get().OnAssetChanged().RemoveAll(this);
+	FNeoStackProjectCatalog::Get().OnRebuilt().RemoveAll(this);
+
+	UnwatchSourceDirectories();
+
+	Entries.Empty();
+	EntryByPath.Empty();
+	PendingChanges.Empty();
+}
+
+void FNeoStackContextIndex::StartBuild()
+{
+	if (bBuilding)
+	{
+		bRebuildQueued = true;
+		return;
+	}
+	bBuilding = true;
+	bRebuildQueued = false;
+
+	// Registry queries stay on the game thread; turning them into entries does not
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	// Class sets let entries be typed by class path without touching UClass off the game thread
+	AssetClasses.Blueprints.Reset();
+	AssetClasses.Materials.Reset();
+	AssetRegistry.GetDerivedClassNames({ UBlueprint::StaticClass()->GetClassPathName() }, {}, AssetClasses.Blueprints);
+	AssetRegistry.GetDerivedClassNames({ UMaterial::StaticClass()->GetClassPathName(), UMaterialInstance::StaticClass()->GetClassPathName() }, {}, AssetClasses.Materials);
+	AssetClasses.Blueprints.Add(UBlueprint::StaticClass()->GetClassPathName());
+	AssetClasses.Materials.Add(UMaterial::StaticClass()->GetClassPathName());
+	AssetClasses.Materials.Add(UMaterialInstance::StaticClass()->GetClassPathName());
+
+	// Only the offered classes are copied out of the catalog; the rest of the work is off-thread
+	const FNeoStackProjectCatalog& Catalog = FNeoStackProjectCatalog::Get();
+	TBitArray<> OfferedClasses(false, Catalog.NumClassIds());
+	for (int32 ClassId = 0; ClassId < Catalog.NumClassIds(); ++ClassId)
+	{
+		const FTopLevelAssetPath& ClassPath = Catalog.GetClassPathById(ClassId);
+		OfferedClasses[ClassId] = AssetClasses.Blueprints.Contains(ClassPath) || AssetClasses.Materials.Contains(ClassPath);
+	}
+
+	TArray<FCatalogAsset> Assets;
+	for (int32 Row = 0; Row < Catalog.Num(); ++Row)
+	{
+		if (OfferedClasses[Catalog.GetClassId(Row)])
+		{
+			Assets.Add(MakeCatalogAsset(Row));
+		}
+	}
+
+	const FString ProjectDir = FPaths::ProjectDir();
+	TArray<FString> SourceDirs = GetSourceDirectories();
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	Async(EAsyncExecution::ThreadPool, [Assets = MoveTemp(Assets), Classes = AssetClasses, SourceDirs = MoveTemp(SourceDirs), ProjectDir, StartTime]()
+	{
+		TArray<FEntry> Built;
+
+		for (const FString& Directory : SourceDirs)
+		{
+			TArray<FString> FoundFiles;
+			IFileManager::Get().FindFilesRecursive(FoundFiles, *Directory, TEXT("*.h"), true, false);
+			IFileManager::Get().FindFilesRecursive(FoundFiles, *Directory, TEXT("*.cpp"), true, false);
+
+			for (const FString& FilePath : FoundFiles)
+			{
+				FEntry Entry;
+				if (MakeFileEntry(FilePath, ProjectDir, Entry))
+				{
+					Built.Add(MoveTemp(Entry));
+				}
+			}
+		}
+
+		Built.Reserve(Built.Num() + Assets.Num());
+		for (const FCatalogAsset& Asset : Assets)
+		{
+			FEntry Entry;
+			if (MakeAssetEntry(Asset, Classes, Entry))
+			{
+				Built.Add(MoveTemp(Entry));
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [Built = MoveTemp(Built), StartTime]() mutable
+		{
+			UE_LOG(LogTemp, Log, TEXT("[NeoStack] Context index built: %d entries in %.1f ms"), Built.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+			FNeoStackContextIndex::Get().FinishBuild(MoveTemp(Built));
+		});
+	});
+}
+
+void FNeoStackContextIndex::FinishBuild(TArray<FEntry>&& Built)
+{
+	bBuilding = false;
+	if (bShutdown)
+	{
+		return;
+	}
+
+	Entries.Reset();
+	EntryByPath.Reset();
+	Entries.Reserve(Built.Num());
+	for (FEntry& Entry : Built)
+	{
+		AddEntry(MoveTemp(Entry));
+	}
+
+	TArray<FPendingChange> Changes = MoveTemp(PendingChanges);
+	PendingChanges.Reset();
+	for (FPendingChange& Change : Changes)
+	{
+		ApplyChange(MoveTemp(Change));
+	}
+
+	bReady = true;
+	UpdatedEvent.Broadcast();
+
+	if (bRebuildQueued)
+	{
+		StartBuild();
+	}
+}
+
+FNeoStackContextIndex::FEntry FNeoStackContextIndex::MakeEntry(FContextItem&& Item)
+{
+	FEntry Entry;
+	Entry.LowerName = Item.DisplayName.ToLower();
+	Entry.LowerPath = Item.FullPath.ToLower();
+	Entry.Item = MoveTemp(Item);
+	return Entry;
+}
+
+FNeoStackContextIndex::FCatalogAsset FNeoStackContextIndex::MakeCatalogAsset(int32 Row)
+{
+	const FNeoStackProjectCatalog& Catalog = FNeoStackProjectCatalog::Get();
+
+	FCatalogAsset Asset;
+	Asset.AssetName = Catalog.GetAssetName(Row).ToString();
+	Asset.ObjectPath = Catalog.GetObjectPath(Row);
+	Asset.ClassPath = Catalog.GetClassPath(Row);
+	return Asset;
+}
+
+bool FNeoStackContextIndex::MakeAssetEntry(const FCatalogAsset& Asset, const FAssetClasses& Classes, FEntry& OutEntry)
+{
+	const FString& AssetName = Asset.AssetName;
+	EContextItemType Type;
+
+	if (Classes.Materials.Contains(Asset.ClassPath))
+	{
+		Type = EContextItemType::Material;
+	}
+	else if (Classes.Blueprints.Contains(Asset.ClassPath))
+	{
+		// Same naming heuristic the popup has always used for widget blueprints
+		Type = (AssetName.Contains(TEXT("Widget")) || AssetName.StartsWith(TEXT("WBP_")) || AssetName.StartsWith(TEXT("W_")))
+			? EContextItemType::Widget
+			: EContextItemType::Blueprint;
+	}
+	else
+	{
+		return false;
+	}
+
+	OutEntry = MakeEntry(FContextItem(AssetName, Asset.ObjectPath, Type));
+	return true;
+}
+
+bool FNeoStackContextIndex::MakeFileEntry(const FString& AbsolutePath, const FString& ProjectDir, FEntry& OutEntry)
+{
+	const FString Extension = FPaths::GetExtension(AbsolutePath).ToLower();
+	if (Extension != TEXT("h") && Extension != TEXT("cpp"))
+	{
+		return false;
+	}
+
+	FString RelativePath = AbsolutePath;
+	FPaths::NormalizeFilename(RelativePath);
+	FPaths::MakePathRelativeTo(RelativePath, *ProjectDir);
+
+	const EContextItemType Type = Extension == TEXT("h") ? EContextItemType::CppHeader : EContextItemType::CppSource;
+	OutEntry = MakeEntry(FContextItem(FPaths::GetCleanFilename(AbsolutePath), RelativePath, Type));
+	return true;
+}
+
+void FNeoStackContextIndex::AddEntry(FEntry&& Entry)
+{
+	if (const int32* Existing = EntryByPath.Find(Entry.Item.FullPath))
+	{
+		Entries[*Existing] = MoveTemp(Entry);
+		return;
+	}
+
+	const FString Path = Entry.Item.FullPath;
+	EntryByPath.Add(Path, Entries.Add(MoveTemp(Entry)));
+}
+
+bool FNeoStackContextIndex::RemoveEntry(const FString& FullPath)
+{
+	int32 Index;
+	if (!EntryByPath.RemoveAndCopyValue(FullPath, Index))
+	{
+		return false;
+	}
+
+	Entries.RemoveAtSwap(Index);
+	if (Entries.IsValidIndex(Index))
+	{
+		EntryByPath.Add(Entries[Index].Item.FullPath, Index);
+	}
+	return true;
+}
+
+bool FNeoStackContextIndex::ApplyChange(FPendingChange&& Change)
+{
+	if (bBuilding)
+	{
+		PendingChanges.Add(MoveTemp(Change));
+		return false;
+	}
+
+	if (Change.bRemove)
+	{
+		return RemoveEntry(Change.Entry.Item.FullPath);
+	}
+
+	AddEntry(MoveTemp(Change.Entry));
+	return true;
+}
+
+void FNeoStackContextIndex::HandleCatalogRebuilt()
+{
+	StartBuild();
+}
+
+void FNeoStackContextIndex::HandleCatalogAssetChanged(const FString& ObjectPath, bool bRemoved)
+{
+	FPendingChange Change;
+	if (bRemoved)
+	{
+		Change.bRemove = true;
+		Change.Entry.Item.FullPath = ObjectPath;
+	}
+	else
+	{
+		const int32 Row = FNeoStackProjectCatalog::Get().FindByObjectPath(ObjectPath);
+		if (Row == INDEX_NONE || !MakeAssetEntry(MakeCatalogAsset(Row), AssetClasses, Change.Entry))
+		{
+			// An update can turn an offered asset into one that isn't, so drop any old entry
+			Change.bRemove = true;
+			Change.Entry.Item.FullPath = ObjectPath;
+		}
+	}
+
+	if (ApplyChange(MoveTemp(Change)))
+	{
+		UpdatedEvent.Broadcast();
+	}
+}
+
+void FNeoStackContextIndex::HandleSourceChanged(const TArray<FFileChangeData>& Changes)
+{
+	const FString ProjectDir = FPaths::ProjectDir();
+	bool bChanged = false;
+
+	for (const FFileChangeData& Change : Changes)
+	{
+		if (Change.Action == FFileChangeData::FCA_RescanRequired)
+		{
+			StartBuild();
+			return;
+		}
+
+		FPendingChange Pending;
+		if (!MakeFileEntry(Change.Filename, ProjectDir, Pending.Entry))
+		{
+			continue;
+		}
+
+		if (Change.Action == FFileChangeData::FCA_Added)
+		{
+			bChanged |= ApplyChange(MoveTemp(Pending));
+		}
+		else if (Change.Action == FFileChangeData::FCA_Removed)
+		{
+			Pending.bRemove = true;
+			bChanged |= ApplyChange(MoveTemp(Pending));
+		}
+	}
+
+	if (bChanged)
+	{
+		UpdatedEvent.Broadcast();
+	}
+}
+
+void FNeoStackContextIndex::WatchSourceDirectories()
+{
+	FDirectoryWatcherModule& WatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+	IDirectoryWatcher* Watcher = WatcherModule.Get();
+	if (!Watcher)
+	{
+		return;
+	}
+
+	for (const FString& Directory : GetSourceDirectories())
+	{
+		FDelegateHandle Handle;
+		if (Watcher->RegisterDirectoryChangedCallback_Handle(
+			Directory,
+			IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FNeoStackContextIndex::HandleSourceChanged),
+			Handle))
+		{
+			WatchHandles.Emplace(Directory, Handle);
+		}
+	}
+}
+
+void FNeoStackContextIndex::UnwatchSourceDirectories()
+{
+	if (FDirectoryWatcherModule* WatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* Watcher = WatcherModule->Get())
+		{
+			for (const TPair<FString, FDelegateHandle>& Watch : WatchHandles)
+			{
+				Watcher->UnregisterDirectoryChangedCallback_Handle(Watch.Key, Watch.Value);
+			}
+		}
+	}
+	WatchHandles.Empty();
+}
+
+TArray<FString> FNeoStackContextIndex::GetSourceDirectories()
+{
+	TArray<FString> Directories;
+
+	const FString SourceDir = FPaths::ProjectDir() / TEXT("Source");
+	if (IFileManager::Get().DirectoryExists(*SourceDir))
+	{
+		Directories.Add(SourceDir);
+	}
+
+	const FString PluginsDir = FPaths::ProjectDir() / TEXT("Plugins");
+	TArray<FString> PluginDirs;
+	IFileManager::Get().FindFiles(PluginDirs, *(PluginsDir / TEXT("*")), false, true);
+	for (const FString& PluginDir : PluginDirs)
+	{
+		const FString PluginSourceDir = PluginsDir / PluginDir / TEXT("Source");
+		if (IFileManager::Get().DirectoryExists(*PluginSourceDir))
+		{
+			Directories.Add(PluginSourceDir);
+		}
+	}
+
+	return Directories;
+}
+
+FString FNeoStackContextIndex::GetCategoryName(EContextItemType Type)
+{
+	switch (Type)
+	{
+	case EContextItemType::CppHeader:
+	case EContextItemType::CppSource:
+		return TEXT("C++ Files");
+	case EContextItemType::Material:
+		return TEXT("Materials");
+	default:
+		return TEXT("Blueprints");
+	}
+}
+
+int32 FNeoStackContextIndex::ScoreFuzzy(const FString& LowerQuery, const FString& LowerText, const FString& Text)
+{
+	const int32 QueryLen = LowerQuery.Len();
+	const int32 TextLen = LowerText.Len();
+	if (QueryLen == 0)
+	{
+		return 0;
+	}
+	if (QueryLen > TextLen)
+	{
+		return INDEX_NONE;
+	}
+
+	// A contiguous match beats any scattered one; earlier and on a word start is better
+	const int32 Found = LowerText.Find(LowerQuery, ESearchCase::CaseSensitive);
+	if (Found != INDEX_NONE)
+	{
+		int32 Score = QueryLen * MatchScore + (QueryLen - 1) * ConsecutiveBonus + SubstringBonus;
+		if (IsWordStart(Text, Found))
+		{
+			Score += WordStartBonus;
+		}
+		if (Found == 0)
+		{
+			Score += PrefixBonus;
+		}
+		if (QueryLen == TextLen)
+		{
+			Score += ExactBonus;
+		}
+		return FMath::Max(0, Score - FMath::Min(Found, MaxGapPenalty) - (TextLen - QueryLen) / 8);
+	}
+
+	// Subsequence, taking each query character at its first position after the previous one
+	int32 Score = 0;
+	int32 QueryPos = 0;
+	int32 LastMatch = INDEX_NONE;
+	for (int32 i = 0; i < TextLen && QueryPos < QueryLen; ++i)
+	{
+		if (LowerText[i] != LowerQuery[QueryPos])
+		{
+			continue;
+		}
+
+		Score += MatchScore;
+		if (LastMatch != INDEX_NONE)
+		{
+			Score += (LastMatch == i - 1) ? ConsecutiveBonus : -FMath::Min(i - LastMatch - 1, MaxGapPenalty);
+		}
+		if (IsWordStart(Text, i))
+		{
+			Score += WordStartBonus;
+		}
+
+		LastMatch = i;
+		++QueryPos;
+	}
+
+	if (QueryPos < QueryLen)
+	{
+		return INDEX_NONE;
+	}
+
+	return FMath::Max(0, Score - (TextLen - QueryLen) / 8);
+}
+
+void FNeoStackContextIndex::Query(const FString& Filter, int32 MaxResults, TArray<FContextItem>& OutItems) const
+{
+	OutItems.Reset();
+	if (MaxResults <= 0)
+	{
+		return;
+	}
+
+	static const EContextItemType CategoryOrder[] = { EContextItemType::CppSource, EContextItemType::Blueprint, EContextItemType::Material };
+
+	if (Filter.IsEmpty())
+	{
+		// Category order, the way the popup has always listed things before any typing
+		int32 Count = 0;
+		for (const EContextItemType Category : CategoryOrder)
+		{
+			const FString CategoryName = GetCategoryName(Category);
+			bool bHeaderAdded = false;
+
+			for (const FEntry& Entry : Entries)
+			{
+				if (Count >= MaxResults)
+				{
+					return;
+				}
+				if (GetCategoryName(Entry.Item.Type) != CategoryName)
+				{
+					continue;
+				}
+
+				if (!bHeaderAdded)
+				{
+					OutItems.Add(FContextItem::Category(CategoryName));
+					bHeaderAdded = true;
+				}
+				OutItems.Add(Entry.Item);
+				++Count;
+			}
+		}
+		return;
+	}
+
+	const FString LowerFilter = Filter.ToLower();
+
+	struct FMatch
+	{
+		int32 Score;
+		int32 Index;
+	};
+
+	// Min-heap of the best candidates: the root is the weakest match kept so far
+	const int32 MaxCandidates = MaxResults * RerankFactor;
+	auto WeakerFirst = [](const FMatch& A, const FMatch& B) { return A.Score < B.Score; };
+	TArray<FMatch> Best;
+	Best.Reserve(MaxCandidates + 1);
+
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		const FEntry& Entry = Entries[i];
+
+		// Name matches count double against matches that only hit the path
+		const int32 NameScore = ScoreFuzzy(LowerFilter, Entry.LowerName, Entry.Item.DisplayName);
+		int32 Score = NameScore != INDEX_NONE ? NameScore * 2 : INDEX_NONE;
+		if (NameScore == INDEX_NONE || Entry.LowerPath.Len() > Entry.LowerName.Len())
+		{
+			Score = FMath::Max(Score, ScoreFuzzy(LowerFilter, Entry.LowerPath, Entry.Item.FullPath));
+		}
+
+		if (Score == INDEX_NONE)
+		{
+			continue;
+		}
+
+		if (Best.Num() < MaxCandidates)
+		{
+			Best.HeapPush(FMatch{ Score, i }, WeakerFirst);
+		}
+		else if (Score > Best.HeapTop().Score)
+		{
+			Best.HeapPopDiscard(WeakerFirst);
+			Best.HeapPush(FMatch{ Score, i }, WeakerFirst);
+		}
+	}
+
+	// Only the survivors get the full word/acronym/edit-distance scoring the node search uses
+	for (FMatch& Match : Best)
+	{
+		Match.Score += FMath::RoundToInt(FFuzzyMatchingUtils::CalculateEnhancedFuzzyScore(Filter, Entries[Match.Index].Item.DisplayName) * EnhancedScoreWeight);
+	}
+
+	Best.Sort([this](const FMatch& A, const FMatch& B)
+	{
+		if (A.Score != B.Score)
+		{
+			return A.Score > B.Score;
+		}
+		return Entries[A.Index].Item.DisplayName.Len() < Entries[B.Index].Item.DisplayName.Len();
+	});
+	if (Best.Num() > MaxResults)
+	{
+		Best.SetNum(MaxResults);
+	}
+
+	// Group under headers; categories appear in the order of their best match
+	TArray<FString> Categories;
+	TMap<FString, TArray<int32>> ByCategory;
+	for (const FMatch& Match : Best)
+	{
+		const FString CategoryName = GetCategoryName(Entries[Match.Index].Item.Type);
+		TArray<int32>* Group = ByCategory.Find(CategoryName);
+		if (!Group)
+		{
+			Categories.Add(CategoryName);
+			Group = &ByCategory.Add(CategoryName);
+		}
+		Group->Add(Match.Index);
+	}
+
+	for (const FString& CategoryName : Categories)
+	{
+		OutItems.Add(FContextItem::Category(CategoryName));
+		for (const int32 Index : ByCategory[CategoryName])
+		{
+			OutItems.Add(Entries[Index].Item);
+		}
+	}
+}
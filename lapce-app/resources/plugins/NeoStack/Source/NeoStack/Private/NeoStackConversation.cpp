@@ -6,13 +6,24 @@
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFilemanager.h"
+#include "NeoStackPersistenceWriter.h"
+#include "NeoStackBlobStore.h"
+#include "NeoStackSettings.h"
 
 TSharedPtr<FJsonObject> FConversationMessage::ToJson() const
 {
 	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	if (!ID.IsEmpty())
+	{
+		JsonObject->SetStringField(TEXT("id"), ID);
+	}
 	JsonObject->SetStringField(TEXT("role"), Role);
 
-	if (!Content.IsEmpty())
+	if (!ContentBlob.IsEmpty() && Content.IsEmpty())
+	{
+		JsonObject->SetStringField(TEXT("content_blob"), ContentBlob);
+	}
+	else if (!Content.IsEmpty())
 	{
 		JsonObject->SetStringField(TEXT("content"), Content);
 	}
@@ -47,8 +58,19 @@ TSharedPtr<FJsonObject> FConversationMessage::ToJson() const
 		for (const FConversationImage& Img : Images)
 		{
 			TSharedPtr<FJsonObject> ImgJson = MakeShareable(new FJsonObject());
-			ImgJson->SetStringField(TEXT("base64"), Img.Base64Data);
+			if (!Img.Blob.IsEmpty() && Img.Base64Data.IsEmpty())
+			{
+				ImgJson->SetStringField(TEXT("blob"), Img.Blob);
+			}
+			else
+			{
+				ImgJson->SetStringField(TEXT("base64"), Img.Base64Data);
+			}
 			ImgJson->SetStringField(TEXT("mime_type"), Img.MimeType);
+			if (!Img.Hash.IsEmpty())
+			{
+				ImgJson->SetStringField(TEXT("hash"), Img.Hash);
+			}
 			ImagesArray.Add(MakeShareable(new FJsonValueObject(ImgJson)));
 		}
 		JsonObject->SetArrayField(TEXT("images"), ImagesArray);
@@ -66,8 +88,10 @@ FConversationMessage FConversationMessage::FromJson(const TSharedPtr<FJsonObject
 		return Msg;
 	}
 
+	JsonObject->TryGetStringField(TEXT("id"), Msg.ID);
 	JsonObject->TryGetStringField(TEXT("role"), Msg.Role);
 	JsonObject->TryGetStringField(TEXT("content"), Msg.Content);
+	JsonObject->TryGetStringField(TEXT("content_blob"), Msg.ContentBlob);
 	JsonObject->TryGetStringField(TEXT("tool_call_id"), Msg.ToolCallID);
 
 	const TArray<TSharedPtr<FJsonValue>>* ToolCallsArray;
@@ -103,7 +127,9 @@ FConversationMessage FConversationMessage::FromJson(const TSharedPtr<FJsonObject
 			{
 				FConversationImage Img;
 				(*ImgObj)->TryGetStringField(TEXT("base64"), Img.Base64Data);
+				(*ImgObj)->TryGetStringField(TEXT("blob"), Img.Blob);
 				(*ImgObj)->TryGetStringField(TEXT("mime_type"), Img.MimeType);
+				(*ImgObj)->TryGetStringField(TEXT("hash"), Img.Hash);
 				Msg.Images.Add(Img);
 			}
 		}
@@ -112,21 +138,45 @@ FConversationMessage FConversationMessage::FromJson(const TSharedPtr<FJsonObject
 	return Msg;
 }
 
+namespace
+{
+	bool bConversationManagerCreated = false;
+}
+
 FNeoStackConversationManager& FNeoStackConversationManager::Get()
 {
 	static FNeoStackConversationManager Instance;
 	return Instance;
 }
 
+bool FNeoStackConversationManager::IsCreated()
+{
+	return bConversationManagerCreated;
+}
+
 FNeoStackConversationManager::FNeoStackConversationManager()
 	: CurrentConversationID(-1)
 	, NextID(1)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_LoadConversationMetadata);
+	const double StartTime = FPlatformTime::Seconds();
+	bConversationManagerCreated = true;
+
 	// Ensure directory exists
 	IFileManager& FileManager = IFileManager::Get();
 	FileManager.MakeDirectory(*GetConversationsDir(), true);
 
 	LoadMetadata();
+	ReplayJournal();
+
+	SearchIndex = MakeUnique<FNeoStackSearchIndex>(GetSearchIndexFilePath());
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Conversation metadata loaded: %d conversations in %.1f ms"), AllMetadata.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+FNeoStackConversationManager::~FNeoStackConversationManager()
+{
+	Writer.Reset();
 }
 
 FString FNeoStackConversationManager::GetConversationsDir() const
@@ -139,11 +189,26 @@ FString FNeoStackConversationManager::GetConversationFilePath(int32 Conversation
 	return GetConversationsDir() / FString::Printf(TEXT("conversation_%d.jsonl"), ConversationID);
 }
 
+FString FNeoStackConversationManager::GetIndexFilePath(int32 ConversationID) const
+{
+	return GetConversationsDir() / FString::Printf(TEXT("conversation_%d.idx"), ConversationID);
+}
+
+FString FNeoStackConversationManager::GetSearchIndexFilePath() const
+{
+	return GetConversationsDir() / TEXT("search_index.jsonl");
+}
+
 FString FNeoStackConversationManager::GetMetadataFilePath() const
 {
 	return GetConversationsDir() / TEXT("metadata.json");
 }
 
+FString FNeoStackConversationManager::GetJournalFilePath() const
+{
+	return GetConversationsDir() / TEXT("metadata.journal");
+}
+
 void FNeoStackConversationManager::LoadMetadata()
 {
 	FString MetadataPath = GetMetadataFilePath();
@@ -191,28 +256,127 @@ void FNeoStackConversationManager::LoadMetadata()
 
 void FNeoStackConversationManager::SaveMetadata()
 {
-	TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject());
-	RootObject->SetNumberField(TEXT("next_id"), NextID);
+	// Serialized on the writer thread from a snapshot
+	GetWriter().ReplaceFile(GetMetadataFilePath(), [Snapshot = AllMetadata, SnapshotNextID = NextID]()
+	{
+		TSharedPtr<FJsonObject> RootObject = MakeShareable(new FJsonObject());
+		RootObject->SetNumberField(TEXT("next_id"), SnapshotNextID);
+
+		TArray<TSharedPtr<FJsonValue>> ConversationsArray;
+		for (const FConversationMetadata& Meta : Snapshot)
+		{
+			TSharedPtr<FJsonObject> ConvObj = MakeShareable(new FJsonObject());
+			ConvObj->SetNumberField(TEXT("id"), Meta.ID);
+			ConvObj->SetStringField(TEXT("title"), Meta.Title);
+			ConvObj->SetNumberField(TEXT("message_count"), Meta.MessageCount);
+			ConvObj->SetStringField(TEXT("created_at"), Meta.CreatedAt.ToIso8601());
+			ConvObj->SetStringField(TEXT("updated_at"), Meta.UpdatedAt.ToIso8601());
+
+			ConversationsArray.Add(MakeShareable(new FJsonValueObject(ConvObj)));
+		}
+		RootObject->SetArrayField(TEXT("conversations"), ConversationsArray);
+
+		FString OutputString;
+		TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&OutputString);
+		FJsonSerializer::Serialize(RootObject.ToSharedRef(), JsonWriter);
+		return OutputString;
+	});
+
+	// Everything in the journal is now part of metadata.json (applied after the write above)
+	GetWriter().RemoveFile(GetJournalFilePath());
+	JournalEntries = 0;
+}
+
+void FNeoStackConversationManager::ReplayJournal()
+{
+	FString JournalContent;
+	if (!FFileHelper::LoadFileToString(JournalContent, *GetJournalFilePath()))
+	{
+		return;
+	}
+
+	TArray<FString> Lines;
+	JournalContent.ParseIntoArrayLines(Lines);
+
+	for (const FString& Line : Lines)
+	{
+		TSharedPtr<FJsonObject> Entry;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+		if (!FJsonSerializer::Deserialize(Reader, Entry) || !Entry.IsValid())
+		{
+			// A torn last line from a crash - everything before it is intact
+			continue;
+		}
+
+		const int32 ID = Entry->GetIntegerField(TEXT("id"));
+		for (FConversationMetadata& Meta : AllMetadata)
+		{
+			if (Meta.ID == ID)
+			{
+				Entry->TryGetNumberField(TEXT("message_count"), Meta.MessageCount);
+				Entry->TryGetStringField(TEXT("title"), Meta.Title);
+
+				FString UpdatedAtStr;
+				if (Entry->TryGetStringField(TEXT("updated_at"), UpdatedAtStr))
+				{
+					FDateTime::ParseIso8601(*UpdatedAtStr, Meta.UpdatedAt);
+				}
+				break;
+			}
+		}
+		++JournalEntries;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Replayed %d metadata journal entries"), JournalEntries);
+}
+
+void FNeoStackConversationManager::AppendJournal(const FConversationMetadata& Meta, bool bTitleChanged)
+{
+	if (JournalEntries >= MaxJournalEntries)
+	{
+		SaveMetadata();
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Entry = MakeShareable(new FJsonObject());
+	Entry->SetNumberField(TEXT("id"), Meta.ID);
+	Entry->SetNumberField(TEXT("message_count"), Meta.MessageCount);
+	Entry->SetStringField(TEXT("updated_at"), Meta.UpdatedAt.ToIso8601());
+	if (bTitleChanged)
+	{
+		Entry->SetStringField(TEXT("title"), Meta.Title);
+	}
 
-	TArray<TSharedPtr<FJsonValue>> ConversationsArray;
-	for (const FConversationMetadata& Meta : AllMetadata)
+	GetWriter().AppendLine(GetJournalFilePath(), [Entry]()
 	{
-		TSharedPtr<FJsonObject> ConvObj = MakeShareable(new FJsonObject());
-		ConvObj->SetNumberField(TEXT("id"), Meta.ID);
-		ConvObj->SetStringField(TEXT("title"), Meta.Title);
-		ConvObj->SetNumberField(TEXT("message_count"), Meta.MessageCount);
-		ConvObj->SetStringField(TEXT("created_at"), Meta.CreatedAt.ToIso8601());
-		ConvObj->SetStringField(TEXT("updated_at"), Meta.UpdatedAt.ToIso8601());
+		FString EntryLine;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&EntryLine);
+		FJsonSerializer::Serialize(Entry.ToSharedRef(), JsonWriter);
+		return EntryLine;
+	});
+	++JournalEntries;
+}
 
-		ConversationsArray.Add(MakeShareable(new FJsonValueObject(ConvObj)));
+FNeoStackPersistenceWriter& FNeoStackConversationManager::GetWriter()
+{
+	if (!Writer.IsValid())
+	{
+		const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+		Writer = MakeUnique<FNeoStackPersistenceWriter>(Settings ? Settings->PersistenceSyncInterval : 1.0f);
 	}
-	RootObject->SetArrayField(TEXT("conversations"), ConversationsArray);
+	return *Writer;
+}
 
-	FString OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-	FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer);
+void FNeoStackConversationManager::Shutdown()
+{
+	if (JournalEntries > 0)
+	{
+		SaveMetadata();
+	}
 
-	FFileHelper::SaveStringToFile(OutputString, *GetMetadataFilePath(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	// Joins the writer thread after everything queued is on disk
+	Writer.Reset();
 }
 
 int32 FNeoStackConversationManager::GenerateNextID()
@@ -244,11 +408,15 @@ void FNeoStackConversationManager::SetCurrentConversation(int32 ConversationID)
 	{
 		CurrentConversationID = ConversationID;
 		CurrentMessages.Empty();
+		CurrentOffsets.Reset();
+		CurrentFileSize = 0;
+		CurrentLoadedStart = 0;
 
-		if (ConversationID >= 0)
+		if (ConversationID >= 0 && LoadOffsetIndex(ConversationID, CurrentOffsets, CurrentFileSize))
 		{
-			// Load messages from file
-			CurrentMessages = LoadMessages(ConversationID);
+			// Only the newest page is parsed up front, older pages load on demand
+			CurrentLoadedStart = FMath::Max(0, CurrentOffsets.Num() - InitialPageSize);
+			CurrentMessages = ReadMessageRange(ConversationID, CurrentOffsets, CurrentFileSize, CurrentLoadedStart, CurrentOffsets.Num() - CurrentLoadedStart);
 		}
 	}
 }
@@ -264,31 +432,160 @@ TArray<FConversationMetadata> FNeoStackConversationManager::GetAllConversations(
 	return Sorted;
 }
 
-TArray<FConversationMessage> FNeoStackConversationManager::LoadMessages(int32 ConversationID) const
+TArray<FConversationMessage> FNeoStackConversationManager::LoadMessages(int32 ConversationID)
 {
-	TArray<FConversationMessage> Messages;
+	TArray<int64> Offsets;
+	int64 FileSize = 0;
+	if (!LoadOffsetIndex(ConversationID, Offsets, FileSize))
+	{
+		return TArray<FConversationMessage>();
+	}
+
+	return ReadMessageRange(ConversationID, Offsets, FileSize, 0, Offsets.Num());
+}
+
+bool FNeoStackConversationManager::LoadOffsetIndex(int32 ConversationID, TArray<int64>& OutOffsets, int64& OutFileSize)
+{
+	OutOffsets.Reset();
+	OutFileSize = 0;
 
-	FString FilePath = GetConversationFilePath(ConversationID);
-	FString FileContent;
+	// Make sure queued appends (and their index entries) are on disk before reading back
+	if (Writer.IsValid())
+	{
+		Writer->Flush();
+	}
 
-	if (FFileHelper::LoadFileToString(FileContent, *FilePath))
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString FilePath = GetConversationFilePath(ConversationID);
+	OutFileSize = PlatformFile.FileSize(*FilePath);
+	if (OutFileSize <= 0)
 	{
-		TArray<FString> Lines;
-		FileContent.ParseIntoArrayLines(Lines);
+		OutFileSize = 0;
+		return false;
+	}
 
-		for (const FString& Line : Lines)
+	// Fast path: the sidecar index is consistent with the data file
+	const FString IndexPath = GetIndexFilePath(ConversationID);
+	TArray<uint8> IndexBytes;
+	if (FFileHelper::LoadFileToArray(IndexBytes, *IndexPath, FILEREAD_Silent) && IndexBytes.Num() > 0 && IndexBytes.Num() % sizeof(int64) == 0)
+	{
+		const int32 Count = IndexBytes.Num() / sizeof(int64);
+		OutOffsets.SetNumUninitialized(Count);
+		FMemory::Memcpy(OutOffsets.GetData(), IndexBytes.GetData(), IndexBytes.Num());
+
+		// Exactly one complete line must follow the last indexed offset
+		const int64 LastOffset = OutOffsets.Last();
+		bool bValid = OutOffsets[0] == 0 && LastOffset < OutFileSize;
+		if (bValid)
 		{
-			if (Line.IsEmpty())
+			TUniquePtr<IFileHandle> Handle(PlatformFile.OpenRead(*FilePath, true));
+			TArray<uint8> Tail;
+			Tail.SetNumUninitialized(static_cast<int32>(OutFileSize - LastOffset));
+			bValid = Handle.IsValid() && Handle->Seek(LastOffset) && Handle->Read(Tail.GetData(), Tail.Num());
+			if (bValid)
 			{
-				continue;
+				const int32 FirstNewline = Tail.Find('\n');
+				bValid = FirstNewline == Tail.Num() - 1;
 			}
+		}
+
+		if (bValid)
+		{
+			return true;
+		}
+	}
 
-			TSharedPtr<FJsonObject> JsonObject;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+	// Missing or stale (older file, crash between data and index) - rebuild by scanning for newlines, no parsing
+	TArray<uint8> FileBytes;
+	if (!FFileHelper::LoadFileToArray(FileBytes, *FilePath))
+	{
+		return false;
+	}
 
-			if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+	OutOffsets.Reset();
+	int64 LineStart = 0;
+	for (int64 i = 0; i < FileBytes.Num(); ++i)
+	{
+		if (FileBytes[i] == '\n')
+		{
+			if (i > LineStart)
 			{
-				Messages.Add(FConversationMessage::FromJson(JsonObject));
+				OutOffsets.Add(LineStart);
+			}
+			LineStart = i + 1;
+		}
+	}
+	if (LineStart < FileBytes.Num())
+	{
+		OutOffsets.Add(LineStart);
+	}
+
+	TArray<uint8> NewIndex;
+	NewIndex.SetNumUninitialized(OutOffsets.Num() * sizeof(int64));
+	FMemory::Memcpy(NewIndex.GetData(), OutOffsets.GetData(), NewIndex.Num());
+	GetWriter().ReplaceFileBytes(IndexPath, MoveTemp(NewIndex));
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Rebuilt offset index for conversation %d (%d messages)"), ConversationID, OutOffsets.Num());
+	return OutOffsets.Num() > 0;
+}
+
+TArray<FConversationMessage> FNeoStackConversationManager::ReadMessageRange(int32 ConversationID, const TArray<int64>& Offsets, int64 FileSize, int32 Start, int32 Count,
+	TArray<int32>* OutLines) const
+{
+	TArray<FConversationMessage> Messages;
+
+	Start = FMath::Clamp(Start, 0, Offsets.Num());
+	const int32 End = FMath::Clamp(Start + Count, Start, Offsets.Num());
+	if (Start == End)
+	{
+		return Messages;
+	}
+
+	// Only the bytes of the requested lines are read
+	const int64 RangeBegin = Offsets[Start];
+	const int64 RangeEnd = End < Offsets.Num() ? Offsets[End] : FileSize;
+
+	TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*GetConversationFilePath(ConversationID), true));
+	TArray<uint8> Bytes;
+	Bytes.SetNumUninitialized(static_cast<int32>(RangeEnd - RangeBegin));
+	if (!Handle.IsValid() || !Handle->Seek(RangeBegin) || !Handle->Read(Bytes.GetData(), Bytes.Num()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to read messages %d-%d of conversation %d"), Start, End, ConversationID);
+		return Messages;
+	}
+
+	Messages.Reserve(End - Start);
+	for (int32 Line = Start; Line < End; ++Line)
+	{
+		const int64 LineBegin = Offsets[Line] - RangeBegin;
+		int64 LineEnd = (Line + 1 < Offsets.Num() ? Offsets[Line + 1] : FileSize) - RangeBegin;
+		while (LineEnd > LineBegin && (Bytes[LineEnd - 1] == '\n' || Bytes[LineEnd - 1] == '\r'))
+		{
+			--LineEnd;
+		}
+		if (LineEnd <= LineBegin)
+		{
+			continue;
+		}
+
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Bytes.GetData() + LineBegin), static_cast<int32>(LineEnd - LineBegin));
+		const FString LineString(Converted.Length(), Converted.Get());
+
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(LineString);
+
+		if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+		{
+			FConversationMessage& Msg = Messages.Add_GetRef(FConversationMessage::FromJson(JsonObject));
+
+			// Messages written before IDs existed get a deterministic one so cursors stay stable across loads
+			if (Msg.ID.IsEmpty())
+			{
+				Msg.ID = FString::Printf(TEXT("%d-%d"), ConversationID, Line);
+			}
+			if (OutLines)
+			{
+				OutLines->Add(Line);
 			}
 		}
 	}
@@ -296,6 +593,30 @@ TArray<FConversationMessage> FNeoStackConversationManager::LoadMessages(int32 Co
 	return Messages;
 }
 
+TArray<FConversationMessage> FNeoStackConversationManager::LoadOlderMessages(int32 Count)
+{
+	if (CurrentConversationID < 0 || CurrentLoadedStart <= 0 || Count <= 0)
+	{
+		return TArray<FConversationMessage>();
+	}
+
+	const int32 Start = FMath::Max(0, CurrentLoadedStart - Count);
+	TArray<FConversationMessage> Page = ReadMessageRange(CurrentConversationID, CurrentOffsets, CurrentFileSize, Start, CurrentLoadedStart - Start);
+	CurrentLoadedStart = Start;
+
+	CurrentMessages.Insert(Page, 0);
+	return Page;
+}
+
+const TArray<FConversationMessage>& FNeoStackConversationManager::GetFullCurrentMessages()
+{
+	if (CurrentLoadedStart > 0)
+	{
+		LoadOlderMessages(CurrentLoadedStart);
+	}
+	return CurrentMessages;
+}
+
 void FNeoStackConversationManager::AppendMessage(const FConversationMessage& Message)
 {
 	if (CurrentConversationID < 0)
@@ -316,22 +637,36 @@ void FNeoStackConversationManager::AppendMessage(const FConversationMessage& Mes
 		CreateConversation(Title);
 	}
 
-	// Add to in-memory list
-	CurrentMessages.Add(Message);
-
-	// Append to file (JSON Lines format - one JSON object per line)
-	TSharedPtr<FJsonObject> JsonObject = Message.ToJson();
-	FString JsonLine;
-	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
-		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonLine);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-	JsonLine += TEXT("\n");
+	// Add to in-memory list, every stored message gets an ID the backend can acknowledge
+	FConversationMessage& Stored = CurrentMessages.Add_GetRef(Message);
+	if (Stored.ID.IsEmpty())
+	{
+		Stored.ID = FGuid::NewGuid().ToString(EGuidFormats::DigitsWithHyphens);
+	}
 
-	FString FilePath = GetConversationFilePath(CurrentConversationID);
-	FFileHelper::SaveStringToFile(JsonLine, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM,
-		&IFileManager::Get(), EFileWrite::FILEWRITE_Append);
+	// Append to file (JSON Lines format - one JSON object per line). Serialization and I/O run on the
+	// writer thread; CurrentMessages above is already up to date for readers on this thread.
+	// Large payloads go to the blob store first, so the line never references a blob that is not on disk
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	const int32 BlobThreshold = Settings ? Settings->BlobThreshold : 0;
+	GetWriter().AppendLine(GetConversationFilePath(CurrentConversationID), [Snapshot = Stored, BlobThreshold]() mutable
+	{
+		FNeoStackBlobStore::Externalize(Snapshot, BlobThreshold);
+		TSharedPtr<FJsonObject> JsonObject = Snapshot.ToJson();
+		FString JsonLine;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonLine);
+		FJsonSerializer::Serialize(JsonObject.ToSharedRef(), JsonWriter);
+		return JsonLine;
+	}, GetIndexFilePath(CurrentConversationID));
+
+	// Index the text for search; tool results are left out, they are mostly noise for finding a chat
+	if ((Stored.Role == TEXT("user") || Stored.Role == TEXT("assistant")) && !Stored.Content.IsEmpty())
+	{
+		SearchIndex->AddMessage(CurrentConversationID, CurrentLoadedStart + CurrentMessages.Num() - 1, Stored.Content, GetWriter());
+	}
 
-	// Update metadata
+	// Update metadata - journaled, metadata.json is only rewritten when the journal is folded in
 	for (FConversationMetadata& Meta : AllMetadata)
 	{
 		if (Meta.ID == CurrentConversationID)
@@ -340,6 +675,7 @@ void FNeoStackConversationManager::AppendMessage(const FConversationMessage& Mes
 			Meta.UpdatedAt = FDateTime::Now();
 
 			// Update title from first user message
+			bool bTitleChanged = false;
 			if (Meta.MessageCount == 1 && Message.Role == TEXT("user") && !Message.Content.IsEmpty())
 			{
 				Meta.Title = Message.Content.Left(50);
@@ -347,11 +683,13 @@ void FNeoStackConversationManager::AppendMessage(const FConversationMessage& Mes
 				{
 					Meta.Title += TEXT("...");
 				}
+				bTitleChanged = true;
 			}
+
+			AppendJournal(Meta, bTitleChanged);
 			break;
 		}
 	}
-	SaveMetadata();
 }
 
 void FNeoStackConversationManager::UpdateTitle(int32 ConversationID, const FString& NewTitle)
@@ -377,20 +715,123 @@ void FNeoStackConversationManager::DeleteConversation(int32 ConversationID)
 	});
 	SaveMetadata();
 
-	// Delete file
-	FString FilePath = GetConversationFilePath(ConversationID);
-	IFileManager::Get().Delete(*FilePath);
+	// Delete file (after any writes to it still in flight)
+	GetWriter().RemoveFile(GetConversationFilePath(ConversationID));
+	GetWriter().RemoveFile(GetIndexFilePath(ConversationID));
+	SearchIndex->RemoveConversation(ConversationID, GetWriter());
 
 	// If this was the current conversation, clear it
 	if (CurrentConversationID == ConversationID)
 	{
-		CurrentConversationID = -1;
-		CurrentMessages.Empty();
+		ClearCurrentConversation();
+	}
+}
+
+FNeoStackSearchIndex& FNeoStackConversationManager::GetSearchIndex()
+{
+	// Entries appended since startup may still be queued on the writer thread
+	if (!SearchIndex->IsLoaded() && Writer.IsValid())
+	{
+		Writer->Flush();
+	}
+
+	if (!SearchIndex->IsLoaded() && !SearchIndex->Load())
+	{
+		// First search since the index was introduced (or the file was lost) - build it once
+		const double StartTime = FPlatformTime::Seconds();
+		SearchIndex->BeginRebuild();
+
+		for (const FConversationMetadata& Meta : AllMetadata)
+		{
+			TArray<int64> Offsets;
+			int64 FileSize = 0;
+			if (!LoadOffsetIndex(Meta.ID, Offsets, FileSize))
+			{
+				continue;
+			}
+
+			// Search reads hits back by line, so index each message under its line rather than its position
+			TArray<int32> Lines;
+			const TArray<FConversationMessage> Messages = ReadMessageRange(Meta.ID, Offsets, FileSize, 0, Offsets.Num(), &Lines);
+			for (int32 i = 0; i < Messages.Num(); ++i)
+			{
+				const FConversationMessage& Message = Messages[i];
+				if ((Message.Role == TEXT("user") || Message.Role == TEXT("assistant")) && !Message.Content.IsEmpty())
+				{
+					SearchIndex->AddMessageForRebuild(Meta.ID, Lines[i], Message.Content);
+				}
+			}
+		}
+
+		SearchIndex->SaveSnapshot(GetWriter());
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Built search index for %d conversations in %.0f ms"), AllMetadata.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
+
+	return *SearchIndex;
+}
+
+TArray<FConversationSearchHit> FNeoStackConversationManager::Search(const FString& Query, int32 MaxResults)
+{
+	TArray<FConversationSearchHit> Hits = GetSearchIndex().Search(Query, MaxResults);
+
+	// Snippets: one ranged read per hit thanks to the offset index
+	TArray<FString> QueryTerms;
+	FNeoStackSearchIndex::Tokenize(Query, QueryTerms);
+
+	for (FConversationSearchHit& Hit : Hits)
+	{
+		FString Text;
+		if (Hit.ConversationID == CurrentConversationID && Hit.MessageIndex >= CurrentLoadedStart && Hit.MessageIndex - CurrentLoadedStart < CurrentMessages.Num())
+		{
+			Text = CurrentMessages[Hit.MessageIndex - CurrentLoadedStart].Content;
+		}
+		else
+		{
+			TArray<int64> Offsets;
+			int64 FileSize = 0;
+			if (LoadOffsetIndex(Hit.ConversationID, Offsets, FileSize))
+			{
+				TArray<FConversationMessage> Message = ReadMessageRange(Hit.ConversationID, Offsets, FileSize, Hit.MessageIndex, 1);
+				if (Message.Num() > 0)
+				{
+					Text = MoveTemp(Message[0].Content);
+				}
+			}
+		}
+
+		// Center the snippet on the first query term found in the message
+		int32 MatchPos = INDEX_NONE;
+		for (const FString& Term : QueryTerms)
+		{
+			MatchPos = Text.Find(Term, ESearchCase::IgnoreCase);
+			if (MatchPos != INDEX_NONE)
+			{
+				break;
+			}
+		}
+
+		constexpr int32 SnippetContext = 40;
+		constexpr int32 SnippetLength = 120;
+		const int32 SnippetStart = MatchPos == INDEX_NONE ? 0 : FMath::Max(0, MatchPos - SnippetContext);
+		Hit.Snippet = Text.Mid(SnippetStart, SnippetLength).Replace(TEXT("\n"), TEXT(" "));
+		if (SnippetStart > 0)
+		{
+			Hit.Snippet = TEXT("...") + Hit.Snippet;
+		}
+		if (SnippetStart + SnippetLength < Text.Len())
+		{
+			Hit.Snippet += TEXT("...");
+		}
 	}
+
+	return Hits;
 }
 
 void FNeoStackConversationManager::ClearCurrentConversation()
 {
 	CurrentConversationID = -1;
 	CurrentMessages.Empty();
+	CurrentOffsets.Reset();
+	CurrentFileSize = 0;
+	CurrentLoadedStart = 0;
 }
@@ -0,0 +1,239 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackImagePipeline.h"
+#include "NeoStackSettings.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+#include "Misc/Base64.h"
+#include "Misc/SecureHash.h"
+#include "Async/Async.h"
+
+namespace
+{
+	/** Most recently processed images, keyed by source hash. Guarded by CacheLock */
+	FCriticalSection CacheLock;
+	TArray<TPair<FString, TSharedPtr<const FNeoStackProcessedImage>>> RecentImages;
+	constexpr int32 MaxRecentImages = 16;
+
+	FString HashBytes(const uint8* Data, int64 Num)
+	{
+		FSHA1 Sha;
+		Sha.Update(Data, static_cast<uint64>(Num));
+		Sha.Final();
+
+		FSHAHash Hash;
+		Sha.GetHash(Hash.Hash);
+		return Hash.ToString();
+	}
+
+	int32 GetMaxEdge()
+	{
+		const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+		return Settings ? Settings->MaxImageEdge : 0;
+	}
+}
+
+void FNeoStackImagePipeline::ProcessEncodedAsync(TArray<uint8>&& EncodedData, FOnProcessed OnProcessed)
+{
+	// Modules can only be loaded on the game thread; the wrapper factory itself is thread safe
+	IImageWrapperModule* ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	const int32 MaxEdge = GetMaxEdge();
+
+	Async(EAsyncExecution::ThreadPool, [Data = MoveTemp(EncodedData), ImageWrapperModule, MaxEdge, OnProcessed = MoveTemp(OnProcessed)]() mutable
+	{
+		const FString SourceHash = HashBytes(Data.GetData(), Data.Num()) + FString::Printf(TEXT("@%d"), MaxEdge);
+		if (TSharedPtr<const FNeoStackProcessedImage> Cached = FindCached(SourceHash))
+		{
+			Deliver(MoveTemp(OnProcessed), Cached);
+			return;
+		}
+
+		const EImageFormat Format = ImageWrapperModule->DetectImageFormat(Data.GetData(), Data.Num());
+		TSharedPtr<IImageWrapper> Wrapper = Format != EImageFormat::Invalid ? ImageWrapperModule->CreateImageWrapper(Format) : nullptr;
+
+		TArray64<uint8> Raw;
+		if (!Wrapper.IsValid() || !Wrapper->SetCompressed(Data.GetData(), Data.Num()) || !Wrapper->GetRaw(ERGBFormat::BGRA, 8, Raw))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Failed to decode image attachment"));
+			Deliver(MoveTemp(OnProcessed), nullptr);
+			return;
+		}
+
+		const int32 Width = static_cast<int32>(Wrapper->GetWidth());
+		const int32 Height = static_cast<int32>(Wrapper->GetHeight());
+
+		TArray<uint8> BGRA;
+		BGRA.SetNumUninitialized(static_cast<int32>(Raw.Num()));
+		FMemory::Memcpy(BGRA.GetData(), Raw.GetData(), Raw.Num());
+		Raw.Empty();
+
+		TSharedPtr<const FNeoStackProcessedImage> Result = ProcessPixels(BGRA, Width, Height, MaxEdge);
+		if (Result.IsValid())
+		{
+			AddCached(SourceHash, Result);
+		}
+		Deliver(MoveTemp(OnProcessed), Result);
+	});
+}
+
+void FNeoStackImagePipeline::ProcessRawAsync(TArray<uint8>&& BGRA, int32 Width, int32 Height, FOnProcessed OnProcessed)
+{
+	// Load the module here so ProcessPixels never has to on a worker
+	FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	const int32 MaxEdge = GetMaxEdge();
+
+	Async(EAsyncExecution::ThreadPool, [Pixels = MoveTemp(BGRA), Width, Height, MaxEdge, OnProcessed = MoveTemp(OnProcessed)]() mutable
+	{
+		if (Width <= 0 || Height <= 0 || Pixels.Num() != Width * Height * 4)
+		{
+			Deliver(MoveTemp(OnProcessed), nullptr);
+			return;
+		}
+
+		const FString SourceHash = HashBytes(Pixels.GetData(), Pixels.Num()) + FString::Printf(TEXT("@%dx%d@%d"), Width, Height, MaxEdge);
+		if (TSharedPtr<const FNeoStackProcessedImage> Cached = FindCached(SourceHash))
+		{
+			Deliver(MoveTemp(OnProcessed), Cached);
+			return;
+		}
+
+		TSharedPtr<const FNeoStackProcessedImage> Result = ProcessPixels(Pixels, Width, Height, MaxEdge);
+		if (Result.IsValid())
+		{
+			AddCached(SourceHash, Result);
+		}
+		Deliver(MoveTemp(OnProcessed), Result);
+	});
+}
+
+TSharedPtr<const FNeoStackProcessedImage> FNeoStackImagePipeline::ProcessRaw(TArray<uint8>& BGRA, int32 Width, int32 Height, int32 MaxEdge)
+{
+	if (Width <= 0 || Height <= 0 || BGRA.Num() != Width * Height * 4)
+	{
+		return nullptr;
+	}
+	return ProcessPixels(BGRA, Width, Height, MaxEdge);
+}
+
+TSharedPtr<const FNeoStackProcessedImage> FNeoStackImagePipeline::ProcessPixels(TArray<uint8>& BGRA, int32 Width, int32 Height, int32 MaxEdge)
+{
+	// Downscale to the configured max edge, keeping the aspect ratio
+	const int32 LongEdge = FMath::Max(Width, Height);
+	if (MaxEdge > 0 && LongEdge > MaxEdge)
+	{
+		const float Scale = static_cast<float>(MaxEdge) / LongEdge;
+		const int32 NewWidth = FMath::Max(1, FMath::RoundToInt(Width * Scale));
+		const int32 NewHeight = FMath::Max(1, FMath::RoundToInt(Height * Scale));
+
+		TArray<uint8> Scaled;
+		Downscale(BGRA, Width, Height, Scaled, NewWidth, NewHeight);
+		BGRA = MoveTemp(Scaled);
+		Width = NewWidth;
+		Height = NewHeight;
+	}
+
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::GetModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	TSharedPtr<IImageWrapper> PngWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+	if (!PngWrapper.IsValid() || !PngWrapper->SetRaw(BGRA.GetData(), BGRA.Num(), Width, Height, ERGBFormat::BGRA, 8))
+	{
+		return nullptr;
+	}
+
+	const TArray64<uint8> Png = PngWrapper->GetCompressed(90);
+	if (Png.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FNeoStackProcessedImage> Image = MakeShared<FNeoStackProcessedImage>();
+	Image->Width = Width;
+	Image->Height = Height;
+	Image->PngData.SetNumUninitialized(static_cast<int32>(Png.Num()));
+	FMemory::Memcpy(Image->PngData.GetData(), Png.GetData(), Png.Num());
+	Image->Hash = HashBytes(Image->PngData.GetData(), Image->PngData.Num());
+	Image->Base64Data = FBase64::Encode(Image->PngData);
+
+	// Preview for the attachment strip
+	const float ThumbScale = FMath::Min(1.0f, static_cast<float>(ThumbnailEdge) / FMath::Max(Width, Height));
+	Image->ThumbnailWidth = FMath::Max(1, FMath::RoundToInt(Width * ThumbScale));
+	Image->ThumbnailHeight = FMath::Max(1, FMath::RoundToInt(Height * ThumbScale));
+	Downscale(BGRA, Width, Height, Image->ThumbnailBGRA, Image->ThumbnailWidth, Image->ThumbnailHeight);
+
+	return Image;
+}
+
+void FNeoStackImagePipeline::Downscale(const TArray<uint8>& Src, int32 SrcWidth, int32 SrcHeight, TArray<uint8>& Dst, int32 DstWidth, int32 DstHeight)
+{
+	Dst.SetNumUninitialized(DstWidth * DstHeight * 4);
+
+	if (DstWidth == SrcWidth && DstHeight == SrcHeight)
+	{
+		FMemory::Memcpy(Dst.GetData(), Src.GetData(), Dst.Num());
+		return;
+	}
+
+	// Average every source pixel that falls into the destination pixel
+	for (int32 DstY = 0; DstY < DstHeight; ++DstY)
+	{
+		const int32 Y0 = DstY * SrcHeight / DstHeight;
+		const int32 Y1 = FMath::Max(Y0 + 1, (DstY + 1) * SrcHeight / DstHeight);
+
+		for (int32 DstX = 0; DstX < DstWidth; ++DstX)
+		{
+			const int32 X0 = DstX * SrcWidth / DstWidth;
+			const int32 X1 = FMath::Max(X0 + 1, (DstX + 1) * SrcWidth / DstWidth);
+
+			uint32 Sum[4] = { 0, 0, 0, 0 };
+			for (int32 Y = Y0; Y < Y1; ++Y)
+			{
+				const uint8* Row = Src.GetData() + (static_cast<int64>(Y) * SrcWidth + X0) * 4;
+				for (int32 X = X0; X < X1; ++X, Row += 4)
+				{
+					Sum[0] += Row[0];
+					Sum[1] += Row[1];
+					Sum[2] += Row[2];
+					Sum[3] += Row[3];
+				}
+			}
+
+			const uint32 Count = static_cast<uint32>((Y1 - Y0) * (X1 - X0));
+			uint8* Out = Dst.GetData() + (static_cast<int64>(DstY) * DstWidth + DstX) * 4;
+			Out[0] = static_cast<uint8>(Sum[0] / Count);
+			Out[1] = static_cast<uint8>(Sum[1] / Count);
+			Out[2] = static_cast<uint8>(Sum[2] / Count);
+			Out[3] = static_cast<uint8>(Sum[3] / Count);
+		}
+	}
+}
+
+TSharedPtr<const FNeoStackProcessedImage> FNeoStackImagePipeline::FindCached(const FString& SourceHash)
+{
+	FScopeLock Lock(&CacheLock);
+	for (const TPair<FString, TSharedPtr<const FNeoStackProcessedImage>>& Entry : RecentImages)
+	{
+		if (Entry.Key == SourceHash)
+		{
+			return Entry.Value;
+		}
+	}
+	return nullptr;
+}
+
+void FNeoStackImagePipeline::AddCached(const FString& SourceHash, const TSharedPtr<const FNeoStackProcessedImage>& Image)
+{
+	FScopeLock Lock(&CacheLock);
+	if (RecentImages.Num() >= MaxRecentImages)
+	{
+		RecentImages.RemoveAt(0);
+	}
+	RecentImages.Emplace(SourceHash, Image);
+}
+
+void FNeoStackImagePipeline::Deliver(FOnProcessed OnProcessed, TSharedPtr<const FNeoStackProcessedImage> Image)
+{
+	AsyncTask(ENamedThreads::GameThread, [OnProcessed = MoveTemp(OnProcessed), Image]()
+	{
+		OnProcessed(Image);
+	});
+}
@@ -0,0 +1,249 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackIndexArtifacts.h"
+#include "NeoStackSettings.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+	/** Bumped whenever the manifest layout changes */
+	constexpr int32 ManifestVersion = 1;
+
+	const TCHAR* ManifestName = TEXT("Manifest.json");
+	const TCHAR* BlobDirName = TEXT("Artifacts");
+
+	/** Serialized names and class paths only mean the same thing to the same engine */
+	FString GetEngineKey()
+	{
+		return FEngineVersion::CompatibleWith().ToString(EVersionComponent::Patch);
+	}
+
+	bool HashFile(const FString& Path, FString& OutHash)
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+		{
+			return false;
+		}
+
+		FSHAHash Hash;
+		FSHA1::HashBuffer(Bytes.GetData(), Bytes.Num(), Hash.Hash);
+		OutHash = Hash.ToString();
+		return true;
+	}
+
+	/** Copy Source next to Dest under a unique name, check its hash, then move it into place */
+	bool CopyVerified(const FString& Source, const FString& Dest, const FString& ExpectedHash)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		const FString TempPath = Dest + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+
+		FString CopiedHash;
+		if (FileManager.Copy(*TempPath, *Source, true, true) != COPY_OK
+			|| !HashFile(TempPath, CopiedHash) || CopiedHash != ExpectedHash)
+		{
+			FileManager.Delete(*TempPath, false, true, true);
+			return false;
+		}
+		return FileManager.Move(*Dest, *TempPath, true, true);
+	}
+
+	TSharedPtr<FJsonObject> LoadManifest(const FString& SharedDir)
+	{
+		FString Contents;
+		if (!FFileHelper::LoadFileToString(Contents, *(SharedDir / ManifestName)))
+		{
+			return nullptr;
+		}
+
+		TSharedPtr<FJsonObject> Manifest;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Contents), Manifest) || !Manifest.IsValid())
+		{
+			return nullptr;
+		}
+		return Manifest;
+	}
+}
+
+FString FNeoStackIndexArtifacts::GetLocalDir()
+{
+	return FPaths::ProjectIntermediateDir() / TEXT("NeoStack");
+}
+
+FString FNeoStackIndexArtifacts::GetSharedDir(const FString& SharedRoot)
+{
+	FString Root = SharedRoot.TrimStartAndEnd();
+	if (Root.IsEmpty())
+	{
+		const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+		Root = Settings ? Settings->SharedIndexPath.TrimStartAndEnd() : FString();
+	}
+	return Root.IsEmpty() ? FString() : Root / FApp::GetProjectName();
+}
+
+const TArray<FString>& FNeoStackIndexArtifacts::GetArtifactNames()
+{
+	// FNeoStackProjectCatalog, FCodeSearchIndex and the Bridge's FNeoStackFunctionUsageIndex
+	static const TArray<FString> Names = {
+		TEXT("ProjectCatalog.bin"),
+		TEXT("CodeSearchIndex.bin"),
+		TEXT("FunctionUsages.json"),
+	};
+	return Names;
+}
+
+int32 FNeoStackIndexArtifacts::Pull(const FString& SharedDir)
+{
+	if (SharedDir.IsEmpty())
+	{
+		return 0;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_IndexArtifactsPull);
+	const double StartTime = FPlatformTime::Seconds();
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FString LocalDir = GetLocalDir();
+
+	// A machine with every file already never touches the share
+	TArray<FString> Missing;
+	for (const FString& Name : GetArtifactNames())
+	{
+		if (!FileManager.FileExists(*(LocalDir / Name)))
+		{
+			Missing.Add(Name);
+		}
+	}
+	if (Missing.Num() == 0)
+	{
+		return 0;
+	}
+
+	const TSharedPtr<FJsonObject> Manifest = LoadManifest(SharedDir);
+	const TSharedPtr<FJsonObject>* Files;
+	if (!Manifest.IsValid() || Manifest->GetIntegerField(TEXT("version")) != ManifestVersion
+		|| !Manifest->TryGetObjectField(TEXT("files"), Files))
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] No usable index manifest in %s, building indexes locally"), *SharedDir);
+		return 0;
+	}
+	if (Manifest->GetStringField(TEXT("engine")) != GetEngineKey())
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Shared indexes in %s were built with engine %s, building indexes locally"),
+			*SharedDir, *Manifest->GetStringField(TEXT("engine")));
+		return 0;
+	}
+
+	FileManager.MakeDirectory(*LocalDir, true);
+
+	int32 Copied = 0;
+	int64 CopiedBytes = 0;
+	for (const FString& Name : Missing)
+	{
+		const TSharedPtr<FJsonObject>* Entry;
+		FString Hash;
+		if (!(*Files)->TryGetObjectField(Name, Entry) || !(*Entry)->TryGetStringField(TEXT("hash"), Hash))
+		{
+			continue;
+		}
+
+		const FString BlobPath = SharedDir / BlobDirName / Hash;
+		const FString LocalPath = LocalDir / Name;
+		if (!CopyVerified(BlobPath, LocalPath, Hash))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Could not pull %s from %s, building it locally"), *Name, *BlobPath);
+			continue;
+		}
+
+		Copied++;
+		CopiedBytes += FileManager.FileSize(*LocalPath);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Pulled %d prebuilt index file(s), %lld bytes, published %s, in %.1f ms"),
+		Copied, CopiedBytes, *Manifest->GetStringField(TEXT("publishedAt")), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return Copied;
+}
+
+int32 FNeoStackIndexArtifacts::Publish(const FString& SharedDir)
+{
+	if (SharedDir.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_IndexArtifactsPublish);
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FString LocalDir = GetLocalDir();
+	const FString BlobDir = SharedDir / BlobDirName;
+	if (!FileManager.MakeDirectory(*BlobDir, true))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[NeoStack] Can't create %s"), *BlobDir);
+		return INDEX_NONE;
+	}
+
+	TSharedRef<FJsonObject> Files = MakeShared<FJsonObject>();
+	for (const FString& Name : GetArtifactNames())
+	{
+		const FString LocalPath = LocalDir / Name;
+		FString Hash;
+		if (!HashFile(LocalPath, Hash))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[NeoStack] %s was not built, leaving it out of the shared indexes"), *Name);
+			continue;
+		}
+
+		// Content-addressed: a blob that exists already holds exactly these bytes
+		const FString BlobPath = BlobDir / Hash;
+		if (!FileManager.FileExists(*BlobPath) && !CopyVerified(LocalPath, BlobPath, Hash))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to store %s as %s"), *Name, *BlobPath);
+			return INDEX_NONE;
+		}
+
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetStringField(TEXT("hash"), Hash);
+		Entry->SetNumberField(TEXT("size"), (double)FileManager.FileSize(*LocalPath));
+		Files->SetObjectField(Name, Entry);
+	}
+
+	if (Files->Values.Num() == 0)
+	{
+		return 0;
+	}
+
+	TSharedRef<FJsonObject> Manifest = MakeShared<FJsonObject>();
+	Manifest->SetNumberField(TEXT("version"), ManifestVersion);
+	Manifest->SetStringField(TEXT("engine"), GetEngineKey());
+	Manifest->SetStringField(TEXT("publishedAt"), FDateTime::UtcNow().ToIso8601());
+	Manifest->SetObjectField(TEXT("files"), Files);
+
+	FString Contents;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Contents);
+	FJsonSerializer::Serialize(Manifest, Writer);
+
+	// Blobs first, manifest last, so the manifest never names a blob that isn't there
+	const FString ManifestPath = SharedDir / ManifestName;
+	const FString TempPath = ManifestPath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(Contents, *TempPath) || !FileManager.Move(*ManifestPath, *TempPath, true, true))
+	{
+		FileManager.Delete(*TempPath, false, true, true);
+		UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to write %s"), *ManifestPath);
+		return INDEX_NONE;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Published %d index file(s) to %s"), Files->Values.Num(), *SharedDir);
+	return Files->Values.Num();
+}
@@ -0,0 +1,134 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackLogCapture.h"
+#include "Misc/OutputDeviceRedirector.h"
+
+static_assert((FNeoStackLogCapture::Capacity & (FNeoStackLogCapture::Capacity - 1)) == 0, "Capacity must be a power of two");
+
+FNeoStackLogCapture& FNeoStackLogCapture::Get()
+{
+	static FNeoStackLogCapture Instance;
+	return Instance;
+}
+
+void FNeoStackLogCapture::Install()
+{
+	if (bInstalled || !GLog)
+	{
+		return;
+	}
+	bInstalled = true;
+
+	if (!Slots)
+	{
+		Slots = MakeUnique<FSlot[]>(Capacity);
+	}
+
+	GLog->AddOutputDevice(this);
+
+	// Lines logged before the plugin loaded, while the editor still keeps them
+	GLog->SerializeBacklog(this);
+}
+
+void FNeoStackLogCapture::Uninstall()
+{
+	if (!bInstalled)
+	{
+		return;
+	}
+	bInstalled = false;
+
+	if (GLog)
+	{
+		GLog->RemoveOutputDevice(this);
+	}
+}
+
+void FNeoStackLogCapture::Serialize(const TCHAR* Message, ELogVerbosity::Type Verbosity, const FName& Category)
+{
+	if (!Message || !Slots || Verbosity == ELogVerbosity::SetColor)
+	{
+		return;
+	}
+
+	const uint64 Cursor = NextCursor.fetch_add(1, std::memory_order_acq_rel);
+	FSlot& Slot = Slots[Cursor & (Capacity - 1)];
+
+	// Odd version first: a reader that copies the slot meanwhile sees it change and drops the copy
+	Slot.Version.store(Cursor * 2 + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	const int32 Len = FMath::Min(FCString::Strlen(Message), MaxMessageChars);
+	Slot.Ticks = FDateTime::Now().GetTicks();
+	Slot.Category = Category;
+	Slot.Verbosity = static_cast<uint8>(Verbosity & ELogVerbosity::VerbosityMask);
+	FMemory::Memcpy(Slot.Message, Message, Len * sizeof(TCHAR));
+	Slot.Len = Len;
+
+	Slot.Version.store(Cursor * 2 + 2, std::memory_order_release);
+}
+
+uint64 FNeoStackLogCapture::Read(uint64 Since, TFunctionRef<bool(const FLine&)> Visitor, uint64& OutDropped) const
+{
+	OutDropped = 0;
+	if (!Slots)
+	{
+		return Since;
+	}
+
+	const uint64 Head = GetNextCursor();
+	const uint64 Oldest = Head > Capacity ? Head - Capacity : 0;
+	uint64 Cursor = FMath::Min(Since, Head);
+	if (Cursor < Oldest)
+	{
+		OutDropped += Oldest - Cursor;
+		Cursor = Oldest;
+	}
+
+	FLine Line;
+	TCHAR Buffer[MaxMessageChars];
+	for (; Cursor < Head; ++Cursor)
+	{
+		const FSlot& Slot = Slots[Cursor & (Capacity - 1)];
+		const uint64 Complete = Cursor * 2 + 2;
+
+		const uint64 Before = Slot.Version.load(std::memory_order_acquire);
+		if (Before < Complete)
+		{
+			// Claimed but not written yet; it is the first line of the next read
+			break;
+		}
+		if (Before > Complete)
+		{
+			// Lapped by a later line
+			++OutDropped;
+			continue;
+		}
+
+		const int64 Ticks = Slot.Ticks;
+		const FName Category = Slot.Category;
+		const uint8 Verbosity = Slot.Verbosity;
+		const int32 Len = FMath::Clamp(Slot.Len, 0, MaxMessageChars);
+		FMemory::Memcpy(Buffer, Slot.Message, Len * sizeof(TCHAR));
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (Slot.Version.load(std::memory_order_relaxed) != Complete)
+		{
+			++OutDropped;
+			continue;
+		}
+
+		Line.Cursor = Cursor;
+		Line.Time = FDateTime(Ticks);
+		Line.Verbosity = static_cast<ELogVerbosity::Type>(Verbosity);
+		Line.Category = Category;
+		Line.Message.Reset(Len);
+		Line.Message.AppendChars(Buffer, Len);
+
+		if (!Visitor(Line))
+		{
+			return Cursor + 1;
+		}
+	}
+	return Cursor;
+}
@@ -0,0 +1,245 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackMentionPrefetcher.h"
+#include "NeoStackSettings.h"
+#include "Tools/NeoStackToolRegistry.h"
+#include "Editor.h"
+#include "Json.h"
+#include "Misc/PackageName.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+FNeoStackMentionPrefetcher& FNeoStackMentionPrefetcher::Get()
+{
+	static FNeoStackMentionPrefetcher Instance;
+	return Instance;
+}
+
+void FNeoStackMentionPrefetcher::RegisterDelegates()
+{
+	if (bDelegatesRegistered)
+	{
+		return;
+	}
+
+	FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FNeoStackMentionPrefetcher::HandleObjectModified);
+	FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FNeoStackMentionPrefetcher::HandleObjectTransacted);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().AddRaw(this, &FNeoStackMentionPrefetcher::HandleBlueprintCompiled);
+	}
+	bDelegatesRegistered = true;
+}
+
+TSharedRef<FJsonObject> FNeoStackMentionPrefetcher::MakeReadArgs(const FString& FullPath)
+{
+	// Assets are mentioned by object path; read_asset takes the package path, like the agent passes it
+	TSharedRef<FJsonObject> Args = MakeShared<FJsonObject>();
+	Args->SetStringField(TEXT("name"), FullPath.StartsWith(TEXT("/"))
+		? FPackageName::ObjectPathToPackageName(FullPath) : FullPath);
+	return Args;
+}
+
+void FNeoStackMentionPrefetcher::Prefetch(const FString& FullPath)
+{
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	if (FullPath.IsEmpty() || (Settings && Settings->MentionPrefetch == ENeoStackMentionPrefetch::Disabled))
+	{
+		return;
+	}
+
+	// A failed read is worth retrying: the asset may have been saved or the file created since
+	if (const FPrefetch* Existing = Entries.Find(FullPath))
+	{
+		if (Existing->State != EState::Failed)
+		{
+			return;
+		}
+	}
+
+	while (Entries.Num() >= MaxEntries)
+	{
+		const FString* Oldest = nullptr;
+		uint32 OldestSerial = MAX_uint32;
+		for (const TPair<FString, FPrefetch>& Entry : Entries)
+		{
+			if (Entry.Value.Serial < OldestSerial)
+			{
+				OldestSerial = Entry.Value.Serial;
+				Oldest = &Entry.Key;
+			}
+		}
+		Cancel(FString(*Oldest));
+	}
+
+	RegisterDelegates();
+
+	FPrefetch& Entry = Entries.Add(FullPath);
+	Entry.CancelToken = MakeShared<FNeoStackCancellationToken>();
+	Entry.Serial = NextSerial++;
+
+	if (!FullPath.StartsWith(TEXT("/")))
+	{
+		StartRead(FullPath);
+		return;
+	}
+
+	// Load the package off the game thread; read_asset then finds it in memory
+	const FString PackageName = FPackageName::ObjectPathToPackageName(FullPath);
+	if (FindPackage(nullptr, *PackageName))
+	{
+		StartRead(FullPath);
+		return;
+	}
+
+	const uint32 Serial = Entry.Serial;
+	LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateLambda(
+		[this, FullPath, Serial](const FName& /*LoadedName*/, UPackage* Package, EAsyncLoadingResult::Type Result)
+		{
+			if (!IsCurrent(FullPath, Serial))
+			{
+				return;
+			}
+			if (Result != EAsyncLoadingResult::Succeeded || !Package)
+			{
+				UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Mention prefetch could not load %s"), *FullPath);
+				Entries[FullPath].State = EState::Failed;
+				return;
+			}
+			StartRead(FullPath);
+		}));
+}
+
+void FNeoStackMentionPrefetcher::StartRead(const FString& FullPath)
+{
+	FPrefetch& Entry = Entries[FullPath];
+	Entry.State = EState::Reading;
+
+	const uint32 Serial = Entry.Serial;
+	const double StartTime = FPlatformTime::Seconds();
+	FNeoStackToolRegistry::Get().ExecuteAsync(TEXT("read_asset"), MakeReadArgs(FullPath), FOnToolProgress(), Entry.CancelToken)
+		.Next([this, FullPath, Serial, StartTime](FToolResult Result)
+		{
+			if (!IsCurrent(FullPath, Serial))
+			{
+				return;
+			}
+
+			FPrefetch& Finished = Entries[FullPath];
+			Finished.State = Result.bSuccess ? EState::Done : EState::Failed;
+			Finished.Output = MoveTemp(Result.Output);
+			UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Prefetched mention %s in %.1f ms%s"), *FullPath,
+				(FPlatformTime::Seconds() - StartTime) * 1000.0, Result.bSuccess ? TEXT("") : TEXT(" (failed)"));
+		});
+}
+
+bool FNeoStackMentionPrefetcher::IsCurrent(const FString& FullPath, uint32 Serial) const
+{
+	const FPrefetch* Entry = Entries.Find(FullPath);
+	return Entry && Entry->Serial == Serial;
+}
+
+void FNeoStackMentionPrefetcher::Cancel(const FString& FullPath)
+{
+	FPrefetch Entry;
+	if (Entries.RemoveAndCopyValue(FullPath, Entry) && Entry.CancelToken.IsValid())
+	{
+		Entry.CancelToken->Cancel();
+	}
+}
+
+bool FNeoStackMentionPrefetcher::GetResult(const FString& FullPath, FString& OutOutput) const
+{
+	const FPrefetch* Entry = Entries.Find(FullPath);
+	if (!Entry || Entry->State != EState::Done)
+	{
+		return false;
+	}
+	OutOutput = Entry->Output;
+	return true;
+}
+
+void FNeoStackMentionPrefetcher::InvalidatePackage(const UObject* Object)
+{
+	// Called for every Modify() in the editor; stay cheap when nothing is prefetched
+	if (!Object || Entries.Num() == 0)
+	{
+		return;
+	}
+
+	const UPackage* Package = Object->GetPackage();
+	if (!Package)
+	{
+		return;
+	}
+
+	const FString PackageName = Package->GetName();
+	TArray<FString> Stale;
+	for (const TPair<FString, FPrefetch>& Entry : Entries)
+	{
+		if (Entry.Key.StartsWith(TEXT("/")) && FPackageName::ObjectPathToPackageName(Entry.Key) == PackageName)
+		{
+			Stale.Add(Entry.Key);
+		}
+	}
+	for (const FString& FullPath : Stale)
+	{
+		Cancel(FullPath);
+	}
+}
+
+void FNeoStackMentionPrefetcher::HandleObjectModified(UObject* Object)
+{
+	InvalidatePackage(Object);
+}
+
+void FNeoStackMentionPrefetcher::HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+	InvalidatePackage(Object);
+}
+
+void FNeoStackMentionPrefetcher::HandleBlueprintCompiled()
+{
+	// Compiles can reconstruct nodes and pins without modifying the package; any asset summary may be stale
+	TArray<FString> Stale;
+	for (const TPair<FString, FPrefetch>& Entry : Entries)
+	{
+		if (Entry.Key.StartsWith(TEXT("/")))
+		{
+			Stale.Add(Entry.Key);
+		}
+	}
+	for (const FString& FullPath : Stale)
+	{
+		Cancel(FullPath);
+	}
+}
+
+void FNeoStackMentionPrefetcher::Clear()
+{
+	for (TPair<FString, FPrefetch>& Entry : Entries)
+	{
+		if (Entry.Value.CancelToken.IsValid())
+		{
+			Entry.Value.CancelToken->Cancel();
+		}
+	}
+	Entries.Reset();
+}
+
+void FNeoStackMentionPrefetcher::Shutdown()
+{
+	if (bDelegatesRegistered)
+	{
+		FCoreUObjectDelegates::OnObjectModified.RemoveAll(this);
+		FCoreUObjectDelegates::OnObjectTransacted.RemoveAll(this);
+		if (GEditor)
+		{
+			GEditor->OnBlueprintCompiled().RemoveAll(this);
+		}
+		bDelegatesRegistered = false;
+	}
+
+	Clear();
+}
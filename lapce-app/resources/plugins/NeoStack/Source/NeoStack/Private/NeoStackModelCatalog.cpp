@@ -0,0 +1,374 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackModelCatalog.h"
+#include "NeoStackSettings.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Json.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Async/Async.h"
+
+namespace
+{
+	/** Bump when the cache layout changes; older files are ignored */
+	constexpr int32 CacheVersion = 1;
+}
+
+FNeoStackModelCatalog& FNeoStackModelCatalog::Get()
+{
+	static FNeoStackModelCatalog Instance;
+	return Instance;
+}
+
+FString FNeoStackModelCatalog::GetCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("models_cache.json");
+}
+
+void FNeoStackModelCatalog::Request()
+{
+	check(IsInGameThread());
+
+	if (!bCacheRequested)
+	{
+		bCacheRequested = true;
+		bLoadingCache = true;
+		bRefreshAfterLoad = true;
+
+		Async(EAsyncExecution::ThreadPool, []()
+		{
+			TSharedPtr<FCatalog> Catalog = MakeShared<FCatalog>();
+			const bool bLoaded = LoadCache(*Catalog);
+
+			AsyncTask(ENamedThreads::GameThread, [Catalog, bLoaded]()
+			{
+				FNeoStackModelCatalog& Self = FNeoStackModelCatalog::Get();
+				Self.bLoadingCache = false;
+
+				// A refresh that finished first already holds newer data
+				if (bLoaded && Self.Models.Num() == 0)
+				{
+					Self.InstallCatalog(MoveTemp(*Catalog));
+				}
+				else
+				{
+					Self.UpdatedEvent.Broadcast();
+				}
+
+				if (Self.bRefreshAfterLoad)
+				{
+					Self.bRefreshAfterLoad = false;
+					Self.StartRefresh();
+				}
+			});
+		});
+		return;
+	}
+
+	if (bLoadingCache)
+	{
+		// Validators come from the cache, so wait for it
+		bRefreshAfterLoad = true;
+		return;
+	}
+
+	if (FPlatformTime::Seconds() - LastRefreshTime >= MinRefreshIntervalSeconds || Models.Num() == 0)
+	{
+		StartRefresh();
+	}
+}
+
+void FNeoStackModelCatalog::StartRefresh()
+{
+	if (bRefreshing)
+	{
+		return;
+	}
+
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	if (!Settings)
+	{
+		LastError = TEXT("Failed to get NeoStack settings");
+		UpdatedEvent.Broadcast();
+		return;
+	}
+
+	if (Settings->BackendURL.IsEmpty())
+	{
+		LastError = TEXT("Backend URL not configured");
+		UpdatedEvent.Broadcast();
+		return;
+	}
+
+	if (Settings->APIKey.IsEmpty())
+	{
+		LastError = TEXT("API Key not configured");
+		UpdatedEvent.Broadcast();
+		return;
+	}
+
+	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(Settings->BackendURL + TEXT("/models"));
+	Request->SetVerb(TEXT("GET"));
+	Request->SetHeader(TEXT("X-API-Key"), Settings->APIKey);
+
+	// Validators only mean something for the backend they came from
+	if (BackendURL == Settings->BackendURL && Models.Num() > 0)
+	{
+		if (!ETag.IsEmpty())
+		{
+			Request->SetHeader(TEXT("If-None-Match"), ETag);
+		}
+		if (!LastModified.IsEmpty())
+		{
+			Request->SetHeader(TEXT("If-Modified-Since"), LastModified);
+		}
+	}
+
+	Request->OnProcessRequestComplete().BindRaw(this, &FNeoStackModelCatalog::OnRefreshResponse);
+
+	LastRefreshTime = FPlatformTime::Seconds();
+	if (!Request->ProcessRequest())
+	{
+		LastError = TEXT("Failed to send HTTP request");
+		UpdatedEvent.Broadcast();
+		return;
+	}
+
+	bRefreshing = true;
+	UpdatedEvent.Broadcast();
+}
+
+void FNeoStackModelCatalog::OnRefreshResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	if (!bWasSuccessful || !Response.IsValid())
+	{
+		bRefreshing = false;
+		LastError = TEXT("Request failed or invalid response");
+		UpdatedEvent.Broadcast();
+		return;
+	}
+
+	const int32 ResponseCode = Response->GetResponseCode();
+	if (ResponseCode == 304)
+	{
+		bRefreshing = false;
+		LastError.Empty();
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Model catalog unchanged (304), keeping %d cached models"), Models.Num());
+		UpdatedEvent.Broadcast();
+		return;
+	}
+
+	if (ResponseCode != 200)
+	{
+		bRefreshing = false;
+		LastError = FString::Printf(TEXT("Server error: %d"), ResponseCode);
+		UpdatedEvent.Broadcast();
+		return;
+	}
+
+	TSharedPtr<FCatalog> Catalog = MakeShared<FCatalog>();
+	Catalog->ETag = Response->GetHeader(TEXT("ETag"));
+	Catalog->LastModified = Response->GetHeader(TEXT("Last-Modified"));
+	Catalog->BackendURL = UNeoStackSettings::Get() ? UNeoStackSettings::Get()->BackendURL : FString();
+
+	Async(EAsyncExecution::ThreadPool, [Catalog, Content = Response->GetContentAsString()]()
+	{
+		const bool bParsed = ParseResponse(Content, Catalog->Models);
+		if (bParsed)
+		{
+			SaveCache(*Catalog);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [Catalog, bParsed]()
+		{
+			FNeoStackModelCatalog& Self = FNeoStackModelCatalog::Get();
+			Self.bRefreshing = false;
+
+			if (!bParsed)
+			{
+				Self.LastError = TEXT("Failed to parse response");
+				Self.UpdatedEvent.Broadcast();
+				return;
+			}
+
+			Self.LastError.Empty();
+			Self.InstallCatalog(MoveTemp(*Catalog));
+		});
+	});
+}
+
+void FNeoStackModelCatalog::InstallCatalog(FCatalog&& Catalog)
+{
+	Models = MoveTemp(Catalog.Models);
+	ETag = MoveTemp(Catalog.ETag);
+	LastModified = MoveTemp(Catalog.LastModified);
+	BackendURL = MoveTemp(Catalog.BackendURL);
+	UpdatedEvent.Broadcast();
+}
+
+bool FNeoStackModelCatalog::ParseResponse(const FString& Content, TArray<TSharedPtr<FOpenRouterModelInfo>>& OutModels)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* DataArray;
+	if (!JsonObject->TryGetArrayField(TEXT("data"), DataArray))
+	{
+		return false;
+	}
+
+	OutModels.Reset(DataArray->Num());
+	for (const TSharedPtr<FJsonValue>& Value : *DataArray)
+	{
+		const TSharedPtr<FJsonObject>* ModelObj;
+		if (!Value->TryGetObject(ModelObj))
+		{
+			continue;
+		}
+
+		TSharedPtr<FOpenRouterModelInfo> Model = MakeShared<FOpenRouterModelInfo>();
+
+		(*ModelObj)->TryGetStringField(TEXT("id"), Model->ID);
+		(*ModelObj)->TryGetStringField(TEXT("name"), Model->Name);
+		(*ModelObj)->TryGetStringField(TEXT("description"), Model->Description);
+		(*ModelObj)->TryGetNumberField(TEXT("context_length"), Model->ContextLength);
+
+		// Strip provider prefix from name (e.g., "Anthropic: Claude Opus 4.5" -> "Claude Opus 4.5")
+		int32 ColonIndex;
+		if (Model->Name.FindChar(TEXT(':'), ColonIndex))
+		{
+			Model->Name = Model->Name.RightChop(ColonIndex + 1).TrimStart();
+		}
+
+		const TSharedPtr<FJsonObject>* PricingObj;
+		if ((*ModelObj)->TryGetObjectField(TEXT("pricing"), PricingObj))
+		{
+			(*PricingObj)->TryGetStringField(TEXT("prompt"), Model->PromptCost);
+			(*PricingObj)->TryGetStringField(TEXT("completion"), Model->CompletionCost);
+		}
+
+		FinalizeModel(*Model);
+		OutModels.Add(Model);
+	}
+
+	return true;
+}
+
+bool FNeoStackModelCatalog::LoadCache(FCatalog& OutCatalog)
+{
+	FString Content;
+	if (!FFileHelper::LoadFileToString(Content, *GetCacheFilePath()))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Ignoring unreadable model cache"));
+		return false;
+	}
+
+	int32 Version = 0;
+	const TArray<TSharedPtr<FJsonValue>>* ModelsArray;
+	if (!JsonObject->TryGetNumberField(TEXT("version"), Version) || Version != CacheVersion
+		|| !JsonObject->TryGetArrayField(TEXT("models"), ModelsArray))
+	{
+		return false;
+	}
+
+	JsonObject->TryGetStringField(TEXT("etag"), OutCatalog.ETag);
+	JsonObject->TryGetStringField(TEXT("last_modified"), OutCatalog.LastModified);
+	JsonObject->TryGetStringField(TEXT("backend"), OutCatalog.BackendURL);
+
+	OutCatalog.Models.Reset(ModelsArray->Num());
+	for (const TSharedPtr<FJsonValue>& Value : *ModelsArray)
+	{
+		const TSharedPtr<FJsonObject>* ModelObj;
+		if (!Value->TryGetObject(ModelObj))
+		{
+			continue;
+		}
+
+		// Stored names are already stripped of their provider prefix
+		TSharedPtr<FOpenRouterModelInfo> Model = MakeShared<FOpenRouterModelInfo>();
+		(*ModelObj)->TryGetStringField(TEXT("id"), Model->ID);
+		(*ModelObj)->TryGetStringField(TEXT("name"), Model->Name);
+		(*ModelObj)->TryGetStringField(TEXT("description"), Model->Description);
+		(*ModelObj)->TryGetNumberField(TEXT("context_length"), Model->ContextLength);
+		(*ModelObj)->TryGetStringField(TEXT("prompt"), Model->PromptCost);
+		(*ModelObj)->TryGetStringField(TEXT("completion"), Model->CompletionCost);
+
+		FinalizeModel(*Model);
+		OutCatalog.Models.Add(Model);
+	}
+
+	return true;
+}
+
+void FNeoStackModelCatalog::SaveCache(const FCatalog& Catalog)
+{
+	FString Output;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+
+	JsonWriter->WriteObjectStart();
+	JsonWriter->WriteValue(TEXT("version"), CacheVersion);
+	JsonWriter->WriteValue(TEXT("etag"), Catalog.ETag);
+	JsonWriter->WriteValue(TEXT("last_modified"), Catalog.LastModified);
+	JsonWriter->WriteValue(TEXT("backend"), Catalog.BackendURL);
+	JsonWriter->WriteArrayStart(TEXT("models"));
+	for (const TSharedPtr<FOpenRouterModelInfo>& Model : Catalog.Models)
+	{
+		JsonWriter->WriteObjectStart();
+		JsonWriter->WriteValue(TEXT("id"), Model->ID);
+		JsonWriter->WriteValue(TEXT("name"), Model->Name);
+		JsonWriter->WriteValue(TEXT("description"), Model->Description);
+		JsonWriter->WriteValue(TEXT("context_length"), Model->ContextLength);
+		JsonWriter->WriteValue(TEXT("prompt"), Model->PromptCost);
+		JsonWriter->WriteValue(TEXT("completion"), Model->CompletionCost);
+		JsonWriter->WriteObjectEnd();
+	}
+	JsonWriter->WriteArrayEnd();
+	JsonWriter->WriteObjectEnd();
+	JsonWriter->Close();
+
+	// Write then move so a crash mid-write never leaves a truncated cache behind
+	const FString CachePath = GetCacheFilePath();
+	const FString TempPath = CachePath + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(Output, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !IFileManager::Get().Move(*CachePath, *TempPath, true, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Failed to write model cache %s"), *CachePath);
+	}
+}
+
+void FNeoStackModelCatalog::FinalizeModel(FOpenRouterModelInfo& Model)
+{
+	Model.Provider = ExtractProvider(Model.ID);
+	Model.SearchKey = FString::Join(TArray<FString>{ Model.Name, Model.ID, Model.Provider, Model.Description }, TEXT("\n")).ToLower();
+}
+
+FString FNeoStackModelCatalog::ExtractProvider(const FString& ModelID)
+{
+	// Extract provider from model ID like "anthropic/claude-3" -> "Anthropic"
+	int32 SlashIndex;
+	if (ModelID.FindChar(TEXT('/'), SlashIndex))
+	{
+		FString Provider = ModelID.Left(SlashIndex);
+		// Capitalize first letter
+		if (Provider.Len() > 0)
+		{
+			Provider[0] = FChar::ToUpper(Provider[0]);
+		}
+		return Provider;
+	}
+	return TEXT("Unknown");
+}
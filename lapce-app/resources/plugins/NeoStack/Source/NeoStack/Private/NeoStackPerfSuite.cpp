@@ -0,0 +1,688 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackAPIClient.h"
+#include "NeoStackConversation.h"
+#include "NeoStackSettings.h"
+#include "NeoStackStreamRecording.h"
+#include "Tools/NeoStackToolRegistry.h"
+#include "Tools/AssetReadCache.h"
+#include "Tools/NodeNameRegistry.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+// Fixture assets
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/DataTable.h"
+#include "Engine/UserDefinedStruct.h"
+#include "GameFramework/Actor.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/StructureEditorUtils.h"
+
+/**
+ * NeoStack.Perf [Suites...] [-scale=F] [-iterations=N] [-out=File] [-thresholds=File] [-recording=File]
+ *
+ * Builds synthetic fixtures, times the hot tool and persistence paths against them and writes
+ * the results as JSON (default Saved/NeoStack/perf_results.json). Suites: sse, conversation,
+ * source, graph, datatable, blueprints; all of them when none is named.
+ *
+ * Fixtures at scale 1: a 10k-file Source tree (in the user temp folder), a 5k-node EventGraph,
+ * a 50k-row DataTable and 1k Blueprints (in memory under /Game/__NeoStackPerf, never saved),
+ * a 500-message conversation (deleted afterwards) and a 20k-delta SSE stream. Tool calls go
+ * through FNeoStackToolRegistry with the result cache off and the read cache invalidated, so
+ * every iteration does the tool's work instead of returning a stored reply. The indexes the
+ * tools keep (project catalog, code search, text line indexes, Blueprint summaries) are built
+ * by the first iteration and stay warm, so the median measures a warm call, not a cold one.
+ * With -recording (a NeoStack.RecordStreams capture) the sse suite also decodes that real
+ * response with its recorded chunk boundaries.
+ *
+ * Each benchmark reports the median of its iterations. It fails when the median exceeds its
+ * threshold: the built-in default scaled by -scale, or the value for its name in the
+ * -thresholds file ({"find_node": 150, ...}, in ms, not scaled). Failures are logged as
+ * errors and the run's "passed" field is false, so CI can gate on either.
+ */
+namespace
+{
+	const TCHAR* FixtureRoot = TEXT("/Game/__NeoStackPerf");
+
+	struct FPerfResult
+	{
+		FString Name;
+		int32 Iterations = 0;
+		double MedianMs = 0.0;
+		double MinMs = 0.0;
+		double MaxMs = 0.0;
+		double ThresholdMs = 0.0;
+		bool bPassed = false;
+		FString Error;
+	};
+
+	class FPerfRun
+	{
+	public:
+		explicit FPerfRun(const TArray<FString>& Args)
+		{
+			const FString CommandLine = FString::Join(Args, TEXT(" "));
+			FParse::Value(*CommandLine, TEXT("-scale="), Scale);
+			FParse::Value(*CommandLine, TEXT("-iterations="), Iterations);
+			Scale = FMath::Clamp(Scale, 0.001f, 100.0f);
+			Iterations = FMath::Clamp(Iterations, 1, 1000);
+
+			if (!FParse::Value(*CommandLine, TEXT("-out="), OutFile))
+			{
+				OutFile = FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("perf_results.json");
+			}
+
+			if (FParse::Value(*CommandLine, TEXT("-recording="), RecordingFile) && FPaths::IsRelative(RecordingFile))
+			{
+				RecordingFile = FNeoStackStreamRecording::GetRecordingDir() / RecordingFile;
+			}
+
+			FString ThresholdFile;
+			if (FParse::Value(*CommandLine, TEXT("-thresholds="), ThresholdFile))
+			{
+				LoadThresholds(ThresholdFile);
+			}
+
+			for (const FString& Arg : Args)
+			{
+				if (!Arg.StartsWith(TEXT("-")))
+				{
+					Suites.Add(Arg.ToLower());
+				}
+			}
+		}
+
+		bool WantsSuite(const TCHAR* Suite) const
+		{
+			return Suites.Num() == 0 || Suites.Contains(Suite);
+		}
+
+		/** Scaled fixture size, at least 1 */
+		int32 Count(int32 AtScaleOne) const
+		{
+			return FMath::Max(1, FMath::RoundToInt32(AtScaleOne * Scale));
+		}
+
+		/**
+		 * Time Body over the configured iterations. Body returns false with OutError set if the
+		 * operation failed; the benchmark then fails regardless of its time.
+		 */
+		void Measure(const FString& Name, double DefaultThresholdMs, TFunctionRef<bool(FString& OutError)> Body)
+		{
+			FPerfResult& Result = Results.AddDefaulted_GetRef();
+			Result.Name = Name;
+			const double* Override = Thresholds.Find(Name);
+			Result.ThresholdMs = Override ? *Override : DefaultThresholdMs * Scale;
+
+			TArray<double> Times;
+			Times.Reserve(Iterations);
+			for (int32 i = 0; i < Iterations; i++)
+			{
+				const double Start = FPlatformTime::Seconds();
+				const bool bOk = Body(Result.Error);
+				Times.Add((FPlatformTime::Seconds() - Start) * 1000.0);
+				if (!bOk)
+				{
+					break;
+				}
+			}
+
+			Times.Sort();
+			Result.Iterations = Times.Num();
+			Result.MinMs = Times[0];
+			Result.MaxMs = Times.Last();
+			Result.MedianMs = Times[Times.Num() / 2];
+			Result.bPassed = Result.Error.IsEmpty() && Result.MedianMs <= Result.ThresholdMs;
+
+			if (!Result.Error.IsEmpty())
+			{
+				UE_LOG(LogTemp, Error, TEXT("[NeoStack] Perf %s failed: %s"), *Name, *Result.Error);
+			}
+			else if (!Result.bPassed)
+			{
+				UE_LOG(LogTemp, Error, TEXT("[NeoStack] Perf %s regressed: %.2f ms (threshold %.2f ms)"),
+					*Name, Result.MedianMs, Result.ThresholdMs);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Display, TEXT("[NeoStack] Perf %s: %.2f ms (min %.2f, max %.2f, threshold %.2f)"),
+					*Name, Result.MedianMs, Result.MinMs, Result.MaxMs, Result.ThresholdMs);
+			}
+		}
+
+		/**
+		 * Measure a tool call through the registry; a failed tool result fails the benchmark
+		 * @param Validate - Returns an error for output that succeeded without finding what the fixture holds
+		 */
+		void MeasureTool(const FString& Name, double DefaultThresholdMs, const FString& ToolName,
+			const TSharedRef<FJsonObject>& ToolArgs, TFunction<void()> BeforeCall = nullptr,
+			TFunction<FString(const FString& Output)> Validate = nullptr)
+		{
+			Measure(Name, DefaultThresholdMs, [&](FString& OutError)
+			{
+				if (BeforeCall)
+				{
+					BeforeCall();
+				}
+				const FToolResult ToolResult = FNeoStackToolRegistry::Get().Execute(ToolName, ToolArgs);
+				if (!ToolResult.bSuccess)
+				{
+					OutError = ToolResult.Output.Left(300);
+					return false;
+				}
+				if (Validate)
+				{
+					OutError = Validate(ToolResult.Output);
+				}
+				return OutError.IsEmpty();
+			});
+		}
+
+		bool WriteResults() const
+		{
+			bool bAllPassed = true;
+			TArray<TSharedPtr<FJsonValue>> ResultArray;
+			for (const FPerfResult& Result : Results)
+			{
+				TSharedPtr<FJsonObject> Entry = MakeShared<FJsonObject>();
+				Entry->SetStringField(TEXT("name"), Result.Name);
+				Entry->SetNumberField(TEXT("iterations"), Result.Iterations);
+				Entry->SetNumberField(TEXT("median_ms"), Result.MedianMs);
+				Entry->SetNumberField(TEXT("min_ms"), Result.MinMs);
+				Entry->SetNumberField(TEXT("max_ms"), Result.MaxMs);
+				Entry->SetNumberField(TEXT("threshold_ms"), Result.ThresholdMs);
+				Entry->SetBoolField(TEXT("passed"), Result.bPassed);
+				if (!Result.Error.IsEmpty())
+				{
+					Entry->SetStringField(TEXT("error"), Result.Error);
+				}
+				ResultArray.Add(MakeShared<FJsonValueObject>(Entry));
+				bAllPassed &= Result.bPassed;
+			}
+
+			TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+			Root->SetNumberField(TEXT("version"), 1);
+			Root->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+			Root->SetNumberField(TEXT("scale"), Scale);
+			Root->SetNumberField(TEXT("iterations"), Iterations);
+			Root->SetBoolField(TEXT("passed"), bAllPassed);
+			Root->SetArrayField(TEXT("results"), ResultArray);
+
+			FString Output;
+			TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+			FJsonSerializer::Serialize(Root, Writer);
+			return FFileHelper::SaveStringToFile(Output, *OutFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+		}
+
+		int32 GetFailureCount() const
+		{
+			return Results.FilterByPredicate([](const FPerfResult& Result) { return !Result.bPassed; }).Num();
+		}
+
+		int32 GetResultCount() const { return Results.Num(); }
+		const FString& GetOutFile() const { return OutFile; }
+		const FString& GetRecordingFile() const { return RecordingFile; }
+
+	private:
+		void LoadThresholds(const FString& FilePath)
+		{
+			FString Json;
+			TSharedPtr<FJsonObject> Root;
+			if (!FFileHelper::LoadFileToString(Json, *FilePath) ||
+				!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Perf: could not read thresholds from %s, using defaults"), *FilePath);
+				return;
+			}
+
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Root->Values)
+			{
+				double Value = 0.0;
+				if (Field.Value.IsValid() && Field.Value->TryGetNumber(Value))
+				{
+					Thresholds.Add(Field.Key, Value);
+				}
+			}
+		}
+
+		float Scale = 1.0f;
+		int32 Iterations = 5;
+		FString OutFile;
+		FString RecordingFile;
+		TSet<FString> Suites;
+		TMap<FString, double> Thresholds;
+		TArray<FPerfResult> Results;
+	};
+
+	TSharedRef<FJsonObject> MakeArgs(const TMap<FString, FString>& Fields)
+	{
+		TSharedRef<FJsonObject> Args = MakeShared<FJsonObject>();
+		for (const TPair<FString, FString>& Field : Fields)
+		{
+			Args->SetStringField(Field.Key, Field.Value);
+		}
+		return Args;
+	}
+
+	void SetStringArray(const TSharedRef<FJsonObject>& Args, const TCHAR* Field, std::initializer_list<const TCHAR*> Values)
+	{
+		TArray<TSharedPtr<FJsonValue>> Array;
+		for (const TCHAR* Value : Values)
+		{
+			Array.Add(MakeShared<FJsonValueString>(Value));
+		}
+		Args->SetArrayField(Field, Array);
+	}
+
+	/** Drop in-memory fixture packages: unregister, unroot and let GC collect them */
+	void DestroyFixturePackages(const TArray<UPackage*>& Packages)
+	{
+		for (UPackage* Package : Packages)
+		{
+			ForEachObjectWithPackage(Package, [](UObject* Object)
+			{
+				if (Object->IsAsset())
+				{
+					FAssetRegistryModule::AssetDeleted(Object);
+				}
+				Object->ClearFlags(RF_Standalone | RF_Public);
+				Object->MarkAsGarbage();
+				return true;
+			}, false);
+			Package->MarkAsGarbage();
+		}
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	UBlueprint* CreateFixtureBlueprint(const FString& SubPath, const FString& Name, TArray<UPackage*>& OutPackages)
+	{
+		UPackage* Package = CreatePackage(*(FString(FixtureRoot) / SubPath / Name));
+		OutPackages.Add(Package);
+
+		UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(AActor::StaticClass(), Package, FName(*Name),
+			BPTYPE_Normal, UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+		if (Blueprint)
+		{
+			FAssetRegistryModule::AssetCreated(Blueprint);
+		}
+		return Blueprint;
+	}
+
+	// SSE: content/reasoning deltas plus an occasional tool call, decoded in network-sized chunks
+
+	void RunSSESuite(FPerfRun& Run)
+	{
+		const int32 DeltaCount = Run.Count(20000);
+		FString Stream;
+		Stream.Reserve(DeltaCount * 80);
+		for (int32 i = 0; i < DeltaCount; i++)
+		{
+			if (i % 500 == 499)
+			{
+				Stream += FString::Printf(TEXT("data: {\"type\":\"tool_call_backend\",\"tool\":\"web_search\",\"call_id\":\"call_%d\",\"args\":{\"query\":\"unreal \\\"perf\\\" %d\"}}\n\n"), i, i);
+			}
+			else
+			{
+				Stream += FString::Printf(TEXT("data: {\"type\":\"%s\",\"%s\":\"token %d \\u00e9\\n\"}\n\n"),
+					i % 4 == 0 ? TEXT("reasoning") : TEXT("content"),
+					i % 4 == 0 ? TEXT("reasoning") : TEXT("content"), i);
+			}
+		}
+
+		const FTCHARToUTF8 Utf8(*Stream);
+		TArray<uint8> Body;
+		Body.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+		int32 Events = 0;
+		FNeoStackStreamCallbacks Callbacks;
+		Callbacks.OnContent.BindLambda([&Events](const FString&) { Events++; });
+		Callbacks.OnReasoning.BindLambda([&Events](const FString&) { Events++; });
+		Callbacks.OnToolCall.BindLambda([&Events](const FString&, const FString&, const FString&) { Events++; });
+
+		Run.Measure(TEXT("sse.parse"), 150.0, [&](FString& OutError)
+		{
+			Events = 0;
+			FNeoStackAPIClient::ReplayStream(Body, 1400, Callbacks);
+			if (Events != DeltaCount)
+			{
+				OutError = FString::Printf(TEXT("decoded %d of %d events"), Events, DeltaCount);
+				return false;
+			}
+			return true;
+		});
+
+		if (Run.GetRecordingFile().IsEmpty())
+		{
+			return;
+		}
+
+		// A recorded response: the event count of the first pass is the expectation for the rest
+		TSharedRef<FNeoStackStreamRecording> Recording = MakeShared<FNeoStackStreamRecording>();
+		const bool bLoaded = Recording->LoadFromFile(Run.GetRecordingFile());
+		Callbacks.OnUE5ToolCall.BindLambda([&Events](const FString&, const FString&, const FString&, const TSharedPtr<FJsonObject>&, const FString&) { Events++; });
+		Callbacks.OnToolResult.BindLambda([&Events](const FString&, const FString&) { Events++; });
+		int32 ExpectedEvents = INDEX_NONE;
+		Run.Measure(TEXT("sse.recording"), 50.0, [&](FString& OutError)
+		{
+			if (!bLoaded)
+			{
+				OutError = FString::Printf(TEXT("could not read recording %s"), *Run.GetRecordingFile());
+				return false;
+			}
+
+			Events = 0;
+			FNeoStackAPIClient::ReplayRecording(Recording, 0.0f, Callbacks);
+			if (ExpectedEvents == INDEX_NONE)
+			{
+				ExpectedEvents = Events;
+			}
+			if (Events != ExpectedEvents)
+			{
+				OutError = FString::Printf(TEXT("decoded %d events, first pass decoded %d"), Events, ExpectedEvents);
+				return false;
+			}
+			return true;
+		});
+	}
+
+	// Conversation: append a long history, then reload it the way switching conversations does
+
+	void RunConversationSuite(FPerfRun& Run)
+	{
+		FNeoStackConversationManager& Manager = FNeoStackConversationManager::Get();
+		const int32 PreviousID = Manager.GetCurrentConversationID();
+		const int32 MessageCount = Run.Count(500);
+
+		const int32 ConversationID = Manager.CreateConversation(TEXT("NeoStack.Perf fixture"));
+		const FString Paragraph = FString::ChrN(600, TEXT('x'));
+		for (int32 i = 0; i < MessageCount; i++)
+		{
+			switch (i % 3)
+			{
+			case 0: Manager.AppendMessage(FConversationMessage::User(FString::Printf(TEXT("Question %d: %s"), i, *Paragraph))); break;
+			case 1: Manager.AppendMessage(FConversationMessage::Assistant(FString::Printf(TEXT("Answer %d: %s"), i, *Paragraph))); break;
+			default: Manager.AppendMessage(FConversationMessage::Tool(FString::Printf(TEXT("call_%d"), i), Paragraph)); break;
+			}
+		}
+
+		Run.Measure(TEXT("conversation.load_messages"), 200.0, [&](FString& OutError)
+		{
+			const int32 Loaded = Manager.LoadMessages(ConversationID).Num();
+			if (Loaded != MessageCount)
+			{
+				OutError = FString::Printf(TEXT("loaded %d of %d messages"), Loaded, MessageCount);
+				return false;
+			}
+			return true;
+		});
+
+		Manager.DeleteConversation(ConversationID);
+		Manager.SetCurrentConversation(PreviousID);
+	}
+
+	// Source tree: code search and listing over many small files, plus a paged text read
+
+	void RunSourceSuite(FPerfRun& Run)
+	{
+		const FString Root = FPaths::Combine(FPlatformProcess::UserTempDir(), TEXT("NeoStackPerf"), TEXT("Source"));
+		IFileManager::Get().DeleteDirectory(*Root, false, true);
+
+		const int32 FileCount = Run.Count(10000);
+		FString Body;
+		for (int32 Line = 0; Line < 40; Line++)
+		{
+			Body += FString::Printf(TEXT("\tint32 Value%d = ComputeSomething(%d); // filler line\n"), Line, Line);
+		}
+		for (int32 i = 0; i < FileCount; i++)
+		{
+			const FString Needle = i % 100 == 0 ? TEXT("\tNeoStackPerfNeedle();\n") : TEXT("");
+			const FString Contents = FString::Printf(TEXT("// Perf fixture %d\n#include \"CoreMinimal.h\"\n\nvoid Fixture%d()\n{\n%s%s}\n"),
+				i, i, *Body, *Needle);
+			FFileHelper::SaveStringToFile(Contents, *(Root / FString::Printf(TEXT("Module%02d"), i % 50) / FString::Printf(TEXT("Fixture%05d.cpp"), i)));
+		}
+
+		FString LargeFile;
+		const int32 LargeLines = Run.Count(20000);
+		for (int32 Line = 0; Line < LargeLines; Line++)
+		{
+			LargeFile += FString::Printf(TEXT("Line %d of the large read fixture with some trailing text\n"), Line);
+		}
+		FFileHelper::SaveStringToFile(LargeFile, *(Root / TEXT("Large.txt")));
+
+		TSharedRef<FJsonObject> CodeArgs = MakeArgs({ { TEXT("path"), Root }, { TEXT("type"), TEXT("code") }, { TEXT("query"), TEXT("NeoStackPerfNeedle") } });
+		Run.MeasureTool(TEXT("explore.code"), 600.0, TEXT("explore"), CodeArgs);
+
+		TSharedRef<FJsonObject> FileArgs = MakeArgs({ { TEXT("path"), Root }, { TEXT("type"), TEXT("files") }, { TEXT("pattern"), TEXT("*.cpp") } });
+		FileArgs->SetBoolField(TEXT("recursive"), true);
+		Run.MeasureTool(TEXT("explore.files"), 400.0, TEXT("explore"), FileArgs);
+
+		TSharedRef<FJsonObject> ReadArgs = MakeArgs({ { TEXT("name"), TEXT("Large.txt") }, { TEXT("path"), Root } });
+		ReadArgs->SetNumberField(TEXT("offset"), LargeLines / 2);
+		ReadArgs->SetNumberField(TEXT("limit"), 500);
+		Run.MeasureTool(TEXT("read_file.text"), 50.0, TEXT("read_asset"), ReadArgs);
+
+		IFileManager::Get().DeleteDirectory(*Root, false, true);
+	}
+
+	// Graph: one EventGraph with a long exec chain of Print String nodes
+
+	void RunGraphSuite(FPerfRun& Run)
+	{
+		TArray<UPackage*> Packages;
+		const FString Name = TEXT("BP_PerfGraph");
+		const FString Path = FString(FixtureRoot) / TEXT("Graph");
+		UBlueprint* Blueprint = CreateFixtureBlueprint(TEXT("Graph"), Name, Packages);
+		UEdGraph* Graph = Blueprint ? FBlueprintEditorUtils::FindEventGraph(Blueprint) : nullptr;
+		UFunction* PrintString = UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString));
+		if (!Graph || !PrintString)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStack] Perf: could not build the graph fixture"));
+			DestroyFixturePackages(Packages);
+			return;
+		}
+
+		const int32 NodeCount = Run.Count(5000);
+		UEdGraphPin* PreviousThen = nullptr;
+		for (int32 i = 0; i < NodeCount; i++)
+		{
+			FGraphNodeCreator<UK2Node_CallFunction> Creator(*Graph);
+			UK2Node_CallFunction* Node = Creator.CreateNode(false);
+			Node->SetFromFunction(PrintString);
+			Node->NodePosX = (i % 50) * 300;
+			Node->NodePosY = (i / 50) * 200;
+			Creator.Finalize();
+
+			if (PreviousThen)
+			{
+				PreviousThen->MakeLinkTo(Node->GetExecPin());
+			}
+			PreviousThen = Node->GetThenPin();
+		}
+
+		TSharedRef<FJsonObject> ReadArgs = MakeArgs({ { TEXT("name"), Name }, { TEXT("path"), Path } });
+		SetStringArray(ReadArgs, TEXT("include"), { TEXT("graphs") });
+		ReadArgs->SetNumberField(TEXT("limit"), 200);
+		Run.MeasureTool(TEXT("read_asset.graph"), 400.0, TEXT("read_asset"), ReadArgs,
+			[Blueprint]() { FAssetReadCache::Get().Invalidate(Blueprint); });
+
+		TSharedRef<FJsonObject> FindArgs = MakeArgs({ { TEXT("asset"), Name }, { TEXT("path"), Path } });
+		SetStringArray(FindArgs, TEXT("query"), { TEXT("print"), TEXT("string") });
+		Run.MeasureTool(TEXT("find_node"), 150.0, TEXT("find_node"), FindArgs);
+
+		// edit_graph spawns by the ID find_node reports
+		const FToolResult Found = FNeoStackToolRegistry::Get().Execute(TEXT("find_node"), FindArgs);
+		const int32 IdStart = Found.Output.Find(TEXT("  ID: "));
+		const FString SpawnerId = IdStart != INDEX_NONE
+			? Found.Output.Mid(IdStart + 6, Found.Output.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, IdStart) - IdStart - 6)
+			: FString();
+		if (SpawnerId.IsEmpty())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStack] Perf: find_node returned no spawner ID, skipping edit_graph"));
+		}
+		else
+		{
+			int32 EditIndex = 0;
+			Run.Measure(TEXT("edit_graph.add_node"), 250.0, [&](FString& OutError)
+			{
+				TSharedRef<FJsonObject> EditArgs = MakeArgs({ { TEXT("asset"), Name }, { TEXT("path"), Path } });
+				TSharedPtr<FJsonObject> NodeDef = MakeShared<FJsonObject>();
+				NodeDef->SetStringField(TEXT("id"), SpawnerId);
+				NodeDef->SetStringField(TEXT("name"), FString::Printf(TEXT("PerfNode%d"), EditIndex++));
+				TArray<TSharedPtr<FJsonValue>> AddNodes;
+				AddNodes.Add(MakeShared<FJsonValueObject>(NodeDef));
+				EditArgs->SetArrayField(TEXT("add_nodes"), AddNodes);
+
+				const FToolResult ToolResult = FNeoStackToolRegistry::Get().Execute(TEXT("edit_graph"), EditArgs);
+				if (!ToolResult.bSuccess)
+				{
+					OutError = ToolResult.Output.Left(300);
+				}
+				return ToolResult.bSuccess;
+			});
+		}
+
+		FNodeNameRegistry::Get().ClearAsset(Blueprint->GetPathName());
+		DestroyFixturePackages(Packages);
+	}
+
+	// DataTable: a user struct row type with a few columns and many rows
+
+	void RunDataTableSuite(FPerfRun& Run)
+	{
+		TArray<UPackage*> Packages;
+		UPackage* StructPackage = CreatePackage(*(FString(FixtureRoot) / TEXT("Data") / TEXT("S_PerfRow")));
+		Packages.Add(StructPackage);
+		UUserDefinedStruct* RowStruct = FStructureEditorUtils::CreateUserDefinedStruct(StructPackage, TEXT("S_PerfRow"), RF_Public | RF_Standalone);
+		if (!RowStruct)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStack] Perf: could not build the DataTable row struct"));
+			DestroyFixturePackages(Packages);
+			return;
+		}
+
+		FEdGraphPinType IntType;
+		IntType.PinCategory = UEdGraphSchema_K2::PC_Int;
+		FEdGraphPinType StringType;
+		StringType.PinCategory = UEdGraphSchema_K2::PC_String;
+		FEdGraphPinType FloatType;
+		FloatType.PinCategory = UEdGraphSchema_K2::PC_Real;
+		FloatType.PinSubCategory = UEdGraphSchema_K2::PC_Float;
+		FStructureEditorUtils::AddVariable(RowStruct, IntType);
+		FStructureEditorUtils::AddVariable(RowStruct, StringType);
+		FStructureEditorUtils::AddVariable(RowStruct, FloatType);
+
+		const FString Name = TEXT("DT_Perf");
+		const FString Path = FString(FixtureRoot) / TEXT("Data");
+		UPackage* TablePackage = CreatePackage(*(Path / Name));
+		Packages.Add(TablePackage);
+		UDataTable* DataTable = NewObject<UDataTable>(TablePackage, FName(*Name), RF_Public | RF_Standalone);
+		DataTable->RowStruct = RowStruct;
+		FAssetRegistryModule::AssetCreated(DataTable);
+
+		const int32 RowCount = Run.Count(50000);
+		uint8* RowData = (uint8*)FMemory::Malloc(RowStruct->GetStructureSize());
+		RowStruct->InitializeStruct(RowData);
+		for (int32 i = 0; i < RowCount; i++)
+		{
+			DataTable->AddRow(FName(*FString::Printf(TEXT("Row_%05d"), i)), *(FTableRowBase*)RowData);
+		}
+		RowStruct->DestroyStruct(RowData);
+		FMemory::Free(RowData);
+
+		TSharedRef<FJsonObject> ReadArgs = MakeArgs({ { TEXT("name"), Name }, { TEXT("path"), Path } });
+		SetStringArray(ReadArgs, TEXT("include"), { TEXT("summary"), TEXT("rows") });
+		ReadArgs->SetNumberField(TEXT("offset"), RowCount / 2);
+		ReadArgs->SetNumberField(TEXT("limit"), 200);
+		Run.MeasureTool(TEXT("read_asset.datatable"), 150.0, TEXT("read_asset"), ReadArgs,
+			[DataTable]() { FAssetReadCache::Get().Invalidate(DataTable); });
+
+		DestroyFixturePackages(Packages);
+	}
+
+	// Blueprints: many small Blueprint assets for the asset-registry search path
+
+	void RunBlueprintsSuite(FPerfRun& Run)
+	{
+		// Every tenth Blueprint has a variable the query finds; the rest are read and rejected
+		TArray<UPackage*> Packages;
+		const int32 BlueprintCount = Run.Count(1000);
+		FEdGraphPinType NeedleType;
+		NeedleType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+		for (int32 i = 0; i < BlueprintCount; i++)
+		{
+			UBlueprint* Blueprint = CreateFixtureBlueprint(TEXT("Blueprints"), FString::Printf(TEXT("BP_Perf%04d"), i), Packages);
+			if (Blueprint && i % 10 == 0)
+			{
+				FBlueprintEditorUtils::AddMemberVariable(Blueprint, TEXT("PerfNeedle"), NeedleType);
+			}
+		}
+
+		TSharedRef<FJsonObject> SearchArgs = MakeArgs({
+			{ TEXT("path"), FString(FixtureRoot) / TEXT("Blueprints") },
+			{ TEXT("type"), TEXT("blueprints") },
+			{ TEXT("query"), TEXT("PerfNeedle") } });
+		Run.MeasureTool(TEXT("explore.blueprints"), 200.0, TEXT("explore"), SearchArgs, nullptr,
+			[](const FString& Output) -> FString
+			{
+				const int32 CountStart = Output.Find(TEXT(" count="));
+				const int32 Count = CountStart != INDEX_NONE ? FCString::Atoi(*Output.Mid(CountStart + 7, 12)) : 0;
+				return Count > 0 ? FString() : FString::Printf(TEXT("query matched no fixture Blueprint: %s"), *Output.Left(200));
+			});
+
+		DestroyFixturePackages(Packages);
+	}
+
+	void RunPerfSuite(const TArray<FString>& Args)
+	{
+		FPerfRun Run(Args);
+
+		// Cached results would turn every iteration after the first into a lookup
+		UNeoStackSettings* Settings = GetMutableDefault<UNeoStackSettings>();
+		const bool bCacheToolResults = Settings->bCacheToolResults;
+		Settings->bCacheToolResults = false;
+
+		const double Start = FPlatformTime::Seconds();
+		if (Run.WantsSuite(TEXT("sse"))) RunSSESuite(Run);
+		if (Run.WantsSuite(TEXT("conversation"))) RunConversationSuite(Run);
+		if (Run.WantsSuite(TEXT("source"))) RunSourceSuite(Run);
+		if (Run.WantsSuite(TEXT("graph"))) RunGraphSuite(Run);
+		if (Run.WantsSuite(TEXT("datatable"))) RunDataTableSuite(Run);
+		if (Run.WantsSuite(TEXT("blueprints"))) RunBlueprintsSuite(Run);
+
+		Settings->bCacheToolResults = bCacheToolResults;
+
+		if (!Run.WriteResults())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStack] Perf: failed to write %s"), *Run.GetOutFile());
+		}
+
+		const int32 Failures = Run.GetFailureCount();
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack] Perf: %d benchmarks, %d failed, %.1f s including fixtures. Results in %s"),
+			Run.GetResultCount(), Failures, FPlatformTime::Seconds() - Start, *Run.GetOutFile());
+		if (Failures > 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStack] Perf: %d benchmarks over threshold or failing"), Failures);
+		}
+	}
+
+	FAutoConsoleCommand PerfSuiteCommand(
+		TEXT("NeoStack.Perf"),
+		TEXT("Run the NeoStack performance benchmarks on synthetic fixtures and write JSON results. Usage: NeoStack.Perf [sse|conversation|source|graph|datatable|blueprints ...] [-scale=F] [-iterations=N] [-out=File] [-thresholds=File] [-recording=File]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunPerfSuite));
+}
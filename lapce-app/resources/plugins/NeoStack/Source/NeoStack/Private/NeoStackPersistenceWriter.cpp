@@ -0,0 +1,264 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackPersistenceWriter.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Misc/FileHelper.h"
+
+FNeoStackPersistenceWriter::FNeoStackPersistenceWriter(float InSyncInterval)
+	: SyncInterval(FMath::Max(0.05f, InSyncInterval))
+{
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("NeoStack_Persistence"), 0, TPri_BelowNormal);
+}
+
+FNeoStackPersistenceWriter::~FNeoStackPersistenceWriter()
+{
+	if (CommitHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(CommitHandle);
+		CommitHandle.Reset();
+	}
+
+	if (Thread)
+	{
+		// Run() drains the queue and syncs before it returns
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+	else
+	{
+		DrainQueue();
+		SyncOpenFiles();
+	}
+
+	OpenFiles.Empty();
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+void FNeoStackPersistenceWriter::AppendLine(const FString& Path, FContentProducer&& Content, const FString& IndexPath)
+{
+	FOp Op;
+	Op.Type = EOpType::Append;
+	Op.Path = Path;
+	Op.IndexPath = IndexPath;
+	Op.Content = MoveTemp(Content);
+	Submit(MoveTemp(Op));
+}
+
+void FNeoStackPersistenceWriter::ReplaceFile(const FString& Path, FContentProducer&& Content)
+{
+	FOp Op;
+	Op.Type = EOpType::Replace;
+	Op.Path = Path;
+	Op.Content = MoveTemp(Content);
+	Submit(MoveTemp(Op));
+}
+
+void FNeoStackPersistenceWriter::ReplaceFileBytes(const FString& Path, TArray<uint8>&& Bytes)
+{
+	FOp Op;
+	Op.Type = EOpType::ReplaceBytes;
+	Op.Path = Path;
+	Op.Bytes = MoveTemp(Bytes);
+	Submit(MoveTemp(Op));
+}
+
+void FNeoStackPersistenceWriter::RemoveFile(const FString& Path)
+{
+	FOp Op;
+	Op.Type = EOpType::Delete;
+	Op.Path = Path;
+	Submit(MoveTemp(Op));
+}
+
+void FNeoStackPersistenceWriter::Submit(FOp&& Op)
+{
+	PendingOps.Increment();
+	Queue.Enqueue(MoveTemp(Op));
+
+	if (!Thread)
+	{
+		// No thread available (e.g. single-threaded commandlet) - write inline
+		DrainQueue();
+		return;
+	}
+
+	// Group commit: everything submitted this frame is written together after the frame
+	if (!CommitHandle.IsValid() && IsInGameThread())
+	{
+		CommitHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FNeoStackPersistenceWriter::OnEndOfFrame),
+			0.0f
+		);
+	}
+	else if (!IsInGameThread())
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+bool FNeoStackPersistenceWriter::OnEndOfFrame(float DeltaTime)
+{
+	CommitHandle.Reset();
+	WakeEvent->Trigger();
+
+	// One-shot
+	return false;
+}
+
+void FNeoStackPersistenceWriter::Flush()
+{
+	if (!Thread)
+	{
+		DrainQueue();
+		return;
+	}
+
+	while (PendingOps.GetValue() > 0)
+	{
+		WakeEvent->Trigger();
+		FPlatformProcess::Sleep(0.0005f);
+	}
+}
+
+uint32 FNeoStackPersistenceWriter::Run()
+{
+	double LastSync = FPlatformTime::Seconds();
+
+	while (!bShouldStop)
+	{
+		WakeEvent->Wait(FTimespan::FromSeconds(SyncInterval));
+
+		DrainQueue();
+
+		const double Now = FPlatformTime::Seconds();
+		if (Now - LastSync >= SyncInterval)
+		{
+			SyncOpenFiles();
+			LastSync = Now;
+		}
+	}
+
+	// Shutting down - nothing may be left behind
+	DrainQueue();
+	SyncOpenFiles();
+	return 0;
+}
+
+void FNeoStackPersistenceWriter::Stop()
+{
+	bShouldStop = true;
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FNeoStackPersistenceWriter::DrainQueue()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	FOp Op;
+	while (Queue.Dequeue(Op))
+	{
+		switch (Op.Type)
+		{
+		case EOpType::Append:
+			if (IFileHandle* Handle = GetAppendHandle(Op.Path))
+			{
+				if (!Op.IndexPath.IsEmpty())
+				{
+					if (IFileHandle* IndexHandle = GetAppendHandle(Op.IndexPath))
+					{
+						int64 LineStart = Handle->Tell();
+						IndexHandle->Write(reinterpret_cast<const uint8*>(&LineStart), sizeof(LineStart));
+					}
+				}
+
+				FString Line = Op.Content ? Op.Content() : FString();
+				Line += TEXT("\n");
+
+				FTCHARToUTF8 Utf8(*Line);
+				if (!Handle->Write(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length()))
+				{
+					UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to append to %s"), *Op.Path);
+				}
+				bDirty = true;
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to open %s for writing"), *Op.Path);
+			}
+			break;
+
+		case EOpType::Replace:
+			OpenFiles.Remove(Op.Path);
+			if (!FFileHelper::SaveStringToFile(Op.Content ? Op.Content() : FString(), *Op.Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+			{
+				UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to write %s"), *Op.Path);
+			}
+			break;
+
+		case EOpType::ReplaceBytes:
+			OpenFiles.Remove(Op.Path);
+			if (!FFileHelper::SaveArrayToFile(Op.Bytes, *Op.Path))
+			{
+				UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to write %s"), *Op.Path);
+			}
+			break;
+
+		case EOpType::Delete:
+			OpenFiles.Remove(Op.Path);
+			if (PlatformFile.FileExists(*Op.Path))
+			{
+				PlatformFile.DeleteFile(*Op.Path);
+			}
+			break;
+		}
+
+		PendingOps.Decrement();
+	}
+
+	// Group commit: hand the whole batch to the OS in one go
+	for (TPair<FString, TUniquePtr<IFileHandle>>& File : OpenFiles)
+	{
+		File.Value->Flush(false);
+	}
+}
+
+void FNeoStackPersistenceWriter::SyncOpenFiles()
+{
+	if (!bDirty)
+	{
+		return;
+	}
+
+	for (TPair<FString, TUniquePtr<IFileHandle>>& File : OpenFiles)
+	{
+		File.Value->Flush(true);
+	}
+	bDirty = false;
+}
+
+IFileHandle* FNeoStackPersistenceWriter::GetAppendHandle(const FString& Path)
+{
+	if (TUniquePtr<IFileHandle>* Existing = OpenFiles.Find(Path))
+	{
+		return Existing->Get();
+	}
+
+	IFileHandle* Handle = FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Path, true, true);
+	if (!Handle)
+	{
+		return nullptr;
+	}
+
+	OpenFiles.Add(Path, TUniquePtr<IFileHandle>(Handle));
+	return Handle;
+}
@@ -0,0 +1,595 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackProjectCatalog.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+	/** "NSPC" */
+	constexpr uint32 CatalogMagic = 0x4E535043;
+	constexpr int32 CatalogVersion = 1;
+
+	const TCHAR* CatalogRoot = TEXT("/Game");
+
+	/** Parent class name from the registry tag, as UClass::GetName() would return it */
+	bool ReadParentClassTag(const FAssetData& Asset, FString& OutParentName)
+	{
+		FString ParentPath;
+		if (!Asset.GetTagValue(FBlueprintTags::ParentClassPath, ParentPath) || ParentPath.IsEmpty())
+		{
+			return false;
+		}
+		OutParentName = FPackageName::ObjectPathToObjectName(FPackageName::ExportTextPathToObjectPath(ParentPath));
+		return !OutParentName.IsEmpty();
+	}
+
+	/**
+	 * Interface class names from the registry tag, comma-joined. The tag holds the exported
+	 * ImplementedInterfaces array, e.g. (Interface=/Script/CoreUObject.Class'"/Game/BPI_Foo.BPI_Foo_C"',Graphs=(...))
+	 */
+	bool ReadInterfacesTag(const FAssetData& Asset, FString& OutInterfaceList)
+	{
+		FString Exported;
+		if (!Asset.GetTagValue(FBlueprintTags::ImplementedInterfaces, Exported))
+		{
+			return false;
+		}
+
+		static const FString InterfaceKey = TEXT("Interface=");
+		TArray<FString> Terms;
+		Exported.ParseIntoArray(Terms, TEXT(","));
+		for (const FString& Term : Terms)
+		{
+			const int32 KeyIdx = Term.Find(InterfaceKey);
+			if (KeyIdx == INDEX_NONE)
+			{
+				continue;
+			}
+
+			FString Path = Term.RightChop(KeyIdx + InterfaceKey.Len());
+			Path.ReplaceInline(TEXT("\""), TEXT(""));
+			Path.ReplaceInline(TEXT("'"), TEXT(""));
+			Path.ReplaceInline(TEXT("("), TEXT(""));
+			Path.ReplaceInline(TEXT(")"), TEXT(""));
+
+			int32 LastDot = INDEX_NONE;
+			if (Path.FindLastChar(TEXT('.'), LastDot))
+			{
+				if (!OutInterfaceList.IsEmpty())
+				{
+					OutInterfaceList += TEXT(",");
+				}
+				OutInterfaceList += Path.RightChop(LastDot + 1);
+			}
+		}
+		return true;
+	}
+
+	FName MakeObjectPath(FName PackageName, FName AssetName)
+	{
+		TStringBuilder<256> Builder;
+		Builder << PackageName << TEXT('.') << AssetName;
+		return FName(Builder.ToView());
+	}
+}
+
+FNeoStackProjectCatalog& FNeoStackProjectCatalog::Get()
+{
+	static FNeoStackProjectCatalog Instance;
+	return Instance;
+}
+
+FString FNeoStackProjectCatalog::GetCatalogFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("NeoStack"), TEXT("ProjectCatalog.bin"));
+}
+
+void FNeoStackProjectCatalog::EnsureBuilt()
+{
+	check(IsInGameThread());
+
+	if (bStarted || bShutdown)
+	{
+		return;
+	}
+	bStarted = true;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FNeoStackProjectCatalog::HandleAssetAdded);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FNeoStackProjectCatalog::HandleAssetRemoved);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FNeoStackProjectCatalog::HandleAssetRenamed);
+	AssetRegistry.OnAssetUpdated().AddRaw(this, &FNeoStackProjectCatalog::HandleAssetUpdated);
+
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		// Discovery can take a while on a big project; the last session's table answers until then
+		AssetRegistry.OnFilesLoaded().AddRaw(this, &FNeoStackProjectCatalog::HandleFilesLoaded);
+		if (LoadCatalogFile())
+		{
+			bReady = true;
+			bFromCache = true;
+			RebuiltEvent.Broadcast();
+			return;
+		}
+	}
+
+	RebuildFromRegistry();
+}
+
+void FNeoStackProjectCatalog::Shutdown()
+{
+	if (bShutdown)
+	{
+		return;
+	}
+	bShutdown = true;
+
+	if (!bStarted)
+	{
+		return;
+	}
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+		AssetRegistry.OnAssetUpdated().RemoveAll(this);
+		AssetRegistry.OnFilesLoaded().RemoveAll(this);
+	}
+
+	// Flush a pending save so the next session starts from this one's table
+	if (SaveHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SaveHandle);
+		SaveHandle.Reset();
+		SaveCatalogFile(false);
+	}
+
+	ResetTable();
+	bReady = false;
+}
+
+bool FNeoStackProjectCatalog::IsCataloged(const FAssetData& Asset)
+{
+	const FNameBuilder PackagePath(Asset.PackagePath);
+	const FStringView Path = PackagePath.ToView();
+	const FStringView Root(CatalogRoot);
+	return Path.StartsWith(Root) && (Path.Len() == Root.Len() || Path[Root.Len()] == TEXT('/'));
+}
+
+void FNeoStackProjectCatalog::ResetTable()
+{
+	AssetNames.Reset();
+	PackageNames.Reset();
+	PackagePathIds.Reset();
+	ClassIds.Reset();
+	ParentClassIds.Reset();
+	InterfaceListIds.Reset();
+	PackagePaths.Reset();
+	Classes.Reset();
+	Strings.Reset();
+	RowByObjectPath.Reset();
+}
+
+void FNeoStackProjectCatalog::RebuildFromRegistry()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_ProjectCatalogBuild);
+	const double StartTime = FPlatformTime::Seconds();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByPath(FName(CatalogRoot), Assets, true);
+
+	ResetTable();
+	AssetNames.Reserve(Assets.Num());
+	PackageNames.Reserve(Assets.Num());
+	PackagePathIds.Reserve(Assets.Num());
+	ClassIds.Reserve(Assets.Num());
+	ParentClassIds.Reserve(Assets.Num());
+	InterfaceListIds.Reserve(Assets.Num());
+	RowByObjectPath.Reserve(Assets.Num());
+
+	for (const FAssetData& Asset : Assets)
+	{
+		SetRow(Asset);
+	}
+
+	bReady = true;
+	bFromCache = false;
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Project catalog built: %d assets, %d paths, %d classes in %.1f ms"),
+		Num(), PackagePaths.Values.Num(), Classes.Values.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	ScheduleSave();
+	RebuiltEvent.Broadcast();
+}
+
+void FNeoStackProjectCatalog::SetRow(const FAssetData& Asset)
+{
+	FString ParentClass;
+	FString InterfaceList;
+	const int32 ParentClassId = ReadParentClassTag(Asset, ParentClass) ? Strings.Intern(ParentClass) : INDEX_NONE;
+	const int32 InterfaceListId = ReadInterfacesTag(Asset, InterfaceList) ? Strings.Intern(InterfaceList) : INDEX_NONE;
+	const int32 PackagePathId = PackagePaths.Intern(Asset.PackagePath.ToString());
+	const int32 ClassId = Classes.Intern(Asset.AssetClassPath);
+
+	const FName ObjectPath = MakeObjectPath(Asset.PackageName, Asset.AssetName);
+	if (const int32* Existing = RowByObjectPath.Find(ObjectPath))
+	{
+		const int32 Row = *Existing;
+		PackagePathIds[Row] = PackagePathId;
+		ClassIds[Row] = ClassId;
+		ParentClassIds[Row] = ParentClassId;
+		InterfaceListIds[Row] = InterfaceListId;
+		return;
+	}
+
+	const int32 Row = AssetNames.Add(Asset.AssetName);
+	PackageNames.Add(Asset.PackageName);
+	PackagePathIds.Add(PackagePathId);
+	ClassIds.Add(ClassId);
+	ParentClassIds.Add(ParentClassId);
+	InterfaceListIds.Add(InterfaceListId);
+	RowByObjectPath.Add(ObjectPath, Row);
+}
+
+bool FNeoStackProjectCatalog::RemoveRow(const FString& ObjectPath)
+{
+	int32 Row;
+	if (!RowByObjectPath.RemoveAndCopyValue(FName(*ObjectPath), Row))
+	{
+		return false;
+	}
+
+	AssetNames.RemoveAtSwap(Row);
+	PackageNames.RemoveAtSwap(Row);
+	PackagePathIds.RemoveAtSwap(Row);
+	ClassIds.RemoveAtSwap(Row);
+	ParentClassIds.RemoveAtSwap(Row);
+	InterfaceListIds.RemoveAtSwap(Row);
+
+	// The last row moved into the hole
+	if (AssetNames.IsValidIndex(Row))
+	{
+		RowByObjectPath.Add(MakeObjectPath(PackageNames[Row], AssetNames[Row]), Row);
+	}
+	return true;
+}
+
+void FNeoStackProjectCatalog::FindInPath(const FString& PackagePath, bool bRecursive, TArray<int32>& OutRows) const
+{
+	OutRows.Reset();
+
+	FString Path = PackagePath;
+	while (Path.Len() > 1 && Path.EndsWith(TEXT("/")))
+	{
+		Path.LeftChopInline(1);
+	}
+	const FString Prefix = Path + TEXT("/");
+
+	// One string test per distinct folder, then the rows only compare ids
+	TBitArray<> PathMatches(false, PackagePaths.Values.Num());
+	for (int32 Id = 0; Id < PackagePaths.Values.Num(); ++Id)
+	{
+		const FString& Candidate = PackagePaths.Values[Id];
+		PathMatches[Id] = Candidate.Equals(Path, ESearchCase::IgnoreCase)
+			|| (bRecursive && Candidate.StartsWith(Prefix, ESearchCase::IgnoreCase));
+	}
+
+	for (int32 Row = 0; Row < PackagePathIds.Num(); ++Row)
+	{
+		if (PathMatches[PackagePathIds[Row]])
+		{
+			OutRows.Add(Row);
+		}
+	}
+}
+
+int32 FNeoStackProjectCatalog::FindByObjectPath(const FString& ObjectPath) const
+{
+	// A path that was never made a name can't be in the table
+	const FName Key(*ObjectPath, FNAME_Find);
+	if (Key.IsNone())
+	{
+		return INDEX_NONE;
+	}
+
+	const int32* Row = RowByObjectPath.Find(Key);
+	return Row ? *Row : INDEX_NONE;
+}
+
+int32 FNeoStackProjectCatalog::FindByPackage(FName PackageName) const
+{
+	const FString PackageString = PackageName.ToString();
+	return FindByObjectPath(PackageString + TEXT(".") + FPackageName::GetShortName(PackageString));
+}
+
+FString FNeoStackProjectCatalog::GetObjectPath(int32 Row) const
+{
+	return MakeObjectPath(PackageNames[Row], AssetNames[Row]).ToString();
+}
+
+bool FNeoStackProjectCatalog::GetParentClass(int32 Row, FString& OutParentClass) const
+{
+	const int32 Id = ParentClassIds[Row];
+	if (Id == INDEX_NONE)
+	{
+		return false;
+	}
+	OutParentClass = Strings.Values[Id];
+	return true;
+}
+
+bool FNeoStackProjectCatalog::GetInterfaces(int32 Row, TArray<FString>& OutInterfaces) const
+{
+	const int32 Id = InterfaceListIds[Row];
+	if (Id == INDEX_NONE)
+	{
+		return false;
+	}
+	Strings.Values[Id].ParseIntoArray(OutInterfaces, TEXT(","));
+	return true;
+}
+
+FAssetData FNeoStackProjectCatalog::GetAssetData(int32 Row) const
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	return AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(GetObjectPath(Row)));
+}
+
+bool FNeoStackProjectCatalog::LoadCatalogFile()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_ProjectCatalogLoad);
+
+	TArray<uint8> Buffer;
+	if (!FFileHelper::LoadFileToArray(Buffer, *GetCatalogFilePath(), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Buffer);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != CatalogMagic || Version != CatalogVersion)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Project catalog file is from another version, rebuilding"));
+		return false;
+	}
+
+	TArray<FString> PathValues;
+	TArray<FString> ClassValues;
+	TArray<FString> StringValues;
+	TArray<FString> AssetNameValues;
+	TArray<FString> PackageNameValues;
+	TArray<int32> PathIdValues;
+	TArray<int32> ClassIdValues;
+	TArray<int32> ParentIdValues;
+	TArray<int32> InterfaceIdValues;
+	Reader << PathValues;
+	Reader << ClassValues;
+	Reader << StringValues;
+	Reader << AssetNameValues;
+	Reader << PackageNameValues;
+	Reader << PathIdValues;
+	Reader << ClassIdValues;
+	Reader << ParentIdValues;
+	Reader << InterfaceIdValues;
+
+	const int32 RowCount = AssetNameValues.Num();
+	auto IdsValid = [RowCount](const TArray<int32>& Ids, int32 PoolSize, bool bAllowNone)
+	{
+		return Ids.Num() == RowCount && !Ids.ContainsByPredicate([PoolSize, bAllowNone](int32 Id)
+		{
+			return Id >= PoolSize || (Id < 0 && !(bAllowNone && Id == INDEX_NONE));
+		});
+	};
+
+	if (Reader.IsError() || PackageNameValues.Num() != RowCount
+		|| !IdsValid(PathIdValues, PathValues.Num(), false) || !IdsValid(ClassIdValues, ClassValues.Num(), false)
+		|| !IdsValid(ParentIdValues, StringValues.Num(), true) || !IdsValid(InterfaceIdValues, StringValues.Num(), true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Project catalog file is corrupt, rebuilding"));
+		return false;
+	}
+
+	ResetTable();
+	for (const FString& Value : PathValues)
+	{
+		PackagePaths.Intern(Value);
+	}
+	for (const FString& Value : ClassValues)
+	{
+		Classes.Intern(FTopLevelAssetPath(Value));
+	}
+	for (const FString& Value : StringValues)
+	{
+		Strings.Intern(Value);
+	}
+
+	// Pools were saved without duplicates, so the saved ids still line up
+	if (PackagePaths.Values.Num() != PathValues.Num() || Classes.Values.Num() != ClassValues.Num() || Strings.Values.Num() != StringValues.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Project catalog file is corrupt, rebuilding"));
+		ResetTable();
+		return false;
+	}
+
+	AssetNames.Reserve(RowCount);
+	PackageNames.Reserve(RowCount);
+	RowByObjectPath.Reserve(RowCount);
+	for (int32 Row = 0; Row < RowCount; ++Row)
+	{
+		AssetNames.Add(FName(*AssetNameValues[Row]));
+		PackageNames.Add(FName(*PackageNameValues[Row]));
+		RowByObjectPath.Add(MakeObjectPath(PackageNames[Row], AssetNames[Row]), Row);
+	}
+	PackagePathIds = MoveTemp(PathIdValues);
+	ClassIds = MoveTemp(ClassIdValues);
+	ParentClassIds = MoveTemp(ParentIdValues);
+	InterfaceListIds = MoveTemp(InterfaceIdValues);
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Project catalog loaded from cache: %d assets"), RowCount);
+	return true;
+}
+
+void FNeoStackProjectCatalog::SaveCatalogFile(bool bBackground) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_ProjectCatalogSave);
+
+	TArray<FString> PathValues = PackagePaths.Values;
+	TArray<FString> ClassValues;
+	ClassValues.Reserve(Classes.Values.Num());
+	for (const FTopLevelAssetPath& ClassPath : Classes.Values)
+	{
+		ClassValues.Add(ClassPath.ToString());
+	}
+	TArray<FString> StringValues = Strings.Values;
+
+	TArray<FString> AssetNameValues;
+	TArray<FString> PackageNameValues;
+	AssetNameValues.Reserve(Num());
+	PackageNameValues.Reserve(Num());
+	for (int32 Row = 0; Row < Num(); ++Row)
+	{
+		AssetNameValues.Add(AssetNames[Row].ToString());
+		PackageNameValues.Add(PackageNames[Row].ToString());
+	}
+	TArray<int32> PathIdValues = PackagePathIds;
+	TArray<int32> ClassIdValues = ClassIds;
+	TArray<int32> ParentIdValues = ParentClassIds;
+	TArray<int32> InterfaceIdValues = InterfaceListIds;
+
+	TArray<uint8> Buffer;
+	FMemoryWriter Writer(Buffer);
+	uint32 Magic = CatalogMagic;
+	int32 Version = CatalogVersion;
+	Writer << Magic;
+	Writer << Version;
+	Writer << PathValues;
+	Writer << ClassValues;
+	Writer << StringValues;
+	Writer << AssetNameValues;
+	Writer << PackageNameValues;
+	Writer << PathIdValues;
+	Writer << ClassIdValues;
+	Writer << ParentIdValues;
+	Writer << InterfaceIdValues;
+
+	auto WriteFile = [Buffer = MoveTemp(Buffer)]()
+	{
+		// Write then move so a crash mid-write never leaves a truncated catalog behind
+		const FString CatalogPath = GetCatalogFilePath();
+		const FString TempPath = CatalogPath + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(Buffer, *TempPath)
+			|| !IFileManager::Get().Move(*CatalogPath, *TempPath, true, true))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Failed to write project catalog %s"), *CatalogPath);
+		}
+	};
+
+	if (bBackground)
+	{
+		Async(EAsyncExecution::ThreadPool, MoveTemp(WriteFile));
+	}
+	else
+	{
+		WriteFile();
+	}
+}
+
+void FNeoStackProjectCatalog::ScheduleSave()
+{
+	// A table that mirrors a half-discovered registry is worse than the last full one
+	if (SaveHandle.IsValid() || bFromCache || bShutdown)
+	{
+		return;
+	}
+
+	SaveHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FNeoStackProjectCatalog::HandleSaveTick), SaveDelaySeconds);
+}
+
+bool FNeoStackProjectCatalog::HandleSaveTick(float DeltaTime)
+{
+	SaveHandle.Reset();
+	SaveCatalogFile(true);
+	return false;
+}
+
+void FNeoStackProjectCatalog::HandleFilesLoaded()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnFilesLoaded().RemoveAll(this);
+	}
+
+	RebuildFromRegistry();
+}
+
+void FNeoStackProjectCatalog::HandleAssetAdded(const FAssetData& Asset)
+{
+	// The initial discovery reports every asset; the rebuild after OnFilesLoaded covers those
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (!bReady || AssetRegistry.IsLoadingAssets() || !IsCataloged(Asset))
+	{
+		return;
+	}
+
+	SetRow(Asset);
+	ScheduleSave();
+	AssetChangedEvent.Broadcast(Asset.GetObjectPathString(), false);
+}
+
+void FNeoStackProjectCatalog::HandleAssetRemoved(const FAssetData& Asset)
+{
+	const FString ObjectPath = Asset.GetObjectPathString();
+	if (RemoveRow(ObjectPath))
+	{
+		ScheduleSave();
+		AssetChangedEvent.Broadcast(ObjectPath, true);
+	}
+}
+
+void FNeoStackProjectCatalog::HandleAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath)
+{
+	if (RemoveRow(OldObjectPath))
+	{
+		AssetChangedEvent.Broadcast(OldObjectPath, true);
+	}
+
+	if (bReady && IsCataloged(Asset))
+	{
+		SetRow(Asset);
+		AssetChangedEvent.Broadcast(Asset.GetObjectPathString(), false);
+	}
+
+	ScheduleSave();
+}
+
+void FNeoStackProjectCatalog::HandleAssetUpdated(const FAssetData& Asset)
+{
+	// Saving a Blueprint can change its parent class or interfaces tags
+	if (!bReady || !IsCataloged(Asset))
+	{
+		return;
+	}
+
+	SetRow(Asset);
+	ScheduleSave();
+	AssetChangedEvent.Broadcast(Asset.GetObjectPathString(), false);
+}
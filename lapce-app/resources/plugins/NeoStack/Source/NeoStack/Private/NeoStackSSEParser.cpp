@@ -0,0 +1,103 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackSSEParser.h"
+#include "Containers/StringConv.h"
+
+void FNeoStackSSEParser::Consume(const TArray<uint8>& Content, FOnData OnData)
+{
+	const int64 Total = Content.Num();
+	if (Total <= ProcessedBytes)
+	{
+		return;
+	}
+
+	ConsumeBytes(Content.GetData() + ProcessedBytes, Total - ProcessedBytes, OnData);
+}
+
+void FNeoStackSSEParser::ConsumeBytes(const uint8* Data, int64 Num, FOnData OnData)
+{
+	if (!Data || Num <= 0)
+	{
+		return;
+	}
+
+	ProcessedBytes += Num;
+
+	const uint8* LineStart = Data;
+	const uint8* const End = Data + Num;
+
+	for (const uint8* Cursor = Data; Cursor < End; ++Cursor)
+	{
+		if (*Cursor != '\n')
+		{
+			continue;
+		}
+
+		if (PendingLine.Num() > 0)
+		{
+			// Line started in a previous chunk - stitch it together once
+			PendingLine.Append(LineStart, static_cast<int32>(Cursor - LineStart));
+			ProcessLine(PendingLine.GetData(), PendingLine.Num(), OnData);
+			PendingLine.Reset();
+		}
+		else
+		{
+			// Fast path: the whole line is inside this chunk, decode it in place
+			ProcessLine(LineStart, static_cast<int32>(Cursor - LineStart), OnData);
+		}
+
+		LineStart = Cursor + 1;
+	}
+
+	// Carry the incomplete tail over to the next chunk
+	if (LineStart < End)
+	{
+		PendingLine.Append(LineStart, static_cast<int32>(End - LineStart));
+	}
+}
+
+void FNeoStackSSEParser::Finish(FOnData OnData)
+{
+	if (PendingLine.Num() > 0)
+	{
+		ProcessLine(PendingLine.GetData(), PendingLine.Num(), OnData);
+		PendingLine.Reset();
+	}
+}
+
+void FNeoStackSSEParser::Reset()
+{
+	ProcessedBytes = 0;
+	PendingLine.Reset();
+}
+
+void FNeoStackSSEParser::ProcessLine(const uint8* Line, int32 Len, FOnData OnData)
+{
+	// Tolerate CRLF line endings
+	if (Len > 0 && Line[Len - 1] == '\r')
+	{
+		--Len;
+	}
+
+	// Blank lines terminate events and ":" lines are comments/keep-alives - nothing to emit
+	static constexpr int32 PrefixLen = 5; // "data:"
+	if (Len < PrefixLen || FMemory::Memcmp(Line, "data:", PrefixLen) != 0)
+	{
+		return;
+	}
+
+	int32 ValueStart = PrefixLen;
+	if (ValueStart < Len && Line[ValueStart] == ' ')
+	{
+		++ValueStart;
+	}
+
+	const int32 ValueLen = Len - ValueStart;
+	if (ValueLen <= 0)
+	{
+		return;
+	}
+
+	FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Line + ValueStart), ValueLen);
+	OnData(FString(Converted.Length(), Converted.Get()));
+}
@@ -0,0 +1,377 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackSearchIndex.h"
+#include "NeoStackPersistenceWriter.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace
+{
+	constexpr int32 MinTokenLength = 2;
+	constexpr int32 MaxTokenLength = 32;
+
+	uint64 MakeMessageKey(int32 ConversationID, int32 MessageIndex)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(ConversationID)) << 32) | static_cast<uint32>(MessageIndex);
+	}
+}
+
+FNeoStackSearchIndex::FNeoStackSearchIndex(const FString& InFilePath)
+	: FilePath(InFilePath)
+{
+	bHasFile = IFileManager::Get().FileExists(*FilePath);
+}
+
+void FNeoStackSearchIndex::Tokenize(const FString& Text, TArray<FString>& OutTokens)
+{
+	FString Current;
+	for (const TCHAR C : Text)
+	{
+		if (FChar::IsAlnum(C) || C == TEXT('_'))
+		{
+			if (Current.Len() < MaxTokenLength)
+			{
+				Current.AppendChar(FChar::ToLower(C));
+			}
+			continue;
+		}
+
+		if (Current.Len() >= MinTokenLength)
+		{
+			OutTokens.Add(Current);
+		}
+		Current.Reset();
+	}
+
+	if (Current.Len() >= MinTokenLength)
+	{
+		OutTokens.Add(Current);
+	}
+}
+
+void FNeoStackSearchIndex::CountTerms(const FString& Text, TMap<FString, int32>& OutTerms)
+{
+	TArray<FString> Tokens;
+	Tokenize(Text, Tokens);
+	for (FString& Token : Tokens)
+	{
+		++OutTerms.FindOrAdd(MoveTemp(Token));
+	}
+}
+
+bool FNeoStackSearchIndex::Load()
+{
+	bLoaded = true;
+	Postings.Reset();
+	MessageCount = 0;
+	RemovalsSinceSnapshot = 0;
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+	{
+		bHasFile = false;
+		return false;
+	}
+	bHasFile = true;
+
+	for (const FString& Line : Lines)
+	{
+		TSharedPtr<FJsonObject> Entry;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+		if (!FJsonSerializer::Deserialize(Reader, Entry) || !Entry.IsValid())
+		{
+			// A crash can cut off the last line; everything before it is still valid
+			continue;
+		}
+
+		int32 ConversationID = -1;
+		if (!Entry->TryGetNumberField(TEXT("c"), ConversationID))
+		{
+			continue;
+		}
+
+		bool bRemoved = false;
+		if (Entry->TryGetBoolField(TEXT("del"), bRemoved) && bRemoved)
+		{
+			RemovePostings(ConversationID);
+			++RemovalsSinceSnapshot;
+			continue;
+		}
+
+		int32 MessageIndex = -1;
+		const TSharedPtr<FJsonObject>* TermsObject;
+		if (!Entry->TryGetNumberField(TEXT("m"), MessageIndex) || !Entry->TryGetObjectField(TEXT("t"), TermsObject))
+		{
+			continue;
+		}
+
+		TMap<FString, int32> Terms;
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Term : (*TermsObject)->Values)
+		{
+			Terms.Add(Term.Key, static_cast<int32>(Term.Value->AsNumber()));
+		}
+		AddTerms(ConversationID, MessageIndex, Terms);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Loaded search index: %d terms, %d messages"), Postings.Num(), MessageCount);
+	return true;
+}
+
+void FNeoStackSearchIndex::AddTerms(int32 ConversationID, int32 MessageIndex, const TMap<FString, int32>& Terms)
+{
+	if (Terms.Num() == 0)
+	{
+		return;
+	}
+
+	for (const TPair<FString, int32>& Term : Terms)
+	{
+		Postings.FindOrAdd(Term.Key).Add({ ConversationID, MessageIndex, Term.Value });
+	}
+	++MessageCount;
+}
+
+FString FNeoStackSearchIndex::MakeEntryLine(int32 ConversationID, int32 MessageIndex, const TMap<FString, int32>& Terms)
+{
+	TSharedRef<FJsonObject> TermsObject = MakeShared<FJsonObject>();
+	for (const TPair<FString, int32>& Term : Terms)
+	{
+		TermsObject->SetNumberField(Term.Key, Term.Value);
+	}
+
+	TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+	Entry->SetNumberField(TEXT("c"), ConversationID);
+	Entry->SetNumberField(TEXT("m"), MessageIndex);
+	Entry->SetObjectField(TEXT("t"), TermsObject);
+
+	FString Line;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+	FJsonSerializer::Serialize(Entry, JsonWriter);
+	return Line;
+}
+
+void FNeoStackSearchIndex::AddMessage(int32 ConversationID, int32 MessageIndex, const FString& Text, FNeoStackPersistenceWriter& Writer)
+{
+	TMap<FString, int32> Terms;
+	CountTerms(Text, Terms);
+	if (Terms.Num() == 0)
+	{
+		return;
+	}
+
+	if (bLoaded)
+	{
+		AddTerms(ConversationID, MessageIndex, Terms);
+	}
+
+	// Without a file the next load rebuilds from the conversations, which will include this message
+	if (bHasFile)
+	{
+		Writer.AppendLine(FilePath, [ConversationID, MessageIndex, Terms = MoveTemp(Terms)]()
+		{
+			return MakeEntryLine(ConversationID, MessageIndex, Terms);
+		});
+	}
+}
+
+void FNeoStackSearchIndex::RemovePostings(int32 ConversationID)
+{
+	TSet<int32> RemovedMessages;
+	for (auto It = Postings.CreateIterator(); It; ++It)
+	{
+		It.Value().RemoveAll([ConversationID, &RemovedMessages](const FPosting& Posting)
+		{
+			if (Posting.ConversationID == ConversationID)
+			{
+				RemovedMessages.Add(Posting.MessageIndex);
+				return true;
+			}
+			return false;
+		});
+
+		if (It.Value().Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	MessageCount = FMath::Max(0, MessageCount - RemovedMessages.Num());
+}
+
+void FNeoStackSearchIndex::RemoveConversation(int32 ConversationID, FNeoStackPersistenceWriter& Writer)
+{
+	if (bLoaded)
+	{
+		RemovePostings(ConversationID);
+	}
+
+	if (!bHasFile)
+	{
+		return;
+	}
+
+	if (bLoaded && ++RemovalsSinceSnapshot > MaxRemovalsBeforeSnapshot)
+	{
+		SaveSnapshot(Writer);
+		return;
+	}
+
+	Writer.AppendLine(FilePath, [ConversationID]()
+	{
+		return FString::Printf(TEXT("{\"c\":%d,\"del\":true}"), ConversationID);
+	});
+}
+
+void FNeoStackSearchIndex::BeginRebuild()
+{
+	bLoaded = true;
+	Postings.Reset();
+	MessageCount = 0;
+}
+
+void FNeoStackSearchIndex::AddMessageForRebuild(int32 ConversationID, int32 MessageIndex, const FString& Text)
+{
+	TMap<FString, int32> Terms;
+	CountTerms(Text, Terms);
+	AddTerms(ConversationID, MessageIndex, Terms);
+}
+
+void FNeoStackSearchIndex::SaveSnapshot(FNeoStackPersistenceWriter& Writer)
+{
+	// Regroup postings by message so the file has the same shape as the appended entries
+	TMap<uint64, TMap<FString, int32>> Messages;
+	for (const TPair<FString, TArray<FPosting>>& Term : Postings)
+	{
+		for (const FPosting& Posting : Term.Value)
+		{
+			Messages.FindOrAdd(MakeMessageKey(Posting.ConversationID, Posting.MessageIndex)).Add(Term.Key, Posting.Count);
+		}
+	}
+
+	Writer.ReplaceFile(FilePath, [Messages = MoveTemp(Messages)]()
+	{
+		FString Content;
+		for (const TPair<uint64, TMap<FString, int32>>& Message : Messages)
+		{
+			Content += MakeEntryLine(static_cast<int32>(Message.Key >> 32), static_cast<int32>(Message.Key & 0xffffffff), Message.Value);
+			Content += TEXT("\n");
+		}
+		return Content;
+	});
+
+	bHasFile = true;
+	RemovalsSinceSnapshot = 0;
+}
+
+TArray<FConversationSearchHit> FNeoStackSearchIndex::Search(const FString& Query, int32 MaxResults) const
+{
+	TArray<FConversationSearchHit> Hits;
+
+	TArray<FString> QueryTerms;
+	Tokenize(Query, QueryTerms);
+	if (QueryTerms.Num() == 0 || MessageCount == 0)
+	{
+		return Hits;
+	}
+
+	// Score every message that contains all query terms. Term weight is a plain idf, term
+	// frequency saturates so one message repeating a word does not dominate
+	TMap<uint64, float> Scores;
+	for (int32 TermIndex = 0; TermIndex < QueryTerms.Num(); ++TermIndex)
+	{
+		const FString& QueryTerm = QueryTerms[TermIndex];
+		const bool bPrefix = TermIndex == QueryTerms.Num() - 1;
+
+		TMap<uint64, float> TermScores;
+		auto AddPostings = [this, &TermScores](const TArray<FPosting>& TermPostings, float Weight)
+		{
+			const float Idf = FMath::Loge(1.0f + static_cast<float>(MessageCount) / TermPostings.Num());
+			for (const FPosting& Posting : TermPostings)
+			{
+				float& Score = TermScores.FindOrAdd(MakeMessageKey(Posting.ConversationID, Posting.MessageIndex));
+				Score = FMath::Max(Score, Weight * Idf * Posting.Count / (Posting.Count + 1.0f));
+			}
+		};
+
+		if (const TArray<FPosting>* Exact = Postings.Find(QueryTerm))
+		{
+			AddPostings(*Exact, 1.0f);
+		}
+
+		if (bPrefix)
+		{
+			// Completions of a word still being typed rank below the exact word
+			for (const TPair<FString, TArray<FPosting>>& Term : Postings)
+			{
+				if (Term.Key.Len() > QueryTerm.Len() && Term.Key.StartsWith(QueryTerm, ESearchCase::CaseSensitive))
+				{
+					AddPostings(Term.Value, 0.7f);
+				}
+			}
+		}
+
+		if (TermIndex == 0)
+		{
+			Scores = MoveTemp(TermScores);
+		}
+		else
+		{
+			for (auto It = Scores.CreateIterator(); It; ++It)
+			{
+				if (const float* TermScore = TermScores.Find(It.Key()))
+				{
+					It.Value() += *TermScore;
+				}
+				else
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		if (Scores.Num() == 0)
+		{
+			return Hits;
+		}
+	}
+
+	// One hit per conversation: its best message, nudged up by how many other messages match
+	TMap<int32, FConversationSearchHit> ByConversation;
+	for (const TPair<uint64, float>& Scored : Scores)
+	{
+		const int32 ConversationID = static_cast<int32>(Scored.Key >> 32);
+		const int32 MessageIndex = static_cast<int32>(Scored.Key & 0xffffffff);
+
+		FConversationSearchHit& Hit = ByConversation.FindOrAdd(ConversationID);
+		Hit.ConversationID = ConversationID;
+		++Hit.MatchCount;
+		if (Scored.Value > Hit.Score || (Scored.Value == Hit.Score && MessageIndex > Hit.MessageIndex))
+		{
+			Hit.Score = Scored.Value;
+			Hit.MessageIndex = MessageIndex;
+		}
+	}
+
+	ByConversation.GenerateValueArray(Hits);
+	for (FConversationSearchHit& Hit : Hits)
+	{
+		Hit.Score += 0.1f * FMath::Loge(static_cast<float>(Hit.MatchCount));
+	}
+
+	Hits.Sort([](const FConversationSearchHit& A, const FConversationSearchHit& B)
+	{
+		return A.Score != B.Score ? A.Score > B.Score : A.ConversationID > B.ConversationID;
+	});
+
+	if (Hits.Num() > MaxResults)
+	{
+		Hits.SetNum(MaxResults);
+	}
+
+	return Hits;
+}
@@ -7,6 +7,21 @@ UNeoStackSettings::UNeoStackSettings()
 	// Set default values
 	BackendURL = TEXT("http://localhost:8080");
 	APIKey = TEXT("");
+	bDeltaHistoryUpload = false;
+	HistoryTokenBudget = 100000;
+	PersistenceSyncInterval = 1.0f;
+	BlobThreshold = 8192;
+	MaxImageEdge = 1568;
+	StreamUpdateBudgetMs = 4.0f;
+	bLazyInitialization = true;
+	bCodeSearchIndex = true;
+	SharedIndexPath = TEXT("");
+	bPersistNodeNames = true;
+	ToolFrameBudgetMs = 8.0f;
+	bCacheToolResults = true;
+	MentionPrefetch = ENeoStackMentionPrefetch::WarmToolCache;
+	bSkipGCAfterToolCompiles = true;
+	bTurnCheckpoints = false;
 }
 
 UNeoStackSettings* UNeoStackSettings::Get()
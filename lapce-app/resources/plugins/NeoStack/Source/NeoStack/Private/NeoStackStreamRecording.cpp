@@ -0,0 +1,170 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackStreamRecording.h"
+#include "NeoStackAPIClient.h"
+#include "UI/SNeoStackChatArea.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	/** "NSSR" */
+	constexpr uint32 RecordingMagic = 0x4E535352;
+	constexpr int32 RecordingVersion = 1;
+
+	TAutoConsoleVariable<bool> CVarRecordStreams(
+		TEXT("NeoStack.RecordStreams"),
+		false,
+		TEXT("Write the raw bytes of every successful backend response, chunk by chunk, to Saved/NeoStack/Recordings"));
+
+	/**
+	 * NeoStack.ReplayStream File [-speed=F]
+	 *
+	 * Play a recording into the open chat as a new assistant message. -speed=1 (the default)
+	 * keeps the recorded timing, -speed=0 decodes the whole recording at once. A relative File
+	 * is looked up in the recording folder.
+	 */
+	void ReplayStreamCommand(const TArray<FString>& Args)
+	{
+		FString FilePath;
+		float Speed = 1.0f;
+		for (const FString& Arg : Args)
+		{
+			if (!FParse::Value(*Arg, TEXT("-speed="), Speed) && !Arg.StartsWith(TEXT("-")))
+			{
+				FilePath = Arg;
+			}
+		}
+
+		if (FilePath.IsEmpty())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStack] Usage: NeoStack.ReplayStream File [-speed=F]"));
+			return;
+		}
+		if (FPaths::IsRelative(FilePath))
+		{
+			FilePath = FNeoStackStreamRecording::GetRecordingDir() / FilePath;
+		}
+
+		TSharedRef<FNeoStackStreamRecording> Recording = MakeShared<FNeoStackStreamRecording>();
+		if (!Recording->LoadFromFile(FilePath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStack] Could not read stream recording %s"), *FilePath);
+			return;
+		}
+
+		TSharedPtr<SNeoStackChatArea> ChatArea = SNeoStackChatArea::Get();
+		if (!ChatArea.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStack] Open the NeoStack tab before replaying a stream"));
+			return;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Replaying %s: %d chunks, %lld bytes, %.2f s recorded"),
+			*FPaths::GetCleanFilename(FilePath), Recording->Chunks.Num(), Recording->GetNumBytes(), Recording->GetDuration());
+		ChatArea->ReplayRecording(Recording, Speed);
+	}
+
+	FAutoConsoleCommand ReplayStreamConsoleCommand(
+		TEXT("NeoStack.ReplayStream"),
+		TEXT("Play a recorded backend stream into the chat without a backend. Usage: NeoStack.ReplayStream File [-speed=F] (0 = as fast as possible)"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ReplayStreamCommand));
+}
+
+void FNeoStackStreamRecording::AddChunk(double Time, const uint8* Data, int64 Num)
+{
+	if (Num <= 0)
+	{
+		return;
+	}
+
+	FChunk& Chunk = Chunks.AddDefaulted_GetRef();
+	Chunk.Time = Time;
+	Chunk.Bytes.Append(Data, Num);
+}
+
+int64 FNeoStackStreamRecording::GetNumBytes() const
+{
+	int64 Total = 0;
+	for (const FChunk& Chunk : Chunks)
+	{
+		Total += Chunk.Bytes.Num();
+	}
+	return Total;
+}
+
+bool FNeoStackStreamRecording::SaveToFile(const FString& FilePath) const
+{
+	TArray<uint8> Buffer;
+	FMemoryWriter Writer(Buffer);
+	uint32 Magic = RecordingMagic;
+	int32 Version = RecordingVersion;
+	int32 ChunkCount = Chunks.Num();
+	Writer << Magic;
+	Writer << Version;
+	Writer << ChunkCount;
+	for (const FChunk& Chunk : Chunks)
+	{
+		double Time = Chunk.Time;
+		Writer << Time;
+		Writer << const_cast<TArray<uint8>&>(Chunk.Bytes);
+	}
+
+	// Write then move so a crash mid-write never leaves a truncated recording behind
+	const FString TempPath = FilePath + TEXT(".tmp");
+	return FFileHelper::SaveArrayToFile(Buffer, *TempPath)
+		&& IFileManager::Get().Move(*FilePath, *TempPath, true, true);
+}
+
+bool FNeoStackStreamRecording::LoadFromFile(const FString& FilePath)
+{
+	Chunks.Reset();
+
+	TArray<uint8> Buffer;
+	if (!FFileHelper::LoadFileToArray(Buffer, *FilePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Buffer);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 ChunkCount = 0;
+	Reader << Magic;
+	Reader << Version;
+	Reader << ChunkCount;
+	if (Magic != RecordingMagic || Version != RecordingVersion || ChunkCount < 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] %s is not a stream recording of this version"), *FilePath);
+		return false;
+	}
+
+	Chunks.Reserve(ChunkCount);
+	for (int32 i = 0; i < ChunkCount && !Reader.IsError(); ++i)
+	{
+		FChunk& Chunk = Chunks.AddDefaulted_GetRef();
+		Reader << Chunk.Time;
+		Reader << Chunk.Bytes;
+	}
+
+	if (Reader.IsError())
+	{
+		Chunks.Reset();
+		return false;
+	}
+	return true;
+}
+
+FString FNeoStackStreamRecording::GetRecordingDir()
+{
+	return FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("Recordings");
+}
+
+bool FNeoStackStreamRecording::IsRecordingEnabled()
+{
+	return CVarRecordStreams.GetValueOnGameThread();
+}
@@ -0,0 +1,140 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackTokenBudget.h"
+#include "NeoStackConversation.h"
+
+namespace
+{
+	/** Stored messages never change, so their estimate is cached by message ID (game thread only) */
+	TMap<FString, int32> MessageEstimateCache;
+	constexpr int32 MaxCachedEstimates = 8192;
+}
+
+int32 FNeoStackTokenEstimator::EstimateText(const FString& Text)
+{
+	int32 Tokens = 0;
+	int32 WordRun = 0;
+
+	for (const TCHAR C : Text)
+	{
+		if ((C >= TEXT('a') && C <= TEXT('z')) || (C >= TEXT('A') && C <= TEXT('Z')) || (C >= TEXT('0') && C <= TEXT('9')) || C == TEXT('_'))
+		{
+			++WordRun;
+			continue;
+		}
+
+		Tokens += (WordRun + 3) / 4;
+		WordRun = 0;
+
+		// Whitespace usually merges into the following token; everything else stands alone
+		if (C != TEXT(' ') && C != TEXT('\t') && C != TEXT('\r'))
+		{
+			++Tokens;
+		}
+	}
+
+	return Tokens + (WordRun + 3) / 4;
+}
+
+int32 FNeoStackTokenEstimator::EstimateMessage(const FConversationMessage& Message)
+{
+	if (!Message.ID.IsEmpty())
+	{
+		if (const int32* Cached = MessageEstimateCache.Find(Message.ID))
+		{
+			return *Cached;
+		}
+	}
+
+	int32 Tokens = MessageOverheadTokens + EstimateText(Message.Content);
+
+	for (const FConversationToolCall& ToolCall : Message.ToolCalls)
+	{
+		Tokens += MessageOverheadTokens + EstimateText(ToolCall.Name) + EstimateText(ToolCall.Arguments);
+	}
+
+	Tokens += Message.Images.Num() * ImageTokens;
+
+	if (!Message.ID.IsEmpty())
+	{
+		if (MessageEstimateCache.Num() >= MaxCachedEstimates)
+		{
+			MessageEstimateCache.Reset();
+		}
+		MessageEstimateCache.Add(Message.ID, Tokens);
+	}
+
+	return Tokens;
+}
+
+int32 FNeoStackTokenEstimator::EstimateHistory(const TArray<FConversationMessage>& History)
+{
+	int32 Tokens = 0;
+	for (const FConversationMessage& Message : History)
+	{
+		Tokens += EstimateMessage(Message);
+	}
+	return Tokens;
+}
+
+int32 FNeoStackHistoryCompactor::Compact(const TArray<FConversationMessage>& History, int32 TokenBudget, TMap<int32, FString>& OutDigests)
+{
+	int32 Total = FNeoStackTokenEstimator::EstimateHistory(History);
+	if (TokenBudget <= 0 || Total <= TokenBudget)
+	{
+		return Total;
+	}
+
+	// Never shorten the turn in progress
+	int32 ProtectedFrom = History.Num();
+	for (int32 i = History.Num() - 1; i >= 0; --i)
+	{
+		if (History[i].Role == TEXT("user"))
+		{
+			ProtectedFrom = i;
+			break;
+		}
+	}
+
+	// Oldest results first - they are the least likely to still matter
+	for (int32 i = 0; i < ProtectedFrom && Total > TokenBudget; ++i)
+	{
+		const FConversationMessage& Message = History[i];
+		if (Message.Role != TEXT("tool"))
+		{
+			continue;
+		}
+
+		const int32 ContentTokens = FNeoStackTokenEstimator::EstimateText(Message.Content);
+		if (ContentTokens <= MinCompactTokens || Message.Content.Len() <= DigestHeadChars + DigestTailChars)
+		{
+			continue;
+		}
+
+		FString Digest = MakeDigest(Message.Content, ContentTokens);
+		Total -= ContentTokens - FNeoStackTokenEstimator::EstimateText(Digest);
+		OutDigests.Add(i, MoveTemp(Digest));
+	}
+
+	if (Total > TokenBudget)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] History still ~%d tokens after compaction (budget %d)"), Total, TokenBudget);
+	}
+
+	return Total;
+}
+
+FString FNeoStackHistoryCompactor::MakeDigest(const FString& Result, int32 EstimatedTokens)
+{
+	if (Result.Len() <= DigestHeadChars + DigestTailChars)
+	{
+		return Result;
+	}
+
+	return FString::Printf(
+		TEXT("%s\n[... tool result compacted, ~%d tokens omitted; the full output is in the local conversation log ...]\n%s"),
+		*Result.Left(DigestHeadChars),
+		EstimatedTokens,
+		*Result.Right(DigestTailChars)
+	);
+}
@@ -0,0 +1,227 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackToolResultQueue.h"
+#include "NeoStackAPIClient.h"
+#include "NeoStackImagePipeline.h"
+#include "NeoStackSettings.h"
+#include "NeoStackTrace.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Json.h"
+
+FNeoStackToolResultQueue& FNeoStackToolResultQueue::Get()
+{
+	static FNeoStackToolResultQueue Instance;
+	return Instance;
+}
+
+void FNeoStackToolResultQueue::Enqueue(const FString& SessionID, const FString& CallID, const FString& Result,
+	const TArray<TSharedPtr<const FNeoStackProcessedImage>>& Images)
+{
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Queueing tool result - SessionID: %s, CallID: %s"), *SessionID, *CallID);
+
+	FPendingToolResult& Entry = Pending.AddDefaulted_GetRef();
+	Entry.SessionID = SessionID;
+	Entry.CallID = CallID;
+	Entry.Result = Result;
+	Entry.Images = Images;
+
+	// A batch in flight (or waiting on backoff) picks the new result up when it completes
+	if (InFlight.Num() == 0)
+	{
+		ScheduleFlush(0.0f);
+	}
+}
+
+void FNeoStackToolResultQueue::Hold(const FString& SessionID)
+{
+	Holds.FindOrAdd(SessionID)++;
+}
+
+void FNeoStackToolResultQueue::Release(const FString& SessionID)
+{
+	int32* Count = Holds.Find(SessionID);
+	if (!Count || --(*Count) > 0)
+	{
+		return;
+	}
+	Holds.Remove(SessionID);
+
+	if (InFlight.Num() == 0)
+	{
+		ScheduleFlush(0.0f);
+	}
+}
+
+void FNeoStackToolResultQueue::ScheduleFlush(float Delay)
+{
+	if (FlushHandle.IsValid())
+	{
+		return;
+	}
+
+	FlushHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FNeoStackToolResultQueue::OnFlush),
+		Delay
+	);
+}
+
+bool FNeoStackToolResultQueue::OnFlush(float DeltaTime)
+{
+	FlushHandle.Reset();
+	SendBatch();
+
+	// One-shot
+	return false;
+}
+
+void FNeoStackToolResultQueue::SendBatch()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("NeoStack_SendToolResults", NeoStackNetChannel);
+
+	// A retry re-sends the in-flight batch as is; otherwise take everything queued so far
+	// that isn't held, in order
+	if (InFlight.Num() == 0)
+	{
+		for (int32 Index = 0; Index < Pending.Num();)
+		{
+			if (Holds.Contains(Pending[Index].SessionID))
+			{
+				Index++;
+				continue;
+			}
+
+			InFlight.Add(MoveTemp(Pending[Index]));
+			Pending.RemoveAt(Index);
+			if (bBatchUnsupported)
+			{
+				break;
+			}
+		}
+
+		if (InFlight.Num() == 0)
+		{
+			return;
+		}
+	}
+
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	if (!Settings)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to get settings for tool result submission"));
+		InFlight.Reset();
+		return;
+	}
+
+	// Build JSON payload - a single result keeps the original shape and endpoint
+	TSharedPtr<FJsonObject> JsonObject;
+	FString URL;
+
+	if (InFlight.Num() == 1)
+	{
+		JsonObject = MakeResultObject(InFlight[0]);
+		URL = Settings->BackendURL + TEXT("/ai/tool-result");
+	}
+	else
+	{
+		JsonObject = MakeShareable(new FJsonObject());
+		TArray<TSharedPtr<FJsonValue>> ResultsArray;
+		ResultsArray.Reserve(InFlight.Num());
+		for (const FPendingToolResult& Entry : InFlight)
+		{
+			ResultsArray.Add(MakeShareable(new FJsonValueObject(MakeResultObject(Entry))));
+		}
+		JsonObject->SetArrayField(TEXT("results"), ResultsArray);
+		URL = Settings->BackendURL + TEXT("/ai/tool-results");
+	}
+
+	FString RequestBody;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&RequestBody);
+	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+
+	// Configure request
+	TSharedRef<IHttpRequest> Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(URL);
+	Request->SetVerb(TEXT("POST"));
+	Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	Request->SetHeader(TEXT("Connection"), TEXT("keep-alive"));
+	Request->SetHeader(TEXT("X-API-Key"), Settings->APIKey);
+	Request->SetContentAsString(RequestBody);
+	Request->OnProcessRequestComplete().BindRaw(this, &FNeoStackToolResultQueue::OnBatchComplete);
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Submitting %d tool result(s)"), InFlight.Num());
+
+	if (!Request->ProcessRequest())
+	{
+		OnBatchComplete(Request, nullptr, false);
+	}
+}
+
+TSharedRef<FJsonObject> FNeoStackToolResultQueue::MakeResultObject(const FPendingToolResult& Entry)
+{
+	TSharedRef<FJsonObject> ResultObject = MakeShared<FJsonObject>();
+	ResultObject->SetStringField(TEXT("session_id"), Entry.SessionID);
+	ResultObject->SetStringField(TEXT("call_id"), Entry.CallID);
+	ResultObject->SetStringField(TEXT("result"), Entry.Result);
+
+	if (Entry.Images.Num() > 0)
+	{
+		TArray<TSharedPtr<FJsonValue>> ImagesArray;
+		for (const TSharedPtr<const FNeoStackProcessedImage>& Image : Entry.Images)
+		{
+			ImagesArray.Add(MakeShareable(new FJsonValueObject(
+				FNeoStackAPIClient::MakeInlineImageContent(Image->MimeType, Image->Base64Data, Image->Hash))));
+		}
+		ResultObject->SetArrayField(TEXT("images"), ImagesArray);
+	}
+	return ResultObject;
+}
+
+void FNeoStackToolResultQueue::OnBatchComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	const int32 ResponseCode = Response.IsValid() ? Response->GetResponseCode() : 0;
+
+	if (bWasSuccessful && Response.IsValid() && EHttpResponseCodes::IsOk(ResponseCode))
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Submitted %d tool result(s)"), InFlight.Num());
+		InFlight.Reset();
+		RetryCount = 0;
+		ScheduleFlush(0.0f);
+		return;
+	}
+
+	// Older backends only know the single-result endpoint - split the batch up and resend
+	if (ResponseCode == EHttpResponseCodes::NotFound && InFlight.Num() > 1)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Backend has no batch tool-result endpoint, submitting individually"));
+		bBatchUnsupported = true;
+		Pending.Insert(InFlight, 0);
+		InFlight.Reset();
+		RetryCount = 0;
+		ScheduleFlush(0.0f);
+		return;
+	}
+
+	const FString Error = Response.IsValid() ? Response->GetContentAsString() : TEXT("Request failed");
+
+	// Client errors will not get better by retrying
+	const bool bRetryable = ResponseCode == 0 || ResponseCode == EHttpResponseCodes::TooManyRequests || ResponseCode >= 500;
+	if (bRetryable && RetryCount < MaxRetries)
+	{
+		const float Delay = RetryBaseDelay * FMath::Pow(2.0f, static_cast<float>(RetryCount));
+		++RetryCount;
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Tool result submission failed (%d), retry %d/%d in %.1fs - %s"),
+			ResponseCode, RetryCount, MaxRetries, Delay, *Error);
+		ScheduleFlush(Delay);
+		return;
+	}
+
+	for (const FPendingToolResult& Entry : InFlight)
+	{
+		UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to submit tool result for CallID: %s - %s"), *Entry.CallID, *Error);
+	}
+	InFlight.Reset();
+	RetryCount = 0;
+	ScheduleFlush(0.0f);
+}
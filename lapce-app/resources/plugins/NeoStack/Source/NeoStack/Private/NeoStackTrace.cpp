@@ -0,0 +1,6 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(NeoStackToolsChannel);
+UE_TRACE_CHANNEL_DEFINE(NeoStackNetChannel);
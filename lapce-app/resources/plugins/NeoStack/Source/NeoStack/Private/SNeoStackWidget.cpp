@@ -8,8 +8,12 @@
 #include "UI/SNeoStackSettingsPanel.h"
 #include "UI/SCollapsibleToolWidget.h"
 #include "NeoStackConversation.h"
+#include "NeoStackBlobStore.h"
 #include "Tools/NeoStackToolRegistry.h"
 #include "NeoStackAPIClient.h"
+#include "NeoStackToolResultQueue.h"
+#include "NeoStackSettings.h"
+#include "Dom/JsonObject.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Layout/SSplitter.h"
 #include "Widgets/Layout/SScrollBox.h"
@@ -22,6 +26,42 @@
 
 void SNeoStackWidget::Construct(const FArguments& InArgs)
 {
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	if (Settings && !Settings->bLazyInitialization)
+	{
+		BuildContent();
+		return;
+	}
+
+	// A tab restored with the editor layout is constructed during startup even if it stays in the
+	// background; active timers only run once the widget is painted, so the real UI (and the
+	// conversation, model and context loading behind it) waits until the tab is actually shown
+	ChildSlot
+	[
+		SNew(SBox)
+		.HAlign(HAlign_Center)
+		.VAlign(VAlign_Center)
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("Initializing", "Loading NeoStack..."))
+			.ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f))
+		]
+	];
+
+	RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SNeoStackWidget::OnDeferredInitialize));
+}
+
+EActiveTimerReturnType SNeoStackWidget::OnDeferredInitialize(double InCurrentTime, float InDeltaTime)
+{
+	BuildContent();
+	return EActiveTimerReturnType::Stop;
+}
+
+void SNeoStackWidget::BuildContent()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_BuildWidget);
+	const double StartTime = FPlatformTime::Seconds();
+
 	ChildSlot
 	[
 		SAssignNew(MainOverlay, SOverlay)
@@ -57,6 +97,7 @@ void SNeoStackWidget::Construct(const FArguments& InArgs)
 					SAssignNew(ChatArea, SNeoStackChatArea)
 					.OnToolApproved(this, &SNeoStackWidget::OnToolApproved)
 					.OnToolRejected(this, &SNeoStackWidget::OnToolRejected)
+					.OnLoadOlderMessages(this, &SNeoStackWidget::OnLoadOlderMessages)
 				]
 				// Input area (fixed at bottom)
 				+ SVerticalBox::Slot()
@@ -69,6 +110,8 @@ void SNeoStackWidget::Construct(const FArguments& InArgs)
 			]
 		]
 	];
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Chat UI initialized in %.1f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 }
 
 void SNeoStackWidget::OnSettingsClicked()
@@ -143,13 +186,45 @@ void SNeoStackWidget::LoadConversationIntoChat(int32 ConversationID)
 	// Clear current messages
 	ChatArea->ClearMessages();
 
-	// Get messages from conversation manager
+	// Get messages from conversation manager (only the newest page is loaded at this point)
+	FNeoStackConversationManager& ConvMgr = FNeoStackConversationManager::Get();
+	ReplayMessages(ConvMgr.GetCurrentMessages());
+}
+
+void SNeoStackWidget::OnLoadOlderMessages()
+{
 	FNeoStackConversationManager& ConvMgr = FNeoStackConversationManager::Get();
-	const TArray<FConversationMessage>& Messages = ConvMgr.GetCurrentMessages();
+	if (!ChatArea.IsValid() || !ConvMgr.HasOlderMessages())
+	{
+		return;
+	}
 
+	TArray<FConversationMessage> Page = ConvMgr.LoadOlderMessages(OlderMessagesPageSize);
+	if (Page.Num() == 0)
+	{
+		return;
+	}
+
+	ChatArea->BeginPrepend();
+	ReplayMessages(Page);
+	ChatArea->EndPrepend();
+}
+
+void SNeoStackWidget::ReplayMessages(const TArray<FConversationMessage>& Messages)
+{
 	// Replay messages into chat area
-	for (const FConversationMessage& Msg : Messages)
+	for (const FConversationMessage& Stored : Messages)
 	{
+		// Externalized payloads are only read once the message is actually shown
+		FConversationMessage Resolved;
+		const bool bNeedsResolve = FNeoStackBlobStore::NeedsResolve(Stored);
+		if (bNeedsResolve)
+		{
+			Resolved = Stored;
+			FNeoStackBlobStore::Resolve(Resolved);
+		}
+		const FConversationMessage& Msg = bNeedsResolve ? Resolved : Stored;
+
 		if (Msg.Role == TEXT("user"))
 		{
 			ChatArea->AddUserMessageWithImages(Msg.Content, Msg.Images);
@@ -199,21 +274,43 @@ void SNeoStackWidget::OnToolApproved(const FString& CallID, const FString& ToolN
 		return;
 	}
 
-	// Execute the tool via registry
-	FToolResult Result = FNeoStackToolRegistry::Get().Execute(ToolName, Args);
+	TWeakPtr<SCollapsibleToolWidget> WeakToolWidget = ChatArea->GetToolWidget(CallID);
+	FOnToolProgress OnProgress = FOnToolProgress::CreateLambda([WeakToolWidget](float Fraction, const FString& Status)
+	{
+		if (TSharedPtr<SCollapsibleToolWidget> ToolWidget = WeakToolWidget.Pin())
+		{
+			ToolWidget->SetProgress(Fraction, Status);
+		}
+	});
+
+	// Run the tool through the registry's scheduler so the editor stays responsive, reusing
+	// the args object parsed from the stream when available. Calls of one turn run side by
+	// side where they don't conflict; holding the session sends their results as one batch.
+	FNeoStackToolResultQueue::Get().Hold(SessionID);
+	TSharedPtr<FJsonObject> ArgsObject = ChatArea->GetToolArgsObject(CallID);
+	TFuture<FToolResult> Future = ArgsObject.IsValid()
+		? FNeoStackToolRegistry::Get().ExecuteAsync(ToolName, ArgsObject, MoveTemp(OnProgress))
+		: FNeoStackToolRegistry::Get().ExecuteAsync(ToolName, Args, MoveTemp(OnProgress));
 
-	// Update the tool widget with the result
-	TSharedPtr<SCollapsibleToolWidget> ToolWidget = ChatArea->GetToolWidget(CallID);
-	if (ToolWidget.IsValid())
+	// Fulfilled on the game thread; the panel may have been closed by then
+	Future.Next([WeakToolWidget, SessionID, CallID](FToolResult Result)
 	{
-		ToolWidget->SetResult(Result.Output, Result.bSuccess);
-	}
+		// Update the tool widget with the result
+		if (TSharedPtr<SCollapsibleToolWidget> ToolWidget = WeakToolWidget.Pin())
+		{
+			if (Result.bFromCache)
+			{
+				ToolWidget->SetCached(Result.CachedDurationMs);
+			}
+			ToolWidget->SetResult(Result.Output, Result.bSuccess);
+		}
 
-	// Submit result to backend (plain text output)
-	FString ResultString = Result.Output;
-	FNeoStackAPIClient::SubmitToolResult(SessionID, CallID, ResultString);
+		// Submit result to backend (plain text output plus any attached images)
+		FNeoStackAPIClient::SubmitToolResult(SessionID, CallID, Result.Output, Result.Images);
+		FNeoStackToolResultQueue::Get().Release(SessionID);
 
-	UE_LOG(LogTemp, Log, TEXT("[NeoStack Widget] Tool result submitted - Success: %d"), Result.bSuccess);
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack Widget] Tool result submitted - Success: %d"), Result.bSuccess);
+	});
 }
 
 void SNeoStackWidget::OnToolRejected(const FString& CallID)
@@ -0,0 +1,124 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/AssetDependencyGraph.h"
+#include "NeoStackProjectCatalog.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+
+FAssetDependencyGraph& FAssetDependencyGraph::Get()
+{
+	static FAssetDependencyGraph Instance;
+	return Instance;
+}
+
+void FAssetDependencyGraph::EnsureSubscribed()
+{
+	if (bSubscribed)
+	{
+		return;
+	}
+	bSubscribed = true;
+
+	FNeoStackProjectCatalog& Catalog = FNeoStackProjectCatalog::Get();
+	Catalog.EnsureBuilt();
+	Catalog.OnAssetChanged().AddRaw(this, &FAssetDependencyGraph::HandleCatalogAssetChanged);
+	Catalog.OnRebuilt().AddRaw(this, &FAssetDependencyGraph::HandleCatalogRebuilt);
+}
+
+const TArray<FName>& FAssetDependencyGraph::GetDependencies(FName PackageName)
+{
+	check(IsInGameThread());
+	EnsureSubscribed();
+
+	if (const TArray<FName>* Cached = Dependencies.Find(PackageName))
+	{
+		return *Cached;
+	}
+
+	TArray<FName> Edges;
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.GetDependencies(PackageName, Edges);
+	return Dependencies.Add(PackageName, MoveTemp(Edges));
+}
+
+const TArray<FName>& FAssetDependencyGraph::GetReferencers(FName PackageName)
+{
+	check(IsInGameThread());
+	EnsureSubscribed();
+
+	if (const TArray<FName>* Cached = Referencers.Find(PackageName))
+	{
+		return *Cached;
+	}
+
+	TArray<FName> Edges;
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.GetReferencers(PackageName, Edges);
+	return Referencers.Add(PackageName, MoveTemp(Edges));
+}
+
+void FAssetDependencyGraph::Walk(FName PackageName, EDirection Direction, int32 MaxDepth, TArray<FVisit>& OutVisits)
+{
+	TSet<FName> Seen;
+	Seen.Add(PackageName);
+
+	TArray<FName> Frontier;
+	TArray<FName> Next;
+	Frontier.Add(PackageName);
+
+	for (int32 Depth = 1; Depth <= MaxDepth && Frontier.Num() > 0; ++Depth)
+	{
+		Next.Reset();
+		for (const FName Package : Frontier)
+		{
+			// Copied: the next lookup may add to the map the reference points into
+			const TArray<FName> Edges = Direction == EDirection::Dependencies ? GetDependencies(Package) : GetReferencers(Package);
+			for (const FName Edge : Edges)
+			{
+				bool bAlreadySeen = false;
+				Seen.Add(Edge, &bAlreadySeen);
+				if (bAlreadySeen)
+				{
+					continue;
+				}
+
+				OutVisits.Add({ Edge, Direction, Depth });
+
+				// Native /Script packages have no package dependencies of their own worth following
+				if (!FPackageName::IsScriptPackage(Edge.ToString()))
+				{
+					Next.Add(Edge);
+				}
+			}
+		}
+		Swap(Frontier, Next);
+	}
+}
+
+void FAssetDependencyGraph::Shutdown()
+{
+	if (bSubscribed)
+	{
+		FNeoStackProjectCatalog::Get().OnAssetChanged().RemoveAll(this);
+		FNeoStackProjectCatalog::Get().OnRebuilt().RemoveAll(this);
+		bSubscribed = false;
+	}
+
+	Dependencies.Empty();
+	Referencers.Empty();
+}
+
+void FAssetDependencyGraph::HandleCatalogAssetChanged(const FString& ObjectPath, bool bRemoved)
+{
+	Dependencies.Remove(FName(*FPackageName::ObjectPathToPackageName(ObjectPath)));
+
+	// Whichever packages it gained or lost an edge to have stale referencer lists now
+	Referencers.Reset();
+}
+
+void FAssetDependencyGraph::HandleCatalogRebuilt()
+{
+	Dependencies.Reset();
+	Referencers.Reset();
+}
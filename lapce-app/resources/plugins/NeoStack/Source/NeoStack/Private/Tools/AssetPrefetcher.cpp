@@ -0,0 +1,176 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/AssetPrefetcher.h"
+#include "Tools/NeoStackToolUtils.h"
+#include "NeoStackProjectCatalog.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+	/** Arguments are shallow; deeper nesting is a spec tree whose leaves rarely name assets */
+	constexpr int32 MaxScanDepth = 4;
+}
+
+FAssetPrefetcher& FAssetPrefetcher::Get()
+{
+	static FAssetPrefetcher Instance;
+	return Instance;
+}
+
+void FAssetPrefetcher::AddCandidate(const FString& Value, TArray<FName>& OutPackages)
+{
+	if (OutPackages.Num() >= MaxPackagesPerCall || Value.Len() < 3 || Value[0] != TEXT('/') || Value.StartsWith(TEXT("/Script/")))
+	{
+		return;
+	}
+
+	// "/Game/BP.BP", "/Game/BP" and "Class'/Game/BP.BP'" all name the package /Game/BP
+	const FString PackageName = FPackageName::ObjectPathToPackageName(FPackageName::ExportTextPathToObjectPath(Value));
+	if (!FPackageName::IsValidLongPackageName(PackageName))
+	{
+		return;
+	}
+
+	// The catalog gives the package name in its stored case and says whether it exists without touching the disk
+	FName ExistingName;
+	FNeoStackProjectCatalog& Catalog = FNeoStackProjectCatalog::Get();
+	if (Catalog.IsReady())
+	{
+		const int32 Row = Catalog.FindByPackage(FName(*PackageName));
+		if (Row == INDEX_NONE)
+		{
+			return;
+		}
+		ExistingName = Catalog.GetPackageName(Row);
+	}
+	else if (FPackageName::DoesPackageExist(PackageName))
+	{
+		ExistingName = FName(*PackageName);
+	}
+	else
+	{
+		return;
+	}
+
+	OutPackages.AddUnique(ExistingName);
+}
+
+void FAssetPrefetcher::ScanValue(const TSharedPtr<FJsonValue>& Value, TArray<FName>& OutPackages, int32 Depth)
+{
+	if (!Value.IsValid() || Depth > MaxScanDepth || OutPackages.Num() >= MaxPackagesPerCall)
+	{
+		return;
+	}
+
+	switch (Value->Type)
+	{
+	case EJson::String:
+		AddCandidate(Value->AsString(), OutPackages);
+		break;
+
+	case EJson::Array:
+		for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+		{
+			ScanValue(Element, OutPackages, Depth + 1);
+		}
+		break;
+
+	case EJson::Object:
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Value->AsObject()->Values)
+		{
+			ScanValue(Field.Value, OutPackages, Depth + 1);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+TArray<FName> FAssetPrefetcher::Prefetch(const TSharedPtr<FJsonObject>& Args)
+{
+	TArray<FName> Packages;
+	if (!Args.IsValid())
+	{
+		return Packages;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_AssetPrefetch);
+
+	// The call's own asset, as every tool resolves it
+	FString Name, Path;
+	if (Args->TryGetStringField(TEXT("name"), Name) && !Name.IsEmpty())
+	{
+		Args->TryGetStringField(TEXT("path"), Path);
+		if (NeoStackToolUtils::IsAssetPath(Name, Path))
+		{
+			AddCandidate(NeoStackToolUtils::BuildAssetPath(Name, Path), Packages);
+		}
+	}
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Args->Values)
+	{
+		ScanValue(Field.Value, Packages, 0);
+	}
+
+	// Packages already in memory (loaded, being loaded or created in this session) need nothing
+	Packages.RemoveAll([this](const FName& PackageName)
+	{
+		return !Pending.Contains(PackageName) && FindObjectFast<UPackage>(nullptr, PackageName) != nullptr;
+	});
+
+	for (const FName& PackageName : Packages)
+	{
+		if (Pending.Contains(PackageName))
+		{
+			continue;
+		}
+
+		// Added first: the completion can run before LoadPackageAsync returns
+		Pending.Add(PackageName, INDEX_NONE);
+		const int32 RequestId = LoadPackageAsync(PackageName.ToString(),
+			FLoadPackageAsyncDelegate::CreateRaw(this, &FAssetPrefetcher::HandleLoaded));
+		if (int32* Entry = Pending.Find(PackageName))
+		{
+			*Entry = RequestId;
+		}
+	}
+
+	if (Packages.Num() > 0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Prefetching %d package(s), %d loads in flight"), Packages.Num(), Pending.Num());
+	}
+	return Packages;
+}
+
+bool FAssetPrefetcher::IsLoading(const TArray<FName>& Packages) const
+{
+	if (Pending.Num() == 0)
+	{
+		return false;
+	}
+
+	for (const FName& PackageName : Packages)
+	{
+		if (Pending.Contains(PackageName))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FAssetPrefetcher::HandleLoaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result)
+{
+	Pending.Remove(PackageName);
+
+	if (Result != EAsyncLoadingResult::Succeeded)
+	{
+		// The tool's own load reports the problem
+		UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Prefetch of %s did not succeed"), *PackageName.ToString());
+	}
+}
@@ -0,0 +1,173 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/AssetReadCache.h"
+#include "Editor.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+FAssetReadCache& FAssetReadCache::Get()
+{
+	static FAssetReadCache Instance;
+	return Instance;
+}
+
+void FAssetReadCache::RegisterDelegates()
+{
+	if (bDelegatesRegistered)
+	{
+		return;
+	}
+
+	FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FAssetReadCache::HandleObjectModified);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FAssetReadCache::HandleObjectPropertyChanged);
+	FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FAssetReadCache::HandleObjectTransacted);
+	UPackage::PackageSavedWithContextEvent.AddRaw(this, &FAssetReadCache::HandlePackageSaved);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().AddRaw(this, &FAssetReadCache::HandleBlueprintCompiled);
+	}
+	bDelegatesRegistered = true;
+}
+
+void FAssetReadCache::Shutdown()
+{
+	if (bDelegatesRegistered)
+	{
+		FCoreUObjectDelegates::OnObjectModified.RemoveAll(this);
+		FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+		FCoreUObjectDelegates::OnObjectTransacted.RemoveAll(this);
+		UPackage::PackageSavedWithContextEvent.RemoveAll(this);
+		if (GEditor)
+		{
+			GEditor->OnBlueprintCompiled().RemoveAll(this);
+		}
+		bDelegatesRegistered = false;
+	}
+
+	Entries.Empty();
+	Generations.Empty();
+}
+
+uint32 FAssetReadCache::GetGeneration(FName PackageName) const
+{
+	const uint32* Generation = Generations.Find(PackageName);
+	return (Generation ? *Generation : 0) + CompileGeneration;
+}
+
+const FString* FAssetReadCache::Find(const UObject* Asset, const FString& Key)
+{
+	if (!Asset)
+	{
+		return nullptr;
+	}
+
+	const FName PackageName = Asset->GetPackage()->GetFName();
+	FPackageEntry* Entry = Entries.Find(PackageName);
+	if (!Entry || Entry->RenderedGeneration != GetGeneration(PackageName))
+	{
+		return nullptr;
+	}
+
+	const FString* Output = Entry->Sections.Find(Key);
+	if (Output)
+	{
+		Entry->LastUsed = ++UseCounter;
+	}
+	return Output;
+}
+
+void FAssetReadCache::Store(const UObject* Asset, const FString& Key, const FString& Output)
+{
+	if (!Asset)
+	{
+		return;
+	}
+	RegisterDelegates();
+
+	const FName PackageName = Asset->GetPackage()->GetFName();
+	const uint32 Generation = GetGeneration(PackageName);
+
+	FPackageEntry* Entry = Entries.Find(PackageName);
+	if (!Entry)
+	{
+		if (Entries.Num() >= MaxCachedPackages)
+		{
+			FName Oldest;
+			uint64 OldestUse = MAX_uint64;
+			for (const TPair<FName, FPackageEntry>& Pair : Entries)
+			{
+				if (Pair.Value.LastUsed < OldestUse)
+				{
+					OldestUse = Pair.Value.LastUsed;
+					Oldest = Pair.Key;
+				}
+			}
+			Entries.Remove(Oldest);
+			Generations.Remove(Oldest);
+		}
+		Entry = &Entries.Add(PackageName);
+	}
+
+	// Sections rendered at an older generation are all stale
+	if (Entry->RenderedGeneration != Generation)
+	{
+		Entry->Sections.Reset();
+		Entry->RenderedGeneration = Generation;
+	}
+
+	Entry->Sections.Add(Key, Output);
+	Entry->LastUsed = ++UseCounter;
+}
+
+void FAssetReadCache::Invalidate(const UObject* Asset)
+{
+	BumpGeneration(Asset);
+}
+
+void FAssetReadCache::BumpGeneration(const UObject* Object)
+{
+	// Called for every Modify() in the editor; stay cheap when nothing is cached
+	if (!Object || Entries.Num() == 0)
+	{
+		return;
+	}
+
+	const UPackage* Package = Object->GetPackage();
+	if (!Package)
+	{
+		return;
+	}
+
+	const FName PackageName = Package->GetFName();
+	if (Entries.Contains(PackageName))
+	{
+		++Generations.FindOrAdd(PackageName);
+	}
+}
+
+void FAssetReadCache::HandleObjectModified(UObject* Object)
+{
+	BumpGeneration(Object);
+}
+
+void FAssetReadCache::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	BumpGeneration(Object);
+}
+
+void FAssetReadCache::HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+	BumpGeneration(Object);
+}
+
+void FAssetReadCache::HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	BumpGeneration(Package);
+}
+
+void FAssetReadCache::HandleBlueprintCompiled()
+{
+	// Compiles can reconstruct nodes and pins without touching the Blueprint package's generation
+	++CompileGeneration;
+}
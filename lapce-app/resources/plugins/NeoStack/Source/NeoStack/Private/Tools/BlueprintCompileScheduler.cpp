@@ -0,0 +1,268 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/BlueprintCompileScheduler.h"
+#include "Tools/NeoStackToolRegistry.h"
+#include "NeoStackSettings.h"
+#include "NeoStackTrace.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+FBlueprintCompileScheduler& FBlueprintCompileScheduler::Get()
+{
+	static FBlueprintCompileScheduler Instance;
+	return Instance;
+}
+
+FBlueprintCompileScheduler::FPendingCompile& FBlueprintCompileScheduler::FindOrAddPending(UBlueprint* Blueprint)
+{
+	FPendingCompile& Entry = Pending.FindOrAdd(Blueprint);
+	Entry.Blueprint = Blueprint;
+
+	if (!TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FBlueprintCompileScheduler::HandleTick), 0.0f);
+	}
+	return Entry;
+}
+
+void FBlueprintCompileScheduler::MarkStructurallyModified(UBlueprint* Blueprint)
+{
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	// What MarkBlueprintAsStructurallyModified does up front; the skeleton regeneration waits
+	Blueprint->Status = BS_Dirty;
+	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	FindOrAddPending(Blueprint).bStructural = true;
+}
+
+void FBlueprintCompileScheduler::RequestCompile(UBlueprint* Blueprint, FOnCompiled&& OnCompiled)
+{
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	FRequest& Request = FindOrAddPending(Blueprint).Requests.AddDefaulted_GetRef();
+	Request.CallerId = CurrentCaller;
+	Request.OnCompiled = OnCompiled ? MoveTemp(OnCompiled) : FOnCompiled(&FBlueprintCompileScheduler::AppendSummary);
+}
+
+bool FBlueprintCompileScheduler::FlushBlueprint(UBlueprint* Blueprint)
+{
+	FPendingCompile Entry;
+	if (!Blueprint || !Pending.RemoveAndCopyValue(Blueprint, Entry))
+	{
+		return false;
+	}
+
+	Compile(Entry);
+	return true;
+}
+
+void FBlueprintCompileScheduler::FlushCaller(uint32 CallerId)
+{
+	TArray<TObjectKey<UBlueprint>> Waiting;
+	for (const TPair<TObjectKey<UBlueprint>, FPendingCompile>& Entry : Pending)
+	{
+		if (Entry.Value.Requests.ContainsByPredicate([CallerId](const FRequest& Request) { return Request.CallerId == CallerId; }))
+		{
+			Waiting.Add(Entry.Key);
+		}
+	}
+
+	for (const TObjectKey<UBlueprint>& Key : Waiting)
+	{
+		FPendingCompile Entry;
+		if (Pending.RemoveAndCopyValue(Key, Entry))
+		{
+			Compile(Entry);
+		}
+	}
+}
+
+void FBlueprintCompileScheduler::RegenerateSkeleton(UBlueprint* Blueprint)
+{
+	if (!Blueprint || FlushBlueprint(Blueprint))
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	FKismetEditorUtilities::CompileBlueprint(Blueprint,
+		EBlueprintCompileOptions::RegenerateSkeletonOnly | EBlueprintCompileOptions::SkipGarbageCollection);
+	UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Regenerated skeleton of %s in %.1f ms"), *Blueprint->GetName(),
+		(FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FBlueprintCompileScheduler::FlushAll()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("NeoStack_FlushBlueprintCompiles", NeoStackToolsChannel);
+
+	// A compile can make an editor ask for another one; that waits for the next flush
+	TMap<TObjectKey<UBlueprint>, FPendingCompile> Batch = MoveTemp(Pending);
+	Pending.Reset();
+	for (TPair<TObjectKey<UBlueprint>, FPendingCompile>& Entry : Batch)
+	{
+		Compile(Entry.Value);
+	}
+}
+
+void FBlueprintCompileScheduler::Compile(FPendingCompile& Entry)
+{
+	UBlueprint* Blueprint = Entry.Blueprint.Get();
+	if (!Blueprint)
+	{
+		// Deleted meanwhile; the callers still get an answer
+		for (FRequest& Request : Entry.Requests)
+		{
+			FCompletedReport& Completion = Completed.FindOrAdd(Request.CallerId).AddDefaulted_GetRef();
+			Completion.Report.Messages.Add(TEXT("error: Blueprint was deleted before it compiled"));
+			Completion.Report.NumErrors = 1;
+			Completion.OnCompiled = MoveTemp(Request.OnCompiled);
+		}
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*Blueprint->GetName(), NeoStackToolsChannel);
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (Entry.Requests.Num() == 0)
+	{
+		if (!Entry.bStructural)
+		{
+			return;
+		}
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Regenerated skeleton of %s in %.1f ms"), *Blueprint->GetName(),
+			(FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return;
+	}
+
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	EBlueprintCompileOptions Options = EBlueprintCompileOptions::None;
+	if (!Settings || Settings->bSkipGCAfterToolCompiles)
+	{
+		Options |= EBlueprintCompileOptions::SkipGarbageCollection;
+	}
+
+	FCompilerResultsLog CompileLog;
+	CompileLog.SetSourcePath(Blueprint->GetPathName());
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, Options, &CompileLog);
+
+	FBlueprintCompileReport Report;
+	Report.BlueprintName = Blueprint->GetName();
+	Report.NumErrors = CompileLog.NumErrors;
+	Report.NumWarnings = CompileLog.NumWarnings;
+	Report.NumRequests = Entry.Requests.Num();
+	Report.DurationMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	for (const TSharedRef<FTokenizedMessage>& Message : CompileLog.Messages)
+	{
+		const EMessageSeverity::Type Severity = Message->GetSeverity();
+		if (Severity == EMessageSeverity::Error || Severity == EMessageSeverity::Warning)
+		{
+			Report.Messages.Add(FString::Printf(TEXT("%s: %s"),
+				Severity == EMessageSeverity::Error ? TEXT("error") : TEXT("warning"), *Message->ToText().ToString()));
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Compiled %s for %d request(s) in %.1f ms: %d errors, %d warnings"),
+		*Report.BlueprintName, Report.NumRequests, Report.DurationMs, Report.NumErrors, Report.NumWarnings);
+
+	for (FRequest& Request : Entry.Requests)
+	{
+		FCompletedReport& Completion = Completed.FindOrAdd(Request.CallerId).AddDefaulted_GetRef();
+		Completion.Report = Report;
+		Completion.OnCompiled = MoveTemp(Request.OnCompiled);
+	}
+}
+
+bool FBlueprintCompileScheduler::IsWaiting(uint32 CallerId) const
+{
+	for (const TPair<TObjectKey<UBlueprint>, FPendingCompile>& Entry : Pending)
+	{
+		for (const FRequest& Request : Entry.Value.Requests)
+		{
+			if (Request.CallerId == CallerId)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void FBlueprintCompileScheduler::ApplyReports(uint32 CallerId, FString& InOutOutput)
+{
+	TArray<FCompletedReport> Reports;
+	if (!Completed.RemoveAndCopyValue(CallerId, Reports))
+	{
+		return;
+	}
+
+	for (FCompletedReport& Completion : Reports)
+	{
+		Completion.OnCompiled(Completion.Report, InOutOutput);
+	}
+}
+
+void FBlueprintCompileScheduler::AppendSummary(const FBlueprintCompileReport& Report, FString& InOutOutput)
+{
+	if (!InOutOutput.IsEmpty() && !InOutOutput.EndsWith(TEXT("\n")))
+	{
+		InOutOutput += TEXT("\n");
+	}
+	for (const FString& Message : Report.Messages)
+	{
+		InOutOutput += FString::Printf(TEXT("! Compile %s\n"), *Message);
+	}
+	InOutOutput += FString::Printf(TEXT("= compiled %s: %d errors, %d warnings\n"), *Report.BlueprintName, Report.NumErrors, Report.NumWarnings);
+}
+
+bool FBlueprintCompileScheduler::HandleTick(float DeltaTime)
+{
+	// While tool calls run the registry flushes at the end of their batch
+	if (FNeoStackToolRegistry::IsCreated() && FNeoStackToolRegistry::Get().GetRunningTaskCount() > 0)
+	{
+		return true;
+	}
+
+	FlushAll();
+
+	// Nobody collects reports of calls made outside the registry
+	Completed.Remove(0);
+
+	if (Pending.Num() == 0)
+	{
+		TickHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FBlueprintCompileScheduler::Shutdown()
+{
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+	Pending.Reset();
+	Completed.Reset();
+}
+
+FBlueprintCompileScheduler::FCallerScope::FCallerScope(uint32 CallerId)
+	: PreviousCaller(FBlueprintCompileScheduler::Get().CurrentCaller)
+{
+	FBlueprintCompileScheduler::Get().CurrentCaller = CallerId;
+}
+
+FBlueprintCompileScheduler::FCallerScope::~FCallerScope()
+{
+	FBlueprintCompileScheduler::Get().CurrentCaller = PreviousCaller;
+}
@@ -0,0 +1,303 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/BlueprintSummaryCache.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Engine/Blueprint.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "EdGraph/EdGraph.h"
+#include "Json.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Async/Async.h"
+
+namespace
+{
+	constexpr int32 CacheVersion = 1;
+
+	TArray<TSharedPtr<FJsonValue>> ToJsonArray(const TArray<FString>& Strings)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		Values.Reserve(Strings.Num());
+		for (const FString& String : Strings)
+		{
+			Values.Add(MakeShared<FJsonValueString>(String));
+		}
+		return Values;
+	}
+
+	void ReadStringArray(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field, TArray<FString>& OutStrings)
+	{
+		Object->TryGetStringArrayField(Field, OutStrings);
+	}
+}
+
+FBlueprintSummaryCache& FBlueprintSummaryCache::Get()
+{
+	static FBlueprintSummaryCache Instance;
+	return Instance;
+}
+
+FString FBlueprintSummaryCache::GetCacheFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("blueprint_summaries.json");
+}
+
+FString FBlueprintSummaryCache::GetSavedHash(FName PackageName)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+	if (!PackageData.IsSet())
+	{
+		return FString();
+	}
+	return LexToString(PackageData->GetPackageSavedHash());
+}
+
+void FBlueprintSummaryCache::Summarize(const UBlueprint* Blueprint, FBlueprintSummary& OutSummary)
+{
+	OutSummary = FBlueprintSummary();
+	OutSummary.ParentClass = Blueprint->ParentClass ? Blueprint->ParentClass->GetName() : TEXT("None");
+
+	for (const FBPInterfaceDescription& Interface : Blueprint->ImplementedInterfaces)
+	{
+		if (Interface.Interface)
+		{
+			OutSummary.Interfaces.Add(Interface.Interface->GetName());
+		}
+	}
+
+	for (const FBPVariableDescription& Var : Blueprint->NewVariables)
+	{
+		OutSummary.Variables.Add(Var.VarName.ToString());
+	}
+
+	for (const UEdGraph* Graph : Blueprint->FunctionGraphs)
+	{
+		if (Graph)
+		{
+			OutSummary.Functions.Add(Graph->GetName());
+		}
+	}
+
+	if (Blueprint->SimpleConstructionScript)
+	{
+		for (const USCS_Node* Node : Blueprint->SimpleConstructionScript->GetAllNodes())
+		{
+			if (!Node)
+			{
+				continue;
+			}
+			OutSummary.ComponentNames.Add(Node->GetVariableName().ToString());
+			OutSummary.ComponentClasses.Add(Node->ComponentTemplate ? Node->ComponentTemplate->GetClass()->GetName() : FString());
+		}
+	}
+
+	OutSummary.GraphCount = Blueprint->UbergraphPages.Num() + Blueprint->FunctionGraphs.Num() + Blueprint->MacroGraphs.Num();
+}
+
+bool FBlueprintSummaryCache::GetSummary(const FAssetData& Asset, FBlueprintSummary& OutSummary, bool& bOutLoaded)
+{
+	bOutLoaded = false;
+	LoadIfNeeded();
+
+	// An object already in memory is the freshest source and costs nothing to read
+	if (Asset.IsAssetLoaded())
+	{
+		const UBlueprint* Blueprint = Cast<UBlueprint>(Asset.FastGetAsset(false));
+		if (!Blueprint)
+		{
+			return false;
+		}
+		Summarize(Blueprint, OutSummary);
+
+		// Unsaved edits are not what the saved hash describes
+		const UPackage* Package = Blueprint->GetOutermost();
+		if (Package && !Package->IsDirty())
+		{
+			const FString SavedHash = GetSavedHash(Asset.PackageName);
+			if (!SavedHash.IsEmpty())
+			{
+				FEntry& Entry = Entries.FindOrAdd(Asset.PackageName);
+				if (Entry.SavedHash != SavedHash)
+				{
+					Entry.SavedHash = SavedHash;
+					Entry.Summary = OutSummary;
+					bDirty = true;
+				}
+			}
+		}
+		return true;
+	}
+
+	const FString SavedHash = GetSavedHash(Asset.PackageName);
+	if (const FEntry* Entry = Entries.Find(Asset.PackageName))
+	{
+		if (!SavedHash.IsEmpty() && Entry->SavedHash == SavedHash)
+		{
+			OutSummary = Entry->Summary;
+			return true;
+		}
+	}
+
+	const UBlueprint* Blueprint = Cast<UBlueprint>(Asset.GetAsset());
+	if (!Blueprint)
+	{
+		return false;
+	}
+	bOutLoaded = true;
+
+	Summarize(Blueprint, OutSummary);
+	if (!SavedHash.IsEmpty())
+	{
+		FEntry& Entry = Entries.FindOrAdd(Asset.PackageName);
+		Entry.SavedHash = SavedHash;
+		Entry.Summary = OutSummary;
+		bDirty = true;
+	}
+	return true;
+}
+
+void FBlueprintSummaryCache::LoadIfNeeded()
+{
+	if (bLoaded)
+	{
+		return;
+	}
+	bLoaded = true;
+
+	FString Content;
+	if (!FFileHelper::LoadFileToString(Content, *GetCacheFilePath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Ignoring unreadable Blueprint summary cache"));
+		return;
+	}
+
+	int32 Version = 0;
+	const TArray<TSharedPtr<FJsonValue>>* EntriesArray;
+	if (!JsonObject->TryGetNumberField(TEXT("version"), Version) || Version != CacheVersion
+		|| !JsonObject->TryGetArrayField(TEXT("entries"), EntriesArray))
+	{
+		return;
+	}
+
+	Entries.Reserve(EntriesArray->Num());
+	for (const TSharedPtr<FJsonValue>& Value : *EntriesArray)
+	{
+		const TSharedPtr<FJsonObject>* EntryObj;
+		if (!Value->TryGetObject(EntryObj))
+		{
+			continue;
+		}
+
+		FString PackageName;
+		FEntry Entry;
+		if (!(*EntryObj)->TryGetStringField(TEXT("package"), PackageName)
+			|| !(*EntryObj)->TryGetStringField(TEXT("hash"), Entry.SavedHash))
+		{
+			continue;
+		}
+
+		(*EntryObj)->TryGetStringField(TEXT("parent"), Entry.Summary.ParentClass);
+		ReadStringArray(*EntryObj, TEXT("interfaces"), Entry.Summary.Interfaces);
+		ReadStringArray(*EntryObj, TEXT("variables"), Entry.Summary.Variables);
+		ReadStringArray(*EntryObj, TEXT("functions"), Entry.Summary.Functions);
+		ReadStringArray(*EntryObj, TEXT("components"), Entry.Summary.ComponentNames);
+		ReadStringArray(*EntryObj, TEXT("component_classes"), Entry.Summary.ComponentClasses);
+		(*EntryObj)->TryGetNumberField(TEXT("graphs"), Entry.Summary.GraphCount);
+
+		if (Entry.Summary.ComponentClasses.Num() != Entry.Summary.ComponentNames.Num())
+		{
+			Entry.Summary.ComponentClasses.SetNum(Entry.Summary.ComponentNames.Num());
+		}
+
+		Entries.Add(FName(*PackageName), MoveTemp(Entry));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Loaded %d cached Blueprint summaries"), Entries.Num());
+}
+
+void FBlueprintSummaryCache::SaveIfDirty()
+{
+	if (!bDirty)
+	{
+		return;
+	}
+
+	if (PendingSave.IsValid() && !PendingSave.IsReady())
+	{
+		// Stay dirty and write the newer entries once the running save is done
+		if (!SaveRetryHandle.IsValid())
+		{
+			SaveRetryHandle = FTSTicker::GetCoreTicker().AddTicker(
+				FTickerDelegate::CreateRaw(this, &FBlueprintSummaryCache::HandleSaveRetryTick), 0.5f);
+		}
+		return;
+	}
+	bDirty = false;
+
+	PendingSave = Async(EAsyncExecution::ThreadPool, [Snapshot = Entries]()
+	{
+		SaveEntries(Snapshot);
+	});
+}
+
+bool FBlueprintSummaryCache::HandleSaveRetryTick(float DeltaTime)
+{
+	if (PendingSave.IsValid() && !PendingSave.IsReady())
+	{
+		return true;
+	}
+
+	SaveRetryHandle.Reset();
+	SaveIfDirty();
+	return false;
+}
+
+void FBlueprintSummaryCache::SaveEntries(const TMap<FName, FEntry>& Entries)
+{
+	TArray<TSharedPtr<FJsonValue>> EntriesArray;
+	EntriesArray.Reserve(Entries.Num());
+	for (const TPair<FName, FEntry>& Pair : Entries)
+	{
+		const FBlueprintSummary& Summary = Pair.Value.Summary;
+		TSharedPtr<FJsonObject> EntryObj = MakeShared<FJsonObject>();
+		EntryObj->SetStringField(TEXT("package"), Pair.Key.ToString());
+		EntryObj->SetStringField(TEXT("hash"), Pair.Value.SavedHash);
+		EntryObj->SetStringField(TEXT("parent"), Summary.ParentClass);
+		EntryObj->SetArrayField(TEXT("interfaces"), ToJsonArray(Summary.Interfaces));
+		EntryObj->SetArrayField(TEXT("variables"), ToJsonArray(Summary.Variables));
+		EntryObj->SetArrayField(TEXT("functions"), ToJsonArray(Summary.Functions));
+		EntryObj->SetArrayField(TEXT("components"), ToJsonArray(Summary.ComponentNames));
+		EntryObj->SetArrayField(TEXT("component_classes"), ToJsonArray(Summary.ComponentClasses));
+		EntryObj->SetNumberField(TEXT("graphs"), Summary.GraphCount);
+		EntriesArray.Add(MakeShared<FJsonValueObject>(EntryObj));
+	}
+
+	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("version"), CacheVersion);
+	Root->SetArrayField(TEXT("entries"), EntriesArray);
+
+	FString Output;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), JsonWriter);
+
+	// Write then move so a crash mid-write never leaves a truncated cache behind
+	const FString CachePath = GetCacheFilePath();
+	const FString TempPath = CachePath + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(Output, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !IFileManager::Get().Move(*CachePath, *TempPath, true, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Failed to write Blueprint summary cache %s"), *CachePath);
+	}
+}
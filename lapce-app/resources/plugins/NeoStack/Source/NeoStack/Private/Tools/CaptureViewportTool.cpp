@@ -0,0 +1,557 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/CaptureViewportTool.h"
+#include "Tools/NeoStackToolUtils.h"
+#include "NeoStackImagePipeline.h"
+#include "NeoStackSettings.h"
+#include "Json.h"
+#include "Editor.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "BlueprintEditor.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "GraphEditor.h"
+#include "LevelEditor.h"
+#include "SLevelViewport.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/SlateRenderer.h"
+#include "RenderingThread.h"
+#include "RHIGPUReadback.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+#include <atomic>
+
+namespace
+{
+	/**
+	 * One region of a window's back buffer on its way to the CPU. Created on the game thread,
+	 * copied and read back on the render thread, converted on a worker.
+	 */
+	struct FBackBufferCapture
+	{
+		enum EState : int32
+		{
+			Waiting,	// for the window's next present
+			Copying,	// GPU copy enqueued, not read back yet
+			Ready,		// Pixels filled in
+			Failed
+		};
+
+		/** Window to copy from; only compared, never dereferenced off the game thread */
+		const SWindow* Window = nullptr;
+
+		/** Region in back buffer pixels */
+		FIntRect Rect;
+
+		/** Given up on after this (FPlatformTime::Seconds) */
+		double Deadline = 0.0;
+
+		TUniquePtr<FRHIGPUTextureReadback> Readback;
+
+		/** Back buffer format and copied size, set when the copy is enqueued */
+		EPixelFormat Format = PF_Unknown;
+		FIntPoint Size = FIntPoint::ZeroValue;
+
+		/** Tightly packed rows in Format */
+		TArray<uint8> Pixels;
+
+		std::atomic<int32> State{Waiting};
+		std::atomic<bool> bPollQueued{false};
+	};
+
+	using FCaptureRef = TSharedRef<FBackBufferCapture, ESPMode::ThreadSafe>;
+
+	/** Captures waiting for their window to be presented. Render thread only */
+	TArray<FCaptureRef> WaitingCaptures;
+	FSlateRenderer* HookedRenderer = nullptr;
+	FDelegateHandle BackBufferHandle;
+
+	/** Enqueue the GPU copies of captures whose window is about to be presented; render thread */
+	void HandleBackBufferReadyToPresent(SWindow& Window, const FTextureRHIRef& BackBuffer)
+	{
+		FRHICommandListImmediate& RHICmdList = FRHICommandListImmediate::Get();
+		const double Now = FPlatformTime::Seconds();
+
+		for (int32 Index = WaitingCaptures.Num() - 1; Index >= 0; --Index)
+		{
+			FBackBufferCapture& Capture = *WaitingCaptures[Index];
+			if (Now > Capture.Deadline)
+			{
+				Capture.State = FBackBufferCapture::Failed;
+				WaitingCaptures.RemoveAtSwap(Index);
+				continue;
+			}
+			if (Capture.Window != &Window || !BackBuffer.IsValid())
+			{
+				continue;
+			}
+
+			const FIntPoint Extent = BackBuffer->GetSizeXY();
+			FIntRect Rect = Capture.Rect;
+			Rect.Clip(FIntRect(0, 0, Extent.X, Extent.Y));
+			if (Rect.Area() <= 0)
+			{
+				Capture.State = FBackBufferCapture::Failed;
+				WaitingCaptures.RemoveAtSwap(Index);
+				continue;
+			}
+
+			Capture.Format = BackBuffer->GetFormat();
+			Capture.Size = Rect.Size();
+			Capture.Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("NeoStackCapture"));
+			Capture.Readback->EnqueueCopy(RHICmdList, BackBuffer, FIntVector(Rect.Min.X, Rect.Min.Y, 0), 0, FIntVector(Rect.Width(), Rect.Height(), 1));
+			Capture.State = FBackBufferCapture::Copying;
+			WaitingCaptures.RemoveAtSwap(Index);
+		}
+
+		// Nothing left to wait for: stop paying for the hook every present
+		if (WaitingCaptures.Num() == 0 && HookedRenderer)
+		{
+			HookedRenderer->OnBackBufferReadyToPresent().Remove(BackBufferHandle);
+			BackBufferHandle.Reset();
+			HookedRenderer = nullptr;
+		}
+	}
+
+	/** Have the next present of the capture's window copy its region; game thread */
+	void QueueCapture(const FCaptureRef& Capture)
+	{
+		FSlateRenderer* Renderer = FSlateApplication::Get().GetRenderer();
+		ENQUEUE_RENDER_COMMAND(NeoStackQueueCapture)([Capture, Renderer](FRHICommandListImmediate&)
+		{
+			WaitingCaptures.Add(Capture);
+			if (!HookedRenderer)
+			{
+				HookedRenderer = Renderer;
+				BackBufferHandle = Renderer->OnBackBufferReadyToPresent().AddStatic(&HandleBackBufferReadyToPresent);
+			}
+		});
+	}
+
+	/** Copy the pixels out once the GPU is done; checks once per call without waiting. Game thread */
+	void PollCapture(const FCaptureRef& Capture)
+	{
+		if (Capture->State != FBackBufferCapture::Copying || Capture->bPollQueued.exchange(true))
+		{
+			return;
+		}
+
+		ENQUEUE_RENDER_COMMAND(NeoStackPollCapture)([Capture](FRHICommandListImmediate&)
+		{
+			if (Capture->Readback->IsReady())
+			{
+				int32 RowPitchInPixels = 0;
+				const uint8* Data = static_cast<const uint8*>(Capture->Readback->Lock(RowPitchInPixels));
+				if (Data)
+				{
+					const int32 BytesPerPixel = GPixelFormats[Capture->Format].BlockBytes;
+					const int32 RowBytes = Capture->Size.X * BytesPerPixel;
+					Capture->Pixels.SetNumUninitialized(RowBytes * Capture->Size.Y);
+					for (int32 Y = 0; Y < Capture->Size.Y; ++Y)
+					{
+						FMemory::Memcpy(Capture->Pixels.GetData() + Y * RowBytes, Data + static_cast<int64>(Y) * RowPitchInPixels * BytesPerPixel, RowBytes);
+					}
+				}
+				Capture->Readback->Unlock();
+				Capture->Readback.Reset();
+				Capture->State = Data ? FBackBufferCapture::Ready : FBackBufferCapture::Failed;
+			}
+			Capture->bPollQueued = false;
+		});
+	}
+
+	/** Opaque BGRA8 from the back buffer's format; worker thread */
+	bool ConvertToBGRA(FBackBufferCapture& Capture, TArray<uint8>& OutBGRA)
+	{
+		const int32 NumPixels = Capture.Size.X * Capture.Size.Y;
+		switch (Capture.Format)
+		{
+		case PF_B8G8R8A8:
+			OutBGRA = MoveTemp(Capture.Pixels);
+			for (int32 Index = 0; Index < NumPixels; ++Index)
+			{
+				OutBGRA[Index * 4 + 3] = 255;
+			}
+			return true;
+
+		case PF_R8G8B8A8:
+			OutBGRA = MoveTemp(Capture.Pixels);
+			for (int32 Index = 0; Index < NumPixels; ++Index)
+			{
+				Swap(OutBGRA[Index * 4 + 0], OutBGRA[Index * 4 + 2]);
+				OutBGRA[Index * 4 + 3] = 255;
+			}
+			return true;
+
+		case PF_A2B10G10R10:
+		{
+			// Red in the low bits
+			OutBGRA.SetNumUninitialized(NumPixels * 4);
+			const uint32* Source = reinterpret_cast<const uint32*>(Capture.Pixels.GetData());
+			for (int32 Index = 0; Index < NumPixels; ++Index)
+			{
+				const uint32 Packed = Source[Index];
+				OutBGRA[Index * 4 + 0] = static_cast<uint8>(((Packed >> 20) & 0x3FF) >> 2);
+				OutBGRA[Index * 4 + 1] = static_cast<uint8>(((Packed >> 10) & 0x3FF) >> 2);
+				OutBGRA[Index * 4 + 2] = static_cast<uint8>((Packed & 0x3FF) >> 2);
+				OutBGRA[Index * 4 + 3] = 255;
+			}
+			return true;
+		}
+
+		case PF_FloatRGBA:
+		{
+			// Linear HDR back buffer; clamped and sRGB-encoded, which is what an SDR screenshot shows
+			OutBGRA.SetNumUninitialized(NumPixels * 4);
+			const FFloat16Color* Source = reinterpret_cast<const FFloat16Color*>(Capture.Pixels.GetData());
+			for (int32 Index = 0; Index < NumPixels; ++Index)
+			{
+				const FColor Color = FLinearColor(Source[Index]).ToFColor(true);
+				OutBGRA[Index * 4 + 0] = Color.B;
+				OutBGRA[Index * 4 + 1] = Color.G;
+				OutBGRA[Index * 4 + 2] = Color.R;
+				OutBGRA[Index * 4 + 3] = 255;
+			}
+			return true;
+		}
+
+		default:
+			return false;
+		}
+	}
+
+	void CollectVisibleGraphEditors(const TSharedRef<SWidget>& Widget, TArray<TSharedRef<SGraphEditor>>& OutEditors)
+	{
+		if (!Widget->GetVisibility().IsVisible())
+		{
+			return;
+		}
+		if (Widget->GetType() == TEXT("SGraphEditor"))
+		{
+			OutEditors.Add(StaticCastSharedRef<SGraphEditor>(Widget));
+			return;
+		}
+
+		FChildren* Children = Widget->GetChildren();
+		for (int32 Index = 0; Children && Index < Children->Num(); ++Index)
+		{
+			CollectVisibleGraphEditors(Children->GetChildAt(Index), OutEditors);
+		}
+	}
+
+	TArray<TSharedRef<SGraphEditor>> GetVisibleGraphEditors()
+	{
+		TArray<TSharedRef<SGraphEditor>> Editors;
+		for (const TSharedRef<SWindow>& Window : FSlateApplication::Get().GetInteractiveTopLevelWindows())
+		{
+			CollectVisibleGraphEditors(Window, Editors);
+		}
+		return Editors;
+	}
+}
+
+class FCaptureViewportTool::FCaptureTask : public FNeoStackToolTask
+{
+public:
+	explicit FCaptureTask(const FCaptureRequest& InRequest)
+		: Request(InRequest)
+		, StartTime(FPlatformTime::Seconds())
+	{
+	}
+
+	virtual bool Step(double Deadline) override
+	{
+		// The step after the worker only has to hand its result over
+		if (bEncoding)
+		{
+			return true;
+		}
+
+		if (!Capture.IsValid())
+		{
+			return Start();
+		}
+
+		switch (Capture->State)
+		{
+		case FBackBufferCapture::Ready:
+			Encode();
+			return false;
+
+		case FBackBufferCapture::Failed:
+			Result = FToolResult::Fail(TEXT("The window was not drawn in time; is it minimized or hidden?"));
+			return true;
+
+		default:
+			if (FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+			{
+				Result = FToolResult::Fail(TEXT("Timed out waiting for the capture"));
+				return true;
+			}
+			PollCapture(Capture.ToSharedRef());
+			return false;
+		}
+	}
+
+	/** Blocking callers: draw the window and flush the render thread instead of waiting for frames */
+	void DrawNow()
+	{
+		WaitForWorker();
+		if (Capture.IsValid() && Capture->State == FBackBufferCapture::Waiting)
+		{
+			if (TSharedPtr<SWindow> PinnedWindow = Window.Pin())
+			{
+				FSlateApplication::Get().ForceRedrawWindow(PinnedWindow.ToSharedRef());
+			}
+		}
+		FlushRenderingCommands();
+	}
+
+private:
+	/** Find the target and queue the capture; retries until the target has been laid out */
+	bool Start()
+	{
+		if (!FSlateApplication::IsInitialized() || !GEditor)
+		{
+			Result = FToolResult::Fail(TEXT("No editor window to capture in this session"));
+			return true;
+		}
+
+		FString Error;
+		if (!bValidated)
+		{
+			if (!Validate(Request, Error))
+			{
+				Result = FToolResult::Fail(Error);
+				return true;
+			}
+			bValidated = true;
+		}
+
+		TSharedPtr<SWidget> Widget = FindTargetWidget(Request, Error);
+
+		FWidgetPath Path;
+		TOptional<FArrangedWidget> Arranged;
+		if (Widget.IsValid() && FSlateApplication::Get().GeneratePathToWidgetUnchecked(Widget.ToSharedRef(), Path) && Path.IsValid())
+		{
+			Arranged = Path.FindArrangedWidget(Widget.ToSharedRef());
+		}
+
+		if (!Arranged.IsSet() || Arranged->Geometry.GetAbsoluteSize().GetMin() < 1.0f)
+		{
+			// A graph editor opened by this call needs a frame or two to be arranged
+			if (FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+			{
+				Result = FToolResult::Fail(Error.IsEmpty() ? FString(TEXT("The capture target is not visible")) : Error);
+				return true;
+			}
+			return false;
+		}
+
+		// Absolute Slate coordinates are desktop pixels, the window's back buffer starts at its own position
+		const FGeometry& WindowGeometry = Path.Widgets[0].Geometry;
+		const FVector2D Offset = FVector2D(Arranged->Geometry.GetAbsolutePosition() - WindowGeometry.GetAbsolutePosition());
+		const FVector2D Size = FVector2D(Arranged->Geometry.GetAbsoluteSize());
+
+		Capture = MakeShared<FBackBufferCapture, ESPMode::ThreadSafe>();
+		Capture->Window = &Path.GetWindow().Get();
+		Capture->Rect = FIntRect(
+			FIntPoint(FMath::RoundToInt(Offset.X), FMath::RoundToInt(Offset.Y)),
+			FIntPoint(FMath::RoundToInt(Offset.X + Size.X), FMath::RoundToInt(Offset.Y + Size.Y)));
+		Capture->Deadline = StartTime + TimeoutSeconds;
+		Window = Path.GetWindow();
+		QueueCapture(Capture.ToSharedRef());
+
+		ReportProgress(-1.0f, TEXT("capturing"));
+		return false;
+	}
+
+	/** Convert, downscale and encode off the game thread */
+	void Encode()
+	{
+		bEncoding = true;
+		ReportProgress(-1.0f, TEXT("encoding"));
+
+		// ProcessRaw runs on the worker and can't load modules there
+		FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+		int32 MaxEdge = Request.MaxEdge;
+		if (MaxEdge <= 0)
+		{
+			const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+			MaxEdge = Settings ? Settings->MaxImageEdge : 0;
+		}
+
+		RunOnWorker([this, MaxEdge]()
+		{
+			const FIntPoint SourceSize = Capture->Size;
+			TArray<uint8> BGRA;
+			if (!ConvertToBGRA(*Capture, BGRA))
+			{
+				Result = FToolResult::Fail(FString::Printf(TEXT("Unsupported back buffer format %s"), GPixelFormats[Capture->Format].Name));
+				return;
+			}
+
+			TSharedPtr<const FNeoStackProcessedImage> Image = FNeoStackImagePipeline::ProcessRaw(BGRA, SourceSize.X, SourceSize.Y, MaxEdge);
+			if (!Image.IsValid())
+			{
+				Result = FToolResult::Fail(TEXT("Failed to encode the capture"));
+				return;
+			}
+
+			Result = FToolResult::Ok(FString::Printf(TEXT("Captured %s (%dx%d), attached as %dx%d PNG %s in %.0f ms"),
+				Request.Target == TEXT("graph") ? TEXT("graph editor") : TEXT("level viewport"),
+				SourceSize.X, SourceSize.Y, Image->Width, Image->Height, *Image->Hash,
+				(FPlatformTime::Seconds() - StartTime) * 1000.0));
+			Result.Images.Add(Image);
+		});
+	}
+
+	FCaptureRequest Request;
+	double StartTime;
+	TSharedPtr<FBackBufferCapture, ESPMode::ThreadSafe> Capture;
+	TWeakPtr<SWindow> Window;
+	bool bValidated = false;
+	bool bEncoding = false;
+};
+
+FCaptureViewportTool::FCaptureRequest FCaptureViewportTool::ParseRequest(const TSharedPtr<FJsonObject>& Args)
+{
+	FCaptureRequest Request;
+	Args->TryGetStringField(TEXT("target"), Request.Target);
+	Request.Target = Request.Target.ToLower();
+	Args->TryGetStringField(TEXT("graph"), Request.GraphName);
+	Args->TryGetNumberField(TEXT("max_edge"), Request.MaxEdge);
+
+	FString Name, Path;
+	Args->TryGetStringField(TEXT("name"), Name);
+	Args->TryGetStringField(TEXT("path"), Path);
+	if (!Name.IsEmpty())
+	{
+		Request.AssetPath = NeoStackToolUtils::BuildAssetPath(Name, Path);
+		Request.Target = TEXT("graph");
+	}
+	return Request;
+}
+
+FToolResult FCaptureViewportTool::Execute(const TSharedPtr<FJsonObject>& Args)
+{
+	FCaptureTask Task(ParseRequest(Args));
+	while (!Task.Step(FPlatformTime::Seconds()))
+	{
+		Task.DrawNow();
+	}
+	return Task.Result;
+}
+
+TSharedRef<FNeoStackToolTask> FCaptureViewportTool::CreateTask(const TSharedPtr<FJsonObject>& Args)
+{
+	return MakeShared<FCaptureTask>(ParseRequest(Args));
+}
+
+bool FCaptureViewportTool::Validate(const FCaptureRequest& Request, FString& OutError)
+{
+	if (Request.Target != TEXT("viewport") && Request.Target != TEXT("graph"))
+	{
+		OutError = FString::Printf(TEXT("Unknown target '%s' (viewport or graph)"), *Request.Target);
+		return false;
+	}
+	if (!Request.AssetPath.IsEmpty() && !LoadObject<UObject>(nullptr, *Request.AssetPath))
+	{
+		OutError = FString::Printf(TEXT("Asset not found: %s"), *Request.AssetPath);
+		return false;
+	}
+	return true;
+}
+
+TSharedPtr<SWidget> FCaptureViewportTool::FindTargetWidget(const FCaptureRequest& Request, FString& OutError)
+{
+	if (Request.Target == TEXT("viewport"))
+	{
+		TSharedPtr<SWidget> Viewport = FindLevelViewport();
+		if (!Viewport.IsValid())
+		{
+			OutError = TEXT("No level viewport is open");
+		}
+		return Viewport;
+	}
+
+	if (Request.AssetPath.IsEmpty())
+	{
+		TSharedPtr<SWidget> GraphEditor = FindFocusedGraphEditor();
+		if (!GraphEditor.IsValid())
+		{
+			OutError = TEXT("No graph editor has focus; pass the asset's name and path");
+		}
+		return GraphEditor;
+	}
+
+	UObject* Asset = LoadObject<UObject>(nullptr, *Request.AssetPath);
+	TSharedPtr<SWidget> GraphEditor = Asset ? FindAssetGraphEditor(Asset, Request.GraphName) : nullptr;
+	if (!GraphEditor.IsValid())
+	{
+		OutError = FString::Printf(TEXT("No graph editor for %s is visible%s"), *Request.AssetPath,
+			Request.GraphName.IsEmpty() ? TEXT("") : *FString::Printf(TEXT(" showing '%s'"), *Request.GraphName));
+	}
+	return GraphEditor;
+}
+
+TSharedPtr<SWidget> FCaptureViewportTool::FindLevelViewport()
+{
+	FLevelEditorModule& LevelEditor = FModuleManager::LoadModuleChecked<FLevelEditorModule>(TEXT("LevelEditor"));
+	return LevelEditor.GetFirstActiveLevelViewport();
+}
+
+TSharedPtr<SWidget> FCaptureViewportTool::FindFocusedGraphEditor()
+{
+	for (TSharedPtr<SWidget> Widget = FSlateApplication::Get().GetUserFocusedWidget(0); Widget.IsValid(); Widget = Widget->GetParentWidget())
+	{
+		if (Widget->GetType() == TEXT("SGraphEditor"))
+		{
+			return Widget;
+		}
+	}
+
+	// Focus is usually in the chat panel; a lone visible graph editor is the one the user means
+	TArray<TSharedRef<SGraphEditor>> Editors = GetVisibleGraphEditors();
+	return Editors.Num() == 1 ? TSharedPtr<SWidget>(Editors[0]) : nullptr;
+}
+
+TSharedPtr<SWidget> FCaptureViewportTool::FindAssetGraphEditor(UObject* Asset, const FString& GraphName)
+{
+	// Blueprint editors can bring any of their graphs to front and hand out its panel
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
+	{
+		TSharedPtr<FBlueprintEditor> BlueprintEditor = StaticCastSharedPtr<FBlueprintEditor>(FKismetEditorUtilities::GetIBlueprintEditorForObject(Blueprint, true));
+		if (!BlueprintEditor.IsValid())
+		{
+			return nullptr;
+		}
+
+		UEdGraph* Graph = GraphName.IsEmpty() ? BlueprintEditor->GetFocusedGraph() : NeoStackToolUtils::FindGraphByName(Blueprint, GraphName);
+		if (!Graph && GraphName.IsEmpty() && Blueprint->UbergraphPages.Num() > 0)
+		{
+			Graph = Blueprint->UbergraphPages[0];
+		}
+		return Graph ? BlueprintEditor->OpenGraphAndBringToFront(Graph, false) : nullptr;
+	}
+
+	// Other graph assets (materials, behavior trees...): open the editor and look for its panel
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+	if (AssetEditorSubsystem && !AssetEditorSubsystem->FindEditorForAsset(Asset, true))
+	{
+		AssetEditorSubsystem->OpenEditorForAsset(Asset);
+	}
+
+	for (const TSharedRef<SGraphEditor>& Editor : GetVisibleGraphEditors())
+	{
+		UEdGraph* Graph = Editor->GetCurrentGraph();
+		if (Graph && (Graph->IsIn(Asset) || Graph->GetOutermost() == Asset->GetOutermost())
+			&& (GraphName.IsEmpty() || Graph->GetName().Equals(GraphName, ESearchCase::IgnoreCase)))
+		{
+			return Editor;
+		}
+	}
+	return nullptr;
+}
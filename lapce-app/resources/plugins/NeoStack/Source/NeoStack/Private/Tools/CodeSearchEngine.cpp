@@ -0,0 +1,478 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/CodeSearchEngine.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/FileHelper.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#include <cstring>
+
+namespace
+{
+	/** Bytes sniffed for NUL to classify a file as binary */
+	constexpr int64 BinarySniffBytes = 8000;
+
+	FORCEINLINE uint8 ToLowerAscii(uint8 Ch)
+	{
+		return (Ch >= 'A' && Ch <= 'Z') ? (uint8)(Ch + ('a' - 'A')) : Ch;
+	}
+
+	/** File contents, memory-mapped when the platform allows it */
+	struct FFileBytes
+	{
+		TUniquePtr<IMappedFileHandle> Handle;
+		TUniquePtr<IMappedFileRegion> Region;
+		TArray<uint8> Owned;
+		const uint8* Data = nullptr;
+		int64 Size = 0;
+
+		bool Open(const FString& Path)
+		{
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			Handle.Reset(PlatformFile.OpenMapped(*Path));
+			if (Handle.IsValid())
+			{
+				if (Handle->GetFileSize() == 0)
+				{
+					return true;
+				}
+
+				Region.Reset(Handle->MapRegion(0, Handle->GetFileSize()));
+				if (Region.IsValid())
+				{
+					Data = Region->GetMappedPtr();
+					Size = Region->GetMappedSize();
+				}
+			}
+
+			if (!Data)
+			{
+				if (!FFileHelper::LoadFileToArray(Owned, *Path, FILEREAD_Silent))
+				{
+					return false;
+				}
+				Data = Owned.GetData();
+				Size = Owned.Num();
+			}
+
+			// UTF-16 files are rare in a source tree; convert them so the scan only sees UTF-8
+			if (Size >= 2 && ((Data[0] == 0xFF && Data[1] == 0xFE) || (Data[0] == 0xFE && Data[1] == 0xFF)))
+			{
+				FString Text;
+				if (!FFileHelper::LoadFileToString(Text, *Path))
+				{
+					return false;
+				}
+				Region.Reset();
+				Handle.Reset();
+
+				FTCHARToUTF8 Utf8(*Text);
+				Owned.Reset(Utf8.Length());
+				Owned.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+				Data = Owned.GetData();
+				Size = Owned.Num();
+			}
+
+			// Skip a UTF-8 BOM
+			if (Size >= 3 && Data[0] == 0xEF && Data[1] == 0xBB && Data[2] == 0xBF)
+			{
+				Data += 3;
+				Size -= 3;
+			}
+			return true;
+		}
+
+		void Release()
+		{
+			Region.Reset();
+			Handle.Reset();
+			Owned.Empty();
+			Data = nullptr;
+			Size = 0;
+		}
+	};
+
+	/** Lowercased UTF-8 query */
+	struct FNeedle
+	{
+		TArray<uint8> Bytes;
+		uint8 First = 0;
+		uint8 FirstUpper = 0;
+
+		explicit FNeedle(const FString& Query)
+		{
+			FTCHARToUTF8 Utf8(*Query.ToLower());
+			Bytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+			for (uint8& Byte : Bytes)
+			{
+				Byte = ToLowerAscii(Byte);
+			}
+			if (Bytes.Num() > 0)
+			{
+				First = Bytes[0];
+				FirstUpper = (First >= 'a' && First <= 'z') ? (uint8)(First - ('a' - 'A')) : First;
+			}
+		}
+	};
+
+	/** Next occurrence of Byte in [From, Limit), or Limit */
+	FORCEINLINE int64 ScanByte(const uint8* Data, int64 From, int64 Limit, uint8 Byte)
+	{
+		if (From >= Limit)
+		{
+			return Limit;
+		}
+		// memchr is the CRT's vectorized byte scan
+		const void* Found = std::memchr(Data + From, Byte, (size_t)(Limit - From));
+		return Found ? (int64)(static_cast<const uint8*>(Found) - Data) : Limit;
+	}
+
+	/** First case-insensitive occurrence of Needle at or after From, or INDEX_NONE */
+	int64 FindNeedle(const uint8* Data, int64 Size, int64 From, const FNeedle& Needle)
+	{
+		const int32 NeedleLen = Needle.Bytes.Num();
+		const int64 Limit = Size - NeedleLen + 1;
+		if (NeedleLen == 0 || From >= Limit)
+		{
+			return INDEX_NONE;
+		}
+
+		// Candidate starts are found by scanning for both cases of the first byte
+		const bool bTwoCases = Needle.First != Needle.FirstUpper;
+		int64 NextLower = ScanByte(Data, From, Limit, Needle.First);
+		int64 NextUpper = bTwoCases ? ScanByte(Data, From, Limit, Needle.FirstUpper) : Limit;
+
+		while (true)
+		{
+			const int64 Candidate = FMath::Min(NextLower, NextUpper);
+			if (Candidate >= Limit)
+			{
+				return INDEX_NONE;
+			}
+
+			int32 i = 1;
+			while (i < NeedleLen && ToLowerAscii(Data[Candidate + i]) == Needle.Bytes[i])
+			{
+				++i;
+			}
+			if (i == NeedleLen)
+			{
+				return Candidate;
+			}
+
+			if (Candidate == NextLower)
+			{
+				NextLower = ScanByte(Data, Candidate + 1, Limit, Needle.First);
+			}
+			else
+			{
+				NextUpper = ScanByte(Data, Candidate + 1, Limit, Needle.FirstUpper);
+			}
+		}
+	}
+
+	/** A matching line, as byte offsets into its file */
+	struct FRawMatch
+	{
+		int64 LineStart = 0;
+		int64 LineEnd = 0;
+		int32 Line = 0;
+	};
+
+	/** Scan state of one file */
+	struct FFileScan
+	{
+		FFileBytes Bytes;
+		TArray<FRawMatch> Matches;
+		bool bBinary = false;
+
+		/** Stopped at the per-file cap, more matches may follow */
+		bool bCapped = false;
+	};
+
+	void ScanFile(const FString& Path, const FNeedle& Needle, int32 MaxMatches, FFileScan& Scan)
+	{
+		if (!Scan.Bytes.Open(Path))
+		{
+			return;
+		}
+
+		const uint8* Data = Scan.Bytes.Data;
+		const int64 Size = Scan.Bytes.Size;
+		if (Size == 0)
+		{
+			return;
+		}
+
+		if (std::memchr(Data, 0, (size_t)FMath::Min(Size, BinarySniffBytes)) != nullptr)
+		{
+			Scan.bBinary = true;
+			Scan.Bytes.Release();
+			return;
+		}
+
+		// Lines are only counted up to each match, never split up front
+		int32 LineNumber = 1;
+		int64 LineStart = 0;
+		int64 CountedTo = 0;
+		int64 SearchFrom = 0;
+
+		while (true)
+		{
+			const int64 MatchPos = FindNeedle(Data, Size, SearchFrom, Needle);
+			if (MatchPos == INDEX_NONE)
+			{
+				break;
+			}
+
+			for (int64 Newline = ScanByte(Data, CountedTo, MatchPos, '\n'); Newline < MatchPos; Newline = ScanByte(Data, Newline + 1, MatchPos, '\n'))
+			{
+				++LineNumber;
+				LineStart = Newline + 1;
+			}
+
+			FRawMatch& Match = Scan.Matches.AddDefaulted_GetRef();
+			Match.LineStart = LineStart;
+			Match.LineEnd = ScanByte(Data, MatchPos, Size, '\n');
+			Match.Line = LineNumber;
+
+			if (Scan.Matches.Num() >= MaxMatches)
+			{
+				Scan.bCapped = Match.LineEnd < Size;
+				break;
+			}
+
+			// One match per line: continue on the next one
+			if (Match.LineEnd >= Size)
+			{
+				break;
+			}
+			++LineNumber;
+			LineStart = Match.LineEnd + 1;
+			CountedTo = LineStart;
+			SearchFrom = LineStart;
+		}
+
+		if (Scan.Matches.Num() == 0)
+		{
+			Scan.Bytes.Release();
+		}
+	}
+
+	/** A line's bytes as an FString, without the line terminator */
+	FString LineToString(const uint8* Data, int64 Start, int64 End)
+	{
+		if (End > Start && Data[End - 1] == '\r')
+		{
+			--End;
+		}
+		if (End <= Start)
+		{
+			return FString();
+		}
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data + Start), (int32)(End - Start));
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	FORCEINLINE uint32 MakeTrigram(uint8 A, uint8 B, uint8 C)
+	{
+		return ((uint32)ToLowerAscii(A) << 16) | ((uint32)ToLowerAscii(B) << 8) | (uint32)ToLowerAscii(C);
+	}
+
+	void CollectTrigrams(const uint8* Data, int64 Size, TArray<uint32>& OutTrigrams)
+	{
+		OutTrigrams.Reset();
+		if (Size < 3)
+		{
+			return;
+		}
+
+		OutTrigrams.Reserve((int32)(Size - 2));
+		for (int64 i = 0; i + 2 < Size; ++i)
+		{
+			OutTrigrams.Add(MakeTrigram(Data[i], Data[i + 1], Data[i + 2]));
+		}
+
+		OutTrigrams.Sort();
+		int32 Unique = 0;
+		for (int32 i = 0; i < OutTrigrams.Num(); ++i)
+		{
+			if (Unique == 0 || OutTrigrams[Unique - 1] != OutTrigrams[i])
+			{
+				OutTrigrams[Unique++] = OutTrigrams[i];
+			}
+		}
+		OutTrigrams.SetNum(Unique, EAllowShrinking::Yes);
+	}
+
+	/** Fill content and up to Context lines on each side of a match */
+	void BuildMatch(const FString& Path, const FFileBytes& Bytes, const FRawMatch& Raw, int32 Context, FCodeSearchEngine::FMatch& OutMatch)
+	{
+		const uint8* Data = Bytes.Data;
+		const int64 Size = Bytes.Size;
+
+		OutMatch.File = Path;
+		OutMatch.Line = Raw.Line;
+		OutMatch.Content = LineToString(Data, Raw.LineStart, Raw.LineEnd);
+
+		// Walk back over the preceding lines, nearest first
+		int64 Start = Raw.LineStart;
+		for (int32 i = 0; i < Context && Start > 0; ++i)
+		{
+			const int64 PrevEnd = Start - 1;
+			int64 PrevStart = PrevEnd;
+			while (PrevStart > 0 && Data[PrevStart - 1] != '\n')
+			{
+				--PrevStart;
+			}
+			OutMatch.ContextBefore.Insert(LineToString(Data, PrevStart, PrevEnd), 0);
+			Start = PrevStart;
+		}
+
+		int64 End = Raw.LineEnd;
+		for (int32 i = 0; i < Context && End < Size; ++i)
+		{
+			const int64 NextStart = End + 1;
+			const int64 NextEnd = ScanByte(Data, NextStart, Size, '\n');
+			if (NextStart >= Size)
+			{
+				break;
+			}
+			OutMatch.ContextAfter.Add(LineToString(Data, NextStart, NextEnd));
+			End = NextEnd;
+		}
+	}
+}
+
+bool FCodeSearchEngine::IsSearchableExtension(const FString& Extension)
+{
+	static const TSet<FString> Extensions = {
+		TEXT("cpp"), TEXT("h"), TEXT("c"), TEXT("hpp"), TEXT("cs"), TEXT("txt"),
+		TEXT("ini"), TEXT("json"), TEXT("xml"), TEXT("yaml"), TEXT("md"), TEXT("py")
+	};
+	return Extensions.Contains(Extension);
+}
+
+FCodeSearchEngine::EFileKind FCodeSearchEngine::ReadFileTrigrams(const FString& Path, TArray<uint32>& OutTrigrams, uint64* OutContentHash)
+{
+	OutTrigrams.Reset();
+	if (OutContentHash)
+	{
+		*OutContentHash = 0;
+	}
+
+	FFileBytes Bytes;
+	if (!Bytes.Open(Path))
+	{
+		return EFileKind::Unindexed;
+	}
+
+	if (OutContentHash)
+	{
+		*OutContentHash = FXxHash64::HashBuffer(Bytes.Data, Bytes.Size).Hash;
+	}
+	if (Bytes.Size > MaxIndexedFileSize)
+	{
+		return EFileKind::Unindexed;
+	}
+
+	if (Bytes.Size > 0 && std::memchr(Bytes.Data, 0, (size_t)FMath::Min(Bytes.Size, BinarySniffBytes)) != nullptr)
+	{
+		return EFileKind::Binary;
+	}
+
+	CollectTrigrams(Bytes.Data, Bytes.Size, OutTrigrams);
+	return EFileKind::Text;
+}
+
+bool FCodeSearchEngine::HashFile(const FString& Path, uint64& OutHash)
+{
+	// Same bytes ReadFileTrigrams hashes, UTF-16 conversion included
+	FFileBytes Bytes;
+	if (!Bytes.Open(Path))
+	{
+		return false;
+	}
+
+	OutHash = FXxHash64::HashBuffer(Bytes.Data, Bytes.Size).Hash;
+	return true;
+}
+
+void FCodeSearchEngine::GetQueryTrigrams(const FString& Query, TArray<uint32>& OutTrigrams)
+{
+	const FNeedle Needle(Query);
+	CollectTrigrams(Needle.Bytes.GetData(), Needle.Bytes.Num(), OutTrigrams);
+}
+
+FCodeSearchEngine::FResult FCodeSearchEngine::Search(const TArray<FString>& Files, const FString& Query, int32 Context, int32 Offset, int32 Limit)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_CodeSearch);
+	const double StartTime = FPlatformTime::Seconds();
+
+	FResult Result;
+	const FNeedle Needle(Query);
+	if (Needle.Bytes.Num() == 0)
+	{
+		return Result;
+	}
+
+	Offset = FMath::Max(0, Offset);
+	Limit = FMath::Max(0, Limit);
+	Context = FMath::Max(0, Context);
+
+	// Matches needed to fill the page; no file can contribute more than that
+	const int32 Needed = (int32)FMath::Min<int64>((int64)Offset + Limit, MAX_int32);
+	const int32 MaxMatchesPerFile = FMath::Max(1, Needed);
+
+	int32 BatchStart = 0;
+	while (BatchStart < Files.Num())
+	{
+		const int32 BatchCount = FMath::Min(FilesPerBatch, Files.Num() - BatchStart);
+
+		TArray<FFileScan> Scans;
+		Scans.SetNum(BatchCount);
+		ParallelFor(BatchCount, [&](int32 Index)
+		{
+			ScanFile(Files[BatchStart + Index], Needle, MaxMatchesPerFile, Scans[Index]);
+		});
+
+		// Merge in file order so pages are stable
+		for (int32 Index = 0; Index < BatchCount; ++Index)
+		{
+			FFileScan& Scan = Scans[Index];
+			Result.BinaryFilesSkipped += Scan.bBinary ? 1 : 0;
+
+			for (const FRawMatch& Raw : Scan.Matches)
+			{
+				const int32 GlobalIndex = Result.TotalFound++;
+				if (GlobalIndex >= Offset && GlobalIndex < Needed)
+				{
+					BuildMatch(Files[BatchStart + Index], Scan.Bytes, Raw, Context, Result.Matches.AddDefaulted_GetRef());
+				}
+			}
+
+			if (Scan.bCapped)
+			{
+				Result.bComplete = false;
+			}
+		}
+
+		Result.FilesSearched += BatchCount;
+		BatchStart += BatchCount;
+
+		if (Result.TotalFound >= Needed && BatchStart < Files.Num())
+		{
+			Result.bComplete = false;
+			break;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Code search \"%s\": %d matches in %d/%d files (%d binary skipped) in %.1f ms%s"),
+		*Query, Result.TotalFound, Result.FilesSearched, Files.Num(), Result.BinaryFilesSkipped,
+		(FPlatformTime::Seconds() - StartTime) * 1000.0, Result.bComplete ? TEXT("") : TEXT(", stopped early"));
+
+	return Result;
+}
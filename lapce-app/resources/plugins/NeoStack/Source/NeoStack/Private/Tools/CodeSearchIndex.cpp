@@ -0,0 +1,752 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/CodeSearchIndex.h"
+#include "NeoStackSettings.h"
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+	/** "NSCI" */
+	constexpr uint32 IndexMagic = 0x4E534349;
+	constexpr int32 IndexVersion = 2;
+
+	/** Stands for the project directory in stored paths */
+	const TCHAR* ProjectDirToken = TEXT("{Project}/");
+}
+
+FCodeSearchIndex& FCodeSearchIndex::Get()
+{
+	static FCodeSearchIndex Instance;
+	return Instance;
+}
+
+bool FCodeSearchIndex::IsPrunedDirectory(const FString& DirectoryName)
+{
+	return DirectoryName.Equals(TEXT("Intermediate"), ESearchCase::IgnoreCase)
+		|| DirectoryName.Equals(TEXT("Binaries"), ESearchCase::IgnoreCase)
+		|| DirectoryName.Equals(TEXT("Saved"), ESearchCase::IgnoreCase)
+		|| DirectoryName.Equals(TEXT("DerivedDataCache"), ESearchCase::IgnoreCase)
+		|| DirectoryName.StartsWith(TEXT("."));
+}
+
+FString FCodeSearchIndex::GetIndexFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectIntermediateDir(), TEXT("NeoStack"), TEXT("CodeSearchIndex.bin"));
+}
+
+FString FCodeSearchIndex::NormalizeDirectory(const FString& Directory)
+{
+	FString Result = FPaths::ConvertRelativePathToFull(Directory);
+	FPaths::NormalizeDirectoryName(Result);
+	if (!Result.EndsWith(TEXT("/")))
+	{
+		Result += TEXT("/");
+	}
+	return Result;
+}
+
+FString FCodeSearchIndex::ChooseRoot(const FString& Directory)
+{
+	const FString ProjectDir = NormalizeDirectory(FPaths::ProjectDir());
+	return Directory.StartsWith(ProjectDir) ? ProjectDir : Directory;
+}
+
+FString FCodeSearchIndex::ToPortablePath(const FString& Path)
+{
+	const FString ProjectDir = NormalizeDirectory(FPaths::ProjectDir());
+	return Path.StartsWith(ProjectDir) ? ProjectDirToken + Path.RightChop(ProjectDir.Len()) : Path;
+}
+
+FString FCodeSearchIndex::FromPortablePath(const FString& Path)
+{
+	return Path.StartsWith(ProjectDirToken, ESearchCase::CaseSensitive)
+		? NormalizeDirectory(FPaths::ProjectDir()) + Path.RightChop(FCString::Strlen(ProjectDirToken))
+		: Path;
+}
+
+bool FCodeSearchIndex::FindCandidates(const FString& Directory, bool bRecursive, const FString& Query, TArray<FString>& OutFiles)
+{
+	if (bShutdown || !UNeoStackSettings::Get()->bCodeSearchIndex)
+	{
+		return false;
+	}
+
+	if (!bLoadStarted)
+	{
+		StartLoad();
+	}
+
+	const FString Dir = NormalizeDirectory(Directory);
+	const FString* Root = FindRoot(Dir);
+
+	// Build output and the like is never indexed, so searches inside it always scan
+	if (HasPrunedSegment(Root ? *Root : ChooseRoot(Dir), Dir))
+	{
+		return false;
+	}
+
+	if (!Root)
+	{
+		RequestRoot(ChooseRoot(Dir));
+		return false;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_CodeSearchIndexQuery);
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<uint32> QueryTrigrams;
+	FCodeSearchEngine::GetQueryTrigrams(Query, QueryTrigrams);
+
+	auto IsInScope = [&Dir, bRecursive](const FString& Path)
+	{
+		if (!Path.StartsWith(Dir))
+		{
+			return false;
+		}
+		int32 SlashIndex = INDEX_NONE;
+		return bRecursive || !Path.RightChop(Dir.Len()).FindChar(TEXT('/'), SlashIndex);
+	};
+
+	OutFiles.Reset();
+	for (const FIndexedFile& File : Files)
+	{
+		if (!IsInScope(File.Path) || DirtyFiles.Contains(File.Path) || RefreshingFiles.Contains(File.Path))
+		{
+			continue;
+		}
+
+		if (File.Kind == FCodeSearchEngine::EFileKind::Binary)
+		{
+			continue;
+		}
+
+		if (File.Kind == FCodeSearchEngine::EFileKind::Text && File.Trigrams.IsValid())
+		{
+			const TArray<uint32>& FileTrigrams = *File.Trigrams;
+			bool bHasAll = true;
+			for (const uint32 Trigram : QueryTrigrams)
+			{
+				if (Algo::BinarySearch(FileTrigrams, Trigram) == INDEX_NONE)
+				{
+					bHasAll = false;
+					break;
+				}
+			}
+			if (!bHasAll)
+			{
+				continue;
+			}
+		}
+
+		OutFiles.Add(File.Path);
+	}
+
+	// Not re-indexed yet, so unknown content: let the scan decide
+	for (const TSet<FString>* Pending : { &DirtyFiles, &RefreshingFiles })
+	{
+		for (const FString& Path : *Pending)
+		{
+			if (IsInScope(Path))
+			{
+				OutFiles.Add(Path);
+			}
+		}
+	}
+
+	OutFiles.Sort();
+
+	UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Code search index: %d candidates of %d files in %.1f ms"),
+		OutFiles.Num(), Files.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return true;
+}
+
+const FString* FCodeSearchIndex::FindRoot(const FString& Path) const
+{
+	return Roots.FindByPredicate([&Path](const FString& Root) { return Path.StartsWith(Root); });
+}
+
+bool FCodeSearchIndex::HasPrunedSegment(const FString& Root, const FString& Path)
+{
+	if (!Path.StartsWith(Root))
+	{
+		return false;
+	}
+
+	TArray<FString> Segments;
+	Path.RightChop(Root.Len()).ParseIntoArray(Segments, TEXT("/"));
+	return Segments.ContainsByPredicate([](const FString& Segment) { return IsPrunedDirectory(Segment); });
+}
+
+void FCodeSearchIndex::StartLoad()
+{
+	bLoadStarted = true;
+
+	Async(EAsyncExecution::ThreadPool, []()
+	{
+		FLoadResult Result;
+		LoadIndexFile(Result);
+
+		AsyncTask(ENamedThreads::GameThread, [Result = MoveTemp(Result)]() mutable
+		{
+			FCodeSearchIndex::Get().FinishLoad(MoveTemp(Result));
+		});
+	});
+}
+
+void FCodeSearchIndex::FinishLoad(FLoadResult&& Result)
+{
+	bLoaded = true;
+	if (bShutdown)
+	{
+		return;
+	}
+
+	Files.Reserve(Result.Files.Num());
+	for (FIndexedFile& File : Result.Files)
+	{
+		AddOrReplace(MoveTemp(File));
+	}
+
+	// Saved roots only count once a walk has reconciled them with the disk
+	for (int32 i = Result.Roots.Num() - 1; i >= 0; --i)
+	{
+		if (!QueuedRoots.Contains(Result.Roots[i]))
+		{
+			QueuedRoots.Insert(Result.Roots[i], 0);
+		}
+	}
+
+	PumpJobs();
+}
+
+void FCodeSearchIndex::RequestRoot(const FString& Root)
+{
+	for (const FString& Queued : QueuedRoots)
+	{
+		if (Root.StartsWith(Queued))
+		{
+			return;
+		}
+	}
+
+	QueuedRoots.Add(Root);
+	PumpJobs();
+}
+
+void FCodeSearchIndex::PumpJobs()
+{
+	if (!bLoaded || bJobInFlight || bShutdown)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	if (QueuedRoots.Num() > 0)
+	{
+		const FString Root = QueuedRoots[0];
+		QueuedRoots.RemoveAt(0);
+
+		// Records share their trigram arrays, so this copy is cheap
+		TMap<FString, FIndexedFile> KnownFiles;
+		for (const FIndexedFile& File : Files)
+		{
+			if (File.Path.StartsWith(Root))
+			{
+				KnownFiles.Add(File.Path, File);
+			}
+		}
+
+		bJobInFlight = true;
+		Async(EAsyncExecution::ThreadPool, [Root, KnownFiles = MoveTemp(KnownFiles), StartTime]()
+		{
+			FJobResult Result;
+			WalkRoot(Root, KnownFiles, Result);
+
+			AsyncTask(ENamedThreads::GameThread, [Result = MoveTemp(Result), StartTime]() mutable
+			{
+				UE_LOG(LogTemp, Log, TEXT("[NeoStack] Code search index: walked %s, %d files indexed, %d removed in %.1f ms"),
+					*Result.Root, Result.Updated.Num(), Result.Removed.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+				FCodeSearchIndex::Get().FinishJob(MoveTemp(Result));
+			});
+		});
+		return;
+	}
+
+	if (DirtyFiles.Num() > 0)
+	{
+		RefreshingFiles = MoveTemp(DirtyFiles);
+		DirtyFiles.Reset();
+
+		bJobInFlight = true;
+		Async(EAsyncExecution::ThreadPool, [Paths = RefreshingFiles.Array()]()
+		{
+			FJobResult Result;
+			RefreshFiles(Paths, Result);
+
+			AsyncTask(ENamedThreads::GameThread, [Result = MoveTemp(Result)]() mutable
+			{
+				FCodeSearchIndex::Get().FinishJob(MoveTemp(Result));
+			});
+		});
+	}
+}
+
+void FCodeSearchIndex::FinishJob(FJobResult&& Result)
+{
+	bJobInFlight = false;
+	if (bShutdown)
+	{
+		return;
+	}
+
+	for (const FString& Path : Result.Removed)
+	{
+		Remove(Path);
+	}
+	for (FIndexedFile& File : Result.Updated)
+	{
+		AddOrReplace(MoveTemp(File));
+	}
+
+	if (Result.Root.IsEmpty())
+	{
+		RefreshingFiles.Reset();
+	}
+	else
+	{
+		// A wider root replaces the roots it contains
+		for (int32 i = Roots.Num() - 1; i >= 0; --i)
+		{
+			if (Roots[i].StartsWith(Result.Root))
+			{
+				UnwatchRoot(Roots[i]);
+				Roots.RemoveAt(i);
+			}
+		}
+		Roots.Add(Result.Root);
+		WatchRoot(Result.Root);
+	}
+
+	if (Result.Updated.Num() > 0 || Result.Removed.Num() > 0 || !Result.Root.IsEmpty())
+	{
+		ScheduleSave();
+	}
+
+	PumpJobs();
+}
+
+void FCodeSearchIndex::AddOrReplace(FIndexedFile&& File)
+{
+	if (const int32* Existing = FileByPath.Find(File.Path))
+	{
+		Files[*Existing] = MoveTemp(File);
+		return;
+	}
+
+	const int32 Index = Files.Num();
+	FileByPath.Add(File.Path, Index);
+	Files.Add(MoveTemp(File));
+}
+
+void FCodeSearchIndex::Remove(const FString& Path)
+{
+	int32 Index = INDEX_NONE;
+	if (!FileByPath.RemoveAndCopyValue(Path, Index))
+	{
+		return;
+	}
+
+	const int32 LastIndex = Files.Num() - 1;
+	if (Index != LastIndex)
+	{
+		FileByPath.Add(Files[LastIndex].Path, Index);
+	}
+	Files.RemoveAtSwap(Index);
+}
+
+FCodeSearchIndex::FIndexedFile FCodeSearchIndex::IndexFile(const FString& Path, int64 Timestamp, int64 Size)
+{
+	FIndexedFile File;
+	File.Path = Path;
+	File.Timestamp = Timestamp;
+	File.Size = Size;
+
+	TArray<uint32> Trigrams;
+	File.Kind = FCodeSearchEngine::ReadFileTrigrams(Path, Trigrams, &File.ContentHash);
+	File.Trigrams = MakeShared<TArray<uint32>, ESPMode::ThreadSafe>(MoveTemp(Trigrams));
+	return File;
+}
+
+void FCodeSearchIndex::WalkRoot(const FString& Root, const TMap<FString, FIndexedFile>& KnownFiles, FJobResult& OutResult)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_CodeSearchIndexWalk);
+
+	OutResult.Root = Root;
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	struct FToIndex
+	{
+		FString Path;
+		int64 Timestamp;
+		int64 Size;
+
+		/** Record with another stamp, reused if the contents turn out to be the same */
+		const FIndexedFile* Previous;
+	};
+	TArray<FToIndex> ToIndex;
+	TSet<FString> Seen;
+
+	TArray<FString> Pending;
+	Pending.Add(Root.LeftChop(1));
+	while (Pending.Num() > 0)
+	{
+		const FString Directory = Pending.Pop(EAllowShrinking::No);
+		PlatformFile.IterateDirectoryStat(*Directory, [&](const TCHAR* Name, const FFileStatData& Stat) -> bool
+		{
+			FString Path = Name;
+			FPaths::NormalizeFilename(Path);
+			FPaths::RemoveDuplicateSlashes(Path);
+
+			if (Stat.bIsDirectory)
+			{
+				if (!IsPrunedDirectory(FPaths::GetCleanFilename(Path)))
+				{
+					Pending.Add(Path);
+				}
+				return true;
+			}
+
+			if (!FCodeSearchEngine::IsSearchableExtension(FPaths::GetExtension(Path).ToLower()))
+			{
+				return true;
+			}
+
+			const int64 Timestamp = Stat.ModificationTime.GetTicks();
+			const FIndexedFile* Known = KnownFiles.Find(Path);
+			if (!Known || Known->Timestamp != Timestamp || Known->Size != Stat.FileSize)
+			{
+				ToIndex.Add({ Path, Timestamp, Stat.FileSize, Known });
+			}
+			Seen.Add(MoveTemp(Path));
+			return true;
+		});
+	}
+
+	OutResult.Updated.SetNum(ToIndex.Num());
+	ParallelFor(ToIndex.Num(), [&](int32 Index)
+	{
+		const FToIndex& Item = ToIndex[Index];
+
+		// A fresh checkout or a pulled index: every stamp differs, most contents don't
+		uint64 ContentHash = 0;
+		if (Item.Previous && Item.Previous->ContentHash != 0 && Item.Previous->Size == Item.Size
+			&& FCodeSearchEngine::HashFile(Item.Path, ContentHash) && ContentHash == Item.Previous->ContentHash)
+		{
+			FIndexedFile& File = OutResult.Updated[Index];
+			File = *Item.Previous;
+			File.Timestamp = Item.Timestamp;
+			return;
+		}
+
+		OutResult.Updated[Index] = IndexFile(Item.Path, Item.Timestamp, Item.Size);
+	});
+
+	for (const TPair<FString, FIndexedFile>& Known : KnownFiles)
+	{
+		if (!Seen.Contains(Known.Key))
+		{
+			OutResult.Removed.Add(Known.Key);
+		}
+	}
+}
+
+void FCodeSearchIndex::RefreshFiles(const TArray<FString>& Paths, FJobResult& OutResult)
+{
+	for (const FString& Path : Paths)
+	{
+		const FFileStatData Stat = IFileManager::Get().GetStatData(*Path);
+		if (!Stat.bIsValid || Stat.bIsDirectory)
+		{
+			OutResult.Removed.Add(Path);
+			continue;
+		}
+		OutResult.Updated.Add(IndexFile(Path, Stat.ModificationTime.GetTicks(), Stat.FileSize));
+	}
+}
+
+bool FCodeSearchIndex::LoadIndexFile(FLoadResult& OutResult)
+{
+	TArray<uint8> Buffer;
+	if (!FFileHelper::LoadFileToArray(Buffer, *GetIndexFilePath(), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Buffer);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+	if (Magic != IndexMagic || Version != IndexVersion)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Code search index file is from another version, rebuilding"));
+		return false;
+	}
+
+	Reader << OutResult.Roots;
+	for (FString& Root : OutResult.Roots)
+	{
+		Root = FromPortablePath(Root);
+	}
+
+	int32 FileCount = 0;
+	Reader << FileCount;
+	if (Reader.IsError() || FileCount < 0)
+	{
+		OutResult = FLoadResult();
+		return false;
+	}
+
+	OutResult.Files.Reserve(FileCount);
+	for (int32 i = 0; i < FileCount && !Reader.IsError(); ++i)
+	{
+		FIndexedFile& File = OutResult.Files.AddDefaulted_GetRef();
+		uint8 Kind = 0;
+		int32 TrigramCount = 0;
+		Reader << File.Path;
+		Reader << File.Timestamp;
+		Reader << File.Size;
+		Reader << File.ContentHash;
+		Reader << Kind;
+		Reader << TrigramCount;
+		if (TrigramCount < 0 || (int64)TrigramCount * sizeof(uint32) > Reader.TotalSize() - Reader.Tell())
+		{
+			Reader.SetError();
+			break;
+		}
+
+		TArray<uint32> Trigrams;
+		Trigrams.SetNumUninitialized(TrigramCount);
+		Reader.Serialize(Trigrams.GetData(), TrigramCount * sizeof(uint32));
+
+		File.Path = FromPortablePath(File.Path);
+		File.Kind = (FCodeSearchEngine::EFileKind)Kind;
+		File.Trigrams = MakeShared<TArray<uint32>, ESPMode::ThreadSafe>(MoveTemp(Trigrams));
+	}
+
+	if (Reader.IsError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Code search index file is corrupt, rebuilding"));
+		OutResult = FLoadResult();
+		return false;
+	}
+	return true;
+}
+
+void FCodeSearchIndex::SaveIndexFile(const TArray<FString>& Roots, const TArray<FIndexedFile>& Files)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_CodeSearchIndexSave);
+
+	TArray<uint8> Buffer;
+	FMemoryWriter Writer(Buffer);
+
+	uint32 Magic = IndexMagic;
+	int32 Version = IndexVersion;
+	TArray<FString> RootsCopy;
+	RootsCopy.Reserve(Roots.Num());
+	for (const FString& Root : Roots)
+	{
+		RootsCopy.Add(ToPortablePath(Root));
+	}
+	int32 FileCount = Files.Num();
+	Writer << Magic;
+	Writer << Version;
+	Writer << RootsCopy;
+	Writer << FileCount;
+
+	for (const FIndexedFile& File : Files)
+	{
+		FString Path = ToPortablePath(File.Path);
+		int64 Timestamp = File.Timestamp;
+		int64 Size = File.Size;
+		uint64 ContentHash = File.ContentHash;
+		uint8 Kind = (uint8)File.Kind;
+		int32 TrigramCount = File.Trigrams.IsValid() ? File.Trigrams->Num() : 0;
+		Writer << Path;
+		Writer << Timestamp;
+		Writer << Size;
+		Writer << ContentHash;
+		Writer << Kind;
+		Writer << TrigramCount;
+		if (TrigramCount > 0)
+		{
+			Writer.Serialize(const_cast<uint32*>(File.Trigrams->GetData()), TrigramCount * sizeof(uint32));
+		}
+	}
+
+	// Write then move so a crash mid-write never leaves a truncated index behind
+	const FString IndexPath = GetIndexFilePath();
+	const FString TempPath = IndexPath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Buffer, *TempPath)
+		|| !IFileManager::Get().Move(*IndexPath, *TempPath, true, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Failed to write code search index %s"), *IndexPath);
+	}
+}
+
+void FCodeSearchIndex::ScheduleSave()
+{
+	if (SaveHandle.IsValid())
+	{
+		return;
+	}
+
+	SaveHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FCodeSearchIndex::HandleSaveTick), SaveDelaySeconds);
+}
+
+bool FCodeSearchIndex::HandleSaveTick(float DeltaTime)
+{
+	SaveHandle.Reset();
+
+	// Records share their trigram arrays, so this snapshot is cheap
+	Async(EAsyncExecution::ThreadPool, [RootsSnapshot = Roots, FilesSnapshot = Files]()
+	{
+		SaveIndexFile(RootsSnapshot, FilesSnapshot);
+	});
+	return false;
+}
+
+void FCodeSearchIndex::WatchRoot(const FString& Root)
+{
+	FDirectoryWatcherModule& WatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+	IDirectoryWatcher* Watcher = WatcherModule.Get();
+	if (!Watcher)
+	{
+		return;
+	}
+
+	FDelegateHandle Handle;
+	if (Watcher->RegisterDirectoryChangedCallback_Handle(
+		Root,
+		IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FCodeSearchIndex::HandleFilesChanged),
+		Handle))
+	{
+		WatchHandles.Emplace(Root, Handle);
+	}
+}
+
+void FCodeSearchIndex::UnwatchRoot(const FString& Root)
+{
+	const int32 Index = WatchHandles.IndexOfByPredicate([&Root](const TPair<FString, FDelegateHandle>& Watch) { return Watch.Key == Root; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (FDirectoryWatcherModule* WatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* Watcher = WatcherModule->Get())
+		{
+			Watcher->UnregisterDirectoryChangedCallback_Handle(WatchHandles[Index].Key, WatchHandles[Index].Value);
+		}
+	}
+	WatchHandles.RemoveAtSwap(Index);
+}
+
+void FCodeSearchIndex::HandleFilesChanged(const TArray<FFileChangeData>& Changes)
+{
+	bool bDirtied = false;
+
+	for (const FFileChangeData& Change : Changes)
+	{
+		FString Path = FPaths::ConvertRelativePathToFull(Change.Filename);
+		FPaths::NormalizeFilename(Path);
+
+		const FString* Root = FindRoot(Path);
+		if (!Root)
+		{
+			continue;
+		}
+
+		if (Change.Action == FFileChangeData::FCA_RescanRequired)
+		{
+			RequestRoot(*Root);
+			continue;
+		}
+
+		if (!FCodeSearchEngine::IsSearchableExtension(FPaths::GetExtension(Path).ToLower()))
+		{
+			continue;
+		}
+
+		// Same pruning as the walk, applied to the directories between the root and the file
+		if (HasPrunedSegment(*Root, FPaths::GetPath(Path) + TEXT("/")))
+		{
+			continue;
+		}
+
+		DirtyFiles.Add(MoveTemp(Path));
+		bDirtied = true;
+	}
+
+	if (bDirtied)
+	{
+		PumpJobs();
+	}
+}
+
+void FCodeSearchIndex::Prebuild(const FString& Directory)
+{
+	if (bShutdown)
+	{
+		return;
+	}
+
+	if (!bLoadStarted)
+	{
+		StartLoad();
+	}
+
+	const FString Dir = NormalizeDirectory(Directory);
+	RequestRoot(ChooseRoot(Dir));
+
+	// Loads and jobs finish through game thread tasks, which nothing else pumps in a commandlet
+	while (!bLoaded || bJobInFlight || QueuedRoots.Num() > 0)
+	{
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FPlatformProcess::Sleep(0.01f);
+	}
+}
+
+void FCodeSearchIndex::Shutdown()
+{
+	bShutdown = true;
+
+	// Flush a pending save so the next session starts from this one's index
+	if (SaveHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(SaveHandle);
+		SaveHandle.Reset();
+		SaveIndexFile(Roots, Files);
+	}
+
+	while (WatchHandles.Num() > 0)
+	{
+		UnwatchRoot(WatchHandles.Last().Key);
+	}
+}
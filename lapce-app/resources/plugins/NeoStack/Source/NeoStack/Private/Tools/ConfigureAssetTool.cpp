@@ -2,6 +2,10 @@
 
 #include "Tools/ConfigureAssetTool.h"
 #include "Tools/NeoStackToolUtils.h"
+#include "Tools/AssetReadCache.h"
+#include "Tools/PropertyPathCache.h"
+#include "Tools/BlueprintCompileScheduler.h"
+#include "Tools/TurnCheckpoint.h"
 #include "Json.h"
 #include "UObject/UnrealType.h"
 #include "UObject/PropertyIterator.h"
@@ -10,6 +14,8 @@
 #include "Materials/Material.h"
 #include "Materials/MaterialFunction.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "ScopedTransaction.h"
 
 // For accessing Material Editor preview material
 #include "Editor.h"
@@ -34,42 +40,248 @@
 #include "Engine/SCS_Node.h"
 #include "Components/ActorComponent.h"
 
+namespace
+{
+	bool HasWildcard(const FString& Name)
+	{
+		return Name.Contains(TEXT("*")) || Name.Contains(TEXT("?"));
+	}
+}
+
+void FConfigureAssetTool::GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const
+{
+	// Wildcards can match anything, so report nothing and run after everything before
+	FString Name, Path;
+	Args->TryGetStringField(TEXT("name"), Name);
+	Args->TryGetStringField(TEXT("path"), Path);
+
+	TArray<FString> Names;
+	if (!Args->TryGetStringArrayField(TEXT("assets"), Names) || Names.Num() == 0)
+	{
+		if (HasWildcard(Name))
+		{
+			return;
+		}
+		NeoStackToolUtils::AddNamePathResource(Args, OutKeys);
+		return;
+	}
+
+	TArray<FString> Keys;
+	for (const FString& AssetName : Names)
+	{
+		if (HasWildcard(AssetName))
+		{
+			return;
+		}
+		Keys.Add(NeoStackToolUtils::GetResourceKey(AssetName, Path));
+	}
+	OutKeys.Append(Keys);
+}
+
 FToolResult FConfigureAssetTool::Execute(const TSharedPtr<FJsonObject>& Args)
 {
-	FString Name, Path, SubobjectName;
+	TArray<FString> AssetPaths;
+	bool bMulti = false;
+	FString TargetError;
+	if (!ResolveTargets(Args, AssetPaths, bMulti, TargetError))
+	{
+		return FToolResult::Fail(TargetError);
+	}
+
+	// Parse parameters
+	FConfigureRequest Request;
+	Args->TryGetStringField(TEXT("subobject"), Request.SubobjectName);
+	Args->TryGetBoolField(TEXT("list_properties"), Request.bListProperties);
+
+	const TArray<TSharedPtr<FJsonValue>>* GetArray;
+	if (Args->TryGetArrayField(TEXT("get"), GetArray))
+	{
+		for (const auto& Val : *GetArray)
+		{
+			FString PropName;
+			if (Val->TryGetString(PropName))
+			{
+				Request.GetProperties.Add(PropName);
+			}
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* ChangesArray;
+	if (Args->TryGetArrayField(TEXT("changes"), ChangesArray))
+	{
+		FString ParseError;
+		if (!ParseChanges(*ChangesArray, Request.Changes, ParseError))
+		{
+			return FToolResult::Fail(ParseError);
+		}
+	}
+
+	// Parse slot configuration (for widgets in panels)
+	const TSharedPtr<FJsonObject>* SlotConfig = nullptr;
+	if (Args->TryGetObjectField(TEXT("slot"), SlotConfig) && SlotConfig)
+	{
+		Request.SlotConfig = *SlotConfig;
+	}
+
+	// If nothing was requested, show help
+	if (Request.GetProperties.Num() == 0 && !Request.bListProperties && Request.Changes.Num() == 0 && !Request.SlotConfig.IsValid())
+	{
+		return FToolResult::Fail(TEXT("No operation specified. Use 'get', 'list_properties', 'changes', or 'slot'."));
+	}
 
-	if (!Args->TryGetStringField(TEXT("name"), Name) || Name.IsEmpty())
+	// One transaction for every asset, so a fan-out is undone in a single step (the turn checkpoint covers it when on)
+	TOptional<FScopedTransaction> Transaction;
+	if ((Request.Changes.Num() > 0 || Request.SlotConfig.IsValid()) && !FTurnCheckpoint::Get().IsCapturing())
 	{
-		return FToolResult::Fail(TEXT("Missing required parameter: name"));
+		Transaction.Emplace(FText::Format(NSLOCTEXT("NeoStack", "ConfigureAssets", "Configure {0} Asset(s)"), AssetPaths.Num()));
+	}
+
+	if (!bMulti)
+	{
+		FString Output;
+		if (!ConfigureAsset(AssetPaths[0], Request, Output))
+		{
+			return FToolResult::Fail(Output);
+		}
+		return FToolResult::Ok(Output);
 	}
 
+	FString Output = FString::Printf(TEXT("# CONFIGURE %d assets\n"), AssetPaths.Num());
+	int32 SucceededCount = 0;
+	for (const FString& AssetPath : AssetPaths)
+	{
+		FString AssetOutput;
+		if (ConfigureAsset(AssetPath, Request, AssetOutput))
+		{
+			Output += TEXT("\n") + AssetOutput;
+			SucceededCount++;
+		}
+		else
+		{
+			Output += FString::Printf(TEXT("\n! %s: %s\n"), *AssetPath, *AssetOutput);
+		}
+	}
+	Output += FString::Printf(TEXT("\n= %d assets configured, %d failed\n"), SucceededCount, AssetPaths.Num() - SucceededCount);
+
+	if (SucceededCount == 0)
+	{
+		return FToolResult::Fail(Output);
+	}
+	return FToolResult::Ok(Output);
+}
+
+bool FConfigureAssetTool::ResolveTargets(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutAssetPaths, bool& bOutMulti, FString& OutError) const
+{
+	FString Name, Path;
+	Args->TryGetStringField(TEXT("name"), Name);
 	Args->TryGetStringField(TEXT("path"), Path);
-	Args->TryGetStringField(TEXT("subobject"), SubobjectName);
 
+	TArray<FString> Names;
+	bOutMulti = Args->TryGetStringArrayField(TEXT("assets"), Names) && Names.Num() > 0;
+	if (!bOutMulti)
+	{
+		if (Name.IsEmpty())
+		{
+			OutError = TEXT("Missing required parameter: name (or assets)");
+			return false;
+		}
+		Names.Add(Name);
+	}
+
+	for (const FString& AssetName : Names)
+	{
+		if (HasWildcard(AssetName))
+		{
+			bOutMulti = true;
+			ExpandAssetPattern(AssetName, Path, OutAssetPaths);
+		}
+		else
+		{
+			OutAssetPaths.AddUnique(NeoStackToolUtils::BuildAssetPath(AssetName, Path));
+		}
+	}
+
+	if (OutAssetPaths.Num() == 0)
+	{
+		OutError = FString::Printf(TEXT("No assets match %s"), *FString::Join(Names, TEXT(", ")));
+		return false;
+	}
+	if (OutAssetPaths.Num() > MaxAssetsPerCall)
+	{
+		OutError = FString::Printf(TEXT("%d assets match, more than the %d one call may configure. Narrow the pattern."),
+			OutAssetPaths.Num(), MaxAssetsPerCall);
+		return false;
+	}
+	return true;
+}
+
+void FConfigureAssetTool::ExpandAssetPattern(const FString& Name, const FString& Path, TArray<FString>& OutAssetPaths)
+{
+	// Package path pattern: a full "/Game/..." name, or a name under Path
+	FString Pattern = Name.StartsWith(TEXT("/")) ? Name : (Path.IsEmpty() ? FString(TEXT("/Game")) : Path) / Name;
+	Pattern.RemoveFromEnd(TEXT(".uasset"));
+
+	int32 WildcardIndex = Pattern.Len();
+	for (int32 i = 0; i < Pattern.Len(); i++)
+	{
+		if (Pattern[i] == TEXT('*') || Pattern[i] == TEXT('?'))
+		{
+			WildcardIndex = i;
+			break;
+		}
+	}
+
+	// Search from the deepest folder before the first wildcard
+	FString Root = Pattern.Left(WildcardIndex);
+	int32 SlashIndex = INDEX_NONE;
+	Root.FindLastChar(TEXT('/'), SlashIndex);
+	Root.LeftInline(FMath::Max(SlashIndex, 1));
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByPath(FName(*Root), Assets, /*bRecursive*/ true);
+
+	TArray<FString> Matches;
+	for (const FAssetData& Asset : Assets)
+	{
+		if (!Asset.IsRedirector() && Asset.PackageName.ToString().MatchesWildcard(Pattern))
+		{
+			Matches.Add(Asset.GetObjectPathString());
+		}
+	}
+	Matches.Sort();
+
+	for (const FString& Match : Matches)
+	{
+		OutAssetPaths.AddUnique(Match);
+	}
+}
+
+bool FConfigureAssetTool::ConfigureAsset(const FString& FullAssetPath, const FConfigureRequest& Request, FString& OutOutput)
+{
 	// Load asset
-	FString FullAssetPath = NeoStackToolUtils::BuildAssetPath(Name, Path);
 	UObject* Asset = LoadObject<UObject>(nullptr, *FullAssetPath);
 
 	if (!Asset)
 	{
-		return FToolResult::Fail(FString::Printf(TEXT("Asset not found: %s"), *FullAssetPath));
+		OutOutput = FString::Printf(TEXT("Asset not found: %s"), *FullAssetPath);
+		return false;
 	}
 
 	// Track the original asset for editor refresh
 	UObject* OriginalAsset = Asset;
 	UObject* WorkingAsset = Asset;
-	FString SubobjectContext;
 
 	// If subobject is specified, find it within the asset
-	if (!SubobjectName.IsEmpty())
+	if (!Request.SubobjectName.IsEmpty())
 	{
-		UObject* Subobject = FindSubobject(Asset, SubobjectName);
+		UObject* Subobject = FindSubobject(Asset, Request.SubobjectName);
 		if (!Subobject)
 		{
-			return FToolResult::Fail(FString::Printf(TEXT("Subobject '%s' not found in %s"), *SubobjectName, *Name));
+			OutOutput = FString::Printf(TEXT("Subobject '%s' not found in %s"), *Request.SubobjectName, *Asset->GetName());
+			return false;
 		}
 		WorkingAsset = Subobject;
-		SubobjectContext = FString::Printf(TEXT(" (subobject: %s)"), *SubobjectName);
 	}
 
 	// CRITICAL: When the Material Editor is open, it works on a PREVIEW COPY of the material.
@@ -102,39 +314,6 @@ FToolResult FConfigureAssetTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		}
 	}
 
-	// Parse parameters
-	bool bListProperties = false;
-	Args->TryGetBoolField(TEXT("list_properties"), bListProperties);
-
-	TArray<FString> GetProperties;
-	const TArray<TSharedPtr<FJsonValue>>* GetArray;
-	if (Args->TryGetArrayField(TEXT("get"), GetArray))
-	{
-		for (const auto& Val : *GetArray)
-		{
-			FString PropName;
-			if (Val->TryGetString(PropName))
-			{
-				GetProperties.Add(PropName);
-			}
-		}
-	}
-
-	TArray<FPropertyChange> Changes;
-	const TArray<TSharedPtr<FJsonValue>>* ChangesArray;
-	if (Args->TryGetArrayField(TEXT("changes"), ChangesArray))
-	{
-		FString ParseError;
-		if (!ParseChanges(*ChangesArray, Changes, ParseError))
-		{
-			return FToolResult::Fail(ParseError);
-		}
-	}
-
-	// Parse slot configuration (for widgets in panels)
-	const TSharedPtr<FJsonObject>* SlotConfig = nullptr;
-	Args->TryGetObjectField(TEXT("slot"), SlotConfig);
-
 	// Execute operations
 	TArray<TPair<FString, FString>> GetResults;
 	TArray<FString> GetErrors;
@@ -143,51 +322,51 @@ FToolResult FConfigureAssetTool::Execute(const TSharedPtr<FJsonObject>& Args)
 	FString SlotResult;
 
 	// Get specific property values
-	if (GetProperties.Num() > 0)
+	if (Request.GetProperties.Num() > 0)
 	{
-		GetResults = GetPropertyValues(WorkingAsset, GetProperties, GetErrors);
+		GetResults = GetPropertyValues(WorkingAsset, Request.GetProperties, GetErrors);
 	}
 
 	// List all editable properties
-	if (bListProperties)
+	if (Request.bListProperties)
 	{
 		ListedProperties = ListEditableProperties(WorkingAsset);
 	}
 
 	// Apply changes
-	if (Changes.Num() > 0)
+	if (Request.Changes.Num() > 0)
 	{
-		ChangeResults = ApplyChanges(WorkingAsset, Asset, Changes);
+		ChangeResults = ApplyChanges(WorkingAsset, Asset, Request.Changes);
 	}
 
 	// Configure slot (for widgets)
-	if (SlotConfig && *SlotConfig)
+	if (Request.SlotConfig.IsValid())
 	{
 		UWidget* Widget = Cast<UWidget>(WorkingAsset);
 		if (!Widget)
 		{
-			return FToolResult::Fail(TEXT("'slot' parameter only valid for widgets. Use 'subobject' to target a widget first."));
+			OutOutput = TEXT("'slot' parameter only valid for widgets. Use 'subobject' to target a widget first.");
+			return false;
 		}
-		SlotResult = ConfigureSlot(Widget, *SlotConfig, OriginalAsset);
+		SlotResult = ConfigureSlot(Widget, Request.SlotConfig, OriginalAsset);
 	}
 
-	// If nothing was requested, show help
-	if (GetProperties.Num() == 0 && !bListProperties && Changes.Num() == 0 && !SlotConfig)
+	if (Request.Changes.Num() > 0 || Request.SlotConfig.IsValid())
 	{
-		return FToolResult::Fail(TEXT("No operation specified. Use 'get', 'list_properties', 'changes', or 'slot'."));
+		FAssetReadCache::Get().Invalidate(OriginalAsset);
 	}
 
 	// Format and return results
-	FString Output = FormatResults(WorkingAsset->GetName(), GetAssetTypeName(WorkingAsset),
-	                                GetResults, GetErrors, ListedProperties, ChangeResults);
+	OutOutput = FormatResults(WorkingAsset->GetName(), GetAssetTypeName(WorkingAsset),
+	                          GetResults, GetErrors, ListedProperties, ChangeResults);
 
 	// Append slot configuration result
 	if (!SlotResult.IsEmpty())
 	{
-		Output += TEXT("\n") + SlotResult;
+		OutOutput += TEXT("\n") + SlotResult;
 	}
 
-	return FToolResult::Ok(Output);
+	return true;
 }
 
 bool FConfigureAssetTool::ParseChanges(const TArray<TSharedPtr<FJsonValue>>& ChangesArray,
@@ -253,15 +432,23 @@ TArray<TPair<FString, FString>> FConfigureAssetTool::GetPropertyValues(UObject*
 
 	for (const FString& PropName : PropertyNames)
 	{
-		FProperty* Property = FindProperty(Asset, PropName);
-		if (!Property)
+		FResolvedPropertyPath PropertyPath;
+		FString Error;
+		if (!FindProperty(Asset, PropName, PropertyPath, Error))
+		{
+			OutErrors.Add(FString::Printf(TEXT("%s - %s"), *PropName, *Error));
+			continue;
+		}
+
+		const void* ValuePtr = PropertyPath.GetValuePtr(Asset);
+		if (!ValuePtr)
 		{
-			OutErrors.Add(FString::Printf(TEXT("%s - Property not found"), *PropName));
+			OutErrors.Add(FString::Printf(TEXT("%s - Array index out of range"), *PropName));
 			continue;
 		}
 
-		FString Value = GetPropertyValue(Asset, Property);
-		Results.Add(TPair<FString, FString>(Property->GetName(), Value));
+		FString Value = GetPropertyValue(Asset, PropertyPath.GetLeafProperty(), ValuePtr);
+		Results.Add(TPair<FString, FString>(PropertyPath.DisplayPath, Value));
 	}
 
 	return Results;
@@ -273,26 +460,13 @@ TArray<FConfigureAssetTool::FPropertyInfo> FConfigureAssetTool::ListEditableProp
 
 	if (!Asset) return Properties;
 
-	for (TFieldIterator<FProperty> PropIt(Asset->GetClass()); PropIt; ++PropIt)
+	// Only editable (visible in editor), non-deprecated properties; the list is cached per class
+	for (FProperty* Property : FPropertyPathCache::Get().GetEditableProperties(Asset->GetClass()))
 	{
-		FProperty* Property = *PropIt;
-
-		// Only show editable properties (visible in editor)
-		if (!Property->HasAnyPropertyFlags(CPF_Edit))
-		{
-			continue;
-		}
-
-		// Skip deprecated properties
-		if (Property->HasAnyPropertyFlags(CPF_Deprecated))
-		{
-			continue;
-		}
-
 		FPropertyInfo Info;
 		Info.Name = Property->GetName();
 		Info.Type = GetPropertyTypeName(Property);
-		Info.CurrentValue = GetPropertyValue(Asset, Property);
+		Info.CurrentValue = GetPropertyValue(Asset, Property, Property->ContainerPtrToValuePtr<void>(Asset));
 
 		// Get category from metadata
 		Info.Category = Property->GetMetaData(TEXT("Category"));
@@ -326,32 +500,39 @@ TArray<FConfigureAssetTool::FChangeResult> FConfigureAssetTool::ApplyChanges(UOb
 	// Mark object for transaction (undo/redo support)
 	WorkingAsset->Modify();
 
-	// Track which properties changed for Materials
-	TArray<FProperty*> ChangedProperties;
-
 	for (const FPropertyChange& Change : Changes)
 	{
 		FChangeResult Result;
 		Result.PropertyName = Change.PropertyName;
 		Result.bSuccess = false;
 
-		FProperty* Property = FindProperty(WorkingAsset, Change.PropertyName);
-		if (!Property)
+		FResolvedPropertyPath PropertyPath;
+		if (!FindProperty(WorkingAsset, Change.PropertyName, PropertyPath, Result.Error))
 		{
-			Result.Error = TEXT("Property not found");
 			Results.Add(Result);
 			continue;
 		}
 
+		void* ValuePtr = PropertyPath.GetValuePtr(WorkingAsset);
+		if (!ValuePtr)
+		{
+			Result.Error = TEXT("Array index out of range");
+			Results.Add(Result);
+			continue;
+		}
+
+		FProperty* Property = PropertyPath.GetLeafProperty();
+		FProperty* MemberProperty = PropertyPath.GetMemberProperty();
+
 		// Get old value
-		Result.OldValue = GetPropertyValue(WorkingAsset, Property);
+		Result.OldValue = GetPropertyValue(WorkingAsset, Property, ValuePtr);
 
-		// Notify pre-change with the actual property (critical for Materials!)
-		WorkingAsset->PreEditChange(Property);
+		// Notify pre-change with the actual member property (critical for Materials!)
+		WorkingAsset->PreEditChange(MemberProperty);
 
 		// Set new value
 		FString SetError;
-		if (!SetPropertyValue(WorkingAsset, Property, Change.Value, SetError))
+		if (!SetPropertyValue(WorkingAsset, Property, ValuePtr, Change.Value, SetError))
 		{
 			Result.Error = SetError;
 			Results.Add(Result);
@@ -363,13 +544,11 @@ TArray<FConfigureAssetTool::FChangeResult> FConfigureAssetTool::ApplyChanges(UOb
 
 		// Create proper PropertyChangedEvent and notify post-change
 		FPropertyChangedEvent PropertyEvent(Property, EPropertyChangeType::ValueSet);
+		PropertyEvent.SetActiveMemberProperty(MemberProperty);
 		WorkingAsset->PostEditChangeProperty(PropertyEvent);
 
-		// Track for Materials
-		ChangedProperties.Add(Property);
-
 		// Get new value for confirmation
-		Result.NewValue = GetPropertyValue(WorkingAsset, Property);
+		Result.NewValue = GetPropertyValue(WorkingAsset, Property, ValuePtr);
 		Result.bSuccess = true;
 
 		Results.Add(Result);
@@ -403,7 +582,7 @@ TArray<FConfigureAssetTool::FChangeResult> FConfigureAssetTool::ApplyChanges(UOb
 	else if (UBlueprint* Blueprint = Cast<UBlueprint>(WorkingAsset))
 	{
 		// Recompile blueprint when directly editing it
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		FBlueprintCompileScheduler::Get().MarkStructurallyModified(Blueprint);
 	}
 	else if (Cast<UWidget>(WorkingAsset) || Cast<UActorComponent>(WorkingAsset))
 	{
@@ -414,76 +593,68 @@ TArray<FConfigureAssetTool::FChangeResult> FConfigureAssetTool::ApplyChanges(UOb
 	return Results;
 }
 
-FProperty* FConfigureAssetTool::FindProperty(UObject* Asset, const FString& PropertyName)
+bool FConfigureAssetTool::FindProperty(UObject* Asset, const FString& PropertyPath, FResolvedPropertyPath& OutPath, FString& OutError)
 {
-	if (!Asset) return nullptr;
-
-	// Case-insensitive search
-	for (TFieldIterator<FProperty> PropIt(Asset->GetClass()); PropIt; ++PropIt)
+	if (!Asset)
 	{
-		if (PropIt->GetName().Equals(PropertyName, ESearchCase::IgnoreCase))
-		{
-			return *PropIt;
-		}
+		OutError = TEXT("Invalid asset");
+		return false;
 	}
 
-	return nullptr;
+	// Case-insensitive, resolved once per class and path
+	return FPropertyPathCache::Get().Resolve(Asset->GetClass(), PropertyPath, OutPath, OutError);
 }
 
-FString FConfigureAssetTool::GetPropertyValue(UObject* Asset, FProperty* Property)
+FString FConfigureAssetTool::GetPropertyValue(UObject* Owner, const FProperty* Property, const void* ValuePtr)
 {
-	if (!Asset || !Property) return TEXT("");
-
-	const void* ContainerPtr = Asset;
+	if (!Property || !ValuePtr) return TEXT("");
 
 	// Handle bool properties explicitly
-	if (FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
+	if (const FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
 	{
-		bool bValue = BoolProp->GetPropertyValue_InContainer(ContainerPtr);
+		bool bValue = BoolProp->GetPropertyValue(ValuePtr);
 		return bValue ? TEXT("True") : TEXT("False");
 	}
 
 	// Handle enum properties explicitly
-	if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+	if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
 	{
 		if (UEnum* Enum = EnumProp->GetEnum())
 		{
 			FNumericProperty* UnderlyingProp = EnumProp->GetUnderlyingProperty();
-			int64 EnumValue = UnderlyingProp->GetSignedIntPropertyValue(EnumProp->ContainerPtrToValuePtr<void>(ContainerPtr));
+			int64 EnumValue = UnderlyingProp->GetSignedIntPropertyValue(ValuePtr);
 			return Enum->GetNameStringByValue(EnumValue);
 		}
 	}
 
 	// Handle byte enums
-	if (FByteProperty* ByteProp = CastField<FByteProperty>(Property))
+	if (const FByteProperty* ByteProp = CastField<FByteProperty>(Property))
 	{
 		if (UEnum* Enum = ByteProp->GetIntPropertyEnum())
 		{
-			uint8 ByteValue = ByteProp->GetPropertyValue_InContainer(ContainerPtr);
+			uint8 ByteValue = ByteProp->GetPropertyValue(ValuePtr);
 			return Enum->GetNameStringByValue(ByteValue);
 		}
 	}
 
 	// Standard export for other types
 	FString Value;
-	Property->ExportText_InContainer(0, Value, ContainerPtr, nullptr, Asset, PPF_None);
+	Property->ExportTextItem_Direct(Value, ValuePtr, nullptr, Owner, PPF_None);
 
 	return Value;
 }
 
-bool FConfigureAssetTool::SetPropertyValue(UObject* Asset, FProperty* Property,
+bool FConfigureAssetTool::SetPropertyValue(UObject* Owner, FProperty* Property, void* ValuePtr,
                                             const FString& Value, FString& OutError)
 {
-	if (!Asset || !Property)
+	if (!Owner || !Property || !ValuePtr)
 	{
 		OutError = TEXT("Invalid asset or property");
 		return false;
 	}
 
-	void* ContainerPtr = Asset;
-
 	// ImportText returns the pointer past the parsed text, or nullptr on failure
-	const TCHAR* Result = Property->ImportText_InContainer(*Value, ContainerPtr, Asset, PPF_None);
+	const TCHAR* Result = Property->ImportText_Direct(*Value, ValuePtr, Owner, PPF_None);
 
 	if (!Result)
 	{
@@ -501,7 +672,7 @@ bool FConfigureAssetTool::SetPropertyValue(UObject* Asset, FProperty* Property,
 		}
 
 		// Try again with transformed value
-		Result = Property->ImportText_InContainer(*TransformedValue, ContainerPtr, Asset, PPF_None);
+		Result = Property->ImportText_Direct(*TransformedValue, ValuePtr, Owner, PPF_None);
 
 		if (!Result)
 		{
@@ -745,7 +916,7 @@ void FConfigureAssetTool::RefreshBlueprintEditor(UObject* Asset)
 	// Regular Blueprint: mark as modified to trigger recompile
 	if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset))
 	{
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		FBlueprintCompileScheduler::Get().MarkStructurallyModified(Blueprint);
 		return;
 	}
 }
@@ -764,6 +935,30 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 	}
 
 	FString Result = TEXT("## Slot Configuration\n");
+	const int32 ChangesApplied = ApplySlotConfig(Slot, SlotConfig, Result);
+
+	// Synchronize and refresh
+	if (ChangesApplied > 0)
+	{
+		Slot->SynchronizeProperties();
+		RefreshBlueprintEditor(OriginalAsset);
+		Result += FString::Printf(TEXT("= %d slot properties configured\n"), ChangesApplied);
+	}
+	else
+	{
+		Result += TEXT("= No slot properties changed\n");
+	}
+
+	return Result;
+}
+
+int32 FConfigureAssetTool::ApplySlotConfig(UPanelSlot* Slot, const TSharedPtr<FJsonObject>& SlotConfig, FString& OutLog)
+{
+	if (!Slot || !SlotConfig.IsValid())
+	{
+		return 0;
+	}
+
 	int32 ChangesApplied = 0;
 
 	// Handle CanvasPanelSlot
@@ -776,7 +971,7 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 			FVector2D OldPos = CanvasSlot->GetPosition();
 			FVector2D NewPos((*PositionArray)[0]->AsNumber(), (*PositionArray)[1]->AsNumber());
 			CanvasSlot->SetPosition(NewPos);
-			Result += FString::Printf(TEXT("+ Position: (%.1f, %.1f) -> (%.1f, %.1f)\n"), OldPos.X, OldPos.Y, NewPos.X, NewPos.Y);
+			OutLog += FString::Printf(TEXT("+ Position: (%.1f, %.1f) -> (%.1f, %.1f)\n"), OldPos.X, OldPos.Y, NewPos.X, NewPos.Y);
 			ChangesApplied++;
 		}
 
@@ -787,7 +982,7 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 			FVector2D OldSize = CanvasSlot->GetSize();
 			FVector2D NewSize((*SizeArray)[0]->AsNumber(), (*SizeArray)[1]->AsNumber());
 			CanvasSlot->SetSize(NewSize);
-			Result += FString::Printf(TEXT("+ Size: (%.1f, %.1f) -> (%.1f, %.1f)\n"), OldSize.X, OldSize.Y, NewSize.X, NewSize.Y);
+			OutLog += FString::Printf(TEXT("+ Size: (%.1f, %.1f) -> (%.1f, %.1f)\n"), OldSize.X, OldSize.Y, NewSize.X, NewSize.Y);
 			ChangesApplied++;
 		}
 
@@ -798,7 +993,7 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 			FVector2D OldAlign = CanvasSlot->GetAlignment();
 			FVector2D NewAlign((*AlignmentArray)[0]->AsNumber(), (*AlignmentArray)[1]->AsNumber());
 			CanvasSlot->SetAlignment(NewAlign);
-			Result += FString::Printf(TEXT("+ Alignment: (%.2f, %.2f) -> (%.2f, %.2f)\n"), OldAlign.X, OldAlign.Y, NewAlign.X, NewAlign.Y);
+			OutLog += FString::Printf(TEXT("+ Alignment: (%.2f, %.2f) -> (%.2f, %.2f)\n"), OldAlign.X, OldAlign.Y, NewAlign.X, NewAlign.Y);
 			ChangesApplied++;
 		}
 
@@ -822,7 +1017,7 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 			}
 
 			CanvasSlot->SetAnchors(NewAnchors);
-			Result += FString::Printf(TEXT("+ Anchors: Min(%.2f, %.2f) Max(%.2f, %.2f)\n"),
+			OutLog += FString::Printf(TEXT("+ Anchors: Min(%.2f, %.2f) Max(%.2f, %.2f)\n"),
 				NewAnchors.Minimum.X, NewAnchors.Minimum.Y, NewAnchors.Maximum.X, NewAnchors.Maximum.Y);
 			ChangesApplied++;
 		}
@@ -833,7 +1028,7 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 		{
 			int32 OldZOrder = CanvasSlot->GetZOrder();
 			CanvasSlot->SetZOrder(ZOrder);
-			Result += FString::Printf(TEXT("+ ZOrder: %d -> %d\n"), OldZOrder, ZOrder);
+			OutLog += FString::Printf(TEXT("+ ZOrder: %d -> %d\n"), OldZOrder, ZOrder);
 			ChangesApplied++;
 		}
 
@@ -843,7 +1038,7 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 		{
 			bool bOldAutoSize = CanvasSlot->GetAutoSize();
 			CanvasSlot->SetAutoSize(bAutoSize);
-			Result += FString::Printf(TEXT("+ AutoSize: %s -> %s\n"),
+			OutLog += FString::Printf(TEXT("+ AutoSize: %s -> %s\n"),
 				bOldAutoSize ? TEXT("true") : TEXT("false"),
 				bAutoSize ? TEXT("true") : TEXT("false"));
 			ChangesApplied++;
@@ -862,7 +1057,7 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 			(*PaddingObj)->TryGetNumberField(TEXT("right"), Padding.Right);
 			(*PaddingObj)->TryGetNumberField(TEXT("bottom"), Padding.Bottom);
 			HBoxSlot->SetPadding(Padding);
-			Result += FString::Printf(TEXT("+ Padding: L=%.1f T=%.1f R=%.1f B=%.1f\n"),
+			OutLog += FString::Printf(TEXT("+ Padding: L=%.1f T=%.1f R=%.1f B=%.1f\n"),
 				Padding.Left, Padding.Top, Padding.Right, Padding.Bottom);
 			ChangesApplied++;
 		}
@@ -890,7 +1085,7 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 				Size.Value = Value;
 			}
 			HBoxSlot->SetSize(Size);
-			Result += FString::Printf(TEXT("+ Size: %s (%.2f)\n"),
+			OutLog += FString::Printf(TEXT("+ Size: %s (%.2f)\n"),
 				Size.SizeRule == ESlateSizeRule::Fill ? TEXT("Fill") : TEXT("Auto"), Size.Value);
 			ChangesApplied++;
 		}
@@ -908,7 +1103,7 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 			(*PaddingObj)->TryGetNumberField(TEXT("right"), Padding.Right);
 			(*PaddingObj)->TryGetNumberField(TEXT("bottom"), Padding.Bottom);
 			VBoxSlot->SetPadding(Padding);
-			Result += FString::Printf(TEXT("+ Padding: L=%.1f T=%.1f R=%.1f B=%.1f\n"),
+			OutLog += FString::Printf(TEXT("+ Padding: L=%.1f T=%.1f R=%.1f B=%.1f\n"),
 				Padding.Left, Padding.Top, Padding.Right, Padding.Bottom);
 			ChangesApplied++;
 		}
@@ -936,7 +1131,7 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 				Size.Value = Value;
 			}
 			VBoxSlot->SetSize(Size);
-			Result += FString::Printf(TEXT("+ Size: %s (%.2f)\n"),
+			OutLog += FString::Printf(TEXT("+ Size: %s (%.2f)\n"),
 				Size.SizeRule == ESlateSizeRule::Fill ? TEXT("Fill") : TEXT("Auto"), Size.Value);
 			ChangesApplied++;
 		}
@@ -954,27 +1149,15 @@ FString FConfigureAssetTool::ConfigureSlot(UWidget* Widget, const TSharedPtr<FJs
 			(*PaddingObj)->TryGetNumberField(TEXT("right"), Padding.Right);
 			(*PaddingObj)->TryGetNumberField(TEXT("bottom"), Padding.Bottom);
 			OvlSlot->SetPadding(Padding);
-			Result += FString::Printf(TEXT("+ Padding: L=%.1f T=%.1f R=%.1f B=%.1f\n"),
+			OutLog += FString::Printf(TEXT("+ Padding: L=%.1f T=%.1f R=%.1f B=%.1f\n"),
 				Padding.Left, Padding.Top, Padding.Right, Padding.Bottom);
 			ChangesApplied++;
 		}
 	}
 	else
 	{
-		Result += FString::Printf(TEXT("! Unsupported slot type: %s\n"), *Slot->GetClass()->GetName());
+		OutLog += FString::Printf(TEXT("! Unsupported slot type: %s\n"), *Slot->GetClass()->GetName());
 	}
 
-	// Synchronize and refresh
-	if (ChangesApplied > 0)
-	{
-		Slot->SynchronizeProperties();
-		RefreshBlueprintEditor(OriginalAsset);
-		Result += FString::Printf(TEXT("= %d slot properties configured\n"), ChangesApplied);
-	}
-	else
-	{
-		Result += TEXT("= No slot properties changed\n");
-	}
-
-	return Result;
+	return ChangesApplied;
 }
@@ -16,6 +16,9 @@
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "Factories/Factory.h"
 #include "UObject/UObjectIterator.h"
+#include "UObject/SavePackage.h"
+#include "Misc/PackageName.h"
+#include "Algo/StableSort.h"
 
 // Specialized Blueprint types
 #include "Blueprint/UserWidget.h"
@@ -212,6 +215,41 @@ namespace
 		return FAssetTypeInfo();
 	}
 
+	/** String field of a batch spec, empty if missing */
+	FString GetSpecString(const TSharedPtr<FJsonObject>& Spec, const TCHAR* Field)
+	{
+		FString Value;
+		Spec->TryGetStringField(Field, Value);
+		return Value;
+	}
+
+	bool IsStructType(const FString& TypeName)
+	{
+		return TypeName.Equals(TEXT("Struct"), ESearchCase::IgnoreCase) ||
+			TypeName.Equals(TEXT("UserDefinedStruct"), ESearchCase::IgnoreCase);
+	}
+
+	/**
+	 * Creation pass for a batch spec: enums and structs are referenced by the assets after them.
+	 */
+	int32 GetCreatePass(const FString& TypeName)
+	{
+		if (TypeName.Equals(TEXT("Enum"), ESearchCase::IgnoreCase) ||
+			TypeName.Equals(TEXT("UserDefinedEnum"), ESearchCase::IgnoreCase))
+		{
+			return 0;
+		}
+		if (IsStructType(TypeName))
+		{
+			return 1;
+		}
+		if (TypeName.Equals(TEXT("DataTable"), ESearchCase::IgnoreCase))
+		{
+			return 2;
+		}
+		return 3;
+	}
+
 	/**
 	 * Checks if the type name refers to a Widget Blueprint.
 	 */
@@ -255,7 +293,202 @@ namespace
 	}
 }
 
+void FCreateFileTool::GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const
+{
+	const TArray<TSharedPtr<FJsonValue>>* Specs;
+	if (Args->TryGetArrayField(TEXT("assets"), Specs))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *Specs)
+		{
+			const TSharedPtr<FJsonObject>* Spec;
+			if (Value.IsValid() && Value->TryGetObject(Spec))
+			{
+				NeoStackToolUtils::AddNamePathResource(*Spec, OutKeys);
+			}
+		}
+		return;
+	}
+
+	NeoStackToolUtils::AddNamePathResource(Args, OutKeys);
+}
+
 FToolResult FCreateFileTool::Execute(const TSharedPtr<FJsonObject>& Args)
+{
+	bool bSave = false;
+	Args->TryGetBoolField(TEXT("save"), bSave);
+
+	const TArray<TSharedPtr<FJsonValue>>* Specs;
+	if (Args->TryGetArrayField(TEXT("assets"), Specs))
+	{
+		return ExecuteBatch(*Specs, bSave);
+	}
+
+	CreatedPackages.Reset();
+	FToolResult Result = CreateFromSpec(Args);
+	if (Result.bSuccess && bSave && CreatedPackages.Num() > 0)
+	{
+		TArray<FString> Failed;
+		SaveCreatedPackages(Failed);
+		Result.Output += Failed.Num() == 0
+			? TEXT("\nSaved")
+			: FString::Printf(TEXT("\n! Save failed: %s"), *FString::Join(Failed, TEXT(", ")));
+	}
+	CreatedPackages.Reset();
+	return Result;
+}
+
+TArray<TSharedPtr<FJsonObject>> FCreateFileTool::OrderSpecs(const TArray<TSharedPtr<FJsonValue>>& Specs)
+{
+	TArray<TSharedPtr<FJsonObject>> Ordered;
+	for (const TSharedPtr<FJsonValue>& Value : Specs)
+	{
+		const TSharedPtr<FJsonObject>* Spec;
+		if (Value.IsValid() && Value->TryGetObject(Spec))
+		{
+			Ordered.Add(*Spec);
+		}
+	}
+
+	Algo::StableSortBy(Ordered, [](const TSharedPtr<FJsonObject>& Spec)
+	{
+		return GetCreatePass(GetSpecString(Spec, TEXT("parent")));
+	});
+
+	// Structs whose fields use another struct of the batch go after it (cycles keep their order)
+	TArray<TSharedPtr<FJsonObject>> Structs;
+	int32 FirstStruct = INDEX_NONE;
+	for (int32 i = 0; i < Ordered.Num(); i++)
+	{
+		if (IsStructType(GetSpecString(Ordered[i], TEXT("parent"))))
+		{
+			FirstStruct = FirstStruct == INDEX_NONE ? i : FirstStruct;
+			Structs.Add(Ordered[i]);
+		}
+	}
+	if (Structs.Num() < 2)
+	{
+		return Ordered;
+	}
+
+	auto DependsOn = [](const TSharedPtr<FJsonObject>& Spec, const FString& StructName)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Fields;
+		if (Spec->TryGetArrayField(TEXT("fields"), Fields))
+		{
+			for (const TSharedPtr<FJsonValue>& Field : *Fields)
+			{
+				const TSharedPtr<FJsonObject>* FieldObj;
+				FString Type;
+				if (Field->TryGetObject(FieldObj) && (*FieldObj)->TryGetStringField(TEXT("type"), Type) &&
+					Type.Contains(StructName))
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	};
+
+	TArray<TSharedPtr<FJsonObject>> Sorted;
+	while (Structs.Num() > 0)
+	{
+		int32 Ready = 0;
+		for (int32 i = 0; i < Structs.Num(); i++)
+		{
+			bool bBlocked = false;
+			for (int32 j = 0; j < Structs.Num() && !bBlocked; j++)
+			{
+				bBlocked = i != j && DependsOn(Structs[i], GetSpecString(Structs[j], TEXT("name")));
+			}
+			if (!bBlocked)
+			{
+				Ready = i;
+				break;
+			}
+		}
+		Sorted.Add(Structs[Ready]);
+		Structs.RemoveAt(Ready);
+	}
+
+	for (int32 i = 0; i < Sorted.Num(); i++)
+	{
+		Ordered[FirstStruct + i] = Sorted[i];
+	}
+	return Ordered;
+}
+
+FToolResult FCreateFileTool::ExecuteBatch(const TArray<TSharedPtr<FJsonValue>>& Specs, bool bSave)
+{
+	const TArray<TSharedPtr<FJsonObject>> Ordered = OrderSpecs(Specs);
+	if (Ordered.Num() == 0)
+	{
+		return FToolResult::Fail(TEXT("assets: expected an array of asset objects"));
+	}
+
+	CreatedPackages.Reset();
+	bBatchCreate = true;
+
+	FString Output = FString::Printf(TEXT("# CREATE %d assets\n"), Ordered.Num());
+	int32 CreatedCount = 0;
+	for (const TSharedPtr<FJsonObject>& Spec : Ordered)
+	{
+		const FToolResult Result = CreateFromSpec(Spec);
+		FString FirstLine = Result.Output;
+		FirstLine.Split(TEXT("\n"), &FirstLine, nullptr);
+
+		Output += FString::Printf(TEXT("%s %s: %s\n"), Result.bSuccess ? TEXT("+") : TEXT("!"),
+			*GetSpecString(Spec, TEXT("name")), *FirstLine);
+		CreatedCount += Result.bSuccess ? 1 : 0;
+	}
+
+	bBatchCreate = false;
+
+	if (bSave && CreatedPackages.Num() > 0)
+	{
+		TArray<FString> Failed;
+		const int32 SavedCount = SaveCreatedPackages(Failed);
+		Output += FString::Printf(TEXT("Saved %d packages\n"), SavedCount);
+		for (const FString& PackageName : Failed)
+		{
+			Output += FString::Printf(TEXT("! Save failed: %s\n"), *PackageName);
+		}
+	}
+	CreatedPackages.Reset();
+
+	Output += FString::Printf(TEXT("= %d created, %d failed\n"), CreatedCount, Ordered.Num() - CreatedCount);
+	return CreatedCount > 0 ? FToolResult::Ok(Output) : FToolResult::Fail(Output);
+}
+
+int32 FCreateFileTool::SaveCreatedPackages(TArray<FString>& OutFailed)
+{
+	// Serialization stays on the game thread; SAVE_Async hands the file writes to the async writer
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_Async | SAVE_NoError;
+	SaveArgs.Error = GWarn;
+
+	int32 SavedCount = 0;
+	for (UPackage* Package : CreatedPackages)
+	{
+		if (!Package || !Package->IsDirty())
+		{
+			continue;
+		}
+
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		if (UPackage::SavePackage(Package, Package->FindAssetInPackage(), *Filename, SaveArgs))
+		{
+			SavedCount++;
+		}
+		else
+		{
+			OutFailed.Add(Package->GetName());
+		}
+	}
+	return SavedCount;
+}
+
+FToolResult FCreateFileTool::CreateFromSpec(const TSharedPtr<FJsonObject>& Args)
 {
 	FString Name, Parent, Path, Content;
 
@@ -437,10 +670,11 @@ FToolResult FCreateFileTool::CreateAsset(const FString& Name, UClass* AssetClass
 
 	// Mark dirty and notify asset registry
 	Package->MarkPackageDirty();
+	CreatedPackages.Add(Package);
 	FAssetRegistryModule::AssetCreated(NewAsset);
 
-	// Open in editor
-	if (GEditor)
+	// Open in editor (not for batches)
+	if (GEditor && !bBatchCreate)
 	{
 		GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(NewAsset);
 	}
@@ -520,14 +754,21 @@ FToolResult FCreateFileTool::CreateBlueprint(const FString& Name, const FString&
 
 	// Mark dirty and notify asset registry
 	Package->MarkPackageDirty();
+	CreatedPackages.Add(Package);
 	FAssetRegistryModule::AssetCreated(NewBlueprint);
 
-	// Open in editor
-	if (GEditor)
+	// Open in editor (not for batches)
+	if (GEditor && !bBatchCreate)
 	{
 		GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(NewBlueprint);
 	}
 
+	if (bBatchCreate)
+	{
+		return FToolResult::Ok(FString::Printf(TEXT("Created %s at %s (parent: %s)"),
+			*Name, *PackageName, *ParentClass->GetName()));
+	}
+
 	// Read the created asset's state using ReadFileTool
 	FReadFileTool ReadTool;
 	TSharedPtr<FJsonObject> ReadArgs = MakeShareable(new FJsonObject());
@@ -589,13 +830,19 @@ FToolResult FCreateFileTool::CreateWidgetBlueprint(const FString& Name, const FS
 	{
 		return FToolResult::Fail(TEXT("Failed to create Widget Blueprint"));
 	}
+	CreatedPackages.Add(NewAsset->GetOutermost());
 
-	// Open in editor
-	if (GEditor)
+	// Open in editor (not for batches)
+	if (GEditor && !bBatchCreate)
 	{
 		GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(NewAsset);
 	}
 
+	if (bBatchCreate)
+	{
+		return FToolResult::Ok(FString::Printf(TEXT("Created Widget Blueprint %s at %s"), *Name, *PackageName));
+	}
+
 	// Read the created asset's state using ReadFileTool
 	FReadFileTool ReadTool;
 	TSharedPtr<FJsonObject> ReadArgs = MakeShareable(new FJsonObject());
@@ -848,10 +1095,11 @@ FToolResult FCreateFileTool::CreateUserDefinedStruct(const FString& Name, const
 
 	// Mark dirty and notify asset registry
 	Package->MarkPackageDirty();
+	CreatedPackages.Add(Package);
 	FAssetRegistryModule::AssetCreated(NewStruct);
 
-	// Open in editor
-	if (GEditor)
+	// Open in editor (not for batches)
+	if (GEditor && !bBatchCreate)
 	{
 		GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(NewStruct);
 	}
@@ -937,10 +1185,11 @@ FToolResult FCreateFileTool::CreateUserDefinedEnum(const FString& Name, const FS
 
 	// Mark dirty and notify asset registry
 	Package->MarkPackageDirty();
+	CreatedPackages.Add(Package);
 	FAssetRegistryModule::AssetCreated(NewEnum);
 
-	// Open in editor
-	if (GEditor)
+	// Open in editor (not for batches)
+	if (GEditor && !bBatchCreate)
 	{
 		GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(NewEnum);
 	}
@@ -1057,10 +1306,11 @@ FToolResult FCreateFileTool::CreateDataTable(const FString& Name, const FString&
 
 	// Mark dirty and notify asset registry
 	Package->MarkPackageDirty();
+	CreatedPackages.Add(Package);
 	FAssetRegistryModule::AssetCreated(NewDataTable);
 
-	// Open in editor
-	if (GEditor)
+	// Open in editor (not for batches)
+	if (GEditor && !bBatchCreate)
 	{
 		GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(NewDataTable);
 	}
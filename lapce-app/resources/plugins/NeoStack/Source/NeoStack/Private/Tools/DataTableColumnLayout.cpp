@@ -0,0 +1,276 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/DataTableColumnLayout.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "Engine/UserDefinedStruct.h"
+#include "Kismet2/StructureEditorUtils.h"
+
+namespace
+{
+	/** Enum behind an enum or byte property, or null */
+	const UEnum* GetPropertyEnum(const FProperty* Property)
+	{
+		if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+		{
+			return EnumProp->GetEnum();
+		}
+		if (const FByteProperty* ByteProp = CastField<FByteProperty>(Property))
+		{
+			return ByteProp->Enum;
+		}
+		return nullptr;
+	}
+
+	bool CanCompareAsNumber(const FProperty* Property)
+	{
+		return Property->IsA<FNumericProperty>() || Property->IsA<FBoolProperty>() || Property->IsA<FEnumProperty>();
+	}
+
+	/** Value as a number for numeric, bool and enum properties */
+	bool GetNumber(const FProperty* Property, const void* ValuePtr, double& OutNumber)
+	{
+		if (const FEnumProperty* EnumProp = CastField<FEnumProperty>(Property))
+		{
+			OutNumber = static_cast<double>(EnumProp->GetUnderlyingProperty()->GetSignedIntPropertyValue(ValuePtr));
+			return true;
+		}
+		if (const FNumericProperty* NumericProp = CastField<FNumericProperty>(Property))
+		{
+			OutNumber = NumericProp->IsFloatingPoint()
+				? NumericProp->GetFloatingPointPropertyValue(ValuePtr)
+				: static_cast<double>(NumericProp->GetSignedIntPropertyValue(ValuePtr));
+			return true;
+		}
+		if (const FBoolProperty* BoolProp = CastField<FBoolProperty>(Property))
+		{
+			OutNumber = BoolProp->GetPropertyValue(ValuePtr) ? 1.0 : 0.0;
+			return true;
+		}
+		return false;
+	}
+
+	/** Value as text; names, strings, text and enums are read directly, the rest exported */
+	FString GetString(const FProperty* Property, const void* ValuePtr)
+	{
+		if (const FStrProperty* StrProp = CastField<FStrProperty>(Property))
+		{
+			return StrProp->GetPropertyValue(ValuePtr);
+		}
+		if (const FNameProperty* NameProp = CastField<FNameProperty>(Property))
+		{
+			return NameProp->GetPropertyValue(ValuePtr).ToString();
+		}
+		if (const FTextProperty* TextProp = CastField<FTextProperty>(Property))
+		{
+			return TextProp->GetPropertyValue(ValuePtr).ToString();
+		}
+		if (const UEnum* Enum = GetPropertyEnum(Property))
+		{
+			double Number = 0.0;
+			GetNumber(Property, ValuePtr, Number);
+			return Enum->GetDisplayNameTextByValue(static_cast<int64>(Number)).ToString();
+		}
+
+		FString Exported;
+		Property->ExportTextItem_Direct(Exported, ValuePtr, nullptr, nullptr, PPF_None);
+		return Exported;
+	}
+}
+
+int32 FDataTableColumnLayout::Find(const FString& Name) const
+{
+	const int32* Index = IndexByName.Find(Name.ToLower());
+	return Index ? *Index : INDEX_NONE;
+}
+
+FString FDataTableColumnLayout::JoinNames() const
+{
+	TArray<FString> Names;
+	Names.Reserve(Columns.Num());
+	for (const FColumn& Column : Columns)
+	{
+		Names.Add(Column.Name);
+	}
+	return FString::Join(Names, TEXT(", "));
+}
+
+bool FDataTableRowFilter::Parse(const FString& Expression, const FDataTableColumnLayout& Layout,
+	FDataTableRowFilter& OutFilter, FString& OutError)
+{
+	int32 OpStart = INDEX_NONE;
+	for (int32 i = 0; i < Expression.Len(); i++)
+	{
+		if (FCString::Strchr(TEXT("=!<>~"), Expression[i]))
+		{
+			OpStart = i;
+			break;
+		}
+	}
+	if (OpStart <= 0)
+	{
+		OutError = FString::Printf(TEXT("Invalid filter '%s' (expected 'column op value')"), *Expression);
+		return false;
+	}
+
+	int32 OpEnd = OpStart + 1;
+	while (OpEnd < Expression.Len() && FCString::Strchr(TEXT("=<>"), Expression[OpEnd]))
+	{
+		OpEnd++;
+	}
+
+	const FString OpText = Expression.Mid(OpStart, OpEnd - OpStart);
+	if (OpText == TEXT("=") || OpText == TEXT("==")) OutFilter.Op = EOp::Equal;
+	else if (OpText == TEXT("!=")) OutFilter.Op = EOp::NotEqual;
+	else if (OpText == TEXT("<")) OutFilter.Op = EOp::Less;
+	else if (OpText == TEXT("<=")) OutFilter.Op = EOp::LessEqual;
+	else if (OpText == TEXT(">")) OutFilter.Op = EOp::Greater;
+	else if (OpText == TEXT(">=")) OutFilter.Op = EOp::GreaterEqual;
+	else if (OpText == TEXT("~")) OutFilter.Op = EOp::Contains;
+	else
+	{
+		OutError = FString::Printf(TEXT("Unknown operator '%s' in filter '%s'"), *OpText, *Expression);
+		return false;
+	}
+
+	const FString ColumnName = Expression.Left(OpStart).TrimStartAndEnd();
+	OutFilter.Column = Layout.Find(ColumnName);
+	if (OutFilter.Column == INDEX_NONE)
+	{
+		OutError = FString::Printf(TEXT("Unknown column '%s' in filter (columns: %s)"), *ColumnName, *Layout.JoinNames());
+		return false;
+	}
+
+	OutFilter.Value = Expression.Mid(OpEnd).TrimStartAndEnd().TrimQuotes();
+
+	// Numbers, bools and enum values compare natively; "true"/"false" count as 1/0, and enum
+	// names fall back to comparing display names
+	const FProperty* Property = Layout.Columns[OutFilter.Column].Property;
+	OutFilter.bNumeric = false;
+	if (OutFilter.Op != EOp::Contains && CanCompareAsNumber(Property))
+	{
+		if (OutFilter.Value.IsNumeric())
+		{
+			OutFilter.NumberValue = FCString::Atod(*OutFilter.Value);
+			OutFilter.bNumeric = true;
+		}
+		else if (Property->IsA<FBoolProperty>())
+		{
+			OutFilter.NumberValue = OutFilter.Value.ToBool() ? 1.0 : 0.0;
+			OutFilter.bNumeric = true;
+		}
+	}
+
+	return true;
+}
+
+bool FDataTableRowFilter::CompareOrder(int32 Order) const
+{
+	switch (Op)
+	{
+	case EOp::Equal:        return Order == 0;
+	case EOp::NotEqual:     return Order != 0;
+	case EOp::Less:         return Order < 0;
+	case EOp::LessEqual:    return Order <= 0;
+	case EOp::Greater:      return Order > 0;
+	case EOp::GreaterEqual: return Order >= 0;
+	default:                return false;
+	}
+}
+
+bool FDataTableRowFilter::Matches(const FDataTableColumnLayout& Layout, const uint8* RowData) const
+{
+	const FProperty* Property = Layout.Columns[Column].Property;
+	const void* ValuePtr = Property->ContainerPtrToValuePtr<void>(RowData);
+
+	if (bNumeric)
+	{
+		double Number = 0.0;
+		GetNumber(Property, ValuePtr, Number);
+		return CompareOrder(Number < NumberValue ? -1 : (Number > NumberValue ? 1 : 0));
+	}
+
+	const FString Text = GetString(Property, ValuePtr);
+	if (Op == EOp::Contains)
+	{
+		return Text.Contains(Value, ESearchCase::IgnoreCase);
+	}
+	return CompareOrder(Text.Compare(Value, ESearchCase::IgnoreCase));
+}
+
+class FDataTableColumnLayoutCache::FStructListener : public FStructureEditorUtils::INotifyOnStructChanged
+{
+public:
+	explicit FStructListener(FDataTableColumnLayoutCache& InOwner) : Owner(InOwner) {}
+
+	virtual void PreChange(const UUserDefinedStruct* Changed, FStructureEditorUtils::EStructureEditorChangeInfo ChangedType) override
+	{
+		Owner.Invalidate(Changed);
+	}
+
+	virtual void PostChange(const UUserDefinedStruct* Changed, FStructureEditorUtils::EStructureEditorChangeInfo ChangedType) override
+	{
+		Owner.Invalidate(Changed);
+	}
+
+private:
+	FDataTableColumnLayoutCache& Owner;
+};
+
+FDataTableColumnLayoutCache::FDataTableColumnLayoutCache() = default;
+FDataTableColumnLayoutCache::~FDataTableColumnLayoutCache() = default;
+
+FDataTableColumnLayoutCache& FDataTableColumnLayoutCache::Get()
+{
+	static FDataTableColumnLayoutCache Instance;
+	return Instance;
+}
+
+TSharedRef<const FDataTableColumnLayout> FDataTableColumnLayoutCache::GetLayout(const UScriptStruct* RowStruct)
+{
+	if (const TSharedRef<const FDataTableColumnLayout>* Cached = Layouts.Find(RowStruct))
+	{
+		return *Cached;
+	}
+
+	if (!Listener)
+	{
+		Listener = MakeUnique<FStructListener>(*this);
+	}
+
+	// Drop layouts of structs that have since been garbage collected
+	for (auto It = Layouts.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TSharedRef<FDataTableColumnLayout> Layout = MakeShared<FDataTableColumnLayout>();
+	if (RowStruct)
+	{
+		for (TFieldIterator<FProperty> PropIt(RowStruct); PropIt; ++PropIt)
+		{
+			const FProperty* Property = *PropIt;
+			const int32 Index = Layout->Columns.Add({ Property, Property->GetAuthoredName() });
+			Layout->IndexByName.Add(Property->GetAuthoredName().ToLower(), Index);
+			Layout->IndexByName.Add(Property->GetName().ToLower(), Index);
+		}
+	}
+
+	Layouts.Add(RowStruct, Layout);
+	return Layout;
+}
+
+void FDataTableColumnLayoutCache::Invalidate(const UScriptStruct* RowStruct)
+{
+	Layouts.Remove(RowStruct);
+}
+
+void FDataTableColumnLayoutCache::Shutdown()
+{
+	Listener.Reset();
+	Layouts.Empty();
+}
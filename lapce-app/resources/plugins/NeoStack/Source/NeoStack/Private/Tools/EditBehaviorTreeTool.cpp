@@ -14,6 +14,8 @@
 #include "BehaviorTree/Composites/BTComposite_Selector.h"
 #include "BehaviorTree/Composites/BTComposite_Sequence.h"
 #include "BehaviorTree/Composites/BTComposite_SimpleParallel.h"
+#include "BehaviorTreeGraph.h"
+#include "BehaviorTreeGraphNode_Root.h"
 
 // Blackboard
 #include "BehaviorTree/BlackboardData.h"
@@ -33,6 +35,11 @@
 #include "UObject/UObjectIterator.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 
+void FEditBehaviorTreeTool::GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const
+{
+	NeoStackToolUtils::AddNamePathResource(Args, OutKeys);
+}
+
 FToolResult FEditBehaviorTreeTool::Execute(const TSharedPtr<FJsonObject>& Args)
 {
 	FString Name, Path;
@@ -67,6 +74,10 @@ FToolResult FEditBehaviorTreeTool::Execute(const TSharedPtr<FJsonObject>& Args)
 	// ========== Behavior Tree Operations ==========
 	if (BehaviorTree)
 	{
+		// Every lookup below goes through the index; class lookups are cached for the call
+		BuildNodeIndex(BehaviorTree);
+		NodeClassCache.Reset();
+
 		// Process set_blackboard
 		FString BlackboardName;
 		if (Args->TryGetStringField(TEXT("set_blackboard"), BlackboardName) && !BlackboardName.IsEmpty())
@@ -98,6 +109,38 @@ FToolResult FEditBehaviorTreeTool::Execute(const TSharedPtr<FJsonObject>& Args)
 			}
 		}
 
+		// Process add_subtree
+		const TArray<TSharedPtr<FJsonValue>>* AddSubtrees;
+		if (Args->TryGetArrayField(TEXT("add_subtree"), AddSubtrees))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *AddSubtrees)
+			{
+				const TSharedPtr<FJsonObject>* SubtreeObj;
+				if (!Value->TryGetObject(SubtreeObj))
+				{
+					continue;
+				}
+
+				FString ParentName;
+				int32 Index = -1;
+				(*SubtreeObj)->TryGetStringField(TEXT("parent"), ParentName);
+				(*SubtreeObj)->TryGetNumberField(TEXT("index"), Index);
+
+				UBTCompositeNode* ParentNode = nullptr;
+				if (!ParentName.IsEmpty())
+				{
+					ParentNode = FindComposite(ParentName);
+					if (!ParentNode)
+					{
+						Results.Add(FString::Printf(TEXT("! Subtree: Parent '%s' not found"), *ParentName));
+						continue;
+					}
+				}
+
+				AddedCount += AddSubtree(BehaviorTree, *SubtreeObj, ParentNode, Index, Results);
+			}
+		}
+
 		// Process add_task
 		const TArray<TSharedPtr<FJsonValue>>* AddTasks;
 		if (Args->TryGetArrayField(TEXT("add_task"), AddTasks))
@@ -180,6 +223,12 @@ FToolResult FEditBehaviorTreeTool::Execute(const TSharedPtr<FJsonObject>& Args)
 
 		// Mark dirty
 		BehaviorTree->Modify();
+
+		// Sync the editor graph once for everything above
+		if (AddedCount > 0 || RemovedCount > 0)
+		{
+			RebuildTreeGraph(BehaviorTree);
+		}
 	}
 
 	// ========== Blackboard Operations (works for both standalone and BT's blackboard) ==========
@@ -245,61 +294,85 @@ FToolResult FEditBehaviorTreeTool::Execute(const TSharedPtr<FJsonObject>& Args)
 
 // ========== Find Helpers ==========
 
-UBTCompositeNode* FEditBehaviorTreeTool::FindCompositeByName(UBTCompositeNode* Root, const FString& Name)
+void FEditBehaviorTreeTool::BuildNodeIndex(UBehaviorTree* BehaviorTree)
 {
-	if (!Root)
+	NodesByName.Reset();
+	NodeParents.Reset();
+	if (BehaviorTree->RootNode)
+	{
+		IndexNode(BehaviorTree->RootNode, nullptr);
+	}
+}
+
+void FEditBehaviorTreeTool::IndexNode(UBTNode* Node, UBTCompositeNode* Parent)
+{
+	if (!Node)
+	{
+		return;
+	}
+
+	if (Parent)
 	{
-		return nullptr;
+		NodeParents.Add(Node, Parent);
 	}
 
-	// Check this node
-	if (Root->GetNodeName().Equals(Name, ESearchCase::IgnoreCase))
+	// First node wins a name, except that a composite replaces a task of the same name
+	UBTNode*& Named = NodesByName.FindOrAdd(Node->GetNodeName().ToLower());
+	if (!Named || (Named->IsA<UBTTaskNode>() && Node->IsA<UBTCompositeNode>()))
 	{
-		return Root;
+		Named = Node;
 	}
 
-	// Check children
-	for (int32 i = 0; i < Root->GetChildrenNum(); i++)
+	if (UBTCompositeNode* Composite = Cast<UBTCompositeNode>(Node))
 	{
-		FBTCompositeChild& Child = Root->Children[i];
-		if (Child.ChildComposite)
+		for (FBTCompositeChild& Child : Composite->Children)
 		{
-			UBTCompositeNode* Found = FindCompositeByName(Child.ChildComposite, Name);
-			if (Found)
-			{
-				return Found;
-			}
+			IndexNode(Child.ChildComposite ? (UBTNode*)Child.ChildComposite : (UBTNode*)Child.ChildTask, Composite);
 		}
 	}
+}
 
-	return nullptr;
+UBTNode* FEditBehaviorTreeTool::FindNode(const FString& Name) const
+{
+	return NodesByName.FindRef(Name.ToLower());
+}
+
+UBTCompositeNode* FEditBehaviorTreeTool::FindComposite(const FString& Name) const
+{
+	return Cast<UBTCompositeNode>(FindNode(Name));
 }
 
-UBTTaskNode* FEditBehaviorTreeTool::FindTaskByName(UBTCompositeNode* Root, const FString& Name)
+UClass* FEditBehaviorTreeTool::FindNodeClass(UClass* BaseClass, const TCHAR* Prefix, const FString& TypeName)
 {
-	if (!Root)
+	const FString CacheKey = FString::Printf(TEXT("%s:%s"), Prefix, *TypeName.ToLower());
+	if (UClass** Cached = NodeClassCache.Find(CacheKey))
 	{
-		return nullptr;
+		return *Cached;
 	}
 
-	for (int32 i = 0; i < Root->GetChildrenNum(); i++)
+	FString ClassName = TypeName;
+	if (!ClassName.StartsWith(Prefix))
 	{
-		FBTCompositeChild& Child = Root->Children[i];
-		if (Child.ChildTask && Child.ChildTask->GetNodeName().Equals(Name, ESearchCase::IgnoreCase))
-		{
-			return Child.ChildTask;
-		}
-		if (Child.ChildComposite)
+		ClassName = Prefix + TypeName;
+	}
+
+	UClass* Found = nullptr;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (It->IsChildOf(BaseClass) &&
+			!It->HasAnyClassFlags(CLASS_Abstract))
 		{
-			UBTTaskNode* Found = FindTaskByName(Child.ChildComposite, Name);
-			if (Found)
+			if (It->GetName().Equals(ClassName, ESearchCase::IgnoreCase) ||
+				It->GetName().Equals(TypeName, ESearchCase::IgnoreCase))
 			{
-				return Found;
+				Found = *It;
+				break;
 			}
 		}
 	}
 
-	return nullptr;
+	NodeClassCache.Add(CacheKey, Found);
+	return Found;
 }
 
 UClass* FEditBehaviorTreeTool::FindCompositeClass(const FString& TypeName)
@@ -320,132 +393,59 @@ UClass* FEditBehaviorTreeTool::FindCompositeClass(const FString& TypeName)
 	}
 
 	// Try to find by class name
-	FString ClassName = TypeName;
-	if (!ClassName.StartsWith(TEXT("BTComposite_")))
-	{
-		ClassName = TEXT("BTComposite_") + TypeName;
-	}
-
-	for (TObjectIterator<UClass> It; It; ++It)
-	{
-		if (It->IsChildOf(UBTCompositeNode::StaticClass()) &&
-			!It->HasAnyClassFlags(CLASS_Abstract))
-		{
-			if (It->GetName().Equals(ClassName, ESearchCase::IgnoreCase) ||
-				It->GetName().Equals(TypeName, ESearchCase::IgnoreCase))
-			{
-				return *It;
-			}
-		}
-	}
-
-	return nullptr;
+	return FindNodeClass(UBTCompositeNode::StaticClass(), TEXT("BTComposite_"), TypeName);
 }
 
 UClass* FEditBehaviorTreeTool::FindTaskClass(const FString& TypeName)
 {
-	FString ClassName = TypeName;
-	if (!ClassName.StartsWith(TEXT("BTTask_")))
-	{
-		ClassName = TEXT("BTTask_") + TypeName;
-	}
-
-	for (TObjectIterator<UClass> It; It; ++It)
-	{
-		if (It->IsChildOf(UBTTaskNode::StaticClass()) &&
-			!It->HasAnyClassFlags(CLASS_Abstract))
-		{
-			if (It->GetName().Equals(ClassName, ESearchCase::IgnoreCase) ||
-				It->GetName().Equals(TypeName, ESearchCase::IgnoreCase))
-			{
-				return *It;
-			}
-		}
-	}
-
-	return nullptr;
+	return FindNodeClass(UBTTaskNode::StaticClass(), TEXT("BTTask_"), TypeName);
 }
 
 UClass* FEditBehaviorTreeTool::FindDecoratorClass(const FString& TypeName)
 {
-	FString ClassName = TypeName;
-	if (!ClassName.StartsWith(TEXT("BTDecorator_")))
-	{
-		ClassName = TEXT("BTDecorator_") + TypeName;
-	}
-
-	for (TObjectIterator<UClass> It; It; ++It)
-	{
-		if (It->IsChildOf(UBTDecorator::StaticClass()) &&
-			!It->HasAnyClassFlags(CLASS_Abstract))
-		{
-			if (It->GetName().Equals(ClassName, ESearchCase::IgnoreCase) ||
-				It->GetName().Equals(TypeName, ESearchCase::IgnoreCase))
-			{
-				return *It;
-			}
-		}
-	}
-
-	return nullptr;
+	return FindNodeClass(UBTDecorator::StaticClass(), TEXT("BTDecorator_"), TypeName);
 }
 
 UClass* FEditBehaviorTreeTool::FindServiceClass(const FString& TypeName)
 {
-	FString ClassName = TypeName;
-	if (!ClassName.StartsWith(TEXT("BTService_")))
-	{
-		ClassName = TEXT("BTService_") + TypeName;
-	}
-
-	for (TObjectIterator<UClass> It; It; ++It)
-	{
-		if (It->IsChildOf(UBTService::StaticClass()) &&
-			!It->HasAnyClassFlags(CLASS_Abstract))
-		{
-			if (It->GetName().Equals(ClassName, ESearchCase::IgnoreCase) ||
-				It->GetName().Equals(TypeName, ESearchCase::IgnoreCase))
-			{
-				return *It;
-			}
-		}
-	}
-
-	return nullptr;
+	return FindNodeClass(UBTService::StaticClass(), TEXT("BTService_"), TypeName);
 }
 
 // ========== Helper for Decorator Attachment ==========
 
-bool FEditBehaviorTreeTool::AttachDecoratorToChildEdge(UBTCompositeNode* Parent, UBTNode* TargetNode, UBTDecorator* Decorator)
+bool FEditBehaviorTreeTool::AttachDecoratorToChildEdge(UBTNode* TargetNode, UBTDecorator* Decorator)
 {
-	if (!Parent || !TargetNode || !Decorator)
+	UBTCompositeNode* Parent = TargetNode ? NodeParents.FindRef(TargetNode) : nullptr;
+	if (!Parent || !Decorator)
 	{
 		return false;
 	}
 
-	// Check children of this parent
+	// Find the child edge in the parent and attach the decorator there
 	for (FBTCompositeChild& Child : Parent->Children)
 	{
 		if (Child.ChildComposite == TargetNode || Child.ChildTask == TargetNode)
 		{
-			// Found the child edge - attach decorator here
 			Child.Decorators.Add(Decorator);
 			return true;
 		}
-
-		// Recurse into composite children
-		if (Child.ChildComposite)
-		{
-			if (AttachDecoratorToChildEdge(Child.ChildComposite, TargetNode, Decorator))
-			{
-				return true;
-			}
-		}
 	}
 
 	return false;
 }
 
+void FEditBehaviorTreeTool::InsertChild(UBTCompositeNode* Parent, const FBTCompositeChild& Child, int32 Index)
+{
+	if (Index >= 0 && Index < Parent->Children.Num())
+	{
+		Parent->Children.Insert(Child, Index);
+	}
+	else
+	{
+		Parent->Children.Add(Child);
+	}
+}
+
 // ========== Behavior Tree Add/Remove Operations ==========
 
 FString FEditBehaviorTreeTool::AddComposite(UBehaviorTree* BehaviorTree, const FCompositeDefinition& CompDef)
@@ -483,10 +483,11 @@ FString FEditBehaviorTreeTool::AddComposite(UBehaviorTree* BehaviorTree, const F
 			return TEXT("! Composite: Root already exists. Specify 'parent' to add as child.");
 		}
 		BehaviorTree->RootNode = NewNode;
+		IndexNode(NewNode, nullptr);
 	}
 	else
 	{
-		UBTCompositeNode* ParentNode = FindCompositeByName(BehaviorTree->RootNode, CompDef.Parent);
+		UBTCompositeNode* ParentNode = FindComposite(CompDef.Parent);
 		if (!ParentNode)
 		{
 			return FString::Printf(TEXT("! Composite: Parent '%s' not found"), *CompDef.Parent);
@@ -495,15 +496,8 @@ FString FEditBehaviorTreeTool::AddComposite(UBehaviorTree* BehaviorTree, const F
 		// Add as child
 		FBTCompositeChild NewChild;
 		NewChild.ChildComposite = NewNode;
-
-		if (CompDef.Index >= 0 && CompDef.Index < ParentNode->Children.Num())
-		{
-			ParentNode->Children.Insert(NewChild, CompDef.Index);
-		}
-		else
-		{
-			ParentNode->Children.Add(NewChild);
-		}
+		InsertChild(ParentNode, NewChild, CompDef.Index);
+		IndexNode(NewNode, ParentNode);
 	}
 
 	FString NodeName = CompDef.Name.IsEmpty() ? CompDef.Type : CompDef.Name;
@@ -529,7 +523,7 @@ FString FEditBehaviorTreeTool::AddTask(UBehaviorTree* BehaviorTree, const FTaskD
 	}
 
 	// Find parent
-	UBTCompositeNode* ParentNode = FindCompositeByName(BehaviorTree->RootNode, TaskDef.Parent);
+	UBTCompositeNode* ParentNode = FindComposite(TaskDef.Parent);
 	if (!ParentNode)
 	{
 		return FString::Printf(TEXT("! Task: Parent '%s' not found"), *TaskDef.Parent);
@@ -551,15 +545,8 @@ FString FEditBehaviorTreeTool::AddTask(UBehaviorTree* BehaviorTree, const FTaskD
 	// Add as child
 	FBTCompositeChild NewChild;
 	NewChild.ChildTask = NewTask;
-
-	if (TaskDef.Index >= 0 && TaskDef.Index < ParentNode->Children.Num())
-	{
-		ParentNode->Children.Insert(NewChild, TaskDef.Index);
-	}
-	else
-	{
-		ParentNode->Children.Add(NewChild);
-	}
+	InsertChild(ParentNode, NewChild, TaskDef.Index);
+	IndexNode(NewTask, ParentNode);
 
 	FString NodeName = TaskDef.Name.IsEmpty() ? TaskDef.Type : TaskDef.Name;
 	return FString::Printf(TEXT("+ Task: %s (%s) -> %s"), *NodeName, *TaskDef.Type, *TaskDef.Parent);
@@ -583,10 +570,8 @@ FString FEditBehaviorTreeTool::AddDecorator(UBehaviorTree* BehaviorTree, const F
 	}
 
 	// Find target - could be composite or task
-	UBTCompositeNode* TargetComposite = FindCompositeByName(BehaviorTree->RootNode, DecDef.Target);
-	UBTTaskNode* TargetTask = TargetComposite ? nullptr : FindTaskByName(BehaviorTree->RootNode, DecDef.Target);
-
-	if (!TargetComposite && !TargetTask)
+	UBTNode* TargetNode = FindNode(DecDef.Target);
+	if (!TargetNode)
 	{
 		return FString::Printf(TEXT("! Decorator: Target '%s' not found"), *DecDef.Target);
 	}
@@ -607,7 +592,7 @@ FString FEditBehaviorTreeTool::AddDecorator(UBehaviorTree* BehaviorTree, const F
 	// For root node, use BehaviorTree->RootDecorators
 	bool bAttached = false;
 
-	if (TargetComposite == BehaviorTree->RootNode)
+	if (TargetNode == BehaviorTree->RootNode)
 	{
 		// Target is root - add to root decorators
 		BehaviorTree->RootDecorators.Add(NewDecorator);
@@ -615,9 +600,8 @@ FString FEditBehaviorTreeTool::AddDecorator(UBehaviorTree* BehaviorTree, const F
 	}
 	else
 	{
-		// Find the parent and attach to the child edge
-		UBTNode* TargetNode = TargetComposite ? (UBTNode*)TargetComposite : (UBTNode*)TargetTask;
-		bAttached = AttachDecoratorToChildEdge(BehaviorTree->RootNode, TargetNode, NewDecorator);
+		// Attach to the child edge in the target's parent
+		bAttached = AttachDecoratorToChildEdge(TargetNode, NewDecorator);
 	}
 
 	if (!bAttached)
@@ -648,7 +632,7 @@ FString FEditBehaviorTreeTool::AddService(UBehaviorTree* BehaviorTree, const FSe
 	}
 
 	// Find target composite (services only attach to composites)
-	UBTCompositeNode* TargetComposite = FindCompositeByName(BehaviorTree->RootNode, SvcDef.Target);
+	UBTCompositeNode* TargetComposite = FindComposite(SvcDef.Target);
 	if (!TargetComposite)
 	{
 		return FString::Printf(TEXT("! Service: Target composite '%s' not found"), *SvcDef.Target);
@@ -674,25 +658,41 @@ FString FEditBehaviorTreeTool::AddService(UBehaviorTree* BehaviorTree, const FSe
 
 FString FEditBehaviorTreeTool::RemoveNode(UBehaviorTree* BehaviorTree, const FString& NodeName)
 {
-	// This is a simplified implementation - removing nodes from BTs is complex
-	// because of the parent-child relationships
-
 	if (!BehaviorTree->RootNode)
 	{
 		return FString::Printf(TEXT("! Remove: Tree is empty"));
 	}
 
+	UBTNode* Node = FindNode(NodeName);
+	if (!Node)
+	{
+		return FString::Printf(TEXT("! Remove: Node '%s' not found"), *NodeName);
+	}
+
 	// Check if removing root
-	if (BehaviorTree->RootNode->GetNodeName().Equals(NodeName, ESearchCase::IgnoreCase))
+	if (Node == BehaviorTree->RootNode)
 	{
 		BehaviorTree->RootNode = nullptr;
+		BehaviorTree->RootDecorators.Empty();
+		BuildNodeIndex(BehaviorTree);
 		return FString::Printf(TEXT("- Node: %s (was root)"), *NodeName);
 	}
 
-	// TODO: Implement recursive search and removal from parent's children array
-	// This requires finding the parent of the node to remove it from Children
+	// Drop the child edge (and its decorators) from the parent; a composite takes its subtree along
+	UBTCompositeNode* Parent = NodeParents.FindRef(Node);
+	const int32 RemovedEdges = Parent ? Parent->Children.RemoveAll([Node](const FBTCompositeChild& Child)
+	{
+		return Child.ChildComposite == Node || Child.ChildTask == Node;
+	}) : 0;
+
+	if (RemovedEdges == 0)
+	{
+		return FString::Printf(TEXT("! Remove: '%s' has no parent edge"), *NodeName);
+	}
 
-	return FString::Printf(TEXT("! Remove: Not implemented for non-root nodes yet"));
+	// Names hidden by the removed nodes become reachable again
+	BuildNodeIndex(BehaviorTree);
+	return FString::Printf(TEXT("- Node: %s (from %s)"), *NodeName, *Parent->GetNodeName());
 }
 
 FString FEditBehaviorTreeTool::SetBlackboard(UBehaviorTree* BehaviorTree, const FString& BlackboardName)
@@ -731,6 +731,182 @@ FString FEditBehaviorTreeTool::SetBlackboard(UBehaviorTree* BehaviorTree, const
 	return FString::Printf(TEXT("+ Blackboard: Set to %s"), *Blackboard->GetName());
 }
 
+int32 FEditBehaviorTreeTool::AddSubtree(UBehaviorTree* BehaviorTree, const TSharedPtr<FJsonObject>& Spec,
+	UBTCompositeNode* Parent, int32 Index, TArray<FString>& OutResults)
+{
+	FString Type, Name;
+	Spec->TryGetStringField(TEXT("type"), Type);
+	Spec->TryGetStringField(TEXT("name"), Name);
+	if (Type.IsEmpty())
+	{
+		OutResults.Add(TEXT("! Subtree: Missing type"));
+		return 0;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Children = nullptr;
+	Spec->TryGetArrayField(TEXT("children"), Children);
+
+	// Composite types take precedence, so "Sequence" never resolves to a task class
+	UClass* CompositeClass = FindCompositeClass(Type);
+	UClass* TaskClass = CompositeClass ? nullptr : FindTaskClass(Type);
+	if (!CompositeClass && !TaskClass)
+	{
+		OutResults.Add(FString::Printf(TEXT("! Subtree: Unknown type '%s'"), *Type));
+		return 0;
+	}
+	if (TaskClass && Children && Children->Num() > 0)
+	{
+		OutResults.Add(FString::Printf(TEXT("! Subtree: Task '%s' can't have children"), *Type));
+		return 0;
+	}
+	if (!Parent)
+	{
+		if (TaskClass)
+		{
+			OutResults.Add(TEXT("! Subtree: The root must be a composite. Specify 'parent' for a task."));
+			return 0;
+		}
+		if (BehaviorTree->RootNode)
+		{
+			OutResults.Add(TEXT("! Subtree: Root already exists. Specify 'parent' to add as child."));
+			return 0;
+		}
+	}
+
+	UBTNode* NewNode = NewObject<UBTNode>(BehaviorTree, CompositeClass ? CompositeClass : TaskClass);
+	if (!Name.IsEmpty())
+	{
+		NewNode->NodeName = Name;
+	}
+	UBTCompositeNode* NewComposite = Cast<UBTCompositeNode>(NewNode);
+
+	// Decorators live on the edge into the node (root decorators on the tree)
+	TArray<TObjectPtr<UBTDecorator>> Decorators;
+	TArray<FString> DecoratorResults;
+	const TArray<TSharedPtr<FJsonValue>>* DecoratorSpecs;
+	if (Spec->TryGetArrayField(TEXT("decorators"), DecoratorSpecs))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *DecoratorSpecs)
+		{
+			const TSharedPtr<FJsonObject>* DecObj;
+			FString DecType, DecName;
+			if (!Value->TryGetObject(DecObj) || !(*DecObj)->TryGetStringField(TEXT("type"), DecType))
+			{
+				continue;
+			}
+			(*DecObj)->TryGetStringField(TEXT("name"), DecName);
+
+			UClass* DecoratorClass = FindDecoratorClass(DecType);
+			if (!DecoratorClass)
+			{
+				DecoratorResults.Add(FString::Printf(TEXT("! Decorator: Unknown type '%s'"), *DecType));
+				continue;
+			}
+			UBTDecorator* Decorator = NewObject<UBTDecorator>(BehaviorTree, DecoratorClass);
+			if (!DecName.IsEmpty())
+			{
+				Decorator->NodeName = DecName;
+			}
+			Decorators.Add(Decorator);
+			DecoratorResults.Add(FString::Printf(TEXT("+ Decorator: %s (%s) -> %s"),
+				DecName.IsEmpty() ? *DecType : *DecName, *DecType, *NewNode->GetNodeName()));
+		}
+	}
+
+	if (Parent)
+	{
+		FBTCompositeChild NewChild;
+		NewChild.ChildComposite = NewComposite;
+		NewChild.ChildTask = Cast<UBTTaskNode>(NewNode);
+		NewChild.Decorators = Decorators;
+		InsertChild(Parent, NewChild, Index);
+	}
+	else
+	{
+		BehaviorTree->RootNode = NewComposite;
+		BehaviorTree->RootDecorators.Append(Decorators);
+	}
+	IndexNode(NewNode, Parent);
+
+	OutResults.Add(FString::Printf(TEXT("+ %s: %s (%s) -> %s"), NewComposite ? TEXT("Composite") : TEXT("Task"),
+		*NewNode->GetNodeName(), *Type, Parent ? *Parent->GetNodeName() : TEXT("(root)")));
+	OutResults.Append(DecoratorResults);
+	int32 AddedCount = 1 + Decorators.Num();
+
+	// Services only attach to composites
+	const TArray<TSharedPtr<FJsonValue>>* ServiceSpecs;
+	if (Spec->TryGetArrayField(TEXT("services"), ServiceSpecs))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *ServiceSpecs)
+		{
+			const TSharedPtr<FJsonObject>* SvcObj;
+			FString SvcType, SvcName;
+			if (!Value->TryGetObject(SvcObj) || !(*SvcObj)->TryGetStringField(TEXT("type"), SvcType))
+			{
+				continue;
+			}
+			(*SvcObj)->TryGetStringField(TEXT("name"), SvcName);
+
+			UClass* ServiceClass = NewComposite ? FindServiceClass(SvcType) : nullptr;
+			if (!ServiceClass)
+			{
+				OutResults.Add(NewComposite
+					? FString::Printf(TEXT("! Service: Unknown type '%s'"), *SvcType)
+					: FString::Printf(TEXT("! Service: '%s' is a task; services attach to composites"), *NewNode->GetNodeName()));
+				continue;
+			}
+			UBTService* Service = NewObject<UBTService>(BehaviorTree, ServiceClass);
+			if (!SvcName.IsEmpty())
+			{
+				Service->NodeName = SvcName;
+			}
+			NewComposite->Services.Add(Service);
+			OutResults.Add(FString::Printf(TEXT("+ Service: %s (%s) -> %s"),
+				SvcName.IsEmpty() ? *SvcType : *SvcName, *SvcType, *NewNode->GetNodeName()));
+			AddedCount++;
+		}
+	}
+
+	if (NewComposite && Children)
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *Children)
+		{
+			const TSharedPtr<FJsonObject>* ChildObj;
+			if (Value->TryGetObject(ChildObj))
+			{
+				AddedCount += AddSubtree(BehaviorTree, *ChildObj, NewComposite, -1, OutResults);
+			}
+		}
+	}
+
+	return AddedCount;
+}
+
+void FEditBehaviorTreeTool::RebuildTreeGraph(UBehaviorTree* BehaviorTree)
+{
+	// Trees never opened in the editor have no graph; it is spawned from the runtime tree on open
+	UBehaviorTreeGraph* BTGraph = Cast<UBehaviorTreeGraph>(BehaviorTree->BTGraph);
+	if (!BTGraph)
+	{
+		return;
+	}
+
+	// Otherwise the graph is the source of truth and would overwrite the edits on its next update:
+	// respawn it from the edited tree, then rebuild the runtime tree (execution indices etc.) from it
+	BTGraph->Modify();
+	for (int32 i = BTGraph->Nodes.Num() - 1; i >= 0; i--)
+	{
+		UEdGraphNode* GraphNode = BTGraph->Nodes[i];
+		if (GraphNode && !GraphNode->IsA<UBehaviorTreeGraphNode_Root>())
+		{
+			BTGraph->RemoveNode(GraphNode);
+		}
+	}
+	BTGraph->SpawnMissingNodes();
+	BTGraph->UpdateAsset();
+	BTGraph->NotifyGraphChanged();
+}
+
 // ========== Blackboard Key Operations ==========
 
 UClass* FEditBehaviorTreeTool::FindBlackboardKeyTypeClass(const FString& TypeName)
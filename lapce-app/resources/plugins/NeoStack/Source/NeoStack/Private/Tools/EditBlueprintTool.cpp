@@ -2,6 +2,8 @@
 
 #include "Tools/EditBlueprintTool.h"
 #include "Tools/NeoStackToolUtils.h"
+#include "Tools/AssetReadCache.h"
+#include "Tools/BlueprintCompileScheduler.h"
 #include "Json.h"
 
 // Blueprint editing
@@ -54,6 +56,8 @@
 #include "Editor.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "WidgetBlueprintEditor.h"
+#include "Tools/ConfigureAssetTool.h"
+#include "Tools/PropertyPathCache.h"
 
 // Animation Blueprint support
 #include "Animation/AnimBlueprint.h"
@@ -66,7 +70,38 @@
 #include "AnimationTransitionGraph.h"
 #include "AnimGraphNode_TransitionResult.h"
 #include "AnimationStateMachineSchema.h"
+#include "AnimGraphNode_Root.h"
+#include "AnimGraphNode_SequencePlayer.h"
+#include "AnimGraphNode_StateResult.h"
+#include "Animation/AnimSequenceBase.h"
+#include "AlphaBlend.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_CallFunction.h"
+#include "Kismet/KismetMathLibrary.h"
 #include "Kismet2/Kismet2NameValidators.h"
+#include "Tools/GraphLayoutIndex.h"
+
+namespace
+{
+	/** Distance between state columns and rows when placing a new state machine's states */
+	constexpr float StateColumnSpacing = 350.0f;
+	constexpr float StateRowSpacing = 150.0f;
+
+	/**
+	 * UEdGraph::AddNode without its per-node OnGraphChanged broadcast; every open editor of the
+	 * graph rebuilds on that, so a bulk build notifies once after all of its nodes are in
+	 */
+	void AddNodeQuiet(UEdGraph* Graph, UEdGraphNode* Node)
+	{
+		Graph->Nodes.Add(Node);
+		Node->SetFlags(RF_Transactional);
+	}
+}
+
+void FEditBlueprintTool::GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const
+{
+	NeoStackToolUtils::AddNamePathResource(Args, OutKeys);
+}
 
 FToolResult FEditBlueprintTool::Execute(const TSharedPtr<FJsonObject>& Args)
 {
@@ -97,6 +132,15 @@ FToolResult FEditBlueprintTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		return FToolResult::Fail(FString::Printf(TEXT("Blueprint not found: %s"), *FullAssetPath));
 	}
 
+	bool bBatch = true;
+	bool bCompile = false;
+	Args->TryGetBoolField(TEXT("batch"), bBatch);
+	Args->TryGetBoolField(TEXT("compile"), bCompile);
+
+	bDeferStructuralChanges = bBatch;
+	bStructureChangePending = false;
+	bWidgetTreeChanged = false;
+
 	TArray<FString> Results;
 	int32 AddedCount = 0;
 	int32 RemovedCount = 0;
@@ -307,55 +351,6 @@ FToolResult FEditBlueprintTool::Execute(const TSharedPtr<FJsonObject>& Args)
 	// Process widget operations (only for Widget Blueprints)
 	UWidgetBlueprint* WidgetBlueprint = Cast<UWidgetBlueprint>(Blueprint);
 
-	// Process list_events - discover available events on a component/widget
-	FString ListEventsSource;
-	if (Args->TryGetStringField(TEXT("list_events"), ListEventsSource) && !ListEventsSource.IsEmpty())
-	{
-		FString EventsOutput = ListEvents(Blueprint, ListEventsSource);
-		Results.Add(EventsOutput);
-	}
-
-	// Process bind_events
-	const TArray<TSharedPtr<FJsonValue>>* BindEvents;
-	if (Args->TryGetArrayField(TEXT("bind_events"), BindEvents))
-	{
-		for (const TSharedPtr<FJsonValue>& Value : *BindEvents)
-		{
-			const TSharedPtr<FJsonObject>* EventObj;
-			if (Value->TryGetObject(EventObj))
-			{
-				FEventBindingDef EventDef;
-				(*EventObj)->TryGetStringField(TEXT("source"), EventDef.Source);
-				(*EventObj)->TryGetStringField(TEXT("event"), EventDef.Event);
-				(*EventObj)->TryGetStringField(TEXT("handler"), EventDef.Handler);
-
-				FString Result = BindEvent(Blueprint, EventDef);
-				Results.Add(Result);
-				if (Result.StartsWith(TEXT("+"))) AddedCount++;
-			}
-		}
-	}
-
-	// Process unbind_events
-	const TArray<TSharedPtr<FJsonValue>>* UnbindEvents;
-	if (Args->TryGetArrayField(TEXT("unbind_events"), UnbindEvents))
-	{
-		for (const TSharedPtr<FJsonValue>& Value : *UnbindEvents)
-		{
-			const TSharedPtr<FJsonObject>* EventObj;
-			if (Value->TryGetObject(EventObj))
-			{
-				FString Source, Event;
-				(*EventObj)->TryGetStringField(TEXT("source"), Source);
-				(*EventObj)->TryGetStringField(TEXT("event"), Event);
-
-				FString Result = UnbindEvent(Blueprint, Source, Event);
-				Results.Add(Result);
-				if (Result.StartsWith(TEXT("-"))) RemovedCount++;
-			}
-		}
-	}
-
 	// Process add_widgets
 	const TArray<TSharedPtr<FJsonValue>>* AddWidgets;
 	if (Args->TryGetArrayField(TEXT("add_widgets"), AddWidgets))
@@ -384,6 +379,41 @@ FToolResult FEditBlueprintTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		}
 	}
 
+	// Process widget_tree - whole subtrees built in one pass, bindings run after the flush below
+	TArray<FEventBindingDef> TreeBindings;
+	const TSharedPtr<FJsonObject>* WidgetTreeObj;
+	TArray<TSharedPtr<FJsonValue>> WidgetTreeSpecs;
+	if (Args->TryGetObjectField(TEXT("widget_tree"), WidgetTreeObj))
+	{
+		WidgetTreeSpecs.Add(MakeShared<FJsonValueObject>(*WidgetTreeObj));
+	}
+	else
+	{
+		const TArray<TSharedPtr<FJsonValue>>* WidgetTreeArray;
+		if (Args->TryGetArrayField(TEXT("widget_tree"), WidgetTreeArray))
+		{
+			WidgetTreeSpecs = *WidgetTreeArray;
+		}
+	}
+	if (WidgetTreeSpecs.Num() > 0)
+	{
+		if (!WidgetBlueprint)
+		{
+			Results.Add(TEXT("! WidgetTree: Not a Widget Blueprint"));
+		}
+		else
+		{
+			for (const TSharedPtr<FJsonValue>& Value : WidgetTreeSpecs)
+			{
+				const TSharedPtr<FJsonObject>* SpecObj;
+				if (Value->TryGetObject(SpecObj))
+				{
+					Results.Add(BuildWidgetTree(WidgetBlueprint, ParseWidgetTreeSpec(*SpecObj), Results, TreeBindings, AddedCount));
+				}
+			}
+		}
+	}
+
 	// Process remove_widgets
 	const TArray<TSharedPtr<FJsonValue>>* RemoveWidgets;
 	if (Args->TryGetArrayField(TEXT("remove_widgets"), RemoveWidgets))
@@ -407,6 +437,72 @@ FToolResult FEditBlueprintTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		}
 	}
 
+	// Event bindings and transition rules look members up on the skeleton class, so it must
+	// include the batch's adds
+	if (bStructureChangePending && (Args->HasField(TEXT("bind_events")) || Args->HasField(TEXT("list_events")) ||
+		Args->HasField(TEXT("state_machines")) || TreeBindings.Num() > 0))
+	{
+		FBlueprintCompileScheduler::Get().MarkStructurallyModified(Blueprint);
+		FBlueprintCompileScheduler::Get().FlushBlueprint(Blueprint);
+		bStructureChangePending = false;
+	}
+
+	for (const FEventBindingDef& Binding : TreeBindings)
+	{
+		FString Result = BindWidgetEvent(WidgetBlueprint, Binding);
+		Results.Add(Result);
+		if (Result.StartsWith(TEXT("+"))) AddedCount++;
+	}
+
+	// Process list_events - discover available events on a component/widget
+	FString ListEventsSource;
+	if (Args->TryGetStringField(TEXT("list_events"), ListEventsSource) && !ListEventsSource.IsEmpty())
+	{
+		FString EventsOutput = ListEvents(Blueprint, ListEventsSource);
+		Results.Add(EventsOutput);
+	}
+
+	// Process bind_events
+	const TArray<TSharedPtr<FJsonValue>>* BindEvents;
+	if (Args->TryGetArrayField(TEXT("bind_events"), BindEvents))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *BindEvents)
+		{
+			const TSharedPtr<FJsonObject>* EventObj;
+			if (Value->TryGetObject(EventObj))
+			{
+				FEventBindingDef EventDef;
+				(*EventObj)->TryGetStringField(TEXT("source"), EventDef.Source);
+				(*EventObj)->TryGetStringField(TEXT("event"), EventDef.Event);
+				(*EventObj)->TryGetStringField(TEXT("handler"), EventDef.Handler);
+
+				FString Result = BindEvent(Blueprint, EventDef);
+				Results.Add(Result);
+				if (Result.StartsWith(TEXT("+"))) AddedCount++;
+			}
+		}
+	}
+
+	// Process unbind_events
+	const TArray<TSharedPtr<FJsonValue>>* UnbindEvents;
+	if (Args->TryGetArrayField(TEXT("unbind_events"), UnbindEvents))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *UnbindEvents)
+		{
+			const TSharedPtr<FJsonObject>* EventObj;
+			if (Value->TryGetObject(EventObj))
+			{
+				FString Source, Event;
+				(*EventObj)->TryGetStringField(TEXT("source"), Source);
+				(*EventObj)->TryGetStringField(TEXT("event"), Event);
+
+				FString Result = UnbindEvent(Blueprint, Source, Event);
+				Results.Add(Result);
+				if (Result.StartsWith(TEXT("-"))) RemovedCount++;
+			}
+		}
+	}
+
 	// Animation Blueprint operations
 	UAnimBlueprint* AnimBlueprint = Cast<UAnimBlueprint>(Blueprint);
 
@@ -491,9 +587,44 @@ FToolResult FEditBlueprintTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		}
 	}
 
-	// Mark dirty and compile
+	// Process state_machines - whole machines built in one pass each
+	const TArray<TSharedPtr<FJsonValue>>* StateMachineSpecs;
+	if (Args->TryGetArrayField(TEXT("state_machines"), StateMachineSpecs))
+	{
+		if (!AnimBlueprint)
+		{
+			Results.Add(TEXT("! StateMachine: Not an Animation Blueprint"));
+		}
+		else
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *StateMachineSpecs)
+			{
+				const TSharedPtr<FJsonObject>* SpecObj;
+				if (Value->TryGetObject(SpecObj))
+				{
+					FString Result = BuildStateMachine(AnimBlueprint, ParseStateMachineSpec(*SpecObj), Results);
+					Results.Add(Result);
+					if (Result.StartsWith(TEXT("+"))) AddedCount++;
+				}
+			}
+		}
+	}
+
+	// Mark dirty; the skeleton update and compile run once the batch of tool calls is over
 	Blueprint->Modify();
-	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+	FBlueprintCompileScheduler::Get().MarkStructurallyModified(Blueprint);
+	FAssetReadCache::Get().Invalidate(Blueprint);
+
+	if (bWidgetTreeChanged)
+	{
+		RefreshWidgetEditor(WidgetBlueprint);
+	}
+	bDeferStructuralChanges = false;
+
+	if (bCompile)
+	{
+		FBlueprintCompileScheduler::Get().RequestCompile(Blueprint, &FEditBlueprintTool::AnnotateCompileReport);
+	}
 
 	// Build output
 	FString Output = FString::Printf(TEXT("# EDIT %s at %s\n"), *Name, *Path);
@@ -819,7 +950,9 @@ FString FEditBlueprintTool::AddVariable(UBlueprint* Blueprint, const FVariableDe
 	FEdGraphPinType PinType = TypeDefinitionToPinType(VarDef.Type);
 
 	// Add the variable
-	bool bSuccess = FBlueprintEditorUtils::AddMemberVariable(Blueprint, VarName, PinType);
+	bool bSuccess = bDeferStructuralChanges
+		? AddMemberVariableDeferred(Blueprint, VarName, PinType, VarDef.Default)
+		: FBlueprintEditorUtils::AddMemberVariable(Blueprint, VarName, PinType);
 	if (!bSuccess)
 	{
 		return FString::Printf(TEXT("! Variable: Failed to add %s"), *VarDef.Name);
@@ -864,8 +997,8 @@ FString FEditBlueprintTool::AddVariable(UBlueprint* Blueprint, const FVariableDe
 		}
 	}
 
-	// Set default value if provided
-	if (!VarDef.Default.IsEmpty())
+	// Set default value if provided (deferred adds carry it on the description)
+	if (!VarDef.Default.IsEmpty() && !bDeferStructuralChanges)
 	{
 		SetVariableDefaultValue(Blueprint, VarDef.Name, VarDef.Default);
 	}
@@ -928,6 +1061,107 @@ void FEditBlueprintTool::SetVariableDefaultValue(UBlueprint* Blueprint, const FS
 	Property->ImportText_Direct(*DefaultValue, Property->ContainerPtrToValuePtr<void>(CDO), CDO, PPF_None);
 }
 
+bool FEditBlueprintTool::AddMemberVariableDeferred(UBlueprint* Blueprint, FName VarName, const FEdGraphPinType& PinType, const FString& DefaultValue)
+{
+	FKismetNameValidator Validator(Blueprint);
+	if (Validator.IsValid(VarName) != EValidatorResult::Ok)
+	{
+		return false;
+	}
+
+	Blueprint->Modify();
+
+	// Same description FBlueprintEditorUtils::AddMemberVariable builds
+	FBPVariableDescription NewVar;
+	NewVar.VarName = VarName;
+	NewVar.VarGuid = FGuid::NewGuid();
+	NewVar.FriendlyName = FName::NameToDisplayString(VarName.ToString(), PinType.PinCategory == UEdGraphSchema_K2::PC_Boolean);
+	NewVar.VarType = PinType;
+	NewVar.PropertyFlags |= (CPF_Edit | CPF_BlueprintVisible | CPF_DisableEditOnInstance);
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_MCDelegate)
+	{
+		NewVar.PropertyFlags |= CPF_BlueprintAssignable | CPF_BlueprintCallable;
+	}
+	NewVar.ReplicationCondition = COND_None;
+	NewVar.Category = UEdGraphSchema_K2::VR_DefaultCategory;
+	NewVar.DefaultValue = DefaultValue;
+	Blueprint->NewVariables.Add(NewVar);
+
+	FBlueprintEditorUtils::ValidateBlueprintChildVariables(Blueprint, VarName);
+	bStructureChangePending = true;
+	return true;
+}
+
+void FEditBlueprintTool::AnnotateCompileReport(const FBlueprintCompileReport& Report, FString& InOutOutput)
+{
+	TArray<FString> Results;
+	InOutOutput.ParseIntoArrayLines(Results);
+
+	// Item names from "+ Kind: Name ..." / "- Kind: Name" lines
+	TArray<FString> ItemNames;
+	ItemNames.SetNum(Results.Num());
+	for (int32 i = 0; i < Results.Num(); i++)
+	{
+		const FString& Line = Results[i];
+		int32 Colon = INDEX_NONE;
+		if ((Line.StartsWith(TEXT("+ ")) || Line.StartsWith(TEXT("- "))) && Line.FindChar(TEXT(':'), Colon))
+		{
+			FString ItemName = Line.Mid(Colon + 1).TrimStart();
+			int32 End = 0;
+			while (End < ItemName.Len() && (FChar::IsAlnum(ItemName[End]) || ItemName[End] == TEXT('_')))
+			{
+				End++;
+			}
+			ItemNames[i] = ItemName.Left(End);
+		}
+	}
+
+	TMap<int32, TArray<FString>> ItemMessages;
+	TArray<FString> UnattributedMessages;
+	for (const FString& Text : Report.Messages)
+	{
+		int32 Owner = INDEX_NONE;
+		for (int32 i = 0; i < ItemNames.Num() && Owner == INDEX_NONE; i++)
+		{
+			if (!ItemNames[i].IsEmpty() && Text.Contains(ItemNames[i]))
+			{
+				Owner = i;
+			}
+		}
+
+		if (Owner != INDEX_NONE)
+		{
+			ItemMessages.FindOrAdd(Owner).Add(Text);
+		}
+		else
+		{
+			UnattributedMessages.Add(Text);
+		}
+	}
+
+	// Rebuild with each item's messages under it
+	TArray<FString> Annotated;
+	Annotated.Reserve(Results.Num() + Report.Messages.Num() + 1);
+	for (int32 i = 0; i < Results.Num(); i++)
+	{
+		Annotated.Add(Results[i]);
+		if (const TArray<FString>* Messages = ItemMessages.Find(i))
+		{
+			for (const FString& Text : *Messages)
+			{
+				Annotated.Add(TEXT("  ! ") + Text);
+			}
+		}
+	}
+	for (const FString& Text : UnattributedMessages)
+	{
+		Annotated.Add(TEXT("! Compile ") + Text);
+	}
+	Annotated.Add(FString::Printf(TEXT("= compiled: %d errors, %d warnings"), Report.NumErrors, Report.NumWarnings));
+
+	InOutOutput = FString::Join(Annotated, TEXT("\n")) + TEXT("\n");
+}
+
 FString FEditBlueprintTool::AddComponent(UBlueprint* Blueprint, const FComponentDefinition& CompDef)
 {
 	if (CompDef.Name.IsEmpty() || CompDef.Class.IsEmpty())
@@ -1002,6 +1236,9 @@ FString FEditBlueprintTool::AddComponent(UBlueprint* Blueprint, const FComponent
 		}
 	}
 
+	// New component variables reach the skeleton class with the batch's structural update
+	bStructureChangePending |= bDeferStructuralChanges;
+
 	FString ParentStr = CompDef.Parent.IsEmpty() ? TEXT("Root") : CompDef.Parent;
 	return FString::Printf(TEXT("+ Component: %s (%s) -> %s"), *CompDef.Name, *CompDef.Class, *ParentStr);
 }
@@ -1093,7 +1330,18 @@ FString FEditBlueprintTool::AddFunction(UBlueprint* Blueprint, const FFunctionDe
 		return FString::Printf(TEXT("! Function: Failed to create %s"), *FuncDef.Name);
 	}
 
-	FBlueprintEditorUtils::AddFunctionGraph(Blueprint, NewGraph, false, static_cast<UFunction*>(nullptr));
+	if (bDeferStructuralChanges)
+	{
+		// AddFunctionGraph minus its structural-modification recompile
+		GetDefault<UEdGraphSchema_K2>()->CreateFunctionGraphTerminators(*NewGraph, static_cast<UFunction*>(nullptr));
+		Blueprint->FunctionGraphs.Add(NewGraph);
+		FBlueprintEditorUtils::ValidateBlueprintChildVariables(Blueprint, NewGraph->GetFName());
+		bStructureChangePending = true;
+	}
+	else
+	{
+		FBlueprintEditorUtils::AddFunctionGraph(Blueprint, NewGraph, false, static_cast<UFunction*>(nullptr));
+	}
 
 	// Find the entry node and set up parameters
 	UK2Node_FunctionEntry* EntryNode = nullptr;
@@ -1185,7 +1433,9 @@ FString FEditBlueprintTool::AddEvent(UBlueprint* Blueprint, const FEventDefiniti
 	PinType.PinSubCategoryObject = nullptr;
 
 	// Add as variable
-	bool bSuccess = FBlueprintEditorUtils::AddMemberVariable(Blueprint, EventName, PinType);
+	bool bSuccess = bDeferStructuralChanges
+		? AddMemberVariableDeferred(Blueprint, EventName, PinType, FString())
+		: FBlueprintEditorUtils::AddMemberVariable(Blueprint, EventName, PinType);
 	if (!bSuccess)
 	{
 		return FString::Printf(TEXT("! Event: Failed to add %s"), *EventDef.Name);
@@ -1373,61 +1623,359 @@ FString FEditBlueprintTool::AddWidget(UWidgetBlueprint* WidgetBlueprint, const F
 	// Mark as modified
 	WidgetBlueprint->Modify();
 
-	// Refresh editor if open
-	RefreshWidgetEditor(WidgetBlueprint);
+	// Refresh editor if open (once at the end when batching)
+	if (bDeferStructuralChanges)
+	{
+		bWidgetTreeChanged = true;
+		bStructureChangePending = true;
+	}
+	else
+	{
+		RefreshWidgetEditor(WidgetBlueprint);
+	}
 
 	FString ParentStr = WidgetDef.Parent.IsEmpty() ? TEXT("Root") : WidgetDef.Parent;
 	return FString::Printf(TEXT("+ Widget: %s (%s) -> %s"), *WidgetDef.Name, *WidgetDef.Type, *ParentStr);
 }
 
-FString FEditBlueprintTool::RemoveWidget(UWidgetBlueprint* WidgetBlueprint, const FString& WidgetName)
+FEditBlueprintTool::FWidgetTreeSpec FEditBlueprintTool::ParseWidgetTreeSpec(const TSharedPtr<FJsonObject>& SpecObj)
 {
-	if (!WidgetBlueprint->WidgetTree)
+	FWidgetTreeSpec Spec;
+	SpecObj->TryGetStringField(TEXT("type"), Spec.Type);
+	SpecObj->TryGetStringField(TEXT("name"), Spec.Name);
+	SpecObj->TryGetStringField(TEXT("parent"), Spec.Parent);
+
+	const TSharedPtr<FJsonObject>* SlotObj;
+	if (SpecObj->TryGetObjectField(TEXT("slot"), SlotObj))
 	{
-		return FString::Printf(TEXT("! Widget: %s not found (no widget tree)"), *WidgetName);
+		Spec.Slot = *SlotObj;
 	}
 
-	UWidgetTree* WidgetTree = WidgetBlueprint->WidgetTree;
-	UWidget* Widget = FindWidgetByName(WidgetTree, WidgetName);
-
-	if (!Widget)
+	const TSharedPtr<FJsonObject>* PropertiesObj;
+	if (SpecObj->TryGetObjectField(TEXT("properties"), PropertiesObj))
 	{
-		return FString::Printf(TEXT("! Widget: %s not found"), *WidgetName);
+		Spec.Properties = *PropertiesObj;
 	}
 
-	// Don't allow removing root if it has children
-	if (Widget == WidgetTree->RootWidget)
+	// An event is a delegate name or an object with "event"
+	const TArray<TSharedPtr<FJsonValue>>* Events;
+	if (SpecObj->TryGetArrayField(TEXT("events"), Events))
 	{
-		if (UPanelWidget* Panel = Cast<UPanelWidget>(Widget))
+		for (const TSharedPtr<FJsonValue>& Value : *Events)
 		{
-			if (Panel->GetChildrenCount() > 0)
+			FString EventName;
+			const TSharedPtr<FJsonObject>* EventObj;
+			if (Value->TryGetObject(EventObj))
 			{
-				return FString::Printf(TEXT("! Widget: Cannot remove root %s - has children"), *WidgetName);
+				(*EventObj)->TryGetStringField(TEXT("event"), EventName);
+			}
+			else
+			{
+				Value->TryGetString(EventName);
+			}
+			if (!EventName.IsEmpty())
+			{
+				Spec.Events.Add(EventName);
 			}
 		}
-		WidgetTree->RootWidget = nullptr;
 	}
-	else
+
+	const TArray<TSharedPtr<FJsonValue>>* Children;
+	if (SpecObj->TryGetArrayField(TEXT("children"), Children))
 	{
-		// Remove from parent
-		WidgetTree->RemoveWidget(Widget);
+		for (const TSharedPtr<FJsonValue>& Value : *Children)
+		{
+			const TSharedPtr<FJsonObject>* ChildObj;
+			if (Value->TryGetObject(ChildObj))
+			{
+				Spec.Children.Add(ParseWidgetTreeSpec(*ChildObj));
+			}
+		}
 	}
 
-	// Mark as modified
-	WidgetBlueprint->Modify();
-
-	// Refresh editor if open
-	RefreshWidgetEditor(WidgetBlueprint);
-
-	return FString::Printf(TEXT("- Widget: %s"), *WidgetName);
+	return Spec;
 }
 
-void FEditBlueprintTool::RefreshWidgetEditor(UWidgetBlueprint* WidgetBlueprint)
+FString FEditBlueprintTool::BuildWidgetTree(UWidgetBlueprint* WidgetBlueprint, const FWidgetTreeSpec& Spec, TArray<FString>& OutResults,
+	TArray<FEventBindingDef>& OutBindings, int32& OutAddedCount)
 {
-	if (!GEditor) return;
+	if (!WidgetBlueprint->WidgetTree)
+	{
+		WidgetBlueprint->WidgetTree = NewObject<UWidgetTree>(WidgetBlueprint, UWidgetTree::StaticClass(), NAME_None, RF_Transactional);
+	}
 
-	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-	if (!AssetEditorSubsystem) return;
+	UWidgetTree* WidgetTree = WidgetBlueprint->WidgetTree;
+	WidgetBlueprint->Modify();
+	WidgetTree->Modify();
+
+	// Same parent rules as add_widgets: a named panel, else the root, else the subtree becomes the root
+	UPanelWidget* ParentPanel = nullptr;
+	if (!Spec.Parent.IsEmpty())
+	{
+		UWidget* ParentWidget = FindWidgetByName(WidgetTree, Spec.Parent);
+		if (!ParentWidget)
+		{
+			return FString::Printf(TEXT("! WidgetTree: Parent not found: %s"), *Spec.Parent);
+		}
+		ParentPanel = Cast<UPanelWidget>(ParentWidget);
+		if (!ParentPanel)
+		{
+			return FString::Printf(TEXT("! WidgetTree: Parent %s is not a panel widget"), *Spec.Parent);
+		}
+	}
+	else if (WidgetTree->RootWidget)
+	{
+		ParentPanel = Cast<UPanelWidget>(WidgetTree->RootWidget);
+		if (!ParentPanel)
+		{
+			return TEXT("! WidgetTree: Root widget is not a panel, cannot add children");
+		}
+	}
+
+	// Names in the tree, collected once rather than searching the tree per new widget
+	TSet<FName> UsedNames;
+	WidgetTree->ForEachWidget([&UsedNames](UWidget* Widget)
+	{
+		UsedNames.Add(Widget->GetFName());
+	});
+
+	int32 WidgetCount = 0;
+	UWidget* SubtreeRoot = ConstructWidgetSubtree(WidgetTree, ParentPanel, Spec, UsedNames, OutResults, OutBindings, WidgetCount);
+	if (!SubtreeRoot)
+	{
+		return FString::Printf(TEXT("! WidgetTree: %s not created"), Spec.Name.IsEmpty() ? *Spec.Type : *Spec.Name);
+	}
+
+	OutAddedCount += WidgetCount;
+
+	// New widgets become members of the generated class; the designer refreshes once at the end
+	bWidgetTreeChanged = true;
+	bStructureChangePending = true;
+
+	const FString ParentStr = ParentPanel ? ParentPanel->GetName() : TEXT("Root");
+	return FString::Printf(TEXT("+ WidgetTree: %s (%s) -> %s, %d widgets"),
+		*SubtreeRoot->GetName(), *SubtreeRoot->GetClass()->GetName(), *ParentStr, WidgetCount);
+}
+
+UWidget* FEditBlueprintTool::ConstructWidgetSubtree(UWidgetTree* WidgetTree, UPanelWidget* ParentPanel, const FWidgetTreeSpec& Spec,
+	TSet<FName>& UsedNames, TArray<FString>& OutResults, TArray<FEventBindingDef>& OutBindings, int32& OutAddedCount)
+{
+	const FString Label = Spec.Name.IsEmpty() ? Spec.Type : Spec.Name;
+	if (Spec.Type.IsEmpty())
+	{
+		OutResults.Add(FString::Printf(TEXT("! Widget: Missing type for %s"), Spec.Name.IsEmpty() ? TEXT("unnamed widget") : *Spec.Name));
+		return nullptr;
+	}
+
+	if (!Spec.Name.IsEmpty() && UsedNames.Contains(FName(*Spec.Name)))
+	{
+		OutResults.Add(FString::Printf(TEXT("! Widget: %s already exists"), *Spec.Name));
+		return nullptr;
+	}
+
+	UClass* WidgetClass = FindWidgetClass(Spec.Type);
+	if (!WidgetClass)
+	{
+		OutResults.Add(FString::Printf(TEXT("! Widget: Unknown type %s"), *Spec.Type));
+		return nullptr;
+	}
+
+	UWidget* NewWidget = WidgetTree->ConstructWidget<UWidget>(WidgetClass, Spec.Name.IsEmpty() ? NAME_None : FName(*Spec.Name));
+	if (!NewWidget)
+	{
+		OutResults.Add(FString::Printf(TEXT("! Widget: Failed to create %s"), *Label));
+		return nullptr;
+	}
+
+	if (ParentPanel)
+	{
+		// Content widgets (Button, Border, SizeBox) take a single child
+		if (!ParentPanel->AddChild(NewWidget))
+		{
+			OutResults.Add(FString::Printf(TEXT("! Widget: %s cannot take another child (%s)"), *ParentPanel->GetName(), *Label));
+			NewWidget->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors);
+			return nullptr;
+		}
+	}
+	else
+	{
+		WidgetTree->RootWidget = NewWidget;
+	}
+
+	UsedNames.Add(NewWidget->GetFName());
+	OutAddedCount++;
+
+	if (Spec.Properties.IsValid())
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Property : Spec.Properties->Values)
+		{
+			const FString Error = SetWidgetProperty(NewWidget, Property.Key, Property.Value);
+			if (!Error.IsEmpty())
+			{
+				OutResults.Add(FString::Printf(TEXT("! Widget: %s.%s: %s"), *NewWidget->GetName(), *Property.Key, *Error));
+			}
+		}
+	}
+
+	if (Spec.Slot.IsValid())
+	{
+		if (NewWidget->Slot)
+		{
+			// Only failures are worth a line; applied settings show up when the tree is read
+			FString SlotLog;
+			FConfigureAssetTool::ApplySlotConfig(NewWidget->Slot, Spec.Slot, SlotLog);
+			TArray<FString> SlotLines;
+			SlotLog.ParseIntoArrayLines(SlotLines);
+			for (const FString& Line : SlotLines)
+			{
+				if (Line.StartsWith(TEXT("!")))
+				{
+					OutResults.Add(FString::Printf(TEXT("! Widget: %s slot: %s"), *NewWidget->GetName(), *Line.Mid(2)));
+				}
+			}
+		}
+		else
+		{
+			OutResults.Add(FString::Printf(TEXT("! Widget: %s has no slot (it is the root)"), *NewWidget->GetName()));
+		}
+	}
+
+	if (Spec.Events.Num() > 0)
+	{
+		// Bound events need the widget as a member variable
+		NewWidget->bIsVariable = true;
+		for (const FString& EventName : Spec.Events)
+		{
+			FEventBindingDef Binding;
+			Binding.Source = NewWidget->GetName();
+			Binding.Event = EventName;
+			OutBindings.Add(Binding);
+		}
+	}
+
+	if (Spec.Children.Num() > 0)
+	{
+		UPanelWidget* Panel = Cast<UPanelWidget>(NewWidget);
+		if (!Panel)
+		{
+			OutResults.Add(FString::Printf(TEXT("! Widget: %s is not a panel, %d children skipped"), *NewWidget->GetName(), Spec.Children.Num()));
+		}
+		else
+		{
+			for (const FWidgetTreeSpec& Child : Spec.Children)
+			{
+				ConstructWidgetSubtree(WidgetTree, Panel, Child, UsedNames, OutResults, OutBindings, OutAddedCount);
+			}
+		}
+	}
+
+	return NewWidget;
+}
+
+FString FEditBlueprintTool::SetWidgetProperty(UWidget* Widget, const FString& PropertyPath, const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		return TEXT("missing value");
+	}
+
+	FResolvedPropertyPath ResolvedPath;
+	FString Error;
+	if (!FPropertyPathCache::Get().Resolve(Widget->GetClass(), PropertyPath, ResolvedPath, Error))
+	{
+		return Error;
+	}
+
+	void* ValuePtr = ResolvedPath.GetValuePtr(Widget);
+	if (!ValuePtr)
+	{
+		return TEXT("array index out of range");
+	}
+
+	// Everything goes through ImportText, so values use configure_asset's text format
+	FString Text;
+	switch (Value->Type)
+	{
+	case EJson::Boolean:
+		Text = Value->AsBool() ? TEXT("True") : TEXT("False");
+		break;
+	case EJson::Number:
+	{
+		// Whole numbers without a fraction so integer properties accept them
+		const double Number = Value->AsNumber();
+		Text = Number == FMath::RoundToDouble(Number) ? FString::Printf(TEXT("%lld"), static_cast<int64>(Number)) : FString::SanitizeFloat(Number);
+		break;
+	}
+	case EJson::String:
+		Text = Value->AsString();
+		break;
+	default:
+		return TEXT("value must be a string, number or boolean");
+	}
+
+	FProperty* Property = ResolvedPath.GetLeafProperty();
+	if (!Property->ImportText_Direct(*Text, ValuePtr, Widget, PPF_None))
+	{
+		return FString::Printf(TEXT("could not set '%s'"), *Text);
+	}
+	return FString();
+}
+
+FString FEditBlueprintTool::RemoveWidget(UWidgetBlueprint* WidgetBlueprint, const FString& WidgetName)
+{
+	if (!WidgetBlueprint->WidgetTree)
+	{
+		return FString::Printf(TEXT("! Widget: %s not found (no widget tree)"), *WidgetName);
+	}
+
+	UWidgetTree* WidgetTree = WidgetBlueprint->WidgetTree;
+	UWidget* Widget = FindWidgetByName(WidgetTree, WidgetName);
+
+	if (!Widget)
+	{
+		return FString::Printf(TEXT("! Widget: %s not found"), *WidgetName);
+	}
+
+	// Don't allow removing root if it has children
+	if (Widget == WidgetTree->RootWidget)
+	{
+		if (UPanelWidget* Panel = Cast<UPanelWidget>(Widget))
+		{
+			if (Panel->GetChildrenCount() > 0)
+			{
+				return FString::Printf(TEXT("! Widget: Cannot remove root %s - has children"), *WidgetName);
+			}
+		}
+		WidgetTree->RootWidget = nullptr;
+	}
+	else
+	{
+		// Remove from parent
+		WidgetTree->RemoveWidget(Widget);
+	}
+
+	// Mark as modified
+	WidgetBlueprint->Modify();
+
+	// Refresh editor if open (once at the end when batching)
+	if (bDeferStructuralChanges)
+	{
+		bWidgetTreeChanged = true;
+	}
+	else
+	{
+		RefreshWidgetEditor(WidgetBlueprint);
+	}
+
+	return FString::Printf(TEXT("- Widget: %s"), *WidgetName);
+}
+
+void FEditBlueprintTool::RefreshWidgetEditor(UWidgetBlueprint* WidgetBlueprint)
+{
+	if (!GEditor) return;
+
+	UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+	if (!AssetEditorSubsystem) return;
 
 	IAssetEditorInstance* EditorInstance = AssetEditorSubsystem->FindEditorForAsset(WidgetBlueprint, false);
 	if (!EditorInstance) return;
@@ -1803,7 +2351,7 @@ FString FEditBlueprintTool::UnbindEvent(UBlueprint* Blueprint, const FString& So
 				{
 					Graph->RemoveNode(BoundEvent);
 					Blueprint->Modify();
-					FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+					FBlueprintCompileScheduler::Get().MarkStructurallyModified(Blueprint);
 					return FString::Printf(TEXT("- Removed event: %s.%s"), *Source, *Event);
 				}
 			}
@@ -2246,3 +2794,526 @@ FString FEditBlueprintTool::AddStateTransition(UAnimBlueprint* AnimBlueprint, co
 
 	return Output;
 }
+
+// =============================================================================
+// Bulk State Machine Construction
+// =============================================================================
+
+FEditBlueprintTool::FStateMachineSpec FEditBlueprintTool::ParseStateMachineSpec(const TSharedPtr<FJsonObject>& SpecObj)
+{
+	FStateMachineSpec Spec;
+	SpecObj->TryGetStringField(TEXT("name"), Spec.Name);
+	SpecObj->TryGetStringField(TEXT("entry"), Spec.Entry);
+	SpecObj->TryGetBoolField(TEXT("connect_output"), Spec.bConnectOutput);
+
+	const TArray<TSharedPtr<FJsonValue>>* States;
+	if (SpecObj->TryGetArrayField(TEXT("states"), States))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *States)
+		{
+			// A state is either a bare name or an object with an animation
+			FStateSpec State;
+			const TSharedPtr<FJsonObject>* StateObj;
+			if (Value->TryGetObject(StateObj))
+			{
+				(*StateObj)->TryGetStringField(TEXT("name"), State.Name);
+				(*StateObj)->TryGetStringField(TEXT("animation"), State.Animation);
+			}
+			else
+			{
+				Value->TryGetString(State.Name);
+			}
+			Spec.States.Add(State);
+		}
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Transitions;
+	if (SpecObj->TryGetArrayField(TEXT("transitions"), Transitions))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *Transitions)
+		{
+			const TSharedPtr<FJsonObject>* TransObj;
+			if (!Value->TryGetObject(TransObj))
+			{
+				continue;
+			}
+
+			FTransitionSpec Trans;
+			(*TransObj)->TryGetStringField(TEXT("from"), Trans.From);
+			(*TransObj)->TryGetStringField(TEXT("to"), Trans.To);
+			(*TransObj)->TryGetStringField(TEXT("rule"), Trans.Rule);
+			(*TransObj)->TryGetStringField(TEXT("blend_mode"), Trans.BlendMode);
+			(*TransObj)->TryGetStringField(TEXT("blend_logic"), Trans.BlendLogic);
+			(*TransObj)->TryGetBoolField(TEXT("bidirectional"), Trans.bBidirectional);
+
+			double BlendTime = 0.0;
+			if ((*TransObj)->TryGetNumberField(TEXT("blend_time"), BlendTime))
+			{
+				Trans.BlendTime = BlendTime;
+			}
+			int32 Priority = 0;
+			if ((*TransObj)->TryGetNumberField(TEXT("priority"), Priority))
+			{
+				Trans.Priority = Priority;
+			}
+			Spec.Transitions.Add(Trans);
+		}
+	}
+
+	return Spec;
+}
+
+FString FEditBlueprintTool::BuildStateMachine(UAnimBlueprint* AnimBlueprint, const FStateMachineSpec& Spec, TArray<FString>& OutResults)
+{
+	if (Spec.Name.IsEmpty())
+	{
+		return TEXT("! StateMachine: Missing name");
+	}
+
+	UEdGraph* AnimGraph = FindAnimGraph(AnimBlueprint);
+	if (!AnimGraph)
+	{
+		return TEXT("! StateMachine: AnimGraph not found. Open the Animation Blueprint in the editor first.");
+	}
+
+	AnimGraph->Modify();
+
+	// Extend an existing machine, or create the node; it joins the AnimGraph once it is complete
+	UAnimGraphNode_StateMachine* SMNode = FindStateMachineNode(AnimBlueprint, Spec.Name);
+	const bool bNewMachine = SMNode == nullptr;
+	if (bNewMachine)
+	{
+		SMNode = NewObject<UAnimGraphNode_StateMachine>(AnimGraph, NAME_None, RF_Transactional);
+		SMNode->CreateNewGuid();
+		SMNode->PostPlacedNewNode();
+		SMNode->AllocateDefaultPins();
+
+		// PostPlacedNewNode made the graph with a suggested name; the machine is named by its graph
+		SMNode->EditorStateMachineGraph->Rename(*Spec.Name, nullptr, REN_DontCreateRedirectors);
+	}
+
+	UAnimationStateMachineGraph* SMGraph = Cast<UAnimationStateMachineGraph>(SMNode->EditorStateMachineGraph);
+	if (!SMGraph)
+	{
+		return FString::Printf(TEXT("! StateMachine: '%s' has no graph"), *Spec.Name);
+	}
+	SMGraph->Modify();
+
+	// Index what the graph already has once instead of scanning titles per state and transition
+	TMap<FString, UAnimStateNodeBase*> StatesByName;
+	TSet<TPair<UAnimStateNodeBase*, UAnimStateNodeBase*>> ExistingTransitions;
+	UAnimStateEntryNode* EntryNode = nullptr;
+	for (UEdGraphNode* Node : SMGraph->Nodes)
+	{
+		if (UAnimStateNode* StateNode = Cast<UAnimStateNode>(Node))
+		{
+			StatesByName.Add(StateNode->GetStateName().ToLower(), StateNode);
+		}
+		else if (UAnimStateTransitionNode* TransNode = Cast<UAnimStateTransitionNode>(Node))
+		{
+			ExistingTransitions.Add(TPair<UAnimStateNodeBase*, UAnimStateNodeBase*>(TransNode->GetPreviousState(), TransNode->GetNextState()));
+		}
+		else if (UAnimStateEntryNode* Entry = Cast<UAnimStateEntryNode>(Node))
+		{
+			EntryNode = Entry;
+		}
+	}
+
+	FGraphLayoutIndex LayoutIndex(SMGraph);
+	const FVector2D StateOrigin = LayoutIndex.FindFreeSlot();
+
+	// States
+	TArray<UAnimStateNode*> NewStates;
+	int32 ExistingStateCount = 0;
+	for (const FStateSpec& StateSpec : Spec.States)
+	{
+		if (StateSpec.Name.IsEmpty())
+		{
+			OutResults.Add(FString::Printf(TEXT("! AnimState: Missing state name in '%s'"), *Spec.Name));
+			continue;
+		}
+		if (StatesByName.Contains(StateSpec.Name.ToLower()))
+		{
+			ExistingStateCount++;
+			continue;
+		}
+
+		UAnimStateNode* StateNode = NewObject<UAnimStateNode>(SMGraph, NAME_None, RF_Transactional);
+		AddNodeQuiet(SMGraph, StateNode);
+		StateNode->CreateNewGuid();
+		StateNode->PostPlacedNewNode();
+		StateNode->AllocateDefaultPins();
+
+		// The state is named by its bound graph, which PostPlacedNewNode created with a suggested name
+		StateNode->BoundGraph->Rename(*StateSpec.Name, nullptr, REN_DontCreateRedirectors);
+
+		StatesByName.Add(StateSpec.Name.ToLower(), StateNode);
+		NewStates.Add(StateNode);
+
+		if (!StateSpec.Animation.IsEmpty())
+		{
+			FString SequencePath = StateSpec.Animation;
+			if (!SequencePath.Contains(TEXT(".")))
+			{
+				SequencePath += TEXT(".") + FPackageName::GetShortName(SequencePath);
+			}
+
+			UAnimSequenceBase* Sequence = LoadObject<UAnimSequenceBase>(nullptr, *SequencePath);
+			UAnimationStateGraph* StateGraph = Cast<UAnimationStateGraph>(StateNode->BoundGraph);
+			UAnimGraphNode_StateResult* StateResult = StateGraph ? StateGraph->GetResultNode() : nullptr;
+			if (!Sequence)
+			{
+				OutResults.Add(FString::Printf(TEXT("! AnimState: %s animation not found: %s"), *StateSpec.Name, *StateSpec.Animation));
+			}
+			else if (StateResult)
+			{
+				// The state graph is new, so nothing is listening to its notifications yet
+				FGraphNodeCreator<UAnimGraphNode_SequencePlayer> PlayerCreator(*StateGraph);
+				UAnimGraphNode_SequencePlayer* Player = PlayerCreator.CreateNode();
+				Player->SetAnimationAsset(Sequence);
+				Player->NodePosX = StateResult->NodePosX - FGraphLayoutIndex::DefaultNodeWidth - FGraphLayoutIndex::SpacingX;
+				Player->NodePosY = StateResult->NodePosY;
+				PlayerCreator.Finalize();
+
+				UEdGraphPin* PosePin = Player->FindPin(TEXT("Pose"), EGPD_Output);
+				UEdGraphPin* ResultPin = StateResult->FindPin(TEXT("Result"), EGPD_Input);
+				if (PosePin && ResultPin)
+				{
+					PosePin->MakeLinkTo(ResultPin);
+				}
+			}
+		}
+	}
+
+	// Entry: the named state, or the first new state if nothing is linked from the entry yet
+	UEdGraphPin* EntryPin = EntryNode ? EntryNode->GetOutputPin() : nullptr;
+	UAnimStateNodeBase* EntryState = nullptr;
+	if (EntryPin)
+	{
+		if (!Spec.Entry.IsEmpty())
+		{
+			if (UAnimStateNodeBase** Found = StatesByName.Find(Spec.Entry.ToLower()))
+			{
+				EntryPin->BreakAllPinLinks();
+				EntryPin->MakeLinkTo((*Found)->GetInputPin());
+			}
+			else
+			{
+				OutResults.Add(FString::Printf(TEXT("! StateMachine: Entry state '%s' not found in '%s'"), *Spec.Entry, *Spec.Name));
+			}
+		}
+		else if (EntryPin->LinkedTo.Num() == 0 && NewStates.Num() > 0)
+		{
+			EntryPin->MakeLinkTo(NewStates[0]->GetInputPin());
+		}
+
+		if (EntryPin->LinkedTo.Num() > 0)
+		{
+			EntryState = Cast<UAnimStateNodeBase>(EntryPin->LinkedTo[0]->GetOwningNode());
+		}
+	}
+
+	// Transitions
+	TArray<UAnimStateTransitionNode*> NewTransitions;
+	TMap<UAnimStateNodeBase*, TArray<UAnimStateNodeBase*>> NextStates;
+	for (const TPair<UAnimStateNodeBase*, UAnimStateNodeBase*>& Existing : ExistingTransitions)
+	{
+		NextStates.FindOrAdd(Existing.Key).Add(Existing.Value);
+	}
+
+	for (const FTransitionSpec& TransSpec : Spec.Transitions)
+	{
+		UAnimStateNodeBase** FromState = StatesByName.Find(TransSpec.From.ToLower());
+		UAnimStateNodeBase** ToState = StatesByName.Find(TransSpec.To.ToLower());
+		if (!FromState || !ToState)
+		{
+			OutResults.Add(FString::Printf(TEXT("! Transition: %s -> %s: state '%s' not found"),
+				*TransSpec.From, *TransSpec.To, FromState ? *TransSpec.To : *TransSpec.From));
+			continue;
+		}
+
+		const TPair<UAnimStateNodeBase*, UAnimStateNodeBase*> Key(*FromState, *ToState);
+		if (ExistingTransitions.Contains(Key))
+		{
+			OutResults.Add(FString::Printf(TEXT("! Transition: %s -> %s already exists"), *TransSpec.From, *TransSpec.To));
+			continue;
+		}
+		ExistingTransitions.Add(Key);
+		NextStates.FindOrAdd(*FromState).Add(*ToState);
+
+		// PostPlacedNewNode creates the rule graph with its result node
+		UAnimStateTransitionNode* TransNode = NewObject<UAnimStateTransitionNode>(SMGraph, NAME_None, RF_Transactional);
+		AddNodeQuiet(SMGraph, TransNode);
+		TransNode->CreateNewGuid();
+		TransNode->PostPlacedNewNode();
+		TransNode->AllocateDefaultPins();
+		TransNode->CreateConnections(*FromState, *ToState);
+
+		if (TransSpec.BlendTime.IsSet())
+		{
+			TransNode->CrossfadeDuration = static_cast<float>(TransSpec.BlendTime.GetValue());
+		}
+		if (TransSpec.Priority.IsSet())
+		{
+			TransNode->PriorityOrder = TransSpec.Priority.GetValue();
+		}
+		TransNode->bBidirectional = TransSpec.bBidirectional;
+
+		if (!TransSpec.BlendMode.IsEmpty())
+		{
+			const int64 BlendMode = StaticEnum<EAlphaBlendOption>()->GetValueByNameString(TransSpec.BlendMode);
+			if (BlendMode != INDEX_NONE)
+			{
+				TransNode->BlendMode = static_cast<EAlphaBlendOption>(BlendMode);
+			}
+			else
+			{
+				OutResults.Add(FString::Printf(TEXT("! Transition: %s -> %s: unknown blend_mode '%s'"), *TransSpec.From, *TransSpec.To, *TransSpec.BlendMode));
+			}
+		}
+
+		if (!TransSpec.BlendLogic.IsEmpty())
+		{
+			if (TransSpec.BlendLogic.Equals(TEXT("Standard"), ESearchCase::IgnoreCase))
+			{
+				TransNode->LogicType = ETransitionLogicType::TLT_StandardBlend;
+			}
+			else if (TransSpec.BlendLogic.Equals(TEXT("Inertialization"), ESearchCase::IgnoreCase))
+			{
+				TransNode->LogicType = ETransitionLogicType::TLT_Inertialization;
+			}
+			else if (TransSpec.BlendLogic.Equals(TEXT("Custom"), ESearchCase::IgnoreCase))
+			{
+				TransNode->LogicType = ETransitionLogicType::TLT_Custom;
+			}
+			else
+			{
+				OutResults.Add(FString::Printf(TEXT("! Transition: %s -> %s: unknown blend_logic '%s'"), *TransSpec.From, *TransSpec.To, *TransSpec.BlendLogic));
+			}
+		}
+
+		if (!TransSpec.Rule.IsEmpty())
+		{
+			const FString RuleError = BuildTransitionRule(AnimBlueprint, TransNode, TransSpec.Rule);
+			if (!RuleError.IsEmpty())
+			{
+				OutResults.Add(FString::Printf(TEXT("! Transition: %s -> %s: %s"), *TransSpec.From, *TransSpec.To, *RuleError));
+			}
+		}
+
+		NewTransitions.Add(TransNode);
+	}
+
+	// Place new states in columns by transition distance from the entry state
+	if (NewStates.Num() > 0)
+	{
+		TMap<UAnimStateNodeBase*, int32> Depth;
+		TArray<UAnimStateNodeBase*> Queue;
+		if (EntryState)
+		{
+			Depth.Add(EntryState, 0);
+			Queue.Add(EntryState);
+		}
+		for (int32 QueueIdx = 0; QueueIdx < Queue.Num(); QueueIdx++)
+		{
+			UAnimStateNodeBase* Current = Queue[QueueIdx];
+			if (const TArray<UAnimStateNodeBase*>* Nexts = NextStates.Find(Current))
+			{
+				for (UAnimStateNodeBase* Next : *Nexts)
+				{
+					if (!Depth.Contains(Next))
+					{
+						Depth.Add(Next, Depth[Current] + 1);
+						Queue.Add(Next);
+					}
+				}
+			}
+		}
+
+		// States not reachable from the entry go in a column after the rest
+		int32 MaxDepth = 0;
+		for (const TPair<UAnimStateNodeBase*, int32>& Pair : Depth)
+		{
+			MaxDepth = FMath::Max(MaxDepth, Pair.Value);
+		}
+
+		TMap<int32, int32> RowsInColumn;
+		for (UAnimStateNode* StateNode : NewStates)
+		{
+			const int32* StateDepth = Depth.Find(StateNode);
+			const int32 Column = StateDepth ? *StateDepth : MaxDepth + 1;
+			int32& Row = RowsInColumn.FindOrAdd(Column);
+
+			const FVector2D Size = FGraphLayoutIndex::EstimateNodeSize(StateNode);
+			FVector2D Position(StateOrigin.X + Column * StateColumnSpacing, StateOrigin.Y + Row * StateRowSpacing);
+			while (LayoutIndex.Overlaps(FBox2D(Position, Position + Size)))
+			{
+				Position.Y += StateRowSpacing;
+				Row++;
+			}
+			Row++;
+
+			StateNode->NodePosX = FMath::RoundToInt32(Position.X);
+			StateNode->NodePosY = FMath::RoundToInt32(Position.Y);
+			LayoutIndex.AddNode(StateNode);
+		}
+	}
+
+	for (UAnimStateTransitionNode* TransNode : NewTransitions)
+	{
+		const UAnimStateNodeBase* From = TransNode->GetPreviousState();
+		const UAnimStateNodeBase* To = TransNode->GetNextState();
+		if (From && To)
+		{
+			TransNode->NodePosX = (From->NodePosX + To->NodePosX) / 2;
+			TransNode->NodePosY = (From->NodePosY + To->NodePosY) / 2;
+		}
+	}
+
+	// One notification for everything added to the machine
+	SMGraph->NotifyGraphChanged();
+
+	// Feed the machine's pose into the AnimGraph output
+	bool bOutputConnected = false;
+	UAnimGraphNode_Root* RootNode = nullptr;
+	if (Spec.bConnectOutput)
+	{
+		for (UEdGraphNode* Node : AnimGraph->Nodes)
+		{
+			RootNode = Cast<UAnimGraphNode_Root>(Node);
+			if (RootNode)
+			{
+				break;
+			}
+		}
+	}
+
+	if (bNewMachine)
+	{
+		FGraphLayoutIndex AnimLayoutIndex(AnimGraph);
+		FVector2D Position = AnimLayoutIndex.FindFreeSlot();
+		if (RootNode)
+		{
+			// Left of the output pose, stepping down past anything already there
+			const FVector2D Size(FGraphLayoutIndex::DefaultNodeWidth, FGraphLayoutIndex::DefaultNodeHeight);
+			Position = FVector2D(RootNode->NodePosX - Size.X - FGraphLayoutIndex::SpacingX * 2, RootNode->NodePosY);
+			while (AnimLayoutIndex.Overlaps(FBox2D(Position, Position + Size)))
+			{
+				Position.Y += Size.Y + FGraphLayoutIndex::SpacingY;
+			}
+		}
+		SMNode->NodePosX = FMath::RoundToInt32(Position.X);
+		SMNode->NodePosY = FMath::RoundToInt32(Position.Y);
+	}
+
+	if (RootNode)
+	{
+		UEdGraphPin* PosePin = SMNode->FindPin(TEXT("Pose"), EGPD_Output);
+		UEdGraphPin* ResultPin = RootNode->FindPin(TEXT("Result"), EGPD_Input);
+		if (PosePin && ResultPin)
+		{
+			ResultPin->BreakAllPinLinks();
+			PosePin->MakeLinkTo(ResultPin);
+			bOutputConnected = true;
+		}
+	}
+	else if (Spec.bConnectOutput)
+	{
+		OutResults.Add(FString::Printf(TEXT("! StateMachine: Output pose node not found for '%s'"), *Spec.Name));
+	}
+
+	// The AnimGraph hears about the machine once, complete
+	if (bNewMachine)
+	{
+		AnimGraph->AddNode(SMNode, false, false);
+	}
+	else if (bOutputConnected)
+	{
+		AnimGraph->NotifyGraphChanged();
+	}
+
+	FString Summary = FString::Printf(TEXT("+ StateMachine: %s (%s, %d states added"),
+		*Spec.Name, bNewMachine ? TEXT("new") : TEXT("extended"), NewStates.Num());
+	if (ExistingStateCount > 0)
+	{
+		Summary += FString::Printf(TEXT(", %d existing"), ExistingStateCount);
+	}
+	Summary += FString::Printf(TEXT(", %d transitions"), NewTransitions.Num());
+	if (EntryState)
+	{
+		Summary += FString::Printf(TEXT(", entry %s"), *EntryState->GetStateName());
+	}
+	if (bOutputConnected)
+	{
+		Summary += TEXT(", output connected");
+	}
+	Summary += FString::Printf(TEXT(", GUID: %s)"), *SMNode->NodeGuid.ToString());
+	return Summary;
+}
+
+FString FEditBlueprintTool::BuildTransitionRule(UAnimBlueprint* AnimBlueprint, UAnimStateTransitionNode* TransitionNode, const FString& Rule)
+{
+	if (Rule.Equals(TEXT("auto"), ESearchCase::IgnoreCase))
+	{
+		TransitionNode->bAutomaticRuleBasedOnSequencePlayerInState = true;
+		return FString();
+	}
+
+	FString VarName = Rule.TrimStartAndEnd();
+	const bool bNegate = VarName.RemoveFromStart(TEXT("!"));
+	VarName.TrimStartInline();
+
+	const FBoolProperty* BoolProp = AnimBlueprint->SkeletonGeneratedClass
+		? FindFProperty<FBoolProperty>(AnimBlueprint->SkeletonGeneratedClass, FName(*VarName))
+		: nullptr;
+	if (!BoolProp)
+	{
+		return FString::Printf(TEXT("rule variable '%s' is not a Boolean member"), *VarName);
+	}
+
+	UAnimationTransitionGraph* TransGraph = Cast<UAnimationTransitionGraph>(TransitionNode->BoundGraph);
+	UAnimGraphNode_TransitionResult* ResultNode = TransGraph ? TransGraph->GetResultNode() : nullptr;
+	UEdGraphPin* CanEnterPin = ResultNode ? ResultNode->FindPin(TEXT("bCanEnterTransition"), EGPD_Input) : nullptr;
+	if (!CanEnterPin)
+	{
+		return TEXT("rule graph has no result node");
+	}
+
+	// The rule graph is new, so nothing is listening to its notifications yet
+	const float StepX = FGraphLayoutIndex::DefaultNodeWidth + FGraphLayoutIndex::SpacingX;
+
+	FGraphNodeCreator<UK2Node_VariableGet> GetCreator(*TransGraph);
+	UK2Node_VariableGet* GetNode = GetCreator.CreateNode();
+	GetNode->VariableReference.SetSelfMember(FName(*VarName));
+	GetNode->NodePosX = FMath::RoundToInt32(ResultNode->NodePosX - StepX * (bNegate ? 2 : 1));
+	GetNode->NodePosY = ResultNode->NodePosY;
+	GetCreator.Finalize();
+
+	UEdGraphPin* ValuePin = GetNode->FindPin(FName(*VarName), EGPD_Output);
+	if (!ValuePin)
+	{
+		return FString::Printf(TEXT("could not read '%s' in the rule graph"), *VarName);
+	}
+
+	if (bNegate)
+	{
+		FGraphNodeCreator<UK2Node_CallFunction> NotCreator(*TransGraph);
+		UK2Node_CallFunction* NotNode = NotCreator.CreateNode();
+		NotNode->SetFromFunction(UKismetMathLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Not_PreBool)));
+		NotNode->NodePosX = FMath::RoundToInt32(ResultNode->NodePosX - StepX);
+		NotNode->NodePosY = ResultNode->NodePosY;
+		NotCreator.Finalize();
+
+		UEdGraphPin* NotInput = NotNode->FindPin(TEXT("A"), EGPD_Input);
+		UEdGraphPin* NotOutput = NotNode->GetReturnValuePin();
+		if (!NotInput || !NotOutput)
+		{
+			return TEXT("could not create the negation node");
+		}
+		ValuePin->MakeLinkTo(NotInput);
+		ValuePin = NotOutput;
+	}
+
+	ValuePin->MakeLinkTo(CanEnterPin);
+	return FString();
+}
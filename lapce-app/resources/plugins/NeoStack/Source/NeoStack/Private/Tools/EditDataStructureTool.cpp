@@ -16,12 +16,54 @@
 
 // For datatable editing
 #include "Engine/DataTable.h"
+#include "DataTableUtils.h"
+#include "DataTableEditorUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 
 // For editor support
 #include "Editor.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 
+namespace
+{
+	/** Project-relative or absolute path from an import/export "file" argument */
+	FString ResolveDataFilePath(const FString& File)
+	{
+		return FPaths::IsRelative(File) ? FPaths::ProjectDir() / File : File;
+	}
+
+	/** Lowercase "format" argument, or the file's extension when it is missing */
+	FString GetDataFileFormat(const TSharedPtr<FJsonObject>& Obj, const FString& File)
+	{
+		FString Format;
+		if (!Obj->TryGetStringField(TEXT("format"), Format) || Format.IsEmpty())
+		{
+			Format = FPaths::GetExtension(File);
+		}
+		Format.ToLowerInline();
+		return Format == TEXT("ndjson") ? TEXT("jsonl") : Format;
+	}
+
+	FString QuoteCsv(const FString& Value)
+	{
+		return TEXT("\"") + Value.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"");
+	}
+
+	void WriteUtf8(FArchive& Writer, const FString& Text)
+	{
+		FTCHARToUTF8 Utf8(*Text);
+		Writer.Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+	}
+}
+
+void FEditDataStructureTool::GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const
+{
+	NeoStackToolUtils::AddNamePathResource(Args, OutKeys);
+}
+
 FToolResult FEditDataStructureTool::Execute(const TSharedPtr<FJsonObject>& Args)
 {
 	FString Name, Path;
@@ -528,13 +570,35 @@ FToolResult FEditDataStructureTool::EditDataTable(UDataTable* DataTable, const T
 		TotalChanges += ModifyDataTableRows(DataTable, ModifyRowsArray, Results);
 	}
 
-	if (TotalChanges == 0)
+	// Process import_rows
+	const TSharedPtr<FJsonObject>* ImportObj;
+	if (Args->TryGetObjectField(TEXT("import_rows"), ImportObj))
 	{
-		return FToolResult::Fail(TEXT("No operations specified. Use add_rows, remove_rows, or modify_rows."));
+		TotalChanges += ImportDataTableRows(DataTable, *ImportObj, Results);
+	}
+
+	// Process export_rows (after the edits, so the file reflects them)
+	const TSharedPtr<FJsonObject>* ExportObj;
+	const bool bExport = Args->TryGetObjectField(TEXT("export_rows"), ExportObj);
+	if (bExport)
+	{
+		ExportDataTableRows(DataTable, *ExportObj, Results);
+	}
+
+	if (TotalChanges == 0 && !bExport)
+	{
+		if (Results.Num() > 0)
+		{
+			return FToolResult::Fail(FString::Join(Results, TEXT("\n")));
+		}
+		return FToolResult::Fail(TEXT("No operations specified. Use add_rows, remove_rows, modify_rows, import_rows, or export_rows."));
 	}
 
 	// Mark dirty
-	DataTable->GetPackage()->MarkPackageDirty();
+	if (TotalChanges > 0)
+	{
+		DataTable->GetPackage()->MarkPackageDirty();
+	}
 
 	// Build output
 	FString Output = FString::Printf(TEXT("Modified DataTable %s (%d changes)\n"), *DataTable->GetName(), TotalChanges);
@@ -704,6 +768,196 @@ int32 FEditDataStructureTool::ModifyDataTableRows(UDataTable* DataTable, const T
 	return Modified;
 }
 
+int32 FEditDataStructureTool::ImportDataTableRows(UDataTable* DataTable, const TSharedPtr<FJsonObject>& ImportObj, TArray<FString>& OutResults)
+{
+	FString File;
+	if (!ImportObj->TryGetStringField(TEXT("file"), File) || File.IsEmpty())
+	{
+		OutResults.Add(TEXT("import_rows: missing file"));
+		return 0;
+	}
+
+	FString Mode = TEXT("append");
+	ImportObj->TryGetStringField(TEXT("mode"), Mode);
+	const bool bReplace = Mode.Equals(TEXT("replace"), ESearchCase::IgnoreCase);
+	const FString Format = GetDataFileFormat(ImportObj, File);
+
+	FString Contents;
+	if (!FFileHelper::LoadFileToString(Contents, *ResolveDataFilePath(File)))
+	{
+		OutResults.Add(FString::Printf(TEXT("import_rows: could not read %s"), *File));
+		return 0;
+	}
+
+	if (Format == TEXT("jsonl"))
+	{
+		// One object per line -> the JSON array the engine importer reads
+		TArray<FString> Lines;
+		Contents.ParseIntoArrayLines(Lines);
+		FString Array;
+		Array.Reserve(Contents.Len() + Lines.Num() + 2);
+		Array += TEXT("[");
+		for (FString& Line : Lines)
+		{
+			Line.TrimStartAndEndInline();
+			if (Line.IsEmpty())
+			{
+				continue;
+			}
+			if (Array.Len() > 1)
+			{
+				Array += TEXT(",");
+			}
+			Array += Line;
+		}
+		Array += TEXT("]");
+		Contents = MoveTemp(Array);
+	}
+	else if (Format != TEXT("csv") && Format != TEXT("json"))
+	{
+		OutResults.Add(FString::Printf(TEXT("import_rows: unsupported format '%s' (use csv, json or jsonl)"), *Format));
+		return 0;
+	}
+
+	// Parse into a transient table first: the engine importer binds each column to its property
+	// once, and rows added there notify nobody
+	UDataTable* Staging = NewObject<UDataTable>(GetTransientPackage(), NAME_None, RF_Transient);
+	Staging->RowStruct = DataTable->RowStruct;
+	const TArray<FString> Problems = Format == TEXT("csv")
+		? Staging->CreateTableFromCSVString(Contents)
+		: Staging->CreateTableFromJSONString(Contents);
+
+	constexpr int32 MaxReportedProblems = 10;
+	for (int32 i = 0; i < FMath::Min(Problems.Num(), MaxReportedProblems); i++)
+	{
+		OutResults.Add(FString::Printf(TEXT("Import problem: %s"), *Problems[i]));
+	}
+	if (Problems.Num() > MaxReportedProblems)
+	{
+		OutResults.Add(FString::Printf(TEXT("... and %d more import problems"), Problems.Num() - MaxReportedProblems));
+	}
+
+	const int32 ImportedCount = Staging->GetRowMap().Num();
+	if (ImportedCount == 0)
+	{
+		OutResults.Add(FString::Printf(TEXT("import_rows: no rows read from %s"), *File));
+		return 0;
+	}
+
+	// Appends are merged in a second transient table so the real one is replaced in one step
+	UDataTable* Source = Staging;
+	int32 OverwrittenCount = 0;
+	if (!bReplace)
+	{
+		UDataTable* Merged = NewObject<UDataTable>(GetTransientPackage(), NAME_None, RF_Transient);
+		Merged->RowStruct = DataTable->RowStruct;
+		Merged->CreateTableFromOtherTable(DataTable);
+		for (const TPair<FName, uint8*>& Row : Staging->GetRowMap())
+		{
+			OverwrittenCount += DataTable->FindRowUnchecked(Row.Key) ? 1 : 0;
+			Merged->AddRow(Row.Key, *(FTableRowBase*)Row.Value);
+		}
+		Source = Merged;
+	}
+
+	DataTable->Modify();
+	FDataTableEditorUtils::BroadcastPreChange(DataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+	DataTable->CreateTableFromOtherTable(Source);
+	FDataTableEditorUtils::BroadcastPostChange(DataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+
+	FString Summary = FString::Printf(TEXT("Imported %d rows from %s (%s, %s"),
+		ImportedCount, *File, *Format, bReplace ? TEXT("replaced all rows") : TEXT("appended"));
+	if (OverwrittenCount > 0)
+	{
+		Summary += FString::Printf(TEXT(", %d existing rows overwritten"), OverwrittenCount);
+	}
+	OutResults.Add(Summary + TEXT(")"));
+
+	return ImportedCount;
+}
+
+int32 FEditDataStructureTool::ExportDataTableRows(UDataTable* DataTable, const TSharedPtr<FJsonObject>& ExportObj, TArray<FString>& OutResults)
+{
+	FString File;
+	if (!ExportObj->TryGetStringField(TEXT("file"), File) || File.IsEmpty())
+	{
+		OutResults.Add(TEXT("export_rows: missing file"));
+		return 0;
+	}
+
+	const FString Format = GetDataFileFormat(ExportObj, File);
+	const bool bCsv = Format == TEXT("csv");
+	if (!bCsv && Format != TEXT("jsonl"))
+	{
+		OutResults.Add(FString::Printf(TEXT("export_rows: unsupported format '%s' (use csv or jsonl)"), *Format));
+		return 0;
+	}
+
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*ResolveDataFilePath(File)));
+	if (!Writer)
+	{
+		OutResults.Add(FString::Printf(TEXT("export_rows: could not write %s"), *File));
+		return 0;
+	}
+
+	// Column properties and names are resolved once; each row is written as soon as it is formatted
+	TArray<const FProperty*> Columns;
+	TArray<FString> ColumnNames;
+	for (TFieldIterator<FProperty> It(DataTable->RowStruct); It; ++It)
+	{
+		Columns.Add(*It);
+		ColumnNames.Add(DataTableUtils::GetPropertyExportName(*It));
+	}
+
+	FString Line;
+	if (bCsv)
+	{
+		Line = TEXT("---");
+		for (const FString& ColumnName : ColumnNames)
+		{
+			Line += TEXT(",") + QuoteCsv(ColumnName);
+		}
+		Line += TEXT("\n");
+		WriteUtf8(*Writer, Line);
+	}
+
+	int32 RowCount = 0;
+	for (const TPair<FName, uint8*>& Row : DataTable->GetRowMap())
+	{
+		Line.Reset();
+		if (bCsv)
+		{
+			Line += QuoteCsv(Row.Key.ToString());
+			for (const FProperty* Column : Columns)
+			{
+				Line += TEXT(",");
+				Line += QuoteCsv(DataTableUtils::GetPropertyValueAsString(Column, Row.Value, EDataTableExportFlags::None));
+			}
+		}
+		else
+		{
+			TSharedRef<FJsonObject> RowObj = MakeShared<FJsonObject>();
+			RowObj->SetStringField(TEXT("Name"), Row.Key.ToString());
+			for (int32 i = 0; i < Columns.Num(); i++)
+			{
+				RowObj->SetStringField(ColumnNames[i], DataTableUtils::GetPropertyValueAsString(Columns[i], Row.Value, EDataTableExportFlags::None));
+			}
+			TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+				TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+			FJsonSerializer::Serialize(RowObj, JsonWriter);
+		}
+		Line += TEXT("\n");
+		WriteUtf8(*Writer, Line);
+		RowCount++;
+	}
+
+	const int64 Bytes = Writer->TotalSize();
+	Writer->Close();
+
+	OutResults.Add(FString::Printf(TEXT("Exported %d rows to %s (%s, %lld bytes)"), RowCount, *File, *Format, Bytes));
+	return RowCount;
+}
+
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
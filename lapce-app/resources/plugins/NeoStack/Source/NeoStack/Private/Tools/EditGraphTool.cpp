@@ -2,6 +2,11 @@
 
 #include "Tools/EditGraphTool.h"
 #include "Tools/NodeNameRegistry.h"
+#include "Tools/AssetReadCache.h"
+#include "Tools/NeoStackToolUtils.h"
+#include "Tools/GraphLayoutIndex.h"
+#include "Tools/BlueprintCompileScheduler.h"
+#include "Tools/TurnCheckpoint.h"
 #include "Json.h"
 
 // Blueprint includes
@@ -27,13 +32,17 @@
 #include "MaterialGraph/MaterialGraphNode.h"
 #include "MaterialGraph/MaterialGraphNode_Root.h"
 #include "MaterialEditorUtilities.h"
+#include "MaterialEditingLibrary.h"
+#include "MaterialShared.h"
 #include "IMaterialEditor.h"
+#include "RHI.h"
 #include "UObject/UnrealType.h"
 
 // Asset loading
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Editor.h"
 #include "Subsystems/AssetEditorSubsystem.h"
+#include "ScopedTransaction.h"
 
 // Universal schema action system
 #include "EdGraph/EdGraphSchema.h"
@@ -45,6 +54,94 @@
 #include "K2Node_VariableGet.h"
 #include "K2Node_VariableSet.h"
 
+/**
+ * A batch call run asynchronously: the edit is one step, then the task is stepped once a frame
+ * until the material's one shader compile has finished, so the result says when it did
+ */
+class FEditGraphTool::FMaterialCompileTask : public FNeoStackToolTask
+{
+public:
+	explicit FMaterialCompileTask(const TSharedPtr<FJsonObject>& InArgs)
+		: Args(InArgs)
+	{
+	}
+
+	virtual bool Step(double Deadline) override
+	{
+		if (!bEdited)
+		{
+			bEdited = true;
+			Result = Worker.Execute(Args);
+			Material = Worker.PendingShaderCompile;
+			if (!Result.bSuccess || !Material.IsValid())
+			{
+				return true;
+			}
+
+			CompileStartTime = FPlatformTime::Seconds();
+			ReportProgress(-1.0f, TEXT("compiling shaders"));
+			return false;
+		}
+
+		// The edit is complete, so giving up on the wait leaves nothing half done
+		const double Elapsed = FPlatformTime::Seconds() - CompileStartTime;
+		UMaterial* CompiledMaterial = Material.Get();
+		const FMaterialResource* Resource = CompiledMaterial ? CompiledMaterial->GetMaterialResource(GMaxRHIFeatureLevel) : nullptr;
+		if (Resource && !Resource->IsCompilationFinished())
+		{
+			if (IsCancelled() || Elapsed >= ShaderCompileTimeoutSeconds)
+			{
+				Result.Output += FString::Printf(TEXT("# SHADERS still compiling after %.0f s\n"), Elapsed);
+				return true;
+			}
+			return false;
+		}
+
+		const TArray<FString> CompileErrors = Resource ? Resource->GetCompileErrors() : TArray<FString>();
+		if (CompileErrors.Num() > 0)
+		{
+			Result.Output += FString::Printf(TEXT("# SHADERS failed after %.1f s with %d errors\n"), Elapsed, CompileErrors.Num());
+			for (const FString& Error : CompileErrors)
+			{
+				Result.Output += FString::Printf(TEXT("error: %s\n"), *Error);
+			}
+		}
+		else
+		{
+			Result.Output += FString::Printf(TEXT("# SHADERS compiled in %.1f s\n"), Elapsed);
+		}
+		return true;
+	}
+
+private:
+	TSharedPtr<FJsonObject> Args;
+	FEditGraphTool Worker;
+	TWeakObjectPtr<UMaterial> Material;
+	double CompileStartTime = 0.0;
+	bool bEdited = false;
+};
+
+TSharedRef<FNeoStackToolTask> FEditGraphTool::CreateTask(const TSharedPtr<FJsonObject>& Args)
+{
+	bool bBatch = false;
+	if (Args.IsValid() && Args->TryGetBoolField(TEXT("batch"), bBatch) && bBatch)
+	{
+		return MakeShared<FMaterialCompileTask>(Args);
+	}
+	return FNeoStackToolBase::CreateTask(Args);
+}
+
+void FEditGraphTool::GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const
+{
+	FString AssetName, Path;
+	if (!Args.IsValid() || !Args->TryGetStringField(TEXT("asset"), AssetName) || AssetName.IsEmpty())
+	{
+		return;
+	}
+	Args->TryGetStringField(TEXT("path"), Path);
+	OutKeys.Add(NeoStackToolUtils::GetResourceKey(AssetName, Path.IsEmpty() ? TEXT("/Game") : Path));
+}
+
 FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 {
 	// Parse required parameters
@@ -66,6 +163,14 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 	FString GraphName;
 	Args->TryGetStringField(TEXT("graph_name"), GraphName);
 
+	// Batch mode: the whole call is one undo step and editor refreshes are deferred to the end
+	bool bBatch = false;
+	Args->TryGetBoolField(TEXT("batch"), bBatch);
+
+	// Lay the added nodes out in columns by their connections instead of one row
+	bool bAutoLayout = false;
+	Args->TryGetBoolField(TEXT("auto_layout"), bAutoLayout);
+
 	// Build asset path and load
 	if (!Path.StartsWith(TEXT("/Game")) && !Path.StartsWith(TEXT("/Engine")))
 	{
@@ -80,6 +185,10 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		return FToolResult::Fail(FString::Printf(TEXT("Asset not found: %s"), *FullAssetPath));
 	}
 
+	// A material batch spawns expressions itself, so it needs no editor and leaves a closed one closed
+	const bool bMaterialBatch = bBatch && (Asset->IsA<UMaterial>() || Asset->IsA<UMaterialFunction>());
+	PendingShaderCompile.Reset();
+
 	// Ensure asset editor is open for proper schema initialization
 	if (GEditor)
 	{
@@ -87,7 +196,7 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		if (AssetEditorSubsystem)
 		{
 			bool bIsAlreadyOpen = AssetEditorSubsystem->FindEditorForAsset(Asset, false) != nullptr;
-			if (!bIsAlreadyOpen)
+			if (!bIsAlreadyOpen && !bMaterialBatch)
 			{
 				AssetEditorSubsystem->OpenEditorForAsset(Asset);
 				FPlatformProcess::Sleep(0.1f); // Give editor time to initialize
@@ -155,6 +264,9 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 	}
 	else if ((Blueprint = Cast<UBlueprint>(Asset)) != nullptr)
 	{
+		// New nodes resolve members on the skeleton class, so it needs earlier calls' changes
+		FBlueprintCompileScheduler::Get().FlushBlueprint(Blueprint);
+
 		// Blueprint graph
 		Graph = GetGraphByName(Blueprint, GraphName);
 		if (!Graph)
@@ -170,6 +282,25 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 	// Use actual graph name for registry
 	FString ActualGraphName = Graph->GetName();
 
+	// Names saved in an earlier session may point at nodes deleted since
+	FNodeNameRegistry::Get().ValidateGraph(FullAssetPath, Graph);
+
+	TOptional<FScopedTransaction> Transaction;
+	FEditBatch Batch;
+	FEditBatch* ActiveBatch = nullptr;
+	if (bBatch)
+	{
+		if (!FTurnCheckpoint::Get().IsCapturing())
+		{
+			Transaction.Emplace(FText::Format(NSLOCTEXT("NeoStack", "EditGraphBatch", "Edit Graph {0}"), FText::FromString(ActualGraphName)));
+		}
+		Asset->Modify();
+		Graph->Modify();
+		Batch.bDeferMaterialUpdates = bMaterialBatch;
+		ActiveBatch = &Batch;
+	}
+	const double StartTime = FPlatformTime::Seconds();
+
 	// Track results
 	TArray<FAddedNode> AddedNodes;
 	TArray<FString> ConnectionResults;
@@ -180,6 +311,16 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 	// Map of new node names to their instances (for connection resolution within this call)
 	TMap<FString, UEdGraphNode*> NewNodeMap;
 
+	// Node bounds for placement, kept up to date as nodes are added; auto layout starts where
+	// the first new node would otherwise go
+	FGraphLayoutIndex LayoutIndex(Graph);
+	const FVector2D LayoutOrigin = LayoutIndex.FindFreeSlot();
+	TArray<UEdGraphNode*> SpawnedNodes;
+
+	// Action menus are built on first use and shared by every node added in this call
+	TOptional<FBlueprintActionMenuBuilder> BlueprintMenu;
+	TOptional<FGraphContextMenuBuilder> GraphMenu;
+
 	// Process add_nodes
 	const TArray<TSharedPtr<FJsonValue>>* AddNodesArray;
 	if (Args->TryGetArrayField(TEXT("add_nodes"), AddNodesArray))
@@ -208,17 +349,21 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 			if (Blueprint)
 			{
 				// Blueprint-specific action database
-				FBlueprintActionContext FilterContext;
-				FilterContext.Blueprints.Add(Blueprint);
-				FilterContext.Graphs.Add(Graph);
+				if (!BlueprintMenu.IsSet())
+				{
+					FBlueprintActionContext FilterContext;
+					FilterContext.Blueprints.Add(Blueprint);
+					FilterContext.Graphs.Add(Graph);
 
-				FBlueprintActionMenuBuilder MenuBuilder(FBlueprintActionMenuBuilder::DefaultConfig);
-				uint32 ClassTargetMask = EContextTargetFlags::TARGET_Blueprint |
-				                         EContextTargetFlags::TARGET_BlueprintLibraries |
-				                         EContextTargetFlags::TARGET_SubComponents |
-				                         EContextTargetFlags::TARGET_NonImportedTypes;
+					BlueprintMenu.Emplace(FBlueprintActionMenuBuilder::DefaultConfig);
+					uint32 ClassTargetMask = EContextTargetFlags::TARGET_Blueprint |
+					                         EContextTargetFlags::TARGET_BlueprintLibraries |
+					                         EContextTargetFlags::TARGET_SubComponents |
+					                         EContextTargetFlags::TARGET_NonImportedTypes;
 
-				FBlueprintActionMenuUtils::MakeContextMenu(FilterContext, false, ClassTargetMask, MenuBuilder);
+					FBlueprintActionMenuUtils::MakeContextMenu(FilterContext, false, ClassTargetMask, BlueprintMenu.GetValue());
+				}
+				FBlueprintActionMenuBuilder& MenuBuilder = BlueprintMenu.GetValue();
 
 				// Check if this is a variable getter/setter ID (VARGET: or VARSET:)
 				// These have special handling because UE's spawner signature doesn't distinguish member variables
@@ -315,8 +460,12 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 			else
 			{
 				// UNIVERSAL schema-based discovery for Materials, etc.
-				FGraphContextMenuBuilder ContextMenuBuilder(Graph);
-				Schema->GetGraphContextActions(ContextMenuBuilder);
+				if (!GraphMenu.IsSet())
+				{
+					GraphMenu.Emplace(Graph);
+					Schema->GetGraphContextActions(GraphMenu.GetValue());
+				}
+				FGraphContextMenuBuilder& ContextMenuBuilder = GraphMenu.GetValue();
 
 				// For material expressions, SpawnerId is like "/Script/Engine.MaterialExpressionConstant3Vector"
 				// We need to find the action that creates this expression class
@@ -384,11 +533,22 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 			}
 
 			// Calculate smart position - finds empty space near existing nodes
-			FVector2D SmartPosition = CalculateSmartPosition(Graph, NewNodeMap);
+			FVector2D SmartPosition = LayoutIndex.FindFreeSlot();
 
-			// UNIVERSAL node creation using PerformAction
-			TArray<UEdGraphPin*> EmptyPins;
-			UEdGraphNode* NewNode = FoundAction->PerformAction(Graph, EmptyPins, FVector2f(SmartPosition.X, SmartPosition.Y), true);
+			UEdGraphNode* NewNode = nullptr;
+			if (Batch.bDeferMaterialUpdates && FoundAction->GetTypeId() == FMaterialGraphSchemaAction_NewNode::StaticGetTypeId())
+			{
+				// PerformAction would have the Material Editor recompile the preview for every node
+				NewNode = SpawnMaterialExpression(CastChecked<UMaterialGraph>(Graph),
+					static_cast<FMaterialGraphSchemaAction_NewNode*>(FoundAction.Get())->MaterialExpressionClass, SmartPosition);
+			}
+			else
+			{
+				// UNIVERSAL node creation using PerformAction
+				TArray<UEdGraphPin*> EmptyPins;
+				// Selecting each new node refreshes the editor's details panel; skip it in batch mode
+				NewNode = FoundAction->PerformAction(Graph, EmptyPins, FVector2f(SmartPosition.X, SmartPosition.Y), !bBatch);
+			}
 			if (!NewNode)
 			{
 				Errors.Add(FString::Printf(TEXT("Failed to create node: %s"), *NodeDef.SpawnerId));
@@ -399,7 +559,7 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 			TArray<FString> PinValueResults;
 			if (NodeDef.Pins.IsValid())
 			{
-				PinValueResults = SetPinValues(NewNode, NodeDef.Pins);
+				PinValueResults = SetPinValues(NewNode, NodeDef.Pins, ActiveBatch);
 			}
 
 			// Generate name if not provided
@@ -441,6 +601,8 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 			}
 
 			AddedNodes.Add(Added);
+			SpawnedNodes.Add(NewNode);
+			LayoutIndex.AddNode(NewNode);
 		}
 	}
 
@@ -501,7 +663,7 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 			}
 
 			// Create connection using three-tier fallback strategy
-			FConnectionResult ConnResult = CreateConnectionWithFallback(FromPin, ToPin);
+			FConnectionResult ConnResult = CreateConnectionWithFallback(FromPin, ToPin, ActiveBatch);
 			if (ConnResult.bSuccess)
 			{
 				FString ConnStr = FString::Printf(TEXT("%s:%s -> %s:%s"),
@@ -534,6 +696,16 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		}
 	}
 
+	// Layering needs the connections, so it runs once they are made
+	if (bAutoLayout && SpawnedNodes.Num() > 1)
+	{
+		FGraphLayoutIndex::LayoutLayered(SpawnedNodes, LayoutOrigin);
+		for (int32 i = 0; i < SpawnedNodes.Num(); i++)
+		{
+			AddedNodes[i].Position = FVector2D(SpawnedNodes[i]->NodePosX, SpawnedNodes[i]->NodePosY);
+		}
+	}
+
 	// Process disconnect - break connections
 	const TArray<TSharedPtr<FJsonValue>>* DisconnectArray;
 	if (Args->TryGetArrayField(TEXT("disconnect"), DisconnectArray))
@@ -688,7 +860,7 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 			}
 
 			// Set values on the node
-			TArray<FString> Results = SetNodeValues(TargetNode, SetOp.Values, Graph);
+			TArray<FString> Results = SetNodeValues(TargetNode, SetOp.Values, Graph, ActiveBatch);
 			for (const FString& Result : Results)
 			{
 				SetPinsResults.Add(FString::Printf(TEXT("%s: %s"), *SetOp.NodeRef, *Result));
@@ -700,7 +872,7 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 	Asset->Modify();
 	if (Blueprint)
 	{
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		FBlueprintCompileScheduler::Get().MarkStructurallyModified(Blueprint);
 	}
 	else if (UMaterialGraph* MatGraph = Cast<UMaterialGraph>(Graph))
 	{
@@ -710,7 +882,51 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		// Order matters: Modify -> Link -> MarkDirty -> UpdatePinTypes -> Recompile
 
 		UMaterial* Mat = MatGraph->Material;
-		if (Mat)
+		UMaterialFunction* Func = Cast<UMaterialFunction>(MatGraph->MaterialFunction);
+		if ((Mat || Func) && Batch.bDeferMaterialUpdates)
+		{
+			// Nothing was linked or compiled per change; sync once and compile once
+			MatGraph->LinkMaterialExpressionsFromGraph();
+
+			IMaterialEditor* MaterialEditor = nullptr;
+			if (GEditor)
+			{
+				if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+				{
+					MaterialEditor = static_cast<IMaterialEditor*>(AssetEditorSubsystem->FindEditorForAsset(Asset, false));
+				}
+			}
+
+			if (MaterialEditor)
+			{
+				// The open editor's preview material is the one edited; its update is the one compile
+				FMaterialEditorUtilities::UpdateMaterialAfterGraphChange(MatGraph);
+				MaterialEditor->MarkMaterialDirty();
+			}
+			else if (Mat)
+			{
+				Mat->PreEditChange(nullptr);
+				Mat->PostEditChange();
+			}
+			else
+			{
+				// Materials using the function pick up its new links and recompile
+				Func->PreEditChange(nullptr);
+				Func->PostEditChange();
+				UMaterialEditingLibrary::UpdateMaterialFunction(Func, nullptr);
+			}
+
+			if (Mat)
+			{
+				Mat->MarkPackageDirty();
+				PendingShaderCompile = Mat;
+			}
+			else
+			{
+				Func->MarkPackageDirty();
+			}
+		}
+		else if (Mat)
 		{
 			// Step 1: Mark material as being modified BEFORE sync
 			Mat->Modify();
@@ -777,11 +993,39 @@ FToolResult FEditGraphTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		}
 	}
 
+	if (bBatch)
+	{
+		// Material functions have no material to dirty above; expression edits skipped it per property
+		if (Batch.ChangedExpressions.Num() > 0)
+		{
+			Asset->MarkPackageDirty();
+		}
+
+		// One refresh for the editor instead of one per pin default
+		Graph->NotifyGraphChanged();
+
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Batched edit of %s: %d nodes, %d connections, %d pin values, %d nodes and %d expressions changed in %.1f ms%s"),
+			*ActualGraphName, AddedNodes.Num(), ConnectionResults.Num(), SetPinsResults.Num(),
+			Batch.ChangedNodes.Num(), Batch.ChangedExpressions.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0,
+			PendingShaderCompile.IsValid() ? TEXT(", one shader compile started") : TEXT(""));
+	}
+
+	FAssetReadCache::Get().Invalidate(Asset);
+
 	// Format and return results
 	FString Output = FormatResults(AssetName, ActualGraphName, AddedNodes, ConnectionResults, DisconnectResults, SetPinsResults, Errors);
+	if (PendingShaderCompile.IsValid())
+	{
+		Output += TEXT("\n# SHADERS one compile started for the whole batch\n");
+	}
 
 	if (Errors.Num() > 0 && AddedNodes.Num() == 0 && ConnectionResults.Num() == 0 && DisconnectResults.Num() == 0 && SetPinsResults.Num() == 0)
 	{
+		// Nothing was applied; don't leave an empty step on the undo stack
+		if (Transaction.IsSet())
+		{
+			Transaction->Cancel();
+		}
 		return FToolResult::Fail(Output);
 	}
 
@@ -863,7 +1107,7 @@ bool FEditGraphTool::ParseSetPinsOp(const TSharedPtr<FJsonObject>& OpObj, FSetPi
 	return true;
 }
 
-TArray<FString> FEditGraphTool::SetNodeValues(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& Values, UEdGraph* Graph)
+TArray<FString> FEditGraphTool::SetNodeValues(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& Values, UEdGraph* Graph, FEditBatch* Batch)
 {
 	TArray<FString> Results;
 
@@ -929,9 +1173,18 @@ TArray<FString> FEditGraphTool::SetNodeValues(UEdGraphNode* Node, const TSharedP
 				continue;
 			}
 
-			// Post-edit change
-			Expression->MarkPackageDirty();
-			FPropertyChangedEvent PropertyEvent(Property, EPropertyChangeType::ValueSet);
+			// Post-edit change; a batch dirties the package once at the end
+			if (Batch)
+			{
+				Batch->ChangedExpressions.Add(Expression);
+			}
+			else
+			{
+				Expression->MarkPackageDirty();
+			}
+			// An interactive change doesn't recompile the material; a deferred batch compiles once at the end
+			FPropertyChangedEvent PropertyEvent(Property,
+				Batch && Batch->bDeferMaterialUpdates ? EPropertyChangeType::Interactive : EPropertyChangeType::ValueSet);
 			Expression->PostEditChangeProperty(PropertyEvent);
 
 			// Mark for preview update
@@ -1072,16 +1325,21 @@ TArray<FString> FEditGraphTool::SetNodeValues(UEdGraphNode* Node, const TSharedP
 				continue;
 			}
 
-			// Set the default value
+			// Set the default value; a batch marks the Blueprint modified once at the end
 			if (Schema)
 			{
-				Schema->TrySetDefaultValue(*Pin, ValueStr);
+				Schema->TrySetDefaultValue(*Pin, ValueStr, Batch == nullptr);
 			}
 			else
 			{
 				Pin->DefaultValue = ValueStr;
 			}
 
+			if (Batch)
+			{
+				Batch->ChangedNodes.Add(Node);
+			}
+
 			Results.Add(FString::Printf(TEXT("%s = %s"), *PinName, *ValueStr));
 		}
 	}
@@ -1136,7 +1394,26 @@ UEdGraphNode* FEditGraphTool::SpawnNode(UBlueprintNodeSpawner* Spawner, UEdGraph
 	return NewNode;
 }
 
-TArray<FString> FEditGraphTool::SetPinValues(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& PinValues)
+UEdGraphNode* FEditGraphTool::SpawnMaterialExpression(UMaterialGraph* Graph, UClass* ExpressionClass, const FVector2D& Position)
+{
+	if (!Graph || !ExpressionClass)
+	{
+		return nullptr;
+	}
+
+	// What FMaterialEditor::CreateNewMaterialExpression does, minus the preview update and selection
+	UMaterialExpression* Expression = UMaterialEditingLibrary::CreateMaterialExpressionEx(
+		Graph->Material, Graph->MaterialFunction, ExpressionClass, nullptr,
+		FMath::RoundToInt(Position.X), FMath::RoundToInt(Position.Y), /*bAllowMarkingPackageDirty*/ false);
+	if (!Expression)
+	{
+		return nullptr;
+	}
+
+	return Graph->AddExpression(Expression, /*bUserInvoked*/ false);
+}
+
+TArray<FString> FEditGraphTool::SetPinValues(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& PinValues, FEditBatch* Batch)
 {
 	TArray<FString> Results;
 
@@ -1395,13 +1672,18 @@ TArray<FString> FEditGraphTool::SetPinValues(UEdGraphNode* Node, const TSharedPt
 		// Try to set the default value for other pin types
 		if (Schema)
 		{
-			Schema->TrySetDefaultValue(*Pin, ValueStr);
+			Schema->TrySetDefaultValue(*Pin, ValueStr, Batch == nullptr);
 		}
 		else
 		{
 			Pin->DefaultValue = ValueStr;
 		}
 
+		if (Batch)
+		{
+			Batch->ChangedNodes.Add(Node);
+		}
+
 		Results.Add(FString::Printf(TEXT("%s = %s"), *PinName, *ValueStr));
 	}
 
@@ -1611,7 +1893,7 @@ bool FEditGraphTool::ValidateConnectionPrerequisites(UEdGraphPin* FromPin, UEdGr
 	return true;
 }
 
-FEditGraphTool::FConnectionResult FEditGraphTool::CreateConnectionWithFallback(UEdGraphPin* FromPin, UEdGraphPin* ToPin)
+FEditGraphTool::FConnectionResult FEditGraphTool::CreateConnectionWithFallback(UEdGraphPin* FromPin, UEdGraphPin* ToPin, FEditBatch* Batch)
 {
 	FConnectionResult Result;
 
@@ -1653,8 +1935,12 @@ FEditGraphTool::FConnectionResult FEditGraphTool::CreateConnectionWithFallback(U
 	{
 		case CONNECT_RESPONSE_MAKE:
 		{
-			// Direct connection - types are compatible
-			if (Schema->TryCreateConnection(FromPin, ToPin))
+			// Direct connection - types are compatible. The material schema's override updates the
+			// Material Editor after each link; a deferred batch links the pins only and syncs at the end
+			const bool bLinked = Batch && Batch->bDeferMaterialUpdates
+				? Schema->UEdGraphSchema::TryCreateConnection(FromPin, ToPin)
+				: Schema->TryCreateConnection(FromPin, ToPin);
+			if (bLinked)
 			{
 				Result.bSuccess = true;
 				Result.Type = EConnectionResultType::Direct;
@@ -1869,139 +2155,6 @@ FString FEditGraphTool::GetNodeTypeName(UEdGraphNode* Node) const
 	return Node->GetClass()->GetName();
 }
 
-FVector2D FEditGraphTool::CalculateSmartPosition(UEdGraph* Graph, const TMap<FString, UEdGraphNode*>& NewNodesThisCall) const
-{
-	if (!Graph)
-	{
-		return FVector2D(0, 0);
-	}
-
-	// Constants for layout (width is typically consistent, height varies by pins)
-	const float DefaultNodeWidth = 250.0f;   // Typical Blueprint node width
-	const float DefaultNodeHeight = 100.0f;  // Fallback if estimation fails
-	const float SpacingX = 50.0f;            // Horizontal spacing between nodes
-	const float SpacingY = 30.0f;            // Vertical spacing between nodes
-
-	// Helper to get node dimensions
-	auto GetNodeBounds = [DefaultNodeWidth, DefaultNodeHeight](UEdGraphNode* Node) -> FVector2D
-	{
-		if (!Node)
-		{
-			return FVector2D(DefaultNodeWidth, DefaultNodeHeight);
-		}
-
-		// Use UE's built-in height estimation for K2 (Blueprint) nodes
-		float Height = UEdGraphSchema_K2::EstimateNodeHeight(Node);
-		if (Height <= 0.0f)
-		{
-			Height = DefaultNodeHeight;
-		}
-
-		// Width: use node's stored width if available, otherwise default
-		float Width = Node->NodeWidth > 0 ? static_cast<float>(Node->NodeWidth) : DefaultNodeWidth;
-
-		return FVector2D(Width, Height);
-	};
-
-	// Collect all existing node bounds
-	TArray<FBox2D> ExistingBounds;
-	float MaxX = 0.0f;
-	float MinY = 0.0f;
-	float MaxY = 0.0f;
-	bool bHasNodes = false;
-
-	// Include existing nodes in graph
-	for (UEdGraphNode* Node : Graph->Nodes)
-	{
-		if (Node)
-		{
-			float X = Node->NodePosX;
-			float Y = Node->NodePosY;
-			FVector2D Size = GetNodeBounds(Node);
-			FBox2D Bounds(FVector2D(X, Y), FVector2D(X + Size.X, Y + Size.Y));
-			ExistingBounds.Add(Bounds);
-
-			if (!bHasNodes)
-			{
-				MaxX = X + Size.X;
-				MinY = Y;
-				MaxY = Y + Size.Y;
-				bHasNodes = true;
-			}
-			else
-			{
-				MaxX = FMath::Max(MaxX, X + Size.X);
-				MinY = FMath::Min(MinY, Y);
-				MaxY = FMath::Max(MaxY, Y + Size.Y);
-			}
-		}
-	}
-
-	// Include nodes added in this call
-	for (const auto& Pair : NewNodesThisCall)
-	{
-		if (UEdGraphNode* Node = Pair.Value)
-		{
-			float X = Node->NodePosX;
-			float Y = Node->NodePosY;
-			FVector2D Size = GetNodeBounds(Node);
-			FBox2D Bounds(FVector2D(X, Y), FVector2D(X + Size.X, Y + Size.Y));
-			ExistingBounds.Add(Bounds);
-
-			MaxX = FMath::Max(MaxX, X + Size.X);
-			MinY = FMath::Min(MinY, Y);
-			MaxY = FMath::Max(MaxY, Y + Size.Y);
-		}
-	}
-
-	// If no existing nodes, start at origin
-	if (!bHasNodes && NewNodesThisCall.Num() == 0)
-	{
-		return FVector2D(0, 0);
-	}
-
-	// Try to place to the right of existing nodes
-	FVector2D CandidatePos(MaxX + SpacingX, MinY);
-
-	// Use a reasonable default size for overlap checking (new node size unknown yet)
-	const float NewNodeWidth = DefaultNodeWidth;
-	const float NewNodeHeight = DefaultNodeHeight;
-
-	// Check for overlap and adjust Y if needed
-	auto DoesOverlap = [&ExistingBounds, NewNodeWidth, NewNodeHeight](const FVector2D& Pos) -> bool
-	{
-		FBox2D NewBounds(Pos, FVector2D(Pos.X + NewNodeWidth, Pos.Y + NewNodeHeight));
-		for (const FBox2D& Existing : ExistingBounds)
-		{
-			// Check if bounds intersect
-			if (!(NewBounds.Max.X < Existing.Min.X || NewBounds.Min.X > Existing.Max.X ||
-				  NewBounds.Max.Y < Existing.Min.Y || NewBounds.Min.Y > Existing.Max.Y))
-			{
-				return true;
-			}
-		}
-		return false;
-	};
-
-	// If overlapping, try different Y positions
-	int32 MaxAttempts = 20;
-	float YOffset = 0.0f;
-	while (DoesOverlap(CandidatePos) && MaxAttempts > 0)
-	{
-		YOffset += NewNodeHeight + SpacingY;
-		CandidatePos.Y = MinY + YOffset;
-		MaxAttempts--;
-	}
-
-	// If still overlapping after attempts, just place further right
-	if (MaxAttempts == 0)
-	{
-		CandidatePos = FVector2D(MaxX + SpacingX + NewNodeWidth, MinY);
-	}
-
-	return CandidatePos;
-}
-
 FString FEditGraphTool::FormatResults(const FString& AssetName, const FString& GraphName,
                                        const TArray<FAddedNode>& AddedNodes,
                                        const TArray<FString>& Connections,
@@ -2009,36 +2162,37 @@ FString FEditGraphTool::FormatResults(const FString& AssetName, const FString& G
                                        const TArray<FString>& SetPinsResults,
                                        const TArray<FString>& Errors) const
 {
-	FString Output;
+	NeoStackToolUtils::FToolOutputWriter Output(256 + AddedNodes.Num() * 256
+		+ (Connections.Num() + Disconnections.Num() + SetPinsResults.Num() + Errors.Num()) * 96);
 
 	// Header
-	Output += FString::Printf(TEXT("# EDIT GRAPH: %s\n"), *AssetName);
-	Output += FString::Printf(TEXT("Graph: %s\n\n"), *GraphName);
+	Output.Appendf(TEXT("# EDIT GRAPH: %s\n"), *AssetName);
+	Output.Appendf(TEXT("Graph: %s\n\n"), *GraphName);
 
 	// Added nodes
 	if (AddedNodes.Num() > 0)
 	{
-		Output += FString::Printf(TEXT("## Added Nodes (%d)\n\n"), AddedNodes.Num());
+		Output.Appendf(TEXT("## Added Nodes (%d)\n\n"), AddedNodes.Num());
 
 		for (const FAddedNode& Node : AddedNodes)
 		{
-			Output += FString::Printf(TEXT("+ %s (%s) at (%.0f, %.0f)\n"),
+			Output.Appendf(TEXT("+ %s (%s) at (%.0f, %.0f)\n"),
 				*Node.Name, *Node.NodeType, Node.Position.X, Node.Position.Y);
-			Output += FString::Printf(TEXT("  GUID: %s\n"), *Node.Guid.ToString());
+			Output.Appendf(TEXT("  GUID: %s\n"), *Node.Guid.ToString());
 
 			// Show available pins for connections
 			if (Node.OutputPins.Num() > 0)
 			{
-				Output += FString::Printf(TEXT("  Out: %s\n"), *FString::Join(Node.OutputPins, TEXT(", ")));
+				Output.Append(TEXT("  Out: ")).Join(Node.OutputPins, TEXT(", ")).Newline();
 			}
 			if (Node.InputPins.Num() > 0)
 			{
-				Output += FString::Printf(TEXT("  In: %s\n"), *FString::Join(Node.InputPins, TEXT(", ")));
+				Output.Append(TEXT("  In: ")).Join(Node.InputPins, TEXT(", ")).Newline();
 			}
 
 			for (const FString& PinVal : Node.PinValues)
 			{
-				Output += FString::Printf(TEXT("  - %s\n"), *PinVal);
+				Output.Appendf(TEXT("  - %s\n"), *PinVal);
 			}
 		}
 	}
@@ -2046,61 +2200,61 @@ FString FEditGraphTool::FormatResults(const FString& AssetName, const FString& G
 	// Connections
 	if (Connections.Num() > 0)
 	{
-		Output += FString::Printf(TEXT("## Connections (%d)\n\n"), Connections.Num());
+		Output.Appendf(TEXT("## Connections (%d)\n\n"), Connections.Num());
 
 		for (const FString& Conn : Connections)
 		{
-			Output += FString::Printf(TEXT("+ %s\n"), *Conn);
+			Output.Appendf(TEXT("+ %s\n"), *Conn);
 		}
-		Output += TEXT("\n");
+		Output.Append(TEXT("\n"));
 	}
 
 	// Disconnections
 	if (Disconnections.Num() > 0)
 	{
-		Output += FString::Printf(TEXT("## Disconnections (%d)\n\n"), Disconnections.Num());
+		Output.Appendf(TEXT("## Disconnections (%d)\n\n"), Disconnections.Num());
 
 		for (const FString& Disconn : Disconnections)
 		{
-			Output += FString::Printf(TEXT("- %s\n"), *Disconn);
+			Output.Appendf(TEXT("- %s\n"), *Disconn);
 		}
-		Output += TEXT("\n");
+		Output.Append(TEXT("\n"));
 	}
 
 	// Set pins results
 	if (SetPinsResults.Num() > 0)
 	{
-		Output += FString::Printf(TEXT("## Values Set (%d)\n\n"), SetPinsResults.Num());
+		Output.Appendf(TEXT("## Values Set (%d)\n\n"), SetPinsResults.Num());
 
 		for (const FString& Result : SetPinsResults)
 		{
-			Output += FString::Printf(TEXT("+ %s\n"), *Result);
+			Output.Appendf(TEXT("+ %s\n"), *Result);
 		}
-		Output += TEXT("\n");
+		Output.Append(TEXT("\n"));
 	}
 
 	// Errors
 	if (Errors.Num() > 0)
 	{
-		Output += FString::Printf(TEXT("## Errors (%d)\n\n"), Errors.Num());
+		Output.Appendf(TEXT("## Errors (%d)\n\n"), Errors.Num());
 
 		for (const FString& Err : Errors)
 		{
-			Output += FString::Printf(TEXT("! %s\n"), *Err);
+			Output.Appendf(TEXT("! %s\n"), *Err);
 		}
-		Output += TEXT("\n");
+		Output.Append(TEXT("\n"));
 	}
 
 	// Summary
-	Output += FString::Printf(TEXT("= %d nodes added, %d connections, %d disconnections, %d values set"),
+	Output.Appendf(TEXT("= %d nodes added, %d connections, %d disconnections, %d values set"),
 		AddedNodes.Num(), Connections.Num(), Disconnections.Num(), SetPinsResults.Num());
 
 	if (Errors.Num() > 0)
 	{
-		Output += FString::Printf(TEXT(", %d errors"), Errors.Num());
+		Output.Appendf(TEXT(", %d errors"), Errors.Num());
 	}
 
-	Output += TEXT("\n");
+	Output.Append(TEXT("\n"));
 
-	return Output;
+	return Output.ToString();
 }
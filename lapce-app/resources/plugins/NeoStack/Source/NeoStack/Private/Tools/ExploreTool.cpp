@@ -2,91 +2,205 @@
 
 #include "Tools/ExploreTool.h"
 #include "Tools/NeoStackToolUtils.h"
+#include "Tools/CodeSearchEngine.h"
+#include "Tools/CodeSearchIndex.h"
+#include "Tools/BlueprintSummaryCache.h"
+#include "Tools/AssetDependencyGraph.h"
+#include "NeoStackProjectCatalog.h"
 #include "Json.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/FileManager.h"
 #include "Engine/Blueprint.h"
-#include "Engine/SCS_Node.h"
-#include "Engine/SimpleConstructionScript.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * File-system explore run asynchronously: the directory is resolved on the game thread, then
+ * the walk and code search run on a worker with the task's own tool instance, so concurrent
+ * calls never share gitignore state
+ */
+class FExploreTool::FFilesTask : public FNeoStackToolTask
+{
+public:
+	explicit FFilesTask(const FExploreRequest& InRequest)
+		: Request(InRequest)
+	{
+	}
 
-FToolResult FExploreTool::Execute(const TSharedPtr<FJsonObject>& Args)
+	virtual bool Step(double Deadline) override
+	{
+		// The second step only comes once the worker has filled in Result
+		if (bStarted)
+		{
+			return true;
+		}
+		bStarted = true;
+
+		FString Error;
+		if (!Worker.PrepareFiles(Request, FullPath, IndexCandidates, bIndexed, Error))
+		{
+			Result = FToolResult::Fail(Error);
+			return true;
+		}
+
+		ReportProgress(-1.0f, Request.Query.IsEmpty() ? TEXT("listing files") : TEXT("searching code"));
+		RunOnWorker([this]()
+		{
+			Result = Worker.ScanFiles(Request, FullPath, bIndexed ? &IndexCandidates : nullptr);
+		});
+		return false;
+	}
+
+private:
+	FExploreRequest Request;
+	FExploreTool Worker;
+	FString FullPath;
+	TArray<FString> IndexCandidates;
+	bool bIndexed = false;
+	bool bStarted = false;
+};
+
+bool FExploreTool::FExploreRequest::IsAssetSearch() const
 {
-	FString Path, Pattern, Query, Type;
-	int32 Offset = 0;
-	int32 Limit = 50;
-	int32 Context = 0;
-	bool bRecursive = true;
-	FBlueprintFilter Filter;
-
-	Args->TryGetStringField(TEXT("path"), Path);
-	Args->TryGetStringField(TEXT("pattern"), Pattern);
-	Args->TryGetStringField(TEXT("query"), Query);
-	Args->TryGetStringField(TEXT("type"), Type);
-	Args->TryGetNumberField(TEXT("offset"), Offset);
-	Args->TryGetNumberField(TEXT("limit"), Limit);
-	Args->TryGetNumberField(TEXT("context"), Context);
-	Args->TryGetBoolField(TEXT("recursive"), bRecursive);
+	return IsDependencyQuery() || Path.StartsWith(TEXT("/Game")) ||
+		Type.Equals(TEXT("blueprints"), ESearchCase::IgnoreCase) ||
+		Type.Equals(TEXT("materials"), ESearchCase::IgnoreCase) ||
+		Type.Equals(TEXT("textures"), ESearchCase::IgnoreCase) ||
+		Type.Equals(TEXT("assets"), ESearchCase::IgnoreCase);
+}
+
+bool FExploreTool::FExploreRequest::IsDependencyQuery() const
+{
+	return Type.Equals(TEXT("dependencies"), ESearchCase::IgnoreCase);
+}
+
+FExploreTool::FExploreRequest FExploreTool::ParseRequest(const TSharedPtr<FJsonObject>& Args)
+{
+	FExploreRequest Request;
+
+	Args->TryGetStringField(TEXT("path"), Request.Path);
+	Args->TryGetStringField(TEXT("pattern"), Request.Pattern);
+	Args->TryGetStringField(TEXT("query"), Request.Query);
+	Args->TryGetStringField(TEXT("type"), Request.Type);
+	Args->TryGetNumberField(TEXT("offset"), Request.Offset);
+	Args->TryGetNumberField(TEXT("limit"), Request.Limit);
+	Args->TryGetNumberField(TEXT("context"), Request.Context);
+	Args->TryGetBoolField(TEXT("recursive"), Request.bRecursive);
+	Args->TryGetStringField(TEXT("direction"), Request.Direction);
+	Args->TryGetNumberField(TEXT("depth"), Request.Depth);
 
 	// Parse filter object
 	const TSharedPtr<FJsonObject>* FilterObj;
 	if (Args->TryGetObjectField(TEXT("filter"), FilterObj))
 	{
-		(*FilterObj)->TryGetStringField(TEXT("parent"), Filter.Parent);
-		(*FilterObj)->TryGetStringField(TEXT("component"), Filter.Component);
-		(*FilterObj)->TryGetStringField(TEXT("interface"), Filter.Interface);
-		(*FilterObj)->TryGetStringField(TEXT("references"), Filter.References);
-		(*FilterObj)->TryGetStringField(TEXT("referenced_by"), Filter.ReferencedBy);
+		(*FilterObj)->TryGetStringField(TEXT("parent"), Request.Filter.Parent);
+		(*FilterObj)->TryGetStringField(TEXT("component"), Request.Filter.Component);
+		(*FilterObj)->TryGetStringField(TEXT("interface"), Request.Filter.Interface);
+		(*FilterObj)->TryGetStringField(TEXT("references"), Request.Filter.References);
+		(*FilterObj)->TryGetStringField(TEXT("referenced_by"), Request.Filter.ReferencedBy);
 	}
 
 	// Default type
-	if (Type.IsEmpty())
+	if (Request.Type.IsEmpty())
 	{
-		Type = TEXT("all");
+		Request.Type = TEXT("all");
 	}
 
 	// Clamp values
-	Offset = FMath::Max(0, Offset);
-	Limit = FMath::Clamp(Limit, 1, 200);
-	Context = FMath::Clamp(Context, 0, 10);
+	Request.Offset = FMath::Max(0, Request.Offset);
+	Request.Limit = FMath::Clamp(Request.Limit, 1, 200);
+	Request.Context = FMath::Clamp(Request.Context, 0, 10);
+	Request.Depth = FMath::Clamp(Request.Depth, 1, 10);
 
-	// Route based on path and type
-	bool bIsAssetSearch = Path.StartsWith(TEXT("/Game")) ||
-		Type.Equals(TEXT("blueprints"), ESearchCase::IgnoreCase) ||
-		Type.Equals(TEXT("materials"), ESearchCase::IgnoreCase) ||
-		Type.Equals(TEXT("textures"), ESearchCase::IgnoreCase) ||
-		Type.Equals(TEXT("assets"), ESearchCase::IgnoreCase);
+	return Request;
+}
+
+bool FExploreTool::IsCacheable(const TSharedPtr<FJsonObject>& Args) const
+{
+	// File listings and code searches read files edited outside the editor, which nothing invalidates
+	return Args.IsValid() && ParseRequest(Args).IsAssetSearch();
+}
 
-	if (bIsAssetSearch)
+FToolResult FExploreTool::Execute(const TSharedPtr<FJsonObject>& Args)
+{
+	const FExploreRequest Request = ParseRequest(Args);
+
+	// Route based on path and type
+	if (Request.IsDependencyQuery())
 	{
-		return ExploreAssets(Path, Pattern, Query, Type, Filter, Offset, Limit);
+		return ExploreDependencies(Request);
+	}
+	else if (Request.IsAssetSearch())
+	{
+		return ExploreAssets(Request.Path, Request.Pattern, Request.Query, Request.Type, Request.Filter,
+			Request.Offset, Request.Limit);
 	}
 	else
 	{
-		return ExploreFiles(Path, Pattern, Query, Type, bRecursive, Context, Offset, Limit);
+		return ExploreFiles(Request);
+	}
+}
+
+TSharedRef<FNeoStackToolTask> FExploreTool::CreateTask(const TSharedPtr<FJsonObject>& Args)
+{
+	const FExploreRequest Request = ParseRequest(Args);
+	if (Request.IsAssetSearch())
+	{
+		return FNeoStackToolBase::CreateTask(Args);
 	}
+	return MakeShared<FFilesTask>(Request);
+}
+
+FToolResult FExploreTool::ExploreFiles(const FExploreRequest& Request)
+{
+	FString FullPath, Error;
+	TArray<FString> IndexCandidates;
+	bool bIndexed = false;
+	if (!PrepareFiles(Request, FullPath, IndexCandidates, bIndexed, Error))
+	{
+		return FToolResult::Fail(Error);
+	}
+
+	return ScanFiles(Request, FullPath, bIndexed ? &IndexCandidates : nullptr);
 }
 
-FToolResult FExploreTool::ExploreFiles(const FString& Path, const FString& Pattern, const FString& Query,
-	const FString& Type, bool bRecursive, int32 Context, int32 Offset, int32 Limit)
+bool FExploreTool::PrepareFiles(const FExploreRequest& Request, FString& OutFullPath, TArray<FString>& OutIndexCandidates,
+	bool& bOutIndexed, FString& OutError)
 {
-	FString FullPath = NeoStackToolUtils::BuildFilePath(TEXT(""), Path);
+	OutFullPath = NeoStackToolUtils::BuildFilePath(TEXT(""), Request.Path);
 
-	if (!FPaths::DirectoryExists(FullPath))
+	if (!FPaths::DirectoryExists(OutFullPath))
 	{
-		return FToolResult::Fail(FString::Printf(TEXT("Directory not found: %s"), *FullPath));
+		OutError = FString::Printf(TEXT("Directory not found: %s"), *OutFullPath);
+		return false;
 	}
 
+	// The trigram index narrows the walk to files that can contain the query; it falls back
+	// to walking the directory until it covers FullPath
+	bOutIndexed = !Request.Query.IsEmpty() &&
+		FCodeSearchIndex::Get().FindCandidates(OutFullPath, Request.bRecursive, Request.Query, OutIndexCandidates);
+	return true;
+}
+
+FToolResult FExploreTool::ScanFiles(const FExploreRequest& Request, const FString& FullPath, const TArray<FString>* IndexCandidates)
+{
+	// Pick up .gitignore edits made since the last call
+	GitIgnore.Reset();
+
 	// If query is provided, search code
-	if (!Query.IsEmpty())
+	if (!Request.Query.IsEmpty())
 	{
-		return FToolResult::Ok(SearchCode(FullPath, Pattern, Query, bRecursive, Context, Offset, Limit));
+		return FToolResult::Ok(SearchCode(FullPath, Request.Pattern, Request.Query, Request.bRecursive,
+			Request.Context, Request.Offset, Request.Limit, IndexCandidates));
 	}
 
 	// Otherwise list directory
-	return FToolResult::Ok(ListDirectory(FullPath, Pattern, Type, bRecursive, Offset, Limit));
+	return FToolResult::Ok(ListDirectory(FullPath, Request.Pattern, Request.Type, Request.bRecursive,
+		Request.Offset, Request.Limit));
 }
 
 FToolResult FExploreTool::ExploreAssets(const FString& Path, const FString& Pattern, const FString& Query,
@@ -117,8 +231,6 @@ FString FExploreTool::ListDirectory(const FString& FullPath, const FString& Patt
 	TArray<FString> Folders;
 	TArray<FString> Files;
 
-	IFileManager& FileManager = IFileManager::Get();
-
 	bool bIncludeFolders = Type.Equals(TEXT("all"), ESearchCase::IgnoreCase) ||
 		Type.Equals(TEXT("folders"), ESearchCase::IgnoreCase);
 	bool bIncludeFiles = Type.Equals(TEXT("all"), ESearchCase::IgnoreCase) ||
@@ -132,7 +244,6 @@ FString FExploreTool::ListDirectory(const FString& FullPath, const FString& Patt
 		TArray<FString>& Folders;
 		TArray<FString>& Files;
 		FString BasePath;
-		FString ProjectDir;
 		FString Pattern;
 		bool bIncludeFolders;
 		bool bIncludeFiles;
@@ -143,7 +254,6 @@ FString FExploreTool::ListDirectory(const FString& FullPath, const FString& Patt
 			: Folders(InFolders), Files(InFiles), BasePath(InBasePath), Pattern(InPattern),
 			bIncludeFolders(bInFolders), bIncludeFiles(bInFiles), Tool(InTool)
 		{
-			ProjectDir = FPaths::ProjectDir();
 		}
 
 		virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
@@ -151,18 +261,8 @@ FString FExploreTool::ListDirectory(const FString& FullPath, const FString& Patt
 			FString FullName = FilenameOrDirectory;
 			FString Name = FPaths::GetCleanFilename(FullName);
 
-			// Skip hidden files/folders (except .gitignore itself)
-			if (Name.StartsWith(TEXT(".")) && !Name.Equals(TEXT(".gitignore"))) return true;
-
-			// Get path relative to project for gitignore matching
-			FString RelToProject = FullName;
-			FPaths::MakePathRelativeTo(RelToProject, *ProjectDir);
-
-			// Check gitignore
-			if (Tool->IsIgnoredByGitignore(RelToProject, bIsDirectory))
-			{
-				return true;
-			}
+			// Skip hidden files/folders (except .gitignore itself), and don't descend into them
+			if (Name.StartsWith(TEXT(".")) && !Name.Equals(TEXT(".gitignore"))) return false;
 
 			// Apply pattern filter
 			if (!Pattern.IsEmpty() && !Tool->MatchesPattern(Name, Pattern))
@@ -188,15 +288,7 @@ FString FExploreTool::ListDirectory(const FString& FullPath, const FString& Patt
 	};
 
 	FFileVisitor Visitor(Folders, Files, FullPath + TEXT("/"), Pattern, bIncludeFolders, bIncludeFiles, this);
-
-	if (bRecursive)
-	{
-		FileManager.IterateDirectoryRecursively(*FullPath, Visitor);
-	}
-	else
-	{
-		FileManager.IterateDirectory(*FullPath, Visitor);
-	}
+	IterateProjectDirectory(FullPath, bRecursive, Visitor);
 
 	// Sort
 	Folders.Sort();
@@ -210,7 +302,8 @@ FString FExploreTool::ListDirectory(const FString& FullPath, const FString& Patt
 	FString RelPath = FullPath;
 	FPaths::MakePathRelativeTo(RelPath, *FPaths::ProjectDir());
 
-	FString Output = FString::Printf(TEXT("# DIR %s folders=%d files=%d\n"), *RelPath, TotalFolders, TotalFiles);
+	NeoStackToolUtils::FToolOutputWriter Output(128 + FMath::Min(Limit, Total) * 64);
+	Output.Appendf(TEXT("# DIR %s folders=%d files=%d\n"), *RelPath, TotalFolders, TotalFiles);
 
 	// Combine and paginate
 	TArray<TPair<FString, bool>> AllItems; // path, isFolder
@@ -223,29 +316,21 @@ FString FExploreTool::ListDirectory(const FString& FullPath, const FString& Patt
 	for (int32 i = StartIdx; i < EndIdx; i++)
 	{
 		const auto& Item = AllItems[i];
-		if (Item.Value)
-		{
-			Output += FString::Printf(TEXT("D\t%s\n"), *Item.Key);
-		}
-		else
-		{
-			Output += FString::Printf(TEXT("F\t%s\n"), *Item.Key);
-		}
+		Output.Row({ Item.Value ? TEXT("D") : TEXT("F"), Item.Key });
 	}
 
 	if (EndIdx < Total)
 	{
-		Output += FString::Printf(TEXT("# MORE offset=%d remaining=%d\n"), EndIdx, Total - EndIdx);
+		Output.Appendf(TEXT("# MORE offset=%d remaining=%d\n"), EndIdx, Total - EndIdx);
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FExploreTool::SearchCode(const FString& FullPath, const FString& Pattern, const FString& Query,
-	bool bRecursive, int32 Context, int32 Offset, int32 Limit)
+	bool bRecursive, int32 Context, int32 Offset, int32 Limit, const TArray<FString>* IndexCandidates)
 {
 	TArray<FString> Files;
-	IFileManager& FileManager = IFileManager::Get();
 
 	// Default pattern for code search
 	FString SearchPattern = Pattern.IsEmpty() ? TEXT("*") : Pattern;
@@ -256,13 +341,11 @@ FString FExploreTool::SearchCode(const FString& FullPath, const FString& Pattern
 	public:
 		TArray<FString>& Files;
 		FString Pattern;
-		FString ProjectDir;
 		FExploreTool* Tool;
 
 		FCodeFileVisitor(TArray<FString>& InFiles, const FString& InPattern, FExploreTool* InTool)
 			: Files(InFiles), Pattern(InPattern), Tool(InTool)
 		{
-			ProjectDir = FPaths::ProjectDir();
 		}
 
 		virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override
@@ -270,24 +353,10 @@ FString FExploreTool::SearchCode(const FString& FullPath, const FString& Pattern
 			FString FullName = FilenameOrDirectory;
 			FString Name = FPaths::GetCleanFilename(FullName);
 
-			// Get path relative to project for gitignore matching
-			FString RelToProject = FullName;
-			FPaths::MakePathRelativeTo(RelToProject, *ProjectDir);
-
-			// Check gitignore
-			if (Tool->IsIgnoredByGitignore(RelToProject, bIsDirectory))
-			{
-				return true;
-			}
-
 			if (bIsDirectory) return true;
 
 			// Skip non-text files
-			FString Ext = FPaths::GetExtension(Name).ToLower();
-			if (Ext != TEXT("cpp") && Ext != TEXT("h") && Ext != TEXT("c") &&
-				Ext != TEXT("hpp") && Ext != TEXT("cs") && Ext != TEXT("txt") &&
-				Ext != TEXT("ini") && Ext != TEXT("json") && Ext != TEXT("xml") &&
-				Ext != TEXT("yaml") && Ext != TEXT("md") && Ext != TEXT("py"))
+			if (!FCodeSearchEngine::IsSearchableExtension(FPaths::GetExtension(Name).ToLower()))
 			{
 				return true;
 			}
@@ -302,208 +371,287 @@ FString FExploreTool::SearchCode(const FString& FullPath, const FString& Pattern
 		}
 	};
 
-	FCodeFileVisitor Visitor(Files, SearchPattern, this);
-
-	if (bRecursive)
+	if (IndexCandidates)
 	{
-		FileManager.IterateDirectoryRecursively(*FullPath, Visitor);
+		const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+		for (const FString& Candidate : *IndexCandidates)
+		{
+			FString RelToProject = Candidate;
+			FPaths::MakePathRelativeTo(RelToProject, *ProjectDir);
+			if (IsIgnoredByGitignore(RelToProject, false))
+			{
+				continue;
+			}
+			if (!SearchPattern.IsEmpty() && !MatchesPattern(FPaths::GetCleanFilename(Candidate), SearchPattern))
+			{
+				continue;
+			}
+			Files.Add(Candidate);
+		}
 	}
 	else
 	{
-		FileManager.IterateDirectory(*FullPath, Visitor);
+		FCodeFileVisitor Visitor(Files, SearchPattern, this);
+		IterateProjectDirectory(FullPath, bRecursive, Visitor);
+
+		// The walk order is platform dependent; keep pages stable
+		Files.Sort();
 	}
 
-	// Search in files
-	struct FMatch
-	{
-		FString File;
-		int32 Line;
-		FString Content;
-		TArray<FString> ContextBefore;
-		TArray<FString> ContextAfter;
-	};
+	// Search in files (parallel, stops once the requested page is filled)
+	const FCodeSearchEngine::FResult Search = FCodeSearchEngine::Search(Files, Query, Context, Offset, Limit);
 
-	TArray<FMatch> Matches;
-	FString QueryLower = Query.ToLower();
+	// Build output
+	const int32 Total = Search.TotalFound;
+	const int32 EndIdx = Offset + Search.Matches.Num();
 
-	for (const FString& FilePath : Files)
+	NeoStackToolUtils::FToolOutputWriter Output(128 + Search.Matches.Num() * (160 + Context * 160));
+	if (Search.bComplete)
 	{
-		FString Content;
-		if (!FFileHelper::LoadFileToString(Content, *FilePath))
-		{
-			continue;
-		}
-
-		TArray<FString> Lines;
-		Content.ParseIntoArrayLines(Lines);
-
-		for (int32 i = 0; i < Lines.Num(); i++)
-		{
-			if (Lines[i].ToLower().Contains(QueryLower))
-			{
-				FMatch Match;
-				Match.File = FilePath;
-				Match.Line = i + 1;
-				Match.Content = Lines[i];
-
-				// Get context
-				for (int32 j = FMath::Max(0, i - Context); j < i; j++)
-				{
-					Match.ContextBefore.Add(Lines[j]);
-				}
-				for (int32 j = i + 1; j <= FMath::Min(Lines.Num() - 1, i + Context); j++)
-				{
-					Match.ContextAfter.Add(Lines[j]);
-				}
-
-				Matches.Add(Match);
-			}
-		}
+		Output.Appendf(TEXT("# SEARCH \"%s\" matches=%d\n"), *Query, Total);
+	}
+	else
+	{
+		Output.Appendf(TEXT("# SEARCH \"%s\" matches=%d+ (stopped after this page)\n"), *Query, Total);
 	}
 
-	// Build output
-	int32 Total = Matches.Num();
-	int32 StartIdx = Offset;
-	int32 EndIdx = FMath::Min(StartIdx + Limit, Total);
-
-	FString Output = FString::Printf(TEXT("# SEARCH \"%s\" matches=%d\n"), *Query, Total);
-
-	for (int32 i = StartIdx; i < EndIdx; i++)
+	for (const FCodeSearchEngine::FMatch& M : Search.Matches)
 	{
-		const FMatch& M = Matches[i];
 		FString RelFile = M.File;
 		FPaths::MakePathRelativeTo(RelFile, *FPaths::ProjectDir());
 
-		Output += FString::Printf(TEXT("\n%s:%d\n"), *RelFile, M.Line);
+		Output.Appendf(TEXT("\n%s:%d\n"), *RelFile, M.Line);
 
 		// Context before
 		int32 CtxLineNum = M.Line - M.ContextBefore.Num();
 		for (const FString& Ctx : M.ContextBefore)
 		{
-			Output += FString::Printf(TEXT("%d\t%s\n"), CtxLineNum++, *Ctx);
+			Output.Appendf(TEXT("%d\t%s\n"), CtxLineNum++, *Ctx);
 		}
 
 		// Match line
-		Output += FString::Printf(TEXT("%d>\t%s\n"), M.Line, *M.Content);
+		Output.Appendf(TEXT("%d>\t%s\n"), M.Line, *M.Content);
 
 		// Context after
 		CtxLineNum = M.Line + 1;
 		for (const FString& Ctx : M.ContextAfter)
 		{
-			Output += FString::Printf(TEXT("%d\t%s\n"), CtxLineNum++, *Ctx);
+			Output.Appendf(TEXT("%d\t%s\n"), CtxLineNum++, *Ctx);
 		}
 	}
 
-	if (EndIdx < Total)
+	if (!Search.bComplete)
+	{
+		Output.Appendf(TEXT("\n# MORE offset=%d\n"), EndIdx);
+	}
+	else if (EndIdx < Total)
 	{
-		Output += FString::Printf(TEXT("\n# MORE offset=%d remaining=%d\n"), EndIdx, Total - EndIdx);
+		Output.Appendf(TEXT("\n# MORE offset=%d remaining=%d\n"), EndIdx, Total - EndIdx);
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FExploreTool::ListAssets(const FString& AssetPath, const FString& Pattern, const FString& Type, int32 Offset, int32 Limit)
 {
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	FNeoStackProjectCatalog& Catalog = FNeoStackProjectCatalog::Get();
+	Catalog.EnsureBuilt();
 
-	TArray<FAssetData> Assets;
-	AssetRegistry.GetAssetsByPath(FName(*AssetPath), Assets, true);
+	TArray<int32> Rows;
+	Catalog.FindInPath(AssetPath, true, Rows);
 
-	// Filter by type and pattern
-	TArray<FAssetData> FilteredAssets;
-	for (const FAssetData& Asset : Assets)
+	// The type filter depends on the class alone, so it is decided once per distinct class
+	const TCHAR* TypeNeedle = nullptr;
+	if (Type.Equals(TEXT("blueprints"), ESearchCase::IgnoreCase))
+	{
+		TypeNeedle = TEXT("Blueprint");
+	}
+	else if (Type.Equals(TEXT("materials"), ESearchCase::IgnoreCase))
 	{
-		FString AssetName = Asset.AssetName.ToString();
+		TypeNeedle = TEXT("Material");
+	}
+	else if (Type.Equals(TEXT("textures"), ESearchCase::IgnoreCase))
+	{
+		TypeNeedle = TEXT("Texture");
+	}
 
-		// Pattern filter
-		if (!Pattern.IsEmpty() && !MatchesPattern(AssetName, Pattern))
+	TBitArray<> ClassMatches(true, Catalog.NumClassIds());
+	if (TypeNeedle)
+	{
+		for (int32 ClassId = 0; ClassId < Catalog.NumClassIds(); ++ClassId)
 		{
-			continue;
+			ClassMatches[ClassId] = Catalog.GetClassPathById(ClassId).GetAssetName().ToString().Contains(TypeNeedle);
 		}
+	}
 
-		// Type filter
-		FString ClassName = Asset.AssetClassPath.GetAssetName().ToString();
-		if (Type.Equals(TEXT("blueprints"), ESearchCase::IgnoreCase))
-		{
-			if (!ClassName.Contains(TEXT("Blueprint"))) continue;
-		}
-		else if (Type.Equals(TEXT("materials"), ESearchCase::IgnoreCase))
+	// Filter by type and pattern
+	TArray<int32> FilteredRows;
+	for (const int32 Row : Rows)
+	{
+		if (!ClassMatches[Catalog.GetClassId(Row)])
 		{
-			if (!ClassName.Contains(TEXT("Material"))) continue;
+			continue;
 		}
-		else if (Type.Equals(TEXT("textures"), ESearchCase::IgnoreCase))
+
+		if (!Pattern.IsEmpty() && !MatchesPattern(Catalog.GetAssetName(Row).ToString(), Pattern))
 		{
-			if (!ClassName.Contains(TEXT("Texture"))) continue;
+			continue;
 		}
 
-		FilteredAssets.Add(Asset);
+		FilteredRows.Add(Row);
 	}
 
 	// Sort by name
-	FilteredAssets.Sort([](const FAssetData& A, const FAssetData& B) {
-		return A.AssetName.ToString() < B.AssetName.ToString();
+	FilteredRows.Sort([&Catalog](int32 A, int32 B) {
+		return Catalog.GetAssetName(A).Compare(Catalog.GetAssetName(B)) < 0;
 	});
 
 	// Build output
-	int32 Total = FilteredAssets.Num();
+	int32 Total = FilteredRows.Num();
 	int32 StartIdx = Offset;
 	int32 EndIdx = FMath::Min(StartIdx + Limit, Total);
 
-	FString Output = FString::Printf(TEXT("# ASSETS %s count=%d\n"), *AssetPath, Total);
+	NeoStackToolUtils::FToolOutputWriter Output(128 + FMath::Min(Limit, Total) * 96);
+	Output.Appendf(TEXT("# ASSETS %s count=%d\n"), *AssetPath, Total);
 
 	for (int32 i = StartIdx; i < EndIdx; i++)
 	{
-		const FAssetData& Asset = FilteredAssets[i];
-		FString ClassName = Asset.AssetClassPath.GetAssetName().ToString();
-		Output += FString::Printf(TEXT("%s\t%s\t%s\n"),
-			*Asset.AssetName.ToString(),
-			*ClassName,
-			*Asset.PackagePath.ToString());
+		const int32 Row = FilteredRows[i];
+		Output.Row({ Catalog.GetAssetName(Row).ToString(), Catalog.GetClassPath(Row).GetAssetName().ToString(), Catalog.GetPackagePath(Row) });
 	}
 
 	if (EndIdx < Total)
 	{
-		Output += FString::Printf(TEXT("# MORE offset=%d remaining=%d\n"), EndIdx, Total - EndIdx);
+		Output.Appendf(TEXT("# MORE offset=%d remaining=%d\n"), EndIdx, Total - EndIdx);
 	}
 
-	return Output;
+	return Output.ToString();
+}
+
+namespace
+{
+	/** A Blueprint that passed the catalog-only filters, with its summary once fetched */
+	struct FBlueprintCandidate
+	{
+		int32 Row = INDEX_NONE;
+		FString ParentName;
+		bool bHasParentTag = false;
+		FBlueprintSummary Summary;
+		bool bHasSummary = false;
+	};
+
+	/** Loads between garbage collections, so a cold search over /Game doesn't keep every package resident */
+	constexpr int32 LoadsPerCollection = 64;
+
+	bool FetchSummary(FBlueprintCandidate& Candidate, int32& LoadCount)
+	{
+		if (Candidate.bHasSummary)
+		{
+			return true;
+		}
+
+		// Only rows that need components, members or a missing tag get their registry entry
+		const FAssetData Asset = FNeoStackProjectCatalog::Get().GetAssetData(Candidate.Row);
+		bool bLoaded = false;
+		if (!Asset.IsValid() || !FBlueprintSummaryCache::Get().GetSummary(Asset, Candidate.Summary, bLoaded))
+		{
+			return false;
+		}
+		Candidate.bHasSummary = true;
+		if (!Candidate.bHasParentTag)
+		{
+			Candidate.ParentName = Candidate.Summary.ParentClass;
+		}
+
+		if (bLoaded && ++LoadCount % LoadsPerCollection == 0)
+		{
+			// Only the summary is kept, so the loaded Blueprints are unreferenced
+			TryCollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+		return true;
+	}
 }
 
 FString FExploreTool::SearchBlueprints(const FString& AssetPath, const FString& Pattern, const FString& Query,
 	const FBlueprintFilter& Filter, int32 Offset, int32 Limit)
 {
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_SearchBlueprints);
+	const double StartTime = FPlatformTime::Seconds();
 
-	TArray<FAssetData> Assets;
-	AssetRegistry.GetAssetsByPath(FName(*AssetPath), Assets, true);
+	FNeoStackProjectCatalog& Catalog = FNeoStackProjectCatalog::Get();
+	Catalog.EnsureBuilt();
 
-	// Filter to Blueprints and apply criteria
-	TArray<TPair<FAssetData, UBlueprint*>> MatchingBPs;
+	TArray<int32> Rows;
+	Catalog.FindInPath(AssetPath, true, Rows);
 
-	for (const FAssetData& Asset : Assets)
+	TBitArray<> BlueprintClasses(false, Catalog.NumClassIds());
+	for (int32 ClassId = 0; ClassId < Catalog.NumClassIds(); ++ClassId)
 	{
-		FString ClassName = Asset.AssetClassPath.GetAssetName().ToString();
-		if (!ClassName.Contains(TEXT("Blueprint"))) continue;
+		BlueprintClasses[ClassId] = Catalog.GetClassPathById(ClassId).GetAssetName().ToString().Contains(TEXT("Blueprint"));
+	}
+
+	// Name, parent, interface and reference filters come straight from the catalog and the
+	// dependency graph. Components and the query need a summary, which is cached per saved package.
+	TArray<FBlueprintCandidate> MatchingBPs;
+	int32 LoadCount = 0;
 
-		FString AssetName = Asset.AssetName.ToString();
-		if (!Pattern.IsEmpty() && !MatchesPattern(AssetName, Pattern))
+	// Resolved once: the packages the named assets depend on
+	TSet<FName> ReferencedBy;
+	if (!Filter.ReferencedBy.IsEmpty())
+	{
+		ReferencedBy = CollectReferencedBy(Filter.ReferencedBy);
+	}
+
+	for (const int32 Row : Rows)
+	{
+		if (!BlueprintClasses[Catalog.GetClassId(Row)]) continue;
+
+		if (!Pattern.IsEmpty() && !MatchesPattern(Catalog.GetAssetName(Row).ToString(), Pattern))
 		{
 			continue;
 		}
 
-		// Load Blueprint to check filters
-		UBlueprint* BP = Cast<UBlueprint>(Asset.GetAsset());
-		if (!BP) continue;
+		FBlueprintCandidate Candidate;
+		Candidate.Row = Row;
+		Candidate.bHasParentTag = Catalog.GetParentClass(Row, Candidate.ParentName);
+		if (!Filter.Parent.IsEmpty() && Candidate.bHasParentTag && !Candidate.ParentName.Contains(Filter.Parent))
+		{
+			continue;
+		}
+
+		bool bHasInterfacesTag = false;
+		if (!Filter.Interface.IsEmpty())
+		{
+			TArray<FString> Interfaces;
+			bHasInterfacesTag = Catalog.GetInterfaces(Row, Interfaces);
+			if (bHasInterfacesTag && !HasInterface(Interfaces, Filter.Interface)) continue;
+		}
+
+		if (!Filter.References.IsEmpty() && !ReferencesAsset(Catalog.GetPackageName(Row), Filter.References))
+		{
+			continue;
+		}
+
+		if (!Filter.ReferencedBy.IsEmpty() && !ReferencedBy.Contains(Catalog.GetPackageName(Row)))
+		{
+			continue;
+		}
 
-		if (MatchesFilter(BP, Query, Filter))
+		const bool bNeedsSummary = !Filter.Component.IsEmpty() || !Query.IsEmpty()
+			|| (!Filter.Parent.IsEmpty() && !Candidate.bHasParentTag)
+			|| (!Filter.Interface.IsEmpty() && !bHasInterfacesTag);
+		if (bNeedsSummary)
 		{
-			MatchingBPs.Add(TPair<FAssetData, UBlueprint*>(Asset, BP));
+			if (!FetchSummary(Candidate, LoadCount)) continue;
+			if (!MatchesFilter(Candidate.Summary, Query, Filter)) continue;
 		}
+
+		MatchingBPs.Add(MoveTemp(Candidate));
 	}
 
 	// Sort
-	MatchingBPs.Sort([](const auto& A, const auto& B) {
-		return A.Key.AssetName.ToString() < B.Key.AssetName.ToString();
+	MatchingBPs.Sort([&Catalog](const FBlueprintCandidate& A, const FBlueprintCandidate& B) {
+		return Catalog.GetAssetName(A.Row).Compare(Catalog.GetAssetName(B.Row)) < 0;
 	});
 
 	// Build output
@@ -511,119 +659,84 @@ FString FExploreTool::SearchBlueprints(const FString& AssetPath, const FString&
 	int32 StartIdx = Offset;
 	int32 EndIdx = FMath::Min(StartIdx + Limit, Total);
 
-	FString Output = FString::Printf(TEXT("# BLUEPRINTS %s count=%d\n"), *AssetPath, Total);
+	NeoStackToolUtils::FToolOutputWriter Output(128 + FMath::Min(Limit, Total) * 128);
+	Output.Appendf(TEXT("# BLUEPRINTS %s count=%d\n"), *AssetPath, Total);
 
 	for (int32 i = StartIdx; i < EndIdx; i++)
 	{
-		const FAssetData& Asset = MatchingBPs[i].Key;
-		UBlueprint* BP = MatchingBPs[i].Value;
-		FString ParentName = BP->ParentClass ? BP->ParentClass->GetName() : TEXT("None");
+		FBlueprintCandidate& Candidate = MatchingBPs[i];
+		const bool bHasSummary = FetchSummary(Candidate, LoadCount);
+		const FBlueprintSummary& Summary = Candidate.Summary;
+		const FString ParentName = Candidate.ParentName.IsEmpty() ? TEXT("None") : Candidate.ParentName;
 
-		int32 VarCount = BP->NewVariables.Num();
-		int32 CompCount = BP->SimpleConstructionScript ? BP->SimpleConstructionScript->GetAllNodes().Num() : 0;
-		int32 GraphCount = BP->UbergraphPages.Num() + BP->FunctionGraphs.Num() + BP->MacroGraphs.Num();
+		int32 VarCount = bHasSummary ? Summary.Variables.Num() : 0;
+		int32 CompCount = bHasSummary ? Summary.ComponentNames.Num() : 0;
+		int32 GraphCount = bHasSummary ? Summary.GraphCount : 0;
 
 		// Output: name, parent, path, stats
-		Output += FString::Printf(TEXT("%s\t%s\t%s\tvars=%d comps=%d graphs=%d\n"),
-			*BP->GetName(), *ParentName, *Asset.PackagePath.ToString(), VarCount, CompCount, GraphCount);
+		Output.Appendf(TEXT("%s\t%s\t%s\tvars=%d comps=%d graphs=%d\n"),
+			*Catalog.GetAssetName(Candidate.Row).ToString(), *ParentName, *Catalog.GetPackagePath(Candidate.Row), VarCount, CompCount, GraphCount);
 	}
 
 	if (EndIdx < Total)
 	{
-		Output += FString::Printf(TEXT("# MORE offset=%d remaining=%d\n"), EndIdx, Total - EndIdx);
+		Output.Appendf(TEXT("# MORE offset=%d remaining=%d\n"), EndIdx, Total - EndIdx);
 	}
 
-	return Output;
+	FBlueprintSummaryCache::Get().SaveIfDirty();
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] SearchBlueprints %s: %d assets, %d matches, %d loaded in %.1f ms"),
+		*AssetPath, Rows.Num(), Total, LoadCount, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return Output.ToString();
 }
 
-bool FExploreTool::MatchesFilter(UBlueprint* Blueprint, const FString& Query, const FBlueprintFilter& Filter)
+bool FExploreTool::MatchesFilter(const FBlueprintSummary& Summary, const FString& Query, const FBlueprintFilter& Filter)
 {
 	// Check parent class filter
 	if (!Filter.Parent.IsEmpty())
 	{
-		if (!Blueprint->ParentClass) return false;
-
-		FString ParentName = Blueprint->ParentClass->GetName();
-		if (!ParentName.Contains(Filter.Parent)) return false;
+		if (!Summary.ParentClass.Contains(Filter.Parent)) return false;
 	}
 
 	// Check component filter
 	if (!Filter.Component.IsEmpty())
 	{
-		if (!HasComponent(Blueprint, Filter.Component)) return false;
+		if (!HasComponent(Summary, Filter.Component)) return false;
 	}
 
 	// Check interface filter
 	if (!Filter.Interface.IsEmpty())
 	{
-		if (!HasInterface(Blueprint, Filter.Interface)) return false;
-	}
-
-	// Check references filter
-	if (!Filter.References.IsEmpty())
-	{
-		if (!ReferencesAsset(Blueprint, Filter.References)) return false;
+		if (!HasInterface(Summary.Interfaces, Filter.Interface)) return false;
 	}
 
 	// Check query (searches variables, functions, components)
 	if (!Query.IsEmpty())
 	{
-		bool bFound = false;
-
-		// Search in variables
-		for (const FBPVariableDescription& Var : Blueprint->NewVariables)
-		{
-			if (MatchesQuery(Var.VarName.ToString(), Query))
-			{
-				bFound = true;
-				break;
-			}
-		}
-
-		// Search in function names
-		if (!bFound)
+		auto AnyMatches = [this, &Query](const TArray<FString>& Names)
 		{
-			for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-			{
-				if (MatchesQuery(Graph->GetName(), Query))
-				{
-					bFound = true;
-					break;
-				}
-			}
-		}
+			return Names.ContainsByPredicate([this, &Query](const FString& Name) { return MatchesQuery(Name, Query); });
+		};
 
-		// Search in components
-		if (!bFound && Blueprint->SimpleConstructionScript)
+		if (!AnyMatches(Summary.Variables) && !AnyMatches(Summary.Functions) && !AnyMatches(Summary.ComponentNames))
 		{
-			for (USCS_Node* Node : Blueprint->SimpleConstructionScript->GetAllNodes())
-			{
-				if (Node && MatchesQuery(Node->GetVariableName().ToString(), Query))
-				{
-					bFound = true;
-					break;
-				}
-			}
+			return false;
 		}
-
-		if (!bFound) return false;
 	}
 
 	return true;
 }
 
-bool FExploreTool::HasComponent(UBlueprint* Blueprint, const FString& ComponentName)
+bool FExploreTool::HasComponent(const FBlueprintSummary& Summary, const FString& ComponentName)
 {
-	if (!Blueprint->SimpleConstructionScript) return false;
-
-	for (USCS_Node* Node : Blueprint->SimpleConstructionScript->GetAllNodes())
+	for (int32 i = 0; i < Summary.ComponentNames.Num(); i++)
 	{
-		if (!Node || !Node->ComponentTemplate) continue;
-
-		FString ClassName = Node->ComponentTemplate->GetClass()->GetName();
-		FString VarName = Node->GetVariableName().ToString();
+		// Nodes without a template never matched, by class or by name
+		const FString& ClassName = Summary.ComponentClasses[i];
+		if (ClassName.IsEmpty()) continue;
 
-		if (ClassName.Contains(ComponentName) || VarName.Contains(ComponentName))
+		if (ClassName.Contains(ComponentName) || Summary.ComponentNames[i].Contains(ComponentName))
 		{
 			return true;
 		}
@@ -632,11 +745,11 @@ bool FExploreTool::HasComponent(UBlueprint* Blueprint, const FString& ComponentN
 	return false;
 }
 
-bool FExploreTool::HasInterface(UBlueprint* Blueprint, const FString& InterfaceName)
+bool FExploreTool::HasInterface(const TArray<FString>& Interfaces, const FString& InterfaceName)
 {
-	for (const FBPInterfaceDescription& Interface : Blueprint->ImplementedInterfaces)
+	for (const FString& Interface : Interfaces)
 	{
-		if (Interface.Interface && Interface.Interface->GetName().Contains(InterfaceName))
+		if (Interface.Contains(InterfaceName))
 		{
 			return true;
 		}
@@ -645,16 +758,9 @@ bool FExploreTool::HasInterface(UBlueprint* Blueprint, const FString& InterfaceN
 	return false;
 }
 
-bool FExploreTool::ReferencesAsset(UBlueprint* Blueprint, const FString& AssetName)
+bool FExploreTool::ReferencesAsset(FName PackageName, const FString& AssetName)
 {
-	// Get asset references
-	TArray<FName> Dependencies;
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-
-	FString PackageName = Blueprint->GetOutermost()->GetName();
-	AssetRegistryModule.Get().GetDependencies(FName(*PackageName), Dependencies);
-
-	for (const FName& Dep : Dependencies)
+	for (const FName& Dep : FAssetDependencyGraph::Get().GetDependencies(PackageName))
 	{
 		if (Dep.ToString().Contains(AssetName))
 		{
@@ -665,6 +771,113 @@ bool FExploreTool::ReferencesAsset(UBlueprint* Blueprint, const FString& AssetNa
 	return false;
 }
 
+TSet<FName> FExploreTool::CollectReferencedBy(const FString& AssetName)
+{
+	FNeoStackProjectCatalog& Catalog = FNeoStackProjectCatalog::Get();
+	FAssetDependencyGraph& Graph = FAssetDependencyGraph::Get();
+
+	TSet<FName> Referenced;
+	TSet<FName> Sources;
+	for (int32 Row = 0; Row < Catalog.Num(); ++Row)
+	{
+		const FName PackageName = Catalog.GetPackageName(Row);
+		bool bAlreadySeen = false;
+		Sources.Add(PackageName, &bAlreadySeen);
+		if (!bAlreadySeen && PackageName.ToString().Contains(AssetName))
+		{
+			Referenced.Append(Graph.GetDependencies(PackageName));
+		}
+	}
+
+	return Referenced;
+}
+
+FToolResult FExploreTool::ExploreDependencies(const FExploreRequest& Request)
+{
+	if (Request.Path.IsEmpty())
+	{
+		return FToolResult::Fail(TEXT("path is required for type=dependencies (e.g. /Game/Characters/BP_Player)"));
+	}
+
+	// Object paths and package names both name the package
+	const FString PackageString = FPackageName::ObjectPathToPackageName(Request.Path);
+	const FName PackageName(*PackageString);
+
+	FNeoStackProjectCatalog& Catalog = FNeoStackProjectCatalog::Get();
+	Catalog.EnsureBuilt();
+	if (!FPackageName::IsScriptPackage(PackageString) && Catalog.FindByPackage(PackageName) == INDEX_NONE)
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(PackageName, Assets, true);
+		if (Assets.Num() == 0)
+		{
+			return FToolResult::Fail(FString::Printf(TEXT("Asset not found: %s"), *Request.Path));
+		}
+	}
+
+	const bool bBoth = Request.Direction.IsEmpty() || Request.Direction.Equals(TEXT("both"), ESearchCase::IgnoreCase);
+	const bool bDependencies = bBoth || Request.Direction.Equals(TEXT("dependencies"), ESearchCase::IgnoreCase);
+	const bool bReferencers = bBoth || Request.Direction.Equals(TEXT("referencers"), ESearchCase::IgnoreCase);
+	if (!bDependencies && !bReferencers)
+	{
+		return FToolResult::Fail(FString::Printf(TEXT("Unknown direction '%s'. Use dependencies, referencers or both"), *Request.Direction));
+	}
+
+	FAssetDependencyGraph& Graph = FAssetDependencyGraph::Get();
+	TArray<FAssetDependencyGraph::FVisit> Visits;
+	if (bDependencies)
+	{
+		Graph.Walk(PackageName, FAssetDependencyGraph::EDirection::Dependencies, Request.Depth, Visits);
+	}
+	if (bReferencers)
+	{
+		Graph.Walk(PackageName, FAssetDependencyGraph::EDirection::Referencers, Request.Depth, Visits);
+	}
+
+	if (!Request.Pattern.IsEmpty())
+	{
+		Visits.RemoveAll([this, &Request](const FAssetDependencyGraph::FVisit& Visit)
+		{
+			return !MatchesPattern(FPackageName::GetShortName(Visit.PackageName), Request.Pattern);
+		});
+	}
+
+	// Dependencies before referencers, nearest first, by name within a depth
+	Visits.Sort([](const FAssetDependencyGraph::FVisit& A, const FAssetDependencyGraph::FVisit& B)
+	{
+		if (A.Direction != B.Direction) return A.Direction < B.Direction;
+		if (A.Depth != B.Depth) return A.Depth < B.Depth;
+		return A.PackageName.LexicalLess(B.PackageName);
+	});
+
+	int32 Total = Visits.Num();
+	int32 StartIdx = Request.Offset;
+	int32 EndIdx = FMath::Min(StartIdx + Request.Limit, Total);
+
+	NeoStackToolUtils::FToolOutputWriter Output(128 + FMath::Min(Request.Limit, Total) * 96);
+	Output.Appendf(TEXT("# DEPENDENCIES %s depth=%d count=%d\n"), *PackageString, Request.Depth, Total);
+
+	for (int32 i = StartIdx; i < EndIdx; i++)
+	{
+		const FAssetDependencyGraph::FVisit& Visit = Visits[i];
+		const int32 Row = Catalog.FindByPackage(Visit.PackageName);
+		const FString ClassName = Row != INDEX_NONE ? Catalog.GetClassPath(Row).GetAssetName().ToString() : FString();
+
+		// Output: direction, depth, package, class (empty outside /Game)
+		Output.Appendf(TEXT("%s\t%d\t%s\t%s\n"),
+			Visit.Direction == FAssetDependencyGraph::EDirection::Dependencies ? TEXT("dep") : TEXT("ref"),
+			Visit.Depth, *Visit.PackageName.ToString(), *ClassName);
+	}
+
+	if (EndIdx < Total)
+	{
+		Output.Appendf(TEXT("# MORE offset=%d remaining=%d\n"), EndIdx, Total - EndIdx);
+	}
+
+	return FToolResult::Ok(Output.ToString());
+}
+
 bool FExploreTool::MatchesQuery(const FString& Text, const FString& Query)
 {
 	return Text.Contains(Query);
@@ -712,82 +925,38 @@ bool FExploreTool::MatchesPattern(const FString& Name, const FString& Pattern)
 	return NameLower == PatternLower;
 }
 
-void FExploreTool::LoadGitIgnorePatterns()
+bool FExploreTool::IsIgnoredByGitignore(const FString& RelativePath, bool bIsDirectory)
 {
-	if (bGitIgnoreLoaded) return;
-	bGitIgnoreLoaded = true;
-
-	FString GitIgnorePath = FPaths::Combine(FPaths::ProjectDir(), TEXT(".gitignore"));
-	FString Content;
-
-	if (FFileHelper::LoadFileToString(Content, *GitIgnorePath))
-	{
-		TArray<FString> Lines;
-		Content.ParseIntoArrayLines(Lines);
-
-		for (const FString& Line : Lines)
-		{
-			FString Trimmed = Line.TrimStartAndEnd();
-			// Skip empty lines and comments
-			if (Trimmed.IsEmpty() || Trimmed.StartsWith(TEXT("#")))
-			{
-				continue;
-			}
-			GitIgnorePatterns.Add(Trimmed);
-		}
-
-		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Loaded %d gitignore patterns"), GitIgnorePatterns.Num());
-	}
+	return GitIgnore.IsIgnored(RelativePath, bIsDirectory);
 }
 
-bool FExploreTool::IsIgnoredByGitignore(const FString& RelativePath, bool bIsDirectory)
+void FExploreTool::IterateProjectDirectory(const FString& FullPath, bool bRecursive, IPlatformFile::FDirectoryVisitor& Visitor)
 {
-	LoadGitIgnorePatterns();
-
-	// Normalize path separators
-	FString NormalizedPath = RelativePath.Replace(TEXT("\\"), TEXT("/"));
-	if (NormalizedPath.StartsWith(TEXT("/")))
-	{
-		NormalizedPath = NormalizedPath.Mid(1);
-	}
-
-	// Get just the filename for simple pattern matching
-	FString FileName = FPaths::GetCleanFilename(NormalizedPath);
+	const FString ProjectDir = FPaths::ProjectDir();
+	IFileManager& FileManager = IFileManager::Get();
 
-	for (const FString& Pattern : GitIgnorePatterns)
+	TArray<FString> Pending;
+	Pending.Add(FullPath);
+	while (Pending.Num() > 0)
 	{
-		bool bNegation = Pattern.StartsWith(TEXT("!"));
-		FString ActualPattern = bNegation ? Pattern.Mid(1) : Pattern;
-
-		// Directory-only patterns end with /
-		bool bDirOnly = ActualPattern.EndsWith(TEXT("/"));
-		if (bDirOnly)
+		const FString Directory = Pending.Pop(EAllowShrinking::No);
+		FileManager.IterateDirectory(*Directory, [&](const TCHAR* FilenameOrDirectory, bool bIsDirectory) -> bool
 		{
-			ActualPattern = ActualPattern.LeftChop(1);
-			if (!bIsDirectory) continue;
-		}
-
-		bool bMatches = false;
+			FString RelToProject = FilenameOrDirectory;
+			FPaths::MakePathRelativeTo(RelToProject, *ProjectDir);
 
-		// Pattern with slash matches full path
-		if (ActualPattern.Contains(TEXT("/")))
-		{
-			// Match against full relative path
-			bMatches = MatchesPattern(NormalizedPath, ActualPattern);
-		}
-		else
-		{
-			// Simple pattern matches any filename
-			bMatches = MatchesPattern(FileName, ActualPattern);
-		}
+			// Ignored directories are pruned, not just hidden from the results
+			if (GitIgnore.IsIgnored(RelToProject, bIsDirectory))
+			{
+				return true;
+			}
 
-		if (bMatches)
-		{
-			// Negation pattern un-ignores
-			if (bNegation) return false;
+			const bool bDescend = Visitor.Visit(FilenameOrDirectory, bIsDirectory);
+			if (bIsDirectory && bRecursive && bDescend)
+			{
+				Pending.Add(FilenameOrDirectory);
+			}
 			return true;
-		}
+		});
 	}
-
-	return false;
 }
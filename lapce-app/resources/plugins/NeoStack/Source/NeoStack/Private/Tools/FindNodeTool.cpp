@@ -1,8 +1,10 @@
 // Copyright NeoStack. All Rights Reserved.
 
 #include "Tools/FindNodeTool.h"
+#include "Tools/BlueprintCompileScheduler.h"
 #include "Tools/FuzzyMatchingUtils.h"
 #include "Tools/NeoStackToolUtils.h"
+#include "Tools/NodeSpawnerIndex.h"
 #include "Json.h"
 
 // Blueprint includes
@@ -22,7 +24,6 @@
 #include "K2Node_VariableSet.h"
 #include "K2Node_Event.h"
 #include "K2Node_MacroInstance.h"
-#include "Kismet2/KismetEditorUtilities.h"
 
 // Animation Blueprint
 #include "Animation/AnimBlueprint.h"
@@ -44,6 +45,32 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "UObject/UObjectIterator.h"
 
+/** Per-call diagnostics; enable with "log LogNeoStackFindNode Verbose" */
+DEFINE_LOG_CATEGORY_STATIC(LogNeoStackFindNode, Log, All);
+
+/** Normalize each query once; MatchesQuery then scores candidates without allocating */
+static TArray<FFuzzyQuery> PrepareQueries(const TArray<FString>& Queries)
+{
+	TArray<FFuzzyQuery> Prepared;
+	Prepared.Reserve(Queries.Num());
+	for (const FString& Query : Queries)
+	{
+		Prepared.Emplace(Query);
+	}
+	return Prepared;
+}
+
+void FFindNodeTool::GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const
+{
+	FString AssetName, Path;
+	if (!Args.IsValid() || !Args->TryGetStringField(TEXT("asset"), AssetName) || AssetName.IsEmpty())
+	{
+		return;
+	}
+	Args->TryGetStringField(TEXT("path"), Path);
+	OutKeys.Add(NeoStackToolUtils::GetResourceKey(AssetName, Path.IsEmpty() ? TEXT("/Game") : Path));
+}
+
 FToolResult FFindNodeTool::Execute(const TSharedPtr<FJsonObject>& Args)
 {
 	// Parse required parameters
@@ -240,6 +267,7 @@ TArray<FFindNodeTool::FNodeInfo> FFindNodeTool::FindNodesInBlueprint(
 	const FString& OutputTypeFilter)
 {
 	TArray<FNodeInfo> Results;
+	const TArray<FFuzzyQuery> PreparedQueries = PrepareQueries(Queries);
 
 	if (!Blueprint)
 	{
@@ -269,219 +297,164 @@ TArray<FFindNodeTool::FNodeInfo> FFindNodeTool::FindNodesInBlueprint(
 	// Get actions from BlueprintActionDatabase
 	FBlueprintActionDatabase& ActionDatabase = FBlueprintActionDatabase::Get();
 
-	// CRITICAL: Compile the Blueprint if it's dirty to ensure newly added variables/functions
-	// have their FProperty objects created. The action database creates spawners from FProperties,
-	// so variables added via edit_blueprint won't be findable until compiled.
-	UE_LOG(LogTemp, Log, TEXT("FindNode: Blueprint status before compile check: %d (UpToDate=%d)"),
-		(int32)Blueprint->Status, (int32)BS_UpToDate);
-	UE_LOG(LogTemp, Log, TEXT("FindNode: NewVariables count: %d"), Blueprint->NewVariables.Num());
-	for (const FBPVariableDescription& Var : Blueprint->NewVariables)
-	{
-		UE_LOG(LogTemp, Log, TEXT("FindNode: Variable in NewVariables: %s"), *Var.VarName.ToString());
-	}
+	// Newly added variables/functions only reach the action database once they exist as
+	// FProperty/UFunction objects. The skeleton class is enough for that, so regenerate it
+	// instead of running a full compile when something is missing from it.
+	RefreshSkeletonIfStale(Blueprint);
 
-	if (Blueprint->Status != BS_UpToDate)
+	// Refresh actions for this Blueprint to pick up newly added variables/functions
+	// The action database caches actions and won't see new variables until refreshed
+	UE_LOG(LogNeoStackFindNode, Verbose, TEXT("FindNode: Refreshing action database..."));
+	ActionDatabase.RefreshAssetActions(Blueprint);
+
+	// The index re-reads only owners the refresh above (or an OnChanged) marked dirty
+	FNodeSpawnerIndex& SpawnerIndex = FNodeSpawnerIndex::Get();
+	SpawnerIndex.WatchBlueprint(Blueprint);
+	SpawnerIndex.Sync(TargetGraph);
+
+	TSet<int32> Candidates;
+	for (const FString& Query : Queries)
 	{
-		UE_LOG(LogTemp, Log, TEXT("FindNode: Compiling Blueprint..."));
-		FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
-		UE_LOG(LogTemp, Log, TEXT("FindNode: Blueprint status after compile: %d"), (int32)Blueprint->Status);
+		SpawnerIndex.FindCandidates(Query, Candidates);
 	}
+	UE_LOG(LogNeoStackFindNode, Verbose, TEXT("FindNode: %d candidates of %d indexed spawners"), Candidates.Num(), SpawnerIndex.GetCount());
 
-	// Check if GeneratedClass has the property
-	if (Blueprint->GeneratedClass)
+	// Get the graph schema for compatibility checking
+	const UEdGraphSchema* GraphSchema = TargetGraph->GetSchema();
+
+	for (const int32 EntryIndex : Candidates)
 	{
-		UE_LOG(LogTemp, Log, TEXT("FindNode: GeneratedClass exists: %s"), *Blueprint->GeneratedClass->GetName());
-		for (TFieldIterator<FProperty> It(Blueprint->GeneratedClass); It; ++It)
+		FNodeSpawnerIndex::FEntry& Entry = SpawnerIndex.GetEntry(EntryIndex);
+		UBlueprintNodeSpawner* Spawner = Entry.Spawner.Get();
+		if (!Spawner || !Spawner->NodeClass)
 		{
-			UE_LOG(LogTemp, Log, TEXT("FindNode: Property in GeneratedClass: %s"), *It->GetName());
+			continue;
 		}
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("FindNode: GeneratedClass is NULL!"));
-	}
 
-	// Refresh actions for this Blueprint to pick up newly added variables/functions
-	// The action database caches actions and won't see new variables until refreshed
-	UE_LOG(LogTemp, Log, TEXT("FindNode: Refreshing action database..."));
-	ActionDatabase.RefreshAssetActions(Blueprint);
-	const FBlueprintActionDatabase::FActionRegistry& AllActions = ActionDatabase.GetAllActions();
-	UE_LOG(LogTemp, Log, TEXT("FindNode: Total actions in database: %d"), AllActions.Num());
+		// Check category filter
+		if (!CategoryFilter.IsEmpty() && !MatchesCategory(Entry.Category, CategoryFilter))
+		{
+			continue;
+		}
 
-	// Get the graph schema for compatibility checking
-	const UEdGraphSchema* GraphSchema = TargetGraph->GetSchema();
+		// Check query match
+		FString MatchedQuery;
+		int32 Score = 0;
+		if (!MatchesQuery(Entry.Name, Entry.Keywords, PreparedQueries, MatchedQuery, Score))
+		{
+			continue;
+		}
 
-	int32 VarSpawnerCount = 0;
-	for (const auto& ActionPair : AllActions)
-	{
-		for (UBlueprintNodeSpawner* Spawner : ActionPair.Value)
+		// Check if this node type is compatible with the graph's schema
+		UEdGraphNode* NodeCDO = Spawner->NodeClass->GetDefaultObject<UEdGraphNode>();
+		if (!NodeCDO || !NodeCDO->CanCreateUnderSpecifiedSchema(GraphSchema))
 		{
-			if (!Spawner || !Spawner->NodeClass)
-			{
-				continue;
-			}
+			continue;
+		}
 
-			// Log variable spawners specifically
-			bool bIsVarSpawner = false;
-			if (const UBlueprintVariableNodeSpawner* VarSpawner = Cast<UBlueprintVariableNodeSpawner>(Spawner))
+		// Pin info and flags come from the template node, once per spawner
+		if (!Entry.bPinsCached)
+		{
+			UEdGraphNode* TemplateNode = Spawner->GetTemplateNode(TargetGraph);
+			if (TemplateNode)
 			{
-				bIsVarSpawner = true;
-				VarSpawnerCount++;
-				if (FProperty const* VarProp = VarSpawner->GetVarProperty())
+				if (TemplateNode->Pins.Num() == 0)
 				{
-					UClass* OwnerClass = VarProp->GetOwnerClass();
-					UE_LOG(LogTemp, Log, TEXT("FindNode: Found VarSpawner for property: %s (Owner: %s, NodeClass: %s)"),
-						*VarProp->GetName(),
-						OwnerClass ? *OwnerClass->GetName() : TEXT("null"),
-						Spawner->NodeClass ? *Spawner->NodeClass->GetName() : TEXT("null"));
+					TemplateNode->AllocateDefaultPins();
 				}
+				ExtractPinInfo(TemplateNode, Entry.InputPins, Entry.OutputPins);
+				ExtractNodeFlags(TemplateNode, Entry.Flags);
 			}
+			Entry.bPinsCached = true;
+		}
 
-			// Check if this node type is compatible with the graph's schema
-			UEdGraphNode* NodeCDO = Spawner->NodeClass->GetDefaultObject<UEdGraphNode>();
-			if (!NodeCDO || !NodeCDO->CanCreateUnderSpecifiedSchema(GraphSchema))
-			{
-				if (bIsVarSpawner)
-				{
-					UE_LOG(LogTemp, Warning, TEXT("FindNode: VarSpawner FILTERED by schema check! NodeCDO=%s, Schema=%s"),
-						NodeCDO ? TEXT("valid") : TEXT("null"),
-						GraphSchema ? *GraphSchema->GetClass()->GetName() : TEXT("null"));
-				}
-				continue;
-			}
+		// Check pin type filters - skip nodes that don't match
+		if (!MatchesPinType(Entry.InputPins, InputTypeFilter))
+		{
+			continue;
+		}
+		if (!MatchesPinType(Entry.OutputPins, OutputTypeFilter))
+		{
+			continue;
+		}
 
-			// Get UI spec for menu name, category, etc.
-			const FBlueprintActionUiSpec& UiSpec = Spawner->PrimeDefaultUiSpec(TargetGraph);
+		// Create node info
+		FNodeInfo Info;
+		Info.Name = Entry.Name;
+		Info.SpawnerId = Entry.SpawnerId;
+		Info.Category = Entry.Category;
+		Info.Tooltip = Entry.Tooltip;
+		Info.Keywords = Entry.Keywords;
+		Info.InputPins = Entry.InputPins;
+		Info.OutputPins = Entry.OutputPins;
+		Info.Flags = Entry.Flags;
+		Info.MatchedQuery = MatchedQuery;
+		Info.Score = Score;
 
-			FString NodeName = UiSpec.MenuName.ToString();
-			FString NodeCategory = UiSpec.Category.ToString();
-			FString NodeKeywords = UiSpec.Keywords.ToString();
-			FString NodeTooltip = UiSpec.Tooltip.ToString();
+		Results.Add(MoveTemp(Info));
+	}
 
-			// For variable spawners, generate fallback name from property if UiSpec is empty
-			if (const UBlueprintVariableNodeSpawner* VarSpawner = Cast<UBlueprintVariableNodeSpawner>(Spawner))
-			{
-				UE_LOG(LogTemp, Log, TEXT("FindNode: VarSpawner UiSpec - Name: '%s', Category: '%s', Keywords: '%s'"),
-					*NodeName, *NodeCategory, *NodeKeywords);
+	UE_LOG(LogNeoStackFindNode, Verbose, TEXT("FindNode: Summary - Total results matching query: %d"), Results.Num());
 
-				// If MenuName is empty, construct it from the property name
-				if (NodeName.IsEmpty())
-				{
-					if (FProperty const* VarProp = VarSpawner->GetVarProperty())
-					{
-						FString PropName = VarProp->GetName();
-						// Convert to display name (adds spaces for CamelCase)
-						FString DisplayName = FName::NameToDisplayString(PropName, false);
-						bool bIsGetter = Spawner->NodeClass && Spawner->NodeClass->IsChildOf(UK2Node_VariableGet::StaticClass());
-						NodeName = FString::Printf(TEXT("%s %s"), bIsGetter ? TEXT("Get") : TEXT("Set"), *DisplayName);
-						// Also add the raw property name as a keyword for better matching
-						if (NodeKeywords.IsEmpty())
-						{
-							NodeKeywords = PropName.ToLower();
-						}
-						else
-						{
-							NodeKeywords += TEXT(" ") + PropName.ToLower();
-						}
-						UE_LOG(LogTemp, Log, TEXT("FindNode: VarSpawner fallback name: '%s', added keyword: '%s'"),
-							*NodeName, *PropName);
-					}
-				}
-			}
+	return Results;
+}
 
-			// Skip empty names
-			if (NodeName.IsEmpty())
-			{
-				continue;
-			}
+bool FFindNodeTool::RefreshSkeletonIfStale(UBlueprint* Blueprint) const
+{
+	if (!Blueprint || Blueprint->Status == BS_UpToDate)
+	{
+		return false;
+	}
 
-			// Check category filter
-			if (!CategoryFilter.IsEmpty() && !MatchesCategory(NodeCategory, CategoryFilter))
-			{
-				continue;
-			}
+	UE_LOG(LogNeoStackFindNode, Verbose, TEXT("FindNode: Blueprint status %d (UpToDate=%d), %d NewVariables"),
+		(int32)Blueprint->Status, (int32)BS_UpToDate, Blueprint->NewVariables.Num());
 
-			// Check query match
-			FString MatchedQuery;
-			int32 Score = 0;
-			if (!MatchesQuery(NodeName, NodeKeywords, Queries, MatchedQuery, Score))
-			{
-				continue;
-			}
+	UClass* SkeletonClass = Blueprint->SkeletonGeneratedClass;
+	bool bStale = (SkeletonClass == nullptr);
 
-			// Generate a unique spawner ID
-			// IMPORTANT: UBlueprintVariableNodeSpawner has a bug where GetSpawnerSignature()
-			// doesn't include the property for member variables - all getters have the same GUID!
-			// We fix this by using property path for variable spawners.
-			FString SpawnerId;
-			if (const UBlueprintVariableNodeSpawner* VarSpawner = Cast<UBlueprintVariableNodeSpawner>(Spawner))
-			{
-				if (FProperty const* VarProp = VarSpawner->GetVarProperty())
-				{
-					// Use property path as unique identifier for member variables
-					// Format: VARGET:PropertyPath or VARSET:PropertyPath
-					bool bIsGetter = Spawner->NodeClass && Spawner->NodeClass->IsChildOf(UK2Node_VariableGet::StaticClass());
-					SpawnerId = FString::Printf(TEXT("%s:%s"),
-						bIsGetter ? TEXT("VARGET") : TEXT("VARSET"),
-						*VarProp->GetPathName());
-				}
-				else
-				{
-					// Local variable - the GUID should work (signature includes local var info)
-					FGuid SpawnerGuid = Spawner->GetSpawnerSignature().AsGuid();
-					SpawnerId = SpawnerGuid.ToString();
-				}
-			}
-			else
+	if (!bStale)
+	{
+		for (const FBPVariableDescription& Var : Blueprint->NewVariables)
+		{
+			if (!FindFProperty<FProperty>(SkeletonClass, Var.VarName))
 			{
-				// All other spawner types - use GUID (signatures work correctly)
-				FGuid SpawnerGuid = Spawner->GetSpawnerSignature().AsGuid();
-				SpawnerId = SpawnerGuid.ToString();
+				UE_LOG(LogNeoStackFindNode, Verbose, TEXT("FindNode: Variable %s missing from skeleton"), *Var.VarName.ToString());
+				bStale = true;
+				break;
 			}
+		}
+	}
 
-			// Create node info
-			FNodeInfo Info;
-			Info.Name = NodeName;
-			Info.SpawnerId = SpawnerId;
-			Info.Category = NodeCategory;
-			Info.Tooltip = NodeTooltip;
-			Info.Keywords = NodeKeywords;
-			Info.MatchedQuery = MatchedQuery;
-			Info.Score = Score;
-
-			// Try to get pin info and flags from template node
-			if (TargetGraph)
+	if (!bStale)
+	{
+		for (const UEdGraph* Graph : Blueprint->FunctionGraphs)
+		{
+			if (Graph && !SkeletonClass->FindFunctionByName(Graph->GetFName(), EIncludeSuperFlag::ExcludeSuper))
 			{
-				UEdGraphNode* TemplateNode = Spawner->GetTemplateNode(TargetGraph);
-				if (TemplateNode)
-				{
-					if (TemplateNode->Pins.Num() == 0)
-					{
-						TemplateNode->AllocateDefaultPins();
-					}
-					ExtractPinInfo(TemplateNode, Info.InputPins, Info.OutputPins);
-					ExtractNodeFlags(TemplateNode, Info.Flags);
-				}
+				UE_LOG(LogNeoStackFindNode, Verbose, TEXT("FindNode: Function %s missing from skeleton"), *Graph->GetName());
+				bStale = true;
+				break;
 			}
+		}
+	}
 
-			// Check pin type filters - skip nodes that don't match
-			if (!MatchesPinType(Info.InputPins, InputTypeFilter))
-			{
-				continue;
-			}
-			if (!MatchesPinType(Info.OutputPins, OutputTypeFilter))
-			{
-				continue;
-			}
+	if (!bStale)
+	{
+		return false;
+	}
 
-			Results.Add(Info);
+	// Through the scheduler, so an edit of this batch waiting to compile is flushed rather than compiled twice
+	FBlueprintCompileScheduler::Get().RegenerateSkeleton(Blueprint);
+
+	if (UE_LOG_ACTIVE(LogNeoStackFindNode, VeryVerbose) && Blueprint->SkeletonGeneratedClass)
+	{
+		for (TFieldIterator<FProperty> It(Blueprint->SkeletonGeneratedClass); It; ++It)
+		{
+			UE_LOG(LogNeoStackFindNode, VeryVerbose, TEXT("FindNode: Skeleton property %s"), *It->GetName());
 		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("FindNode: Summary - VarSpawners found: %d, Total results matching query: %d"),
-		VarSpawnerCount, Results.Num());
-
-	return Results;
+	return true;
 }
 
 TArray<FFindNodeTool::FNodeInfo> FFindNodeTool::FindNodesInBehaviorTree(
@@ -490,6 +463,7 @@ TArray<FFindNodeTool::FNodeInfo> FFindNodeTool::FindNodesInBehaviorTree(
 	const FString& CategoryFilter)
 {
 	TArray<FNodeInfo> Results;
+	const TArray<FFuzzyQuery> PreparedQueries = PrepareQueries(Queries);
 
 	// Get all BT node classes using TObjectIterator
 	TArray<UClass*> BTNodeClasses;
@@ -543,7 +517,7 @@ TArray<FFindNodeTool::FNodeInfo> FFindNodeTool::FindNodesInBehaviorTree(
 		// Check query match
 		FString MatchedQuery;
 		int32 Score = 0;
-		if (!MatchesQuery(DisplayName, TEXT(""), Queries, MatchedQuery, Score))
+		if (!MatchesQuery(DisplayName, TEXT(""), PreparedQueries, MatchedQuery, Score))
 		{
 			continue;
 		}
@@ -568,6 +542,7 @@ TArray<FFindNodeTool::FNodeInfo> FFindNodeTool::FindNodesInMaterial(
 	const FString& CategoryFilter)
 {
 	TArray<FNodeInfo> Results;
+	const TArray<FFuzzyQuery> PreparedQueries = PrepareQueries(Queries);
 
 	// Iterate all MaterialExpression classes
 	for (TObjectIterator<UClass> It; It; ++It)
@@ -621,7 +596,7 @@ TArray<FFindNodeTool::FNodeInfo> FFindNodeTool::FindNodesInMaterial(
 		// Check query match
 		FString MatchedQuery;
 		int32 Score = 0;
-		if (!MatchesQuery(NodeName, TEXT(""), Queries, MatchedQuery, Score))
+		if (!MatchesQuery(NodeName, TEXT(""), PreparedQueries, MatchedQuery, Score))
 		{
 			continue;
 		}
@@ -839,10 +814,8 @@ FString FFindNodeTool::PinTypeToString(const FEdGraphPinType& PinType) const
 	return TypeName;
 }
 
-bool FFindNodeTool::MatchesQuery(const FString& NodeName, const FString& Keywords, const TArray<FString>& Queries, FString& OutMatchedQuery, int32& OutScore) const
+bool FFindNodeTool::MatchesQuery(const FString& NodeName, const FString& Keywords, const TArray<FFuzzyQuery>& Queries, FString& OutMatchedQuery, int32& OutScore) const
 {
-	FString LowerName = NodeName.ToLower();
-	FString LowerKeywords = Keywords.ToLower();
 	OutScore = 0;
 
 	// Scoring weights:
@@ -851,20 +824,18 @@ bool FFindNodeTool::MatchesQuery(const FString& NodeName, const FString& Keyword
 	// 60  = Query is a word in name (word boundary match)
 	// 50  = Normalized match (spaces removed) - handles "getmyint" matching "Get My Int"
 	// 40  = Name contains query as substring
-	// 35  = Acronym match (e.g., "mvm" -> "Move Mouse Vertically")  [NEW]
-	// 30  = Levenshtein similarity >= 70% (typo tolerance)  [NEW]
+	// 35  = Acronym match (e.g., "mvm" -> "Move Mouse Vertically")
+	// 30  = Levenshtein similarity >= 70% (typo tolerance)
 	// 20  = Keyword match
 	// 15  = Normalized keyword match (spaces removed)
-
-	// Create normalized versions (no spaces) for fuzzy matching
-	// This handles cases like query "getmyint" matching "Get My Int"
-	FString NormalizedName = LowerName.Replace(TEXT(" "), TEXT(""));
+	//
+	// This runs for every candidate, so all comparisons are case-insensitive on the original
+	// strings against the prepared queries rather than on lowercased copies.
 
 	// Helper to check word boundary match on original (non-lowercased) text
 	auto MatchesWithWordBoundary = [](const FString& OriginalText, const FString& LowerQuery) -> bool
 	{
-		FString LowerText = OriginalText.ToLower();
-		int32 Index = LowerText.Find(LowerQuery, ESearchCase::CaseSensitive);
+		int32 Index = OriginalText.Find(LowerQuery, ESearchCase::IgnoreCase);
 		if (Index == INDEX_NONE)
 		{
 			return false;
@@ -884,37 +855,38 @@ bool FFindNodeTool::MatchesQuery(const FString& NodeName, const FString& Keyword
 		return bStartOk && bEndOk;
 	};
 
-	for (const FString& Query : Queries)
+	for (const FFuzzyQuery& Query : Queries)
 	{
+		const FString& LowerQuery = Query.Lower;
 		int32 CurrentScore = 0;
 
 		// Check exact name match (case-insensitive)
-		if (LowerName.Equals(Query))
+		if (NodeName.Equals(LowerQuery, ESearchCase::IgnoreCase))
 		{
 			CurrentScore = 100;
 		}
 		// Check if name starts with query
-		else if (LowerName.StartsWith(Query))
+		else if (NodeName.StartsWith(LowerQuery, ESearchCase::IgnoreCase))
 		{
 			CurrentScore = 80;
 		}
 		// Check word boundary match in name
-		else if (MatchesWithWordBoundary(NodeName, Query))
+		else if (MatchesWithWordBoundary(NodeName, LowerQuery))
 		{
 			CurrentScore = 60;
 		}
 		// Check normalized match (spaces removed from both)
 		// Handles "getmyint" or "get myint" matching "Get My Int"
-		else if (NormalizedName.Contains(Query.Replace(TEXT(" "), TEXT(""))))
+		else if (FFuzzyMatchingUtils::ContainsIgnoringSpaces(NodeName, Query))
 		{
 			CurrentScore = 50;
 		}
 		// Check simple contains in name (fallback, less relevant)
-		else if (LowerName.Contains(Query))
+		else if (NodeName.Contains(LowerQuery, ESearchCase::IgnoreCase))
 		{
 			CurrentScore = 40;
 		}
-		// NEW: Check acronym match (e.g., "mvm" -> "Move Mouse Vertically", "sa" -> "Spawn Actor")
+		// Check acronym match (e.g., "mvm" -> "Move Mouse Vertically", "sa" -> "Spawn Actor")
 		else
 		{
 			float AcronymScore = 0.0f;
@@ -925,11 +897,12 @@ bool FFindNodeTool::MatchesQuery(const FString& NodeName, const FString& Keyword
 			}
 		}
 
-		// NEW: Check Levenshtein similarity for typo tolerance (only if no match yet and query is substantial)
+		// Check Levenshtein similarity for typo tolerance (only if no match yet and query is substantial)
 		if (CurrentScore == 0 && Query.Len() >= 4)
 		{
-			float LevenshteinScore = FFuzzyMatchingUtils::CalculateLevenshteinScore(Query, LowerName);
-			if (LevenshteinScore >= 0.7f)  // 70% similarity threshold
+			// 70% similarity threshold; the kernel gives up as soon as it cannot be reached
+			float LevenshteinScore = FFuzzyMatchingUtils::CalculateLevenshteinScore(Query, NodeName, 0.7f);
+			if (LevenshteinScore >= 0.7f)
 			{
 				// Scale Levenshtein score (0.7-1.0) to integer score (30-40)
 				CurrentScore = 30 + (int32)((LevenshteinScore - 0.7f) * 33.0f);
@@ -937,14 +910,14 @@ bool FFindNodeTool::MatchesQuery(const FString& NodeName, const FString& Keyword
 		}
 
 		// Check keywords (if still no match from name-based checks)
-		if (CurrentScore == 0 && !LowerKeywords.IsEmpty())
+		if (CurrentScore == 0 && !Keywords.IsEmpty())
 		{
-			if (LowerKeywords.Contains(Query))
+			if (Keywords.Contains(LowerQuery, ESearchCase::IgnoreCase))
 			{
 				CurrentScore = 20;
 			}
 			// Check normalized keywords (spaces removed)
-			else if (LowerKeywords.Replace(TEXT(" "), TEXT("")).Contains(Query.Replace(TEXT(" "), TEXT(""))))
+			else if (FFuzzyMatchingUtils::ContainsIgnoringSpaces(Keywords, Query))
 			{
 				CurrentScore = 15;
 			}
@@ -953,7 +926,7 @@ bool FFindNodeTool::MatchesQuery(const FString& NodeName, const FString& Keyword
 		if (CurrentScore > OutScore)
 		{
 			OutScore = CurrentScore;
-			OutMatchedQuery = Query;
+			OutMatchedQuery = LowerQuery;
 		}
 	}
 
@@ -1006,28 +979,29 @@ FString FFindNodeTool::FormatResults(
 	const TArray<FNodeInfo>& Results,
 	int32 Limit) const
 {
-	FString Output;
+	// Each result renders to a few hundred characters
+	NeoStackToolUtils::FToolOutputWriter Output(512 + Results.Num() * 320);
 
 	// Header
-	Output += FString::Printf(TEXT("# FIND NODES in %s (%s)\n"),
+	Output.Appendf(TEXT("# FIND NODES in %s (%s)\n"),
 		*AssetName, *GraphTypeToString(GraphType));
 
 	if (!GraphName.IsEmpty())
 	{
-		Output += FString::Printf(TEXT("Graph: %s\n"), *GraphName);
+		Output.Appendf(TEXT("Graph: %s\n"), *GraphName);
 	}
 
 	// Query info
 	FString QueryStr = FString::Join(Queries, TEXT(", "));
-	Output += FString::Printf(TEXT("Query: %s\n\n"), *QueryStr);
+	Output.Appendf(TEXT("Query: %s\n\n"), *QueryStr);
 
 	// Results count
-	Output += FString::Printf(TEXT("## Results (%d found, showing top %d per query)\n\n"), Results.Num(), Limit);
+	Output.Appendf(TEXT("## Results (%d found, showing top %d per query)\n\n"), Results.Num(), Limit);
 
 	if (Results.Num() == 0)
 	{
-		Output += TEXT("No matching nodes found.\n");
-		return Output;
+		Output.Append(TEXT("No matching nodes found.\n"));
+		return Output.ToString();
 	}
 
 	// Group by matched query
@@ -1062,31 +1036,31 @@ FString FFindNodeTool::FormatResults(
 
 		if (TotalCount > Limit)
 		{
-			Output += FString::Printf(TEXT("### \"%s\" (%d of %d, +%d more)\n"),
+			Output.Appendf(TEXT("### \"%s\" (%d of %d, +%d more)\n"),
 				*Query, ShownCount, TotalCount, TotalCount - Limit);
-			Output += TEXT("    TIP: Too many results? Add input_type/output_type filter (e.g., input_type=\"array\") or category filter.\n\n");
+			Output.Append(TEXT("    TIP: Too many results? Add input_type/output_type filter (e.g., input_type=\"array\") or category filter.\n\n"));
 		}
 		else
 		{
-			Output += FString::Printf(TEXT("### \"%s\" (%d)\n\n"), *Query, TotalCount);
+			Output.Appendf(TEXT("### \"%s\" (%d)\n\n"), *Query, TotalCount);
 		}
 
 		for (int32 i = 0; i < ShownCount; ++i)
 		{
 			const FNodeInfo* Info = (*Group)[i];
 
-			Output += FString::Printf(TEXT("+ %s\n"), *Info->Name);
-			Output += FString::Printf(TEXT("  ID: %s\n"), *Info->SpawnerId);
+			Output.Appendf(TEXT("+ %s\n"), *Info->Name);
+			Output.Appendf(TEXT("  ID: %s\n"), *Info->SpawnerId);
 
 			if (!Info->Category.IsEmpty())
 			{
-				Output += FString::Printf(TEXT("  Category: %s\n"), *Info->Category);
+				Output.Appendf(TEXT("  Category: %s\n"), *Info->Category);
 			}
 
 			// Add node flags if present
 			if (Info->Flags.Num() > 0)
 			{
-				Output += FString::Printf(TEXT("  Flags: %s\n"), *FString::Join(Info->Flags, TEXT(", ")));
+				Output.Append(TEXT("  Flags: ")).Join(Info->Flags, TEXT(", ")).Newline();
 			}
 
 			// Add tooltip/description (truncate if too long)
@@ -1100,32 +1074,32 @@ FString FFindNodeTool::FormatResults(
 				{
 					Desc = Desc.Left(117) + TEXT("...");
 				}
-				Output += FString::Printf(TEXT("  Desc: %s\n"), *Desc);
+				Output.Appendf(TEXT("  Desc: %s\n"), *Desc);
 			}
 
 			// Input pins
 			if (Info->InputPins.Num() > 0)
 			{
-				Output += TEXT("  Inputs:\n");
+				Output.Append(TEXT("  Inputs:\n"));
 				for (const FString& Pin : Info->InputPins)
 				{
-					Output += FString::Printf(TEXT("    - %s\n"), *Pin);
+					Output.Appendf(TEXT("    - %s\n"), *Pin);
 				}
 			}
 
 			// Output pins
 			if (Info->OutputPins.Num() > 0)
 			{
-				Output += TEXT("  Outputs:\n");
+				Output.Append(TEXT("  Outputs:\n"));
 				for (const FString& Pin : Info->OutputPins)
 				{
-					Output += FString::Printf(TEXT("    - %s\n"), *Pin);
+					Output.Appendf(TEXT("    - %s\n"), *Pin);
 				}
 			}
 
-			Output += TEXT("\n");
+			Output.Append(TEXT("\n"));
 		}
 	}
 
-	return Output;
+	return Output.ToString();
 }
@@ -0,0 +1,106 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/FuzzyMatchingUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	/** Synthetic node titles shaped like action-database entries ("Get Actor Location", ...) */
+	void BuildBenchmarkCorpus(int32 Count, TArray<FString>& OutNames)
+	{
+		static const TCHAR* Words[] = {
+			TEXT("Get"), TEXT("Set"), TEXT("Add"), TEXT("Remove"), TEXT("Find"), TEXT("Make"), TEXT("Break"),
+			TEXT("Actor"), TEXT("Component"), TEXT("Location"), TEXT("Rotation"), TEXT("Vector"), TEXT("Transform"),
+			TEXT("World"), TEXT("Relative"), TEXT("Mouse"), TEXT("Move"), TEXT("Vertically"), TEXT("Spawn"),
+			TEXT("Timer"), TEXT("Delay"), TEXT("Array"), TEXT("Element"), TEXT("Index"), TEXT("Float"),
+			TEXT("Integer"), TEXT("String"), TEXT("Print"), TEXT("Velocity"), TEXT("Camera"), TEXT("Socket"),
+			TEXT("Overlap"), TEXT("Event"), TEXT("Begin"), TEXT("Play"), TEXT("Tick"), TEXT("Input"), TEXT("Axis")
+		};
+		const int32 WordCount = UE_ARRAY_COUNT(Words);
+
+		FRandomStream Random(0x4E53);
+		OutNames.Reset(Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			FString Name;
+			const int32 NumWords = Random.RandRange(2, 5);
+			for (int32 w = 0; w < NumWords; ++w)
+			{
+				if (w > 0)
+				{
+					Name.AppendChar(TEXT(' '));
+				}
+				Name += Words[Random.RandRange(0, WordCount - 1)];
+			}
+			OutNames.Add(MoveTemp(Name));
+		}
+	}
+
+	/**
+	 * NeoStack.BenchmarkFuzzyMatching [Candidates]
+	 * Scores a fixed query set against a synthetic corpus with the FString functions and with
+	 * the FFuzzyQuery overloads, and logs timings plus any disagreement between the two.
+	 */
+	void RunFuzzyMatchingBenchmark(const TArray<FString>& Args)
+	{
+		const int32 CandidateCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 50000;
+
+		TArray<FString> Names;
+		BuildBenchmarkCorpus(CandidateCount, Names);
+
+		const TArray<FString> Queries = { TEXT("getactorlocation"), TEXT("spwan actor"), TEXT("mvm"), TEXT("set timer"), TEXT("vectr") };
+
+		// Current API: every call lowercases (and splits) both strings
+		int32 LegacyHits = 0;
+		TArray<float> LegacyScores;
+		LegacyScores.Reserve(Names.Num() * Queries.Num());
+		const double LegacyStart = FPlatformTime::Seconds();
+		for (const FString& Query : Queries)
+		{
+			for (const FString& Name : Names)
+			{
+				float AcronymScore = 0.0f;
+				FFuzzyMatchingUtils::MatchesAsAcronym(Query, Name, AcronymScore);
+				const float Levenshtein = FFuzzyMatchingUtils::CalculateLevenshteinScore(Query, Name);
+				const float Words = FFuzzyMatchingUtils::CalculateWordMatchScore(Query, Name);
+				const float Thresholded = Levenshtein >= 0.7f ? Levenshtein : 0.0f;
+				LegacyHits += (Thresholded > 0.0f) ? 1 : 0;
+				LegacyScores.Add(AcronymScore + Thresholded * 10.0f + Words * 100.0f);
+			}
+		}
+		const double LegacyMs = (FPlatformTime::Seconds() - LegacyStart) * 1000.0;
+
+		// Prepared API: queries normalized once, bit-parallel distance with 0.7 early exit
+		int32 PreparedHits = 0;
+		int32 Mismatches = 0;
+		int32 ScoreIndex = 0;
+		const double PreparedStart = FPlatformTime::Seconds();
+		for (const FString& QueryText : Queries)
+		{
+			const FFuzzyQuery Query(QueryText);
+			for (const FString& Name : Names)
+			{
+				float AcronymScore = 0.0f;
+				FFuzzyMatchingUtils::MatchesAsAcronym(Query, Name, AcronymScore);
+				const float Levenshtein = FFuzzyMatchingUtils::CalculateLevenshteinScore(Query, Name, 0.7f);
+				const float Words = FFuzzyMatchingUtils::CalculateWordMatchScore(Query, Name);
+				PreparedHits += (Levenshtein > 0.0f) ? 1 : 0;
+				const float Combined = AcronymScore + Levenshtein * 10.0f + Words * 100.0f;
+				Mismatches += FMath::IsNearlyEqual(Combined, LegacyScores[ScoreIndex++], 1.e-4f) ? 0 : 1;
+			}
+		}
+		const double PreparedMs = (FPlatformTime::Seconds() - PreparedStart) * 1000.0;
+
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack] Fuzzy matching: %d candidates x %d queries"), Names.Num(), Queries.Num());
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack]   FString API:      %.1f ms (%d Levenshtein hits)"), LegacyMs, LegacyHits);
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack]   FFuzzyQuery API:  %.1f ms (%d Levenshtein hits), %.1fx"),
+			PreparedMs, PreparedHits, PreparedMs > 0.0 ? LegacyMs / PreparedMs : 0.0);
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack]   Score mismatches: %d"), Mismatches);
+	}
+
+	FAutoConsoleCommand BenchmarkFuzzyMatchingCommand(
+		TEXT("NeoStack.BenchmarkFuzzyMatching"),
+		TEXT("Compare the FString and FFuzzyQuery fuzzy scorers. Usage: NeoStack.BenchmarkFuzzyMatching [Candidates]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunFuzzyMatchingBenchmark));
+}
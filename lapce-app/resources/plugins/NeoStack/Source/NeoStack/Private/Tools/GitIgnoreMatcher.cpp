@@ -0,0 +1,384 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/GitIgnoreMatcher.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	/**
+	 * Match Ch against the [...] class starting at Pattern[Start]
+	 * @param OutEnd - Index just past the closing ']'
+	 * @return 1 on match, 0 on no match, -1 if the class is not closed (treat '[' literally)
+	 */
+	int32 MatchClass(const TCHAR* Pattern, int32 Start, int32 PatternLen, TCHAR Ch, int32& OutEnd)
+	{
+		int32 i = Start + 1;
+		bool bNegated = false;
+		if (i < PatternLen && (Pattern[i] == TEXT('!') || Pattern[i] == TEXT('^')))
+		{
+			bNegated = true;
+			++i;
+		}
+
+		const TCHAR LowerCh = FChar::ToLower(Ch);
+		bool bMatched = false;
+		bool bFirst = true;
+		for (; i < PatternLen; ++i)
+		{
+			// ']' right after the opening bracket is a literal
+			if (Pattern[i] == TEXT(']') && !bFirst)
+			{
+				OutEnd = i + 1;
+				return (bMatched != bNegated) ? 1 : 0;
+			}
+			bFirst = false;
+
+			TCHAR Low = Pattern[i];
+			if (Low == TEXT('\\') && i + 1 < PatternLen)
+			{
+				Low = Pattern[++i];
+			}
+
+			TCHAR High = Low;
+			if (i + 2 < PatternLen && Pattern[i + 1] == TEXT('-') && Pattern[i + 2] != TEXT(']'))
+			{
+				High = Pattern[i + 2];
+				i += 2;
+			}
+
+			if (LowerCh >= FChar::ToLower(Low) && LowerCh <= FChar::ToLower(High))
+			{
+				bMatched = true;
+			}
+		}
+		return -1;
+	}
+}
+
+void FGitIgnoreMatcher::Reset()
+{
+	RulesByDirectory.Reset();
+	DirectoryIgnored.Reset();
+}
+
+int32 FGitIgnoreMatcher::GetRuleCount() const
+{
+	int32 Count = 0;
+	for (const TPair<FString, FDirectoryRules>& Pair : RulesByDirectory)
+	{
+		Count += Pair.Value.Rules.Num();
+	}
+	return Count;
+}
+
+bool FGitIgnoreMatcher::MatchSegment(const TCHAR* Pattern, int32 PatternLen, const TCHAR* Text, int32 TextLen)
+{
+	int32 p = 0;
+	int32 t = 0;
+	int32 StarP = INDEX_NONE;
+	int32 StarT = INDEX_NONE;
+
+	while (t < TextLen)
+	{
+		if (p < PatternLen)
+		{
+			const TCHAR Ch = Pattern[p];
+			if (Ch == TEXT('*'))
+			{
+				StarP = p++;
+				StarT = t;
+				continue;
+			}
+			if (Ch == TEXT('?'))
+			{
+				++p;
+				++t;
+				continue;
+			}
+
+			bool bLiteral = true;
+			if (Ch == TEXT('['))
+			{
+				int32 End = p;
+				const int32 ClassResult = MatchClass(Pattern, p, PatternLen, Text[t], End);
+				if (ClassResult == 1)
+				{
+					p = End;
+					++t;
+					continue;
+				}
+				bLiteral = (ClassResult == -1);
+			}
+
+			if (bLiteral)
+			{
+				int32 LiteralLen = 1;
+				TCHAR Literal = Ch;
+				if (Ch == TEXT('\\') && p + 1 < PatternLen)
+				{
+					Literal = Pattern[p + 1];
+					LiteralLen = 2;
+				}
+				if (FChar::ToLower(Literal) == FChar::ToLower(Text[t]))
+				{
+					p += LiteralLen;
+					++t;
+					continue;
+				}
+			}
+		}
+
+		// Mismatch: let the last '*' swallow one more character
+		if (StarP != INDEX_NONE)
+		{
+			p = StarP + 1;
+			t = ++StarT;
+			continue;
+		}
+		return false;
+	}
+
+	while (p < PatternLen && Pattern[p] == TEXT('*'))
+	{
+		++p;
+	}
+	return p == PatternLen;
+}
+
+bool FGitIgnoreMatcher::CompileRule(const FString& Line, FRule& OutRule)
+{
+	FString Pattern = Line.TrimStartAndEnd();
+	if (Pattern.IsEmpty() || Pattern.StartsWith(TEXT("#")))
+	{
+		return false;
+	}
+
+	if (Pattern.StartsWith(TEXT("!")))
+	{
+		OutRule.bNegated = true;
+		Pattern.RightChopInline(1);
+	}
+	else if (Pattern.StartsWith(TEXT("\\")))
+	{
+		// "\#" and "\!" start literal patterns
+		Pattern.RightChopInline(1);
+	}
+
+	while (Pattern.EndsWith(TEXT("/")))
+	{
+		OutRule.bDirectoryOnly = true;
+		Pattern.LeftChopInline(1);
+	}
+
+	OutRule.bAnchored = Pattern.Contains(TEXT("/"));
+
+	TArray<FString> Segments;
+	Pattern.ParseIntoArray(Segments, TEXT("/"));
+	for (FString& Segment : Segments)
+	{
+		// Consecutive "**" mean the same as one
+		if (Segment == TEXT("**") && OutRule.Segments.Num() > 0 && OutRule.Segments.Last() == TEXT("**"))
+		{
+			continue;
+		}
+		OutRule.Segments.Add(MoveTemp(Segment));
+	}
+
+	return OutRule.Segments.Num() > 0;
+}
+
+bool FGitIgnoreMatcher::MatchSegments(const TArray<FString>& Pattern, int32 PatternIdx, const TArray<FStringView>& Path, int32 PathIdx)
+{
+	if (PatternIdx == Pattern.Num())
+	{
+		return PathIdx == Path.Num();
+	}
+
+	if (Pattern[PatternIdx] == TEXT("**"))
+	{
+		// Trailing "**" matches everything inside, but not the directory itself
+		if (PatternIdx == Pattern.Num() - 1)
+		{
+			return PathIdx < Path.Num();
+		}
+		for (int32 Skip = PathIdx; Skip <= Path.Num(); ++Skip)
+		{
+			if (MatchSegments(Pattern, PatternIdx + 1, Path, Skip))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	if (PathIdx == Path.Num())
+	{
+		return false;
+	}
+
+	const FString& Segment = Pattern[PatternIdx];
+	return MatchSegment(*Segment, Segment.Len(), Path[PathIdx].GetData(), Path[PathIdx].Len())
+		&& MatchSegments(Pattern, PatternIdx + 1, Path, PathIdx + 1);
+}
+
+const FGitIgnoreMatcher::FDirectoryRules& FGitIgnoreMatcher::GetRules(const FString& Directory)
+{
+	if (const FDirectoryRules* Existing = RulesByDirectory.Find(Directory))
+	{
+		return *Existing;
+	}
+
+	FDirectoryRules Rules;
+	Rules.BaseDir = Directory;
+
+	FString Content;
+	const FString GitIgnorePath = FPaths::Combine(FPaths::ProjectDir(), Directory, TEXT(".gitignore"));
+	if (FFileHelper::LoadFileToString(Content, *GitIgnorePath, FFileHelper::EHashOptions::None, FILEREAD_Silent))
+	{
+		TArray<FString> Lines;
+		Content.ParseIntoArrayLines(Lines);
+		for (const FString& Line : Lines)
+		{
+			FRule Rule;
+			if (CompileRule(Line, Rule))
+			{
+				Rules.Rules.Add(MoveTemp(Rule));
+			}
+		}
+		UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Loaded %d gitignore patterns from %s"), Rules.Rules.Num(), *GitIgnorePath);
+	}
+
+	return RulesByDirectory.Add(Directory, MoveTemp(Rules));
+}
+
+bool FGitIgnoreMatcher::IsIgnoredByRules(const FString& RelativePath, bool bIsDirectory)
+{
+	bool bIgnored = false;
+
+	// .gitignore files from the root down; later (deeper) matches override earlier ones
+	int32 DirEnd = 0;
+	while (true)
+	{
+		const FString Directory = RelativePath.Left(DirEnd);
+		const FDirectoryRules& Rules = GetRules(Directory);
+		if (Rules.Rules.Num() > 0)
+		{
+			const FString SubPath = RelativePath.RightChop(DirEnd);
+
+			int32 LastSlash = INDEX_NONE;
+			SubPath.FindLastChar(TEXT('/'), LastSlash);
+			const FStringView BaseName = FStringView(SubPath).RightChop(LastSlash + 1);
+
+			TArray<FStringView> PathSegments;
+			for (const FRule& Rule : Rules.Rules)
+			{
+				if (Rule.bDirectoryOnly && !bIsDirectory)
+				{
+					continue;
+				}
+
+				bool bMatches = false;
+				if (!Rule.bAnchored)
+				{
+					bMatches = MatchSegment(*Rule.Segments[0], Rule.Segments[0].Len(), BaseName.GetData(), BaseName.Len());
+				}
+				else
+				{
+					if (PathSegments.Num() == 0)
+					{
+						int32 SegmentStart = 0;
+						for (int32 i = 0; i <= SubPath.Len(); ++i)
+						{
+							if (i == SubPath.Len() || SubPath[i] == TEXT('/'))
+							{
+								PathSegments.Add(FStringView(SubPath).Mid(SegmentStart, i - SegmentStart));
+								SegmentStart = i + 1;
+							}
+						}
+					}
+					bMatches = MatchSegments(Rule.Segments, 0, PathSegments, 0);
+				}
+
+				if (bMatches)
+				{
+					bIgnored = !Rule.bNegated;
+				}
+			}
+		}
+
+		const int32 NextSlash = RelativePath.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, DirEnd);
+		if (NextSlash == INDEX_NONE)
+		{
+			break;
+		}
+		DirEnd = NextSlash + 1;
+	}
+
+	return bIgnored;
+}
+
+bool FGitIgnoreMatcher::IsDirectoryIgnored(const FString& Directory)
+{
+	if (const bool* Cached = DirectoryIgnored.Find(Directory))
+	{
+		return *Cached;
+	}
+
+	bool bIgnored = false;
+
+	int32 LastSlash = INDEX_NONE;
+	Directory.FindLastChar(TEXT('/'), LastSlash);
+	if (LastSlash != INDEX_NONE && IsDirectoryIgnored(Directory.Left(LastSlash)))
+	{
+		// Git never re-includes anything below an ignored directory
+		bIgnored = true;
+	}
+	else if (Directory.RightChop(LastSlash + 1) == TEXT(".git"))
+	{
+		bIgnored = true;
+	}
+	else
+	{
+		bIgnored = IsIgnoredByRules(Directory, true);
+	}
+
+	DirectoryIgnored.Add(Directory, bIgnored);
+	return bIgnored;
+}
+
+bool FGitIgnoreMatcher::IsIgnored(const FString& RelativePath, bool bIsDirectory)
+{
+	FString Path = RelativePath.Replace(TEXT("\\"), TEXT("/"));
+	while (Path.StartsWith(TEXT("./")))
+	{
+		Path.RightChopInline(2);
+	}
+	while (Path.StartsWith(TEXT("/")))
+	{
+		Path.RightChopInline(1);
+	}
+	while (Path.EndsWith(TEXT("/")))
+	{
+		Path.LeftChopInline(1);
+	}
+
+	// Outside the project (or still absolute after MakePathRelativeTo failed)
+	if (Path.IsEmpty() || Path.StartsWith(TEXT("../")) || Path == TEXT("..") || Path.Contains(TEXT(":")))
+	{
+		return false;
+	}
+
+	if (bIsDirectory)
+	{
+		return IsDirectoryIgnored(Path);
+	}
+
+	int32 LastSlash = INDEX_NONE;
+	Path.FindLastChar(TEXT('/'), LastSlash);
+	if (LastSlash != INDEX_NONE && IsDirectoryIgnored(Path.Left(LastSlash)))
+	{
+		return true;
+	}
+	return IsIgnoredByRules(Path, false);
+}
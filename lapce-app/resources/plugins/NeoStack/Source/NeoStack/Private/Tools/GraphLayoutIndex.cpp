@@ -0,0 +1,260 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/GraphLayoutIndex.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+#include "Algo/StableSort.h"
+
+FGraphLayoutIndex::FGraphLayoutIndex(const UEdGraph* Graph)
+{
+	if (!Graph)
+	{
+		return;
+	}
+
+	Boxes.Reserve(Graph->Nodes.Num());
+	for (const UEdGraphNode* Node : Graph->Nodes)
+	{
+		AddNode(Node);
+	}
+}
+
+FVector2D FGraphLayoutIndex::EstimateNodeSize(const UEdGraphNode* Node)
+{
+	if (!Node)
+	{
+		return FVector2D(DefaultNodeWidth, DefaultNodeHeight);
+	}
+
+	// Use UE's built-in height estimation for K2 (Blueprint) nodes
+	float Height = UEdGraphSchema_K2::EstimateNodeHeight(const_cast<UEdGraphNode*>(Node));
+	if (Height <= 0.0f)
+	{
+		Height = DefaultNodeHeight;
+	}
+
+	// Width: use node's stored width if available, otherwise default
+	const float Width = Node->NodeWidth > 0 ? static_cast<float>(Node->NodeWidth) : DefaultNodeWidth;
+
+	return FVector2D(Width, Height);
+}
+
+FIntPoint FGraphLayoutIndex::ToCell(const FVector2D& Point)
+{
+	return FIntPoint(FMath::FloorToInt32(Point.X / CellSize), FMath::FloorToInt32(Point.Y / CellSize));
+}
+
+void FGraphLayoutIndex::AddNode(const UEdGraphNode* Node)
+{
+	if (!Node)
+	{
+		return;
+	}
+
+	const FVector2D Position(Node->NodePosX, Node->NodePosY);
+	AddBounds(FBox2D(Position, Position + EstimateNodeSize(Node)));
+}
+
+void FGraphLayoutIndex::AddBounds(const FBox2D& Bounds)
+{
+	const int32 BoxIndex = Boxes.Add(Bounds);
+
+	const FIntPoint MinCell = ToCell(Bounds.Min);
+	const FIntPoint MaxCell = ToCell(Bounds.Max);
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			Cells.FindOrAdd(FIntPoint(CellX, CellY)).Add(BoxIndex);
+		}
+	}
+
+	if (!bHasBounds)
+	{
+		MaxX = Bounds.Max.X;
+		MinY = Bounds.Min.Y;
+		bHasBounds = true;
+	}
+	else
+	{
+		MaxX = FMath::Max(MaxX, static_cast<float>(Bounds.Max.X));
+		MinY = FMath::Min(MinY, static_cast<float>(Bounds.Min.Y));
+	}
+}
+
+bool FGraphLayoutIndex::Overlaps(const FBox2D& Bounds) const
+{
+	const FIntPoint MinCell = ToCell(Bounds.Min);
+	const FIntPoint MaxCell = ToCell(Bounds.Max);
+	for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+	{
+		for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+		{
+			const TArray<int32>* CellBoxes = Cells.Find(FIntPoint(CellX, CellY));
+			if (!CellBoxes)
+			{
+				continue;
+			}
+
+			for (int32 BoxIndex : *CellBoxes)
+			{
+				// Touching counts as overlapping so placed nodes never share an edge
+				const FBox2D& Existing = Boxes[BoxIndex];
+				if (!(Bounds.Max.X < Existing.Min.X || Bounds.Min.X > Existing.Max.X ||
+					  Bounds.Max.Y < Existing.Min.Y || Bounds.Min.Y > Existing.Max.Y))
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+FVector2D FGraphLayoutIndex::FindFreeSlot() const
+{
+	if (!bHasBounds)
+	{
+		return FVector2D(0, 0);
+	}
+
+	// The new node's size is unknown until it is spawned; check against the default size
+	const FVector2D Size(DefaultNodeWidth, DefaultNodeHeight);
+
+	FVector2D CandidatePos(MaxX + SpacingX, MinY);
+	for (int32 Attempt = 0; Attempt < MaxSlotAttempts; Attempt++)
+	{
+		if (!Overlaps(FBox2D(CandidatePos, CandidatePos + Size)))
+		{
+			return CandidatePos;
+		}
+		CandidatePos.Y += DefaultNodeHeight + SpacingY;
+	}
+
+	// Still overlapping after all attempts, just place further right
+	return FVector2D(MaxX + SpacingX + DefaultNodeWidth, MinY);
+}
+
+void FGraphLayoutIndex::LayoutLayered(const TArray<UEdGraphNode*>& Nodes, const FVector2D& Origin)
+{
+	const int32 NodeCount = Nodes.Num();
+	if (NodeCount == 0)
+	{
+		return;
+	}
+
+	TMap<const UEdGraphNode*, int32> IndexOf;
+	IndexOf.Reserve(NodeCount);
+	for (int32 i = 0; i < NodeCount; i++)
+	{
+		IndexOf.Add(Nodes[i], i);
+	}
+
+	// Predecessors are the set's nodes feeding any input pin (exec or data)
+	TArray<TArray<int32>> Predecessors;
+	TArray<TArray<int32>> Successors;
+	Predecessors.SetNum(NodeCount);
+	Successors.SetNum(NodeCount);
+	for (int32 i = 0; i < NodeCount; i++)
+	{
+		for (const UEdGraphPin* Pin : Nodes[i]->Pins)
+		{
+			if (!Pin || Pin->Direction != EGPD_Input) continue;
+
+			for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				const int32* From = LinkedPin ? IndexOf.Find(LinkedPin->GetOwningNode()) : nullptr;
+				if (From && *From != i && !Predecessors[i].Contains(*From))
+				{
+					Predecessors[i].Add(*From);
+					Successors[*From].Add(i);
+				}
+			}
+		}
+	}
+
+	// Longest-path layering in topological order; nodes on a cycle stay in the first column
+	TArray<int32> Layers;
+	TArray<int32> InDegree;
+	Layers.Init(0, NodeCount);
+	InDegree.SetNum(NodeCount);
+	TArray<int32> Ready;
+	for (int32 i = 0; i < NodeCount; i++)
+	{
+		InDegree[i] = Predecessors[i].Num();
+		if (InDegree[i] == 0)
+		{
+			Ready.Add(i);
+		}
+	}
+	for (int32 ReadyIdx = 0; ReadyIdx < Ready.Num(); ReadyIdx++)
+	{
+		const int32 Current = Ready[ReadyIdx];
+		for (int32 Next : Successors[Current])
+		{
+			Layers[Next] = FMath::Max(Layers[Next], Layers[Current] + 1);
+			if (--InDegree[Next] == 0)
+			{
+				Ready.Add(Next);
+			}
+		}
+	}
+
+	int32 LayerCount = 0;
+	for (int32 Layer : Layers)
+	{
+		LayerCount = FMath::Max(LayerCount, Layer + 1);
+	}
+	TArray<TArray<int32>> Columns;
+	Columns.SetNum(LayerCount);
+	for (int32 i = 0; i < NodeCount; i++)
+	{
+		Columns[Layers[i]].Add(i);
+	}
+
+	// Place column by column; rows follow the average row of each node's predecessors
+	TArray<float> RowKeys;
+	RowKeys.Init(0.0f, NodeCount);
+	float ColumnX = Origin.X;
+	for (TArray<int32>& Column : Columns)
+	{
+		for (int32 Slot = 0; Slot < Column.Num(); Slot++)
+		{
+			const int32 NodeIdx = Column[Slot];
+			const TArray<int32>& Preds = Predecessors[NodeIdx];
+			if (Preds.Num() == 0)
+			{
+				RowKeys[NodeIdx] = static_cast<float>(Slot);
+				continue;
+			}
+
+			float Sum = 0.0f;
+			for (int32 Pred : Preds)
+			{
+				Sum += RowKeys[Pred];
+			}
+			RowKeys[NodeIdx] = Sum / Preds.Num();
+		}
+		Algo::StableSortBy(Column, [&RowKeys](int32 NodeIdx) { return RowKeys[NodeIdx]; });
+
+		float ColumnWidth = 0.0f;
+		float RowY = Origin.Y;
+		for (int32 Slot = 0; Slot < Column.Num(); Slot++)
+		{
+			const int32 NodeIdx = Column[Slot];
+			UEdGraphNode* Node = Nodes[NodeIdx];
+			const FVector2D Size = EstimateNodeSize(Node);
+
+			Node->NodePosX = FMath::RoundToInt32(ColumnX);
+			Node->NodePosY = FMath::RoundToInt32(RowY);
+
+			// Later columns order against final rows, not the pre-sort estimate
+			RowKeys[NodeIdx] = static_cast<float>(Slot);
+			RowY += Size.Y + SpacingY;
+			ColumnWidth = FMath::Max(ColumnWidth, static_cast<float>(Size.X));
+		}
+		ColumnX += ColumnWidth + SpacingX;
+	}
+}
@@ -0,0 +1,198 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/GraphSnapshotStore.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Misc/Crc.h"
+
+FGraphSnapshotStore& FGraphSnapshotStore::Get()
+{
+	static FGraphSnapshotStore Instance;
+	return Instance;
+}
+
+uint32 FGraphSnapshotStore::HashNode(const UEdGraphNode* Node)
+{
+	// What a read shows for the node, plus defaults, so edits to pin values surface as changes
+	uint32 Hash = FCrc::StrCrc32(*Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+	for (const UEdGraphPin* Pin : Node->Pins)
+	{
+		if (!Pin || Pin->bHidden) continue;
+
+		Hash = HashCombine(Hash, GetTypeHash(Pin->PinName));
+		Hash = HashCombine(Hash, static_cast<uint32>(Pin->Direction));
+		Hash = HashCombine(Hash, FCrc::StrCrc32(*Pin->DefaultValue));
+		if (Pin->DefaultObject)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Pin->DefaultObject->GetPathName()));
+		}
+		if (!Pin->DefaultTextValue.IsEmpty())
+		{
+			Hash = HashCombine(Hash, FCrc::StrCrc32(*Pin->DefaultTextValue.ToString()));
+		}
+	}
+	return Hash;
+}
+
+void FGraphSnapshotStore::Build(const UEdGraph* Graph, FSnapshot& OutSnapshot)
+{
+	OutSnapshot.Graph = FObjectKey(Graph);
+	OutSnapshot.NodeHashes.Reserve(Graph->Nodes.Num());
+
+	for (const UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node) continue;
+
+		OutSnapshot.NodeHashes.Add(Node->NodeGuid, HashNode(Node));
+
+		for (const UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin || Pin->Direction != EGPD_Output) continue;
+
+			for (const UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				const UEdGraphNode* LinkedNode = LinkedPin ? LinkedPin->GetOwningNode() : nullptr;
+				if (LinkedNode)
+				{
+					OutSnapshot.Links.Add({ Node->NodeGuid, Pin->PinName, LinkedNode->NodeGuid, LinkedPin->PinName });
+				}
+			}
+		}
+	}
+}
+
+bool FGraphSnapshotStore::ParseToken(const FString& Token, uint32& OutVersion)
+{
+	if (!Token.StartsWith(TEXT("v")) || Token.Len() < 2)
+	{
+		return false;
+	}
+	const FString Digits = Token.RightChop(1);
+	if (!Digits.IsNumeric())
+	{
+		return false;
+	}
+	OutVersion = static_cast<uint32>(FCString::Strtoui64(*Digits, nullptr, 10));
+	return true;
+}
+
+uint32 FGraphSnapshotStore::Commit(const UEdGraph* Graph, FSnapshot&& Snapshot)
+{
+	const FObjectKey GraphKey(Graph);
+
+	// Unchanged since the last read: hand out the same token
+	if (const uint32* Latest = LatestVersions.Find(GraphKey))
+	{
+		if (FSnapshot* Existing = Snapshots.Find(*Latest))
+		{
+			if (Existing->NodeHashes.OrderIndependentCompareEqual(Snapshot.NodeHashes)
+				&& Existing->Links.Num() == Snapshot.Links.Num()
+				&& Existing->Links.Includes(Snapshot.Links))
+			{
+				Existing->LastUsed = ++UseCounter;
+				return *Latest;
+			}
+		}
+	}
+
+	if (Snapshots.Num() >= MaxSnapshots)
+	{
+		uint32 Oldest = 0;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<uint32, FSnapshot>& Pair : Snapshots)
+		{
+			if (Pair.Value.LastUsed < OldestUse)
+			{
+				OldestUse = Pair.Value.LastUsed;
+				Oldest = Pair.Key;
+			}
+		}
+		Snapshots.Remove(Oldest);
+	}
+
+	const uint32 Version = NextVersion++;
+	Snapshot.LastUsed = ++UseCounter;
+	Snapshots.Add(Version, MoveTemp(Snapshot));
+	LatestVersions.Add(GraphKey, Version);
+	return Version;
+}
+
+FString FGraphSnapshotStore::Capture(const UEdGraph* Graph)
+{
+	FSnapshot Snapshot;
+	Build(Graph, Snapshot);
+	return FString::Printf(TEXT("v%u"), Commit(Graph, MoveTemp(Snapshot)));
+}
+
+bool FGraphSnapshotStore::IsTokenFor(const UEdGraph* Graph, const FString& Token) const
+{
+	uint32 Version = 0;
+	if (!ParseToken(Token, Version))
+	{
+		return false;
+	}
+	const FSnapshot* Snapshot = Snapshots.Find(Version);
+	return Snapshot && Snapshot->Graph == FObjectKey(Graph);
+}
+
+bool FGraphSnapshotStore::Diff(const UEdGraph* Graph, const FString& SinceToken, FDelta& OutDelta, FString& OutVersion)
+{
+	if (!IsTokenFor(Graph, SinceToken))
+	{
+		return false;
+	}
+
+	uint32 SinceVersion = 0;
+	ParseToken(SinceToken, SinceVersion);
+
+	FSnapshot Current;
+	Build(Graph, Current);
+
+	{
+		FSnapshot& Since = Snapshots.FindChecked(SinceVersion);
+		Since.LastUsed = ++UseCounter;
+
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node) continue;
+
+			const uint32* OldHash = Since.NodeHashes.Find(Node->NodeGuid);
+			if (!OldHash)
+			{
+				OutDelta.AddedNodes.Add(Node);
+			}
+			else if (*OldHash != Current.NodeHashes.FindChecked(Node->NodeGuid))
+			{
+				OutDelta.ChangedNodes.Add(Node);
+			}
+		}
+
+		for (const TPair<FGuid, uint32>& Pair : Since.NodeHashes)
+		{
+			if (!Current.NodeHashes.Contains(Pair.Key))
+			{
+				OutDelta.RemovedNodes.Add(Pair.Key);
+			}
+		}
+
+		for (const FLink& Link : Current.Links)
+		{
+			if (!Since.Links.Contains(Link))
+			{
+				OutDelta.AddedLinks.Add(Link);
+			}
+		}
+		for (const FLink& Link : Since.Links)
+		{
+			if (!Current.Links.Contains(Link))
+			{
+				OutDelta.RemovedLinks.Add(Link);
+			}
+		}
+	}
+
+	// Committing may evict snapshots, so it happens after the references above are done with
+	OutVersion = FString::Printf(TEXT("v%u"), Commit(Graph, MoveTemp(Current)));
+	return true;
+}
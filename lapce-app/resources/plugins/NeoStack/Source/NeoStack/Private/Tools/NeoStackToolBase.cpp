@@ -0,0 +1,46 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/NeoStackToolBase.h"
+#include "Async/Async.h"
+
+namespace
+{
+	/** Runs a tool's synchronous Execute as one step */
+	class FExecuteToolTask : public FNeoStackToolTask
+	{
+	public:
+		FExecuteToolTask(FNeoStackToolBase& InTool, const TSharedPtr<FJsonObject>& InArgs)
+			: Tool(InTool), Args(InArgs)
+		{
+		}
+
+		virtual bool Step(double Deadline) override
+		{
+			Result = Tool.Execute(Args);
+			return true;
+		}
+
+	private:
+		FNeoStackToolBase& Tool;
+		TSharedPtr<FJsonObject> Args;
+	};
+}
+
+void FNeoStackToolTask::WaitForWorker() const
+{
+	if (WorkerDone.IsValid())
+	{
+		WorkerDone.Wait();
+	}
+}
+
+void FNeoStackToolTask::RunOnWorker(TUniqueFunction<void()>&& Work)
+{
+	check(!IsWaitingForWorker());
+	WorkerDone = Async(EAsyncExecution::ThreadPool, MoveTemp(Work));
+}
+
+TSharedRef<FNeoStackToolTask> FNeoStackToolBase::CreateTask(const TSharedPtr<FJsonObject>& Args)
+{
+	return MakeShared<FExecuteToolTask>(*this, Args);
+}
@@ -1,6 +1,13 @@
 // Copyright NeoStack. All Rights Reserved.
 
 #include "Tools/NeoStackToolRegistry.h"
+#include "Tools/AssetPrefetcher.h"
+#include "Tools/BlueprintCompileScheduler.h"
+#include "Tools/ToolResultCache.h"
+#include "Tools/ToolStats.h"
+#include "Tools/TurnCheckpoint.h"
+#include "NeoStackTrace.h"
+#include "NeoStackSettings.h"
 #include "Json.h"
 
 // Include all tool headers here
@@ -13,6 +20,13 @@
 #include "Tools/ConfigureAssetTool.h"
 #include "Tools/EditBehaviorTreeTool.h"
 #include "Tools/EditDataStructureTool.h"
+#include "Tools/CaptureViewportTool.h"
+#include "Tools/ReadLogTool.h"
+
+namespace
+{
+	bool bToolRegistryCreated = false;
+}
 
 FNeoStackToolRegistry& FNeoStackToolRegistry::Get()
 {
@@ -20,13 +34,22 @@ FNeoStackToolRegistry& FNeoStackToolRegistry::Get()
 	return Instance;
 }
 
+bool FNeoStackToolRegistry::IsCreated()
+{
+	return bToolRegistryCreated;
+}
+
 FNeoStackToolRegistry::FNeoStackToolRegistry()
 {
+	bToolRegistryCreated = true;
 	RegisterBuiltInTools();
 }
 
 void FNeoStackToolRegistry::RegisterBuiltInTools()
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_RegisterBuiltInTools);
+	const double StartTime = FPlatformTime::Seconds();
+
 	// Register all built-in tools
 	Register(MakeShared<FCreateFileTool>());
 	Register(MakeShared<FReadFileTool>());
@@ -37,8 +60,10 @@ void FNeoStackToolRegistry::RegisterBuiltInTools()
 	Register(MakeShared<FConfigureAssetTool>());
 	Register(MakeShared<FEditBehaviorTreeTool>());
 	Register(MakeShared<FEditDataStructureTool>());
+	Register(MakeShared<FCaptureViewportTool>());
+	Register(MakeShared<FReadLogTool>());
 
-	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Tool registry initialized with %d tools"), Tools.Num());
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Tool registry initialized with %d tools in %.1f ms"), Tools.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 }
 
 void FNeoStackToolRegistry::Register(TSharedPtr<FNeoStackToolBase> Tool)
@@ -58,22 +83,64 @@ void FNeoStackToolRegistry::Register(TSharedPtr<FNeoStackToolBase> Tool)
 	Tools.Add(Name, Tool);
 }
 
-FToolResult FNeoStackToolRegistry::Execute(const FString& ToolName, const FString& ArgsJson)
+TSharedPtr<FJsonObject> FNeoStackToolRegistry::ParseArgs(const FString& ArgsJson)
 {
-	// Parse JSON args
+	if (ArgsJson.IsEmpty())
+	{
+		return MakeShared<FJsonObject>();
+	}
+
 	TSharedPtr<FJsonObject> Args;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ArgsJson);
+	if (!FJsonSerializer::Deserialize(Reader, Args) || !Args.IsValid())
+	{
+		return nullptr;
+	}
+	return Args;
+}
 
-	if (!ArgsJson.IsEmpty())
+void FNeoStackToolRegistry::LogResult(const FString& ToolName, const FToolResult& Result)
+{
+	if (Result.bSuccess)
 	{
-		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ArgsJson);
-		if (!FJsonSerializer::Deserialize(Reader, Args) || !Args.IsValid())
-		{
-			return FToolResult::Fail(FString::Printf(TEXT("Failed to parse arguments for tool '%s'"), *ToolName));
-		}
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Tool '%s' succeeded: %s"), *ToolName, *Result.Output);
 	}
 	else
 	{
-		Args = MakeShared<FJsonObject>();
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Tool '%s' failed: %s"), *ToolName, *Result.Output);
+	}
+}
+
+FString FNeoStackToolRegistry::GetCacheKey(const FNeoStackToolBase& Tool, const FString& ToolName, const TSharedPtr<FJsonObject>& Args)
+{
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	if (!Tool.IsReadOnly() || !Tool.IsCacheable(Args) || (Settings && !Settings->bCacheToolResults))
+	{
+		return FString();
+	}
+	return FToolResultCache::MakeKey(ToolName, Args);
+}
+
+void FNeoStackToolRegistry::RecordResult(bool bReadOnly, const FString& CacheKey, const TArray<FString>& Resources,
+	const FToolResult& Result, double DurationMs)
+{
+	if (!bReadOnly)
+	{
+		// Even a failed edit may have changed something before it stopped
+		FToolResultCache::Get().NotifyMutation(Resources);
+	}
+	else if (!CacheKey.IsEmpty())
+	{
+		FToolResultCache::Get().Store(CacheKey, Resources, Result, DurationMs);
+	}
+}
+
+FToolResult FNeoStackToolRegistry::Execute(const FString& ToolName, const FString& ArgsJson)
+{
+	TSharedPtr<FJsonObject> Args = ParseArgs(ArgsJson);
+	if (!Args.IsValid())
+	{
+		return FToolResult::Fail(FString::Printf(TEXT("Failed to parse arguments for tool '%s'"), *ToolName));
 	}
 
 	return Execute(ToolName, Args);
@@ -81,6 +148,9 @@ FToolResult FNeoStackToolRegistry::Execute(const FString& ToolName, const FStrin
 
 FToolResult FNeoStackToolRegistry::Execute(const FString& ToolName, const TSharedPtr<FJsonObject>& Args)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("NeoStack_ExecuteTool", NeoStackToolsChannel);
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*ToolName, NeoStackToolsChannel);
+
 	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Executing tool: %s"), *ToolName);
 
 	FNeoStackToolBase* Tool = GetTool(ToolName);
@@ -89,20 +159,369 @@ FToolResult FNeoStackToolRegistry::Execute(const FString& ToolName, const TShare
 		return FToolResult::Fail(FString::Printf(TEXT("Unknown tool: %s"), *ToolName));
 	}
 
-	FToolResult Result = Tool->Execute(Args);
+	TArray<FString> Resources;
+	Tool->GetTouchedResources(Args, Resources);
 
-	if (Result.bSuccess)
+	const FString CacheKey = GetCacheKey(*Tool, ToolName, Args);
+	if (!CacheKey.IsEmpty())
 	{
-		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Tool '%s' succeeded: %s"), *ToolName, *Result.Output);
+		if (const FToolResult* Cached = FToolResultCache::Get().Find(CacheKey))
+		{
+			UE_LOG(LogTemp, Log, TEXT("[NeoStack] Tool '%s' served from cache (%.1f ms saved)"), *ToolName, Cached->CachedDurationMs);
+			FNeoStackToolStats::Get().Record(ToolName, *Cached, FNeoStackToolStats::FSample());
+			return *Cached;
+		}
 	}
-	else
+
+	const int64 MemoryBefore = FNeoStackToolStats::GetUsedMemory();
+	const double StartTime = FPlatformTime::Seconds();
+	FBlueprintCompileScheduler& Compiler = FBlueprintCompileScheduler::Get();
+	const uint32 CompileCallerId = Compiler.MakeCallerId();
+	FToolResult Result;
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[NeoStack] Tool '%s' failed: %s"), *ToolName, *Result.Output);
+		FBlueprintCompileScheduler::FCallerScope CompileScope(CompileCallerId);
+		FTurnCheckpoint::FEditScope CheckpointScope(!Tool->IsReadOnly(), Resources);
+		Result = Tool->Execute(Args);
+	}
+	if (Compiler.IsWaiting(CompileCallerId))
+	{
+		// The caller needs the result now; asynchronous calls still running get theirs at the end of their batch
+		Compiler.FlushAll();
+		Compiler.ApplyReports(CompileCallerId, Result.Output);
 	}
+	const double DurationMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	RecordResult(Tool->IsReadOnly(), CacheKey, Resources, Result, DurationMs);
 
+	FNeoStackToolStats::FSample Sample;
+	Sample.LatencyMs = static_cast<float>(DurationMs);
+	Sample.GameThreadMs = Sample.LatencyMs;
+	Sample.OutputBytes = FNeoStackToolStats::GetOutputBytes(Result);
+	Sample.MemoryDeltaBytes = FNeoStackToolStats::GetUsedMemory() - MemoryBefore;
+	FNeoStackToolStats::Get().Record(ToolName, Result, Sample);
+
+	LogResult(ToolName, Result);
 	return Result;
 }
 
+TFuture<FToolResult> FNeoStackToolRegistry::ExecuteAsync(const FString& ToolName, const FString& ArgsJson, FOnToolProgress OnProgress)
+{
+	TSharedPtr<FJsonObject> Args = ParseArgs(ArgsJson);
+	if (!Args.IsValid())
+	{
+		return MakeFulfilledPromise<FToolResult>(
+			FToolResult::Fail(FString::Printf(TEXT("Failed to parse arguments for tool '%s'"), *ToolName))).GetFuture();
+	}
+
+	return ExecuteAsync(ToolName, Args, MoveTemp(OnProgress));
+}
+
+TFuture<FToolResult> FNeoStackToolRegistry::ExecuteAsync(const FString& ToolName, const TSharedPtr<FJsonObject>& Args, FOnToolProgress OnProgress,
+	TSharedPtr<FNeoStackCancellationToken> CancelToken)
+{
+	check(IsInGameThread());
+
+	FNeoStackToolBase* Tool = GetTool(ToolName);
+	if (!Tool)
+	{
+		return MakeFulfilledPromise<FToolResult>(
+			FToolResult::Fail(FString::Printf(TEXT("Unknown tool: %s"), *ToolName))).GetFuture();
+	}
+	if (bShutdown)
+	{
+		return MakeFulfilledPromise<FToolResult>(
+			FToolResult::Fail(TEXT("Tool execution unavailable: editor is shutting down"))).GetFuture();
+	}
+	if (CancelToken.IsValid() && CancelToken->IsCancelled())
+	{
+		return MakeFulfilledPromise<FToolResult>(FToolResult::Fail(TEXT("Cancelled"))).GetFuture();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Executing tool asynchronously: %s"), *ToolName);
+
+	FString CacheKey = GetCacheKey(*Tool, ToolName, Args);
+	if (!CacheKey.IsEmpty())
+	{
+		if (const FToolResult* Cached = FToolResultCache::Get().Find(CacheKey))
+		{
+			UE_LOG(LogTemp, Log, TEXT("[NeoStack] Tool '%s' served from cache (%.1f ms saved)"), *ToolName, Cached->CachedDurationMs);
+			FNeoStackToolStats::Get().Record(ToolName, *Cached, FNeoStackToolStats::FSample());
+			return MakeFulfilledPromise<FToolResult>(*Cached).GetFuture();
+		}
+	}
+
+	TUniquePtr<FRunningTask> Entry = MakeUnique<FRunningTask>();
+	Entry->ToolName = ToolName;
+	Entry->Task = Tool->CreateTask(Args);
+	Entry->Task->CancelToken = MoveTemp(CancelToken);
+	Entry->OnProgress = MoveTemp(OnProgress);
+	Entry->bReadOnly = Tool->IsReadOnly();
+	Tool->GetTouchedResources(Args, Entry->Resources);
+	Entry->CacheKey = MoveTemp(CacheKey);
+	Entry->PrefetchPackages = FAssetPrefetcher::Get().Prefetch(Args);
+	Entry->StartTime = FPlatformTime::Seconds();
+	Entry->CompileCallerId = FBlueprintCompileScheduler::Get().MakeCallerId();
+
+	TFuture<FToolResult> Future = Entry->Promise.GetFuture();
+	Running.Add(MoveTemp(Entry));
+
+	if (!TickHandle.IsValid())
+	{
+		TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FNeoStackToolRegistry::HandleTick), 0.0f);
+	}
+
+	return Future;
+}
+
+bool FNeoStackToolRegistry::HandleTick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("NeoStack_ToolScheduler", NeoStackToolsChannel);
+
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	const double Budget = (Settings ? Settings->ToolFrameBudgetMs : 8.0f) / 1000.0;
+	const double FrameDeadline = FPlatformTime::Seconds() + Budget;
+
+	// Visit each task at most once per tick, splitting what is left of the budget evenly
+	// between the tasks not yet visited. Tasks waiting on a worker or on an earlier
+	// conflicting task or on its prefetched packages are skipped.
+	const int32 TaskCount = Running.Num();
+	int32 Index = NextTaskIndex;
+	for (int32 Visited = 0; Visited < TaskCount && Running.Num() > 0; Visited++)
+	{
+		if (Index >= Running.Num())
+		{
+			Index = 0;
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		if (Now >= FrameDeadline)
+		{
+			break;
+		}
+
+		FNeoStackToolTask& Task = *Running[Index]->Task;
+		if (Task.IsCancelled() && !Task.IsWaitingForWorker() && (!Running[Index]->bStarted || Running[Index]->bReadOnly))
+		{
+			CancelTask(Index);
+			continue;
+		}
+		if (Task.IsWaitingForWorker() || (!Running[Index]->bStarted
+			&& (IsBlocked(Index) || FAssetPrefetcher::Get().IsLoading(Running[Index]->PrefetchPackages))))
+		{
+			Index++;
+			continue;
+		}
+		Running[Index]->bStarted = true;
+
+		const double SliceDeadline = Now + (FrameDeadline - Now) / (TaskCount - Visited);
+		const int64 MemoryBefore = FNeoStackToolStats::GetUsedMemory();
+		bool bDone = false;
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*Running[Index]->ToolName, NeoStackToolsChannel);
+			FBlueprintCompileScheduler::FCallerScope CompileScope(Running[Index]->CompileCallerId);
+			FTurnCheckpoint::FEditScope CheckpointScope(!Running[Index]->bReadOnly, Running[Index]->Resources);
+			bDone = Task.Step(SliceDeadline);
+		}
+
+		FRunningTask& Entry = *Running[Index];
+		Entry.GameThreadSeconds += FPlatformTime::Seconds() - Now;
+		Entry.MemoryDeltaBytes += FNeoStackToolStats::GetUsedMemory() - MemoryBefore;
+		if (Task.Progress != Entry.LastProgress || Task.Status != Entry.LastStatus)
+		{
+			Entry.LastProgress = Task.Progress;
+			Entry.LastStatus = Task.Status;
+			Entry.OnProgress.ExecuteIfBound(Task.Progress, Task.Status);
+		}
+
+		if (bDone)
+		{
+			CompleteTask(Index);
+		}
+		else
+		{
+			Index++;
+		}
+	}
+	NextTaskIndex = Index;
+
+	if (Running.Num() == 0)
+	{
+		FlushCompiles();
+	}
+	else
+	{
+		FlushOverdueCompiles();
+	}
+
+	// Continuations of the tasks just fulfilled may have started new ones
+	if (Running.Num() == 0)
+	{
+		TickHandle.Reset();
+		NextTaskIndex = 0;
+		return false;
+	}
+	return true;
+}
+
+bool FNeoStackToolRegistry::Conflicts(const FRunningTask& A, const FRunningTask& B)
+{
+	if (A.bReadOnly && B.bReadOnly)
+	{
+		return false;
+	}
+
+	// A mutation that can't say what it touches is ordered against everything
+	if ((!A.bReadOnly && A.Resources.Num() == 0) || (!B.bReadOnly && B.Resources.Num() == 0))
+	{
+		return true;
+	}
+
+	for (const FString& Resource : A.Resources)
+	{
+		if (B.Resources.Contains(Resource))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FNeoStackToolRegistry::IsBlocked(int32 Index) const
+{
+	// Running is in call order; tasks only ever wait for earlier ones, so nothing deadlocks
+	const FRunningTask& Entry = *Running[Index];
+	for (int32 Earlier = 0; Earlier < Index; Earlier++)
+	{
+		if (Conflicts(*Running[Earlier], Entry))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FNeoStackToolRegistry::CompleteTask(int32 Index)
+{
+	// Detach first: continuations on the future may start new executions
+	TUniquePtr<FRunningTask> Entry = MoveTemp(Running[Index]);
+	Running.RemoveAt(Index);
+
+	if (FBlueprintCompileScheduler::Get().IsWaiting(Entry->CompileCallerId))
+	{
+		Entry->HeldSince = FPlatformTime::Seconds();
+		AwaitingCompile.Add(MoveTemp(Entry));
+		return;
+	}
+	FinishTask(MoveTemp(Entry));
+}
+
+void FNeoStackToolRegistry::FlushCompiles()
+{
+	FBlueprintCompileScheduler& Compiler = FBlueprintCompileScheduler::Get();
+	if (Compiler.HasPending())
+	{
+		Compiler.FlushAll();
+	}
+
+	TArray<TUniquePtr<FRunningTask>> Finished = MoveTemp(AwaitingCompile);
+	AwaitingCompile.Reset();
+	for (TUniquePtr<FRunningTask>& Entry : Finished)
+	{
+		FinishTask(MoveTemp(Entry));
+	}
+}
+
+void FNeoStackToolRegistry::FlushOverdueCompiles()
+{
+	const double Now = FPlatformTime::Seconds();
+	TArray<TUniquePtr<FRunningTask>> Overdue;
+	for (int32 Index = 0; Index < AwaitingCompile.Num();)
+	{
+		if (Now - AwaitingCompile[Index]->HeldSince >= MaxCompileHoldSeconds)
+		{
+			Overdue.Add(MoveTemp(AwaitingCompile[Index]));
+			AwaitingCompile.RemoveAt(Index);
+		}
+		else
+		{
+			Index++;
+		}
+	}
+
+	// A steady stream of calls would otherwise hold these back until it stops
+	FBlueprintCompileScheduler& Compiler = FBlueprintCompileScheduler::Get();
+	for (TUniquePtr<FRunningTask>& Entry : Overdue)
+	{
+		Compiler.FlushCaller(Entry->CompileCallerId);
+		FinishTask(MoveTemp(Entry));
+	}
+}
+
+void FNeoStackToolRegistry::FinishTask(TUniquePtr<FRunningTask> Entry)
+{
+	FToolResult Result = MoveTemp(Entry->Task->Result);
+	FBlueprintCompileScheduler::Get().ApplyReports(Entry->CompileCallerId, Result.Output);
+	const double DurationMs = (FPlatformTime::Seconds() - Entry->StartTime) * 1000.0;
+	RecordResult(Entry->bReadOnly, Entry->CacheKey, Entry->Resources, Result, DurationMs);
+
+	LogResult(Entry->ToolName, Result);
+	UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Async tool '%s' finished in %.1f ms"), *Entry->ToolName, DurationMs);
+
+	FNeoStackToolStats::FSample Sample;
+	Sample.LatencyMs = static_cast<float>(DurationMs);
+	Sample.GameThreadMs = static_cast<float>(Entry->GameThreadSeconds * 1000.0);
+	Sample.OutputBytes = FNeoStackToolStats::GetOutputBytes(Result);
+	Sample.MemoryDeltaBytes = Entry->MemoryDeltaBytes;
+	FNeoStackToolStats::Get().Record(Entry->ToolName, Result, Sample);
+
+	Entry->Promise.SetValue(MoveTemp(Result));
+}
+
+void FNeoStackToolRegistry::CancelTask(int32 Index)
+{
+	TUniquePtr<FRunningTask> Entry = MoveTemp(Running[Index]);
+	Running.RemoveAt(Index);
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Async tool '%s' cancelled after %.1f ms"), *Entry->ToolName,
+		(FPlatformTime::Seconds() - Entry->StartTime) * 1000.0);
+
+	Entry->Promise.SetValue(FToolResult::Fail(TEXT("Cancelled")));
+}
+
+void FNeoStackToolRegistry::Shutdown()
+{
+	bShutdown = true;
+
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	TArray<TUniquePtr<FRunningTask>> Pending = MoveTemp(Running);
+	NextTaskIndex = 0;
+	for (TUniquePtr<FRunningTask>& Entry : Pending)
+	{
+		// Worker lambdas reference their task; it must outlive them
+		Entry->Task->WaitForWorker();
+		Entry->Promise.SetValue(FToolResult::Fail(TEXT("Tool execution cancelled: editor is shutting down")));
+	}
+
+	// Their edits are done; only the compile is skipped
+	TArray<TUniquePtr<FRunningTask>> Uncompiled = MoveTemp(AwaitingCompile);
+	AwaitingCompile.Reset();
+	for (TUniquePtr<FRunningTask>& Entry : Uncompiled)
+	{
+		Entry->Promise.SetValue(MoveTemp(Entry->Task->Result));
+	}
+	FBlueprintCompileScheduler::Get().Shutdown();
+
+	if (Pending.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Cancelled %d running tool executions"), Pending.Num());
+	}
+}
+
 bool FNeoStackToolRegistry::HasTool(const FString& ToolName) const
 {
 	return Tools.Contains(ToolName);
@@ -3,6 +3,8 @@
 #include "Tools/NeoStackToolUtils.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Dom/JsonObject.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
@@ -160,6 +162,44 @@ namespace NeoStackToolUtils
 		return FString::Printf(TEXT("%s/%s.%s"), *AssetPath, *AssetName, *AssetName);
 	}
 
+	FString GetResourceKey(const FString& Name, const FString& Path)
+	{
+		if (Name.IsEmpty())
+		{
+			return FString();
+		}
+
+		if (IsAssetPath(Name, Path))
+		{
+			// Package path: drop the ".AssetName" object part
+			FString AssetPath = BuildAssetPath(Name, Path);
+			int32 DotIndex = INDEX_NONE;
+			if (AssetPath.FindLastChar(TEXT('.'), DotIndex))
+			{
+				AssetPath.LeftInline(DotIndex);
+			}
+			return AssetPath.ToLower();
+		}
+
+		return FPaths::ConvertRelativePathToFull(BuildFilePath(Name, Path)).ToLower();
+	}
+
+	void AddNamePathResource(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys)
+	{
+		FString Name, Path;
+		if (!Args.IsValid() || !Args->TryGetStringField(TEXT("name"), Name))
+		{
+			return;
+		}
+		Args->TryGetStringField(TEXT("path"), Path);
+
+		FString Key = GetResourceKey(Name, Path);
+		if (!Key.IsEmpty())
+		{
+			OutKeys.Add(MoveTemp(Key));
+		}
+	}
+
 	bool EnsureDirectoryExists(const FString& FilePath, FString& OutError)
 	{
 		FString Directory = FPaths::GetPath(FilePath);
@@ -351,4 +391,188 @@ namespace NeoStackToolUtils
 
 		return nullptr;
 	}
+
+	//--------------------------------------------------------------------
+	// Output Utilities
+	//--------------------------------------------------------------------
+
+	FToolOutputWriter::FToolOutputWriter(int32 SizeHint, int32 InMaxChars)
+		: MaxChars(FMath::Max(1, InMaxChars))
+	{
+		// Grow once up front; the inline buffer covers small outputs. MaxChars may be MAX_int32
+		const int32 Reserve = static_cast<int32>(FMath::Min<int64>(SizeHint, static_cast<int64>(MaxChars) + 256));
+		if (Reserve > 512)
+		{
+			Builder.AddUninitialized(Reserve);
+			Builder.Reset();
+		}
+	}
+
+	FToolOutputWriter& FToolOutputWriter::Append(FStringView Text)
+	{
+		if (HasRoom())
+		{
+			Builder.Append(Text);
+		}
+		return *this;
+	}
+
+	FToolOutputWriter& FToolOutputWriter::AppendChar(TCHAR Char)
+	{
+		if (HasRoom())
+		{
+			Builder.AppendChar(Char);
+		}
+		return *this;
+	}
+
+	FToolOutputWriter& FToolOutputWriter::AppendInt(int64 Value)
+	{
+		if (HasRoom())
+		{
+			Builder << Value;
+		}
+		return *this;
+	}
+
+	FToolOutputWriter& FToolOutputWriter::Row(std::initializer_list<FStringView> Cells)
+	{
+		if (!HasRoom())
+		{
+			return *this;
+		}
+
+		bool bFirst = true;
+		for (const FStringView& Cell : Cells)
+		{
+			if (!bFirst)
+			{
+				Builder.AppendChar(TEXT('\t'));
+			}
+			Builder.Append(Cell);
+			bFirst = false;
+		}
+		Builder.AppendChar(TEXT('\n'));
+		return *this;
+	}
+
+	FToolOutputWriter& FToolOutputWriter::Join(const TArray<FString>& Items, FStringView Separator)
+	{
+		if (!HasRoom())
+		{
+			return *this;
+		}
+
+		for (int32 i = 0; i < Items.Num(); i++)
+		{
+			if (i > 0)
+			{
+				Builder.Append(Separator);
+			}
+			Builder.Append(Items[i]);
+		}
+		return *this;
+	}
+
+	namespace
+	{
+		/** View cut back to the last whole line inside MaxChars, plus the truncation marker */
+		FString TruncateView(FStringView View, int32 MaxChars)
+		{
+			int32 CutAt = FMath::Min(View.Len(), MaxChars);
+			int32 LastNewline = INDEX_NONE;
+			if (View.Left(CutAt).FindLastChar(TEXT('\n'), LastNewline))
+			{
+				CutAt = LastNewline + 1;
+			}
+
+			FString Output(View.Left(CutAt));
+			Output.Appendf(TEXT("# TRUNCATED limit=%d chars (narrow the request or use offset/limit)\n"), MaxChars);
+			return Output;
+		}
+	}
+
+	FString FToolOutputWriter::ToString() const
+	{
+		FStringView View = Builder.ToView();
+		if (!bTruncated && View.Len() <= MaxChars)
+		{
+			return FString(View);
+		}
+		return TruncateView(View, MaxChars);
+	}
+
+	FString CapToolOutput(FString Output, int32 MaxChars)
+	{
+		MaxChars = FMath::Max(1, MaxChars);
+		if (Output.Len() <= MaxChars)
+		{
+			return Output;
+		}
+		return TruncateView(Output, MaxChars);
+	}
+}
+
+namespace
+{
+	/**
+	 * NeoStack.BenchmarkToolOutput [Rows]
+	 * Writes a node listing shaped like a graph read (guid, title, pins) with FString += Printf and
+	 * with FToolOutputWriter, and logs timings plus buffer reallocations (counted as changes of the
+	 * data pointer) and per-line temporaries for both.
+	 */
+	void RunToolOutputBenchmark(const TArray<FString>& Args)
+	{
+		const int32 RowCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 20000;
+
+		const FString Guid = FGuid(0x12345678, 0x9ABCDEF0, 0x0FEDCBA9, 0x87654321).ToString();
+		const FString Title = TEXT("Get Actor Location");
+		const FString Pins = TEXT("execute,then,Target,ReturnValue");
+
+		// Current pattern: one Printf temporary per row appended to a default-sized FString
+		int32 LegacyReallocs = 0;
+		const double LegacyStart = FPlatformTime::Seconds();
+		FString Legacy = FString::Printf(TEXT("# GRAPH EventGraph type=ubergraph %d\n"), RowCount);
+		const TCHAR* LegacyData = *Legacy;
+		for (int32 i = 0; i < RowCount; ++i)
+		{
+			Legacy += FString::Printf(TEXT("%s\t%s\t%s\n"), *Guid, *Title, *Pins);
+			if (*Legacy != LegacyData)
+			{
+				LegacyData = *Legacy;
+				++LegacyReallocs;
+			}
+		}
+		const double LegacyMs = (FPlatformTime::Seconds() - LegacyStart) * 1000.0;
+
+		// Writer sized from the row count, formatting straight into its buffer
+		int32 WriterReallocs = 0;
+		const double WriterStart = FPlatformTime::Seconds();
+		NeoStackToolUtils::FToolOutputWriter Writer(128 + RowCount * 96, MAX_int32);
+		Writer.Appendf(TEXT("# GRAPH EventGraph type=ubergraph %d\n"), RowCount);
+		const TCHAR* WriterData = Writer.ToView().GetData();
+		for (int32 i = 0; i < RowCount; ++i)
+		{
+			Writer.Appendf(TEXT("%s\t%s\t%s\n"), *Guid, *Title, *Pins);
+			if (Writer.ToView().GetData() != WriterData)
+			{
+				WriterData = Writer.ToView().GetData();
+				++WriterReallocs;
+			}
+		}
+		const FString WriterOutput = Writer.ToString();
+		const double WriterMs = (FPlatformTime::Seconds() - WriterStart) * 1000.0;
+
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack] Tool output: %d rows, %d chars"), RowCount, Legacy.Len());
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack]   FString += Printf:  %.1f ms, %d reallocations, %d temporaries"),
+			LegacyMs, LegacyReallocs, RowCount + 1);
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack]   FToolOutputWriter:  %.1f ms, %d reallocations, 1 temporary (final copy), %.1fx"),
+			WriterMs, WriterReallocs, WriterMs > 0.0 ? LegacyMs / WriterMs : 0.0);
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack]   Outputs match: %s"), WriterOutput.Equals(Legacy, ESearchCase::CaseSensitive) ? TEXT("yes") : TEXT("no"));
+	}
+
+	FAutoConsoleCommand BenchmarkToolOutputCommand(
+		TEXT("NeoStack.BenchmarkToolOutput"),
+		TEXT("Compare FString += Printf with FToolOutputWriter for tool output. Usage: NeoStack.BenchmarkToolOutput [Rows]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunToolOutputBenchmark));
 }
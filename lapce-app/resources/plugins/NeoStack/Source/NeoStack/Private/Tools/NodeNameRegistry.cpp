@@ -1,6 +1,30 @@
 // Copyright NeoStack. All Rights Reserved.
 
 #include "Tools/NodeNameRegistry.h"
+#include "NeoStackSettings.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+
+namespace
+{
+	constexpr int32 SaveFileVersion = 1;
+
+	bool IsPersistenceEnabled()
+	{
+		const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+		return Settings && Settings->bPersistNodeNames;
+	}
+}
 
 FNodeNameRegistry& FNodeNameRegistry::Get()
 {
@@ -8,54 +32,65 @@ FNodeNameRegistry& FNodeNameRegistry::Get()
 	return Instance;
 }
 
-FString FNodeNameRegistry::MakeKey(const FString& AssetPath, const FString& GraphName, const FString& NodeName)
+FName FNodeNameRegistry::FindName(const FString& Text)
 {
-	return FString::Printf(TEXT("%s|%s|%s"), *AssetPath, *GraphName, *NodeName);
+	return Text.IsEmpty() ? NAME_None : FName(*Text, FNAME_Find);
 }
 
-bool FNodeNameRegistry::ParseKey(const FString& Key, FString& OutAssetPath, FString& OutGraphName, FString& OutNodeName)
+const FNodeNameRegistry::FGraphNames* FNodeNameRegistry::FindGraph(const FString& AssetPath, const FString& GraphName) const
 {
-	TArray<FString> Parts;
-	Key.ParseIntoArray(Parts, TEXT("|"));
+	LoadIfNeeded();
 
-	if (Parts.Num() != 3)
+	const FName AssetKey = FindName(AssetPath);
+	const FName GraphKey = FindName(GraphName);
+	if (AssetKey.IsNone() || GraphKey.IsNone())
 	{
-		return false;
+		return nullptr;
 	}
 
-	OutAssetPath = Parts[0];
-	OutGraphName = Parts[1];
-	OutNodeName = Parts[2];
-	return true;
+	const FAssetNames* Asset = Assets.Find(AssetKey);
+	return Asset ? Asset->Find(GraphKey) : nullptr;
 }
 
 void FNodeNameRegistry::Register(const FString& AssetPath, const FString& GraphName,
                                   const FString& NodeName, const FGuid& NodeGuid)
 {
-	FString Key = MakeKey(AssetPath, GraphName, NodeName);
+	LoadIfNeeded();
+
+	FGraphNames& Graph = Assets.FindOrAdd(FName(*AssetPath)).FindOrAdd(FName(*GraphName));
+	const FName NameKey(*NodeName);
 
 	// Add or replace
-	if (Registry.Contains(Key))
+	if (FGuid* Existing = Graph.Names.Find(NameKey))
 	{
-		UE_LOG(LogTemp, Log, TEXT("[NodeNameRegistry] Replacing: %s -> %s"), *NodeName, *NodeGuid.ToString());
+		if (*Existing == NodeGuid)
+		{
+			return;
+		}
+		UE_LOG(LogTemp, Verbose, TEXT("[NodeNameRegistry] Replacing: %s -> %s"), *NodeName, *NodeGuid.ToString());
+		*Existing = NodeGuid;
 	}
 	else
 	{
-		UE_LOG(LogTemp, Log, TEXT("[NodeNameRegistry] Registering: %s -> %s"), *NodeName, *NodeGuid.ToString());
+		UE_LOG(LogTemp, Verbose, TEXT("[NodeNameRegistry] Registering: %s -> %s"), *NodeName, *NodeGuid.ToString());
+		Graph.Names.Add(NameKey, NodeGuid);
+		Count++;
 	}
 
-	Registry.Add(Key, NodeGuid);
+	MarkDirty();
 }
 
 FGuid FNodeNameRegistry::Resolve(const FString& AssetPath, const FString& GraphName,
                                   const FString& NodeName) const
 {
-	FString Key = MakeKey(AssetPath, GraphName, NodeName);
-
-	const FGuid* Found = Registry.Find(Key);
-	if (Found)
+	const FName NameKey = FindName(NodeName);
+	const FGraphNames* Graph = NameKey.IsNone() ? nullptr : FindGraph(AssetPath, GraphName);
+	if (Graph)
 	{
-		return *Found;
+		if (const FGuid* Found = Graph->Names.Find(NameKey))
+		{
+			return *Found;
+		}
 	}
 
 	return FGuid(); // Invalid GUID
@@ -64,64 +99,302 @@ FGuid FNodeNameRegistry::Resolve(const FString& AssetPath, const FString& GraphN
 bool FNodeNameRegistry::IsRegistered(const FString& AssetPath, const FString& GraphName,
                                       const FString& NodeName) const
 {
-	FString Key = MakeKey(AssetPath, GraphName, NodeName);
-	return Registry.Contains(Key);
+	return Resolve(AssetPath, GraphName, NodeName).IsValid();
 }
 
 void FNodeNameRegistry::Unregister(const FString& AssetPath, const FString& GraphName,
                                     const FString& NodeName)
 {
-	FString Key = MakeKey(AssetPath, GraphName, NodeName);
-	Registry.Remove(Key);
+	FGraphNames* Graph = const_cast<FGraphNames*>(FindGraph(AssetPath, GraphName));
+	const FName NameKey = FindName(NodeName);
+	if (Graph && !NameKey.IsNone() && Graph->Names.Remove(NameKey) > 0)
+	{
+		Count--;
+		MarkDirty();
+	}
 }
 
-void FNodeNameRegistry::ClearGraph(const FString& AssetPath, const FString& GraphName)
+void FNodeNameRegistry::ValidateGraph(const FString& AssetPath, const UEdGraph* Graph)
 {
-	FString Prefix = FString::Printf(TEXT("%s|%s|"), *AssetPath, *GraphName);
+	FGraphNames* Names = Graph ? const_cast<FGraphNames*>(FindGraph(AssetPath, Graph->GetName())) : nullptr;
+	if (!Names || Names->bValidated)
+	{
+		return;
+	}
+	Names->bValidated = true;
+
+	TSet<FGuid> NodeGuids;
+	NodeGuids.Reserve(Graph->Nodes.Num());
+	for (const UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (Node)
+		{
+			NodeGuids.Add(Node->NodeGuid);
+		}
+	}
 
-	TArray<FString> KeysToRemove;
-	for (const auto& Pair : Registry)
+	int32 Removed = 0;
+	for (auto It = Names->Names.CreateIterator(); It; ++It)
 	{
-		if (Pair.Key.StartsWith(Prefix))
+		if (!NodeGuids.Contains(It.Value()))
 		{
-			KeysToRemove.Add(Pair.Key);
+			It.RemoveCurrent();
+			Removed++;
 		}
 	}
 
-	for (const FString& Key : KeysToRemove)
+	if (Removed > 0)
+	{
+		Count -= Removed;
+		MarkDirty();
+		UE_LOG(LogTemp, Log, TEXT("[NodeNameRegistry] Dropped %d stale saved names for %s:%s"),
+		       Removed, *AssetPath, *Graph->GetName());
+	}
+}
+
+void FNodeNameRegistry::ClearGraph(const FString& AssetPath, const FString& GraphName)
+{
+	LoadIfNeeded();
+
+	FAssetNames* Asset = Assets.Find(FindName(AssetPath));
+	const FName GraphKey = FindName(GraphName);
+	FGraphNames Removed;
+	if (!Asset || GraphKey.IsNone() || !Asset->RemoveAndCopyValue(GraphKey, Removed))
 	{
-		Registry.Remove(Key);
+		return;
 	}
 
+	if (Asset->Num() == 0)
+	{
+		Assets.Remove(FindName(AssetPath));
+	}
+	Count -= Removed.Names.Num();
+	MarkDirty();
+
 	UE_LOG(LogTemp, Log, TEXT("[NodeNameRegistry] Cleared %d entries for %s:%s"),
-	       KeysToRemove.Num(), *AssetPath, *GraphName);
+	       Removed.Names.Num(), *AssetPath, *GraphName);
 }
 
 void FNodeNameRegistry::ClearAsset(const FString& AssetPath)
 {
-	FString Prefix = AssetPath + TEXT("|");
+	LoadIfNeeded();
 
-	TArray<FString> KeysToRemove;
-	for (const auto& Pair : Registry)
+	const FName AssetKey = FindName(AssetPath);
+	FAssetNames Removed;
+	if (AssetKey.IsNone() || !Assets.RemoveAndCopyValue(AssetKey, Removed))
 	{
-		if (Pair.Key.StartsWith(Prefix))
-		{
-			KeysToRemove.Add(Pair.Key);
-		}
+		return;
 	}
 
-	for (const FString& Key : KeysToRemove)
+	int32 RemovedCount = 0;
+	for (const TPair<FName, FGraphNames>& Graph : Removed)
 	{
-		Registry.Remove(Key);
+		RemovedCount += Graph.Value.Names.Num();
 	}
+	Count -= RemovedCount;
+	MarkDirty();
 
 	UE_LOG(LogTemp, Log, TEXT("[NodeNameRegistry] Cleared %d entries for %s"),
-	       KeysToRemove.Num(), *AssetPath);
+	       RemovedCount, *AssetPath);
 }
 
 void FNodeNameRegistry::ClearAll()
 {
-	int32 Count = Registry.Num();
-	Registry.Empty();
-	UE_LOG(LogTemp, Log, TEXT("[NodeNameRegistry] Cleared all %d entries"), Count);
+	LoadIfNeeded();
+
+	const int32 Cleared = Count;
+	Assets.Empty();
+	Count = 0;
+	MarkDirty();
+	UE_LOG(LogTemp, Log, TEXT("[NodeNameRegistry] Cleared all %d entries"), Cleared);
+}
+
+FString FNodeNameRegistry::GetSaveFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("node_names.json");
+}
+
+void FNodeNameRegistry::LoadIfNeeded() const
+{
+	if (bLoaded)
+	{
+		return;
+	}
+	bLoaded = true;
+
+	if (!IsPersistenceEnabled())
+	{
+		return;
+	}
+
+	FString Content;
+	if (!FFileHelper::LoadFileToString(Content, *GetSaveFilePath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NodeNameRegistry] Ignoring unreadable %s"), *GetSaveFilePath());
+		return;
+	}
+
+	int32 Version = 0;
+	const TSharedPtr<FJsonObject>* AssetsObj;
+	if (!JsonObject->TryGetNumberField(TEXT("version"), Version) || Version != SaveFileVersion
+		|| !JsonObject->TryGetObjectField(TEXT("assets"), AssetsObj))
+	{
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	int32 DroppedAssets = 0;
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& AssetPair : (*AssetsObj)->Values)
+	{
+		// Names for deleted or renamed assets can never resolve again
+		if (!AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(AssetPair.Key)).IsValid())
+		{
+			DroppedAssets++;
+			continue;
+		}
+
+		const TSharedPtr<FJsonObject>* GraphsObj;
+		if (!AssetPair.Value->TryGetObject(GraphsObj))
+		{
+			continue;
+		}
+
+		FAssetNames& Asset = Assets.FindOrAdd(FName(*AssetPair.Key));
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& GraphPair : (*GraphsObj)->Values)
+		{
+			const TSharedPtr<FJsonObject>* NamesObj;
+			if (!GraphPair.Value->TryGetObject(NamesObj))
+			{
+				continue;
+			}
+
+			FGraphNames& Graph = Asset.FindOrAdd(FName(*GraphPair.Key));
+			Graph.bValidated = false;
+			Graph.Names.Reserve((*NamesObj)->Values.Num());
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& NamePair : (*NamesObj)->Values)
+			{
+				FString GuidString;
+				FGuid Guid;
+				if (NamePair.Value->TryGetString(GuidString) && FGuid::Parse(GuidString, Guid) && Guid.IsValid())
+				{
+					Graph.Names.Add(FName(*NamePair.Key), Guid);
+					Count++;
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NodeNameRegistry] Loaded %d saved names (%d missing assets dropped)"), Count, DroppedAssets);
+}
+
+void FNodeNameRegistry::MarkDirty()
+{
+	if (!IsPersistenceEnabled() || SaveTickerHandle.IsValid())
+	{
+		return;
+	}
+
+	// Coalesce bursts (a compact read registers every node) into one write
+	SaveTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FNodeNameRegistry::HandleSaveTick), SaveDelaySeconds);
+}
+
+bool FNodeNameRegistry::HandleSaveTick(float DeltaTime)
+{
+	SaveTickerHandle.Reset();
+	Save(true);
+	return false;
+}
+
+void FNodeNameRegistry::Save(bool bAsync)
+{
+	TSharedPtr<FJsonObject> AssetsObj = MakeShared<FJsonObject>();
+	for (const TPair<FName, FAssetNames>& AssetPair : Assets)
+	{
+		TSharedPtr<FJsonObject> GraphsObj = MakeShared<FJsonObject>();
+		for (const TPair<FName, FGraphNames>& GraphPair : AssetPair.Value)
+		{
+			if (GraphPair.Value.Names.Num() == 0)
+			{
+				continue;
+			}
+
+			TSharedPtr<FJsonObject> NamesObj = MakeShared<FJsonObject>();
+			for (const TPair<FName, FGuid>& NamePair : GraphPair.Value.Names)
+			{
+				NamesObj->SetStringField(NamePair.Key.ToString(), NamePair.Value.ToString());
+			}
+			GraphsObj->SetObjectField(GraphPair.Key.ToString(), NamesObj);
+		}
+		if (GraphsObj->Values.Num() > 0)
+		{
+			AssetsObj->SetObjectField(AssetPair.Key.ToString(), GraphsObj);
+		}
+	}
+
+	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("version"), SaveFileVersion);
+	Root->SetObjectField(TEXT("assets"), AssetsObj);
+
+	// Saves are SaveDelaySeconds apart, so the previous one has almost always finished
+	if (PendingSave.IsValid())
+	{
+		PendingSave.Wait();
+	}
+
+	// Serializing and writing don't touch the registry, so they run off the game thread
+	if (bAsync)
+	{
+		PendingSave = Async(EAsyncExecution::ThreadPool, [Root]()
+		{
+			WriteFile(Root.ToSharedRef());
+		});
+	}
+	else
+	{
+		WriteFile(Root.ToSharedRef());
+	}
+}
+
+void FNodeNameRegistry::WriteFile(const TSharedRef<FJsonObject>& Root)
+{
+	FString Output;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+	FJsonSerializer::Serialize(Root, JsonWriter);
+
+	// Write then move so a crash mid-write never leaves a truncated file behind
+	const FString SavePath = GetSaveFilePath();
+	const FString TempPath = SavePath + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(Output, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !IFileManager::Get().Move(*SavePath, *TempPath, true, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NodeNameRegistry] Failed to write %s"), *SavePath);
+	}
+}
+
+void FNodeNameRegistry::Shutdown()
+{
+	if (!SaveTickerHandle.IsValid())
+	{
+		// Nothing new to write, but a save may still be running on the thread pool
+		if (PendingSave.IsValid())
+		{
+			PendingSave.Wait();
+		}
+		return;
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(SaveTickerHandle);
+	SaveTickerHandle.Reset();
+
+	// The thread pool may not run again before the module unloads; Save waits for a running save first
+	Save(false);
 }
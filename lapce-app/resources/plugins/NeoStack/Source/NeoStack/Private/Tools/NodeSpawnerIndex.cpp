@@ -0,0 +1,385 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/NodeSpawnerIndex.h"
+#include "BlueprintActionDatabase.h"
+#include "BlueprintNodeSpawner.h"
+#include "BlueprintNodeSignature.h"
+#include "BlueprintVariableNodeSpawner.h"
+#include "K2Node_VariableGet.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+
+namespace
+{
+	/** Split lowercased text into alphanumeric words */
+	void SplitWords(const FString& Text, TArray<FString>& OutWords)
+	{
+		FString Current;
+		for (const TCHAR C : Text)
+		{
+			if (FChar::IsAlnum(C))
+			{
+				Current.AppendChar(C);
+			}
+			else if (!Current.IsEmpty())
+			{
+				OutWords.Add(MoveTemp(Current));
+				Current.Reset();
+			}
+		}
+		if (!Current.IsEmpty())
+		{
+			OutWords.Add(MoveTemp(Current));
+		}
+	}
+}
+
+FNodeSpawnerIndex& FNodeSpawnerIndex::Get()
+{
+	static FNodeSpawnerIndex Instance;
+	return Instance;
+}
+
+FString FNodeSpawnerIndex::MakeSpawnerId(UBlueprintNodeSpawner* Spawner)
+{
+	// IMPORTANT: UBlueprintVariableNodeSpawner has a bug where GetSpawnerSignature()
+	// doesn't include the property for member variables - all getters have the same GUID!
+	// We fix this by using property path for variable spawners.
+	if (const UBlueprintVariableNodeSpawner* VarSpawner = Cast<UBlueprintVariableNodeSpawner>(Spawner))
+	{
+		if (FProperty const* VarProp = VarSpawner->GetVarProperty())
+		{
+			// Use property path as unique identifier for member variables
+			// Format: VARGET:PropertyPath or VARSET:PropertyPath
+			bool bIsGetter = Spawner->NodeClass && Spawner->NodeClass->IsChildOf(UK2Node_VariableGet::StaticClass());
+			return FString::Printf(TEXT("%s:%s"),
+				bIsGetter ? TEXT("VARGET") : TEXT("VARSET"),
+				*VarProp->GetPathName());
+		}
+	}
+
+	// All other spawner types (and local variables) - the signature GUID is unique
+	return Spawner->GetSpawnerSignature().AsGuid().ToString();
+}
+
+void FNodeSpawnerIndex::Sync(UEdGraph* ContextGraph)
+{
+	FBlueprintActionDatabase& ActionDatabase = FBlueprintActionDatabase::Get();
+
+	if (!bDelegatesRegistered)
+	{
+		ActionDatabase.OnEntryUpdated().AddRaw(this, &FNodeSpawnerIndex::HandleEntryChanged);
+		ActionDatabase.OnEntryRemoved().AddRaw(this, &FNodeSpawnerIndex::HandleEntryChanged);
+		bDelegatesRegistered = true;
+	}
+
+	// Compaction: once most entries are stale a clean build is cheaper than skipping them
+	if (!bBuilt || RemovedCount > Entries.Num() / 2)
+	{
+		BuildAll(ContextGraph);
+		return;
+	}
+
+	if (DirtyOwners.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 OwnerCount = DirtyOwners.Num();
+
+	TSet<FObjectKey> Owners = MoveTemp(DirtyOwners);
+	DirtyOwners.Reset();
+	for (const FObjectKey& Owner : Owners)
+	{
+		ReindexOwner(Owner, ContextGraph);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Node index: re-indexed %d owners in %.1f ms"), OwnerCount, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FNodeSpawnerIndex::BuildAll(UEdGraph* ContextGraph)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	Entries.Reset();
+	EntriesByOwner.Reset();
+	TrigramPostings.Reset();
+	InitialsPostings.Reset();
+	DirtyOwners.Reset();
+	RemovedCount = 0;
+
+	const FBlueprintActionDatabase::FActionRegistry& AllActions = FBlueprintActionDatabase::Get().GetAllActions();
+	for (const auto& ActionPair : AllActions)
+	{
+		for (UBlueprintNodeSpawner* Spawner : ActionPair.Value)
+		{
+			AddSpawner(Spawner, ActionPair.Key, ContextGraph);
+		}
+	}
+
+	bBuilt = true;
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStack] Node index built: %d spawners from %d owners in %.1f ms"),
+		Entries.Num(), AllActions.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FNodeSpawnerIndex::ReindexOwner(const FObjectKey& Owner, UEdGraph* ContextGraph)
+{
+	TArray<int32> OldEntries;
+	if (EntriesByOwner.RemoveAndCopyValue(Owner, OldEntries))
+	{
+		for (const int32 Index : OldEntries)
+		{
+			if (!Entries[Index].bRemoved)
+			{
+				Entries[Index].bRemoved = true;
+				++RemovedCount;
+			}
+		}
+	}
+
+	const FBlueprintActionDatabase::FActionRegistry& AllActions = FBlueprintActionDatabase::Get().GetAllActions();
+	if (const FBlueprintActionDatabase::FActionList* Actions = AllActions.Find(Owner))
+	{
+		for (UBlueprintNodeSpawner* Spawner : *Actions)
+		{
+			AddSpawner(Spawner, Owner, ContextGraph);
+		}
+	}
+}
+
+void FNodeSpawnerIndex::AddSpawner(UBlueprintNodeSpawner* Spawner, const FObjectKey& Owner, UEdGraph* ContextGraph)
+{
+	if (!Spawner || !Spawner->NodeClass)
+	{
+		return;
+	}
+
+	// Get UI spec for menu name, category, etc.
+	const FBlueprintActionUiSpec& UiSpec = Spawner->PrimeDefaultUiSpec(ContextGraph);
+
+	FEntry Entry;
+	Entry.Name = UiSpec.MenuName.ToString();
+	Entry.Category = UiSpec.Category.ToString();
+	Entry.Keywords = UiSpec.Keywords.ToString();
+	Entry.Tooltip = UiSpec.Tooltip.ToString();
+
+	// For variable spawners, generate fallback name from property if UiSpec is empty
+	if (const UBlueprintVariableNodeSpawner* VarSpawner = Cast<UBlueprintVariableNodeSpawner>(Spawner))
+	{
+		if (Entry.Name.IsEmpty())
+		{
+			if (FProperty const* VarProp = VarSpawner->GetVarProperty())
+			{
+				FString PropName = VarProp->GetName();
+				// Convert to display name (adds spaces for CamelCase)
+				FString DisplayName = FName::NameToDisplayString(PropName, false);
+				bool bIsGetter = Spawner->NodeClass->IsChildOf(UK2Node_VariableGet::StaticClass());
+				Entry.Name = FString::Printf(TEXT("%s %s"), bIsGetter ? TEXT("Get") : TEXT("Set"), *DisplayName);
+				// Also add the raw property name as a keyword for better matching
+				Entry.Keywords = Entry.Keywords.IsEmpty() ? PropName.ToLower() : Entry.Keywords + TEXT(" ") + PropName.ToLower();
+			}
+		}
+	}
+
+	// Skip empty names
+	if (Entry.Name.IsEmpty())
+	{
+		return;
+	}
+
+	Entry.Spawner = Spawner;
+	Entry.Owner = Owner;
+	Entry.SpawnerId = MakeSpawnerId(Spawner);
+
+	const int32 Index = Entries.Add(MoveTemp(Entry));
+	EntriesByOwner.FindOrAdd(Owner).Add(Index);
+	AddPostings(Index);
+}
+
+void FNodeSpawnerIndex::AddPostings(int32 EntryIndex)
+{
+	const FEntry& Entry = Entries[EntryIndex];
+	const FString LowerName = Entry.Name.ToLower();
+	const FString LowerKeywords = Entry.Keywords.ToLower();
+
+	TSet<uint64> Trigrams;
+	CollectTrigrams(LowerName, Trigrams);
+	CollectTrigrams(LowerKeywords, Trigrams);
+	for (const uint64 Trigram : Trigrams)
+	{
+		TrigramPostings.FindOrAdd(Trigram).Add(EntryIndex);
+	}
+
+	TArray<FString> NameWords;
+	SplitWords(LowerName, NameWords);
+
+	if (NameWords.Num() >= 2)
+	{
+		FString Initials;
+		Initials.AppendChar(NameWords[0][0]);
+		Initials.AppendChar(NameWords[1][0]);
+		InitialsPostings.FindOrAdd(Initials).Add(EntryIndex);
+	}
+}
+
+void FNodeSpawnerIndex::FindCandidates(const FString& LowerQuery, TSet<int32>& OutCandidates) const
+{
+	const FString Normalized = LowerQuery.Replace(TEXT(" "), TEXT(""));
+	if (Normalized.IsEmpty())
+	{
+		return;
+	}
+
+	TSet<int32> Found;
+	auto AddLive = [this, &Found](const TArray<int32>& Posting)
+	{
+		for (const int32 Index : Posting)
+		{
+			if (!Entries[Index].bRemoved)
+			{
+				Found.Add(Index);
+			}
+		}
+	};
+
+	if (Normalized.Len() >= 3)
+	{
+		TSet<uint64> QueryTrigrams;
+		CollectTrigrams(Normalized, QueryTrigrams);
+
+		// Substring matches contain every trigram; half still lets single typos through
+		const int32 Required = FMath::Max(1, (QueryTrigrams.Num() + 1) / 2);
+
+		TMap<int32, int32> Hits;
+		for (const uint64 Trigram : QueryTrigrams)
+		{
+			if (const TArray<int32>* Posting = TrigramPostings.Find(Trigram))
+			{
+				for (const int32 Index : *Posting)
+				{
+					int32& Count = Hits.FindOrAdd(Index);
+					if (++Count == Required && !Entries[Index].bRemoved)
+					{
+						Found.Add(Index);
+					}
+				}
+			}
+		}
+
+		// Acronym-style queries ("sac" -> "Spawn Actor from Class")
+		if (Normalized.Len() <= 6 && !LowerQuery.Contains(TEXT(" ")))
+		{
+			if (const TArray<int32>* Posting = InitialsPostings.Find(Normalized.Left(2)))
+			{
+				AddLive(*Posting);
+			}
+		}
+	}
+
+	// One or two characters also match mid-word, and a typo can share no trigram with its
+	// target; the fuzzy scorer finds both, so let it see every entry
+	if (Normalized.Len() < 3 || Found.Num() < MinCandidates)
+	{
+		for (int32 Index = 0; Index < Entries.Num(); ++Index)
+		{
+			if (!Entries[Index].bRemoved)
+			{
+				OutCandidates.Add(Index);
+			}
+		}
+		return;
+	}
+
+	OutCandidates.Append(Found);
+}
+
+void FNodeSpawnerIndex::WatchBlueprint(UBlueprint* Blueprint)
+{
+	if (!Blueprint || WatchedBlueprints.Contains(Blueprint))
+	{
+		return;
+	}
+
+	// Drop registrations of Blueprints that are gone
+	WatchedBlueprints.RemoveAll([](const TWeakObjectPtr<UBlueprint>& Watched) { return !Watched.IsValid(); });
+
+	Blueprint->OnChanged().AddRaw(this, &FNodeSpawnerIndex::HandleBlueprintChanged);
+	WatchedBlueprints.Add(Blueprint);
+}
+
+void FNodeSpawnerIndex::HandleEntryChanged(UObject* ActionKey)
+{
+	if (ActionKey)
+	{
+		DirtyOwners.Add(FObjectKey(ActionKey));
+	}
+}
+
+void FNodeSpawnerIndex::HandleBlueprintChanged(UBlueprint* Blueprint)
+{
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	DirtyOwners.Add(FObjectKey(Blueprint));
+	if (Blueprint->GeneratedClass)
+	{
+		DirtyOwners.Add(FObjectKey(Blueprint->GeneratedClass));
+	}
+	if (Blueprint->SkeletonGeneratedClass)
+	{
+		DirtyOwners.Add(FObjectKey(Blueprint->SkeletonGeneratedClass));
+	}
+}
+
+void FNodeSpawnerIndex::Shutdown()
+{
+	if (bDelegatesRegistered)
+	{
+		FBlueprintActionDatabase::Get().OnEntryUpdated().RemoveAll(this);
+		FBlueprintActionDatabase::Get().OnEntryRemoved().RemoveAll(this);
+		bDelegatesRegistered = false;
+	}
+
+	for (const TWeakObjectPtr<UBlueprint>& Watched : WatchedBlueprints)
+	{
+		if (UBlueprint* Blueprint = Watched.Get())
+		{
+			Blueprint->OnChanged().RemoveAll(this);
+		}
+	}
+	WatchedBlueprints.Empty();
+
+	Entries.Empty();
+	EntriesByOwner.Empty();
+	TrigramPostings.Empty();
+	InitialsPostings.Empty();
+	DirtyOwners.Empty();
+	RemovedCount = 0;
+	bBuilt = false;
+}
+
+uint64 FNodeSpawnerIndex::MakeTrigram(TCHAR A, TCHAR B, TCHAR C)
+{
+	return (uint64(uint16(A)) << 32) | (uint64(uint16(B)) << 16) | uint64(uint16(C));
+}
+
+void FNodeSpawnerIndex::CollectTrigrams(const FString& LowerText, TSet<uint64>& OutTrigrams)
+{
+	TArray<TCHAR, TInlineAllocator<128>> Chars;
+	for (const TCHAR C : LowerText)
+	{
+		if (C != TEXT(' '))
+		{
+			Chars.Add(C);
+		}
+	}
+
+	for (int32 i = 0; i + 2 < Chars.Num(); ++i)
+	{
+		OutTrigrams.Add(MakeTrigram(Chars[i], Chars[i + 1], Chars[i + 2]));
+	}
+}
@@ -0,0 +1,198 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/PropertyPathCache.h"
+#include "UObject/UnrealType.h"
+#include "Editor.h"
+
+FProperty* FResolvedPropertyPath::GetLeafProperty() const
+{
+	const FSegment& Leaf = Segments.Last();
+	if (Leaf.ArrayIndex != INDEX_NONE)
+	{
+		return CastFieldChecked<FArrayProperty>(Leaf.Property)->Inner;
+	}
+	return Leaf.Property;
+}
+
+void* FResolvedPropertyPath::GetValuePtr(void* Container) const
+{
+	uint8* ValuePtr = static_cast<uint8*>(Container);
+	for (const FSegment& Segment : Segments)
+	{
+		ValuePtr = Segment.Property->ContainerPtrToValuePtr<uint8>(ValuePtr);
+		if (Segment.ArrayIndex != INDEX_NONE)
+		{
+			FScriptArrayHelper ArrayHelper(CastFieldChecked<FArrayProperty>(Segment.Property), ValuePtr);
+			if (!ArrayHelper.IsValidIndex(Segment.ArrayIndex))
+			{
+				return nullptr;
+			}
+			ValuePtr = ArrayHelper.GetRawPtr(Segment.ArrayIndex);
+		}
+	}
+	return ValuePtr;
+}
+
+FPropertyPathCache& FPropertyPathCache::Get()
+{
+	static FPropertyPathCache Instance;
+	return Instance;
+}
+
+FPropertyPathCache::FStructEntry& FPropertyPathCache::GetEntry(const UStruct* Struct)
+{
+	if (!bDelegatesRegistered && GEditor)
+	{
+		GEditor->OnBlueprintCompiled().AddRaw(this, &FPropertyPathCache::HandleBlueprintCompiled);
+		bDelegatesRegistered = true;
+	}
+
+	TUniquePtr<FStructEntry>& Entry = Entries.FindOrAdd(Struct);
+	if (Entry && Entry->ChildProperties == Struct->ChildProperties)
+	{
+		return *Entry;
+	}
+
+	Entry = MakeUnique<FStructEntry>();
+	Entry->ChildProperties = Struct->ChildProperties;
+	for (TFieldIterator<FProperty> PropIt(Struct); PropIt; ++PropIt)
+	{
+		FProperty* Property = *PropIt;
+		const FString Name = Property->GetName().ToLower();
+		if (!Entry->ByName.Contains(Name))
+		{
+			Entry->ByName.Add(Name, Property);
+		}
+
+		// User Defined Struct fields are also found by the name shown in the editor
+		const FString AuthoredName = Property->GetAuthoredName().ToLower();
+		if (!Entry->ByName.Contains(AuthoredName))
+		{
+			Entry->ByName.Add(AuthoredName, Property);
+		}
+
+		if (Property->HasAnyPropertyFlags(CPF_Edit) && !Property->HasAnyPropertyFlags(CPF_Deprecated))
+		{
+			Entry->Editable.Add(Property);
+		}
+	}
+	return *Entry;
+}
+
+bool FPropertyPathCache::Resolve(const UStruct* Struct, const FString& Path, FResolvedPropertyPath& OutPath, FString& OutError)
+{
+	if (!Struct)
+	{
+		OutError = TEXT("Invalid object");
+		return false;
+	}
+
+	FStructEntry& RootEntry = GetEntry(Struct);
+	const FString PathKey = Path.ToLower();
+	if (const FResolvedPropertyPath* Cached = RootEntry.Paths.Find(PathKey))
+	{
+		OutPath = *Cached;
+		return true;
+	}
+
+	TArray<FString> Parts;
+	Path.ParseIntoArray(Parts, TEXT("."));
+
+	FResolvedPropertyPath Resolved;
+	const UStruct* CurrentStruct = Struct;
+	for (const FString& Part : Parts)
+	{
+		if (!CurrentStruct)
+		{
+			OutError = FString::Printf(TEXT("'%s' has no members"), *Resolved.DisplayPath);
+			return false;
+		}
+
+		// "Name" or "Name[Index]"
+		FString PropertyName = Part.TrimStartAndEnd();
+		int32 ArrayIndex = INDEX_NONE;
+		int32 BracketIndex = INDEX_NONE;
+		if (PropertyName.FindChar(TEXT('['), BracketIndex) && PropertyName.EndsWith(TEXT("]")))
+		{
+			const FString IndexText = PropertyName.Mid(BracketIndex + 1, PropertyName.Len() - BracketIndex - 2);
+			if (!IndexText.IsNumeric())
+			{
+				OutError = FString::Printf(TEXT("Invalid array index in '%s'"), *Part);
+				return false;
+			}
+			ArrayIndex = FCString::Atoi(*IndexText);
+			PropertyName.LeftInline(BracketIndex);
+		}
+
+		FProperty* Property = GetEntry(CurrentStruct).ByName.FindRef(PropertyName.ToLower());
+		if (!Property)
+		{
+			OutError = Resolved.Segments.Num() == 0
+				? TEXT("Property not found")
+				: FString::Printf(TEXT("Property '%s' not found in %s"), *PropertyName, *Resolved.DisplayPath);
+			return false;
+		}
+
+		FProperty* ValueProperty = Property;
+		if (ArrayIndex != INDEX_NONE)
+		{
+			FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property);
+			if (!ArrayProp)
+			{
+				OutError = FString::Printf(TEXT("'%s' is not an array"), *Property->GetName());
+				return false;
+			}
+			ValueProperty = ArrayProp->Inner;
+		}
+
+		if (!Resolved.DisplayPath.IsEmpty())
+		{
+			Resolved.DisplayPath += TEXT(".");
+		}
+		Resolved.DisplayPath += Property->GetName();
+		if (ArrayIndex != INDEX_NONE)
+		{
+			Resolved.DisplayPath += FString::Printf(TEXT("[%d]"), ArrayIndex);
+		}
+
+		Resolved.Segments.Add({ Property, ArrayIndex });
+
+		const FStructProperty* StructProp = CastField<FStructProperty>(ValueProperty);
+		CurrentStruct = StructProp ? StructProp->Struct : nullptr;
+	}
+
+	if (Resolved.Segments.Num() == 0)
+	{
+		OutError = TEXT("Property not found");
+		return false;
+	}
+
+	// Building a nested struct's entry never moves this one (entries are heap allocated)
+	RootEntry.Paths.Add(PathKey, Resolved);
+	OutPath = MoveTemp(Resolved);
+	return true;
+}
+
+TArray<FProperty*> FPropertyPathCache::GetEditableProperties(const UStruct* Struct)
+{
+	return Struct ? GetEntry(Struct).Editable : TArray<FProperty*>();
+}
+
+void FPropertyPathCache::HandleBlueprintCompiled()
+{
+	Entries.Empty();
+}
+
+void FPropertyPathCache::Shutdown()
+{
+	if (bDelegatesRegistered)
+	{
+		if (GEditor)
+		{
+			GEditor->OnBlueprintCompiled().RemoveAll(this);
+		}
+		bDelegatesRegistered = false;
+	}
+
+	Entries.Empty();
+}
@@ -2,6 +2,10 @@
 
 #include "Tools/ReadFileTool.h"
 #include "Tools/NeoStackToolUtils.h"
+#include "Tools/TextFileReader.h"
+#include "Tools/AssetReadCache.h"
+#include "Tools/NodeNameRegistry.h"
+#include "Tools/GraphSnapshotStore.h"
 #include "Json.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
@@ -66,6 +70,22 @@
 #include "UserDefinedStructure/UserDefinedStructEditorData.h"
 #include "Kismet2/StructureEditorUtils.h"
 
+bool FReadFileTool::IsCacheable(const TSharedPtr<FJsonObject>& Args) const
+{
+	FString Name, Path;
+	if (!Args.IsValid() || !Args->TryGetStringField(TEXT("name"), Name) || Name.IsEmpty())
+	{
+		return false;
+	}
+	Args->TryGetStringField(TEXT("path"), Path);
+	return !NeoStackToolUtils::IsAssetPath(Name, Path);
+}
+
+void FReadFileTool::GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const
+{
+	NeoStackToolUtils::AddNamePathResource(Args, OutKeys);
+}
+
 FToolResult FReadFileTool::Execute(const TSharedPtr<FJsonObject>& Args)
 {
 	FString Name, Path, GraphName;
@@ -82,6 +102,27 @@ FToolResult FReadFileTool::Execute(const TSharedPtr<FJsonObject>& Args)
 	Args->TryGetStringField(TEXT("graph"), GraphName);
 	Args->TryGetNumberField(TEXT("offset"), Offset);
 	Args->TryGetNumberField(TEXT("limit"), Limit);
+	bool bCompact = false;
+	Args->TryGetBoolField(TEXT("compact"), bCompact);
+
+	// Version tokens from earlier graph reads: one string or an array
+	TArray<FString> SinceTokens;
+	FString SinceToken;
+	const TArray<TSharedPtr<FJsonValue>>* SinceArray;
+	if (Args->TryGetStringField(TEXT("since"), SinceToken) && !SinceToken.IsEmpty())
+	{
+		SinceTokens.Add(SinceToken);
+	}
+	else if (Args->TryGetArrayField(TEXT("since"), SinceArray))
+	{
+		for (const auto& Val : *SinceArray)
+		{
+			if (Val->TryGetString(SinceToken) && !SinceToken.IsEmpty())
+			{
+				SinceTokens.Add(SinceToken);
+			}
+		}
+	}
 
 	// Parse include array
 	const TArray<TSharedPtr<FJsonValue>>* IncludeArray;
@@ -97,6 +138,23 @@ FToolResult FReadFileTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		}
 	}
 
+	// DataTable column projection and row filters; either implies reading rows
+	FDataTableQuery TableQuery;
+	Args->TryGetStringArrayField(TEXT("columns"), TableQuery.Columns);
+	Args->TryGetStringArrayField(TEXT("where"), TableQuery.Where);
+	if ((TableQuery.Columns.Num() > 0 || TableQuery.Where.Num() > 0) && !Include.Contains(TEXT("rows")))
+	{
+		Include.Add(TEXT("rows"));
+	}
+
+	// Widget and behavior tree subtree addressing
+	FTreeQuery TreeQuery;
+	Args->TryGetStringField(TEXT("root"), TreeQuery.Root);
+	if (Args->TryGetNumberField(TEXT("depth"), TreeQuery.MaxDepth))
+	{
+		TreeQuery.MaxDepth = FMath::Max(0, TreeQuery.MaxDepth);
+	}
+
 	// Default include if not specified
 	if (Include.Num() == 0)
 	{
@@ -122,6 +180,56 @@ FToolResult FReadFileTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		return FToolResult::Fail(FString::Printf(TEXT("Asset not found: %s"), *FullAssetPath));
 	}
 
+	// Repeated reads of an unchanged asset come from the cache. Compact reads register their "@N"
+	// aliases while rendering, so a cached copy would hand out aliases the registry no longer knows
+	const bool bCacheable = !bCompact && IsReadCacheable(Asset);
+	TArray<FString> SortedInclude = Include;
+	SortedInclude.Sort();
+	const FString CacheKey = FString::Printf(TEXT("%s|%s|%d|%d|%d|%s|%s|%s|%s|%d"),
+		*FString::Join(SortedInclude, TEXT(",")), *GraphName.ToLower(), Offset, Limit, bCompact ? 1 : 0,
+		*FString::Join(SinceTokens, TEXT(",")), *FString::Join(TableQuery.Columns, TEXT(",")),
+		*FString::Join(TableQuery.Where, TEXT("\x1f")), *TreeQuery.Root.ToLower(), TreeQuery.MaxDepth);
+
+	if (bCacheable)
+	{
+		if (const FString* Cached = FAssetReadCache::Get().Find(Asset, CacheKey))
+		{
+			return FToolResult::Ok(*Cached);
+		}
+	}
+
+	FToolResult Result = ReadAsset(Asset, Include, GraphName, SinceTokens, Offset, Limit, bCompact, TableQuery, TreeQuery);
+
+	// Each section caps itself; several graphs together could still exceed the limit
+	if (Result.bSuccess)
+	{
+		Result.Output = NeoStackToolUtils::CapToolOutput(MoveTemp(Result.Output));
+	}
+	if (Result.bSuccess && bCacheable)
+	{
+		FAssetReadCache::Get().Store(Asset, CacheKey, Result.Output);
+	}
+	return Result;
+}
+
+bool FReadFileTool::IsReadCacheable(UObject* Asset) const
+{
+	// An open Material Editor works on a preview copy whose edits never touch the asset's package
+	if (Asset->IsA<UMaterial>() && GEditor)
+	{
+		UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+		if (AssetEditorSubsystem && AssetEditorSubsystem->FindEditorForAsset(Asset, false))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+FToolResult FReadFileTool::ReadAsset(UObject* Asset, const TArray<FString>& Include, const FString& GraphName,
+	const TArray<FString>& SinceTokens, int32 Offset, int32 Limit, bool bCompact, const FDataTableQuery& TableQuery,
+	const FTreeQuery& TreeQuery)
+{
 	// Collect graphs and metadata based on asset type
 	TArray<TPair<UEdGraph*, FString>> Graphs; // Graph + Type
 	FString AssetType;
@@ -173,8 +281,14 @@ FToolResult FReadFileTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		}
 		if (Include.Contains(TEXT("widgets")) || Include.Contains(TEXT("tree")))
 		{
+			FString TreeError;
+			const FString Tree = GetWidgetTree(WidgetBlueprint, TreeQuery, Offset, Limit, TreeError);
+			if (!TreeError.IsEmpty())
+			{
+				return FToolResult::Fail(TreeError);
+			}
 			if (!Summary.IsEmpty()) Summary += TEXT("\n");
-			Summary += GetWidgetTree(WidgetBlueprint);
+			Summary += Tree;
 		}
 		if (Include.Contains(TEXT("variables")))
 		{
@@ -305,8 +419,14 @@ FToolResult FReadFileTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		}
 		if (Include.Contains(TEXT("nodes")) || Include.Contains(TEXT("tree")))
 		{
+			FString TreeError;
+			const FString Tree = GetBehaviorTreeNodes(BehaviorTree, TreeQuery, Offset, Limit, TreeError);
+			if (!TreeError.IsEmpty())
+			{
+				return FToolResult::Fail(TreeError);
+			}
 			if (!Summary.IsEmpty()) Summary += TEXT("\n");
-			Summary += GetBehaviorTreeNodes(BehaviorTree);
+			Summary += Tree;
 		}
 
 		// BTs don't have traditional graphs, output is in Summary
@@ -374,8 +494,14 @@ FToolResult FReadFileTool::Execute(const TSharedPtr<FJsonObject>& Args)
 
 		if (Include.Contains(TEXT("rows")) || Include.Contains(TEXT("data")))
 		{
+			FString QueryError;
+			const FString Rows = GetDataTableRows(DataTable, Offset, Limit, TableQuery, QueryError);
+			if (!QueryError.IsEmpty())
+			{
+				return FToolResult::Fail(QueryError);
+			}
 			if (!Summary.IsEmpty()) Summary += TEXT("\n");
-			Summary += GetDataTableRows(DataTable, Offset, Limit);
+			Summary += Rows;
 		}
 
 		// Return early - DataTables don't have graphs
@@ -393,9 +519,7 @@ FToolResult FReadFileTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		{
 			if (GraphPair.Key->GetName().Equals(GraphName, ESearchCase::IgnoreCase))
 			{
-				FString Output = GetGraphWithNodes(GraphPair.Key, GraphPair.Value, TEXT(""), Offset, Limit);
-				Output += TEXT("\n") + GetGraphConnections(GraphPair.Key);
-				return FToolResult::Ok(Output);
+				return FToolResult::Ok(GetGraphOutput(GraphPair.Key, GraphPair.Value, Asset->GetPathName(), SinceTokens, Offset, Limit, bCompact));
 			}
 		}
 		return FToolResult::Fail(FString::Printf(TEXT("Graph not found: %s"), *GraphName));
@@ -410,8 +534,7 @@ FToolResult FReadFileTool::Execute(const TSharedPtr<FJsonObject>& Args)
 		for (const auto& GraphPair : Graphs)
 		{
 			if (!Output.IsEmpty()) Output += TEXT("\n");
-			Output += GetGraphWithNodes(GraphPair.Key, GraphPair.Value, TEXT(""), Offset, Limit);
-			Output += TEXT("\n") + GetGraphConnections(GraphPair.Key);
+			Output += GetGraphOutput(GraphPair.Key, GraphPair.Value, Asset->GetPathName(), SinceTokens, Offset, Limit, bCompact);
 		}
 	}
 
@@ -433,35 +556,32 @@ FToolResult FReadFileTool::ReadTextFile(const FString& Name, const FString& Path
 		return FToolResult::Fail(FString::Printf(TEXT("File not found: %s"), *FullPath));
 	}
 
-	// Read file
-	FString Content;
-	if (!FFileHelper::LoadFileToString(Content, *FullPath))
+	// Read only the requested window; the line index is cached per file
+	TArray<FString> Lines;
+	int32 TotalLines = 0;
+	int32 StartIndex = Offset - 1; // Convert to 0-based
+	if (!FTextFileReader::Get().ReadLines(FullPath, StartIndex, Limit, Lines, TotalLines))
 	{
 		return FToolResult::Fail(FString::Printf(TEXT("Failed to read file: %s"), *FullPath));
 	}
 
-	// Split into lines
-	TArray<FString> Lines;
-	Content.ParseIntoArrayLines(Lines);
-
-	int32 TotalLines = Lines.Num();
-	int32 StartIndex = Offset - 1; // Convert to 0-based
-	int32 EndIndex = FMath::Min(StartIndex + Limit, TotalLines);
-
 	if (StartIndex >= TotalLines)
 	{
 		return FToolResult::Ok(FString::Printf(TEXT("# FILE %s lines=%d offset=%d beyond_end"), *Name, TotalLines, Offset));
 	}
 
+	int32 EndIndex = StartIndex + Lines.Num();
+
 	// Build output
-	FString Output = FString::Printf(TEXT("# FILE %s lines=%d-%d/%d\n"), *Name, Offset, EndIndex, TotalLines);
+	NeoStackToolUtils::FToolOutputWriter Output(128 + Lines.Num() * 96);
+	Output.Appendf(TEXT("# FILE %s lines=%d-%d/%d\n"), *Name, Offset, EndIndex, TotalLines);
 
-	for (int32 i = StartIndex; i < EndIndex; i++)
+	for (int32 i = 0; i < Lines.Num(); i++)
 	{
-		Output += FString::Printf(TEXT("%d\t%s\n"), i + 1, *Lines[i]);
+		Output.Appendf(TEXT("%d\t%s\n"), StartIndex + i + 1, *Lines[i]);
 	}
 
-	return FToolResult::Ok(Output);
+	return FToolResult::Ok(Output.ToString());
 }
 
 FString FReadFileTool::GetBlueprintSummary(UBlueprint* Blueprint)
@@ -476,26 +596,27 @@ FString FReadFileTool::GetBlueprintSummary(UBlueprint* Blueprint)
 	int32 VarCount = Blueprint->NewVariables.Num();
 	int32 GraphCount = Blueprint->UbergraphPages.Num() + Blueprint->FunctionGraphs.Num() + Blueprint->MacroGraphs.Num();
 
-	FString Output = FString::Printf(TEXT("# BLUEPRINT %s parent=%s\ncomponents=%d variables=%d graphs=%d\n"),
+	NeoStackToolUtils::FToolOutputWriter Output(256 + GraphCount * 48);
+	Output.Appendf(TEXT("# BLUEPRINT %s parent=%s\ncomponents=%d variables=%d graphs=%d\n"),
 		*Blueprint->GetName(), *ParentName, ComponentCount, VarCount, GraphCount);
 
 	// Add graph list
-	Output += FString::Printf(TEXT("\n# GRAPHS %d\n"), GraphCount);
+	Output.Appendf(TEXT("\n# GRAPHS %d\n"), GraphCount);
 
 	for (UEdGraph* Graph : Blueprint->UbergraphPages)
 	{
-		Output += FString::Printf(TEXT("%s\tubergraph\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
+		Output.Appendf(TEXT("%s\tubergraph\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
 	}
 	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
 	{
-		Output += FString::Printf(TEXT("%s\tfunction\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
+		Output.Appendf(TEXT("%s\tfunction\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
 	}
 	for (UEdGraph* Graph : Blueprint->MacroGraphs)
 	{
-		Output += FString::Printf(TEXT("%s\tmacro\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
+		Output.Appendf(TEXT("%s\tmacro\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FReadFileTool::GetBlueprintVariables(UBlueprint* Blueprint, int32 Offset, int32 Limit)
@@ -511,7 +632,8 @@ FString FReadFileTool::GetBlueprintVariables(UBlueprint* Blueprint, int32 Offset
 	int32 StartIdx = Offset - 1;
 	int32 EndIdx = FMath::Min(StartIdx + Limit, Total);
 
-	FString Output = FString::Printf(TEXT("# VARIABLES %d\n"), Total);
+	NeoStackToolUtils::FToolOutputWriter Output(64 + (EndIdx - StartIdx) * 96);
+	Output.Appendf(TEXT("# VARIABLES %d\n"), Total);
 
 	for (int32 i = StartIdx; i < EndIdx; i++)
 	{
@@ -527,10 +649,10 @@ FString FReadFileTool::GetBlueprintVariables(UBlueprint* Blueprint, int32 Offset
 		// Get default value
 		FString DefaultValue = Var.DefaultValue.IsEmpty() ? TEXT("None") : Var.DefaultValue;
 
-		Output += FString::Printf(TEXT("%s\t%s\t%s\n"), *Var.VarName.ToString(), *TypeName, *DefaultValue);
+		Output.Appendf(TEXT("%s\t%s\t%s\n"), *Var.VarName.ToString(), *TypeName, *DefaultValue);
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FReadFileTool::GetBlueprintComponents(UBlueprint* Blueprint, int32 Offset, int32 Limit)
@@ -551,7 +673,8 @@ FString FReadFileTool::GetBlueprintComponents(UBlueprint* Blueprint, int32 Offse
 	int32 StartIdx = Offset - 1;
 	int32 EndIdx = FMath::Min(StartIdx + Limit, Total);
 
-	FString Output = FString::Printf(TEXT("# COMPONENTS %d\n"), Total);
+	NeoStackToolUtils::FToolOutputWriter Output(64 + (EndIdx - StartIdx) * 96);
+	Output.Appendf(TEXT("# COMPONENTS %d\n"), Total);
 
 	for (int32 i = StartIdx; i < EndIdx; i++)
 	{
@@ -564,43 +687,40 @@ FString FReadFileTool::GetBlueprintComponents(UBlueprint* Blueprint, int32 Offse
 				ParentName = Node->ParentComponentOrVariableName.ToString();
 			}
 
-			Output += FString::Printf(TEXT("%s\t%s\t%s\n"),
+			Output.Appendf(TEXT("%s\t%s\t%s\n"),
 				*Node->GetVariableName().ToString(),
 				*Node->ComponentTemplate->GetClass()->GetName(),
 				*ParentName);
 		}
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FReadFileTool::GetBlueprintGraphs(UBlueprint* Blueprint, int32 Offset, int32 Limit)
 {
-	FString Output;
+	NeoStackToolUtils::FToolOutputWriter Output(4096);
 
 	// Collect all graphs with nodes and connections
 	for (UEdGraph* Graph : Blueprint->UbergraphPages)
 	{
-		Output += GetGraphWithNodes(Graph, TEXT("ubergraph"), TEXT(""), Offset, Limit);
-		Output += TEXT("\n") + GetGraphConnections(Graph);
-		Output += TEXT("\n");
+		Output.Append(GetGraphWithNodes(Graph, TEXT("ubergraph"), TEXT(""), Offset, Limit));
+		Output.Newline().Append(GetGraphConnections(Graph)).Newline();
 	}
 
 	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
 	{
-		Output += GetGraphWithNodes(Graph, TEXT("function"), TEXT(""), Offset, Limit);
-		Output += TEXT("\n") + GetGraphConnections(Graph);
-		Output += TEXT("\n");
+		Output.Append(GetGraphWithNodes(Graph, TEXT("function"), TEXT(""), Offset, Limit));
+		Output.Newline().Append(GetGraphConnections(Graph)).Newline();
 	}
 
 	for (UEdGraph* Graph : Blueprint->MacroGraphs)
 	{
-		Output += GetGraphWithNodes(Graph, TEXT("macro"), TEXT(""), Offset, Limit);
-		Output += TEXT("\n") + GetGraphConnections(Graph);
-		Output += TEXT("\n");
+		Output.Append(GetGraphWithNodes(Graph, TEXT("macro"), TEXT(""), Offset, Limit));
+		Output.Newline().Append(GetGraphConnections(Graph)).Newline();
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FReadFileTool::GetBlueprintInterfaces(UBlueprint* Blueprint)
@@ -612,17 +732,18 @@ FString FReadFileTool::GetBlueprintInterfaces(UBlueprint* Blueprint)
 		return TEXT("# INTERFACES 0\n");
 	}
 
-	FString Output = FString::Printf(TEXT("# INTERFACES %d\n"), Total);
+	NeoStackToolUtils::FToolOutputWriter Output(64 + Total * 48);
+	Output.Appendf(TEXT("# INTERFACES %d\n"), Total);
 
 	for (const FBPInterfaceDescription& Interface : Blueprint->ImplementedInterfaces)
 	{
 		if (Interface.Interface)
 		{
-			Output += FString::Printf(TEXT("%s\n"), *Interface.Interface->GetName());
+			Output.Appendf(TEXT("%s\n"), *Interface.Interface->GetName());
 		}
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FReadFileTool::GetGraphType(UEdGraph* Graph, UBlueprint* Blueprint)
@@ -630,26 +751,98 @@ FString FReadFileTool::GetGraphType(UEdGraph* Graph, UBlueprint* Blueprint)
 	return NeoStackToolUtils::GetGraphType(Graph, Blueprint);
 }
 
+FString FReadFileTool::GetGraphOutput(UEdGraph* Graph, const FString& GraphType, const FString& AssetPath,
+	const TArray<FString>& SinceTokens, int32 Offset, int32 Limit, bool bCompact)
+{
+	for (const FString& Token : SinceTokens)
+	{
+		if (FGraphSnapshotStore::Get().IsTokenFor(Graph, Token))
+		{
+			return GetGraphDelta(Graph, GraphType, Token);
+		}
+	}
+
+	if (bCompact)
+	{
+		return GetCompactGraph(Graph, GraphType, AssetPath, Offset, Limit);
+	}
+	return GetGraphWithNodes(Graph, GraphType, TEXT(""), Offset, Limit) + TEXT("\n") + GetGraphConnections(Graph);
+}
+
+FString FReadFileTool::GetGraphDelta(UEdGraph* Graph, const FString& GraphType, const FString& SinceToken)
+{
+	FGraphSnapshotStore::FDelta Delta;
+	FString Version;
+	if (!FGraphSnapshotStore::Get().Diff(Graph, SinceToken, Delta, Version))
+	{
+		return GetGraphWithNodes(Graph, GraphType, TEXT(""), 1, Graph->Nodes.Num()) + TEXT("\n") + GetGraphConnections(Graph);
+	}
+
+	NeoStackToolUtils::FToolOutputWriter Output(128 + (Delta.AddedNodes.Num() + Delta.ChangedNodes.Num()) * 96
+		+ Delta.RemovedNodes.Num() * 40 + (Delta.AddedLinks.Num() + Delta.RemovedLinks.Num()) * 96);
+
+	Output.Appendf(TEXT("# GRAPH_DELTA %s type=%s since=%s version=%s nodes=+%d-%d~%d\n"),
+		*Graph->GetName(), *GraphType, *SinceToken, *Version,
+		Delta.AddedNodes.Num(), Delta.RemovedNodes.Num(), Delta.ChangedNodes.Num());
+
+	// Same columns as a full read, prefixed with +/-/~
+	auto AppendNode = [this, &Output](const TCHAR* Marker, UEdGraphNode* Node)
+	{
+		Output.Appendf(TEXT("%s\t%s\t%s\t%s\n"), Marker, *NeoStackToolUtils::GetNodeGuid(Node),
+			*Node->GetNodeTitle(ENodeTitleType::ListView).ToString(), *GetNodePins(Node));
+	};
+	for (UEdGraphNode* Node : Delta.AddedNodes)
+	{
+		AppendNode(TEXT("+"), Node);
+	}
+	for (UEdGraphNode* Node : Delta.ChangedNodes)
+	{
+		AppendNode(TEXT("~"), Node);
+	}
+	for (const FGuid& Guid : Delta.RemovedNodes)
+	{
+		Output.Appendf(TEXT("-\t%s\n"), *Guid.ToString());
+	}
+
+	Output.Appendf(TEXT("\n# CONNECTIONS_DELTA %s +%d-%d\n"), *Graph->GetName(), Delta.AddedLinks.Num(), Delta.RemovedLinks.Num());
+	auto AppendLink = [&Output](const TCHAR* Marker, const FGraphSnapshotStore::FLink& Link)
+	{
+		Output.Appendf(TEXT("%s\t%s\t%s\t%s\t%s\n"), Marker,
+			*Link.FromNode.ToString(), *Link.FromPin.ToString(), *Link.ToNode.ToString(), *Link.ToPin.ToString());
+	};
+	for (const FGraphSnapshotStore::FLink& Link : Delta.AddedLinks)
+	{
+		AppendLink(TEXT("+"), Link);
+	}
+	for (const FGraphSnapshotStore::FLink& Link : Delta.RemovedLinks)
+	{
+		AppendLink(TEXT("-"), Link);
+	}
+
+	return Output.ToString();
+}
+
 FString FReadFileTool::GetGraphWithNodes(UEdGraph* Graph, const FString& GraphType, const FString& ParentGraph, int32 Offset, int32 Limit)
 {
 	int32 Total = Graph->Nodes.Num();
 	int32 StartIdx = Offset - 1;
 	int32 EndIdx = FMath::Min(StartIdx + Limit, Total);
 
-	// Build header
-	FString Output;
+	// Build header; the version token lets the next read ask for changes only
+	const FString Version = FGraphSnapshotStore::Get().Capture(Graph);
+	NeoStackToolUtils::FToolOutputWriter Output(128 + FMath::Max(0, EndIdx - StartIdx) * 128);
 	if (ParentGraph.IsEmpty())
 	{
-		Output = FString::Printf(TEXT("# GRAPH %s type=%s %d\n"), *Graph->GetName(), *GraphType, Total);
+		Output.Appendf(TEXT("# GRAPH %s type=%s %d version=%s\n"), *Graph->GetName(), *GraphType, Total, *Version);
 	}
 	else
 	{
-		Output = FString::Printf(TEXT("# GRAPH %s type=%s parent=%s %d\n"), *Graph->GetName(), *GraphType, *ParentGraph, Total);
+		Output.Appendf(TEXT("# GRAPH %s type=%s parent=%s %d version=%s\n"), *Graph->GetName(), *GraphType, *ParentGraph, Total, *Version);
 	}
 
 	if (Total == 0)
 	{
-		return Output;
+		return Output.ToString();
 	}
 
 	// Output nodes: guid, title, pins
@@ -662,48 +855,149 @@ FString FReadFileTool::GetGraphWithNodes(UEdGraph* Graph, const FString& GraphTy
 		FString NodeTitle = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
 		FString PinNames = GetNodePins(Node);
 
-		Output += FString::Printf(TEXT("%s\t%s\t%s\n"), *NodeGuid, *NodeTitle, *PinNames);
+		Output.Appendf(TEXT("%s\t%s\t%s\n"), *NodeGuid, *NodeTitle, *PinNames);
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FReadFileTool::GetGraphConnections(UEdGraph* Graph)
 {
-	TArray<FString> Connections;
+	// Count first so the output is sized once instead of growing per edge
+	int32 ConnectionCount = 0;
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node) continue;
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->Direction != EGPD_Output) continue;
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				if (LinkedPin && LinkedPin->GetOwningNode()) ConnectionCount++;
+			}
+		}
+	}
+
+	NeoStackToolUtils::FToolOutputWriter Output(64 + ConnectionCount * 96);
+	Output.Appendf(TEXT("# CONNECTIONS %s %d\n"), *Graph->GetName(), ConnectionCount);
 
 	for (UEdGraphNode* Node : Graph->Nodes)
 	{
 		if (!Node) continue;
 
-		FString FromGuid = NeoStackToolUtils::GetNodeGuid(Node);
+		const FString FromGuid = NeoStackToolUtils::GetNodeGuid(Node);
 
 		for (UEdGraphPin* Pin : Node->Pins)
 		{
-			if (Pin->Direction == EGPD_Output && Pin->LinkedTo.Num() > 0)
+			if (Pin->Direction != EGPD_Output) continue;
+
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
 			{
-				for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-				{
-					UEdGraphNode* LinkedNode = LinkedPin->GetOwningNode();
-					if (LinkedNode)
-					{
-						FString ToGuid = NeoStackToolUtils::GetNodeGuid(LinkedNode);
-						Connections.Add(FString::Printf(TEXT("%s\t%s\t%s\t%s"),
-							*FromGuid, *Pin->PinName.ToString(),
-							*ToGuid, *LinkedPin->PinName.ToString()));
-					}
-				}
+				UEdGraphNode* LinkedNode = LinkedPin ? LinkedPin->GetOwningNode() : nullptr;
+				if (!LinkedNode) continue;
+
+				Output.Appendf(TEXT("%s\t%s\t%s\t%s\n"),
+					*FromGuid, *Pin->PinName.ToString(),
+					*NeoStackToolUtils::GetNodeGuid(LinkedNode), *LinkedPin->PinName.ToString());
+			}
+		}
+	}
+
+	return Output.ToString();
+}
+
+FString FReadFileTool::GetCompactGraph(UEdGraph* Graph, const FString& GraphType, const FString& AssetPath, int32 Offset, int32 Limit)
+{
+	const int32 Total = Graph->Nodes.Num();
+	const int32 StartIdx = Offset - 1;
+	const int32 EndIdx = FMath::Min(StartIdx + Limit, Total);
+	const FString GraphName = Graph->GetName();
+
+	// Every node gets an alias, not just the page, since connections reach outside it.
+	// edit_graph resolves "@N" through the session registry like any other node name.
+	TMap<const UEdGraphNode*, int32> Aliases;
+	Aliases.Reserve(Total);
+	FNodeNameRegistry& Registry = FNodeNameRegistry::Get();
+	for (int32 i = 0; i < Total; i++)
+	{
+		if (const UEdGraphNode* Node = Graph->Nodes[i])
+		{
+			Aliases.Add(Node, i + 1);
+			Registry.Register(AssetPath, GraphName, FString::Printf(TEXT("@%d"), i + 1), Node->NodeGuid);
+		}
+	}
+
+	// Pin names are interned in first-use order and written once in the PINS table
+	TMap<FName, int32> PinIds;
+	TArray<FName> PinNames;
+	auto InternPin = [&PinIds, &PinNames](FName PinName) -> int32
+	{
+		if (const int32* Existing = PinIds.Find(PinName))
+		{
+			return *Existing;
+		}
+		const int32 Id = PinNames.Add(PinName);
+		PinIds.Add(PinName, Id);
+		return Id;
+	};
+
+	FString NodeLines;
+	NodeLines.Reserve(FMath::Max(0, EndIdx - StartIdx) * 48);
+	for (int32 i = StartIdx; i < EndIdx; i++)
+	{
+		UEdGraphNode* Node = Graph->Nodes[i];
+		if (!Node) continue;
+
+		NodeLines.Appendf(TEXT("@%d\t%s\t"), i + 1, *Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+		bool bFirstPin = true;
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->bHidden) continue;
+			if (!bFirstPin) NodeLines.AppendChar(TEXT(','));
+			NodeLines.AppendInt(InternPin(Pin->PinName));
+			bFirstPin = false;
+		}
+		NodeLines.AppendChar(TEXT('\n'));
+	}
+
+	FString LinkLines;
+	LinkLines.Reserve(Total * 24);
+	int32 LinkCount = 0;
+	for (int32 i = 0; i < Total; i++)
+	{
+		UEdGraphNode* Node = Graph->Nodes[i];
+		if (!Node) continue;
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->Direction != EGPD_Output) continue;
+
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				const int32* ToAlias = LinkedPin ? Aliases.Find(LinkedPin->GetOwningNode()) : nullptr;
+				if (!ToAlias) continue;
+
+				LinkLines.Appendf(TEXT("@%d\t%d\t@%d\t%d\n"), i + 1, InternPin(Pin->PinName), *ToAlias, InternPin(LinkedPin->PinName));
+				LinkCount++;
 			}
 		}
 	}
 
-	FString Output = FString::Printf(TEXT("# CONNECTIONS %s %d\n"), *Graph->GetName(), Connections.Num());
-	for (const FString& Conn : Connections)
+	NeoStackToolUtils::FToolOutputWriter Output(128 + NodeLines.Len() + PinNames.Num() * 24 + LinkLines.Len());
+	Output.Appendf(TEXT("# GRAPH %s type=%s %d compact version=%s\n"), *GraphName, *GraphType, Total, *FGraphSnapshotStore::Get().Capture(Graph));
+	Output.Append(NodeLines);
+	Output.Appendf(TEXT("\n# PINS %d\n"), PinNames.Num());
+	for (int32 Id = 0; Id < PinNames.Num(); Id++)
 	{
-		Output += Conn + TEXT("\n");
+		Output.AppendInt(Id);
+		Output.AppendChar(TEXT('\t'));
+		Output.Append(PinNames[Id].ToString());
+		Output.AppendChar(TEXT('\n'));
 	}
+	Output.Appendf(TEXT("\n# CONNECTIONS %s %d\n"), *GraphName, LinkCount);
+	Output.Append(LinkLines);
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FReadFileTool::GetNodePins(UEdGraphNode* Node)
@@ -727,104 +1021,140 @@ FString FReadFileTool::GetWidgetBlueprintSummary(UWidgetBlueprint* WidgetBluepri
 	int32 GraphCount = WidgetBlueprint->UbergraphPages.Num() + WidgetBlueprint->FunctionGraphs.Num();
 	int32 AnimCount = WidgetBlueprint->Animations.Num();
 
-	FString Output = FString::Printf(TEXT("# WIDGET_BLUEPRINT %s parent=%s\nwidgets=%d variables=%d graphs=%d animations=%d\n"),
+	NeoStackToolUtils::FToolOutputWriter Output(256 + GraphCount * 48);
+	Output.Appendf(TEXT("# WIDGET_BLUEPRINT %s parent=%s\nwidgets=%d variables=%d graphs=%d animations=%d\n"),
 		*WidgetBlueprint->GetName(), *ParentName, WidgetCount, VarCount, GraphCount, AnimCount);
 
 	// Add graph list
 	if (GraphCount > 0)
 	{
-		Output += FString::Printf(TEXT("\n# GRAPHS %d\n"), GraphCount);
+		Output.Appendf(TEXT("\n# GRAPHS %d\n"), GraphCount);
 
 		for (UEdGraph* Graph : WidgetBlueprint->UbergraphPages)
 		{
-			Output += FString::Printf(TEXT("%s\tubergraph\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
+			Output.Appendf(TEXT("%s\tubergraph\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
 		}
 		for (UEdGraph* Graph : WidgetBlueprint->FunctionGraphs)
 		{
-			Output += FString::Printf(TEXT("%s\tfunction\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
+			Output.Appendf(TEXT("%s\tfunction\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
 		}
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
-FString FReadFileTool::GetWidgetTree(UWidgetBlueprint* WidgetBlueprint)
+FString FReadFileTool::GetWidgetTree(UWidgetBlueprint* WidgetBlueprint, const FTreeQuery& Query, int32 Offset, int32 Limit, FString& OutError)
 {
 	if (!WidgetBlueprint->WidgetTree)
 	{
 		return TEXT("# WIDGET_TREE 0\n(no widget tree)\n");
 	}
 
-	TArray<UWidget*> AllWidgets;
-	WidgetBlueprint->WidgetTree->GetAllWidgets(AllWidgets);
+	UWidget* StartWidget = WidgetBlueprint->WidgetTree->RootWidget;
+	if (!Query.Root.IsEmpty())
+	{
+		StartWidget = WidgetBlueprint->WidgetTree->FindWidget(FName(*Query.Root));
+		if (!StartWidget)
+		{
+			OutError = FString::Printf(TEXT("Widget not found: %s"), *Query.Root);
+			return FString();
+		}
+	}
+	if (!StartWidget)
+	{
+		return TEXT("# WIDGET_TREE 0\n(no root widget)\n");
+	}
+
+	// Collecting is cheap; only the requested page is formatted
+	TArray<FWidgetListEntry> Entries;
+	CollectWidgetEntries(StartWidget, 0, Query.MaxDepth, Entries);
 
-	FString Output = FString::Printf(TEXT("# WIDGET_TREE %d\n"), AllWidgets.Num());
+	const int32 Total = Entries.Num();
+	const int32 StartIdx = FMath::Min(Offset - 1, Total);
+	const int32 EndIdx = FMath::Min(StartIdx + Limit, Total);
 
-	// Get root widget
-	UWidget* RootWidget = WidgetBlueprint->WidgetTree->RootWidget;
-	if (RootWidget)
+	NeoStackToolUtils::FToolOutputWriter Output(64 + (EndIdx - StartIdx) * 96);
+	Output.Appendf(TEXT("# WIDGET_TREE %d"), Total);
+	if (!Query.Root.IsEmpty())
 	{
-		Output += GetWidgetHierarchy(RootWidget, 0);
+		Output.Appendf(TEXT(" root=%s"), *StartWidget->GetName());
 	}
-	else
+	if (Query.MaxDepth != INDEX_NONE)
+	{
+		Output.Appendf(TEXT(" depth=%d"), Query.MaxDepth);
+	}
+	Output.Newline();
+
+	for (int32 i = StartIdx; i < EndIdx; i++)
+	{
+		AppendWidgetLine(Output, Entries[i]);
+	}
+
+	if (EndIdx < Total)
 	{
-		Output += TEXT("(no root widget)\n");
+		Output.Appendf(TEXT("# MORE offset=%d remaining=%d\n"), EndIdx + 1, Total - EndIdx);
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
-FString FReadFileTool::GetWidgetHierarchy(UWidget* Widget, int32 Depth)
+void FReadFileTool::CollectWidgetEntries(UWidget* Widget, int32 Depth, int32 MaxDepth, TArray<FWidgetListEntry>& OutEntries)
 {
 	if (!Widget)
 	{
-		return TEXT("");
+		return;
 	}
 
-	FString Indent;
-	for (int32 i = 0; i < Depth; i++)
+	FWidgetListEntry& Entry = OutEntries.AddDefaulted_GetRef();
+	Entry.Widget = Widget;
+	Entry.Depth = Depth;
+
+	UPanelWidget* PanelWidget = Cast<UPanelWidget>(Widget);
+	if (!PanelWidget)
 	{
-		Indent += TEXT("  ");
+		return;
 	}
 
-	// Get widget info
-	FString WidgetName = Widget->GetName();
-	FString WidgetClass = Widget->GetClass()->GetName();
-	FString WidgetVisibility = Widget->IsVisible() ? TEXT("visible") : TEXT("hidden");
+	if (MaxDepth != INDEX_NONE && Depth >= MaxDepth)
+	{
+		Entry.HiddenChildren = PanelWidget->GetChildrenCount();
+		return;
+	}
 
-	// Get slot info if widget has a slot (layout properties)
-	FString SlotInfo;
-	if (UPanelSlot* Slot = Widget->Slot)
+	for (int32 i = 0; i < PanelWidget->GetChildrenCount(); i++)
 	{
-		if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Slot))
-		{
-			FAnchors Anchors = CanvasSlot->GetAnchors();
-			FVector2D Position = CanvasSlot->GetPosition();
-			FVector2D Size = CanvasSlot->GetSize();
-			SlotInfo = FString::Printf(TEXT(" pos=(%.0f,%.0f) size=(%.0f,%.0f) anchors=(%.1f,%.1f)-(%.1f,%.1f)"),
-				Position.X, Position.Y, Size.X, Size.Y,
-				Anchors.Minimum.X, Anchors.Minimum.Y, Anchors.Maximum.X, Anchors.Maximum.Y);
-		}
+		CollectWidgetEntries(PanelWidget->GetChildAt(i), Depth + 1, MaxDepth, OutEntries);
 	}
+}
 
-	FString Output = FString::Printf(TEXT("%s%s (%s) %s%s\n"),
-		*Indent, *WidgetName, *WidgetClass, *WidgetVisibility, *SlotInfo);
+void FReadFileTool::AppendWidgetLine(NeoStackToolUtils::FToolOutputWriter& Output, const FWidgetListEntry& Entry)
+{
+	UWidget* Widget = Entry.Widget;
 
-	// If this is a panel widget, recursively add children
-	if (UPanelWidget* PanelWidget = Cast<UPanelWidget>(Widget))
+	for (int32 i = 0; i < Entry.Depth; i++)
 	{
-		int32 ChildCount = PanelWidget->GetChildrenCount();
-		for (int32 i = 0; i < ChildCount; i++)
-		{
-			UWidget* ChildWidget = PanelWidget->GetChildAt(i);
-			if (ChildWidget)
-			{
-				Output += GetWidgetHierarchy(ChildWidget, Depth + 1);
-			}
-		}
+		Output.Append(TEXT("  "));
+	}
+
+	Output.Appendf(TEXT("%s (%s) %s"),
+		*Widget->GetName(), *Widget->GetClass()->GetName(), Widget->IsVisible() ? TEXT("visible") : TEXT("hidden"));
+
+	// Layout properties of canvas slots
+	if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Widget->Slot))
+	{
+		const FAnchors Anchors = CanvasSlot->GetAnchors();
+		const FVector2D Position = CanvasSlot->GetPosition();
+		const FVector2D Size = CanvasSlot->GetSize();
+		Output.Appendf(TEXT(" pos=(%.0f,%.0f) size=(%.0f,%.0f) anchors=(%.1f,%.1f)-(%.1f,%.1f)"),
+			Position.X, Position.Y, Size.X, Size.Y,
+			Anchors.Minimum.X, Anchors.Minimum.Y, Anchors.Maximum.X, Anchors.Maximum.Y);
 	}
 
-	return Output;
+	if (Entry.HiddenChildren > 0)
+	{
+		Output.Appendf(TEXT(" [+%d children]"), Entry.HiddenChildren);
+	}
+	Output.Newline();
 }
 
 // Animation Blueprint Support
@@ -859,27 +1189,28 @@ FString FReadFileTool::GetAnimBlueprintSummary(UAnimBlueprint* AnimBlueprint)
 		}
 	}
 
-	FString Output = FString::Printf(TEXT("# ANIM_BLUEPRINT %s parent=%s skeleton=%s\nvariables=%d graphs=%d state_machines=%d\n"),
+	NeoStackToolUtils::FToolOutputWriter Output(256 + GraphCount * 48);
+	Output.Appendf(TEXT("# ANIM_BLUEPRINT %s parent=%s skeleton=%s\nvariables=%d graphs=%d state_machines=%d\n"),
 		*AnimBlueprint->GetName(), *ParentName, *SkeletonName, VarCount, GraphCount, StateMachineCount);
 
 	// Add graph list
-	Output += FString::Printf(TEXT("\n# GRAPHS %d\n"), GraphCount);
+	Output.Appendf(TEXT("\n# GRAPHS %d\n"), GraphCount);
 
 	for (UEdGraph* Graph : AnimBlueprint->UbergraphPages)
 	{
-		Output += FString::Printf(TEXT("%s\tubergraph\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
+		Output.Appendf(TEXT("%s\tubergraph\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
 	}
 	for (UEdGraph* Graph : AnimBlueprint->FunctionGraphs)
 	{
-		Output += FString::Printf(TEXT("%s\tfunction\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
+		Output.Appendf(TEXT("%s\tfunction\t%d\n"), *Graph->GetName(), Graph->Nodes.Num());
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FReadFileTool::GetAnimBlueprintStateMachines(UAnimBlueprint* AnimBlueprint)
 {
-	FString Output;
+	NeoStackToolUtils::FToolOutputWriter Output(1024);
 
 	// Find AnimGraph
 	UEdGraph* AnimGraph = nullptr;
@@ -907,7 +1238,7 @@ FString FReadFileTool::GetAnimBlueprintStateMachines(UAnimBlueprint* AnimBluepri
 		}
 	}
 
-	Output = FString::Printf(TEXT("# STATE_MACHINES %d\n"), StateMachines.Num());
+	Output.Appendf(TEXT("# STATE_MACHINES %d\n"), StateMachines.Num());
 
 	// Output each state machine
 	for (UAnimGraphNode_StateMachine* SMNode : StateMachines)
@@ -919,7 +1250,7 @@ FString FReadFileTool::GetAnimBlueprintStateMachines(UAnimBlueprint* AnimBluepri
 		UAnimationStateMachineGraph* SMGraph = Cast<UAnimationStateMachineGraph>(SMNode->EditorStateMachineGraph);
 		if (!SMGraph)
 		{
-			Output += FString::Printf(TEXT("\n## STATE_MACHINE %s guid=%s\n(no graph)\n"), *SMName, *SMGuid);
+			Output.Appendf(TEXT("\n## STATE_MACHINE %s guid=%s\n(no graph)\n"), *SMName, *SMGuid);
 			continue;
 		}
 
@@ -938,11 +1269,11 @@ FString FReadFileTool::GetAnimBlueprintStateMachines(UAnimBlueprint* AnimBluepri
 			}
 		}
 
-		Output += FString::Printf(TEXT("\n## STATE_MACHINE %s guid=%s states=%d transitions=%d\n"),
+		Output.Appendf(TEXT("\n## STATE_MACHINE %s guid=%s states=%d transitions=%d\n"),
 			*SMName, *SMGuid, StateCount, TransitionCount);
 
 		// List states
-		Output += TEXT("# STATES\n");
+		Output.Append(TEXT("# STATES\n"));
 		for (UEdGraphNode* GraphNode : SMGraph->Nodes)
 		{
 			if (UAnimStateNode* StateNode = Cast<UAnimStateNode>(GraphNode))
@@ -953,17 +1284,17 @@ FString FReadFileTool::GetAnimBlueprintStateMachines(UAnimBlueprint* AnimBluepri
 				// Check if this state has a bound graph (the state's animation logic)
 				FString HasGraph = StateNode->BoundGraph ? TEXT("has_graph") : TEXT("no_graph");
 
-				Output += FString::Printf(TEXT("%s\t%s\t%s\n"), *StateGuid, *StateName, *HasGraph);
+				Output.Appendf(TEXT("%s\t%s\t%s\n"), *StateGuid, *StateName, *HasGraph);
 			}
 			else if (UAnimStateEntryNode* EntryNode = Cast<UAnimStateEntryNode>(GraphNode))
 			{
 				FString EntryGuid = NeoStackToolUtils::GetNodeGuid(EntryNode);
-				Output += FString::Printf(TEXT("%s\t[Entry]\tentry_point\n"), *EntryGuid);
+				Output.Appendf(TEXT("%s\t[Entry]\tentry_point\n"), *EntryGuid);
 			}
 		}
 
 		// List transitions
-		Output += TEXT("# TRANSITIONS\n");
+		Output.Append(TEXT("# TRANSITIONS\n"));
 		for (UEdGraphNode* GraphNode : SMGraph->Nodes)
 		{
 			if (UAnimStateTransitionNode* TransNode = Cast<UAnimStateTransitionNode>(GraphNode))
@@ -990,13 +1321,13 @@ FString FReadFileTool::GetAnimBlueprintStateMachines(UAnimBlueprint* AnimBluepri
 					HasConditionGraph = FString::Printf(TEXT("condition_graph=%s"), *TransGraph->GetName());
 				}
 
-				Output += FString::Printf(TEXT("%s\t%s -> %s\t%s\n"),
+				Output.Appendf(TEXT("%s\t%s -> %s\t%s\n"),
 					*TransGuid, *FromState, *ToState, *HasConditionGraph);
 			}
 		}
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 void FReadFileTool::CollectAnimBlueprintGraphs(UAnimBlueprint* AnimBlueprint, TArray<TPair<UEdGraph*, FString>>& OutGraphs)
@@ -1092,12 +1423,13 @@ FString FReadFileTool::GetBehaviorTreeSummary(UBehaviorTree* BehaviorTree)
 		CountBTNodes(BehaviorTree->RootNode, TaskCount, CompositeCount, DecoratorCount, ServiceCount);
 	}
 
-	FString Output = FString::Printf(TEXT("# BEHAVIOR_TREE %s blackboard=%s\n"),
+	NeoStackToolUtils::FToolOutputWriter Output(256);
+	Output.Appendf(TEXT("# BEHAVIOR_TREE %s blackboard=%s\n"),
 		*BehaviorTree->GetName(), *BlackboardName);
-	Output += FString::Printf(TEXT("composites=%d tasks=%d decorators=%d services=%d\n"),
+	Output.Appendf(TEXT("composites=%d tasks=%d decorators=%d services=%d\n"),
 		CompositeCount, TaskCount, DecoratorCount, ServiceCount);
 
-	return Output;
+	return Output.ToString();
 }
 
 void FReadFileTool::CountBTNodes(UBTCompositeNode* Node, int32& OutTasks, int32& OutComposites, int32& OutDecorators, int32& OutServices)
@@ -1134,98 +1466,206 @@ void FReadFileTool::CountBTNodes(UBTCompositeNode* Node, int32& OutTasks, int32&
 	}
 }
 
-FString FReadFileTool::GetBehaviorTreeNodes(UBehaviorTree* BehaviorTree)
+FString FReadFileTool::GetBehaviorTreeNodes(UBehaviorTree* BehaviorTree, const FTreeQuery& Query, int32 Offset, int32 Limit, FString& OutError)
 {
 	if (!BehaviorTree->RootNode)
 	{
 		return TEXT("# NODES 0\n(no root node)\n");
 	}
 
-	FString Output = TEXT("# NODES\n");
-	Output += GetBTNodeHierarchy(BehaviorTree->RootNode, 0);
+	FBTListEntry Start;
+	if (!FindBTNodeByPath(BehaviorTree, Query.Root, Start, OutError))
+	{
+		return FString();
+	}
+
+	// Collecting is cheap; only the requested page is formatted
+	TArray<FBTListEntry> Entries;
+	CollectBTEntries(Start, Query.MaxDepth, Entries);
+
+	const int32 Total = Entries.Num();
+	const int32 StartIdx = FMath::Min(Offset - 1, Total);
+	const int32 EndIdx = FMath::Min(StartIdx + Limit, Total);
+
+	NeoStackToolUtils::FToolOutputWriter Output(64 + (EndIdx - StartIdx) * 96);
+	Output.Appendf(TEXT("# NODES %d"), Total);
+	if (!Query.Root.IsEmpty())
+	{
+		Output.Appendf(TEXT(" root=%s"), *Start.Path);
+	}
+	if (Query.MaxDepth != INDEX_NONE)
+	{
+		Output.Appendf(TEXT(" depth=%d"), Query.MaxDepth);
+	}
+	Output.Newline();
+
+	for (int32 i = StartIdx; i < EndIdx; i++)
+	{
+		AppendBTNodeLines(Output, Entries[i]);
+	}
 
-	return Output;
+	if (EndIdx < Total)
+	{
+		Output.Appendf(TEXT("# MORE offset=%d remaining=%d\n"), EndIdx + 1, Total - EndIdx);
+	}
+
+	return Output.ToString();
 }
 
-FString FReadFileTool::GetBTNodeHierarchy(UBTCompositeNode* Node, int32 Depth)
+bool FReadFileTool::FindBTNodeByPath(UBehaviorTree* BehaviorTree, const FString& Path, FBTListEntry& OutEntry, FString& OutError)
 {
-	if (!Node)
+	OutEntry = FBTListEntry();
+	OutEntry.Composite = BehaviorTree->RootNode;
+	OutEntry.Path = TEXT("/");
+
+	TArray<FString> Segments;
+	Path.ParseIntoArray(Segments, TEXT("/"));
+
+	for (const FString& Segment : Segments)
 	{
-		return TEXT("");
+		if (!OutEntry.Composite)
+		{
+			OutError = FString::Printf(TEXT("Behavior tree node path %s: %s is a task and has no children"), *Path, *OutEntry.Path);
+			return false;
+		}
+
+		UBTCompositeNode* Parent = OutEntry.Composite;
+		int32 ChildIdx = INDEX_NONE;
+		if (Segment.IsNumeric())
+		{
+			ChildIdx = FCString::Atoi(*Segment);
+			if (!Parent->Children.IsValidIndex(ChildIdx))
+			{
+				ChildIdx = INDEX_NONE;
+			}
+		}
+		else
+		{
+			for (int32 i = 0; i < Parent->Children.Num(); i++)
+			{
+				const FBTCompositeChild& Child = Parent->Children[i];
+				const UBTNode* ChildNode = Child.ChildComposite ? static_cast<const UBTNode*>(Child.ChildComposite) : Child.ChildTask;
+				if (ChildNode && ChildNode->GetNodeName().Equals(Segment, ESearchCase::IgnoreCase))
+				{
+					ChildIdx = i;
+					break;
+				}
+			}
+		}
+
+		if (ChildIdx == INDEX_NONE)
+		{
+			OutError = FString::Printf(TEXT("Behavior tree node path %s: no child '%s' under %s (%d children)"),
+				*Path, *Segment, *OutEntry.Path, Parent->Children.Num());
+			return false;
+		}
+
+		const FBTCompositeChild& Child = Parent->Children[ChildIdx];
+		OutEntry.Composite = Child.ChildComposite;
+		OutEntry.Task = Child.ChildTask;
+		OutEntry.Link = &Child;
+		OutEntry.Path = OutEntry.Path.Len() > 1
+			? FString::Printf(TEXT("%s/%d"), *OutEntry.Path, ChildIdx)
+			: FString::Printf(TEXT("/%d"), ChildIdx);
 	}
 
-	FString Indent;
-	for (int32 i = 0; i < Depth; i++)
+	return true;
+}
+
+void FReadFileTool::CollectBTEntries(const FBTListEntry& Entry, int32 MaxDepth, TArray<FBTListEntry>& OutEntries)
+{
+	const int32 EntryIdx = OutEntries.Add(Entry);
+
+	UBTCompositeNode* Composite = Entry.Composite;
+	if (!Composite)
 	{
-		Indent += TEXT("  ");
+		return;
 	}
 
-	// Get node class name (remove UBT prefix for readability)
-	FString NodeClass = Node->GetClass()->GetName();
-	NodeClass.RemoveFromStart(TEXT("BT"));
-	NodeClass.RemoveFromStart(TEXT("Composite_"));
-
-	FString Output = FString::Printf(TEXT("%s[%s] %s\n"),
-		*Indent, *NodeClass, *Node->GetNodeName());
+	if (MaxDepth != INDEX_NONE && Entry.Depth >= MaxDepth)
+	{
+		OutEntries[EntryIdx].HiddenChildren = Composite->GetChildrenNum();
+		return;
+	}
 
-	// List services on this composite
-	for (UBTService* Service : Node->Services)
+	for (int32 i = 0; i < Composite->GetChildrenNum(); i++)
 	{
-		if (Service)
+		const FBTCompositeChild& Child = Composite->Children[i];
+		if (!Child.ChildComposite && !Child.ChildTask)
 		{
-			FString SvcClass = Service->GetClass()->GetName();
-			SvcClass.RemoveFromStart(TEXT("BTService_"));
-			Output += FString::Printf(TEXT("%s  $%s %s\n"),
-				*Indent, *SvcClass, *Service->GetNodeName());
+			continue;
 		}
+
+		FBTListEntry ChildEntry;
+		ChildEntry.Composite = Child.ChildComposite;
+		ChildEntry.Task = Child.ChildTask;
+		ChildEntry.Link = &Child;
+		ChildEntry.Depth = Entry.Depth + 1;
+		ChildEntry.Path = Entry.Path.Len() > 1
+			? FString::Printf(TEXT("%s/%d"), *Entry.Path, i)
+			: FString::Printf(TEXT("/%d"), i);
+		CollectBTEntries(ChildEntry, MaxDepth, OutEntries);
 	}
+}
 
-	// Process children
-	for (int32 i = 0; i < Node->GetChildrenNum(); i++)
+void FReadFileTool::AppendBTNodeLines(NeoStackToolUtils::FToolOutputWriter& Output, const FBTListEntry& Entry)
+{
+	FString Indent;
+	for (int32 i = 0; i < Entry.Depth; i++)
 	{
-		FBTCompositeChild& Child = Node->Children[i];
+		Indent += TEXT("  ");
+	}
 
-		// List decorators on the child link
-		for (UBTDecorator* Decorator : Child.Decorators)
+	// Decorators sit on the link from the parent
+	if (Entry.Link)
+	{
+		for (UBTDecorator* Decorator : Entry.Link->Decorators)
 		{
 			if (Decorator)
 			{
 				FString DecClass = Decorator->GetClass()->GetName();
 				DecClass.RemoveFromStart(TEXT("BTDecorator_"));
-				Output += FString::Printf(TEXT("%s  @%s %s\n"),
-					*Indent, *DecClass, *Decorator->GetNodeName());
+				Output.Appendf(TEXT("%s@%s %s\n"), *Indent, *DecClass, *Decorator->GetNodeName());
 			}
 		}
+	}
 
-		if (Child.ChildComposite)
+	auto AppendServices = [&Output, &Indent](const auto& Services)
+	{
+		for (UBTService* Service : Services)
 		{
-			// Recurse into composite child
-			Output += GetBTNodeHierarchy(Child.ChildComposite, Depth + 1);
+			if (Service)
+			{
+				FString SvcClass = Service->GetClass()->GetName();
+				SvcClass.RemoveFromStart(TEXT("BTService_"));
+				Output.Appendf(TEXT("%s  $%s %s\n"), *Indent, *SvcClass, *Service->GetNodeName());
+			}
 		}
-		else if (Child.ChildTask)
-		{
-			// Output task node
-			FString TaskClass = Child.ChildTask->GetClass()->GetName();
-			TaskClass.RemoveFromStart(TEXT("BTTask_"));
+	};
 
-			Output += FString::Printf(TEXT("%s  <%s> %s\n"),
-				*Indent, *TaskClass, *Child.ChildTask->GetNodeName());
+	if (UBTCompositeNode* Composite = Entry.Composite)
+	{
+		// Get node class name (remove UBT prefix for readability)
+		FString NodeClass = Composite->GetClass()->GetName();
+		NodeClass.RemoveFromStart(TEXT("BT"));
+		NodeClass.RemoveFromStart(TEXT("Composite_"));
 
-			// List services on the task
-			for (UBTService* Service : Child.ChildTask->Services)
-			{
-				if (Service)
-				{
-					FString SvcClass = Service->GetClass()->GetName();
-					SvcClass.RemoveFromStart(TEXT("BTService_"));
-					Output += FString::Printf(TEXT("%s    $%s %s\n"),
-						*Indent, *SvcClass, *Service->GetNodeName());
-				}
-			}
+		// Composites carry their path so a later read can start from them
+		Output.Appendf(TEXT("%s[%s] %s %s"), *Indent, *NodeClass, *Composite->GetNodeName(), *Entry.Path);
+		if (Entry.HiddenChildren > 0)
+		{
+			Output.Appendf(TEXT(" [+%d children]"), Entry.HiddenChildren);
 		}
+		Output.Newline();
+		AppendServices(Composite->Services);
+	}
+	else if (UBTTaskNode* Task = Entry.Task)
+	{
+		FString TaskClass = Task->GetClass()->GetName();
+		TaskClass.RemoveFromStart(TEXT("BTTask_"));
+		Output.Appendf(TEXT("%s<%s> %s\n"), *Indent, *TaskClass, *Task->GetNodeName());
+		AppendServices(Task->Services);
 	}
-
-	return Output;
 }
 
 // Blackboard Support
@@ -1241,10 +1681,11 @@ FString FReadFileTool::GetBlackboardSummary(UBlackboardData* Blackboard)
 		ParentName = Blackboard->Parent->GetName();
 	}
 
-	FString Output = FString::Printf(TEXT("# BLACKBOARD %s parent=%s keys=%d\n"),
+	NeoStackToolUtils::FToolOutputWriter Output(256);
+	Output.Appendf(TEXT("# BLACKBOARD %s parent=%s keys=%d\n"),
 		*Blackboard->GetName(), *ParentName, KeyCount);
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FReadFileTool::GetBlackboardKeys(UBlackboardData* Blackboard)
@@ -1254,7 +1695,8 @@ FString FReadFileTool::GetBlackboardKeys(UBlackboardData* Blackboard)
 		return TEXT("# KEYS 0\n");
 	}
 
-	FString Output = FString::Printf(TEXT("# KEYS %d\n"), Blackboard->Keys.Num());
+	NeoStackToolUtils::FToolOutputWriter Output(64 + Blackboard->Keys.Num() * 80);
+	Output.Appendf(TEXT("# KEYS %d\n"), Blackboard->Keys.Num());
 
 	for (const FBlackboardEntry& Entry : Blackboard->Keys)
 	{
@@ -1278,18 +1720,18 @@ FString FReadFileTool::GetBlackboardKeys(UBlackboardData* Blackboard)
 
 		if (KeyCategory.IsEmpty())
 		{
-			Output += FString::Printf(TEXT("%s\t%s\t%s\n"), *KeyName, *KeyType, *Flags);
+			Output.Appendf(TEXT("%s\t%s\t%s\n"), *KeyName, *KeyType, *Flags);
 		}
 		else
 		{
-			Output += FString::Printf(TEXT("%s\t%s\t%s\t%s\n"), *KeyName, *KeyType, *KeyCategory, *Flags);
+			Output.Appendf(TEXT("%s\t%s\t%s\t%s\n"), *KeyName, *KeyType, *KeyCategory, *Flags);
 		}
 	}
 
 	// Also include parent keys if any
 	if (Blackboard->Parent)
 	{
-		Output += FString::Printf(TEXT("\n# PARENT_KEYS (%s) %d\n"),
+		Output.Appendf(TEXT("\n# PARENT_KEYS (%s) %d\n"),
 			*Blackboard->Parent->GetName(), Blackboard->Parent->Keys.Num());
 
 		for (const FBlackboardEntry& Entry : Blackboard->Parent->Keys)
@@ -1303,11 +1745,11 @@ FString FReadFileTool::GetBlackboardKeys(UBlackboardData* Blackboard)
 				KeyType.RemoveFromStart(TEXT("BlackboardKeyType_"));
 			}
 
-			Output += FString::Printf(TEXT("%s\t%s\t(inherited)\n"), *KeyName, *KeyType);
+			Output.Appendf(TEXT("%s\t%s\t(inherited)\n"), *KeyName, *KeyType);
 		}
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 // User Defined Struct Support
@@ -1317,14 +1759,15 @@ FString FReadFileTool::GetStructSummary(UUserDefinedStruct* Struct)
 	TArray<FStructVariableDescription>& VarDescArray = FStructureEditorUtils::GetVarDesc(Struct);
 	int32 FieldCount = VarDescArray.Num();
 
-	FString Output = FString::Printf(TEXT("# STRUCT %s fields=%d\n"),
+	NeoStackToolUtils::FToolOutputWriter Output(128);
+	Output.Appendf(TEXT("# STRUCT %s fields=%d\n"),
 		*Struct->GetName(), FieldCount);
 
 	// Get struct size if available
 	int32 StructSize = Struct->GetStructureSize();
-	Output += FString::Printf(TEXT("size=%d bytes\n"), StructSize);
+	Output.Appendf(TEXT("size=%d bytes\n"), StructSize);
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FReadFileTool::GetStructFields(UUserDefinedStruct* Struct)
@@ -1336,7 +1779,8 @@ FString FReadFileTool::GetStructFields(UUserDefinedStruct* Struct)
 		return TEXT("# FIELDS 0\n");
 	}
 
-	FString Output = FString::Printf(TEXT("# FIELDS %d\n"), VarDescArray.Num());
+	NeoStackToolUtils::FToolOutputWriter Output(64 + VarDescArray.Num() * 128);
+	Output.Appendf(TEXT("# FIELDS %d\n"), VarDescArray.Num());
 
 	for (const FStructVariableDescription& VarDesc : VarDescArray)
 	{
@@ -1364,15 +1808,15 @@ FString FReadFileTool::GetStructFields(UUserDefinedStruct* Struct)
 		// Format: name	type	default	[description]
 		if (Description.IsEmpty())
 		{
-			Output += FString::Printf(TEXT("%s\t%s\t%s\n"), *FieldName, *TypeName, *DefaultValue);
+			Output.Appendf(TEXT("%s\t%s\t%s\n"), *FieldName, *TypeName, *DefaultValue);
 		}
 		else
 		{
-			Output += FString::Printf(TEXT("%s\t%s\t%s\t%s\n"), *FieldName, *TypeName, *DefaultValue, *Description);
+			Output.Appendf(TEXT("%s\t%s\t%s\t%s\n"), *FieldName, *TypeName, *DefaultValue, *Description);
 		}
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 // User Defined Enum Support
@@ -1381,10 +1825,11 @@ FString FReadFileTool::GetEnumSummary(UUserDefinedEnum* Enum)
 {
 	int32 ValueCount = Enum->NumEnums() - 1; // Exclude MAX value
 
-	FString Output = FString::Printf(TEXT("# ENUM %s values=%d\n"),
+	NeoStackToolUtils::FToolOutputWriter Output(128);
+	Output.Appendf(TEXT("# ENUM %s values=%d\n"),
 		*Enum->GetName(), ValueCount);
 
-	return Output;
+	return Output.ToString();
 }
 
 FString FReadFileTool::GetEnumValues(UUserDefinedEnum* Enum)
@@ -1396,7 +1841,8 @@ FString FReadFileTool::GetEnumValues(UUserDefinedEnum* Enum)
 		return TEXT("# VALUES 0\n");
 	}
 
-	FString Output = FString::Printf(TEXT("# VALUES %d\n"), ValueCount);
+	NeoStackToolUtils::FToolOutputWriter Output(64 + ValueCount * 64);
+	Output.Appendf(TEXT("# VALUES %d\n"), ValueCount);
 
 	for (int32 i = 0; i < ValueCount; i++)
 	{
@@ -1408,10 +1854,10 @@ FString FReadFileTool::GetEnumValues(UUserDefinedEnum* Enum)
 		FString DisplayName = DisplayNameText.ToString();
 
 		// Format: index	name	display_name
-		Output += FString::Printf(TEXT("%d\t%s\t%s\n"), i, *ValueName, *DisplayName);
+		Output.Appendf(TEXT("%d\t%s\t%s\n"), i, *ValueName, *DisplayName);
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
 // DataTable Support
@@ -1428,89 +1874,149 @@ FString FReadFileTool::GetDataTableSummary(UDataTable* DataTable)
 	TArray<FName> RowNames = DataTable->GetRowNames();
 	int32 RowCount = RowNames.Num();
 
-	FString Output = FString::Printf(TEXT("# DATATABLE %s row_struct=%s rows=%d\n"),
+	NeoStackToolUtils::FToolOutputWriter Output(256);
+	Output.Appendf(TEXT("# DATATABLE %s row_struct=%s rows=%d\n"),
 		*DataTable->GetName(), *RowStructName, RowCount);
 
 	// List column names (struct properties)
 	if (DataTable->RowStruct)
 	{
-		Output += TEXT("\n# COLUMNS\n");
+		Output.Append(TEXT("\n# COLUMNS\n"));
 		for (TFieldIterator<FProperty> PropIt(DataTable->RowStruct); PropIt; ++PropIt)
 		{
 			FProperty* Property = *PropIt;
 			FString PropName = Property->GetName();
 			FString PropType = Property->GetCPPType();
 
-			Output += FString::Printf(TEXT("%s\t%s\n"), *PropName, *PropType);
+			Output.Appendf(TEXT("%s\t%s\n"), *PropName, *PropType);
 		}
 	}
 
-	return Output;
+	return Output.ToString();
 }
 
-FString FReadFileTool::GetDataTableRows(UDataTable* DataTable, int32 Offset, int32 Limit)
+FString FReadFileTool::GetDataTableRows(UDataTable* DataTable, int32 Offset, int32 Limit, const FDataTableQuery& Query, FString& OutError)
 {
-	TArray<FName> RowNames = DataTable->GetRowNames();
-	int32 TotalRows = RowNames.Num();
+	const TMap<FName, uint8*>& RowMap = DataTable->GetRowMap();
+	const int32 TotalRows = RowMap.Num();
 
 	if (TotalRows == 0)
 	{
 		return TEXT("# ROWS 0\n");
 	}
 
-	int32 StartIdx = Offset - 1; // Convert to 0-based
-	int32 EndIdx = FMath::Min(StartIdx + Limit, TotalRows);
+	// Columns and filters resolve against the row struct's cached layout once per read
+	const TSharedRef<const FDataTableColumnLayout> Layout = FDataTableColumnLayoutCache::Get().GetLayout(DataTable->RowStruct);
 
-	FString Output = FString::Printf(TEXT("# ROWS %d-%d/%d\n"), Offset, EndIdx, TotalRows);
+	TArray<int32> ColumnIndices;
+	for (const FString& ColumnName : Query.Columns)
+	{
+		const int32 ColumnIndex = Layout->Find(ColumnName.TrimStartAndEnd());
+		if (ColumnIndex == INDEX_NONE)
+		{
+			OutError = FString::Printf(TEXT("Unknown column '%s' (columns: %s)"), *ColumnName, *Layout->JoinNames());
+			return FString();
+		}
+		ColumnIndices.Add(ColumnIndex);
+	}
+	if (ColumnIndices.Num() == 0)
+	{
+		for (int32 i = 0; i < Layout->Columns.Num(); i++)
+		{
+			ColumnIndices.Add(i);
+		}
+	}
 
-	// Get column names for header
-	TArray<FString> ColumnNames;
-	if (DataTable->RowStruct)
+	TArray<FDataTableRowFilter> Filters;
+	for (const FString& Expression : Query.Where)
 	{
-		for (TFieldIterator<FProperty> PropIt(DataTable->RowStruct); PropIt; ++PropIt)
+		if (!FDataTableRowFilter::Parse(Expression, *Layout, Filters.AddDefaulted_GetRef(), OutError))
 		{
-			ColumnNames.Add((*PropIt)->GetName());
+			return FString();
 		}
 	}
 
-	// Output rows
-	for (int32 i = StartIdx; i < EndIdx; i++)
+	const int32 StartIdx = Offset - 1; // Convert to 0-based
+
+	// Rows are only exported once they pass every filter and fall inside the requested window
+	NeoStackToolUtils::FToolOutputWriter Rows(FMath::Min(Limit, TotalRows) * (32 + ColumnIndices.Num() * 16));
+	int32 MatchCount = 0;
+	int32 WrittenCount = 0;
+	FString ValueStr;
+	for (const TPair<FName, uint8*>& Row : RowMap)
 	{
-		FName RowName = RowNames[i];
-		uint8* RowData = DataTable->FindRowUnchecked(RowName);
+		const uint8* RowData = Row.Value;
+		if (RowData && Filters.Num() > 0)
+		{
+			bool bPass = true;
+			for (const FDataTableRowFilter& Filter : Filters)
+			{
+				if (!Filter.Matches(*Layout, RowData))
+				{
+					bPass = false;
+					break;
+				}
+			}
+			if (!bPass)
+			{
+				continue;
+			}
+		}
 
-		if (!RowData)
+		// Without filters the total is known, so stop at the end of the window; with them keep
+		// counting matches for the header
+		if (WrittenCount >= Limit && Filters.Num() == 0)
+		{
+			break;
+		}
+		const int32 MatchIdx = MatchCount++;
+		if (MatchIdx < StartIdx || WrittenCount >= Limit)
 		{
-			Output += FString::Printf(TEXT("%s\t(no data)\n"), *RowName.ToString());
 			continue;
 		}
+		WrittenCount++;
 
-		Output += RowName.ToString();
-
-		// Get property values
-		if (DataTable->RowStruct)
+		if (!RowData)
 		{
-			for (TFieldIterator<FProperty> PropIt(DataTable->RowStruct); PropIt; ++PropIt)
-			{
-				FProperty* Property = *PropIt;
+			Rows.Appendf(TEXT("%s\t(no data)\n"), *Row.Key.ToString());
+			continue;
+		}
 
-				// Export property value to string
-				FString ValueStr;
-				const void* PropertyValue = Property->ContainerPtrToValuePtr<void>(RowData);
-				Property->ExportTextItem_Direct(ValueStr, PropertyValue, nullptr, nullptr, PPF_None);
+		Rows.Append(Row.Key.ToString());
+		for (int32 ColumnIndex : ColumnIndices)
+		{
+			const FProperty* Property = Layout->Columns[ColumnIndex].Property;
 
-				// Truncate long values
-				if (ValueStr.Len() > 50)
-				{
-					ValueStr = ValueStr.Left(47) + TEXT("...");
-				}
+			// Export property value to string
+			ValueStr.Reset();
+			const void* PropertyValue = Property->ContainerPtrToValuePtr<void>(RowData);
+			Property->ExportTextItem_Direct(ValueStr, PropertyValue, nullptr, nullptr, PPF_None);
 
-				Output += FString::Printf(TEXT("\t%s"), *ValueStr);
+			// Truncate long values
+			if (ValueStr.Len() > 50)
+			{
+				ValueStr = ValueStr.Left(47) + TEXT("...");
 			}
+
+			Rows.Appendf(TEXT("\t%s"), *ValueStr);
 		}
+		Rows.Append(TEXT("\n"));
+	}
 
-		Output += TEXT("\n");
+	FString Header = Filters.Num() > 0
+		? FString::Printf(TEXT("# ROWS %d-%d/%d (of %d)\n"), Offset, StartIdx + WrittenCount, MatchCount, TotalRows)
+		: FString::Printf(TEXT("# ROWS %d-%d/%d\n"), Offset, StartIdx + WrittenCount, TotalRows);
+
+	// Header line naming the projected columns
+	if (Query.Columns.Num() > 0)
+	{
+		Header += TEXT("Name");
+		for (int32 ColumnIndex : ColumnIndices)
+		{
+			Header += TEXT("\t") + Layout->Columns[ColumnIndex].Name;
+		}
+		Header += TEXT("\n");
 	}
 
-	return Output;
+	return Header + Rows.ToString();
 }
@@ -0,0 +1,198 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/ReadLogTool.h"
+#include "Tools/NeoStackToolUtils.h"
+#include "NeoStackLogCapture.h"
+#include "Json.h"
+#include "Internationalization/Regex.h"
+#include "Logging/LogVerbosity.h"
+
+namespace
+{
+	/** Verbosity names read_log accepts, most severe first */
+	bool ParseMinVerbosity(const FString& Name, ELogVerbosity::Type& OutVerbosity)
+	{
+		if (Name.IsEmpty())
+		{
+			OutVerbosity = ELogVerbosity::Log;
+			return true;
+		}
+		if (Name.Equals(TEXT("all"), ESearchCase::IgnoreCase))
+		{
+			OutVerbosity = ELogVerbosity::VeryVerbose;
+			return true;
+		}
+
+		OutVerbosity = ParseLogVerbosityFromString(Name);
+		return OutVerbosity != ELogVerbosity::NoLogging || Name.Equals(TEXT("NoLogging"), ESearchCase::IgnoreCase);
+	}
+
+	/** Messages are single lines in the output; continuation lines are indented */
+	void AppendMessage(NeoStackToolUtils::FToolOutputWriter& Output, const FString& Message)
+	{
+		int32 Start = 0;
+		for (int32 Index = 0; Index < Message.Len(); ++Index)
+		{
+			if (Message[Index] == TEXT('\n'))
+			{
+				Output.Append(FStringView(*Message + Start, Index - Start)).Append(TEXT("\n\t"));
+				Start = Index + 1;
+			}
+			else if (Message[Index] == TEXT('\r'))
+			{
+				Output.Append(FStringView(*Message + Start, Index - Start));
+				Start = Index + 1;
+			}
+		}
+		Output.Append(FStringView(*Message + Start, Message.Len() - Start)).Newline();
+	}
+}
+
+FToolResult FReadLogTool::Execute(const TSharedPtr<FJsonObject>& Args)
+{
+	FString CategoryList, VerbosityName, Pattern;
+	int64 Since = INDEX_NONE;
+	int32 Limit = DefaultLimit;
+	if (Args.IsValid())
+	{
+		Args->TryGetStringField(TEXT("category"), CategoryList);
+		Args->TryGetStringField(TEXT("verbosity"), VerbosityName);
+		Args->TryGetStringField(TEXT("regex"), Pattern);
+		Args->TryGetNumberField(TEXT("since"), Since);
+		Args->TryGetNumberField(TEXT("limit"), Limit);
+	}
+	Limit = FMath::Clamp(Limit, 1, MaxLimit);
+
+	ELogVerbosity::Type MinVerbosity;
+	if (!ParseMinVerbosity(VerbosityName.TrimStartAndEnd(), MinVerbosity))
+	{
+		return FToolResult::Fail(FString::Printf(TEXT("Unknown verbosity '%s'. Use fatal, error, warning, display, log, verbose, veryverbose or all"), *VerbosityName));
+	}
+
+	// FName compares case-insensitively, like log category names on the command line
+	TSet<FName> Categories;
+	TArray<FString> CategoryNames;
+	CategoryList.ParseIntoArray(CategoryNames, TEXT(","));
+	for (const FString& Name : CategoryNames)
+	{
+		const FString Trimmed = Name.TrimStartAndEnd();
+		if (!Trimmed.IsEmpty())
+		{
+			Categories.Add(FName(*Trimmed));
+		}
+	}
+
+	TOptional<FRegexPattern> Regex;
+	if (!Pattern.IsEmpty())
+	{
+		Regex.Emplace(TEXT("(?i)") + Pattern);
+	}
+
+	auto Matches = [&](const FNeoStackLogCapture::FLine& Line)
+	{
+		if (Line.Verbosity > MinVerbosity)
+		{
+			return false;
+		}
+		if (Categories.Num() > 0 && !Categories.Contains(Line.Category))
+		{
+			return false;
+		}
+		if (Regex.IsSet())
+		{
+			FRegexMatcher Matcher(Regex.GetValue(), Line.Message);
+			return Matcher.FindNext();
+		}
+		return true;
+	};
+
+	FNeoStackLogCapture& Capture = FNeoStackLogCapture::Get();
+	TArray<FNeoStackLogCapture::FLine> Lines;
+	uint64 Dropped = 0;
+	uint64 NextCursor = 0;
+	bool bMore = false;
+
+	if (Since >= 0)
+	{
+		// Oldest first from the cursor; stop once the page is full so nothing is skipped
+		NextCursor = Capture.Read(static_cast<uint64>(Since), [&](const FNeoStackLogCapture::FLine& Line)
+		{
+			if (Matches(Line))
+			{
+				Lines.Add(Line);
+			}
+			return Lines.Num() < Limit;
+		}, Dropped);
+		bMore = NextCursor < Capture.GetNextCursor();
+	}
+	else
+	{
+		// The tail: keep the last Limit matches of everything still in the ring, overwriting the
+		// oldest kept match in place once the page is full
+		int32 Skipped = 0;
+		int32 Oldest = 0;
+		Lines.Reserve(Limit);
+		NextCursor = Capture.Read(0, [&](const FNeoStackLogCapture::FLine& Line)
+		{
+			if (Matches(Line))
+			{
+				if (Lines.Num() < Limit)
+				{
+					Lines.Add(Line);
+				}
+				else
+				{
+					Lines[Oldest] = Line;
+					Oldest = (Oldest + 1) % Limit;
+					++Skipped;
+				}
+			}
+			return true;
+		}, Dropped);
+
+		if (Oldest > 0)
+		{
+			// Back to oldest first
+			TArray<FNeoStackLogCapture::FLine> Ordered;
+			Ordered.Reserve(Lines.Num());
+			for (int32 Index = 0; Index < Lines.Num(); ++Index)
+			{
+				Ordered.Add(MoveTemp(Lines[(Oldest + Index) % Lines.Num()]));
+			}
+			Lines = MoveTemp(Ordered);
+		}
+
+		// Lines that scrolled out of the ring were never asked for
+		Dropped = 0;
+		bMore = Skipped > 0;
+	}
+
+	NeoStackToolUtils::FToolOutputWriter Output(128 + Lines.Num() * 160);
+	Output.Appendf(TEXT("# LOG lines=%d cursor=%llu"), Lines.Num(), NextCursor);
+	if (Dropped > 0)
+	{
+		Output.Appendf(TEXT(" dropped=%llu"), Dropped);
+	}
+	Output.Newline();
+
+	for (const FNeoStackLogCapture::FLine& Line : Lines)
+	{
+		Output.Appendf(TEXT("%llu\t%s\t%s\t%s\t"), Line.Cursor, *Line.Time.ToString(TEXT("%H:%M:%S.%s")),
+			ToString(Line.Verbosity), *Line.Category.ToString());
+		AppendMessage(Output, Line.Message);
+	}
+
+	if (bMore)
+	{
+		if (Since >= 0)
+		{
+			Output.Appendf(TEXT("# MORE since=%llu\n"), NextCursor);
+		}
+		else
+		{
+			Output.Append(TEXT("# MORE earlier lines match; raise limit or narrow the filters\n"));
+		}
+	}
+
+	return FToolResult::Ok(Output.ToString());
+}
@@ -0,0 +1,290 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/TextFileReader.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Containers/StringConv.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#include <cstring>
+
+namespace
+{
+	constexpr int64 IndexChunkSize = 1024 * 1024;
+	constexpr int64 ReadChunkSize = 64 * 1024;
+
+	void AddLine(TArray<FString>& OutLines, const uint8* Data, int32 Len)
+	{
+		if (Len > 0 && Data[Len - 1] == '\r')
+		{
+			--Len;
+		}
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Len);
+		OutLines.Emplace(Converted.Length(), Converted.Get());
+	}
+}
+
+FTextFileReader& FTextFileReader::Get()
+{
+	static FTextFileReader Instance;
+	return Instance;
+}
+
+bool FTextFileReader::BuildIndex(const FString& FilePath, FLineIndex& OutIndex)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_BuildLineIndex);
+
+	TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+	if (!Handle)
+	{
+		return false;
+	}
+
+	const int64 FileSize = Handle->Size();
+	OutIndex.FileSize = FileSize;
+	OutIndex.Checkpoints.Reset();
+
+	TArray<uint8> Chunk;
+	Chunk.SetNumUninitialized(static_cast<int32>(FMath::Min(IndexChunkSize, FMath::Max<int64>(FileSize, 1))));
+
+	// Byte order mark
+	if (FileSize >= 2)
+	{
+		uint8 Bom[3] = { 0, 0, 0 };
+		const int64 BomLen = FMath::Min<int64>(FileSize, 3);
+		if (!Handle->Read(Bom, BomLen))
+		{
+			return false;
+		}
+		if ((Bom[0] == 0xFF && Bom[1] == 0xFE) || (Bom[0] == 0xFE && Bom[1] == 0xFF))
+		{
+			OutIndex.bUtf16 = true;
+			return true;
+		}
+		OutIndex.DataStart = (BomLen == 3 && Bom[0] == 0xEF && Bom[1] == 0xBB && Bom[2] == 0xBF) ? 3 : 0;
+		Handle->Seek(OutIndex.DataStart);
+	}
+
+	OutIndex.Checkpoints.Add(OutIndex.DataStart);
+
+	int64 Position = OutIndex.DataStart;
+	int64 NewlineCount = 0;
+	uint8 LastByte = '\n';
+	while (Position < FileSize)
+	{
+		const int64 ToRead = FMath::Min<int64>(Chunk.Num(), FileSize - Position);
+		if (!Handle->Read(Chunk.GetData(), ToRead))
+		{
+			return false;
+		}
+
+		const uint8* Begin = Chunk.GetData();
+		const uint8* End = Begin + ToRead;
+		for (const uint8* Scan = Begin; Scan < End; )
+		{
+			const uint8* Newline = static_cast<const uint8*>(std::memchr(Scan, '\n', (size_t)(End - Scan)));
+			if (!Newline)
+			{
+				break;
+			}
+			++NewlineCount;
+			if (NewlineCount % CheckpointInterval == 0)
+			{
+				OutIndex.Checkpoints.Add(Position + (Newline - Begin) + 1);
+			}
+			Scan = Newline + 1;
+		}
+
+		LastByte = End[-1];
+		Position += ToRead;
+	}
+
+	const int64 TotalLines = NewlineCount + ((FileSize > OutIndex.DataStart && LastByte != '\n') ? 1 : 0);
+	OutIndex.TotalLines = static_cast<int32>(FMath::Min<int64>(TotalLines, MAX_int32));
+	return true;
+}
+
+const FTextFileReader::FLineIndex* FTextFileReader::GetIndex(const FString& FilePath)
+{
+	const FFileStatData Stat = IFileManager::Get().GetStatData(*FilePath);
+	if (!Stat.bIsValid || Stat.bIsDirectory)
+	{
+		return nullptr;
+	}
+
+	if (FLineIndex* Existing = Indexes.Find(FilePath))
+	{
+		if (Existing->TimeStamp == Stat.ModificationTime && Existing->FileSize == Stat.FileSize)
+		{
+			Existing->LastUsed = ++UseCounter;
+			return Existing;
+		}
+		Indexes.Remove(FilePath);
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	FLineIndex Index;
+	if (!BuildIndex(FilePath, Index))
+	{
+		return nullptr;
+	}
+	Index.TimeStamp = Stat.ModificationTime;
+	Index.LastUsed = ++UseCounter;
+
+	if (Indexes.Num() >= MaxCachedFiles)
+	{
+		FString Oldest;
+		uint64 OldestUse = MAX_uint64;
+		for (const TPair<FString, FLineIndex>& Pair : Indexes)
+		{
+			if (Pair.Value.LastUsed < OldestUse)
+			{
+				OldestUse = Pair.Value.LastUsed;
+				Oldest = Pair.Key;
+			}
+		}
+		Indexes.Remove(Oldest);
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("[NeoStack] Indexed %d lines of %s in %.1f ms"),
+		Index.TotalLines, *FilePath, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	return &Indexes.Add(FilePath, MoveTemp(Index));
+}
+
+bool FTextFileReader::ReadLines(const FString& FilePath, int32 StartIndex, int32 Count, TArray<FString>& OutLines, int32& OutTotalLines)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_ReadLines);
+
+	OutLines.Reset();
+	OutTotalLines = 0;
+
+	const FLineIndex* Index = GetIndex(FilePath);
+	if (!Index)
+	{
+		return false;
+	}
+	if (Index->bUtf16)
+	{
+		return ReadUtf16Lines(FilePath, StartIndex, Count, OutLines, OutTotalLines);
+	}
+
+	OutTotalLines = Index->TotalLines;
+	const int32 EndIndex = static_cast<int32>(FMath::Min<int64>(static_cast<int64>(StartIndex) + Count, Index->TotalLines));
+	if (StartIndex >= EndIndex)
+	{
+		return true;
+	}
+
+	TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+	if (!Handle)
+	{
+		return false;
+	}
+
+	const int32 CheckpointIdx = FMath::Min(StartIndex / CheckpointInterval, Index->Checkpoints.Num() - 1);
+	int64 Position = Index->Checkpoints[CheckpointIdx];
+	int32 Line = CheckpointIdx * CheckpointInterval;
+	if (!Handle->Seek(Position))
+	{
+		return false;
+	}
+
+	OutLines.Reserve(EndIndex - StartIndex);
+
+	TArray<uint8> Chunk;
+	Chunk.SetNumUninitialized(static_cast<int32>(ReadChunkSize));
+	TArray<uint8> Pending; // Start of a line that continues into the next chunk
+
+	while (Line < EndIndex && Position < Index->FileSize)
+	{
+		const int64 ToRead = FMath::Min<int64>(ReadChunkSize, Index->FileSize - Position);
+		if (!Handle->Read(Chunk.GetData(), ToRead))
+		{
+			return false;
+		}
+		Position += ToRead;
+
+		const uint8* Scan = Chunk.GetData();
+		const uint8* End = Scan + ToRead;
+		while (Scan < End && Line < EndIndex)
+		{
+			const uint8* Newline = static_cast<const uint8*>(std::memchr(Scan, '\n', (size_t)(End - Scan)));
+			const uint8* LineEnd = Newline ? Newline : End;
+
+			// Lines before the window (at most CheckpointInterval - 1) are skipped without copying
+			if (Line >= StartIndex)
+			{
+				if (Newline && Pending.Num() == 0)
+				{
+					AddLine(OutLines, Scan, static_cast<int32>(LineEnd - Scan));
+				}
+				else
+				{
+					Pending.Append(Scan, static_cast<int32>(LineEnd - Scan));
+					if (Newline)
+					{
+						AddLine(OutLines, Pending.GetData(), Pending.Num());
+						Pending.Reset();
+					}
+				}
+			}
+
+			if (!Newline)
+			{
+				break;
+			}
+			++Line;
+			Scan = Newline + 1;
+		}
+	}
+
+	// Last line without a trailing newline
+	if (Line >= StartIndex && Line < EndIndex)
+	{
+		AddLine(OutLines, Pending.GetData(), Pending.Num());
+	}
+
+	return true;
+}
+
+bool FTextFileReader::ReadUtf16Lines(const FString& FilePath, int32 StartIndex, int32 Count, TArray<FString>& OutLines, int32& OutTotalLines)
+{
+	FString Content;
+	if (!FFileHelper::LoadFileToString(Content, *FilePath))
+	{
+		return false;
+	}
+
+	const int64 EndIndex = static_cast<int64>(StartIndex) + Count;
+	int32 Line = 0;
+	int32 LineStart = 0;
+	for (int32 i = 0; i <= Content.Len(); ++i)
+	{
+		if (i < Content.Len() && Content[i] != TEXT('\n'))
+		{
+			continue;
+		}
+		if (i == Content.Len() && LineStart == i)
+		{
+			break;
+		}
+
+		if (Line >= StartIndex && Line < EndIndex)
+		{
+			int32 Len = i - LineStart;
+			if (Len > 0 && Content[LineStart + Len - 1] == TEXT('\r'))
+			{
+				--Len;
+			}
+			OutLines.Add(Content.Mid(LineStart, Len));
+		}
+		++Line;
+		LineStart = i + 1;
+	}
+
+	OutTotalLines = Line;
+	return true;
+}
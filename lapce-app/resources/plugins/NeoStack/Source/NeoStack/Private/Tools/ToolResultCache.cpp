@@ -0,0 +1,343 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/ToolResultCache.h"
+#include "Editor.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/TransactionObjectEvent.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	/** Compact JSON-like text for Value with object keys sorted; equal arguments give equal text */
+	void AppendNormalized(const TSharedPtr<FJsonValue>& Value, FString& Out)
+	{
+		if (!Value.IsValid())
+		{
+			Out += TEXT("null");
+			return;
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::Object:
+		{
+			const TSharedPtr<FJsonObject>& Object = Value->AsObject();
+			TArray<FString> Keys;
+			if (Object.IsValid())
+			{
+				Object->Values.GetKeys(Keys);
+				Keys.Sort();
+			}
+
+			Out += TEXT('{');
+			for (int32 i = 0; i < Keys.Num(); i++)
+			{
+				if (i > 0)
+				{
+					Out += TEXT(',');
+				}
+				Out += TEXT('"');
+				Out += Keys[i].ReplaceCharWithEscapedChar();
+				Out += TEXT("\":");
+				AppendNormalized(Object->Values[Keys[i]], Out);
+			}
+			Out += TEXT('}');
+			break;
+		}
+		case EJson::Array:
+		{
+			Out += TEXT('[');
+			const TArray<TSharedPtr<FJsonValue>>& Items = Value->AsArray();
+			for (int32 i = 0; i < Items.Num(); i++)
+			{
+				if (i > 0)
+				{
+					Out += TEXT(',');
+				}
+				AppendNormalized(Items[i], Out);
+			}
+			Out += TEXT(']');
+			break;
+		}
+		case EJson::String:
+			Out += TEXT('"');
+			Out += Value->AsString().ReplaceCharWithEscapedChar();
+			Out += TEXT('"');
+			break;
+		case EJson::Number:
+			Out += FString::SanitizeFloat(Value->AsNumber());
+			break;
+		case EJson::Boolean:
+			Out += Value->AsBool() ? TEXT("true") : TEXT("false");
+			break;
+		default:
+			Out += TEXT("null");
+			break;
+		}
+	}
+}
+
+FToolResultCache& FToolResultCache::Get()
+{
+	static FToolResultCache Instance;
+	return Instance;
+}
+
+void FToolResultCache::RegisterDelegates()
+{
+	if (bDelegatesRegistered)
+	{
+		return;
+	}
+
+	FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FToolResultCache::HandleObjectModified);
+	FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FToolResultCache::HandleObjectTransacted);
+	UPackage::PackageSavedWithContextEvent.AddRaw(this, &FToolResultCache::HandlePackageSaved);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().AddRaw(this, &FToolResultCache::HandleBlueprintCompiled);
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FToolResultCache::HandleAssetAdded);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FToolResultCache::HandleAssetRemoved);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FToolResultCache::HandleAssetRenamed);
+
+	bDelegatesRegistered = true;
+}
+
+void FToolResultCache::Shutdown()
+{
+	if (bDelegatesRegistered)
+	{
+		FCoreUObjectDelegates::OnObjectModified.RemoveAll(this);
+		FCoreUObjectDelegates::OnObjectTransacted.RemoveAll(this);
+		UPackage::PackageSavedWithContextEvent.RemoveAll(this);
+		if (GEditor)
+		{
+			GEditor->OnBlueprintCompiled().RemoveAll(this);
+		}
+
+		if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+		{
+			IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+			AssetRegistry.OnAssetAdded().RemoveAll(this);
+			AssetRegistry.OnAssetRemoved().RemoveAll(this);
+			AssetRegistry.OnAssetRenamed().RemoveAll(this);
+		}
+		bDelegatesRegistered = false;
+	}
+
+	Entries.Empty();
+	Generations.Empty();
+	TotalChars = 0;
+}
+
+FString FToolResultCache::MakeKey(const FString& ToolName, const TSharedPtr<FJsonObject>& Args)
+{
+	FString Key = ToolName;
+	Key += TEXT(':');
+	AppendNormalized(MakeShared<FJsonValueObject>(Args.IsValid() ? Args : MakeShared<FJsonObject>()), Key);
+	return Key;
+}
+
+bool FToolResultCache::IsValid(const FEntry& Entry) const
+{
+	if (Entry.CompileGeneration != CompileGeneration ||
+		FPlatformTime::Seconds() - Entry.StoredTime > MaxAgeSeconds)
+	{
+		return false;
+	}
+
+	if (Entry.ResourceGenerations.Num() == 0)
+	{
+		return Entry.GlobalGeneration == GlobalGeneration;
+	}
+
+	for (const TPair<FName, uint32>& Resource : Entry.ResourceGenerations)
+	{
+		const uint32* Generation = Generations.Find(Resource.Key);
+		if (!Generation || *Generation != Resource.Value)
+		{
+			return false;
+		}
+	}
+
+	for (const FFileStamp& File : Entry.Files)
+	{
+		const FFileStatData Stat = IFileManager::Get().GetStatData(*File.Filename);
+		if (!Stat.bIsValid || Stat.ModificationTime != File.TimeStamp || Stat.FileSize != File.FileSize)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+const FToolResult* FToolResultCache::Find(const FString& Key)
+{
+	FEntry* Entry = Entries.Find(Key);
+	if (!Entry)
+	{
+		return nullptr;
+	}
+
+	if (!IsValid(*Entry))
+	{
+		Remove(Key);
+		return nullptr;
+	}
+
+	Entry->LastUsed = ++UseCounter;
+	return &Entry->Result;
+}
+
+void FToolResultCache::Store(const FString& Key, const TArray<FString>& Resources, const FToolResult& Result, double DurationMs)
+{
+	if (!Result.bSuccess || Result.Output.Len() > MaxTotalChars / 4)
+	{
+		return;
+	}
+	RegisterDelegates();
+
+	Remove(Key);
+	while (Entries.Num() >= MaxEntries || (Entries.Num() > 0 && TotalChars + Result.Output.Len() > MaxTotalChars))
+	{
+		EvictOldest();
+	}
+
+	FEntry& Entry = Entries.Add(Key);
+	Entry.Result = Result;
+	Entry.Result.bFromCache = true;
+	Entry.Result.CachedDurationMs = static_cast<float>(DurationMs);
+	Entry.GlobalGeneration = GlobalGeneration;
+	Entry.CompileGeneration = CompileGeneration;
+	Entry.StoredTime = FPlatformTime::Seconds();
+	Entry.LastUsed = ++UseCounter;
+
+	Entry.ResourceGenerations.Reserve(Resources.Num());
+	for (const FString& Resource : Resources)
+	{
+		const FName ResourceName(*Resource);
+		Entry.ResourceGenerations.Emplace(ResourceName, Generations.FindOrAdd(ResourceName));
+
+		// Text file keys are full paths; nothing in the editor is told when they change
+		if (!FPackageName::IsValidLongPackageName(Resource))
+		{
+			const FFileStatData Stat = IFileManager::Get().GetStatData(*Resource);
+			if (Stat.bIsValid && !Stat.bIsDirectory)
+			{
+				Entry.Files.Add({ Resource, Stat.ModificationTime, Stat.FileSize });
+			}
+		}
+	}
+
+	TotalChars += Result.Output.Len();
+}
+
+void FToolResultCache::Remove(const FString& Key)
+{
+	FEntry Removed;
+	if (Entries.RemoveAndCopyValue(Key, Removed))
+	{
+		TotalChars -= Removed.Result.Output.Len();
+	}
+}
+
+void FToolResultCache::EvictOldest()
+{
+	const FString* Oldest = nullptr;
+	uint64 OldestUse = MAX_uint64;
+	for (const TPair<FString, FEntry>& Pair : Entries)
+	{
+		if (Pair.Value.LastUsed < OldestUse)
+		{
+			OldestUse = Pair.Value.LastUsed;
+			Oldest = &Pair.Key;
+		}
+	}
+
+	if (Oldest)
+	{
+		Remove(FString(*Oldest));
+	}
+}
+
+void FToolResultCache::NotifyMutation(const TArray<FString>& Resources)
+{
+	// New or changed assets show up in listings and searches, whatever they are
+	++GlobalGeneration;
+
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	for (const FString& Resource : Resources)
+	{
+		if (uint32* Generation = Generations.Find(FName(*Resource, FNAME_Find)))
+		{
+			++(*Generation);
+		}
+	}
+}
+
+void FToolResultCache::BumpGeneration(const UObject* Object)
+{
+	// Called for every Modify() in the editor; stay cheap when nothing is cached
+	if (!Object || Entries.Num() == 0)
+	{
+		return;
+	}
+
+	const UPackage* Package = Object->GetPackage();
+	if (!Package)
+	{
+		return;
+	}
+
+	if (uint32* Generation = Generations.Find(Package->GetFName()))
+	{
+		++(*Generation);
+	}
+}
+
+void FToolResultCache::HandleObjectModified(UObject* Object)
+{
+	BumpGeneration(Object);
+}
+
+void FToolResultCache::HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event)
+{
+	BumpGeneration(Object);
+}
+
+void FToolResultCache::HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	BumpGeneration(Package);
+}
+
+void FToolResultCache::HandleBlueprintCompiled()
+{
+	++CompileGeneration;
+}
+
+void FToolResultCache::HandleAssetAdded(const FAssetData& AssetData)
+{
+	++GlobalGeneration;
+}
+
+void FToolResultCache::HandleAssetRemoved(const FAssetData& AssetData)
+{
+	++GlobalGeneration;
+}
+
+void FToolResultCache::HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	++GlobalGeneration;
+}
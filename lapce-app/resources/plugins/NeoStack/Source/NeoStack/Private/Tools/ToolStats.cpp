@@ -0,0 +1,187 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/ToolStats.h"
+#include "Tools/NeoStackToolBase.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	/** Nearest-rank percentile of sorted values */
+	float Percentile(const TArray<float>& Sorted, float Fraction)
+	{
+		if (Sorted.Num() == 0)
+		{
+			return 0.0f;
+		}
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt32(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Rank];
+	}
+
+	void DumpToolStats(const TArray<FString>& Args)
+	{
+		FNeoStackToolStats::Get().Dump();
+	}
+
+	void ExportToolStats(const TArray<FString>& Args)
+	{
+		const FString FilePath = Args.Num() > 0
+			? Args[0]
+			: FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("tool_stats.csv");
+
+		if (FNeoStackToolStats::Get().ExportCsv(FilePath))
+		{
+			UE_LOG(LogTemp, Display, TEXT("[NeoStack] Tool stats written to %s"), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStack] Failed to write tool stats to %s"), *FilePath);
+		}
+	}
+
+	void ResetToolStats(const TArray<FString>& Args)
+	{
+		FNeoStackToolStats::Get().Reset();
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack] Tool stats cleared"));
+	}
+
+	FAutoConsoleCommand DumpToolStatsCommand(
+		TEXT("NeoStack.ToolStats"),
+		TEXT("Print per-tool latency, output size and memory statistics for recent tool calls"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DumpToolStats));
+
+	FAutoConsoleCommand ExportToolStatsCommand(
+		TEXT("NeoStack.ToolStats.Export"),
+		TEXT("Write the tool statistics table as CSV. Usage: NeoStack.ToolStats.Export [File]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ExportToolStats));
+
+	FAutoConsoleCommand ResetToolStatsCommand(
+		TEXT("NeoStack.ToolStats.Reset"),
+		TEXT("Clear the tool statistics"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ResetToolStats));
+}
+
+FNeoStackToolStats& FNeoStackToolStats::Get()
+{
+	static FNeoStackToolStats Instance;
+	return Instance;
+}
+
+int64 FNeoStackToolStats::GetUsedMemory()
+{
+	return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+}
+
+int64 FNeoStackToolStats::GetOutputBytes(const FToolResult& Result)
+{
+	return FPlatformString::ConvertedLength<UTF8CHAR>(*Result.Output, Result.Output.Len());
+}
+
+void FNeoStackToolStats::Record(const FString& ToolName, const FToolResult& Result, const FSample& Sample)
+{
+	FToolEntry& Entry = Tools.FindOrAdd(ToolName);
+	Entry.Calls++;
+	if (!Result.bSuccess)
+	{
+		Entry.Failures++;
+	}
+	if (Result.bFromCache)
+	{
+		Entry.CacheHits++;
+	}
+
+	if (Entry.Samples.Num() < SamplesPerTool)
+	{
+		Entry.Samples.Add(Sample);
+	}
+	else
+	{
+		Entry.Samples[Entry.NextSample] = Sample;
+	}
+	Entry.NextSample = (Entry.NextSample + 1) % SamplesPerTool;
+}
+
+TArray<FNeoStackToolStats::FSummary> FNeoStackToolStats::Summarize() const
+{
+	TArray<FSummary> Summaries;
+	Summaries.Reserve(Tools.Num());
+
+	TArray<float> Latencies;
+	for (const TPair<FString, FToolEntry>& Pair : Tools)
+	{
+		const FToolEntry& Entry = Pair.Value;
+		FSummary& Summary = Summaries.AddDefaulted_GetRef();
+		Summary.ToolName = Pair.Key;
+		Summary.Calls = Entry.Calls;
+		Summary.Failures = Entry.Failures;
+		Summary.CacheHits = Entry.CacheHits;
+
+		const int32 Count = Entry.Samples.Num();
+		if (Count == 0)
+		{
+			continue;
+		}
+
+		Latencies.Reset(Count);
+		double GameThreadMs = 0.0;
+		int64 OutputBytes = 0;
+		int64 MemoryDelta = 0;
+		for (const FSample& Sample : Entry.Samples)
+		{
+			Latencies.Add(Sample.LatencyMs);
+			GameThreadMs += Sample.GameThreadMs;
+			OutputBytes += Sample.OutputBytes;
+			MemoryDelta += Sample.MemoryDeltaBytes;
+			Summary.MaxOutputBytes = FMath::Max(Summary.MaxOutputBytes, Sample.OutputBytes);
+		}
+		Latencies.Sort();
+
+		Summary.P50Ms = Percentile(Latencies, 0.50f);
+		Summary.P95Ms = Percentile(Latencies, 0.95f);
+		Summary.MaxMs = Latencies.Last();
+		Summary.AvgGameThreadMs = static_cast<float>(GameThreadMs / Count);
+		Summary.AvgOutputBytes = OutputBytes / Count;
+		Summary.AvgMemoryDeltaBytes = MemoryDelta / Count;
+	}
+
+	Summaries.Sort([](const FSummary& A, const FSummary& B) { return A.P95Ms > B.P95Ms; });
+	return Summaries;
+}
+
+void FNeoStackToolStats::Dump() const
+{
+	const TArray<FSummary> Summaries = Summarize();
+	if (Summaries.Num() == 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack] No tool calls recorded"));
+		return;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[NeoStack] Tool stats (last %d calls per tool):"), SamplesPerTool);
+	UE_LOG(LogTemp, Display, TEXT("[NeoStack]   %-20s %7s %6s %6s %9s %9s %9s %9s %10s %10s %10s"),
+		TEXT("tool"), TEXT("calls"), TEXT("fail"), TEXT("cached"), TEXT("p50 ms"), TEXT("p95 ms"), TEXT("max ms"),
+		TEXT("gt ms"), TEXT("avg out"), TEXT("max out"), TEXT("avg mem"));
+	for (const FSummary& Summary : Summaries)
+	{
+		UE_LOG(LogTemp, Display, TEXT("[NeoStack]   %-20s %7lld %6lld %6lld %9.1f %9.1f %9.1f %9.1f %10lld %10lld %10lld"),
+			*Summary.ToolName, Summary.Calls, Summary.Failures, Summary.CacheHits,
+			Summary.P50Ms, Summary.P95Ms, Summary.MaxMs, Summary.AvgGameThreadMs,
+			Summary.AvgOutputBytes, Summary.MaxOutputBytes, Summary.AvgMemoryDeltaBytes);
+	}
+}
+
+bool FNeoStackToolStats::ExportCsv(const FString& FilePath) const
+{
+	FString Csv = TEXT("tool,calls,failures,cache_hits,p50_ms,p95_ms,max_ms,avg_game_thread_ms,avg_output_bytes,max_output_bytes,avg_memory_delta_bytes\n");
+	for (const FSummary& Summary : Summarize())
+	{
+		Csv += FString::Printf(TEXT("%s,%lld,%lld,%lld,%.2f,%.2f,%.2f,%.2f,%lld,%lld,%lld\n"),
+			*Summary.ToolName, Summary.Calls, Summary.Failures, Summary.CacheHits,
+			Summary.P50Ms, Summary.P95Ms, Summary.MaxMs, Summary.AvgGameThreadMs,
+			Summary.AvgOutputBytes, Summary.MaxOutputBytes, Summary.AvgMemoryDeltaBytes);
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
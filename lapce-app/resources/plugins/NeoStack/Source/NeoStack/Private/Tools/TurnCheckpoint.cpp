@@ -0,0 +1,355 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "Tools/TurnCheckpoint.h"
+#include "Tools/BlueprintCompileScheduler.h"
+#include "Tools/NeoStackToolRegistry.h"
+#include "NeoStackSettings.h"
+#include "Editor.h"
+#include "Editor/Transactor.h"
+#include "ObjectTools.h"
+#include "Engine/Blueprint.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/PackageName.h"
+#include "Serialization/ObjectReader.h"
+#include "Serialization/ObjectWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+
+namespace
+{
+	/** Serializes an object the way the undo buffer does (graph pins, instanced subobjects) */
+	class FSnapshotWriter : public FObjectWriter
+	{
+	public:
+		FSnapshotWriter(UObject* Object, TArray<uint8>& Bytes)
+			: FObjectWriter(Bytes)
+		{
+			SetIsTransacting(true);
+			Object->Serialize(*this);
+		}
+	};
+
+	class FSnapshotReader : public FObjectReader
+	{
+	public:
+		FSnapshotReader(UObject* Object, TArray<uint8>& Bytes)
+			: FObjectReader(Bytes)
+		{
+			SetIsTransacting(true);
+			Object->Serialize(*this);
+		}
+	};
+
+	constexpr ERenameFlags RestoreRenameFlags = REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty | REN_ForceNoResetLoaders;
+
+	void RollbackTurnCommand()
+	{
+		FString Report;
+		const int32 Restored = FTurnCheckpoint::Get().Rollback(Report);
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Rolled back %d package(s)\n%s"), Restored, *Report);
+	}
+
+	FAutoConsoleCommand RollbackTurnConsoleCommand(
+		TEXT("NeoStack.RollbackTurn"),
+		TEXT("Put every asset the last agent turn changed back to its state before the turn (needs the Turn Checkpoints setting)"),
+		FConsoleCommandDelegate::CreateStatic(&RollbackTurnCommand));
+}
+
+FTurnCheckpoint::FEditScope::FEditScope(bool bMutating, const TArray<FString>& Resources)
+{
+	if (!bMutating || !IsEnabled())
+	{
+		return;
+	}
+
+	FTurnCheckpoint& Checkpoint = FTurnCheckpoint::Get();
+	Checkpoint.PrepareCapture();
+	for (const FString& Resource : Resources)
+	{
+		// Files on disk have absolute paths as keys (also "/" rooted outside Windows), assets their package name
+		if (!FPackageName::IsValidLongPackageName(Resource))
+		{
+			continue;
+		}
+
+		const FName PackageName(*Resource);
+		if (!Checkpoint.Packages.Contains(PackageName) && !Checkpoint.CreatedPackages.Contains(PackageName)
+			&& !FindPackage(nullptr, *Resource) && !FPackageName::DoesPackageExist(Resource))
+		{
+			Checkpoint.CreatedPackages.Add(PackageName);
+		}
+	}
+
+	if (Checkpoint.ScopeDepth++ == 0 && GEditor && GEditor->Trans)
+	{
+		GEditor->Trans->DisableObjectSerialization();
+	}
+	bActive = true;
+}
+
+FTurnCheckpoint::FEditScope::~FEditScope()
+{
+	if (!bActive)
+	{
+		return;
+	}
+
+	FTurnCheckpoint& Checkpoint = FTurnCheckpoint::Get();
+	if (--Checkpoint.ScopeDepth == 0 && GEditor && GEditor->Trans)
+	{
+		GEditor->Trans->EnableObjectSerialization();
+	}
+}
+
+FTurnCheckpoint& FTurnCheckpoint::Get()
+{
+	static FTurnCheckpoint Instance;
+	return Instance;
+}
+
+bool FTurnCheckpoint::IsEnabled()
+{
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	return Settings && Settings->bTurnCheckpoints;
+}
+
+void FTurnCheckpoint::BeginTurn()
+{
+	bTurnPending = true;
+}
+
+void FTurnCheckpoint::PrepareCapture()
+{
+	if (!bDelegatesRegistered)
+	{
+		FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FTurnCheckpoint::HandleObjectModified);
+		UPackage::PackageMarkedDirtyEvent.AddRaw(this, &FTurnCheckpoint::HandlePackageMarkedDirty);
+		bDelegatesRegistered = true;
+	}
+
+	if (bTurnPending)
+	{
+		// The previous turn can't be rolled back any more once this one changes something
+		bTurnPending = false;
+		Packages.Reset();
+		CreatedPackages.Reset();
+	}
+}
+
+void FTurnCheckpoint::GatherObjects(UPackage* Package, TArray<UObject*>& OutObjects)
+{
+	TArray<UObject*> Objects;
+	GetObjectsWithPackage(Package, Objects, true, RF_ClassDefaultObject | RF_Transient);
+	OutObjects.Reserve(Objects.Num());
+	for (UObject* Object : Objects)
+	{
+		// Generated classes and functions are rebuilt by the compile that follows a rollback
+		if (!Object->IsA<UField>())
+		{
+			OutObjects.Add(Object);
+		}
+	}
+}
+
+void FTurnCheckpoint::CapturePackage(UPackage* Package, bool bWasDirty)
+{
+	if (!Package || Package == GetTransientPackage() || Package->HasAnyPackageFlags(PKG_CompiledIn))
+	{
+		return;
+	}
+
+	const FName PackageName = Package->GetFName();
+	if (Packages.Contains(PackageName) || CreatedPackages.Contains(PackageName))
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_TurnCheckpointCapture);
+
+	// Modify() runs before the change it announces, so this is still the state before the turn
+	FPackageSnapshot& Snapshot = Packages.Add(PackageName);
+	Snapshot.Package.Reset(Package);
+	Snapshot.bWasDirty = bWasDirty;
+
+	TArray<UObject*> Objects;
+	GatherObjects(Package, Objects);
+	Snapshot.Objects.Reserve(Objects.Num());
+	for (UObject* Object : Objects)
+	{
+		FObjectSnapshot& ObjectSnapshot = Snapshot.Objects.AddDefaulted_GetRef();
+		ObjectSnapshot.Object.Reset(Object);
+		ObjectSnapshot.Outer = Object->GetOuter();
+		ObjectSnapshot.Name = Object->GetFName();
+		FSnapshotWriter Writer(Object, ObjectSnapshot.Data);
+	}
+}
+
+void FTurnCheckpoint::HandleObjectModified(UObject* Object)
+{
+	if (ScopeDepth > 0 && Object)
+	{
+		UPackage* Package = Object->GetPackage();
+		CapturePackage(Package, Package && Package->IsDirty());
+	}
+}
+
+void FTurnCheckpoint::HandlePackageMarkedDirty(UPackage* Package, bool bWasDirty)
+{
+	// Modify() dirties the package before announcing itself; this is the only place the old flag is known
+	if (ScopeDepth > 0)
+	{
+		CapturePackage(Package, bWasDirty);
+	}
+}
+
+int32 FTurnCheckpoint::Rollback(FString& OutReport)
+{
+	if (!HasCheckpoint())
+	{
+		OutReport = TEXT("Nothing to roll back\n");
+		return 0;
+	}
+	if (ScopeDepth > 0 || (FNeoStackToolRegistry::IsCreated() && FNeoStackToolRegistry::Get().GetRunningTaskCount() > 0))
+	{
+		OutReport = TEXT("! A tool call is still running\n");
+		return 0;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStack_TurnCheckpointRollback);
+
+	int32 Restored = 0;
+	for (TPair<FName, FPackageSnapshot>& Entry : Packages)
+	{
+		const bool bOk = RestorePackage(Entry.Value);
+		OutReport += FString::Printf(TEXT("%s restored %s\n"), bOk ? TEXT("+") : TEXT("!"), *Entry.Key.ToString());
+		Restored += bOk ? 1 : 0;
+	}
+	for (const FName& PackageName : CreatedPackages)
+	{
+		const bool bOk = DeleteCreatedPackage(PackageName);
+		OutReport += FString::Printf(TEXT("%s deleted %s\n"), bOk ? TEXT("-") : TEXT("!"), *PackageName.ToString());
+		Restored += bOk ? 1 : 0;
+	}
+
+	Packages.Reset();
+	CreatedPackages.Reset();
+	bTurnPending = true;
+	return Restored;
+}
+
+bool FTurnCheckpoint::RestorePackage(FPackageSnapshot& Snapshot)
+{
+	UPackage* Package = Snapshot.Package.Get();
+	if (!Package)
+	{
+		return false;
+	}
+
+	TSet<UObject*> Known;
+	Known.Reserve(Snapshot.Objects.Num());
+	for (const FObjectSnapshot& ObjectSnapshot : Snapshot.Objects)
+	{
+		Known.Add(ObjectSnapshot.Object.Get());
+	}
+
+	// Objects the turn added leave the package (their subobjects go with them)
+	TArray<UObject*> Current;
+	GatherObjects(Package, Current);
+	for (UObject* Object : Current)
+	{
+		if (!Known.Contains(Object) && (Object->GetOuter() == Package || Known.Contains(Object->GetOuter())))
+		{
+			Object->ClearFlags(RF_Public | RF_Standalone);
+			Object->Rename(nullptr, GetTransientPackage(), RestoreRenameFlags);
+			Object->MarkAsGarbage();
+		}
+	}
+
+	// Objects the turn removed or moved come back where they were
+	for (FObjectSnapshot& ObjectSnapshot : Snapshot.Objects)
+	{
+		UObject* Object = ObjectSnapshot.Object.Get();
+		Object->ClearGarbage();
+		if (Object->GetOuter() != ObjectSnapshot.Outer || Object->GetFName() != ObjectSnapshot.Name)
+		{
+			Object->Rename(*ObjectSnapshot.Name.ToString(), ObjectSnapshot.Outer, RestoreRenameFlags);
+		}
+	}
+
+	for (FObjectSnapshot& ObjectSnapshot : Snapshot.Objects)
+	{
+		ObjectSnapshot.Object->PreEditUndo();
+	}
+	for (FObjectSnapshot& ObjectSnapshot : Snapshot.Objects)
+	{
+		FSnapshotReader Reader(ObjectSnapshot.Object.Get(), ObjectSnapshot.Data);
+	}
+	for (FObjectSnapshot& ObjectSnapshot : Snapshot.Objects)
+	{
+		UObject* Object = ObjectSnapshot.Object.Get();
+		Object->PostEditUndo();
+		if (UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+		{
+			FBlueprintCompileScheduler::Get().RequestCompile(Blueprint);
+		}
+	}
+
+	Package->SetDirtyFlag(Snapshot.bWasDirty);
+
+	// Caches keyed on edit generations see the restore like any other edit
+	if (UObject* Asset = Package->FindAssetInPackage())
+	{
+		FCoreUObjectDelegates::BroadcastOnObjectModified(Asset);
+	}
+	return true;
+}
+
+bool FTurnCheckpoint::DeleteCreatedPackage(FName PackageName)
+{
+	const FString Name = PackageName.ToString();
+	if (UPackage* Package = FindPackage(nullptr, *Name))
+	{
+		TArray<UObject*> Assets;
+		GetObjectsWithPackage(Package, Assets, false);
+		Assets.RemoveAll([](const UObject* Object) { return !Object->IsAsset(); });
+		if (Assets.Num() > 0)
+		{
+			return ObjectTools::DeleteObjectsUnchecked(Assets) > 0;
+		}
+	}
+
+	// Never loaded or already gone from memory; a saved file is all that is left
+	FString Filename;
+	if (FPackageName::DoesPackageExist(Name, &Filename))
+	{
+		return IFileManager::Get().Delete(*Filename, false, true);
+	}
+	return true;
+}
+
+int64 FTurnCheckpoint::GetSnapshotBytes() const
+{
+	int64 Bytes = 0;
+	for (const TPair<FName, FPackageSnapshot>& Entry : Packages)
+	{
+		for (const FObjectSnapshot& ObjectSnapshot : Entry.Value.Objects)
+		{
+			Bytes += ObjectSnapshot.Data.Num();
+		}
+	}
+	return Bytes;
+}
+
+void FTurnCheckpoint::Shutdown()
+{
+	if (bDelegatesRegistered)
+	{
+		FCoreUObjectDelegates::OnObjectModified.RemoveAll(this);
+		UPackage::PackageMarkedDirtyEvent.RemoveAll(this);
+		bDelegatesRegistered = false;
+	}
+
+	Packages.Empty();
+	CreatedPackages.Empty();
+}
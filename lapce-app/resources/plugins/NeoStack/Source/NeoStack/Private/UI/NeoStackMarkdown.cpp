@@ -0,0 +1,288 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "UI/NeoStackMarkdown.h"
+
+namespace
+{
+	enum class ESpan : uint8
+	{
+		None,
+		Bold,
+		Italic
+	};
+
+	/**
+	 * Walks the inline markers of the text. In the counting pass it only tallies bold and
+	 * italic markers; in the emitting pass it writes rich text and uses the remaining counts
+	 * to leave markers without a partner as literal text. Spans never nest (Slate rich
+	 * text cannot), so a marker of the other kind inside an open span is literal too.
+	 */
+	void ScanInline(const FString& Text, bool bEmit, int32& BoldMarkers, int32& ItalicMarkers, FString& Out)
+	{
+		const TCHAR* Data = *Text;
+		const int32 Len = Text.Len();
+
+		ESpan Open = ESpan::None;
+		bool bInCode = false;
+		bool bInHeading = false;
+		bool bLineStart = true;
+
+		for (int32 i = 0; i < Len; ++i)
+		{
+			const TCHAR C = Data[i];
+
+			if (C == TEXT('\n'))
+			{
+				if (bEmit && bInHeading)
+				{
+					Out += TEXT("</>");
+				}
+				bInHeading = false;
+				bLineStart = true;
+				if (bEmit)
+				{
+					Out.AppendChar(C);
+				}
+				continue;
+			}
+
+			if (bLineStart)
+			{
+				bLineStart = false;
+
+				// Headings take the whole line and are not mixed with inline spans
+				const int32 HeadingLevel = (C == TEXT('#') && i + 1 < Len && Data[i + 1] == TEXT(' ')) ? 1
+					: (C == TEXT('#') && i + 2 < Len && Data[i + 1] == TEXT('#') && Data[i + 2] == TEXT(' ')) ? 2 : 0;
+				if (HeadingLevel > 0)
+				{
+					bInHeading = true;
+					i += HeadingLevel;
+					if (bEmit)
+					{
+						if (Open != ESpan::None)
+						{
+							Out += TEXT("</>");
+							Open = ESpan::None;
+						}
+						Out += HeadingLevel == 1 ? TEXT("<Credits.H2>") : TEXT("<RichTextBlock.Bold>");
+					}
+					continue;
+				}
+
+				// "* item" is a list bullet, not an italic marker
+				if (C == TEXT('*') && i + 1 < Len && Data[i + 1] == TEXT(' '))
+				{
+					if (bEmit)
+					{
+						Out += TEXT("•");
+					}
+					continue;
+				}
+			}
+
+			if (C == TEXT('`'))
+			{
+				bInCode = !bInCode;
+				continue;
+			}
+
+			if (C == TEXT('*') && !bInCode && !bInHeading)
+			{
+				const bool bDouble = i + 1 < Len && Data[i + 1] == TEXT('*');
+				const ESpan Kind = bDouble ? ESpan::Bold : ESpan::Italic;
+				int32& Remaining = bDouble ? BoldMarkers : ItalicMarkers;
+
+				if (!bEmit)
+				{
+					++Remaining;
+					i += bDouble ? 1 : 0;
+					continue;
+				}
+
+				--Remaining;
+				if (Open == Kind)
+				{
+					Out += TEXT("</>");
+					Open = ESpan::None;
+					i += bDouble ? 1 : 0;
+					continue;
+				}
+				if (Open == ESpan::None && Remaining > 0)
+				{
+					Out += bDouble ? TEXT("<RichTextBlock.Bold>") : TEXT("<RichTextBlock.Italic>");
+					Open = Kind;
+					i += bDouble ? 1 : 0;
+					continue;
+				}
+
+				// Unpaired or inside the other kind of span - literal
+				Out.AppendChar(C);
+				if (bDouble)
+				{
+					Out.AppendChar(C);
+					++i;
+				}
+				continue;
+			}
+
+			if (bEmit)
+			{
+				Out.AppendChar(C);
+			}
+		}
+
+		if (bEmit && (bInHeading || Open != ESpan::None))
+		{
+			Out += TEXT("</>");
+		}
+	}
+}
+
+FString FNeoStackMarkdown::ToRichText(const FString& Markdown)
+{
+	int32 BoldMarkers = 0;
+	int32 ItalicMarkers = 0;
+	FString Out;
+	ScanInline(Markdown, false, BoldMarkers, ItalicMarkers, Out);
+
+	// Only complete pairs become spans
+	BoldMarkers -= BoldMarkers % 2;
+	ItalicMarkers -= ItalicMarkers % 2;
+
+	Out.Reserve(Markdown.Len() + Markdown.Len() / 8 + 16);
+	ScanInline(Markdown, true, BoldMarkers, ItalicMarkers, Out);
+	return Out;
+}
+
+bool FNeoStackMarkdown::IsFenceLine(const TCHAR* Line, int32 Len)
+{
+	int32 i = 0;
+	while (i < Len && (Line[i] == TEXT(' ') || Line[i] == TEXT('\t')))
+	{
+		++i;
+	}
+	return i + 3 <= Len && Line[i] == TEXT('`') && Line[i + 1] == TEXT('`') && Line[i + 2] == TEXT('`');
+}
+
+FString FNeoStackMarkdown::StripCodeFence(const FString& CodeBlock)
+{
+	int32 Begin = 0;
+	int32 End = CodeBlock.Len();
+
+	// Opening fence line (with optional language tag)
+	const int32 FirstNewline = CodeBlock.Find(TEXT("\n"));
+	if (FirstNewline != INDEX_NONE && IsFenceLine(*CodeBlock, FirstNewline))
+	{
+		Begin = FirstNewline + 1;
+	}
+
+	// Closing fence line
+	while (End > Begin && (CodeBlock[End - 1] == TEXT('\n') || CodeBlock[End - 1] == TEXT('\r')))
+	{
+		--End;
+	}
+	int32 LastLineStart = End;
+	while (LastLineStart > Begin && CodeBlock[LastLineStart - 1] != TEXT('\n'))
+	{
+		--LastLineStart;
+	}
+	if (IsFenceLine(*CodeBlock + LastLineStart, End - LastLineStart))
+	{
+		End = LastLineStart > Begin ? LastLineStart - 1 : Begin;
+	}
+
+	return CodeBlock.Mid(Begin, End - Begin);
+}
+
+void FNeoStackMarkdownStream::Append(const FString& Delta, TArray<FBlock>& OutFinished)
+{
+	Pending += Delta;
+
+	for (; ScanPos < Pending.Len(); ++ScanPos)
+	{
+		if (Pending[ScanPos] != TEXT('\n'))
+		{
+			continue;
+		}
+
+		const TCHAR* Line = *Pending + LineStart;
+		int32 LineLen = ScanPos - LineStart;
+		if (LineLen > 0 && Line[LineLen - 1] == TEXT('\r'))
+		{
+			--LineLen;
+		}
+
+		const bool bFence = FNeoStackMarkdown::IsFenceLine(Line, LineLen);
+		int32 NextLineStart = ScanPos + 1;
+
+		if (bInCodeBlock)
+		{
+			if (bFence)
+			{
+				// Closing fence - the code block is done
+				bInCodeBlock = false;
+				FinishBlock(NextLineStart, true, OutFinished);
+				ScanPos = -1;
+				LineStart = 0;
+				continue;
+			}
+		}
+		else if (bFence)
+		{
+			// Whatever came before the fence is a finished paragraph; the fence line starts the code block
+			if (LineStart > 0)
+			{
+				const int32 Removed = LineStart;
+				FinishBlock(Removed, false, OutFinished);
+				ScanPos -= Removed;
+				NextLineStart -= Removed;
+			}
+			bInCodeBlock = true;
+		}
+		else
+		{
+			bool bBlank = true;
+			for (int32 i = 0; i < LineLen && bBlank; ++i)
+			{
+				bBlank = Line[i] == TEXT(' ') || Line[i] == TEXT('\t');
+			}
+
+			if (bBlank)
+			{
+				FinishBlock(NextLineStart, false, OutFinished);
+				ScanPos = -1;
+				LineStart = 0;
+				continue;
+			}
+		}
+
+		LineStart = NextLineStart;
+	}
+}
+
+void FNeoStackMarkdownStream::FinishBlock(int32 End, bool bCode, TArray<FBlock>& OutFinished)
+{
+	FString Text = Pending.Left(End);
+	Pending.RightChopInline(End, false);
+
+	if (!bCode)
+	{
+		Text.TrimEndInline();
+		if (Text.TrimStart().IsEmpty())
+		{
+			return;
+		}
+	}
+
+	FBlock& Block = OutFinished.AddDefaulted_GetRef();
+	Block.Text = bCode ? FNeoStackMarkdown::StripCodeFence(Text) : MoveTemp(Text);
+	Block.bCode = bCode;
+}
+
+void FNeoStackMarkdownStream::Reset()
+{
+	Pending.Reset();
+	LineStart = 0;
+	ScanPos = 0;
+	bInCodeBlock = false;
+}
@@ -27,7 +27,6 @@ void SCollapsibleToolWidget::Construct(const FArguments& InArgs)
 	CallID = InArgs._CallID;
 	OnApprovedDelegate = InArgs._OnApproved;
 	OnRejectedDelegate = InArgs._OnRejected;
-	bIsExpanded = true;
 
 	// Check if this tool is always allowed
 	bool bRequiresApproval = InArgs._RequiresApproval;
@@ -43,6 +42,9 @@ void SCollapsibleToolWidget::Construct(const FArguments& InArgs)
 		ExecutionState = bRequiresApproval ? EToolExecutionState::PendingApproval : EToolExecutionState::Executing;
 	}
 
+	// Only a tool waiting for approval needs its details open; everything else starts as a header
+	bIsExpanded = ExecutionState == EToolExecutionState::PendingApproval;
+
 	TSharedPtr<SVerticalBox> MainContainer;
 
 	ChildSlot
@@ -117,7 +119,7 @@ void SCollapsibleToolWidget::Construct(const FArguments& InArgs)
 		SAssignNew(DetailsContainer, SBorder)
 		.BorderImage(new FSlateColorBrush(FLinearColor::FromSRGBColor(FColor::FromHex(TEXT("#0f0f11")))))
 		.Padding(12.0f, 8.0f, 12.0f, 12.0f)
-		.Visibility(EVisibility::Visible)
+		.Visibility(bIsExpanded ? EVisibility::Visible : EVisibility::Collapsed)
 		[
 			SAssignNew(DetailsBox, SVerticalBox)
 			// Arguments section
@@ -205,45 +207,141 @@ void SCollapsibleToolWidget::SetResult(const FString& InResult, bool bSuccess)
 	bResultSet = true;
 
 	Result = InResult;
+	bResultSuccess = bSuccess;
 	ExecutionState = bSuccess ? EToolExecutionState::Completed : EToolExecutionState::Failed;
 
-	// Add result section to the details box
-	if (DetailsBox.IsValid())
+	// Approval is done - fold back to the header. The result is only turned into widgets when opened
+	bIsExpanded = false;
+	if (DetailsContainer.IsValid())
+	{
+		DetailsContainer->SetVisibility(EVisibility::Collapsed);
+	}
+}
+
+void SCollapsibleToolWidget::BuildResultSection()
+{
+	if (bResultBuilt || !DetailsBox.IsValid())
 	{
-		FLinearColor ResultColor = bSuccess
-			? FLinearColor::FromSRGBColor(FColor::FromHex(TEXT("#10b981")))  // Green
-			: FLinearColor::FromSRGBColor(FColor::FromHex(TEXT("#ef4444"))); // Red
+		return;
+	}
+	bResultBuilt = true;
 
-		DetailsBox->AddSlot()
-		.AutoHeight()
-		.Padding(0.0f, 12.0f, 0.0f, 0.0f)
+	ResultTotalLines = 1;
+	for (const TCHAR C : Result)
+	{
+		ResultTotalLines += C == TEXT('\n') ? 1 : 0;
+	}
+
+	DetailsBox->AddSlot()
+	.AutoHeight()
+	.Padding(0.0f, 12.0f, 0.0f, 0.0f)
+	[
+		SNew(SBorder)
+		.BorderImage(new FSlateColorBrush(FLinearColor::FromSRGBColor(FColor::FromHex(TEXT("#0a0a0c")))))
+		.Padding(8.0f, 6.0f)
 		[
-			SNew(SBorder)
-			.BorderImage(new FSlateColorBrush(FLinearColor::FromSRGBColor(FColor::FromHex(TEXT("#0a0a0c")))))
-			.Padding(8.0f, 6.0f)
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
 			[
-				SNew(SVerticalBox)
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				[
-					SNew(STextBlock)
-					.Text(FText::FromString(bSuccess ? TEXT("Result") : TEXT("Error")))
-					.Font(FCoreStyle::GetDefaultFontStyle("Regular", 8))
-					.ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f))
-				]
-				+ SVerticalBox::Slot()
-				.AutoHeight()
-				.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+				SNew(STextBlock)
+				.Text(FText::FromString(bResultSuccess ? TEXT("Result") : TEXT("Error")))
+				.Font(FCoreStyle::GetDefaultFontStyle("Regular", 8))
+				.ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f))
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+			[
+				SAssignNew(ResultChunksBox, SVerticalBox)
+			]
+			// Load more
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.HAlign(HAlign_Left)
+			.Padding(0.0f, 6.0f, 0.0f, 0.0f)
+			[
+				SNew(SButton)
+				.ButtonStyle(FCoreStyle::Get(), "NoBorder")
+				.Visibility(this, &SCollapsibleToolWidget::GetShowMoreVisibility)
+				.OnClicked(this, &SCollapsibleToolWidget::OnShowMoreClicked)
 				[
 					SNew(STextBlock)
-					.Text(FText::FromString(Result))
-					.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
-					.ColorAndOpacity(ResultColor)
-					.AutoWrapText(true)
+					.Text(this, &SCollapsibleToolWidget::GetShowMoreText)
+					.Font(FCoreStyle::GetDefaultFontStyle("Italic", 8))
+					.ColorAndOpacity(FLinearColor::FromSRGBColor(FColor::FromHex(TEXT("#3b82f6"))))
 				]
 			]
-		];
+		]
+	];
+
+	AppendResultChunk();
+}
+
+void SCollapsibleToolWidget::AppendResultChunk()
+{
+	if (!ResultChunksBox.IsValid() || ResultShownChars >= Result.Len())
+	{
+		return;
+	}
+
+	// Next run of whole lines, bounded by both line and character count
+	const int32 Start = ResultShownChars;
+	const int32 MaxEnd = FMath::Min(Result.Len(), Start + ResultChunkChars);
+	int32 End = Start;
+	int32 Lines = 0;
+	while (End < MaxEnd && Lines < ResultChunkLines)
+	{
+		if (Result[End++] == TEXT('\n'))
+		{
+			++Lines;
+		}
+	}
+
+	FString Chunk = Result.Mid(Start, End - Start);
+	if (Chunk.EndsWith(TEXT("\n")))
+	{
+		Chunk.LeftChopInline(1, false);
 	}
+	else
+	{
+		// Cut inside a line (or reached the end)
+		++Lines;
+	}
+
+	ResultShownChars = End;
+	ResultShownLines = FMath::Min(ResultTotalLines, ResultShownLines + Lines);
+
+	const FLinearColor ResultColor = bResultSuccess
+		? FLinearColor::FromSRGBColor(FColor::FromHex(TEXT("#10b981")))  // Green
+		: FLinearColor::FromSRGBColor(FColor::FromHex(TEXT("#ef4444"))); // Red
+
+	ResultChunksBox->AddSlot()
+	.AutoHeight()
+	[
+		SNew(STextBlock)
+		.Text(FText::FromString(MoveTemp(Chunk)))
+		.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
+		.ColorAndOpacity(ResultColor)
+		.AutoWrapText(true)
+	];
+}
+
+FReply SCollapsibleToolWidget::OnShowMoreClicked()
+{
+	AppendResultChunk();
+	return FReply::Handled();
+}
+
+EVisibility SCollapsibleToolWidget::GetShowMoreVisibility() const
+{
+	return ResultShownChars < Result.Len() ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+FText SCollapsibleToolWidget::GetShowMoreText() const
+{
+	const int32 RemainingLines = FMath::Max(1, ResultTotalLines - ResultShownLines);
+	return FText::FromString(FString::Printf(TEXT("Show more (%d more lines)"), RemainingLines));
 }
 
 void SCollapsibleToolWidget::SetExecuting()
@@ -251,10 +349,28 @@ void SCollapsibleToolWidget::SetExecuting()
 	ExecutionState = EToolExecutionState::Executing;
 }
 
+void SCollapsibleToolWidget::SetCached(float SavedMs)
+{
+	bResultCached = true;
+	CachedSavedMs = SavedMs;
+}
+
+void SCollapsibleToolWidget::SetProgress(float Fraction, const FString& Status)
+{
+	ProgressText = Fraction >= 0.0f
+		? FString::Printf(TEXT("%s (%d%%)"), *Status, FMath::RoundToInt32(FMath::Clamp(Fraction, 0.0f, 1.0f) * 100.0f))
+		: Status;
+}
+
 FReply SCollapsibleToolWidget::OnToggleExpand()
 {
 	bIsExpanded = !bIsExpanded;
 
+	if (bIsExpanded && bResultSet)
+	{
+		BuildResultSection();
+	}
+
 	if (DetailsContainer.IsValid())
 	{
 		DetailsContainer->SetVisibility(bIsExpanded ? EVisibility::Visible : EVisibility::Collapsed);
@@ -331,9 +447,11 @@ FText SCollapsibleToolWidget::GetStatusText() const
 		case EToolExecutionState::PendingApproval:
 			return FText::FromString(TEXT("awaiting approval"));
 		case EToolExecutionState::Executing:
-			return FText::FromString(TEXT("executing..."));
+			return FText::FromString(ProgressText.IsEmpty() ? TEXT("executing...") : ProgressText + TEXT("..."));
 		case EToolExecutionState::Completed:
-			return FText::FromString(TEXT("completed"));
+			return bResultCached
+				? FText::FromString(FString::Printf(TEXT("completed (cached, %.0f ms saved)"), CachedSavedMs))
+				: FText::FromString(TEXT("completed"));
 		case EToolExecutionState::Rejected:
 			return FText::FromString(TEXT("rejected"));
 		case EToolExecutionState::Failed:
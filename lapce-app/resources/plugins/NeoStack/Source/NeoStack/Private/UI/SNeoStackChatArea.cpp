@@ -3,13 +3,18 @@
 #include "UI/SNeoStackChatArea.h"
 #include "UI/SCollapsibleToolWidget.h"
 #include "UI/SCollapsibleReasoningWidget.h"
+#include "UI/NeoStackMarkdown.h"
 #include "NeoStackConversation.h"
+#include "NeoStackSettings.h"
+#include "NeoStackAPIClient.h"
+#include "NeoStackStreamRecording.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Text/SRichTextBlock.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/SBoxPanel.h"
+#include "Widgets/SNullWidget.h"
 #include "Widgets/Layout/SSpacer.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Images/SImage.h"
@@ -24,20 +29,28 @@
 #include "IImageWrapperModule.h"
 #include "Misc/Base64.h"
 #include "Engine/Texture2D.h"
+#include "Dom/JsonObject.h"
 
 #define LOCTEXT_NAMESPACE "SNeoStackChatArea"
 
+const FString SNeoStackChatArea::DefaultStreamID;
+
+TWeakPtr<SNeoStackChatArea> SNeoStackChatArea::Instance;
+
 void SNeoStackChatArea::Construct(const FArguments& InArgs)
 {
-	bInAssistantMessage = false;
+	Instance = SharedThis(this);
+
 	OnToolApprovedDelegate = InArgs._OnToolApproved;
 	OnToolRejectedDelegate = InArgs._OnToolRejected;
+	OnLoadOlderMessagesDelegate = InArgs._OnLoadOlderMessages;
 
 	ChildSlot
 	[
 		SAssignNew(MessageScrollBox, SScrollBox)
+		.OnUserScrolled(this, &SNeoStackChatArea::OnMessagesScrolled)
 		+ SScrollBox::Slot()
-		.Padding(16.0f)
+		.Padding(MessageListPadding)
 		[
 			SAssignNew(MessageContainer, SVerticalBox)
 		]
@@ -54,190 +67,162 @@ void SNeoStackChatArea::AddUserMessageWithImages(const FString& Message, const T
 	if (!MessageContainer.IsValid())
 		return;
 
-	MessageContainer->AddSlot()
-		.AutoHeight()
-		.Padding(0.0f, 0.0f, 0.0f, 16.0f)
-		[
-			CreateUserMessageWidget(Message, Images)
-		];
+	AddMessageItem(CreateUserMessageWidget(Message, Images));
 
 	ScrollToBottom();
 }
 
 void SNeoStackChatArea::StartAssistantMessage(const FString& AgentName, const FString& ModelName)
+{
+	StartAssistantStream(DefaultStreamID, AgentName, ModelName);
+}
+
+void SNeoStackChatArea::AppendContent(const FString& Content)
+{
+	AppendStreamContent(DefaultStreamID, Content);
+}
+
+void SNeoStackChatArea::AppendReasoning(const FString& Reasoning)
+{
+	AppendStreamReasoning(DefaultStreamID, Reasoning);
+}
+
+void SNeoStackChatArea::AppendToolCall(const FString& ToolName, const FString& Args, const FString& CallID)
+{
+	AppendStreamToolCall(DefaultStreamID, ToolName, Args, CallID);
+}
+
+void SNeoStackChatArea::AppendUE5ToolCall(const FString& SessionID, const FString& ToolName, const FString& Args, const FString& CallID)
+{
+	AppendStreamUE5ToolCall(DefaultStreamID, SessionID, ToolName, Args, CallID);
+}
+
+void SNeoStackChatArea::CompleteAssistantMessage()
+{
+	CompleteAssistantStream(DefaultStreamID);
+}
+
+void SNeoStackChatArea::StartAssistantStream(const FString& StreamID, const FString& AgentName, const FString& ModelName)
 {
 	if (!MessageContainer.IsValid())
 		return;
 
-	CurrentAgentName = AgentName;
-	CurrentModelName = ModelName;
-	bInAssistantMessage = true;
-	CurrentStreamingContent = TEXT("");
-	CurrentStreamingTextBlock.Reset();
-	CurrentStreamingReasoning = TEXT("");
-	CurrentStreamingReasoningWidget.Reset();
+	// Starting a stream with an ID that is still open replaces it
+	if (FAssistantStreamState* Previous = ActiveStreams.Find(StreamID))
+	{
+		if (Previous->Item.IsValid())
+		{
+			Previous->Item->bPinned = false;
+		}
+	}
+	FAssistantStreamState& State = ActiveStreams.Add(StreamID);
+	State.AgentName = AgentName;
+	State.ModelName = ModelName;
 
 	// Create a new vertical box for this assistant message
 	TSharedPtr<SVerticalBox> AssistantMessageBox;
 
-	MessageContainer->AddSlot()
+	State.Item = AddMessageItem(
+		SNew(SVerticalBox)
+		// Header
+		+ SVerticalBox::Slot()
 		.AutoHeight()
-		.Padding(0.0f, 0.0f, 0.0f, 16.0f)
 		[
-			SNew(SVerticalBox)
-			// Header
-			+ SVerticalBox::Slot()
-			.AutoHeight()
-			[
-				CreateAssistantHeaderWidget(AgentName, ModelName)
-			]
-			// Content container
-			+ SVerticalBox::Slot()
-			.AutoHeight()
-			[
-				SAssignNew(AssistantMessageBox, SVerticalBox)
-			]
-		];
+			CreateAssistantHeaderWidget(AgentName, ModelName)
+		]
+		// Content container
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		[
+			SAssignNew(AssistantMessageBox, SVerticalBox)
+		]
+	);
 
-	CurrentAssistantContainer = AssistantMessageBox;
+	// A message that is still receiving content always stays realized
+	State.Item->bPinned = true;
+	State.Container = AssistantMessageBox;
 	ScrollToBottom();
 }
 
-void SNeoStackChatArea::AppendContent(const FString& Content)
+void SNeoStackChatArea::AppendStreamContent(const FString& StreamID, const FString& Content)
 {
-	if (!CurrentAssistantContainer.IsValid() || !bInAssistantMessage)
+	FAssistantStreamState* State = ActiveStreams.Find(StreamID);
+	if (!State || !State->Container.IsValid())
 		return;
 
 	// Finalize any streaming reasoning before adding content
-	CurrentStreamingReasoningWidget.Reset();
-	CurrentStreamingReasoning.Empty();
-
-	// Accumulate content for streaming
-	CurrentStreamingContent += Content;
+	State->StreamingReasoningWidget.Reset();
+	State->StreamingReasoning.Empty();
 
-	// If we don't have a streaming text block yet, create one
-	if (!CurrentStreamingTextBlock.IsValid())
-	{
-		CurrentAssistantContainer->AddSlot()
-			.AutoHeight()
-			.Padding(0.0f, 4.0f, 0.0f, 0.0f)
-			[
-				SAssignNew(CurrentStreamingTextBlock, SRichTextBlock)
-				.TextStyle(FCoreStyle::Get(), "NormalText")
-				.DecoratorStyleSet(&FCoreStyle::Get())
-				.AutoWrapText(true)
-			];
-	}
+	// Blocks completed by this delta are rendered once and never touched again
+	TArray<FNeoStackMarkdownStream::FBlock> Finished;
+	State->Markdown.Append(Content, Finished);
 
-	// Convert accumulated markdown to rich text and update
-	if (CurrentStreamingTextBlock.IsValid())
+	if (Finished.Num() > 0)
 	{
-		FString RichText = CurrentStreamingContent;
-
-		// 1) Handle headings (line-based)
-		TArray<FString> Lines;
-		RichText.ParseIntoArrayLines(Lines, /*bCullEmpty*/ false);
-
-		for (FString& Line : Lines)
+		// The live block becomes final (possibly as a code block), so its widget is replaced
+		if (State->StreamingTextBlock.IsValid())
 		{
-			if (Line.StartsWith(TEXT("## ")))
-			{
-				const FString LineContent = Line.RightChop(3);
-				Line = FString::Printf(TEXT("<RichTextBlock.Bold>%s</>"), *LineContent);
-			}
-			else if (Line.StartsWith(TEXT("# ")))
-			{
-				const FString LineContent = Line.RightChop(2);
-				Line = FString::Printf(TEXT("<Credits.H2>%s</>"), *LineContent);
-			}
+			State->Container->RemoveSlot(State->StreamingTextBlock.ToSharedRef());
+			State->StreamingTextBlock.Reset();
 		}
 
-		RichText = FString::Join(Lines, TEXT("\n"));
-
-		// 2) Handle **bold**
-		while (true)
+		for (const FNeoStackMarkdownStream::FBlock& Block : Finished)
 		{
-			int32 StartPos = RichText.Find(TEXT("**"));
-			if (StartPos == INDEX_NONE) break;
-
-			int32 EndPos = RichText.Find(TEXT("**"), ESearchCase::CaseSensitive, ESearchDir::FromStart, StartPos + 2);
-			if (EndPos == INDEX_NONE) break;
-
-			FString BoldText = RichText.Mid(StartPos + 2, EndPos - StartPos - 2);
-			FString Replacement = FString::Printf(TEXT("<RichTextBlock.Bold>%s</>"), *BoldText);
-
-			RichText = RichText.Left(StartPos) + Replacement + RichText.Mid(EndPos + 2);
+			State->Container->AddSlot()
+				.AutoHeight()
+				.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+				[
+					Block.bCode ? CreateCodeBlockWidget(Block.Text) : CreateContentWidget(Block.Text)
+				];
 		}
+	}
 
-		// 3) Handle *italic*
-		int32 SearchPos = 0;
-		while (SearchPos < RichText.Len())
+	// Only the open trailing block is converted again
+	const FString& OpenBlock = State->Markdown.GetOpenBlock();
+	if (!OpenBlock.IsEmpty())
+	{
+		if (!State->StreamingTextBlock.IsValid())
 		{
-			int32 StartPos = RichText.Find(TEXT("*"), ESearchCase::CaseSensitive, ESearchDir::FromStart, SearchPos);
-			if (StartPos == INDEX_NONE) break;
-
-			if (StartPos > 0 && RichText[StartPos - 1] == '*')
-			{
-				SearchPos = StartPos + 1;
-				continue;
-			}
-			if (StartPos + 1 < RichText.Len() && RichText[StartPos + 1] == '*')
-			{
-				SearchPos = StartPos + 2;
-				continue;
-			}
-
-			int32 EndPos = StartPos + 1;
-			while (EndPos < RichText.Len())
-			{
-				if (RichText[EndPos] == '*' && (EndPos + 1 >= RichText.Len() || RichText[EndPos + 1] != '*'))
-				{
-					break;
-				}
-				EndPos++;
-			}
-
-			if (EndPos < RichText.Len())
-			{
-				FString ItalicText = RichText.Mid(StartPos + 1, EndPos - StartPos - 1);
-				FString Replacement = FString::Printf(TEXT("<RichTextBlock.Italic>%s</>"), *ItalicText);
-
-				RichText = RichText.Left(StartPos) + Replacement + RichText.Mid(EndPos + 1);
-				SearchPos = StartPos + Replacement.Len();
-			}
-			else
-			{
-				break;
-			}
+			State->Container->AddSlot()
+				.AutoHeight()
+				.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+				[
+					SAssignNew(State->StreamingTextBlock, SRichTextBlock)
+					.TextStyle(FCoreStyle::Get(), "NormalText")
+					.DecoratorStyleSet(&FCoreStyle::Get())
+					.AutoWrapText(true)
+				];
 		}
 
-		// Remove backticks
-		RichText.ReplaceInline(TEXT("`"), TEXT(""));
-
-		CurrentStreamingTextBlock->SetText(FText::FromString(RichText));
+		// An unfinished code block is shown as-is; markdown inside code is not markup
+		State->StreamingTextBlock->SetText(FText::FromString(State->Markdown.IsInCodeBlock()
+			? FNeoStackMarkdown::StripCodeFence(OpenBlock)
+			: FNeoStackMarkdown::ToRichText(OpenBlock)));
 	}
 
 	ScrollToBottom();
 }
 
-void SNeoStackChatArea::AppendReasoning(const FString& Reasoning)
+void SNeoStackChatArea::AppendStreamReasoning(const FString& StreamID, const FString& Reasoning)
 {
-	if (!CurrentAssistantContainer.IsValid() || !bInAssistantMessage)
+	FAssistantStreamState* State = ActiveStreams.Find(StreamID);
+	if (!State || !State->Container.IsValid())
 		return;
 
 	// Finalize any streaming content before adding reasoning
-	CurrentStreamingTextBlock.Reset();
-	CurrentStreamingContent.Empty();
+	State->StreamingTextBlock.Reset();
+	State->Markdown.Reset();
 
 	// Accumulate reasoning for streaming
-	CurrentStreamingReasoning += Reasoning;
+	State->StreamingReasoning += Reasoning;
 
 	// If we don't have a streaming reasoning widget yet, create one
-	if (!CurrentStreamingReasoningWidget.IsValid())
+	if (!State->StreamingReasoningWidget.IsValid())
 	{
 		TSharedPtr<SCollapsibleReasoningWidget> ReasoningWidget;
 
-		CurrentAssistantContainer->AddSlot()
+		State->Container->AddSlot()
 			.AutoHeight()
 			.Padding(0.0f, 4.0f, 0.0f, 0.0f)
 			[
@@ -245,36 +230,41 @@ void SNeoStackChatArea::AppendReasoning(const FString& Reasoning)
 				.Reasoning(TEXT(""))
 			];
 
-		CurrentStreamingReasoningWidget = ReasoningWidget;
+		State->StreamingReasoningWidget = ReasoningWidget;
 	}
 
 	// Update the reasoning widget with accumulated text
-	if (CurrentStreamingReasoningWidget.IsValid())
+	if (State->StreamingReasoningWidget.IsValid())
 	{
-		CurrentStreamingReasoningWidget->UpdateReasoning(CurrentStreamingReasoning);
+		State->StreamingReasoningWidget->UpdateReasoning(State->StreamingReasoning);
 	}
 
 	ScrollToBottom();
 }
 
-void SNeoStackChatArea::AppendToolCall(const FString& ToolName, const FString& Args, const FString& CallID)
+void SNeoStackChatArea::AppendStreamToolCall(const FString& StreamID, const FString& ToolName, const FString& Args, const FString& CallID)
 {
 	// Backend tools don't require approval - just show them
-	AppendUE5ToolCall(TEXT(""), ToolName, Args, CallID);
+	AppendStreamUE5ToolCall(StreamID, TEXT(""), ToolName, Args, CallID);
 }
 
-void SNeoStackChatArea::AppendUE5ToolCall(const FString& SessionID, const FString& ToolName, const FString& Args, const FString& CallID)
+void SNeoStackChatArea::AppendStreamUE5ToolCall(const FString& StreamID, const FString& SessionID, const FString& ToolName, const FString& Args, const FString& CallID,
+	const TSharedPtr<FJsonObject>& ArgsObject)
 {
-	if (!CurrentAssistantContainer.IsValid() || !bInAssistantMessage)
+	// Text that arrived before the tool call has to be on screen before it
+	FlushStream(StreamID);
+
+	FAssistantStreamState* State = ActiveStreams.Find(StreamID);
+	if (!State || !State->Container.IsValid())
 		return;
 
 	// Finalize any streaming content before adding tool call
-	CurrentStreamingTextBlock.Reset();
-	CurrentStreamingContent.Empty();
+	State->StreamingTextBlock.Reset();
+	State->Markdown.Reset();
 
 	// Finalize any streaming reasoning before adding tool call
-	CurrentStreamingReasoningWidget.Reset();
-	CurrentStreamingReasoning.Empty();
+	State->StreamingReasoningWidget.Reset();
+	State->StreamingReasoning.Empty();
 
 	// Store session ID for this tool call (needed for result submission)
 	if (!SessionID.IsEmpty())
@@ -282,7 +272,12 @@ void SNeoStackChatArea::AppendUE5ToolCall(const FString& SessionID, const FStrin
 		ToolSessionIDs.Add(CallID, SessionID);
 	}
 
-	CurrentAssistantContainer->AddSlot()
+	if (ArgsObject.IsValid())
+	{
+		ToolArgsObjects.Add(CallID, ArgsObject);
+	}
+
+	State->Container->AddSlot()
 		.AutoHeight()
 		.Padding(0.0f, 4.0f, 0.0f, 0.0f)
 		[
@@ -295,7 +290,7 @@ void SNeoStackChatArea::AppendUE5ToolCall(const FString& SessionID, const FStrin
 void SNeoStackChatArea::AppendToolResult(const FString& CallID, const FString& Result)
 {
 	// Find the tool widget by CallID and update it with the result
-	// Note: Don't check bInAssistantMessage here - we need to update tool widgets
+	// Note: Don't check for an active stream here - we need to update tool widgets
 	// even when loading historical conversations where CompleteAssistantMessage was already called
 	TSharedPtr<SCollapsibleToolWidget>* ToolWidgetPtr = ToolWidgets.Find(CallID);
 	if (ToolWidgetPtr && ToolWidgetPtr->IsValid())
@@ -306,14 +301,163 @@ void SNeoStackChatArea::AppendToolResult(const FString& CallID, const FString& R
 	ScrollToBottom();
 }
 
-void SNeoStackChatArea::CompleteAssistantMessage()
+void SNeoStackChatArea::CompleteAssistantStream(const FString& StreamID)
+{
+	FlushStream(StreamID);
+
+	FAssistantStreamState State;
+	if (ActiveStreams.RemoveAndCopyValue(StreamID, State) && State.Item.IsValid())
+	{
+		State.Item->bPinned = false;
+	}
+}
+
+void SNeoStackChatArea::ReplayRecording(const TSharedRef<const FNeoStackStreamRecording>& Recording, float Speed)
+{
+	const FString StreamID = FGuid::NewGuid().ToString();
+	StartAssistantStream(StreamID, TEXT("Replay"), FString::Printf(TEXT("%d chunks"), Recording->Chunks.Num()));
+
+	TWeakPtr<SNeoStackChatArea> WeakChatArea = SharedThis(this);
+	FNeoStackStreamCallbacks Callbacks;
+	Callbacks.OnContent.BindLambda([WeakChatArea, StreamID](const FString& Content)
+	{
+		if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
+		{
+			ChatArea->QueueStreamContent(StreamID, Content);
+		}
+	});
+	Callbacks.OnReasoning.BindLambda([WeakChatArea, StreamID](const FString& Reasoning)
+	{
+		if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
+		{
+			ChatArea->QueueStreamReasoning(StreamID, Reasoning);
+		}
+	});
+	Callbacks.OnToolCall.BindLambda([WeakChatArea, StreamID](const FString& ToolName, const FString& Args, const FString& CallID)
+	{
+		if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
+		{
+			ChatArea->AppendStreamToolCall(StreamID, ToolName, Args, CallID);
+		}
+	});
+	// Shown like a backend tool so there is nothing to approve: a replay has no session to answer
+	Callbacks.OnUE5ToolCall.BindLambda([WeakChatArea, StreamID](const FString&, const FString& ToolName, const FString& Args, const TSharedPtr<FJsonObject>&, const FString& CallID)
+	{
+		if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
+		{
+			ChatArea->AppendStreamToolCall(StreamID, ToolName, Args, CallID);
+		}
+	});
+	Callbacks.OnToolResult.BindLambda([WeakChatArea](const FString& CallID, const FString& Result)
+	{
+		if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
+		{
+			ChatArea->AppendToolResult(CallID, Result);
+		}
+	});
+	Callbacks.OnComplete.BindLambda([WeakChatArea, StreamID]()
+	{
+		if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
+		{
+			ChatArea->CompleteAssistantStream(StreamID);
+		}
+	});
+
+	TSharedRef<FNeoStackStreamSession> Session = FNeoStackAPIClient::ReplayRecording(Recording, Speed, Callbacks);
+	if (!Session->IsActive())
+	{
+		// Decoded at once; a recording cut off before its "final" event still ends its message
+		CompleteAssistantStream(StreamID);
+	}
+}
+
+void SNeoStackChatArea::QueueStreamContent(const FString& StreamID, const FString& Content)
+{
+	QueueStreamDelta(StreamID, Content, false);
+}
+
+void SNeoStackChatArea::QueueStreamReasoning(const FString& StreamID, const FString& Reasoning)
+{
+	QueueStreamDelta(StreamID, Reasoning, true);
+}
+
+void SNeoStackChatArea::QueueStreamDelta(const FString& StreamID, const FString& Text, bool bReasoning)
 {
-	bInAssistantMessage = false;
-	CurrentAssistantContainer.Reset();
-	CurrentStreamingTextBlock.Reset();
-	CurrentStreamingContent.Empty();
-	CurrentStreamingReasoningWidget.Reset();
-	CurrentStreamingReasoning.Empty();
+	if (Text.IsEmpty())
+	{
+		return;
+	}
+
+	// Consecutive deltas of the same kind are merged into one update
+	TArray<FPendingDelta>& Deltas = PendingDeltas.FindOrAdd(StreamID);
+	if (Deltas.Num() > 0 && Deltas.Last().bReasoning == bReasoning)
+	{
+		Deltas.Last().Text += Text;
+	}
+	else
+	{
+		FPendingDelta& Delta = Deltas.AddDefaulted_GetRef();
+		Delta.bReasoning = bReasoning;
+		Delta.Text = Text;
+	}
+
+	if (!FlushTimerHandle.IsValid())
+	{
+		FlushTimerHandle = RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &SNeoStackChatArea::OnFlushPendingDeltas));
+	}
+}
+
+void SNeoStackChatArea::FlushStream(const FString& StreamID)
+{
+	TArray<FPendingDelta> Deltas;
+	if (!PendingDeltas.RemoveAndCopyValue(StreamID, Deltas))
+	{
+		return;
+	}
+
+	for (const FPendingDelta& Delta : Deltas)
+	{
+		if (Delta.bReasoning)
+		{
+			AppendStreamReasoning(StreamID, Delta.Text);
+		}
+		else
+		{
+			AppendStreamContent(StreamID, Delta.Text);
+		}
+	}
+}
+
+EActiveTimerReturnType SNeoStackChatArea::OnFlushPendingDeltas(double InCurrentTime, float InDeltaTime)
+{
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	const double Budget = (Settings ? Settings->StreamUpdateBudgetMs : 4.0f) / 1000.0;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// One stream at a time; streams left over when the budget runs out go first next frame
+	while (PendingDeltas.Num() > 0)
+	{
+		FString StreamID;
+		for (const TPair<FString, TArray<FPendingDelta>>& Pending : PendingDeltas)
+		{
+			StreamID = Pending.Key;
+			break;
+		}
+		FlushStream(StreamID);
+
+		if (FPlatformTime::Seconds() - StartTime >= Budget)
+		{
+			break;
+		}
+	}
+
+	if (PendingDeltas.Num() > 0)
+	{
+		return EActiveTimerReturnType::Continue;
+	}
+
+	FlushTimerHandle.Reset();
+	return EActiveTimerReturnType::Stop;
 }
 
 void SNeoStackChatArea::ClearMessages()
@@ -322,15 +466,15 @@ void SNeoStackChatArea::ClearMessages()
 	{
 		MessageContainer->ClearChildren();
 	}
-	bInAssistantMessage = false;
-	CurrentAssistantContainer.Reset();
-	CurrentStreamingTextBlock.Reset();
-	CurrentStreamingContent.Empty();
-	CurrentStreamingReasoningWidget.Reset();
-	CurrentStreamingReasoning.Empty();
+	MessageItems.Empty();
+	PrependItems.Empty();
+	bPrepending = false;
+	ActiveStreams.Empty();
+	PendingDeltas.Empty();
 	ToolWidgets.Empty();
 	PendingToolCalls.Empty();
 	ToolSessionIDs.Empty();
+	ToolArgsObjects.Empty();
 	// Clear persistent image storage
 	ImageBrushes.Empty();
 	ImageTextures.Empty();
@@ -348,6 +492,12 @@ FString SNeoStackChatArea::GetSessionIDForTool(const FString& CallID) const
 	return SessionIDPtr ? *SessionIDPtr : FString();
 }
 
+TSharedPtr<FJsonObject> SNeoStackChatArea::GetToolArgsObject(const FString& CallID) const
+{
+	const TSharedPtr<FJsonObject>* ArgsPtr = ToolArgsObjects.Find(CallID);
+	return ArgsPtr ? *ArgsPtr : nullptr;
+}
+
 TSharedRef<SWidget> SNeoStackChatArea::CreateUserMessageWidget(const FString& Message, const TArray<FConversationImage>& Images)
 {
 	TSharedRef<SVerticalBox> UserMessageBox = SNew(SVerticalBox)
@@ -527,6 +677,15 @@ TSharedRef<SWidget> SNeoStackChatArea::CreateToolCallWidget(const FString& ToolN
 
 TSharedRef<SWidget> SNeoStackChatArea::CreateToolResultWidget(const FString& Result)
 {
+	// Inline results are previews; the full text lives in the tool widget's paged view
+	FString Preview = Result;
+	if (Preview.Len() > SCollapsibleToolWidget::ResultChunkChars)
+	{
+		const int32 Omitted = Preview.Len() - SCollapsibleToolWidget::ResultChunkChars;
+		Preview.LeftInline(SCollapsibleToolWidget::ResultChunkChars, false);
+		Preview += FString::Printf(TEXT("\n... (%d more characters)"), Omitted);
+	}
+
 	return SNew(SBorder)
 		.BorderImage(new FSlateColorBrush(FLinearColor::FromSRGBColor(FColor::FromHex(TEXT("#0f0f11")))))
 		.Padding(10.0f, 8.0f)
@@ -561,7 +720,7 @@ TSharedRef<SWidget> SNeoStackChatArea::CreateToolResultWidget(const FString& Res
 			.VAlign(VAlign_Center)
 			[
 				SNew(STextBlock)
-				.Text(FText::FromString(Result))
+				.Text(FText::FromString(Preview))
 				.Font(FCoreStyle::GetDefaultFontStyle("Regular", 9))
 				.ColorAndOpacity(FLinearColor(0.85f, 0.85f, 0.85f, 1.0f))
 				.AutoWrapText(true)
@@ -571,111 +730,188 @@ TSharedRef<SWidget> SNeoStackChatArea::CreateToolResultWidget(const FString& Res
 
 TSharedRef<SWidget> SNeoStackChatArea::CreateMarkdownWidget(const FString& Text, const FSlateFontInfo& Font, const FLinearColor& Color)
 {
-	// Convert markdown to Slate's rich text format
-	// # Heading -> <Credits.H2>Heading</>
-	// ## Heading -> <RichTextBlock.Bold>Heading</>
-	// **bold** -> <RichTextBlock.Bold>bold</>
-	// *italic* -> <RichTextBlock.Italic>italic</>
-	// `code` -> plain text for now (rich text doesn't support inline code well)
+	return SNew(SRichTextBlock)
+		.Text(FText::FromString(FNeoStackMarkdown::ToRichText(Text)))
+		.TextStyle(FCoreStyle::Get(), "NormalText")
+		.DecoratorStyleSet(&FCoreStyle::Get())
+		.AutoWrapText(true);
+}
+
+TSharedRef<SWidget> SNeoStackChatArea::CreateCodeBlockWidget(const FString& Code)
+{
+	static const FSlateColorBrush CodeBlockBrush(FLinearColor::FromSRGBColor(FColor::FromHex(TEXT("#0f0f11"))));
 
-	FString RichText = Text;
+	return SNew(SBorder)
+		.BorderImage(&CodeBlockBrush)
+		.Padding(FMargin(8.0f, 6.0f))
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Code))
+			.Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+			.ColorAndOpacity(FLinearColor(0.85f, 0.85f, 0.85f, 1.0f))
+			.AutoWrapText(true)
+		];
+}
 
-	// 1) FIRST handle headings (line-based) - must be done before inline formatting
-	TArray<FString> Lines;
-	RichText.ParseIntoArrayLines(Lines, /*bCullEmpty*/ false);
+void SNeoStackChatArea::BeginPrepend()
+{
+	bPrepending = true;
+	PrependItems.Reset();
+}
 
-	for (FString& Line : Lines)
+void SNeoStackChatArea::EndPrepend()
+{
+	if (!bPrepending)
 	{
-		// Check for ## first (more specific)
-		if (Line.StartsWith(TEXT("## ")))
-		{
-			const FString Content = Line.RightChop(3); // strip "## "
-			Line = FString::Printf(TEXT("<RichTextBlock.Bold>%s</>"), *Content);
-		}
-		else if (Line.StartsWith(TEXT("# ")))
+		return;
+	}
+	bPrepending = false;
+
+	TArray<TSharedPtr<FChatMessageItem>> Prepended = MoveTemp(PrependItems);
+	PrependItems.Reset();
+
+	if (!MessageContainer.IsValid() || !MessageScrollBox.IsValid() || Prepended.Num() == 0)
+	{
+		return;
+	}
+
+	// Keep the messages the user is looking at in place once the older ones above them are laid out
+	const float DistanceFromEnd = MessageScrollBox->GetScrollOffsetOfEnd() - MessageScrollBox->GetScrollOffset();
+
+	for (int32 i = 0; i < Prepended.Num(); ++i)
+	{
+		MessageContainer->InsertSlot(i)
+			.AutoHeight()
+			[
+				Prepended[i]->Box.ToSharedRef()
+			];
+	}
+	MessageItems.Insert(Prepended, 0);
+
+	RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateLambda([this, DistanceFromEnd](double, float)
+	{
+		if (MessageScrollBox.IsValid())
 		{
-			const FString Content = Line.RightChop(2); // strip "# "
-			Line = FString::Printf(TEXT("<Credits.H2>%s</>"), *Content);
+			MessageScrollBox->SetScrollOffset(FMath::Max(0.0f, MessageScrollBox->GetScrollOffsetOfEnd() - DistanceFromEnd));
 		}
-	}
+		return EActiveTimerReturnType::Stop;
+	}));
+}
 
-	RichText = FString::Join(Lines, TEXT("\n"));
+TSharedPtr<SNeoStackChatArea::FChatMessageItem> SNeoStackChatArea::AddMessageItem(const TSharedRef<SWidget>& Content)
+{
+	TSharedPtr<FChatMessageItem> Item = MakeShared<FChatMessageItem>();
+	Item->Content = Content;
+	Item->Box = SNew(SBox)
+		.Padding(FMargin(0.0f, 0.0f, 0.0f, 16.0f))
+		[
+			Content
+		];
 
-	// 2) THEN handle inline formatting (bold, italic, etc.)
-	// Replace **bold** with rich text tags
-	while (true)
+	if (bPrepending)
+	{
+		PrependItems.Add(Item);
+	}
+	else
 	{
-		int32 StartPos = RichText.Find(TEXT("**"));
-		if (StartPos == INDEX_NONE) break;
+		MessageContainer->AddSlot()
+			.AutoHeight()
+			[
+				Item->Box.ToSharedRef()
+			];
+		MessageItems.Add(Item);
+	}
 
-		int32 EndPos = RichText.Find(TEXT("**"), ESearchCase::CaseSensitive, ESearchDir::FromStart, StartPos + 2);
-		if (EndPos == INDEX_NONE) break;
+	return Item;
+}
 
-		FString BoldText = RichText.Mid(StartPos + 2, EndPos - StartPos - 2);
-		FString Replacement = FString::Printf(TEXT("<RichTextBlock.Bold>%s</>"), *BoldText);
+void SNeoStackChatArea::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+	UpdateRealizedMessages();
+}
 
-		RichText = RichText.Left(StartPos) + Replacement + RichText.Mid(EndPos + 2);
+void SNeoStackChatArea::UpdateRealizedMessages()
+{
+	if (!MessageScrollBox.IsValid() || MessageItems.Num() == 0)
+	{
+		return;
 	}
 
-	// Replace *italic* with rich text tags (but not if part of **)
-	int32 SearchPos = 0;
-	while (SearchPos < RichText.Len())
+	const float ViewHeight = MessageScrollBox->GetCachedGeometry().GetLocalSize().Y;
+	if (ViewHeight <= 0.0f)
 	{
-		int32 StartPos = RichText.Find(TEXT("*"), ESearchCase::CaseSensitive, ESearchDir::FromStart, SearchPos);
-		if (StartPos == INDEX_NONE) break;
+		return;
+	}
 
-		// Skip if this is part of a rich text tag
-		if (StartPos > 0 && RichText[StartPos - 1] == '*')
-		{
-			SearchPos = StartPos + 1;
-			continue;
-		}
-		if (StartPos + 1 < RichText.Len() && RichText[StartPos + 1] == '*')
-		{
-			SearchPos = StartPos + 2;
-			continue;
-		}
+	// Realize everything within one screen above and below the viewport
+	const float ScrollOffset = MessageScrollBox->GetScrollOffset();
+	const float RealizeTop = ScrollOffset - ViewHeight;
+	const float RealizeBottom = ScrollOffset + 2.0f * ViewHeight;
 
-		int32 EndPos = StartPos + 1;
-		while (EndPos < RichText.Len())
+	float Top = MessageListPadding;
+	for (const TSharedPtr<FChatMessageItem>& Item : MessageItems)
+	{
+		// Realized items report their current size; placeholders keep the last measured one
+		if (Item->bRealized)
 		{
-			if (RichText[EndPos] == '*' && (EndPos + 1 >= RichText.Len() || RichText[EndPos + 1] != '*'))
+			const float Measured = Item->Box->GetDesiredSize().Y;
+			if (Measured > 0.0f)
 			{
-				break;
+				Item->CachedHeight = Measured;
 			}
-			EndPos++;
 		}
 
-		if (EndPos < RichText.Len())
-		{
-			FString ItalicText = RichText.Mid(StartPos + 1, EndPos - StartPos - 1);
-			FString Replacement = FString::Printf(TEXT("<RichTextBlock.Italic>%s</>"), *ItalicText);
+		const float Bottom = Top + Item->CachedHeight;
+		const bool bNearView = Bottom >= RealizeTop && Top <= RealizeBottom;
 
-			RichText = RichText.Left(StartPos) + Replacement + RichText.Mid(EndPos + 1);
-			SearchPos = StartPos + Replacement.Len();
+		if (bNearView || Item->bPinned || Item->CachedHeight <= 0.0f)
+		{
+			if (!Item->bRealized)
+			{
+				Item->Box->SetHeightOverride(FOptionalSize());
+				Item->Box->SetContent(Item->Content.ToSharedRef());
+				Item->bRealized = true;
+			}
 		}
-		else
+		else if (Item->bRealized)
 		{
-			break;
+			// Off screen: swap the message for an empty box of the same height, so it costs
+			// nothing to lay out or paint and the scroll position does not move
+			Item->Box->SetHeightOverride(Item->CachedHeight);
+			Item->Box->SetContent(SNullWidget::NullWidget);
+			Item->bRealized = false;
 		}
-	}
 
-	// For code, just remove the backticks for now
-	RichText.ReplaceInline(TEXT("`"), TEXT(""));
+		Top = Bottom;
+	}
+}
 
-	return SNew(SRichTextBlock)
-		.Text(FText::FromString(RichText))
-		.TextStyle(FCoreStyle::Get(), "NormalText")
-		.DecoratorStyleSet(&FCoreStyle::Get())
-		.AutoWrapText(true);
+void SNeoStackChatArea::OnMessagesScrolled(float ScrollOffset)
+{
+	if (ScrollOffset <= LoadOlderScrollThreshold)
+	{
+		OnLoadOlderMessagesDelegate.ExecuteIfBound();
+	}
 }
 
 void SNeoStackChatArea::ScrollToBottom()
 {
+	// Replaying an older page must not yank the view away from where the user is reading
+	if (bPrepending)
+	{
+		return;
+	}
+
 	if (MessageScrollBox.IsValid())
 	{
 		MessageScrollBox->ScrollToEnd();
 	}
 }
 
+TSharedPtr<SNeoStackChatArea> SNeoStackChatArea::Get()
+{
+	return Instance.Pin();
+}
+
 #undef LOCTEXT_NAMESPACE
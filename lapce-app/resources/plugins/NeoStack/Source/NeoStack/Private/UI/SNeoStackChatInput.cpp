@@ -22,10 +22,14 @@
 #include "Framework/Text/PlainTextLayoutMarshaller.h"
 #include "NeoStackStyle.h"
 #include "NeoStackAPIClient.h"
+#include "NeoStackBlobStore.h"
+#include "NeoStackContextIndex.h"
 #include "NeoStackConversation.h"
-#include "IImageWrapper.h"
-#include "IImageWrapperModule.h"
-#include "Misc/Base64.h"
+#include "NeoStackImagePipeline.h"
+#include "NeoStackMentionPrefetcher.h"
+#include "NeoStackSettings.h"
+#include "Tools/AssetPrefetcher.h"
+#include "Tools/TurnCheckpoint.h"
 #include "Misc/FileHelper.h"
 #include "Engine/Texture2D.h"
 #include "HAL/PlatformApplicationMisc.h"
@@ -46,6 +50,9 @@ void SNeoStackChatInput::Construct(const FArguments& InArgs)
 	SidebarPtr = InArgs._Sidebar;
 	ChatAreaPtr = InArgs._ChatArea;
 
+	// Warm the @-context index in the background so the first popup is already populated
+	FNeoStackContextIndex::Get().EnsureBuilt();
+
 	ChildSlot
 	[
 		SNew(SOverlay)
@@ -138,7 +145,7 @@ void SNeoStackChatInput::Construct(const FArguments& InArgs)
 									.Padding(0.0f, 0.0f, 6.0f, 0.0f)
 									[
 										SNew(STextBlock)
-										.Text(LOCTEXT("SendButton", "Send"))
+										.Text(this, &SNeoStackChatInput::GetSendButtonText)
 										.Font(FCoreStyle::GetDefaultFontStyle("Regular", 10))
 										.ColorAndOpacity(FLinearColor(0.85f, 0.85f, 0.85f, 1.0f))
 									]
@@ -178,6 +185,15 @@ FReply SNeoStackChatInput::OnSendClicked()
 	// Hide context popup if open
 	HideContextPopup();
 
+	// Don't drop attachments that are still being processed; OnImageProcessed sends once they are in
+	if (PendingImageCount > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStack] Sending once %d image attachment(s) finish processing"), PendingImageCount);
+		bSendWhenImagesReady = true;
+		return FReply::Handled();
+	}
+	bSendWhenImagesReady = false;
+
 	if (InputTextBox.IsValid())
 	{
 		FText CurrentText = InputTextBox->GetText();
@@ -233,6 +249,7 @@ FReply SNeoStackChatInput::OnSendClicked()
 				FAttachedImage SendImg;
 				SendImg.Base64Data = Img.Base64Data;
 				SendImg.MimeType = Img.MimeType;
+				SendImg.Hash = Img.Hash;
 				// Don't copy ImageData, ThumbnailTexture or ThumbnailBrush - not needed for sending
 				ImagesToSend.Add(MoveTemp(SendImg));
 			}
@@ -244,6 +261,7 @@ FReply SNeoStackChatInput::OnSendClicked()
 				FConversationImage ConvImg;
 				ConvImg.Base64Data = Img.Base64Data;
 				ConvImg.MimeType = Img.MimeType;
+				ConvImg.Hash = Img.Hash;
 				ConvImages.Add(ConvImg);
 			}
 
@@ -252,6 +270,9 @@ FReply SNeoStackChatInput::OnSendClicked()
 			ClearAttachedImages();
 			ClearContextReferences();
 
+			// Edits made while answering this message form the next turn checkpoint
+			FTurnCheckpoint::Get().BeginTurn();
+
 			// Save user message to conversation (crash-safe) with images
 			FNeoStackConversationManager& ConversationMgr = FNeoStackConversationManager::Get();
 			if (ConvImages.Num() > 0)
@@ -270,12 +291,17 @@ FReply SNeoStackChatInput::OnSendClicked()
 			}
 
 			// Get conversation history for multi-turn
-			TArray<FConversationMessage> History = ConversationMgr.GetCurrentMessages();
+			TArray<FConversationMessage> History = ConversationMgr.GetFullCurrentMessages();
 			// Remove the last message (the one we just added) since we send it as prompt
 			if (History.Num() > 0)
 			{
 				History.RemoveAt(History.Num() - 1);
 			}
+			// Pull payloads that only live in the blob store back in for the request
+			FNeoStackBlobStore::ResolveAll(History);
+
+			// Each send streams into its own assistant message, so several requests can run at once
+			const FString StreamID = FGuid::NewGuid().ToString();
 
 			// Add user message to chat area with images
 			if (ChatAreaPtr.IsValid())
@@ -302,7 +328,7 @@ FReply SNeoStackChatInput::OnSendClicked()
 				}
 
 				// Start assistant message
-				ChatAreaPtr->StartAssistantMessage(AgentDisplayName, ModelDisplayName);
+				ChatAreaPtr->StartAssistantStream(StreamID, AgentDisplayName, ModelDisplayName);
 			}
 
 			// Track assistant message content for saving
@@ -324,27 +350,27 @@ FReply SNeoStackChatInput::OnSendClicked()
 				AgentName,
 				ModelID,
 				// On content
-				FOnAIContent::CreateLambda([WeakChatArea, AccumulatedContent](const FString& Content)
+				FOnAIContent::CreateLambda([WeakChatArea, StreamID, AccumulatedContent](const FString& Content)
 				{
 					// Accumulate content for saving
 					*AccumulatedContent += Content;
 
 					if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
 					{
-						ChatArea->AppendContent(Content);
+						ChatArea->QueueStreamContent(StreamID, Content);
 					}
 				}),
 				// On reasoning
-				FOnAIReasoning::CreateLambda([WeakChatArea](const FString& Reasoning)
+				FOnAIReasoning::CreateLambda([WeakChatArea, StreamID](const FString& Reasoning)
 				{
 					// Note: We don't save reasoning to conversation history
 					if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
 					{
-						ChatArea->AppendReasoning(Reasoning);
+						ChatArea->QueueStreamReasoning(StreamID, Reasoning);
 					}
 				}),
 				// On backend tool call (executed by backend)
-				FOnAIToolCall::CreateLambda([WeakChatArea, PendingToolCalls](const FString& ToolName, const FString& Args, const FString& CallID)
+				FOnAIToolCall::CreateLambda([WeakChatArea, StreamID, PendingToolCalls](const FString& ToolName, const FString& Args, const FString& CallID)
 				{
 					// Track tool call for saving (will be saved with assistant message)
 					FConversationToolCall TC;
@@ -355,11 +381,11 @@ FReply SNeoStackChatInput::OnSendClicked()
 
 					if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
 					{
-						ChatArea->AppendToolCall(ToolName, Args, CallID);
+						ChatArea->AppendStreamToolCall(StreamID, ToolName, Args, CallID);
 					}
 				}),
 				// On UE5 tool call (needs execution in engine with approval)
-				FOnAIUE5ToolCall::CreateLambda([WeakChatArea, PendingToolCalls, PendingUE5Tools, CurrentSessionID](const FString& SessionID, const FString& ToolName, const FString& Args, const FString& CallID)
+				FOnAIUE5ToolCall::CreateLambda([WeakChatArea, StreamID, PendingToolCalls, PendingUE5Tools, CurrentSessionID](const FString& SessionID, const FString& ToolName, const FString& Args, const TSharedPtr<FJsonObject>& ArgsObject, const FString& CallID)
 				{
 					UE_LOG(LogTemp, Log, TEXT("[NeoStack] UE5 Tool call received - SessionID: %s, Tool: %s, CallID: %s"), *SessionID, *ToolName, *CallID);
 
@@ -376,10 +402,13 @@ FReply SNeoStackChatInput::OnSendClicked()
 					// Track for execution (CallID -> (ToolName, Args))
 					PendingUE5Tools->Add(CallID, TPair<FString, FString>(ToolName, Args));
 
+					// Start loading the call's assets while it waits for approval and for the calls before it
+					FAssetPrefetcher::Get().Prefetch(ArgsObject);
+
 					if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
 					{
-						// Use AppendUE5ToolCall to pass session ID for result submission
-						ChatArea->AppendUE5ToolCall(SessionID, ToolName, Args, CallID);
+						// Pass session ID for result submission and the parsed args for execution
+						ChatArea->AppendStreamUE5ToolCall(StreamID, SessionID, ToolName, Args, CallID, ArgsObject);
 					}
 				}),
 				// On tool result (from backend execution)
@@ -394,7 +423,7 @@ FReply SNeoStackChatInput::OnSendClicked()
 					}
 				}),
 				// On complete
-				FOnAIComplete::CreateLambda([WeakChatArea, WeakSidebar, AccumulatedContent, PendingToolCalls, PendingToolResults]()
+				FOnAIComplete::CreateLambda([WeakChatArea, WeakSidebar, StreamID, AccumulatedContent, PendingToolCalls, PendingToolResults]()
 				{
 					FNeoStackConversationManager& ConvMgr = FNeoStackConversationManager::Get();
 
@@ -440,7 +469,7 @@ FReply SNeoStackChatInput::OnSendClicked()
 
 					if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
 					{
-						ChatArea->CompleteAssistantMessage();
+						ChatArea->CompleteAssistantStream(StreamID);
 					}
 				}),
 				// On cost update
@@ -452,7 +481,7 @@ FReply SNeoStackChatInput::OnSendClicked()
 					}
 				}),
 				// On error
-				FOnAPIError::CreateLambda([WeakChatArea, WeakSidebar](const FString& Error)
+				FOnAPIError::CreateLambda([WeakChatArea, WeakSidebar, StreamID](const FString& Error)
 				{
 					UE_LOG(LogTemp, Error, TEXT("API Error: %s"), *Error);
 
@@ -470,8 +499,8 @@ FReply SNeoStackChatInput::OnSendClicked()
 
 					if (TSharedPtr<SNeoStackChatArea> ChatArea = WeakChatArea.Pin())
 					{
-						ChatArea->AppendContent(FString::Printf(TEXT("Error: %s"), *Error));
-						ChatArea->CompleteAssistantMessage();
+						ChatArea->QueueStreamContent(StreamID, FString::Printf(TEXT("Error: %s"), *Error));
+						ChatArea->CompleteAssistantStream(StreamID);
 					}
 				})
 			);
@@ -647,28 +676,9 @@ bool SNeoStackChatInput::TryPasteImageFromClipboard()
 				}
 			}
 
-			// Convert BGRA to PNG using ImageWrapper
-			IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-			TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-
-			if (ImageWrapper.IsValid())
-			{
-				// SetRaw expects BGRA format
-				if (ImageWrapper->SetRaw(RawBGRA.GetData(), RawBGRA.Num(), Width, Height, ERGBFormat::BGRA, 8))
-				{
-					TArray64<uint8> PngData = ImageWrapper->GetCompressed(90);
-					if (PngData.Num() > 0)
-					{
-						// Convert TArray64 to TArray
-						TArray<uint8> ImageData;
-						ImageData.SetNumUninitialized(PngData.Num());
-						FMemory::Memcpy(ImageData.GetData(), PngData.GetData(), PngData.Num());
-
-						AddImageAttachment(ImageData);
-						bSuccess = true;
-					}
-				}
-			}
+			// PNG encoding, downscaling and hashing happen on a worker thread
+			AddRawImageAttachment(MoveTemp(RawBGRA), Width, Height);
+			bSuccess = true;
 
 			GlobalUnlock(hDib);
 		}
@@ -697,44 +707,9 @@ bool SNeoStackChatInput::TryPasteImageFromClipboard()
 							TArray<uint8> FileData;
 							if (FFileHelper::LoadFileToArray(FileData, *FilePathStr))
 							{
-								// Convert to PNG if needed
-								if (Extension == TEXT("jpg") || Extension == TEXT("jpeg"))
-								{
-									IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-									TSharedPtr<IImageWrapper> JpgWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
-									TSharedPtr<IImageWrapper> PngWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-
-									if (JpgWrapper.IsValid() && PngWrapper.IsValid())
-									{
-										if (JpgWrapper->SetCompressed(FileData.GetData(), FileData.Num()))
-										{
-											TArray64<uint8> RawData;
-											if (JpgWrapper->GetRaw(ERGBFormat::BGRA, 8, RawData))
-											{
-												int32 Width = JpgWrapper->GetWidth();
-												int32 Height = JpgWrapper->GetHeight();
-
-												if (PngWrapper->SetRaw(RawData.GetData(), RawData.Num(), Width, Height, ERGBFormat::BGRA, 8))
-												{
-													TArray64<uint8> PngData = PngWrapper->GetCompressed(90);
-													if (PngData.Num() > 0)
-													{
-														TArray<uint8> ImageData;
-														ImageData.SetNumUninitialized(PngData.Num());
-														FMemory::Memcpy(ImageData.GetData(), PngData.GetData(), PngData.Num());
-														AddImageAttachment(ImageData);
-														bSuccess = true;
-													}
-												}
-											}
-										}
-									}
-								}
-								else
-								{
-									AddImageAttachment(FileData);
-									bSuccess = true;
-								}
+								// Decoded and re-encoded as PNG on a worker thread
+								AddImageAttachment(MoveTemp(FileData));
+								bSuccess = true;
 							}
 						}
 					}
@@ -752,15 +727,77 @@ bool SNeoStackChatInput::TryPasteImageFromClipboard()
 #endif
 }
 
-void SNeoStackChatInput::AddImageAttachment(const TArray<uint8>& ImageData)
+void SNeoStackChatInput::AddImageAttachment(TArray<uint8>&& ImageData)
+{
+	++PendingImageCount;
+
+	TWeakPtr<SNeoStackChatInput> WeakSelf = SharedThis(this);
+	FNeoStackImagePipeline::ProcessEncodedAsync(MoveTemp(ImageData), [WeakSelf](TSharedPtr<const FNeoStackProcessedImage> Image)
+	{
+		if (TSharedPtr<SNeoStackChatInput> StrongThis = WeakSelf.Pin())
+		{
+			StrongThis->OnImageProcessed(Image);
+		}
+	});
+}
+
+void SNeoStackChatInput::AddRawImageAttachment(TArray<uint8>&& BGRA, int32 Width, int32 Height)
 {
+	++PendingImageCount;
+
+	TWeakPtr<SNeoStackChatInput> WeakSelf = SharedThis(this);
+	FNeoStackImagePipeline::ProcessRawAsync(MoveTemp(BGRA), Width, Height, [WeakSelf](TSharedPtr<const FNeoStackProcessedImage> Image)
+	{
+		if (TSharedPtr<SNeoStackChatInput> StrongThis = WeakSelf.Pin())
+		{
+			StrongThis->OnImageProcessed(Image);
+		}
+	});
+}
+
+void SNeoStackChatInput::OnImageProcessed(TSharedPtr<const FNeoStackProcessedImage> Image)
+{
+	PendingImageCount = FMath::Max(0, PendingImageCount - 1);
+
+	if (Image.IsValid())
+	{
+		AttachProcessedImage(*Image);
+	}
+
+	if (PendingImageCount == 0 && bSendWhenImagesReady)
+	{
+		OnSendClicked();
+	}
+}
+
+FText SNeoStackChatInput::GetSendButtonText() const
+{
+	if (bSendWhenImagesReady && PendingImageCount > 0)
+	{
+		return LOCTEXT("SendButtonWaiting", "Processing images...");
+	}
+	return LOCTEXT("SendButton", "Send");
+}
+
+void SNeoStackChatInput::AttachProcessedImage(const FNeoStackProcessedImage& Image)
+{
+	// The same image pasted twice is attached once
+	for (const FAttachedImage& Existing : AttachedImages)
+	{
+		if (Existing.Hash == Image.Hash)
+		{
+			return;
+		}
+	}
+
 	FAttachedImage Attachment;
-	Attachment.ImageData = ImageData;
-	Attachment.Base64Data = ImageDataToBase64(ImageData);
-	Attachment.MimeType = TEXT("image/png");
+	Attachment.ImageData = Image.PngData;
+	Attachment.Base64Data = Image.Base64Data;
+	Attachment.MimeType = Image.MimeType;
+	Attachment.Hash = Image.Hash;
 
 	// Create thumbnail texture using TStrongObjectPtr for proper UObject lifecycle
-	UTexture2D* Texture = CreateThumbnailTexture(ImageData);
+	UTexture2D* Texture = CreateThumbnailTexture(Image.ThumbnailBGRA, Image.ThumbnailWidth, Image.ThumbnailHeight);
 	if (Texture)
 	{
 		Attachment.ThumbnailTexture.Reset(Texture);
@@ -868,30 +905,13 @@ EVisibility SNeoStackChatInput::GetImagePreviewVisibility() const
 	return AttachedImages.Num() > 0 ? EVisibility::Visible : EVisibility::Collapsed;
 }
 
-UTexture2D* SNeoStackChatInput::CreateThumbnailTexture(const TArray<uint8>& ImageData)
+UTexture2D* SNeoStackChatInput::CreateThumbnailTexture(const TArray<uint8>& BGRA, int32 Width, int32 Height)
 {
-	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
-	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-
-	if (!ImageWrapper.IsValid())
+	if (Width <= 0 || Height <= 0 || BGRA.Num() != Width * Height * 4)
 	{
 		return nullptr;
 	}
 
-	if (!ImageWrapper->SetCompressed(ImageData.GetData(), ImageData.Num()))
-	{
-		return nullptr;
-	}
-
-	TArray64<uint8> RawData;
-	if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, RawData))
-	{
-		return nullptr;
-	}
-
-	int32 Width = ImageWrapper->GetWidth();
-	int32 Height = ImageWrapper->GetHeight();
-
 	// Create texture
 	UTexture2D* Texture = UTexture2D::CreateTransient(Width, Height, PF_B8G8R8A8);
 	if (!Texture)
@@ -901,7 +921,7 @@ UTexture2D* SNeoStackChatInput::CreateThumbnailTexture(const TArray<uint8>& Imag
 
 	// Lock and copy data
 	void* TextureData = Texture->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
-	FMemory::Memcpy(TextureData, RawData.GetData(), RawData.Num());
+	FMemory::Memcpy(TextureData, BGRA.GetData(), BGRA.Num());
 	Texture->GetPlatformData()->Mips[0].BulkData.Unlock();
 
 	// Update the texture
@@ -910,11 +930,6 @@ UTexture2D* SNeoStackChatInput::CreateThumbnailTexture(const TArray<uint8>& Imag
 	return Texture;
 }
 
-FString SNeoStackChatInput::ImageDataToBase64(const TArray<uint8>& ImageData)
-{
-	return FBase64::Encode(ImageData);
-}
-
 EVisibility SNeoStackChatInput::GetContextTagsVisibility() const
 {
 	return AttachedContexts.Num() > 0 ? EVisibility::Visible : EVisibility::Collapsed;
@@ -995,6 +1010,9 @@ void SNeoStackChatInput::AddContextReference(const FString& DisplayName, const F
 	NewContext.FullPath = FullPath;
 	AttachedContexts.Add(NewContext);
 
+	// Read it while the user finishes typing
+	FNeoStackMentionPrefetcher::Get().Prefetch(FullPath);
+
 	UpdateContextTagsUI();
 }
 
@@ -1002,6 +1020,7 @@ void SNeoStackChatInput::RemoveContextReference(int32 Index)
 {
 	if (AttachedContexts.IsValidIndex(Index))
 	{
+		FNeoStackMentionPrefetcher::Get().Cancel(AttachedContexts[Index].FullPath);
 		AttachedContexts.RemoveAt(Index);
 		UpdateContextTagsUI();
 	}
@@ -1009,6 +1028,8 @@ void SNeoStackChatInput::RemoveContextReference(int32 Index)
 
 void SNeoStackChatInput::ClearContextReferences()
 {
+	// Called once the message is sent; the next one's mentions are read afresh
+	FNeoStackMentionPrefetcher::Get().Clear();
 	AttachedContexts.Empty();
 	UpdateContextTagsUI();
 }
@@ -1122,6 +1143,9 @@ void SNeoStackChatInput::CheckForContextTrigger(const FString& Text)
 
 void SNeoStackChatInput::LoadContextFileContents()
 {
+	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
+	const bool bAttachPrefetched = Settings && Settings->MentionPrefetch == ENeoStackMentionPrefetch::AttachToPrompt;
+
 	for (FAttachedContext& Ctx : AttachedContexts)
 	{
 		if (Ctx.FileContent.IsEmpty())
@@ -1129,9 +1153,12 @@ void SNeoStackChatInput::LoadContextFileContents()
 			// Determine if it's a file path or asset path
 			if (Ctx.FullPath.StartsWith(TEXT("/")))
 			{
-				// Asset path - try to load as text asset or get asset info
-				// For now just include the path reference
-				Ctx.FileContent = FString::Printf(TEXT("[Asset: %s]"), *Ctx.FullPath);
+				// Asset path - the prefetched summary if it is ready (sending doesn't wait for it),
+				// else just the path reference for the agent to read
+				if (!bAttachPrefetched || !FNeoStackMentionPrefetcher::Get().GetResult(Ctx.FullPath, Ctx.FileContent))
+				{
+					Ctx.FileContent = FString::Printf(TEXT("[Asset: %s]"), *Ctx.FullPath);
+				}
 			}
 			else
 			{
@@ -1,6 +1,7 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UI/SNeoStackContextPopup.h"
+#include "NeoStackContextIndex.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SScrollBox.h"
@@ -12,10 +13,6 @@
 #include "Brushes/SlateColorBrush.h"
 #include "Styling/CoreStyle.h"
 #include "Styling/AppStyle.h"
-#include "Misc/Paths.h"
-#include "HAL/FileManager.h"
-#include "AssetRegistry/AssetRegistryModule.h"
-#include "Engine/Blueprint.h"
 
 #define LOCTEXT_NAMESPACE "SNeoStackContextPopup"
 
@@ -23,8 +20,10 @@ void SNeoStackContextPopup::Construct(const FArguments& InArgs)
 {
 	OnItemSelectedDelegate = InArgs._OnItemSelected;
 
-	// Scan for files
-	ScanProjectFiles();
+	// Whatever the index holds right now; it refreshes the list once the background build lands
+	FNeoStackContextIndex& Index = FNeoStackContextIndex::Get();
+	Index.EnsureBuilt();
+	Index.OnUpdated().AddSP(this, &SNeoStackContextPopup::OnIndexUpdated);
 	ApplyFilter();
 
 	ChildSlot
@@ -53,111 +52,15 @@ void SNeoStackContextPopup::Construct(const FArguments& InArgs)
 	UpdateListViewItems();
 }
 
-void SNeoStackContextPopup::ScanProjectFiles()
+void SNeoStackContextPopup::OnIndexUpdated()
 {
-	AllItems.Empty();
-
-	// Add C++ files category
-	AllItems.Add(FContextItem::Category(TEXT("C++ Files")));
-
-	// Scan Source directory for C++ files
-	FString SourceDir = FPaths::ProjectDir() / TEXT("Source");
-	ScanCppDirectory(SourceDir);
-
-	// Also scan plugin source directories
-	FString PluginsDir = FPaths::ProjectDir() / TEXT("Plugins");
-	TArray<FString> PluginDirs;
-	IFileManager::Get().FindFiles(PluginDirs, *(PluginsDir / TEXT("*")), false, true);
-	for (const FString& PluginDir : PluginDirs)
-	{
-		FString PluginSourceDir = PluginsDir / PluginDir / TEXT("Source");
-		ScanCppDirectory(PluginSourceDir);
-	}
-
-	// Add Blueprints category
-	AllItems.Add(FContextItem::Category(TEXT("Blueprints")));
-	ScanBlueprintAssets();
-}
-
-void SNeoStackContextPopup::ScanCppDirectory(const FString& Directory)
-{
-	if (!IFileManager::Get().DirectoryExists(*Directory))
-	{
-		return;
-	}
-
-	TArray<FString> FoundFiles;
-
-	// Find all .h and .cpp files recursively
-	IFileManager::Get().FindFilesRecursive(FoundFiles, *Directory, TEXT("*.h"), true, false);
-	IFileManager::Get().FindFilesRecursive(FoundFiles, *Directory, TEXT("*.cpp"), true, false);
-
-	for (const FString& FilePath : FoundFiles)
-	{
-		FString FileName = FPaths::GetCleanFilename(FilePath);
-		FString Extension = FPaths::GetExtension(FilePath).ToLower();
-
-		EContextItemType Type = Extension == TEXT("h") ? EContextItemType::CppHeader : EContextItemType::CppSource;
-
-		// Make path relative to project
-		FString RelativePath = FilePath;
-		FPaths::MakePathRelativeTo(RelativePath, *FPaths::ProjectDir());
-
-		AllItems.Add(FContextItem(FileName, RelativePath, Type));
-	}
-}
-
-void SNeoStackContextPopup::ScanBlueprintAssets()
-{
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	// Query for Blueprint assets
-	TArray<FAssetData> BlueprintAssets;
-
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-	Filter.bRecursiveClasses = true;
-	Filter.bRecursivePaths = true;
-	Filter.PackagePaths.Add(TEXT("/Game"));
-
-	AssetRegistry.GetAssets(Filter, BlueprintAssets);
-
-	for (const FAssetData& Asset : BlueprintAssets)
-	{
-		FString AssetName = Asset.AssetName.ToString();
-		FString AssetPath = Asset.GetObjectPathString();
-
-		// Determine type based on parent class or naming
-		EContextItemType Type = EContextItemType::Blueprint;
-
-		// Check if it's a widget blueprint
-		if (AssetName.Contains(TEXT("Widget")) || AssetName.StartsWith(TEXT("WBP_")) || AssetName.StartsWith(TEXT("W_")))
-		{
-			Type = EContextItemType::Widget;
-		}
-
-		AllItems.Add(FContextItem(AssetName, AssetPath, Type));
-	}
-
-	// Also scan for materials
-	TArray<FAssetData> MaterialAssets;
-	FARFilter MaterialFilter;
-	MaterialFilter.ClassPaths.Add(UMaterial::StaticClass()->GetClassPathName());
-	MaterialFilter.ClassPaths.Add(UMaterialInstance::StaticClass()->GetClassPathName());
-	MaterialFilter.bRecursiveClasses = true;
-	MaterialFilter.bRecursivePaths = true;
-	MaterialFilter.PackagePaths.Add(TEXT("/Game"));
-
-	AssetRegistry.GetAssets(MaterialFilter, MaterialAssets);
+	ApplyFilter();
+	UpdateListViewItems();
 
-	if (MaterialAssets.Num() > 0)
+	SelectedIndex = FMath::Clamp(SelectedIndex, 0, FMath::Max(0, FilteredItems.Num() - 1));
+	if (FilteredItems.IsValidIndex(SelectedIndex) && FilteredItems[SelectedIndex].bIsCategory && FilteredItems.Num() > 1)
 	{
-		AllItems.Add(FContextItem::Category(TEXT("Materials")));
-		for (const FAssetData& Asset : MaterialAssets)
-		{
-			AllItems.Add(FContextItem(Asset.AssetName.ToString(), Asset.GetObjectPathString(), EContextItemType::Material));
-		}
+		SelectedIndex = FMath::Min(SelectedIndex + 1, FilteredItems.Num() - 1);
 	}
 }
 
@@ -177,70 +80,12 @@ void SNeoStackContextPopup::SetFilter(const FString& FilterText)
 
 void SNeoStackContextPopup::ApplyFilter()
 {
-	FilteredItems.Empty();
+	const FNeoStackContextIndex& Index = FNeoStackContextIndex::Get();
+	Index.Query(CurrentFilter, CurrentFilter.IsEmpty() ? MaxUnfilteredItems : MaxFilteredItems, FilteredItems);
 
-	if (CurrentFilter.IsEmpty())
-	{
-		// Show all items (up to a limit)
-		int32 Count = 0;
-		for (const FContextItem& Item : AllItems)
-		{
-			FilteredItems.Add(Item);
-			if (!Item.bIsCategory)
-			{
-				Count++;
-				if (Count >= 50) break; // Limit initial display
-			}
-		}
-	}
-	else
+	if (FilteredItems.Num() == 0 && !Index.IsReady())
 	{
-		// Filter by name (case insensitive fuzzy match)
-		FString LowerFilter = CurrentFilter.ToLower();
-
-		EContextItemType LastCategory = EContextItemType::Category;
-		bool bHasItemsInCategory = false;
-		int32 CategoryIndex = -1;
-
-		for (int32 i = 0; i < AllItems.Num(); i++)
-		{
-			const FContextItem& Item = AllItems[i];
-
-			if (Item.bIsCategory)
-			{
-				// Remember category, add later if we find matching items
-				LastCategory = Item.Type;
-				CategoryIndex = FilteredItems.Num();
-				bHasItemsInCategory = false;
-				continue;
-			}
-
-			// Check if item matches filter
-			FString LowerName = Item.DisplayName.ToLower();
-			FString LowerPath = Item.FullPath.ToLower();
-
-			if (LowerName.Contains(LowerFilter) || LowerPath.Contains(LowerFilter))
-			{
-				// Add category header if this is first match in category
-				if (!bHasItemsInCategory && CategoryIndex >= 0)
-				{
-					// Find and insert the category
-					for (const FContextItem& CatItem : AllItems)
-					{
-						if (CatItem.bIsCategory && CatItem.Type == LastCategory)
-						{
-							FilteredItems.Insert(CatItem, CategoryIndex);
-							break;
-						}
-					}
-					bHasItemsInCategory = true;
-				}
-
-				FilteredItems.Add(Item);
-
-				if (FilteredItems.Num() >= 30) break; // Limit results
-			}
-		}
+		FilteredItems.Add(FContextItem::Category(TEXT("Indexing project...")));
 	}
 }
 
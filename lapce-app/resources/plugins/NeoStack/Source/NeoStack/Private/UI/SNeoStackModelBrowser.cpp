@@ -1,7 +1,6 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "UI/SNeoStackModelBrowser.h"
-#include "NeoStackSettings.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SScrollBox.h"
@@ -12,10 +11,6 @@
 #include "Widgets/SBoxPanel.h"
 #include "Styling/CoreStyle.h"
 #include "Brushes/SlateColorBrush.h"
-#include "HttpModule.h"
-#include "Interfaces/IHttpResponse.h"
-#include "Json.h"
-#include "JsonUtilities.h"
 
 #define LOCTEXT_NAMESPACE "SNeoStackModelBrowser"
 
@@ -23,7 +18,6 @@ void SNeoStackModelBrowser::Construct(const FArguments& InArgs)
 {
 	OnModelSelectedDelegate = InArgs._OnModelSelected;
 	OnClosedDelegate = InArgs._OnClosed;
-	bIsLoading = false;
 
 	ChildSlot
 	[
@@ -78,19 +72,27 @@ void SNeoStackModelBrowser::Construct(const FArguments& InArgs)
 				[
 					SNew(STextBlock)
 					.Text_Lambda([this]() -> FText {
-						if (bIsLoading)
+						const FNeoStackModelCatalog& Catalog = FNeoStackModelCatalog::Get();
+						if (AllModels.Num() == 0)
 						{
-							return LOCTEXT("Loading", "Loading models...");
+							if (Catalog.IsLoading())
+							{
+								return LOCTEXT("Loading", "Loading models...");
+							}
+							if (!Catalog.GetError().IsEmpty())
+							{
+								return FText::FromString(Catalog.GetError());
+							}
 						}
-						if (!ErrorMessage.IsEmpty())
+						if (Catalog.IsLoading())
 						{
-							return FText::FromString(ErrorMessage);
+							return FText::Format(LOCTEXT("ModelCountRefreshing", "{0} models available (checking for updates...)"), FText::AsNumber(FilteredModels.Num()));
 						}
 						return FText::Format(LOCTEXT("ModelCount", "{0} models available"), FText::AsNumber(FilteredModels.Num()));
 					})
 					.Font(FCoreStyle::GetDefaultFontStyle("Italic", 9))
 					.ColorAndOpacity_Lambda([this]() -> FSlateColor {
-						if (!ErrorMessage.IsEmpty())
+						if (AllModels.Num() == 0 && !FNeoStackModelCatalog::Get().GetError().IsEmpty())
 						{
 							return FLinearColor(1.0f, 0.3f, 0.3f, 1.0f);
 						}
@@ -139,126 +141,35 @@ void SNeoStackModelBrowser::Construct(const FArguments& InArgs)
 		]
 	];
 
-	// Start fetching models
+	CatalogUpdatedHandle = FNeoStackModelCatalog::Get().OnUpdated().AddSP(this, &SNeoStackModelBrowser::OnCatalogUpdated);
+
+	// Cached models show right away; the refresh runs in the background
 	FetchModels();
 }
 
-void SNeoStackModelBrowser::FetchModels()
+SNeoStackModelBrowser::~SNeoStackModelBrowser()
 {
-	bIsLoading = true;
-	ErrorMessage.Empty();
-
-	const UNeoStackSettings* Settings = UNeoStackSettings::Get();
-	if (!Settings)
-	{
-		ErrorMessage = TEXT("Failed to get NeoStack settings");
-		bIsLoading = false;
-		return;
-	}
-
-	if (Settings->BackendURL.IsEmpty())
-	{
-		ErrorMessage = TEXT("Backend URL not configured");
-		bIsLoading = false;
-		return;
-	}
-
-	if (Settings->APIKey.IsEmpty())
-	{
-		ErrorMessage = TEXT("API Key not configured");
-		bIsLoading = false;
-		return;
-	}
-
-	FHttpModule& HttpModule = FHttpModule::Get();
-	TSharedRef<IHttpRequest> Request = HttpModule.CreateRequest();
-
-	FString URL = Settings->BackendURL + TEXT("/models");
-	Request->SetURL(URL);
-	Request->SetVerb(TEXT("GET"));
-	Request->SetHeader(TEXT("X-API-Key"), Settings->APIKey);
-
-	Request->OnProcessRequestComplete().BindRaw(this, &SNeoStackModelBrowser::OnModelsResponseReceived);
-
-	if (!Request->ProcessRequest())
-	{
-		ErrorMessage = TEXT("Failed to send HTTP request");
-		bIsLoading = false;
-	}
+	FNeoStackModelCatalog::Get().OnUpdated().Remove(CatalogUpdatedHandle);
 }
 
-void SNeoStackModelBrowser::OnModelsResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void SNeoStackModelBrowser::FetchModels()
 {
-	bIsLoading = false;
-
-	if (!bWasSuccessful || !Response.IsValid())
-	{
-		ErrorMessage = TEXT("Request failed or invalid response");
-		return;
-	}
-
-	int32 ResponseCode = Response->GetResponseCode();
-	if (ResponseCode != 200)
-	{
-		ErrorMessage = FString::Printf(TEXT("Server error: %d"), ResponseCode);
-		return;
-	}
-
-	FString Content = Response->GetContentAsString();
-
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Content);
-
-	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
-	{
-		ErrorMessage = TEXT("Failed to parse response");
-		return;
-	}
+	FNeoStackModelCatalog& Catalog = FNeoStackModelCatalog::Get();
+	Catalog.Request();
+	OnCatalogUpdated();
+}
 
-	const TArray<TSharedPtr<FJsonValue>>* DataArray;
-	if (!JsonObject->TryGetArrayField(TEXT("data"), DataArray))
+void SNeoStackModelBrowser::OnCatalogUpdated()
+{
+	const TArray<TSharedPtr<FOpenRouterModelInfo>>& Models = FNeoStackModelCatalog::Get().GetModels();
+	if (AllModels.Num() == Models.Num() && (AllModels.Num() == 0 || AllModels[0] == Models[0]))
 	{
-		ErrorMessage = TEXT("Invalid response format");
+		// Only the loading state changed
 		return;
 	}
 
-	AllModels.Empty();
-
-	for (const TSharedPtr<FJsonValue>& Value : *DataArray)
-	{
-		const TSharedPtr<FJsonObject>* ModelObj;
-		if (!Value->TryGetObject(ModelObj))
-		{
-			continue;
-		}
-
-		TSharedPtr<FOpenRouterModelInfo> Model = MakeShared<FOpenRouterModelInfo>();
-
-		(*ModelObj)->TryGetStringField(TEXT("id"), Model->ID);
-		(*ModelObj)->TryGetStringField(TEXT("name"), Model->Name);
-		(*ModelObj)->TryGetStringField(TEXT("description"), Model->Description);
-		(*ModelObj)->TryGetNumberField(TEXT("context_length"), Model->ContextLength);
-
-		// Strip provider prefix from name (e.g., "Anthropic: Claude Opus 4.5" -> "Claude Opus 4.5")
-		int32 ColonIndex;
-		if (Model->Name.FindChar(TEXT(':'), ColonIndex))
-		{
-			Model->Name = Model->Name.RightChop(ColonIndex + 1).TrimStart();
-		}
-
-		// Parse pricing
-		const TSharedPtr<FJsonObject>* PricingObj;
-		if ((*ModelObj)->TryGetObjectField(TEXT("pricing"), PricingObj))
-		{
-			(*PricingObj)->TryGetStringField(TEXT("prompt"), Model->PromptCost);
-			(*PricingObj)->TryGetStringField(TEXT("completion"), Model->CompletionCost);
-		}
-
-		Model->Provider = ExtractProvider(Model->ID);
-
-		AllModels.Add(Model);
-	}
-
+	AllModels = Models;
+	AppliedSearch.Empty();
 	FilterModels();
 
 	if (ModelListView.IsValid())
@@ -269,21 +180,23 @@ void SNeoStackModelBrowser::OnModelsResponseReceived(FHttpRequestPtr Request, FH
 
 void SNeoStackModelBrowser::FilterModels()
 {
-	FilteredModels.Empty();
+	const FString SearchLower = SearchText.ToLower();
 
-	FString SearchLower = SearchText.ToLower();
+	// Typing more only narrows the result, so only the current matches need checking
+	const bool bNarrowing = !AppliedSearch.IsEmpty() && SearchLower.StartsWith(AppliedSearch, ESearchCase::CaseSensitive);
+	const TArray<TSharedPtr<FOpenRouterModelInfo>> Candidates = bNarrowing ? MoveTemp(FilteredModels) : TArray<TSharedPtr<FOpenRouterModelInfo>>();
+	const TArray<TSharedPtr<FOpenRouterModelInfo>>& Source = bNarrowing ? Candidates : AllModels;
 
-	for (const TSharedPtr<FOpenRouterModelInfo>& Model : AllModels)
+	FilteredModels.Reset();
+	for (const TSharedPtr<FOpenRouterModelInfo>& Model : Source)
 	{
-		if (SearchText.IsEmpty() ||
-			Model->Name.ToLower().Contains(SearchLower) ||
-			Model->ID.ToLower().Contains(SearchLower) ||
-			Model->Provider.ToLower().Contains(SearchLower) ||
-			Model->Description.ToLower().Contains(SearchLower))
+		if (SearchLower.IsEmpty() || Model->SearchKey.Contains(SearchLower, ESearchCase::CaseSensitive))
 		{
 			FilteredModels.Add(Model);
 		}
 	}
+
+	AppliedSearch = SearchLower;
 }
 
 void SNeoStackModelBrowser::OnSearchTextChanged(const FText& NewText)
@@ -480,21 +393,4 @@ FString SNeoStackModelBrowser::FormatCost(const FString& PerTokenCost)
 	}
 }
 
-FString SNeoStackModelBrowser::ExtractProvider(const FString& ModelID)
-{
-	// Extract provider from model ID like "anthropic/claude-3" -> "Anthropic"
-	int32 SlashIndex;
-	if (ModelID.FindChar(TEXT('/'), SlashIndex))
-	{
-		FString Provider = ModelID.Left(SlashIndex);
-		// Capitalize first letter
-		if (Provider.Len() > 0)
-		{
-			Provider[0] = FChar::ToUpper(Provider[0]);
-		}
-		return Provider;
-	}
-	return TEXT("Unknown");
-}
-
 #undef LOCTEXT_NAMESPACE
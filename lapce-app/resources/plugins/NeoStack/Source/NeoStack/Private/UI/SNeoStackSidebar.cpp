@@ -11,6 +11,7 @@
 #include "Widgets/Layout/SSpacer.h"
 #include "Widgets/Input/SComboBox.h"
 #include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSearchBox.h"
 #include "Widgets/Views/SListView.h"
 #include "Widgets/Views/STableRow.h"
 #include "Widgets/Images/SImage.h"
@@ -366,6 +367,14 @@ void SNeoStackSidebar::Construct(const FArguments& InArgs)
 						.ColorAndOpacity(FLinearColor(0.7f, 0.7f, 0.7f, 1.0f))
 					]
 					+ SVerticalBox::Slot()
+					.AutoHeight()
+					.Padding(0.0f, 0.0f, 0.0f, 5.0f)
+					[
+						SNew(SSearchBox)
+						.HintText(LOCTEXT("SearchConversationsHint", "Search conversations"))
+						.OnTextChanged(this, &SNeoStackSidebar::OnSearchTextChanged)
+					]
+					+ SVerticalBox::Slot()
 					.FillHeight(1.0f)
 					[
 						SAssignNew(ConversationListView, SListView<TSharedPtr<FConversationMetadata>>)
@@ -406,6 +415,10 @@ TSharedRef<ITableRow> SNeoStackSidebar::OnGenerateConversationRow(TSharedPtr<FCo
 		TimeDisplay = Item->UpdatedAt.ToString(TEXT("%m/%d/%Y"));
 	}
 
+	// While searching, the matching text is more useful than the timestamp
+	const FString* Snippet = SearchSnippets.Find(Item->ID);
+	const FString Subtitle = Snippet ? *Snippet : TimeDisplay;
+
 	return SNew(STableRow<TSharedPtr<FConversationMetadata>>, OwnerTable)
 		.Padding(FMargin(0.0f, 3.0f))
 		[
@@ -438,7 +451,8 @@ TSharedRef<ITableRow> SNeoStackSidebar::OnGenerateConversationRow(TSharedPtr<FCo
 					.Padding(0.0f, 2.0f, 0.0f, 0.0f)
 					[
 						SNew(STextBlock)
-						.Text(FText::FromString(TimeDisplay))
+						.Text(FText::FromString(Subtitle))
+						.AutoWrapText(Snippet != nullptr)
 						.Font(FCoreStyle::GetDefaultFontStyle("Regular", 8))
 						.ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f, 1.0f))
 					]
@@ -519,13 +533,37 @@ FReply SNeoStackSidebar::OnDeleteConversation(int32 ConversationID)
 void SNeoStackSidebar::RefreshConversationsList()
 {
 	// Get all conversations from manager
-	TArray<FConversationMetadata> AllConversations = FNeoStackConversationManager::Get().GetAllConversations();
+	FNeoStackConversationManager& ConvMgr = FNeoStackConversationManager::Get();
+	TArray<FConversationMetadata> AllConversations = ConvMgr.GetAllConversations();
 
 	// Clear and rebuild our shared pointer list
 	Conversations.Empty();
-	for (const FConversationMetadata& Meta : AllConversations)
+	SearchSnippets.Empty();
+
+	if (SearchQuery.IsEmpty())
 	{
-		Conversations.Add(MakeShared<FConversationMetadata>(Meta));
+		for (const FConversationMetadata& Meta : AllConversations)
+		{
+			Conversations.Add(MakeShared<FConversationMetadata>(Meta));
+		}
+	}
+	else
+	{
+		// Search results in rank order
+		TMap<int32, const FConversationMetadata*> ByID;
+		for (const FConversationMetadata& Meta : AllConversations)
+		{
+			ByID.Add(Meta.ID, &Meta);
+		}
+
+		for (const FConversationSearchHit& Hit : ConvMgr.Search(SearchQuery))
+		{
+			if (const FConversationMetadata* const* Meta = ByID.Find(Hit.ConversationID))
+			{
+				Conversations.Add(MakeShared<FConversationMetadata>(**Meta));
+				SearchSnippets.Add(Hit.ConversationID, Hit.Snippet);
+			}
+		}
 	}
 
 	// Refresh the list view if it exists
@@ -535,6 +573,12 @@ void SNeoStackSidebar::RefreshConversationsList()
 	}
 }
 
+void SNeoStackSidebar::OnSearchTextChanged(const FText& NewText)
+{
+	SearchQuery = NewText.ToString().TrimStartAndEnd();
+	RefreshConversationsList();
+}
+
 void SNeoStackSidebar::OnConversationClicked(TSharedPtr<FConversationMetadata> Item)
 {
 	if (!Item.IsValid())
@@ -4,10 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "Http.h"
+#include "Containers/Ticker.h"
+#include "NeoStackSSEParser.h"
+#include "NeoStackConversation.h"
 
 // Forward declarations
-struct FConversationMessage;
+class FJsonObject;
 struct FAttachedImage;
+struct FNeoStackProcessedImage;
+struct FNeoStackStreamRecording;
 
 /**
  * Delegate for content event
@@ -26,8 +31,9 @@ DECLARE_DELEGATE_ThreeParams(FOnAIToolCall, const FString& /* ToolName */, const
 
 /**
  * Delegate for UE5 tool call event (tools that need execution in UE5)
+ * ArgsObject is the already-parsed args, so execution doesn't have to parse Args again
  */
-DECLARE_DELEGATE_FourParams(FOnAIUE5ToolCall, const FString& /* SessionID */, const FString& /* ToolName */, const FString& /* Args */, const FString& /* CallID */);
+DECLARE_DELEGATE_FiveParams(FOnAIUE5ToolCall, const FString& /* SessionID */, const FString& /* ToolName */, const FString& /* Args */, const TSharedPtr<FJsonObject>& /* ArgsObject */, const FString& /* CallID */);
 
 /**
  * Delegate for tool result event
@@ -49,6 +55,96 @@ DECLARE_DELEGATE_OneParam(FOnAICost, float /* Cost */);
  */
 DECLARE_DELEGATE_OneParam(FOnAPIError, const FString& /* ErrorMessage */);
 
+/**
+ * Callbacks for a single streamed request
+ */
+struct FNeoStackStreamCallbacks
+{
+	FOnAIContent OnContent;
+	FOnAIReasoning OnReasoning;
+	FOnAIToolCall OnToolCall;
+	FOnAIUE5ToolCall OnUE5ToolCall;
+	FOnAIToolResult OnToolResult;
+	FOnAIComplete OnComplete;
+	FOnAICost OnCost;
+	FOnAPIError OnError;
+};
+
+/**
+ * State of one in-flight streamed request to the AI endpoint.
+ * Each request owns its own SSE parser, callbacks and session ID, so several
+ * agent sessions can stream at the same time without sharing any buffers.
+ * The HTTP request keeps the session alive until the response completes.
+ */
+class NEOSTACK_API FNeoStackStreamSession : public TSharedFromThis<FNeoStackStreamSession>
+{
+public:
+	FNeoStackStreamSession(const FString& InSessionID, const FNeoStackStreamCallbacks& InCallbacks)
+		: SessionID(InSessionID)
+		, Callbacks(InCallbacks)
+	{}
+
+	/** Session ID sent to the backend (used for tool result submission) */
+	const FString& GetSessionID() const { return SessionID; }
+
+	/** True while the response (or a timed replay) is still streaming */
+	bool IsActive() const { return (HttpRequest.IsValid() || ReplayTicker.IsValid()) && !bFinished; }
+
+	/** Abort the request. No further callbacks (including OnError) fire afterwards */
+	void Cancel();
+
+private:
+	friend class FNeoStackAPIClient;
+
+	/** Session ID for this request */
+	FString SessionID;
+
+	/** Callbacks invoked for this request's events */
+	FNeoStackStreamCallbacks Callbacks;
+
+	/** Incremental decoder for this request's response body */
+	FNeoStackSSEParser Parser;
+
+	/** The underlying HTTP request (reset once the response completes) */
+	FHttpRequestPtr HttpRequest;
+
+	/** Set once the "final" event arrived or the request ended */
+	bool bFinished = false;
+
+	/** Set when the caller cancelled the request */
+	bool bCancelled = false;
+
+	/** Fed from a recording: acknowledgements in it are not applied to the live backend state */
+	bool bReplay = false;
+
+	/** Response bytes as they arrive, while NeoStack.RecordStreams is on */
+	TSharedPtr<FNeoStackStreamRecording> Recording;
+
+	/** When the request was sent, for the recording's chunk times */
+	double RequestStartTime = 0.0;
+
+	/** Feeds the next recorded chunks while a replay runs at recorded speed */
+	FTSTicker::FDelegateHandle ReplayTicker;
+
+	/** Payload as sent, kept in delta mode so a cache miss can be retried with the full history */
+	TSharedPtr<FJsonObject> Payload;
+
+	/**
+	 * Which messages of which conversation the history behind a delta upload or image references
+	 * was (HistoryNum 0 when everything was sent inline); a cache miss reads them back from there
+	 */
+	int32 HistoryConversationID = INDEX_NONE;
+	int32 HistoryNum = 0;
+	FString HistoryLastID;
+
+	/** Prompt images sent as hash references, by hash (needed to answer a cache miss) */
+	TMap<FString, FConversationImage> ReferencedImages;
+
+	/** IDs of the messages this payload sent as digests, and whether it sent the whole history */
+	TSet<FString> CompactedHistoryIDs;
+	bool bSentFullHistory = false;
+};
+
 /**
  * API client for communicating with NeoStack backend
  */
@@ -68,8 +164,9 @@ public:
 	 * @param OnComplete - Callback when streaming is complete
 	 * @param OnCost - Callback for cost updates
 	 * @param OnError - Callback when error occurs
+	 * @return The stream session for this request, or null if it could not be started
 	 */
-	static void SendMessage(
+	static TSharedPtr<FNeoStackStreamSession> SendMessage(
 		const FString& Message,
 		const FString& AgentName,
 		const FString& ModelID,
@@ -97,8 +194,9 @@ public:
 	 * @param OnComplete - Callback when streaming is complete
 	 * @param OnCost - Callback for cost updates
 	 * @param OnError - Callback when error occurs
+	 * @return The stream session for this request, or null if it could not be started
 	 */
-	static void SendMessageWithHistory(
+	static TSharedPtr<FNeoStackStreamSession> SendMessageWithHistory(
 		const FString& Message,
 		const TArray<FConversationMessage>& History,
 		const FString& AgentName,
@@ -128,8 +226,9 @@ public:
 	 * @param OnComplete - Callback when streaming is complete
 	 * @param OnCost - Callback for cost updates
 	 * @param OnError - Callback when error occurs
+	 * @return The stream session for this request, or null if it could not be started
 	 */
-	static void SendMessageWithImages(
+	static TSharedPtr<FNeoStackStreamSession> SendMessageWithImages(
 		const FString& Message,
 		const TArray<FAttachedImage>& Images,
 		const TArray<FConversationMessage>& History,
@@ -146,51 +245,96 @@ public:
 	);
 
 	/**
-	 * Submit a tool result back to the backend
+	 * Submit a tool result back to the backend (queued and batched per frame)
 	 * @param SessionID - The session ID from the tool call
 	 * @param CallID - The tool call ID
 	 * @param Result - The result of the tool execution (JSON string)
+	 * @param Images - Images the tool attached for the agent to see
 	 */
 	static void SubmitToolResult(
 		const FString& SessionID,
 		const FString& CallID,
-		const FString& Result
+		const FString& Result,
+		const TArray<TSharedPtr<const FNeoStackProcessedImage>>& Images = {}
+	);
+
+	/** Multimodal image part carrying the bytes as data URL (plus the hash so the backend can cache it) */
+	static TSharedRef<FJsonObject> MakeInlineImageContent(const FString& MimeType, const FString& Base64Data, const FString& Hash);
+
+	/**
+	 * Decode a recorded response body as if it were streamed in ChunkSize-byte pieces, invoking
+	 * Callbacks for its events. Sends nothing (used by the NeoStack.Perf benchmarks).
+	 */
+	static void ReplayStream(const TArray<uint8>& Body, int32 ChunkSize, const FNeoStackStreamCallbacks& Callbacks);
+
+	/**
+	 * Decode a recorded response with its original chunk boundaries, invoking Callbacks for its
+	 * events. Sends nothing.
+	 * @param Speed - 1 keeps the recorded timing (chunks are fed from the core ticker), 2 plays twice
+	 *                as fast, and so on; 0 or less decodes every chunk before returning
+	 * @return The replay session; cancel it to stop a timed replay
+	 */
+	static TSharedRef<FNeoStackStreamSession> ReplayRecording(
+		const TSharedRef<const FNeoStackStreamRecording>& Recording,
+		float Speed,
+		const FNeoStackStreamCallbacks& Callbacks
 	);
 
 private:
-	/** Buffer for accumulating partial SSE data */
-	static FString LastProcessedContent;
+	/** Runtime settings from Saved/NeoStack/settings.json as request settings, cached until the file changes */
+	static TSharedPtr<FJsonObject> BuildSettingsObject(const FString& ModelID);
 
-	/** Current session ID for tool callbacks */
-	static FString CurrentSessionID;
+	/**
+	 * Add the conversation history to the payload. In delta mode only the messages after the
+	 * newest backend-acknowledged ID are sent, together with that ID as the history cursor.
+	 * Once compaction wants to shorten a message the backend cached in full, the whole
+	 * compacted history is sent instead so the backend replaces its copy.
+	 */
+	static void AddHistoryToPayload(
+		const TSharedRef<FJsonObject>& Payload,
+		const TArray<FConversationMessage>& History,
+		FNeoStackStreamSession& Session
+	);
 
-	/** Parse SSE event and call appropriate delegate */
-	static void ParseSSEEvent(
-		const FString& EventData,
-		FString SessionID,
-		FOnAIContent OnContent,
-		FOnAIReasoning OnReasoning,
-		FOnAIToolCall OnToolCall,
-		FOnAIUE5ToolCall OnUE5ToolCall,
-		FOnAIToolResult OnToolResult,
-		FOnAIComplete OnComplete,
-		FOnAICost OnCost
+	/** True if History is the start of the current conversation, so RebuildHistory can read it back */
+	static bool IsCurrentConversationPrefix(const TArray<FConversationMessage>& History);
+
+	/** Read back the history behind a session's delta upload; false if the conversation is no longer current */
+	static bool RebuildHistory(const FNeoStackStreamSession& Session, TArray<FConversationMessage>& OutHistory);
+
+	/** Serialize the payload and hand it to StartStream */
+	static TSharedPtr<FNeoStackStreamSession> SendPayload(const TSharedRef<FNeoStackStreamSession>& Session);
+
+	/** Message IDs the backend reported as cached ("history_ack" events) */
+	static TSet<FString> AcknowledgedHistoryIDs;
+
+	/** Image hashes the backend reported as stored ("image_ack" events) */
+	static TSet<FString> UploadedImageHashes;
+
+	/** Message IDs the backend cached as digests rather than in full */
+	static TSet<FString> CompactedHistoryIDs;
+
+	/** Build the HTTP request for a prepared payload and start streaming it into Session */
+	static TSharedPtr<FNeoStackStreamSession> StartStream(
+		const TSharedRef<FNeoStackStreamSession>& Session,
+		const FString& RequestBody
 	);
 
+	/** Token-level decode of content/reasoning deltas without building a DOM. Returns false for other events */
+	static bool TryParseTextDelta(const FString& JsonString, FNeoStackStreamSession& Session);
+
+	/** Parse a single SSE data payload (one JSON event) and call the session's delegates */
+	static void ParseSSEEvent(const FString& JsonString, FNeoStackStreamSession& Session);
+
+	/** Add the response bytes the session's recording does not have yet */
+	static void RecordNewBytes(FNeoStackStreamSession& Session, const TArray<uint8>& Content);
+
 	/** Handle HTTP response with streaming */
 	static void OnResponseReceived(
 		FHttpRequestPtr Request,
 		FHttpResponsePtr Response,
 		bool bWasSuccessful,
-		FString SessionID,
-		FOnAIContent OnContent,
-		FOnAIReasoning OnReasoning,
-		FOnAIToolCall OnToolCall,
-		FOnAIUE5ToolCall OnUE5ToolCall,
-		FOnAIToolResult OnToolResult,
-		FOnAIComplete OnComplete,
-		FOnAICost OnCost,
-		FOnAPIError OnError
+		TSharedRef<FNeoStackStreamSession> Session
 	);
 
 	/** Handle streaming progress */
@@ -198,13 +342,6 @@ private:
 		FHttpRequestPtr Request,
 		uint64 BytesSent,
 		uint64 BytesReceived,
-		FString SessionID,
-		FOnAIContent OnContent,
-		FOnAIReasoning OnReasoning,
-		FOnAIToolCall OnToolCall,
-		FOnAIUE5ToolCall OnUE5ToolCall,
-		FOnAIToolResult OnToolResult,
-		FOnAIComplete OnComplete,
-		FOnAICost OnCost
+		TSharedRef<FNeoStackStreamSession> Session
 	);
 };
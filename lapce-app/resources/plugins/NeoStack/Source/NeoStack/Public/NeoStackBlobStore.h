@@ -0,0 +1,53 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FConversationMessage;
+
+/**
+ * Content-addressed store for large conversation payloads (image bytes, long tool results).
+ *
+ * Blobs live under Saved/NeoStack/Blobs/<first two hex digits>/<sha1> and are never
+ * modified, so the same payload referenced from several messages or conversations is
+ * stored once. Conversation files only keep the hash; the payload is read back when a
+ * message is rendered or sent again.
+ */
+class NEOSTACK_API FNeoStackBlobStore
+{
+public:
+	/** Store raw bytes, returns their SHA-1 (hex). Safe to call from any thread */
+	static FString StoreBytes(const TArray<uint8>& Bytes, const FString& KnownHash = FString());
+
+	/** Store text as UTF-8, returns the SHA-1 of the UTF-8 bytes */
+	static FString StoreText(const FString& Text);
+
+	/** Read a blob back */
+	static bool LoadBytes(const FString& Hash, TArray<uint8>& OutBytes);
+
+	/** Read a text blob back */
+	static bool LoadText(const FString& Hash, FString& OutText);
+
+	/**
+	 * Move payloads above Threshold bytes out of the message into the store
+	 * (called on the persistence writer thread right before the message is serialized)
+	 */
+	static void Externalize(FConversationMessage& Message, int32 Threshold);
+
+	/** True if some payload of the message is still only referenced by hash */
+	static bool NeedsResolve(const FConversationMessage& Message);
+
+	/** Load every externalized payload of the message back into it */
+	static void Resolve(FConversationMessage& Message);
+
+	/** Resolve a whole history, e.g. before it is sent */
+	static void ResolveAll(TArray<FConversationMessage>& Messages);
+
+	/** Root directory of the store */
+	static FString GetBlobsDir();
+
+private:
+	/** Path of the blob with the given hash */
+	static FString GetBlobPath(const FString& Hash);
+};
@@ -0,0 +1,146 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UI/SNeoStackContextPopup.h"
+
+struct FFileChangeData;
+
+/**
+ * Long-lived index of everything the @-context popup can offer.
+ *
+ * Built once in the background the first time it is needed, then kept current from the
+ * project catalog's asset events and a directory watcher on the project's Source folders, so
+ * opening the popup never rescans anything. Names and paths are lowercased when an entry is added, so a
+ * keystroke is one cheap subsequence-scoring pass that keeps a few top candidates, which are
+ * then ranked with FFuzzyMatchingUtils.
+ * All public functions are game thread only.
+ */
+class NEOSTACK_API FNeoStackContextIndex
+{
+public:
+	static FNeoStackContextIndex& Get();
+
+	/** Start the background build and event subscriptions if that has not happened yet */
+	void EnsureBuilt();
+
+	/** Drop the catalog and directory watcher subscriptions */
+	void Shutdown();
+
+	/** True once the initial build has finished */
+	bool IsReady() const { return bReady; }
+
+	/**
+	 * Best matches for a filter, grouped under category headers
+	 * @param Filter - Text typed after '@'; empty lists entries in category order
+	 * @param MaxResults - Maximum number of selectable items returned
+	 */
+	void Query(const FString& Filter, int32 MaxResults, TArray<FContextItem>& OutItems) const;
+
+	/** Fired after the contents changed */
+	FSimpleMulticastDelegate& OnUpdated() { return UpdatedEvent; }
+
+	/**
+	 * Fuzzy score of a query against one string
+	 * @param LowerQuery - Lowercased query
+	 * @param LowerText - Lowercased candidate
+	 * @param Text - Original candidate, used to find word starts
+	 * @return Score (higher is better), or INDEX_NONE if the query is not a subsequence
+	 */
+	static int32 ScoreFuzzy(const FString& LowerQuery, const FString& LowerText, const FString& Text);
+
+private:
+	struct FEntry
+	{
+		FContextItem Item;
+		FString LowerName;
+		FString LowerPath;
+	};
+
+	/** Asset classes the popup offers, including every subclass */
+	struct FAssetClasses
+	{
+		TSet<FTopLevelAssetPath> Blueprints;
+		TSet<FTopLevelAssetPath> Materials;
+	};
+
+	/** What an entry needs of a catalog row, copied out so it can be typed off the game thread */
+	struct FCatalogAsset
+	{
+		FString AssetName;
+		FString ObjectPath;
+		FTopLevelAssetPath ClassPath;
+	};
+
+	struct FPendingChange
+	{
+		FEntry Entry;
+		bool bRemove = false;
+	};
+
+	static FEntry MakeEntry(FContextItem&& Item);
+
+	static FCatalogAsset MakeCatalogAsset(int32 Row);
+
+	/** Map an asset to an entry; false if the popup does not offer that kind of asset */
+	static bool MakeAssetEntry(const FCatalogAsset& Asset, const FAssetClasses& Classes, FEntry& OutEntry);
+
+	/** Map a source file to an entry; false for anything but .h/.cpp */
+	static bool MakeFileEntry(const FString& AbsolutePath, const FString& ProjectDir, FEntry& OutEntry);
+
+	/** Gather the assets from the catalog here and hand them plus the file scan to the thread pool */
+	void StartBuild();
+
+	/** Install a finished build and replay what changed while it ran */
+	void FinishBuild(TArray<FEntry>&& Built);
+
+	/** Add or replace the entry for Entry.Item.FullPath */
+	void AddEntry(FEntry&& Entry);
+
+	/** @return True if an entry was removed */
+	bool RemoveEntry(const FString& FullPath);
+
+	/**
+	 * Apply a change now, or queue it if a build is in flight
+	 * @return True if the contents changed
+	 */
+	bool ApplyChange(FPendingChange&& Change);
+
+	void WatchSourceDirectories();
+	void UnwatchSourceDirectories();
+
+	void HandleCatalogRebuilt();
+	void HandleCatalogAssetChanged(const FString& ObjectPath, bool bRemoved);
+	void HandleSourceChanged(const TArray<FFileChangeData>& Changes);
+
+	/** Project Source plus every plugin Source folder */
+	static TArray<FString> GetSourceDirectories();
+
+	/** Category header a type is listed under */
+	static FString GetCategoryName(EContextItemType Type);
+
+	TArray<FEntry> Entries;
+
+	/** Refreshed by every build */
+	FAssetClasses AssetClasses;
+
+	/** FullPath -> index into Entries */
+	TMap<FString, int32> EntryByPath;
+
+	/** Changes that arrived while a build was running */
+	TArray<FPendingChange> PendingChanges;
+
+	/** Watched directory -> watcher handle */
+	TArray<TPair<FString, FDelegateHandle>> WatchHandles;
+
+	FSimpleMulticastDelegate UpdatedEvent;
+
+	bool bStarted = false;
+	bool bBuilding = false;
+	bool bReady = false;
+	bool bShutdown = false;
+
+	/** A rescan was requested while a build was running */
+	bool bRebuildQueued = false;
+};
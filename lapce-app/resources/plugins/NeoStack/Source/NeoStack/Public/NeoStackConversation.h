@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "NeoStackSearchIndex.h"
 
 /**
  * Tool call information for conversation messages
@@ -26,6 +27,8 @@ struct FConversationImage
 {
 	FString Base64Data;   // Base64 encoded PNG data
 	FString MimeType;     // e.g., "image/png"
+	FString Hash;         // SHA-1 of the PNG bytes, lets later turns reference an uploaded image
+	FString Blob;         // Blob store key when the bytes are not stored inline (Base64Data is empty until resolved)
 
 	FConversationImage()
 		: MimeType(TEXT("image/png"))
@@ -37,8 +40,10 @@ struct FConversationImage
  */
 struct FConversationMessage
 {
+	FString ID;        // Stable message ID, used as the delta upload cursor
 	FString Role;      // "user", "assistant", "tool"
 	FString Content;
+	FString ContentBlob;                       // Blob store key when Content is not stored inline (empty until resolved)
 	TArray<FConversationToolCall> ToolCalls;  // For assistant messages with tool calls
 	FString ToolCallID;                        // For tool response messages
 	TArray<FConversationImage> Images;         // For messages with images
@@ -115,9 +120,12 @@ struct FConversationMetadata
 class NEOSTACK_API FNeoStackConversationManager
 {
 public:
-	/** Get the singleton instance */
+	/** Get the singleton instance (loads metadata on first use) */
 	static FNeoStackConversationManager& Get();
 
+	/** True once Get() has run, so shutdown paths can avoid creating the manager just to tear it down */
+	static bool IsCreated();
+
 	/** Create a new conversation, returns conversation ID */
 	int32 CreateConversation(const FString& Title = TEXT("New Conversation"));
 
@@ -130,8 +138,8 @@ public:
 	/** Get all conversation metadata */
 	TArray<FConversationMetadata> GetAllConversations() const;
 
-	/** Load messages for a conversation */
-	TArray<FConversationMessage> LoadMessages(int32 ConversationID) const;
+	/** Load all messages for a conversation */
+	TArray<FConversationMessage> LoadMessages(int32 ConversationID);
 
 	/** Append a message to the current conversation (crash-safe) */
 	void AppendMessage(const FConversationMessage& Message);
@@ -142,14 +150,36 @@ public:
 	/** Delete a conversation */
 	void DeleteConversation(int32 ConversationID);
 
-	/** Get the messages for the current conversation */
+	/** Get the loaded messages of the current conversation (the newest page plus any older pages pulled in) */
 	const TArray<FConversationMessage>& GetCurrentMessages() const { return CurrentMessages; }
 
+	/** Get every message of the current conversation, loading the remaining older pages first */
+	const TArray<FConversationMessage>& GetFullCurrentMessages();
+
+	/** True if the current conversation has messages older than the loaded ones */
+	bool HasOlderMessages() const { return CurrentLoadedStart > 0; }
+
+	/** Load up to Count messages older than the loaded ones, returns them (oldest first) */
+	TArray<FConversationMessage> LoadOlderMessages(int32 Count);
+
+	/** Messages parsed when a conversation is opened */
+	static constexpr int32 InitialPageSize = 40;
+
+	/**
+	 * Full-text search over all saved conversations
+	 * @return One hit per matching conversation, best first, with a snippet of the matching message
+	 */
+	TArray<FConversationSearchHit> Search(const FString& Query, int32 MaxResults = 50);
+
 	/** Clear current conversation messages (for new chat) */
 	void ClearCurrentConversation();
 
+	/** Fold the metadata journal into metadata.json and stop the writer thread (module shutdown) */
+	void Shutdown();
+
 private:
 	FNeoStackConversationManager();
+	~FNeoStackConversationManager();
 
 	/** Get the base directory for conversations */
 	FString GetConversationsDir() const;
@@ -157,15 +187,46 @@ private:
 	/** Get the file path for a conversation */
 	FString GetConversationFilePath(int32 ConversationID) const;
 
+	/** Get the offset index (int64 line start per message) for a conversation */
+	FString GetIndexFilePath(int32 ConversationID) const;
+
+	/** Load (rebuilding if stale) the line offsets of a conversation file */
+	bool LoadOffsetIndex(int32 ConversationID, TArray<int64>& OutOffsets, int64& OutFileSize);
+
+	/**
+	 * Parse messages [Start, Start + Count) by reading only their byte range
+	 * @param OutLines - If set, receives each returned message's line in the file; lines that don't parse are skipped
+	 */
+	TArray<FConversationMessage> ReadMessageRange(int32 ConversationID, const TArray<int64>& Offsets, int64 FileSize, int32 Start, int32 Count,
+		TArray<int32>* OutLines = nullptr) const;
+
 	/** Get the metadata file path */
 	FString GetMetadataFilePath() const;
 
 	/** Load metadata from disk */
 	void LoadMetadata();
 
-	/** Save metadata to disk */
+	/** Save metadata to disk (full rewrite, also truncates the journal) */
 	void SaveMetadata();
 
+	/** Get the metadata journal file path */
+	FString GetJournalFilePath() const;
+
+	/** Replay journal entries written since the last full metadata save */
+	void ReplayJournal();
+
+	/** Record a metadata change as one appended journal line instead of a full rewrite */
+	void AppendJournal(const FConversationMetadata& Meta, bool bTitleChanged);
+
+	/** Get the search index, loading it (or building it from the conversation files) on first use */
+	FNeoStackSearchIndex& GetSearchIndex();
+
+	/** Get the search index file path */
+	FString GetSearchIndexFilePath() const;
+
+	/** Get (starting if needed) the background writer that owns all file I/O */
+	class FNeoStackPersistenceWriter& GetWriter();
+
 	/** Generate next conversation ID */
 	int32 GenerateNextID();
 
@@ -175,9 +236,30 @@ private:
 	/** Current conversation messages (in memory) */
 	TArray<FConversationMessage> CurrentMessages;
 
+	/** Line offsets of the current conversation at the time it was opened */
+	TArray<int64> CurrentOffsets;
+
+	/** Size of the current conversation file at the time it was opened */
+	int64 CurrentFileSize = 0;
+
+	/** Index of the oldest message in CurrentMessages */
+	int32 CurrentLoadedStart = 0;
+
 	/** All conversation metadata */
 	TArray<FConversationMetadata> AllMetadata;
 
 	/** Next available ID */
 	int32 NextID;
+
+	/** Background writer for conversation files, metadata and journal */
+	TUniquePtr<class FNeoStackPersistenceWriter> Writer;
+
+	/** Inverted index over message text, kept up to date by AppendMessage */
+	TUniquePtr<FNeoStackSearchIndex> SearchIndex;
+
+	/** Entries in the journal since the last full metadata save */
+	int32 JournalEntries = 0;
+
+	/** Journal size at which it is folded back into metadata.json */
+	static constexpr int32 MaxJournalEntries = 512;
 };
@@ -0,0 +1,76 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * An image attachment after it went through the pipeline. Immutable and shared, so the
+ * same screenshot pasted twice costs one decode/encode and one copy of the bytes.
+ */
+struct FNeoStackProcessedImage
+{
+	/** SHA-1 of the encoded PNG (hex) - identifies the image towards the backend */
+	FString Hash;
+
+	/** Encoded PNG bytes (downscaled to the configured max edge) */
+	TArray<uint8> PngData;
+
+	/** Base64 of PngData */
+	FString Base64Data;
+
+	/** MIME type of PngData */
+	FString MimeType = TEXT("image/png");
+
+	/** Dimensions of the encoded image */
+	int32 Width = 0;
+	int32 Height = 0;
+
+	/** Small BGRA8 preview so the game thread only has to upload a texture */
+	TArray<uint8> ThumbnailBGRA;
+	int32 ThumbnailWidth = 0;
+	int32 ThumbnailHeight = 0;
+};
+
+/**
+ * Decodes, downscales, encodes and hashes image attachments on the thread pool.
+ *
+ * Results are delivered on the game thread, always asynchronously. Inputs are deduplicated by a
+ * hash of the source bytes: re-attaching an image that was processed recently is still hashed
+ * on a worker, but returns the cached result instead of being decoded and encoded again.
+ */
+class NEOSTACK_API FNeoStackImagePipeline
+{
+public:
+	using FOnProcessed = TFunction<void(TSharedPtr<const FNeoStackProcessedImage> /* Image, null on failure */)>;
+
+	/** Process an encoded image file (PNG, JPEG, BMP...) */
+	static void ProcessEncodedAsync(TArray<uint8>&& EncodedData, FOnProcessed OnProcessed);
+
+	/** Process raw BGRA8 pixels (e.g. a clipboard bitmap) */
+	static void ProcessRawAsync(TArray<uint8>&& BGRA, int32 Width, int32 Height, FOnProcessed OnProcessed);
+
+	/**
+	 * Process raw BGRA8 pixels on the calling thread, skipping the cache (for pixels that are
+	 * new every time, like captures). Any thread, once the ImageWrapper module is loaded.
+	 * @param MaxEdge Longest edge of the result, 0 to keep the size
+	 */
+	static TSharedPtr<const FNeoStackProcessedImage> ProcessRaw(TArray<uint8>& BGRA, int32 Width, int32 Height, int32 MaxEdge);
+
+	/** Thumbnail edge length in pixels */
+	static constexpr int32 ThumbnailEdge = 64;
+
+private:
+	/** Worker-side processing of decoded pixels */
+	static TSharedPtr<const FNeoStackProcessedImage> ProcessPixels(TArray<uint8>& BGRA, int32 Width, int32 Height, int32 MaxEdge);
+
+	/** Box-filter downscale of BGRA8 pixels */
+	static void Downscale(const TArray<uint8>& Src, int32 SrcWidth, int32 SrcHeight, TArray<uint8>& Dst, int32 DstWidth, int32 DstHeight);
+
+	/** Look up / store a result by source hash */
+	static TSharedPtr<const FNeoStackProcessedImage> FindCached(const FString& SourceHash);
+	static void AddCached(const FString& SourceHash, const TSharedPtr<const FNeoStackProcessedImage>& Image);
+
+	/** Hand a result back to the game thread */
+	static void Deliver(FOnProcessed OnProcessed, TSharedPtr<const FNeoStackProcessedImage> Image);
+};
@@ -0,0 +1,52 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Prebuilt index files shared between machines, so a fresh checkout starts warm
+ *
+ * The project catalog, the code search index and the Blueprint function usage index keep
+ * their files in Intermediate/NeoStack in a relocatable form: assets are keyed by package
+ * name, code files by their path relative to the project, and entries carry content hashes
+ * that let another checkout reconcile them without re-reading what is unchanged.
+ *
+ * Publish (the NeoStackTools commandlet with -publishIndexes, usually on CI) copies those
+ * files into a content-addressed store under the "Shared Index Path" setting, one blob per
+ * SHA-1 under Artifacts/, then replaces Manifest.json, which names the blob of each file and
+ * the engine it was built with. Blobs are never rewritten, so a reader racing a publish sees
+ * either the old set or the new one.
+ *
+ * Pull runs at editor startup, before any index loads its file: every file missing locally is
+ * copied from the store and checked against its hash. Files a machine already has are kept,
+ * since its own incremental updates are at least as current as CI's; each index then
+ * reconciles what it loaded against the project as it always does.
+ */
+class NEOSTACK_API FNeoStackIndexArtifacts
+{
+public:
+	/** Intermediate/NeoStack, where the indexes keep their files */
+	static FString GetLocalDir();
+
+	/**
+	 * <SharedRoot>/<project name>, where this project's store lives
+	 * @param SharedRoot - Defaults to the Shared Index Path setting; the result is empty when neither is set
+	 */
+	static FString GetSharedDir(const FString& SharedRoot = FString());
+
+	/** Index files that are shared, relative to GetLocalDir */
+	static const TArray<FString>& GetArtifactNames();
+
+	/**
+	 * Copy the artifacts missing locally from the store
+	 * @return Number of files copied
+	 */
+	static int32 Pull(const FString& SharedDir);
+
+	/**
+	 * Add the local artifacts to the store and point its manifest at them
+	 * @return Number of artifacts in the new manifest, INDEX_NONE if it could not be written
+	 */
+	static int32 Publish(const FString& SharedDir);
+};
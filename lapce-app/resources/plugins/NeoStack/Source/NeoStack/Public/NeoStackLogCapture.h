@@ -0,0 +1,82 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/OutputDevice.h"
+#include <atomic>
+
+/**
+ * The editor's recent log lines in memory, for read_log
+ *
+ * An output device on GLog copies every line, with its category, verbosity and time, into a
+ * fixed ring of Capacity slots. Each line gets a cursor (a sequence number that only grows);
+ * readers pass the cursor they got last time and only see what was logged since, without
+ * touching the log file. Writers from any thread claim a slot with one atomic increment and
+ * publish it through the slot's version (a seqlock), so logging never waits for a reader and a
+ * reader simply skips lines that were overwritten while it looked. Messages longer than
+ * MaxMessageChars are cut.
+ */
+class NEOSTACK_API FNeoStackLogCapture : public FOutputDevice
+{
+public:
+	/** One captured line, copied out of the ring */
+	struct FLine
+	{
+		uint64 Cursor = 0;
+		FDateTime Time;
+		ELogVerbosity::Type Verbosity = ELogVerbosity::Log;
+		FName Category;
+		FString Message;
+	};
+
+	static FNeoStackLogCapture& Get();
+
+	/** Start capturing, including the startup backlog GLog still holds */
+	void Install();
+
+	/** Stop capturing (module shutdown); captured lines stay readable */
+	void Uninstall();
+
+	/**
+	 * Visit the captured lines from cursor Since on, oldest first
+	 * @param Visitor - Return false to stop after this line
+	 * @param OutDropped - Lines after Since that were overwritten before they could be read
+	 * @return Cursor to pass next time: one past the last line visited or skipped
+	 */
+	uint64 Read(uint64 Since, TFunctionRef<bool(const FLine&)> Visitor, uint64& OutDropped) const;
+
+	/** Cursor the next line will get */
+	uint64 GetNextCursor() const { return NextCursor.load(std::memory_order_acquire); }
+
+	//~ Begin FOutputDevice Interface
+	virtual void Serialize(const TCHAR* Message, ELogVerbosity::Type Verbosity, const FName& Category) override;
+	virtual bool CanBeUsedOnAnyThread() const override { return true; }
+	virtual bool CanBeUsedOnMultipleThreads() const override { return true; }
+	//~ End FOutputDevice Interface
+
+	/** Lines kept; a power of two */
+	static constexpr uint64 Capacity = 4096;
+
+	/** Characters kept per line */
+	static constexpr int32 MaxMessageChars = 512;
+
+private:
+	struct FSlot
+	{
+		/** 2 * cursor + 1 while being written, 2 * cursor + 2 once complete, 0 if never used */
+		std::atomic<uint64> Version{0};
+
+		int64 Ticks = 0;
+		FName Category;
+		uint8 Verbosity = 0;
+		int32 Len = 0;
+		TCHAR Message[MaxMessageChars];
+	};
+
+	FNeoStackLogCapture() = default;
+
+	TUniquePtr<FSlot[]> Slots;
+	std::atomic<uint64> NextCursor{0};
+	bool bInstalled = false;
+};
@@ -0,0 +1,96 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FNeoStackCancellationToken;
+class FTransactionObjectEvent;
+
+/**
+ * Reads @-mentioned assets and files while the user is still typing
+ *
+ * The chat input starts a prefetch as soon as an item is picked in the context popup. An
+ * asset's package is loaded with LoadPackageAsync, so the disk read happens off the game
+ * thread, and then read_asset runs through FNeoStackToolRegistry::ExecuteAsync inside the
+ * tool frame budget. That stores the result in FAssetReadCache (a text file's in
+ * FToolResultCache), so the agent's first read_asset of the item is served from memory. With
+ * "Mention Prefetch" set to Attach To Prompt, the chat input also puts the finished summary
+ * in the prompt, so the agent doesn't have to ask for it at all.
+ *
+ * An asset's prefetch is dropped as soon as its package is modified, undone/redone or a
+ * Blueprint compiles, the same events that invalidate FAssetReadCache, so a summary is never
+ * attached after the asset changed. Sending the message clears every prefetch.
+ * Game thread only.
+ */
+class NEOSTACK_API FNeoStackMentionPrefetcher
+{
+public:
+	static FNeoStackMentionPrefetcher& Get();
+
+	/** Start reading a mentioned item (FContextItem::FullPath) unless the setting is off or it already runs */
+	void Prefetch(const FString& FullPath);
+
+	/** Stop a prefetch that wasn't needed after all (the mention was removed) */
+	void Cancel(const FString& FullPath);
+
+	/**
+	 * The read_asset output for a mentioned item, if its prefetch finished successfully
+	 * @return False while it still runs, after it failed, or if it never started
+	 */
+	bool GetResult(const FString& FullPath, FString& OutOutput) const;
+
+	/** Cancel and drop every prefetch (the message that mentioned them was sent) */
+	void Clear();
+
+	/** Unregister delegates and cancel everything (module shutdown) */
+	void Shutdown();
+
+private:
+	FNeoStackMentionPrefetcher() = default;
+
+	/** Mentions of one message rarely exceed a handful; older prefetches are dropped */
+	static constexpr int32 MaxEntries = 32;
+
+	enum class EState : uint8
+	{
+		Loading,
+		Reading,
+		Done,
+		Failed
+	};
+
+	struct FPrefetch
+	{
+		EState State = EState::Loading;
+		FString Output;
+		TSharedPtr<FNeoStackCancellationToken> CancelToken;
+
+		/** Tells the callbacks of a cancelled prefetch from those of a newer one for the same path */
+		uint32 Serial = 0;
+	};
+
+	/** read_asset arguments for a mentioned item */
+	static TSharedRef<class FJsonObject> MakeReadArgs(const FString& FullPath);
+
+	/** Run read_asset for an entry whose package (if any) is loaded */
+	void StartRead(const FString& FullPath);
+
+	/** True if the callback for Serial still belongs to the entry at FullPath */
+	bool IsCurrent(const FString& FullPath, uint32 Serial) const;
+
+	void RegisterDelegates();
+
+	/** Drop the prefetches of Object's package; what they read no longer matches it */
+	void InvalidatePackage(const UObject* Object);
+
+	void HandleObjectModified(UObject* Object);
+	void HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
+	void HandleBlueprintCompiled();
+
+	/** FullPath -> prefetch; the lowest Serial is evicted first */
+	TMap<FString, FPrefetch> Entries;
+
+	uint32 NextSerial = 1;
+	bool bDelegatesRegistered = false;
+};
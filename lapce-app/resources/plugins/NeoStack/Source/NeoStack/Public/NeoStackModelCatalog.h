@@ -0,0 +1,107 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+
+/** Structure to hold OpenRouter model data */
+struct FOpenRouterModelInfo
+{
+	FString ID;
+	FString Name;
+	FString Description;
+	int32 ContextLength;
+	FString PromptCost;      // Cost per token as string
+	FString CompletionCost;  // Cost per token as string
+	FString Provider;        // Extracted from ID (e.g., "anthropic" from "anthropic/claude-3")
+
+	/** Lowercased name, ID, provider and description, built once for search */
+	FString SearchKey;
+
+	FOpenRouterModelInfo()
+		: ContextLength(0)
+	{}
+};
+
+/**
+ * The OpenRouter model list, cached on disk between sessions.
+ *
+ * Whatever was cached is loaded on the thread pool and shown as soon as it is parsed. The
+ * backend is then asked for a newer list with If-None-Match / If-Modified-Since, so an
+ * unchanged catalog costs a 304 and no parse at all. Every JSON parse and the cache write
+ * happen off the game thread; public functions are game thread only.
+ */
+class NEOSTACK_API FNeoStackModelCatalog
+{
+public:
+	static FNeoStackModelCatalog& Get();
+
+	/** Load the disk cache if needed and start a conditional refresh unless one ran recently */
+	void Request();
+
+	/** Current models, empty until the cache or the first response is parsed */
+	const TArray<TSharedPtr<FOpenRouterModelInfo>>& GetModels() const { return Models; }
+
+	/** True while the cache is loading or a refresh is in flight */
+	bool IsLoading() const { return bLoadingCache || bRefreshing; }
+
+	/** Error from the last refresh, empty if it succeeded */
+	const FString& GetError() const { return LastError; }
+
+	/** Fired when the models or the loading state change */
+	FSimpleMulticastDelegate& OnUpdated() { return UpdatedEvent; }
+
+	/** Minimum seconds between two refreshes within one session */
+	static constexpr double MinRefreshIntervalSeconds = 300.0;
+
+private:
+	/** Parsed catalog plus the validators that came with it */
+	struct FCatalog
+	{
+		TArray<TSharedPtr<FOpenRouterModelInfo>> Models;
+		FString ETag;
+		FString LastModified;
+		FString BackendURL;
+	};
+
+	static FString GetCacheFilePath();
+
+	/** Background: read and parse the cache file */
+	static bool LoadCache(FCatalog& OutCatalog);
+
+	/** Background: write the catalog in the compact cache format */
+	static void SaveCache(const FCatalog& Catalog);
+
+	/** Background: parse a backend response ({"data": [...]}) */
+	static bool ParseResponse(const FString& Content, TArray<TSharedPtr<FOpenRouterModelInfo>>& OutModels);
+
+	/** Fill in derived fields (display name, provider, search key) */
+	static void FinalizeModel(FOpenRouterModelInfo& Model);
+
+	static FString ExtractProvider(const FString& ModelID);
+
+	void StartRefresh();
+	void OnRefreshResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	/** Game thread: install a parsed catalog */
+	void InstallCatalog(FCatalog&& Catalog);
+
+	TArray<TSharedPtr<FOpenRouterModelInfo>> Models;
+	FString ETag;
+	FString LastModified;
+	FString BackendURL;
+	FString LastError;
+
+	FSimpleMulticastDelegate UpdatedEvent;
+
+	bool bCacheRequested = false;
+	bool bLoadingCache = false;
+	bool bRefreshing = false;
+
+	/** Refresh was requested while the cache was still loading */
+	bool bRefreshAfterLoad = false;
+
+	/** FPlatformTime::Seconds() of the last refresh attempt */
+	double LastRefreshTime = 0.0;
+};
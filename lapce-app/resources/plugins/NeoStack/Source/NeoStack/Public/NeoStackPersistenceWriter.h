@@ -0,0 +1,112 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+
+class IFileHandle;
+
+/**
+ * Dedicated thread that owns all conversation file I/O.
+ *
+ * The game thread only pushes operations into a lock-free queue. Everything submitted
+ * during one frame is written as a group when the frame ends, and open files are synced
+ * to disk at most every SyncInterval seconds, which bounds what a crash can lose.
+ * Operations on the same file are applied in submission order.
+ */
+class NEOSTACK_API FNeoStackPersistenceWriter : public FRunnable
+{
+public:
+	/** Produces the text to write; runs on the writer thread so serialization stays off the game thread */
+	using FContentProducer = TUniqueFunction<FString()>;
+
+	explicit FNeoStackPersistenceWriter(float InSyncInterval);
+	virtual ~FNeoStackPersistenceWriter();
+
+	/**
+	 * Append Content() plus a newline to the file (kept open between writes)
+	 * @param IndexPath - Optional offset index: the line's start offset is appended to it as int64
+	 */
+	void AppendLine(const FString& Path, FContentProducer&& Content, const FString& IndexPath = FString());
+
+	/** Replace the whole file with Content() */
+	void ReplaceFile(const FString& Path, FContentProducer&& Content);
+
+	/** Replace the whole file with raw bytes */
+	void ReplaceFileBytes(const FString& Path, TArray<uint8>&& Bytes);
+
+	/** Close the file if it is open and delete it */
+	void RemoveFile(const FString& Path);
+
+	/** Block until every operation submitted so far is on disk */
+	void Flush();
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+private:
+	enum class EOpType : uint8
+	{
+		Append,
+		Replace,
+		ReplaceBytes,
+		Delete
+	};
+
+	struct FOp
+	{
+		EOpType Type = EOpType::Append;
+		FString Path;
+		FString IndexPath;
+		FContentProducer Content;
+		TArray<uint8> Bytes;
+	};
+
+	/** Queue an operation and make sure the end-of-frame commit is scheduled */
+	void Submit(FOp&& Op);
+
+	/** One-shot ticker: wakes the writer once per frame that submitted work */
+	bool OnEndOfFrame(float DeltaTime);
+
+	/** Writer thread: apply everything queued so far */
+	void DrainQueue();
+
+	/** Writer thread: sync all open files to disk */
+	void SyncOpenFiles();
+
+	/** Writer thread: open (or reuse) an append handle */
+	IFileHandle* GetAppendHandle(const FString& Path);
+
+	/** Pending operations (many producers in principle, one consumer) */
+	TQueue<FOp, EQueueMode::Mpsc> Queue;
+
+	/** Operations submitted but not yet applied */
+	FThreadSafeCounter PendingOps;
+
+	/** Open append handles, writer thread only */
+	TMap<FString, TUniquePtr<IFileHandle>> OpenFiles;
+
+	/** Set when files were written since the last sync, writer thread only */
+	bool bDirty = false;
+
+	/** Seconds between syncs to disk */
+	float SyncInterval;
+
+	/** Wakes the writer thread */
+	FEvent* WakeEvent = nullptr;
+
+	/** Writer thread */
+	FRunnableThread* Thread = nullptr;
+
+	/** End-of-frame commit ticker (game thread) */
+	FTSTicker::FDelegateHandle CommitHandle;
+
+	FThreadSafeBool bShouldStop;
+};
@@ -0,0 +1,182 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/TopLevelAssetPath.h"
+
+struct FAssetData;
+
+/**
+ * One table of every asset under /Game, shared by explore, the @-context index and the Bridge
+ * so none of them scans the Asset Registry on its own.
+ *
+ * Rows are stored as parallel columns. Package paths, class paths and the summary strings read
+ * from registry tags (Blueprint parent class, implemented interfaces) are interned, so a
+ * project with thousands of assets keeps a few hundred distinct strings. A path query tests
+ * each distinct package path once and then only compares ids.
+ *
+ * The table is saved to Intermediate/NeoStack. When the registry is still discovering assets
+ * the saved table answers queries until discovery finishes, then the table is rebuilt from
+ * the registry and kept current from its add, remove, rename and update events.
+ * All public functions are game thread only.
+ */
+class NEOSTACK_API FNeoStackProjectCatalog
+{
+public:
+	/** Fired per asset after a row was added, replaced or (bRemoved) dropped */
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnAssetChanged, const FString& /*ObjectPath*/, bool /*bRemoved*/);
+
+	static FNeoStackProjectCatalog& Get();
+
+	/** Load or build the table and subscribe to registry events if that has not happened yet */
+	void EnsureBuilt();
+
+	/** Drop the registry subscriptions and write a pending save */
+	void Shutdown();
+
+	/** True once the table holds either the saved or the registry's view of the project */
+	bool IsReady() const { return bReady; }
+
+	/** True while the rows come from the saved table and the registry is still discovering */
+	bool IsFromCache() const { return bFromCache; }
+
+	int32 Num() const { return AssetNames.Num(); }
+
+	/**
+	 * Rows in a package path, like IAssetRegistry::GetAssetsByPath
+	 * @param PackagePath - /Game or a folder below it
+	 * @param bRecursive - Include sub-folders
+	 */
+	void FindInPath(const FString& PackagePath, bool bRecursive, TArray<int32>& OutRows) const;
+
+	/** @return Row of an asset object path (/Game/BP_Player.BP_Player), or INDEX_NONE */
+	int32 FindByObjectPath(const FString& ObjectPath) const;
+
+	/** @return Row of the main asset of a package, or INDEX_NONE */
+	int32 FindByPackage(FName PackageName) const;
+
+	FName GetAssetName(int32 Row) const { return AssetNames[Row]; }
+	FName GetPackageName(int32 Row) const { return PackageNames[Row]; }
+	const FString& GetPackagePath(int32 Row) const { return PackagePaths.Values[PackagePathIds[Row]]; }
+	const FTopLevelAssetPath& GetClassPath(int32 Row) const { return Classes.Values[ClassIds[Row]]; }
+
+	/** Interned id of a row's class; equal ids mean equal classes */
+	int32 GetClassId(int32 Row) const { return ClassIds[Row]; }
+	int32 NumClassIds() const { return Classes.Values.Num(); }
+	const FTopLevelAssetPath& GetClassPathById(int32 ClassId) const { return Classes.Values[ClassId]; }
+
+	/** /Game/BP_Player.BP_Player */
+	FString GetObjectPath(int32 Row) const;
+
+	/**
+	 * Blueprint parent class name from the ParentClassPath tag, as UClass::GetName() returns it
+	 * @return False if the asset has no such tag
+	 */
+	bool GetParentClass(int32 Row, FString& OutParentClass) const;
+
+	/**
+	 * Interface class names from the ImplementedInterfaces tag
+	 * @return False if the asset has no such tag
+	 */
+	bool GetInterfaces(int32 Row, TArray<FString>& OutInterfaces) const;
+
+	/** Full registry entry, for the few rows a caller needs tags or a load for */
+	FAssetData GetAssetData(int32 Row) const;
+
+	FOnAssetChanged& OnAssetChanged() { return AssetChangedEvent; }
+
+	/** Fired after the whole table was (re)built, from the saved file or from the registry */
+	FSimpleMulticastDelegate& OnRebuilt() { return RebuiltEvent; }
+
+	/** Seconds between the last change and writing the catalog file */
+	static constexpr float SaveDelaySeconds = 5.0f;
+
+private:
+	template <typename ValueType>
+	struct TInternPool
+	{
+		TArray<ValueType> Values;
+		TMap<ValueType, int32> Ids;
+
+		int32 Intern(const ValueType& Value)
+		{
+			if (const int32* Existing = Ids.Find(Value))
+			{
+				return *Existing;
+			}
+			const int32 Id = Values.Add(Value);
+			Ids.Add(Value, Id);
+			return Id;
+		}
+
+		void Reset()
+		{
+			Values.Reset();
+			Ids.Reset();
+		}
+	};
+
+	FNeoStackProjectCatalog() = default;
+
+	static FString GetCatalogFilePath();
+
+	/** Only assets the catalog covers get a row */
+	static bool IsCataloged(const FAssetData& Asset);
+
+	/** Replace every row with the registry's assets under /Game */
+	void RebuildFromRegistry();
+
+	/** Add or replace the row of an asset */
+	void SetRow(const FAssetData& Asset);
+
+	/** @return True if a row was removed */
+	bool RemoveRow(const FString& ObjectPath);
+
+	void ResetTable();
+
+	bool LoadCatalogFile();
+
+	/** Serialize the table here and write it, on the thread pool if bBackground */
+	void SaveCatalogFile(bool bBackground) const;
+
+	/** Schedule a save a few seconds out, coalescing bursts of changes */
+	void ScheduleSave();
+	bool HandleSaveTick(float DeltaTime);
+
+	void HandleFilesLoaded();
+	void HandleAssetAdded(const FAssetData& Asset);
+	void HandleAssetRemoved(const FAssetData& Asset);
+	void HandleAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath);
+	void HandleAssetUpdated(const FAssetData& Asset);
+
+	/** Columns, index-aligned by row */
+	TArray<FName> AssetNames;
+	TArray<FName> PackageNames;
+	TArray<int32> PackagePathIds;
+	TArray<int32> ClassIds;
+
+	/** Ids into Strings, INDEX_NONE when the asset has no such tag */
+	TArray<int32> ParentClassIds;
+	TArray<int32> InterfaceListIds;
+
+	TInternPool<FString> PackagePaths;
+	TInternPool<FTopLevelAssetPath> Classes;
+
+	/** Parent class names and comma-joined interface lists */
+	TInternPool<FString> Strings;
+
+	/** Object path -> row */
+	TMap<FName, int32> RowByObjectPath;
+
+	FOnAssetChanged AssetChangedEvent;
+	FSimpleMulticastDelegate RebuiltEvent;
+
+	FTSTicker::FDelegateHandle SaveHandle;
+
+	bool bStarted = false;
+	bool bReady = false;
+	bool bFromCache = false;
+	bool bShutdown = false;
+};
@@ -0,0 +1,55 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Incremental decoder for the backend's Server-Sent Events stream.
+ *
+ * The HTTP response body only ever grows while a request is streaming, so the parser
+ * remembers how many bytes it has already consumed and only scans the new tail on each
+ * progress tick. A "data:" line that is split across two ticks is carried over as raw
+ * bytes until its terminating newline arrives, which also keeps multi-byte UTF-8
+ * characters intact. Every complete data payload is emitted exactly once.
+ */
+class NEOSTACK_API FNeoStackSSEParser
+{
+public:
+	/** Called with the payload of each complete "data:" line (prefix stripped) */
+	using FOnData = TFunctionRef<void(const FString& /* Data */)>;
+
+	/**
+	 * Consume all bytes of the response body that have not been seen yet
+	 * @param Content - The full response body received so far
+	 * @param OnData - Invoked for every complete data line in the new bytes
+	 */
+	void Consume(const TArray<uint8>& Content, FOnData OnData);
+
+	/**
+	 * Consume a chunk of raw bytes that directly follows the previously consumed ones
+	 * @param Data - Pointer to the new bytes
+	 * @param Num - Number of new bytes
+	 * @param OnData - Invoked for every complete data line in the chunk
+	 */
+	void ConsumeBytes(const uint8* Data, int64 Num, FOnData OnData);
+
+	/** Emit a trailing line that was never terminated by a newline (end of stream) */
+	void Finish(FOnData OnData);
+
+	/** Forget all state so the parser can be reused for a new stream */
+	void Reset();
+
+	/** Number of response bytes consumed so far */
+	int64 GetProcessedBytes() const { return ProcessedBytes; }
+
+private:
+	/** Dispatch a single complete line (without its line terminator) */
+	static void ProcessLine(const uint8* Line, int32 Len, FOnData OnData);
+
+	/** Total number of bytes consumed from the response body */
+	int64 ProcessedBytes = 0;
+
+	/** Bytes of the current, not yet terminated line */
+	TArray<uint8> PendingLine;
+};
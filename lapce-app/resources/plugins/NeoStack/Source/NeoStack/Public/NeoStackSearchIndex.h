@@ -0,0 +1,108 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FNeoStackPersistenceWriter;
+
+/**
+ * One ranked search result: the best matching message of a conversation
+ */
+struct FConversationSearchHit
+{
+	int32 ConversationID = -1;
+	int32 MessageIndex = -1;
+	float Score = 0.0f;
+
+	/** Matching messages in the conversation */
+	int32 MatchCount = 0;
+
+	/** Text around the match (filled in by the conversation manager) */
+	FString Snippet;
+};
+
+/**
+ * Inverted index over the text of every saved conversation.
+ *
+ * Maps each lower-cased word to the messages containing it. New messages are added as
+ * they are appended, and each addition is persisted as one line of search_index.jsonl so
+ * the index never has to be rebuilt from the conversation files. The file is loaded on
+ * the first query, and rewritten from memory when deletions have piled up.
+ */
+class NEOSTACK_API FNeoStackSearchIndex
+{
+public:
+	explicit FNeoStackSearchIndex(const FString& InFilePath);
+
+	/** True once the persisted index has been read into memory */
+	bool IsLoaded() const { return bLoaded; }
+
+	/** True if the index file exists (otherwise it has to be built from the conversations) */
+	bool HasFile() const { return bHasFile; }
+
+	/** Read the persisted index. Returns false if there is none yet */
+	bool Load();
+
+	/** Index one message and persist the entry */
+	void AddMessage(int32 ConversationID, int32 MessageIndex, const FString& Text, FNeoStackPersistenceWriter& Writer);
+
+	/** Drop a conversation from the index and persist the removal */
+	void RemoveConversation(int32 ConversationID, FNeoStackPersistenceWriter& Writer);
+
+	/** Reset the in-memory index before a rebuild */
+	void BeginRebuild();
+
+	/** Index one message during a rebuild (memory only) */
+	void AddMessageForRebuild(int32 ConversationID, int32 MessageIndex, const FString& Text);
+
+	/** Write the whole in-memory index to disk, replacing the file */
+	void SaveSnapshot(FNeoStackPersistenceWriter& Writer);
+
+	/**
+	 * Messages containing every word of the query (the last word also matches as a prefix,
+	 * so results update while typing), one hit per conversation, best first
+	 */
+	TArray<FConversationSearchHit> Search(const FString& Query, int32 MaxResults) const;
+
+	/** Split text into index terms */
+	static void Tokenize(const FString& Text, TArray<FString>& OutTokens);
+
+private:
+	struct FPosting
+	{
+		int32 ConversationID;
+		int32 MessageIndex;
+		int32 Count;
+	};
+
+	/** Add the term counts of one message to the postings */
+	void AddTerms(int32 ConversationID, int32 MessageIndex, const TMap<FString, int32>& Terms);
+
+	/** Remove every posting of a conversation */
+	void RemovePostings(int32 ConversationID);
+
+	/** Count the terms of a piece of text */
+	static void CountTerms(const FString& Text, TMap<FString, int32>& OutTerms);
+
+	/** Serialize one message entry as a journal line */
+	static FString MakeEntryLine(int32 ConversationID, int32 MessageIndex, const TMap<FString, int32>& Terms);
+
+	/** Term -> messages containing it */
+	TMap<FString, TArray<FPosting>> Postings;
+
+	/** Number of indexed messages (for term weighting) */
+	int32 MessageCount = 0;
+
+	/** Removal lines in the file since the last snapshot */
+	int32 RemovalsSinceSnapshot = 0;
+
+	/** Removals after which the file is rewritten from memory */
+	static constexpr int32 MaxRemovalsBeforeSnapshot = 32;
+
+	/** Persisted index path */
+	FString FilePath;
+
+	bool bLoaded = false;
+	bool bHasFile = false;
+};
@@ -6,6 +6,20 @@
 #include "Engine/DeveloperSettings.h"
 #include "NeoStackSettings.generated.h"
 
+/** What is done with @-mentioned items before the message is sent */
+UENUM()
+enum class ENeoStackMentionPrefetch : uint8
+{
+	/** Read them when the agent asks */
+	Disabled,
+
+	/** Read them while the user types, so the agent's first read_asset is served from the tool cache */
+	WarmToolCache UMETA(DisplayName="Warm Tool Cache"),
+
+	/** Read them while the user types and put asset summaries in the prompt */
+	AttachToPrompt UMETA(DisplayName="Attach To Prompt")
+};
+
 /**
  * Settings for the NeoStack plugin
  * Appears in Project Settings under Game category
@@ -27,6 +41,69 @@ public:
 	UPROPERTY(config, EditAnywhere, Category="Connection", meta=(DisplayName="Backend URL"))
 	FString BackendURL;
 
+	/** Send only the messages the backend has not acknowledged yet instead of the full history every turn */
+	UPROPERTY(config, EditAnywhere, Category="Connection", meta=(DisplayName="Delta History Upload"))
+	bool bDeltaHistoryUpload;
+
+	/**
+	 * Old tool results in the uploaded history are shortened once it exceeds this many estimated tokens (0 = never).
+	 * With delta upload, shortening a result the backend already cached re-sends the full history once.
+	 */
+	UPROPERTY(config, EditAnywhere, Category="Connection", meta=(DisplayName="History Token Budget", ClampMin="0"))
+	int32 HistoryTokenBudget;
+
+	/** Conversation files are synced to disk at least this often (seconds); a crash loses at most this much */
+	UPROPERTY(config, EditAnywhere, Category="Storage", meta=(DisplayName="Persistence Sync Interval", ClampMin="0.05", UIMax="10.0"))
+	float PersistenceSyncInterval;
+
+	/** Tool results and images larger than this many characters are kept in the blob store, not in the conversation file (0 = always inline) */
+	UPROPERTY(config, EditAnywhere, Category="Storage", meta=(DisplayName="Blob Threshold", ClampMin="0"))
+	int32 BlobThreshold;
+
+	/** Attached images are downscaled so their longest edge is at most this many pixels (0 = keep original size) */
+	UPROPERTY(config, EditAnywhere, Category="Images", meta=(DisplayName="Max Image Edge", ClampMin="0", UIMin="256", UIMax="4096"))
+	int32 MaxImageEdge;
+
+	/** Streamed text is pushed to the chat at most once per frame, spending at most this many milliseconds */
+	UPROPERTY(config, EditAnywhere, Category="Interface", meta=(DisplayName="Stream Update Budget (ms)", ClampMin="0.5", UIMax="16.0"))
+	float StreamUpdateBudgetMs;
+
+	/** Defer tool registration, conversation loading and model lists until the NeoStack tab is first shown or the bridge gets its first command */
+	UPROPERTY(config, EditAnywhere, Category="Startup", meta=(DisplayName="Lazy Initialization"))
+	bool bLazyInitialization;
+
+	/** Keep a trigram index of project source (Intermediate/NeoStack) so explore code searches only read files that can match */
+	UPROPERTY(config, EditAnywhere, Category="Search", meta=(DisplayName="Index Code Search"))
+	bool bCodeSearchIndex;
+
+	/** Network or DDC-like folder with indexes prebuilt by the NeoStackTools commandlet (-publishIndexes); copied into Intermediate/NeoStack at startup when missing there */
+	UPROPERTY(config, EditAnywhere, Category="Search", meta=(DisplayName="Shared Index Path"))
+	FString SharedIndexPath;
+
+	/** Save node names given to edit_graph (Saved/NeoStack) so they still resolve after an editor restart */
+	UPROPERTY(config, EditAnywhere, Category="Tools", meta=(DisplayName="Persist Node Names"))
+	bool bPersistNodeNames;
+
+	/** Tools run from the chat share at most this many milliseconds of game-thread time per frame (a tool that cannot be split may overrun it) */
+	UPROPERTY(config, EditAnywhere, Category="Tools", meta=(DisplayName="Tool Frame Budget (ms)", ClampMin="0.5", UIMax="33.0"))
+	float ToolFrameBudgetMs;
+
+	/** Reuse results of identical read_asset, explore and find_node calls while the assets they read are unchanged */
+	UPROPERTY(config, EditAnywhere, Category="Tools", meta=(DisplayName="Cache Tool Results"))
+	bool bCacheToolResults;
+
+	/** Read @-mentioned assets and files in the background as soon as they are picked */
+	UPROPERTY(config, EditAnywhere, Category="Tools", meta=(DisplayName="Mention Prefetch"))
+	ENeoStackMentionPrefetch MentionPrefetch;
+
+	/** Leave the garbage collection a Blueprint compile ends with to the editor when a tool compiles (tools compile once per batch of calls either way) */
+	UPROPERTY(config, EditAnywhere, Category="Tools", meta=(DisplayName="Skip GC After Tool Compiles"))
+	bool bSkipGCAfterToolCompiles;
+
+	/** Record each agent turn as one snapshot of the assets it changes instead of an undo transaction per edit; NeoStack.RollbackTurn restores the last turn */
+	UPROPERTY(config, EditAnywhere, Category="Tools", meta=(DisplayName="Turn Checkpoints"))
+	bool bTurnCheckpoints;
+
 	/** Get the singleton instance */
 	static UNeoStackSettings* Get();
 
@@ -0,0 +1,46 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A backend response body as it arrived over the network: the bytes each progress tick added
+ * and when, relative to the start of the request. Chunk boundaries are kept exactly, so a
+ * replay splits lines and UTF-8 sequences the same way the live stream did.
+ *
+ * With NeoStack.RecordStreams on, every successful /ai response is written to
+ * Saved/NeoStack/Recordings. NeoStack.ReplayStream plays one back into the chat and
+ * NeoStack.Perf sse -recording=File benchmarks decoding it, both without a backend.
+ */
+struct NEOSTACK_API FNeoStackStreamRecording
+{
+	struct FChunk
+	{
+		/** Seconds since the request was sent */
+		double Time = 0.0;
+
+		TArray<uint8> Bytes;
+	};
+
+	/** Chunks in arrival order */
+	TArray<FChunk> Chunks;
+
+	/** Append the bytes of one progress tick */
+	void AddChunk(double Time, const uint8* Data, int64 Num);
+
+	/** Total size of the recorded body */
+	int64 GetNumBytes() const;
+
+	/** Seconds from the request to the last chunk */
+	double GetDuration() const { return Chunks.Num() > 0 ? Chunks.Last().Time : 0.0; }
+
+	bool SaveToFile(const FString& FilePath) const;
+	bool LoadFromFile(const FString& FilePath);
+
+	/** Saved/NeoStack/Recordings */
+	static FString GetRecordingDir();
+
+	/** True while NeoStack.RecordStreams is set */
+	static bool IsRecordingEnabled();
+};
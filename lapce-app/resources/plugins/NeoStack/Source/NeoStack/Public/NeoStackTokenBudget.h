@@ -0,0 +1,63 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FConversationMessage;
+
+/**
+ * Fast local token estimate for conversation content.
+ *
+ * Not a real tokenizer - one pass over the text that counts ASCII word runs as one token
+ * per four characters and every symbol or non-ASCII character as its own token. That
+ * tracks BPE tokenizers closely enough on code, JSON and prose to budget a request.
+ */
+class NEOSTACK_API FNeoStackTokenEstimator
+{
+public:
+	/** Estimated tokens of a piece of text */
+	static int32 EstimateText(const FString& Text);
+
+	/** Estimated tokens of a whole message (content, tool calls, images, framing) */
+	static int32 EstimateMessage(const FConversationMessage& Message);
+
+	/** Estimated tokens of a history, using cached per-message estimates where possible */
+	static int32 EstimateHistory(const TArray<FConversationMessage>& History);
+
+	/** Flat cost assumed for one attached image */
+	static constexpr int32 ImageTokens = 1000;
+
+	/** Per-message framing overhead (role, separators) */
+	static constexpr int32 MessageOverheadTokens = 4;
+};
+
+/**
+ * Decides which tool results to shorten so a history fits a token budget.
+ *
+ * Works on the outgoing request only - the conversation log on disk always keeps the
+ * full results. The oldest large tool results are replaced first, and everything after
+ * the latest user message (the turn the model is working on) is never touched.
+ */
+class NEOSTACK_API FNeoStackHistoryCompactor
+{
+public:
+	/**
+	 * Pick digests for the history
+	 * @param History - Messages that will be sent
+	 * @param TokenBudget - Target size of the history (0 or less disables compaction)
+	 * @param OutDigests - Message index -> replacement content
+	 * @return Estimated history size after compaction
+	 */
+	static int32 Compact(const TArray<FConversationMessage>& History, int32 TokenBudget, TMap<int32, FString>& OutDigests);
+
+	/** Short digest of a tool result: head and tail of the text plus an omission marker */
+	static FString MakeDigest(const FString& Result, int32 EstimatedTokens);
+
+	/** Tool results at or below this size are never worth compacting */
+	static constexpr int32 MinCompactTokens = 256;
+
+	/** Characters kept from the start and end of a compacted result */
+	static constexpr int32 DigestHeadChars = 600;
+	static constexpr int32 DigestTailChars = 200;
+};
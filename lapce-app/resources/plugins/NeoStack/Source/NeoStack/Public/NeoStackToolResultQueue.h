@@ -0,0 +1,96 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Http.h"
+#include "Containers/Ticker.h"
+
+class FJsonObject;
+struct FNeoStackProcessedImage;
+
+/**
+ * A tool result waiting to be delivered to the backend
+ */
+struct FPendingToolResult
+{
+	FString SessionID;
+	FString CallID;
+	FString Result;
+
+	/** Attached images, sent as multimodal parts next to the text */
+	TArray<TSharedPtr<const FNeoStackProcessedImage>> Images;
+};
+
+/**
+ * Ordered submission queue for tool results.
+ *
+ * Results submitted during the same frame are flushed together on the next core tick as
+ * one POST to /ai/tool-results, so a turn with many UE5 tool calls costs one request per
+ * frame instead of one per call. Only one batch is in flight at a time, which keeps the
+ * results in submission order. All requests go through the same keep-alive connection to
+ * the backend. Failed batches are retried with exponential backoff; if the backend has no
+ * batch endpoint (404) the queue falls back to the single-result endpoint.
+ *
+ * While a session is held (tool calls of its turn still running) its results stay queued,
+ * so the results of calls running side by side go out together once the last one finishes.
+ */
+class NEOSTACK_API FNeoStackToolResultQueue
+{
+public:
+	/** Get the singleton instance */
+	static FNeoStackToolResultQueue& Get();
+
+	/** Queue a result; it is sent with everything else queued this frame */
+	void Enqueue(const FString& SessionID, const FString& CallID, const FString& Result,
+		const TArray<TSharedPtr<const FNeoStackProcessedImage>>& Images = {});
+
+	/** Keep SessionID's results queued until the matching Release; holds nest */
+	void Hold(const FString& SessionID);
+
+	/** Undo one Hold; the last one lets the session's results be sent */
+	void Release(const FString& SessionID);
+
+	/** Number of results not yet acknowledged by the backend */
+	int32 GetPendingCount() const { return Pending.Num() + InFlight.Num(); }
+
+private:
+	FNeoStackToolResultQueue() = default;
+
+	/** Arm the ticker so the queue is flushed after Delay seconds (0 = next tick) */
+	void ScheduleFlush(float Delay);
+
+	/** Ticker callback - sends the next batch */
+	bool OnFlush(float DeltaTime);
+
+	/** Send everything currently pending as one request */
+	void SendBatch();
+
+	/** Session, call ID, result text and images of an entry */
+	static TSharedRef<FJsonObject> MakeResultObject(const FPendingToolResult& Entry);
+
+	/** Handle the backend's response for the in-flight batch */
+	void OnBatchComplete(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	/** Results queued but not yet sent */
+	TArray<FPendingToolResult> Pending;
+
+	/** Session -> outstanding holds */
+	TMap<FString, int32> Holds;
+
+	/** Results of the request that is currently in flight */
+	TArray<FPendingToolResult> InFlight;
+
+	/** Ticker handle while a flush is scheduled */
+	FTSTicker::FDelegateHandle FlushHandle;
+
+	/** Consecutive failed attempts for the in-flight batch */
+	int32 RetryCount = 0;
+
+	/** Set once the backend reported that it has no batch endpoint */
+	bool bBatchUnsupported = false;
+
+	/** Retry give-up limit and backoff base (seconds) */
+	static constexpr int32 MaxRetries = 5;
+	static constexpr float RetryBaseDelay = 0.5f;
+};
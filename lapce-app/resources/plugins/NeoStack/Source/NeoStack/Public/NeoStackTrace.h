@@ -0,0 +1,18 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Unreal Insights trace channels for NeoStack
+ *
+ * Enable with -trace=cpu,NeoStackTools,NeoStackNet (or "Trace.Enable NeoStackTools" at runtime)
+ * to see tool executions, scheduler steps and bridge commands (NeoStackTools), and SSE parsing
+ * and tool-result submission (NeoStackNet), as CPU timing scopes. Tool scopes are named
+ * after the tool, so a slow turn shows which call it was.
+ */
+UE_TRACE_CHANNEL_EXTERN(NeoStackToolsChannel, NEOSTACK_API);
+UE_TRACE_CHANNEL_EXTERN(NeoStackNetChannel, NEOSTACK_API);
@@ -20,6 +20,12 @@ public:
 	void Construct(const FArguments& InArgs);
 
 private:
+	/** Build the real UI (sidebar, chat, input) */
+	void BuildContent();
+
+	/** First tick after the tab is shown in lazy mode */
+	EActiveTimerReturnType OnDeferredInitialize(double InCurrentTime, float InDeltaTime);
+
 	/** Reference to the sidebar widget */
 	TSharedPtr<class SNeoStackSidebar> Sidebar;
 
@@ -53,6 +59,15 @@ private:
 	/** Load and display messages from a conversation */
 	void LoadConversationIntoChat(int32 ConversationID);
 
+	/** Replay stored messages into the chat area */
+	void ReplayMessages(const TArray<struct FConversationMessage>& Messages);
+
+	/** Chat area scrolled to the top - page in older messages */
+	void OnLoadOlderMessages();
+
+	/** Messages loaded per scroll-back page */
+	static constexpr int32 OlderMessagesPageSize = 40;
+
 	/** Handle tool approval - execute tool and submit result */
 	void OnToolApproved(const FString& CallID, const FString& ToolName, const FString& Args);
 
@@ -0,0 +1,65 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Package dependency edges from the Asset Registry, cached in both directions
+ *
+ * Explore's reference filters and its dependencies mode ask the registry for the same packages
+ * over and over; each package's dependencies and referencers are asked for once and kept until
+ * the catalog reports a change. A changed package drops its own dependency list and every
+ * cached referencer list, since any of them may have gained or lost it. Nothing is loaded, so
+ * answering "who references X" costs registry lookups only. Game thread only.
+ */
+class NEOSTACK_API FAssetDependencyGraph
+{
+public:
+	enum class EDirection : uint8
+	{
+		Dependencies,
+		Referencers,
+	};
+
+	/** One package reached by Walk */
+	struct FVisit
+	{
+		FName PackageName;
+		EDirection Direction = EDirection::Dependencies;
+
+		/** Edges from the start package; 1 for direct neighbours */
+		int32 Depth = 0;
+	};
+
+	static FAssetDependencyGraph& Get();
+
+	/** Packages PackageName depends on (hard and soft) */
+	const TArray<FName>& GetDependencies(FName PackageName);
+
+	/** Packages that depend on PackageName (hard and soft) */
+	const TArray<FName>& GetReferencers(FName PackageName);
+
+	/**
+	 * Breadth-first walk from PackageName, visiting each package once per direction at its
+	 * shortest depth. The start package is not visited.
+	 * @param MaxDepth - Edges to follow; 1 lists direct neighbours only
+	 */
+	void Walk(FName PackageName, EDirection Direction, int32 MaxDepth, TArray<FVisit>& OutVisits);
+
+	/** Unsubscribe and drop all edges (module shutdown) */
+	void Shutdown();
+
+private:
+	FAssetDependencyGraph() = default;
+
+	void EnsureSubscribed();
+
+	void HandleCatalogAssetChanged(const FString& ObjectPath, bool bRemoved);
+	void HandleCatalogRebuilt();
+
+	TMap<FName, TArray<FName>> Dependencies;
+	TMap<FName, TArray<FName>> Referencers;
+
+	bool bSubscribed = false;
+};
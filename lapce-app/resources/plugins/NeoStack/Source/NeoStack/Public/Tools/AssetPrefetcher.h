@@ -0,0 +1,54 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UObjectGlobals.h"
+
+class FJsonObject;
+
+/**
+ * Starts loading the packages a tool call will open before the call runs
+ *
+ * The assets a call works on are known from its arguments as soon as the backend streams it:
+ * the "name"/"path" pair, plus any string argument holding an asset or object path. Prefetch
+ * issues LoadPackageAsync for every such package that exists and is not in memory yet, so the
+ * cold loads of a whole batch of calls overlap instead of each tool's LoadObject blocking the
+ * game thread in turn. Packages are checked against FNeoStackProjectCatalog (or the disk while
+ * it is not ready), so paths of assets a call is about to create start nothing.
+ *
+ * Only asynchronous calls are prefetched: the registry does not step one while any of its
+ * packages is still loading. A synchronous call loads its assets itself, since it would block
+ * on them right away either way. Game thread only.
+ */
+class NEOSTACK_API FAssetPrefetcher
+{
+public:
+	static FAssetPrefetcher& Get();
+
+	/**
+	 * Start loading the packages a call references
+	 * @return The packages the call has to wait for (already loaded ones are left out)
+	 */
+	TArray<FName> Prefetch(const TSharedPtr<FJsonObject>& Args);
+
+	/** True while any of the packages is still loading */
+	bool IsLoading(const TArray<FName>& Packages) const;
+
+	/** Packages looked at per call; arrays of hundreds of paths only prefetch the first ones */
+	static constexpr int32 MaxPackagesPerCall = 32;
+
+private:
+	FAssetPrefetcher() = default;
+
+	/** Add the package of an asset, object or export-text path to OutPackages if it names an existing package */
+	static void AddCandidate(const FString& Value, TArray<FName>& OutPackages);
+
+	/** Collect path-like strings from a JSON object and its nested objects and arrays */
+	static void ScanValue(const TSharedPtr<class FJsonValue>& Value, TArray<FName>& OutPackages, int32 Depth);
+
+	void HandleLoaded(const FName& PackageName, UPackage* Package, EAsyncLoadingResult::Type Result);
+
+	/** Package -> async load request id */
+	TMap<FName, int32> Pending;
+};
@@ -0,0 +1,73 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectSaveContext.h"
+
+class FTransactionObjectEvent;
+struct FPropertyChangedEvent;
+
+/**
+ * Rendered read_asset output, cached per package and request
+ *
+ * Each package has an edit generation that is bumped whenever one of its objects is modified,
+ * has a property changed, is undone/redone or saved, whenever any Blueprint compiles, and when
+ * an edit tool reports that it touched the asset. A cached section is only returned while its
+ * package is still at the generation it was rendered at, so repeated reads of an unchanged
+ * asset skip re-rendering entirely. Game thread only.
+ */
+class NEOSTACK_API FAssetReadCache
+{
+public:
+	static FAssetReadCache& Get();
+
+	/** Cached output for Key on the asset's package, or null if missing or stale */
+	const FString* Find(const UObject* Asset, const FString& Key);
+
+	/** Remember output rendered for Key at the package's current generation */
+	void Store(const UObject* Asset, const FString& Key, const FString& Output);
+
+	/** Mark everything cached for the asset's package stale (edit tools call this after changing it) */
+	void Invalidate(const UObject* Asset);
+
+	/** Unregister delegates and drop all entries (module shutdown) */
+	void Shutdown();
+
+private:
+	static constexpr int32 MaxCachedPackages = 32;
+
+	struct FPackageEntry
+	{
+		/** Generation the cached sections were rendered at */
+		uint32 RenderedGeneration = 0;
+		TMap<FString, FString> Sections;
+		uint64 LastUsed = 0;
+	};
+
+	FAssetReadCache() = default;
+
+	void RegisterDelegates();
+
+	/** Bump the generation of the package that owns Object */
+	void BumpGeneration(const UObject* Object);
+
+	uint32 GetGeneration(FName PackageName) const;
+
+	void HandleObjectModified(UObject* Object);
+	void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+	void HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
+	void HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext);
+	void HandleBlueprintCompiled();
+
+	TMap<FName, FPackageEntry> Entries;
+
+	/** Package -> edit generation; only tracked for packages with cached sections */
+	TMap<FName, uint32> Generations;
+
+	/** Bumped on any Blueprint compile; folded into every package's generation */
+	uint32 CompileGeneration = 0;
+
+	uint64 UseCounter = 0;
+	bool bDelegatesRegistered = false;
+};
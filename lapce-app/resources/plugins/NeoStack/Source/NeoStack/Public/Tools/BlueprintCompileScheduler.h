@@ -0,0 +1,149 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UBlueprint;
+
+/** What one Blueprint compile produced, handed to every call that asked for it */
+struct NEOSTACK_API FBlueprintCompileReport
+{
+	FString BlueprintName;
+	int32 NumErrors = 0;
+	int32 NumWarnings = 0;
+
+	/** "error: ..." and "warning: ..." lines */
+	TArray<FString> Messages;
+
+	/** Calls that asked for this compile */
+	int32 NumRequests = 0;
+
+	double DurationMs = 0.0;
+};
+
+/**
+ * Compiles Blueprints for the tools, once per Blueprint per tool batch
+ *
+ * Edit tools report structural changes and compile requests here instead of compiling
+ * themselves. Repeats for the same Blueprint merge, and the work is done when the batch
+ * is over: the registry flushes once no tool call is left running, or the ticker does on
+ * the next frame for calls made outside the registry. A full compile covers a pending
+ * skeleton update; otherwise the skeleton is regenerated once. Calls that need the
+ * current class before then (reads, bindings) flush one Blueprint with FlushBlueprint, or
+ * with RegenerateSkeleton when a stale skeleton is all they need.
+ *
+ * A call that asked for a compile only gets its result once the compile ran: the registry
+ * holds it back and then runs the call's FOnCompiled with the report, which by default
+ * appends an error/warning summary. A call held back too long while other calls keep the
+ * batch open has its own compiles run early with FlushCaller. The "Skip GC After Tool Compiles" setting leaves the
+ * garbage collection a compile normally ends with to the editor's own schedule.
+ * Game thread only.
+ */
+class NEOSTACK_API FBlueprintCompileScheduler
+{
+public:
+	/** Adds the compile outcome to the result of the call that asked for it */
+	using FOnCompiled = TFunction<void(const FBlueprintCompileReport& /*Report*/, FString& /*InOutOutput*/)>;
+
+	static FBlueprintCompileScheduler& Get();
+
+	/** Mark the Blueprint modified now and regenerate its skeleton when the batch is over */
+	void MarkStructurallyModified(UBlueprint* Blueprint);
+
+	/** Fully compile the Blueprint when the batch is over; OnCompiled defaults to a summary line */
+	void RequestCompile(UBlueprint* Blueprint, FOnCompiled&& OnCompiled = nullptr);
+
+	/**
+	 * Do what is pending for the Blueprint now
+	 * @return False if nothing was pending
+	 */
+	bool FlushBlueprint(UBlueprint* Blueprint);
+
+	/** Do everything pending (end of the batch) */
+	void FlushAll();
+
+	/** Compile the Blueprints the call is waiting for now, ahead of the rest of the batch */
+	void FlushCaller(uint32 CallerId);
+
+	/**
+	 * Bring the Blueprint's skeleton class up to date for a read
+	 * Flushes what is pending for it, which covers the skeleton, or else regenerates only the
+	 * skeleton without marking the Blueprint modified.
+	 */
+	void RegenerateSkeleton(UBlueprint* Blueprint);
+
+	bool HasPending() const { return Pending.Num() > 0; }
+
+	/** Attributes the requests made while it lives to one tool call */
+	class FCallerScope
+	{
+	public:
+		explicit FCallerScope(uint32 CallerId);
+		~FCallerScope();
+
+	private:
+		uint32 PreviousCaller;
+	};
+
+	/** A new ID for a tool call */
+	uint32 MakeCallerId() { return NextCallerId++; }
+
+	/** True while a compile the call asked for hasn't run yet */
+	bool IsWaiting(uint32 CallerId) const;
+
+	/** Run the call's FOnCompiled for its finished compiles on its output, then forget them */
+	void ApplyReports(uint32 CallerId, FString& InOutOutput);
+
+	/** Drop everything pending without compiling (module shutdown) */
+	void Shutdown();
+
+private:
+	FBlueprintCompileScheduler() = default;
+
+	struct FRequest
+	{
+		uint32 CallerId = 0;
+		FOnCompiled OnCompiled;
+	};
+
+	struct FPendingCompile
+	{
+		TWeakObjectPtr<UBlueprint> Blueprint;
+
+		/** MarkBlueprintAsStructurallyModified is due */
+		bool bStructural = false;
+
+		/** Compile requests; empty for a skeleton update only */
+		TArray<FRequest> Requests;
+	};
+
+	struct FCompletedReport
+	{
+		FBlueprintCompileReport Report;
+		FOnCompiled OnCompiled;
+	};
+
+	FPendingCompile& FindOrAddPending(UBlueprint* Blueprint);
+
+	void Compile(FPendingCompile& Entry);
+
+	/** Flushes work queued outside the registry once no tool call is running */
+	bool HandleTick(float DeltaTime);
+
+	static void AppendSummary(const FBlueprintCompileReport& Report, FString& InOutOutput);
+
+	/** In request order so compiles run in the order the edits were made */
+	TMap<TObjectKey<UBlueprint>, FPendingCompile> Pending;
+
+	/** Finished compiles per caller, waiting for its result */
+	TMap<uint32, TArray<FCompletedReport>> Completed;
+
+	uint32 CurrentCaller = 0;
+	uint32 NextCallerId = 1;
+
+	FTSTicker::FDelegateHandle TickHandle;
+};
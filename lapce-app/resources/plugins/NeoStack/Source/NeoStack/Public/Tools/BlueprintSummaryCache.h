@@ -0,0 +1,83 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+
+struct FAssetData;
+class UBlueprint;
+
+/** What explore needs to know about a Blueprint without loading it */
+struct FBlueprintSummary
+{
+	FString ParentClass;
+	TArray<FString> Interfaces;
+	TArray<FString> Variables;
+	TArray<FString> Functions;
+
+	/** SCS component variable names and template class names, index-aligned */
+	TArray<FString> ComponentNames;
+	TArray<FString> ComponentClasses;
+
+	int32 GraphCount = 0;
+};
+
+/**
+ * Per-Blueprint summaries keyed by package name and the package's saved hash.
+ *
+ * A summary stays valid as long as the package on disk is unchanged, so a repeated explore
+ * search answers component, variable and function filters without loading anything. Entries
+ * are built from the live object when the Blueprint is already in memory, and only otherwise
+ * by loading its package. The cache lives in Saved/NeoStack and is written on the thread pool,
+ * one save at a time; entries added while a save runs are written once it has finished.
+ * Game thread only.
+ */
+class NEOSTACK_API FBlueprintSummaryCache
+{
+public:
+	static FBlueprintSummaryCache& Get();
+
+	/**
+	 * Summary of a Blueprint asset
+	 * @param bOutLoaded - Set when the package had to be loaded to produce it
+	 * @return False if the asset is not a loadable Blueprint
+	 */
+	bool GetSummary(const FAssetData& Asset, FBlueprintSummary& OutSummary, bool& bOutLoaded);
+
+	/** Write the cache in the background if entries were added since the last save, or once the running save is done */
+	void SaveIfDirty();
+
+	/** Read a summary off a Blueprint */
+	static void Summarize(const UBlueprint* Blueprint, FBlueprintSummary& OutSummary);
+
+private:
+	struct FEntry
+	{
+		FString SavedHash;
+		FBlueprintSummary Summary;
+	};
+
+	FBlueprintSummaryCache() = default;
+
+	static FString GetCacheFilePath();
+
+	/** Saved hash of the package on disk, empty if the registry has none */
+	static FString GetSavedHash(FName PackageName);
+
+	void LoadIfNeeded();
+
+	static void SaveEntries(const TMap<FName, FEntry>& Entries);
+
+	/** Retries SaveIfDirty until the save in flight has finished */
+	bool HandleSaveRetryTick(float DeltaTime);
+
+	TMap<FName, FEntry> Entries;
+	bool bLoaded = false;
+	bool bDirty = false;
+
+	/** The save on the thread pool; both would write the same .tmp file */
+	TFuture<void> PendingSave;
+	FTSTicker::FDelegateHandle SaveRetryHandle;
+};
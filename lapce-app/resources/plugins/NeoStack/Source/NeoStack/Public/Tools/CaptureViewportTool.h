@@ -0,0 +1,73 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tools/NeoStackToolBase.h"
+
+class SWidget;
+
+/**
+ * Captures what the user sees so the agent can look at it
+ * - The active level viewport (including PIE running in it)
+ * - A graph editor panel: the focused one, or a graph of an asset (opened if needed)
+ *
+ * The pixels come straight from the window's back buffer, copied by the GPU right before it
+ * is presented and read back without stalling the render thread. Conversion, downscaling and
+ * PNG encoding run on a worker through FNeoStackImagePipeline; the result is attached to the
+ * tool result as a content-hashed image, so nothing goes through the clipboard.
+ */
+class NEOSTACK_API FCaptureViewportTool : public FNeoStackToolBase
+{
+public:
+	virtual FString GetName() const override { return TEXT("capture_viewport"); }
+	virtual FString GetDescription() const override
+	{
+		return TEXT("Capture the level viewport or a graph editor as an image you can see");
+	}
+
+	virtual FToolResult Execute(const TSharedPtr<FJsonObject>& Args) override;
+	virtual TSharedRef<FNeoStackToolTask> CreateTask(const TSharedPtr<FJsonObject>& Args) override;
+	virtual bool IsReadOnly() const override { return true; }
+
+	/** How long a capture waits for its window to be drawn */
+	static constexpr double TimeoutSeconds = 3.0;
+
+private:
+	class FCaptureTask;
+
+	struct FCaptureRequest
+	{
+		/** "viewport" or "graph" */
+		FString Target = TEXT("viewport");
+
+		/** Graph target: asset whose editor to capture, empty for the focused graph editor */
+		FString AssetPath;
+
+		/** Graph target: graph of the asset to bring to front (e.g. EventGraph) */
+		FString GraphName;
+
+		/** Longest edge of the attached image; 0 uses the Max Image Edge setting */
+		int32 MaxEdge = 0;
+	};
+
+	static FCaptureRequest ParseRequest(const TSharedPtr<FJsonObject>& Args);
+
+	/** Errors waiting a few frames won't fix: unknown target, missing asset */
+	static bool Validate(const FCaptureRequest& Request, FString& OutError);
+
+	/**
+	 * Find the widget the request captures, opening the asset's editor first if needed
+	 * @return Null with OutError set if there is nothing to capture (yet)
+	 */
+	static TSharedPtr<SWidget> FindTargetWidget(const FCaptureRequest& Request, FString& OutError);
+
+	/** The level viewport the user worked in last */
+	static TSharedPtr<SWidget> FindLevelViewport();
+
+	/** The graph editor that has keyboard focus or contains the focused widget */
+	static TSharedPtr<SWidget> FindFocusedGraphEditor();
+
+	/** A visible graph editor showing one of the asset's graphs (GraphName if set) */
+	static TSharedPtr<SWidget> FindAssetGraphEditor(UObject* Asset, const FString& GraphName);
+};
@@ -0,0 +1,84 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Parallel, case-insensitive text search over a list of source files
+ *
+ * Files are memory-mapped and scanned as raw UTF-8 bytes on the task graph, a batch at a time.
+ * Only match offsets are recorded during the scan; line numbers are counted up to each match
+ * and line/context strings are built only for matches inside the requested page. Scanning
+ * stops after the first batch that completes the page, and files containing NUL bytes are
+ * treated as binary and skipped.
+ */
+class NEOSTACK_API FCodeSearchEngine
+{
+public:
+	/** One matching line */
+	struct FMatch
+	{
+		FString File;
+		int32 Line = 0;
+		FString Content;
+		TArray<FString> ContextBefore;
+		TArray<FString> ContextAfter;
+	};
+
+	struct FResult
+	{
+		/** Matches [Offset, Offset + Limit) in file order, one per line */
+		TArray<FMatch> Matches;
+
+		/** Matching lines seen; the real total only if bComplete */
+		int32 TotalFound = 0;
+
+		/** Every file was searched */
+		bool bComplete = true;
+
+		int32 FilesSearched = 0;
+		int32 BinaryFilesSkipped = 0;
+	};
+
+	/**
+	 * Search Files in order for Query (ASCII case-insensitive)
+	 * @param Context - Lines of context before and after each returned match
+	 */
+	static FResult Search(const TArray<FString>& Files, const FString& Query, int32 Context, int32 Offset, int32 Limit);
+
+	/** Extensions (lowercase, no dot) code search looks at */
+	static bool IsSearchableExtension(const FString& Extension);
+
+	/** How a file looked to ReadFileTrigrams */
+	enum class EFileKind : uint8
+	{
+		Text,
+		Binary,
+		/** Unreadable or too large to index; always searched directly */
+		Unindexed
+	};
+
+	/**
+	 * Sorted, unique trigrams of a file's bytes, case-folded the same way Search compares them
+	 * Must be able to run on any thread.
+	 * @param OutContentHash - If set, receives HashFile's hash of the same bytes (0 when unreadable)
+	 */
+	static EFileKind ReadFileTrigrams(const FString& Path, TArray<uint32>& OutTrigrams, uint64* OutContentHash = nullptr);
+
+	/**
+	 * Content hash of a file as the index sees it, independent of its path and timestamp
+	 * Must be able to run on any thread.
+	 * @return False if the file can't be read
+	 */
+	static bool HashFile(const FString& Path, uint64& OutHash);
+
+	/** Sorted, unique trigrams a file must contain to match Query; empty if Query is shorter than three bytes */
+	static void GetQueryTrigrams(const FString& Query, TArray<uint32>& OutTrigrams);
+
+	/** Files larger than this are never trigram-indexed */
+	static constexpr int64 MaxIndexedFileSize = 16 * 1024 * 1024;
+
+	/** Files scanned per parallel batch; also the granularity of the early stop */
+	static constexpr int32 FilesPerBatch = 64;
+};
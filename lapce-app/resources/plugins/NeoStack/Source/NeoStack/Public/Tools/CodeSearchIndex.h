@@ -0,0 +1,168 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Tools/CodeSearchEngine.h"
+
+struct FFileChangeData;
+
+/**
+ * Persistent trigram index over the files explore's code search accepts.
+ *
+ * Each indexed file keeps the sorted set of its case-folded byte trigrams; a query is answered
+ * by binary-searching the query's trigrams in every file under the search directory, so only
+ * files that can contain the query are read. The index covers whole roots (the project
+ * directory, or the searched directory outside it), built in the background the first time a
+ * search lands in them, saved to Intermediate/NeoStack and reconciled against file
+ * timestamps on the next session. A directory watcher on each root marks changed files dirty;
+ * dirty files are always returned as candidates until they are re-indexed.
+ *
+ * The file stores paths under the project directory relative to it, and each file's content
+ * hash, so an index built in another checkout (a shared prebuilt one, see
+ * FNeoStackIndexArtifacts) only re-reads files whose size or hash differ there.
+ * All public functions are game thread only.
+ */
+class NEOSTACK_API FCodeSearchIndex
+{
+public:
+	static FCodeSearchIndex& Get();
+
+	/**
+	 * Files under Directory that may contain Query, sorted by path
+	 * Starts loading or building the index when Directory is not covered yet.
+	 * @return False if the index cannot answer (disabled or not built); scan the directory instead
+	 */
+	bool FindCandidates(const FString& Directory, bool bRecursive, const FString& Query, TArray<FString>& OutFiles);
+
+	/**
+	 * Build (or reconcile) the root covering Directory and wait for it, whatever the settings say
+	 * For the NeoStackTools commandlet, which prebuilds the index for other machines.
+	 */
+	void Prebuild(const FString& Directory);
+
+	/** Drop the watchers and stop applying background results (module shutdown) */
+	void Shutdown();
+
+	/** Directories (below a root) that are never indexed: build output and VCS metadata */
+	static bool IsPrunedDirectory(const FString& DirectoryName);
+
+	/** Seconds between the last change and writing the index file */
+	static constexpr float SaveDelaySeconds = 5.0f;
+
+private:
+	typedef TSharedPtr<const TArray<uint32>, ESPMode::ThreadSafe> FTrigramsPtr;
+
+	struct FIndexedFile
+	{
+		FString Path;
+		int64 Timestamp = 0;
+		int64 Size = 0;
+		FCodeSearchEngine::EFileKind Kind = FCodeSearchEngine::EFileKind::Unindexed;
+		FTrigramsPtr Trigrams;
+
+		/** FCodeSearchEngine::HashFile of the contents, 0 if unknown */
+		uint64 ContentHash = 0;
+	};
+
+	/** Output of one background job */
+	struct FJobResult
+	{
+		/** Root that was walked, empty for a dirty-file refresh */
+		FString Root;
+		TArray<FIndexedFile> Updated;
+		TArray<FString> Removed;
+	};
+
+	/** Everything read back from the index file */
+	struct FLoadResult
+	{
+		TArray<FString> Roots;
+		TArray<FIndexedFile> Files;
+	};
+
+	FCodeSearchIndex() = default;
+
+	static FString GetIndexFilePath();
+
+	/** Absolute, forward slashes, trailing slash */
+	static FString NormalizeDirectory(const FString& Directory);
+
+	/** Root that should cover Directory: the project directory when inside it, else Directory */
+	static FString ChooseRoot(const FString& Directory);
+
+	/**
+	 * Background: stat every file under Root, and read one only when its stamp changed
+	 * A changed stamp with the same size and content hash keeps the known trigrams.
+	 */
+	static void WalkRoot(const FString& Root, const TMap<FString, FIndexedFile>& KnownFiles, FJobResult& OutResult);
+
+	/** Background: re-read specific files */
+	static void RefreshFiles(const TArray<FString>& Paths, FJobResult& OutResult);
+
+	/** Background: read one file into a record */
+	static FIndexedFile IndexFile(const FString& Path, int64 Timestamp, int64 Size);
+
+	/** Path as stored in the index file: relative to the project directory when inside it */
+	static FString ToPortablePath(const FString& Path);
+	static FString FromPortablePath(const FString& Path);
+
+	static bool LoadIndexFile(FLoadResult& OutResult);
+	static void SaveIndexFile(const TArray<FString>& Roots, const TArray<FIndexedFile>& Files);
+
+	/** Finished root that covers Path, or null */
+	const FString* FindRoot(const FString& Path) const;
+
+	/** True if a directory between Root and Path is one the walk prunes */
+	static bool HasPrunedSegment(const FString& Root, const FString& Path);
+
+	void StartLoad();
+	void FinishLoad(FLoadResult&& Result);
+
+	/** Queue a (re)build of Root */
+	void RequestRoot(const FString& Root);
+
+	/** Start the next queued job if none is running */
+	void PumpJobs();
+	void FinishJob(FJobResult&& Result);
+
+	void AddOrReplace(FIndexedFile&& File);
+	void Remove(const FString& Path);
+
+	/** Schedule a save a few seconds out, coalescing bursts of changes */
+	void ScheduleSave();
+
+	bool HandleSaveTick(float DeltaTime);
+
+	void WatchRoot(const FString& Root);
+	void UnwatchRoot(const FString& Root);
+	void HandleFilesChanged(const TArray<FFileChangeData>& Changes);
+
+	TArray<FIndexedFile> Files;
+
+	/** Path -> index into Files */
+	TMap<FString, int32> FileByPath;
+
+	/** Finished roots */
+	TArray<FString> Roots;
+
+	/** Roots waiting for a walk, in request order */
+	TArray<FString> QueuedRoots;
+
+	/** Changed on disk since last indexed; always returned as candidates */
+	TSet<FString> DirtyFiles;
+
+	/** Dirty files the running refresh job is re-reading; still returned as candidates */
+	TSet<FString> RefreshingFiles;
+
+	/** Watched root -> watcher handle */
+	TArray<TPair<FString, FDelegateHandle>> WatchHandles;
+
+	FTSTicker::FDelegateHandle SaveHandle;
+
+	bool bLoadStarted = false;
+	bool bLoaded = false;
+	bool bJobInFlight = false;
+	bool bShutdown = false;
+};
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Tools/NeoStackToolBase.h"
 
+struct FResolvedPropertyPath;
+
 /**
  * Tool for reading and configuring asset properties using UE5 reflection system.
  * Supports ANY editable property on Materials, Blueprints, AnimBlueprints, Widgets, Components, etc.
@@ -24,6 +26,13 @@
  * Subobject support (widgets in Widget Blueprints, components in Blueprints):
  * Use the "subobject" parameter to target a specific widget or component.
  *
+ * Property names may be paths into structs and arrays: "BodyInstance.CollisionProfileName",
+ * "Points[2].X". Lookups are cached per class by FPropertyPathCache.
+ *
+ * Several assets can be handled in one call with "assets" (a list of names) or a wildcard
+ * name ("/Game/Enemies/BP_*", where * also matches subfolders). The same operations run on
+ * each, all changes go into one undo transaction, and results are reported per asset.
+ *
  * Example - Configure widget property:
  * {
  *   "name": "WBP_MainMenu",
@@ -64,6 +73,15 @@ public:
 	}
 
 	virtual FToolResult Execute(const TSharedPtr<FJsonObject>& Args) override;
+	virtual void GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const override;
+
+	/**
+	 * Apply "slot" settings (position, size, anchors, padding, ...) to a widget's panel slot
+	 * without synchronizing it or refreshing an editor. Also used by edit_blueprint's widget_tree.
+	 * @param OutLog - One "+ ..." line per applied setting is appended
+	 * @return Number of settings applied
+	 */
+	static int32 ApplySlotConfig(class UPanelSlot* Slot, const TSharedPtr<FJsonObject>& SlotConfig, FString& OutLog);
 
 private:
 	/** Property change request from JSON */
@@ -83,6 +101,16 @@ private:
 		FString Error;
 	};
 
+	/** Operations requested for every target asset */
+	struct FConfigureRequest
+	{
+		FString SubobjectName;
+		bool bListProperties = false;
+		TArray<FString> GetProperties;
+		TArray<FPropertyChange> Changes;
+		TSharedPtr<FJsonObject> SlotConfig;
+	};
+
 	/** Property info for listing */
 	struct FPropertyInfo
 	{
@@ -92,6 +120,21 @@ private:
 		FString Category;
 	};
 
+	/** Most assets one call may configure */
+	static constexpr int32 MaxAssetsPerCall = 200;
+
+	/**
+	 * Object paths of the assets a call targets: "assets" or "name", with wildcards expanded
+	 * @param bOutMulti - Set when more than one asset could match (a list or a wildcard)
+	 */
+	bool ResolveTargets(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutAssetPaths, bool& bOutMulti, FString& OutError) const;
+
+	/** Object paths of assets whose package path matches a wildcard pattern */
+	static void ExpandAssetPattern(const FString& Name, const FString& Path, TArray<FString>& OutAssetPaths);
+
+	/** Run the request on one asset; false with the error in OutOutput if it could not be configured */
+	bool ConfigureAsset(const FString& FullAssetPath, const FConfigureRequest& Request, FString& OutOutput);
+
 	/** Parse property changes from JSON array */
 	bool ParseChanges(const TArray<TSharedPtr<FJsonValue>>& ChangesArray,
 	                  TArray<FPropertyChange>& OutChanges, FString& OutError);
@@ -106,14 +149,14 @@ private:
 	/** Apply changes to an asset using reflection (WorkingAsset may be preview copy when editor is open) */
 	TArray<FChangeResult> ApplyChanges(UObject* WorkingAsset, UObject* OriginalAsset, const TArray<FPropertyChange>& Changes);
 
-	/** Find a property on the asset by name (case-insensitive) */
-	FProperty* FindProperty(UObject* Asset, const FString& PropertyName);
+	/** Find a property (or property path) on the asset by name, case-insensitive */
+	bool FindProperty(UObject* Asset, const FString& PropertyPath, FResolvedPropertyPath& OutPath, FString& OutError);
 
-	/** Get the current value of a property as string */
-	FString GetPropertyValue(UObject* Asset, FProperty* Property);
+	/** Get the value at ValuePtr as string */
+	FString GetPropertyValue(UObject* Owner, const FProperty* Property, const void* ValuePtr);
 
-	/** Set a property value from string */
-	bool SetPropertyValue(UObject* Asset, FProperty* Property, const FString& Value, FString& OutError);
+	/** Set the value at ValuePtr from string */
+	bool SetPropertyValue(UObject* Owner, FProperty* Property, void* ValuePtr, const FString& Value, FString& OutError);
 
 	/** Get property type as readable string */
 	FString GetPropertyTypeName(FProperty* Property) const;
@@ -4,6 +4,8 @@
 
 #include "Tools/NeoStackToolBase.h"
 
+class UPackage;
+
 /**
  * Tool for creating files and assets
  *
@@ -15,6 +17,12 @@
  *   - fields: Array of field definitions for Struct (name, type, default_value)
  *   - values: Array of enum value definitions for Enum (name, display_name)
  *   - row_struct: Row struct name for DataTable creation
+ *   - assets: Array of objects with the parameters above, to create several assets in one call
+ *   - save: Save the new packages when done (asynchronous file writes, one pass for the batch)
+ *
+ * Batches are created in dependency order: enums, then structs (structs used by other structs
+ * in the batch first), then DataTables, then Blueprints and other assets. Batched assets are
+ * not opened in editors and report a one-line result each.
  *
  * Supported asset types:
  *   - Text files: parent="Text"
@@ -39,6 +47,7 @@ public:
 		return TEXT("Create a file or asset. Use parent='Text' for text files, asset type name for non-Blueprints (e.g., 'BehaviorTree', 'Material', 'Struct', 'Enum'), 'Widget' for Widget Blueprints, or a UE class name for Blueprints (e.g., 'Actor', 'Character').");
 	}
 	virtual FToolResult Execute(const TSharedPtr<class FJsonObject>& Args) override;
+	virtual void GetTouchedResources(const TSharedPtr<class FJsonObject>& Args, TArray<FString>& OutKeys) const override;
 
 private:
 	/** Struct field definition */
@@ -58,6 +67,18 @@ private:
 		FString Description;
 	};
 
+	/** Create the asset described by one spec (the single-asset parameters) */
+	FToolResult CreateFromSpec(const TSharedPtr<FJsonObject>& Spec);
+
+	/** Create every spec in dependency order */
+	FToolResult ExecuteBatch(const TArray<TSharedPtr<FJsonValue>>& Specs, bool bSave);
+
+	/** Specs sorted into creation order; entries that are not objects are dropped */
+	static TArray<TSharedPtr<FJsonObject>> OrderSpecs(const TArray<TSharedPtr<FJsonValue>>& Specs);
+
+	/** Save CreatedPackages with asynchronous file writes. Returns the number saved */
+	int32 SaveCreatedPackages(TArray<FString>& OutFailed);
+
 	FToolResult CreateTextFile(const FString& Name, const FString& Path, const FString& Content);
 	FToolResult CreateAsset(const FString& Name, UClass* AssetClass, const FString& Path);
 	FToolResult CreateBlueprint(const FString& Name, const FString& ParentClass, const FString& Path);
@@ -77,4 +98,10 @@ private:
 
 	/** Parse enum values from JSON array */
 	TArray<FEnumValueDef> ParseEnumValues(const TArray<TSharedPtr<FJsonValue>>* ValuesArray);
+
+	/** Packages created by the current call, for the optional save */
+	TArray<UPackage*> CreatedPackages;
+
+	/** Set while a batch runs: no editors are opened and results stay one line */
+	bool bBatchCreate = false;
 };
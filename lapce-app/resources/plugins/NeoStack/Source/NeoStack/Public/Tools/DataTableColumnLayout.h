@@ -0,0 +1,95 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UScriptStruct;
+
+/** A row struct's columns, resolved once and shared by every read of the tables using it */
+struct FDataTableColumnLayout
+{
+	struct FColumn
+	{
+		const FProperty* Property = nullptr;
+
+		/** Authored name (the field name shown in the editor for User Defined Structs) */
+		FString Name;
+	};
+
+	TArray<FColumn> Columns;
+
+	/** Lowercase authored and internal names -> column index */
+	TMap<FString, int32> IndexByName;
+
+	/** Column index for a name, case-insensitive, or INDEX_NONE */
+	int32 Find(const FString& Name) const;
+
+	/** Comma-separated authored names, for error messages */
+	FString JoinNames() const;
+};
+
+/**
+ * A "column op value" predicate evaluated against row memory.
+ * Ops: = (or ==), !=, <, <=, >, >=, ~ (contains). Numbers, bools and enums are compared as
+ * numbers when the value is numeric; names, strings and text without exporting; anything else
+ * against its exported text. String comparisons ignore case.
+ */
+struct FDataTableRowFilter
+{
+	enum class EOp : uint8
+	{
+		Equal,
+		NotEqual,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		Contains
+	};
+
+	int32 Column = INDEX_NONE;
+	EOp Op = EOp::Equal;
+	FString Value;
+	double NumberValue = 0.0;
+	bool bNumeric = false;
+
+	/** Parse an expression against a layout; false with OutError if it can't be used */
+	static bool Parse(const FString& Expression, const FDataTableColumnLayout& Layout,
+		FDataTableRowFilter& OutFilter, FString& OutError);
+
+	bool Matches(const FDataTableColumnLayout& Layout, const uint8* RowData) const;
+
+private:
+	bool CompareOrder(int32 Order) const;
+};
+
+/**
+ * Column layouts cached per row struct.
+ * A User Defined Struct's layout is dropped as soon as the struct is edited, since that
+ * recreates its properties. Game thread only.
+ */
+class NEOSTACK_API FDataTableColumnLayoutCache
+{
+public:
+	static FDataTableColumnLayoutCache& Get();
+
+	TSharedRef<const FDataTableColumnLayout> GetLayout(const UScriptStruct* RowStruct);
+
+	/** Drop one struct's layout */
+	void Invalidate(const UScriptStruct* RowStruct);
+
+	/** Stop listening for struct edits and drop all layouts (module shutdown) */
+	void Shutdown();
+
+private:
+	class FStructListener;
+
+	FDataTableColumnLayoutCache();
+	~FDataTableColumnLayoutCache();
+
+	TMap<TWeakObjectPtr<const UScriptStruct>, TSharedRef<const FDataTableColumnLayout>> Layouts;
+
+	TUniquePtr<FStructListener> Listener;
+};
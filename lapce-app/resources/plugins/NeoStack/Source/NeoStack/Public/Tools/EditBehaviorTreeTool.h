@@ -12,15 +12,21 @@ class UBTTaskNode;
 class UBTNode;
 class UBTDecorator;
 class UBTService;
+struct FBTCompositeChild;
 
 /**
  * Tool for editing Behavior Trees and Blackboards:
  * - Add/remove composite nodes (Selector, Sequence, Parallel)
+ * - Add whole subtrees (nested composites and tasks with their decorators and services)
  * - Add/remove task nodes
  * - Add/remove decorators
  * - Add/remove services
  * - Add/remove blackboard keys
  * - Set blackboard on behavior tree
+ *
+ * Nodes are found through a name index built once per call and kept current as nodes are
+ * added. The runtime tree is edited directly; if the tree already has an editor graph, the
+ * graph is respawned from it and the runtime tree rebuilt from the graph once at the end.
  */
 class NEOSTACK_API FEditBehaviorTreeTool : public FNeoStackToolBase
 {
@@ -32,6 +38,7 @@ public:
 	}
 
 	virtual FToolResult Execute(const TSharedPtr<FJsonObject>& Args) override;
+	virtual void GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const override;
 
 private:
 	// ========== Definitions ==========
@@ -82,11 +89,20 @@ private:
 
 	// ========== Behavior Tree Operations ==========
 
-	/** Find a BT node by name (searches recursively) */
-	UBTCompositeNode* FindCompositeByName(UBTCompositeNode* Root, const FString& Name);
+	/** Index the tree's composites and tasks by name, with the composite each is a child of */
+	void BuildNodeIndex(UBehaviorTree* BehaviorTree);
 
-	/** Find a task node by name */
-	UBTTaskNode* FindTaskByName(UBTCompositeNode* Root, const FString& Name);
+	/** Add a node (and, for a composite, its existing children) to the index */
+	void IndexNode(UBTNode* Node, UBTCompositeNode* Parent);
+
+	/** Find a composite or task by name (case-insensitive); composites win a name clash */
+	UBTNode* FindNode(const FString& Name) const;
+
+	/** Find a composite by name */
+	UBTCompositeNode* FindComposite(const FString& Name) const;
+
+	/** Find a node class deriving from BaseClass by "Type" or "Prefix_Type", cached for the call */
+	UClass* FindNodeClass(UClass* BaseClass, const TCHAR* Prefix, const FString& TypeName);
 
 	/** Find the composite class by type name */
 	UClass* FindCompositeClass(const FString& TypeName);
@@ -101,11 +117,22 @@ private:
 	UClass* FindServiceClass(const FString& TypeName);
 
 	/** Attach a decorator to the child edge that contains the target node */
-	bool AttachDecoratorToChildEdge(UBTCompositeNode* Parent, UBTNode* TargetNode, UBTDecorator* Decorator);
+	bool AttachDecoratorToChildEdge(UBTNode* TargetNode, UBTDecorator* Decorator);
+
+	/** Insert a child edge at Index, or append when Index is out of range */
+	static void InsertChild(UBTCompositeNode* Parent, const FBTCompositeChild& Child, int32 Index);
 
 	/** Add a composite node to the behavior tree */
 	FString AddComposite(UBehaviorTree* BehaviorTree, const FCompositeDefinition& CompDef);
 
+	/**
+	 * Add a subtree from a nested spec {type, name, decorators, services, children} under Parent
+	 * (null for the root)
+	 * @return Number of nodes, decorators and services added
+	 */
+	int32 AddSubtree(UBehaviorTree* BehaviorTree, const TSharedPtr<FJsonObject>& Spec, UBTCompositeNode* Parent,
+		int32 Index, TArray<FString>& OutResults);
+
 	/** Add a task node to the behavior tree */
 	FString AddTask(UBehaviorTree* BehaviorTree, const FTaskDefinition& TaskDef);
 
@@ -121,6 +148,9 @@ private:
 	/** Set the blackboard asset for the behavior tree */
 	FString SetBlackboard(UBehaviorTree* BehaviorTree, const FString& BlackboardName);
 
+	/** Respawn the editor graph (if the tree has one) from the runtime tree and rebuild the tree from it */
+	void RebuildTreeGraph(UBehaviorTree* BehaviorTree);
+
 	// ========== Blackboard Operations ==========
 
 	/** Find a blackboard key type class by name */
@@ -131,4 +161,13 @@ private:
 
 	/** Remove a key from the blackboard */
 	FString RemoveBlackboardKey(UBlackboardData* Blackboard, const FString& KeyName);
+
+	/** Lowercase node name -> node, for the tree being edited */
+	TMap<FString, UBTNode*> NodesByName;
+
+	/** Composite or task -> the composite it is a child of (the root has none) */
+	TMap<UBTNode*, UBTCompositeNode*> NodeParents;
+
+	/** "Prefix:type" -> node class, for the current call */
+	TMap<FString, UClass*> NodeClassCache;
 };
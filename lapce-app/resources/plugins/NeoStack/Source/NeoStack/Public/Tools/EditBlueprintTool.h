@@ -6,6 +6,7 @@
 #include "Tools/NeoStackToolBase.h"
 
 class UBlueprint;
+struct FBlueprintCompileReport;
 class USCS_Node;
 class UWidgetBlueprint;
 class UWidgetTree;
@@ -15,6 +16,7 @@ class UAnimBlueprint;
 class UAnimGraphNode_StateMachine;
 class UAnimationStateMachineGraph;
 class UAnimStateNode;
+class UAnimStateTransitionNode;
 
 /**
  * Tool for editing Blueprint assets:
@@ -23,7 +25,15 @@ class UAnimStateNode;
  * - Add/remove custom functions with inputs/outputs
  * - Add/remove event dispatchers with parameters
  * - Add/remove widgets in Widget Blueprints
+ * - Build whole widget subtrees (children, slots, properties, event bindings) from one spec
  * - Add state machines, states, and transitions in Animation Blueprints
+ * - Build whole state machines (states, transitions, rules, blend settings) from one spec
+ *
+ * By default ("batch") variables, event dispatchers, functions and widgets are added without
+ * the skeleton recompile FBlueprintEditorUtils runs per item; the Blueprint is marked
+ * structurally modified once after all of them (and once more at the end if event bindings
+ * need the new members). "compile": true then runs one full compile and reports its errors
+ * under the items they mention.
  */
 class NEOSTACK_API FEditBlueprintTool : public FNeoStackToolBase
 {
@@ -35,6 +45,7 @@ public:
 	}
 
 	virtual FToolResult Execute(const TSharedPtr<FJsonObject>& Args) override;
+	virtual void GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const override;
 
 private:
 	/** Type definition parsed from JSON */
@@ -158,6 +169,15 @@ private:
 	/** Remove an event dispatcher from the Blueprint */
 	FString RemoveEvent(UBlueprint* Blueprint, const FString& EventName);
 
+	/**
+	 * FBlueprintEditorUtils::AddMemberVariable without its structural-modification recompile.
+	 * The default value is stored on the description and applied by the next compile.
+	 */
+	bool AddMemberVariableDeferred(UBlueprint* Blueprint, FName VarName, const FEdGraphPinType& PinType, const FString& DefaultValue);
+
+	/** FBlueprintCompileScheduler callback: put the compile messages under the output lines of the items they name */
+	static void AnnotateCompileReport(const FBlueprintCompileReport& Report, FString& InOutOutput);
+
 	/** Set default value on a variable */
 	void SetVariableDefaultValue(UBlueprint* Blueprint, const FString& VarName, const FString& DefaultValue);
 
@@ -180,6 +200,44 @@ private:
 	/** Refresh widget editor if open */
 	void RefreshWidgetEditor(UWidgetBlueprint* WidgetBlueprint);
 
+	/** A widget and its subtree from a widget_tree spec */
+	struct FWidgetTreeSpec
+	{
+		FString Type;
+		FString Name;                        // Empty = generated name
+		FString Parent;                      // Top level only: existing panel to add under (empty = root)
+		TSharedPtr<FJsonObject> Slot;        // Same keys as configure_asset's "slot"
+		TSharedPtr<FJsonObject> Properties;  // Property path -> value
+		TArray<FString> Events;              // Delegates to bind once the skeleton has the widget
+		TArray<FWidgetTreeSpec> Children;
+	};
+
+	FWidgetTreeSpec ParseWidgetTreeSpec(const TSharedPtr<FJsonObject>& SpecObj);
+
+	/**
+	 * Construct a widget subtree in one pass: every widget is created, given its properties,
+	 * added to its parent and slotted before the designer is refreshed once at the end of the call.
+	 * Widgets with events are made variables and their bindings are appended to OutBindings,
+	 * to run after the skeleton class includes them.
+	 * @return Summary line for the subtree
+	 */
+	FString BuildWidgetTree(UWidgetBlueprint* WidgetBlueprint, const FWidgetTreeSpec& Spec, TArray<FString>& OutResults,
+		TArray<FEventBindingDef>& OutBindings, int32& OutAddedCount);
+
+	/** Construct Spec and its children under ParentPanel, or as the tree root if ParentPanel is null */
+	UWidget* ConstructWidgetSubtree(UWidgetTree* WidgetTree, UPanelWidget* ParentPanel, const FWidgetTreeSpec& Spec,
+		TSet<FName>& UsedNames, TArray<FString>& OutResults, TArray<FEventBindingDef>& OutBindings, int32& OutAddedCount);
+
+	/** Set a property path on a widget from a JSON value; @return Error, or empty on success */
+	static FString SetWidgetProperty(UWidget* Widget, const FString& PropertyPath, const TSharedPtr<FJsonValue>& Value);
+
+	/** True during a batched Execute: per-item recompiles and editor refreshes are skipped */
+	bool bDeferStructuralChanges = false;
+
+	/** Set when a deferred add changed the Blueprint's members or widget tree */
+	bool bStructureChangePending = false;
+	bool bWidgetTreeChanged = false;
+
 	// Event binding operations (unified for both Widget and regular Blueprints)
 
 	/** List available events on a component or widget */
@@ -266,4 +324,51 @@ private:
 	 * Returns info about the transition graph and result node for wiring condition logic
 	 */
 	FString AddStateTransition(UAnimBlueprint* AnimBlueprint, const FStateTransitionDefinition& TransDef);
+
+	// Bulk state machine construction
+
+	/** One state of a state_machines spec */
+	struct FStateSpec
+	{
+		FString Name;
+		FString Animation;      // Optional sequence played by the state
+	};
+
+	/** One transition of a state_machines spec */
+	struct FTransitionSpec
+	{
+		FString From;
+		FString To;
+		FString Rule;           // Bool member variable, "!Var" to negate, or "auto" for the sequence-end rule
+		TOptional<double> BlendTime;
+		FString BlendMode;      // EAlphaBlendOption name (Linear, Cubic, ...)
+		FString BlendLogic;     // Standard, Inertialization or Custom
+		TOptional<int32> Priority;
+		bool bBidirectional = false;
+	};
+
+	/** A state machine with all of its states and transitions */
+	struct FStateMachineSpec
+	{
+		FString Name;
+		FString Entry;          // Initial state; defaults to the first new state if the entry is unlinked
+		bool bConnectOutput = false;
+		TArray<FStateSpec> States;
+		TArray<FTransitionSpec> Transitions;
+	};
+
+	FStateMachineSpec ParseStateMachineSpec(const TSharedPtr<FJsonObject>& SpecObj);
+
+	/**
+	 * Create a state machine, or extend an existing one, from a full spec in one pass.
+	 * Nodes are put into the graphs' node lists without per-node notifications, new states are
+	 * placed with FGraphLayoutIndex in columns following the transitions from the entry, and
+	 * each touched graph is notified once at the end.
+	 * Failed states and transitions are added to OutResults.
+	 * @return Summary line for the state machine
+	 */
+	FString BuildStateMachine(UAnimBlueprint* AnimBlueprint, const FStateMachineSpec& Spec, TArray<FString>& OutResults);
+
+	/** Wire a transition's rule graph: bool member (optionally negated) into bCanEnterTransition */
+	FString BuildTransitionRule(UAnimBlueprint* AnimBlueprint, UAnimStateTransitionNode* TransitionNode, const FString& Rule);
 };
@@ -30,6 +30,12 @@ class UDataTable;
  *   - add_rows: Array of row definitions [{row_name, values: {column: value, ...}}]
  *   - remove_rows: Array of row names to remove
  *   - modify_rows: Array of row modifications [{row_name, values: {column: value, ...}}]
+ *   - import_rows: Bulk import from a file {file, format: csv|json|jsonl, mode: append|replace}
+ *   - export_rows: Write all rows to a file {file, format: csv|jsonl}
+ *
+ * Files are project-relative or absolute. CSV uses the engine's DataTable layout (a "---" name
+ * column, one column per field); JSON lines hold one flat object per row with a "Name" key.
+ * Imports are parsed once into a transient table and applied with a single change broadcast.
  *
  * Supported field types for structs:
  *   Boolean, Integer, Int64, Float, Double, String, Name, Text,
@@ -46,6 +52,7 @@ public:
 	}
 
 	virtual FToolResult Execute(const TSharedPtr<FJsonObject>& Args) override;
+	virtual void GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const override;
 
 private:
 	/** Struct field definition for adding/modifying */
@@ -90,6 +97,8 @@ private:
 	int32 AddDataTableRows(UDataTable* DataTable, const TArray<TSharedPtr<FJsonValue>>* RowsArray, TArray<FString>& OutResults);
 	int32 RemoveDataTableRows(UDataTable* DataTable, const TArray<TSharedPtr<FJsonValue>>* RowsArray, TArray<FString>& OutResults);
 	int32 ModifyDataTableRows(UDataTable* DataTable, const TArray<TSharedPtr<FJsonValue>>* RowsArray, TArray<FString>& OutResults);
+	int32 ImportDataTableRows(UDataTable* DataTable, const TSharedPtr<FJsonObject>& ImportObj, TArray<FString>& OutResults);
+	int32 ExportDataTableRows(UDataTable* DataTable, const TSharedPtr<FJsonObject>& ExportObj, TArray<FString>& OutResults);
 
 	/** Parse struct field operation from JSON */
 	FStructFieldOp ParseStructFieldOp(const TSharedPtr<FJsonObject>& FieldObj);
@@ -4,12 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "Tools/NeoStackToolBase.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 
 class UBlueprint;
 class UEdGraph;
 class UEdGraphNode;
 class UEdGraphPin;
 class UBlueprintNodeSpawner;
+class UMaterial;
+class UMaterialExpression;
+class UMaterialGraph;
 
 /**
  * Tool for editing graph logic in Blueprint and Material assets:
@@ -25,6 +29,15 @@ class UBlueprintNodeSpawner;
  *
  * set_pins: For Blueprints sets pin default values, for Materials sets expression
  * properties dynamically using reflection (R, Constant, Texture, etc.)
+ *
+ * batch: Runs the whole call as one undo transaction with a single refresh and
+ * recompile pass at the end, for generating many nodes at once. On a Material, expressions
+ * are created, linked and edited without the per-change Material Editor updates, and the
+ * material gets one PreEditChange/PostEditChange, so one shader compile; an asynchronous
+ * call waits for that compile and reports when it finished.
+ *
+ * auto_layout: Places the added nodes in columns by their connections (FGraphLayoutIndex)
+ * instead of one row to the right of the graph
  */
 class NEOSTACK_API FEditGraphTool : public FNeoStackToolBase
 {
@@ -36,8 +49,15 @@ public:
 	}
 
 	virtual FToolResult Execute(const TSharedPtr<FJsonObject>& Args) override;
+	virtual TSharedRef<FNeoStackToolTask> CreateTask(const TSharedPtr<FJsonObject>& Args) override;
+	virtual void GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const override;
+
+	/** How long an asynchronous batch call waits for its material's shaders */
+	static constexpr double ShaderCompileTimeoutSeconds = 120.0;
 
 private:
+	class FMaterialCompileTask;
+
 	/** Node definition from JSON */
 	struct FNodeDefinition
 	{
@@ -93,6 +113,26 @@ private:
 		FString Details;  // e.g., "promoted float to int" or "inserted ToText node"
 	};
 
+	/**
+	 * Deferred work for a batch=true call. The call runs in one transaction; per-pin and
+	 * per-expression modification notifications are skipped and replaced by one refresh and
+	 * one structural-modification (recompile) pass at the end.
+	 */
+	struct FEditBatch
+	{
+		/** Nodes whose pin defaults were set without marking the Blueprint modified */
+		TSet<UEdGraphNode*> ChangedNodes;
+
+		/** Material expressions whose properties were set without dirtying the package */
+		TSet<UMaterialExpression*> ChangedExpressions;
+
+		/**
+		 * Material graph batch: expressions are spawned and linked past the Material Editor
+		 * and property edits are reported as interactive, so nothing recompiles until the end
+		 */
+		bool bDeferMaterialUpdates = false;
+	};
+
 	/** Parse a node definition from JSON */
 	bool ParseNodeDefinition(const TSharedPtr<FJsonObject>& NodeObj, FNodeDefinition& OutDef, FString& OutError);
 
@@ -108,11 +148,14 @@ private:
 	/** Spawn a node using the spawner */
 	UEdGraphNode* SpawnNode(UBlueprintNodeSpawner* Spawner, UEdGraph* Graph, const FVector2D& Position);
 
+	/** Create an expression and its graph node without notifying the Material Editor (deferred material batch) */
+	UEdGraphNode* SpawnMaterialExpression(UMaterialGraph* Graph, UClass* ExpressionClass, const FVector2D& Position);
+
 	/** Set default values on node pins (Blueprint) or expression properties (Material) */
-	TArray<FString> SetPinValues(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& PinValues);
+	TArray<FString> SetPinValues(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& PinValues, FEditBatch* Batch = nullptr);
 
 	/** Set values on existing node - dispatches to Blueprint pins or Material expression properties */
-	TArray<FString> SetNodeValues(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& Values, UEdGraph* Graph);
+	TArray<FString> SetNodeValues(UEdGraphNode* Node, const TSharedPtr<FJsonObject>& Values, UEdGraph* Graph, FEditBatch* Batch = nullptr);
 
 	/** Resolve a node reference (name or GUID) to actual node */
 	UEdGraphNode* ResolveNodeRef(const FString& NodeRef, UEdGraph* Graph, const FString& AssetPath,
@@ -129,7 +172,7 @@ private:
 	 * 2. Type promotion if schema supports it (e.g., float to double)
 	 * 3. Auto-insert conversion node if needed (e.g., int to string)
 	 */
-	FConnectionResult CreateConnectionWithFallback(UEdGraphPin* FromPin, UEdGraphPin* ToPin);
+	FConnectionResult CreateConnectionWithFallback(UEdGraphPin* FromPin, UEdGraphPin* ToPin, FEditBatch* Batch = nullptr);
 
 	/** Legacy simple connection (for compatibility) */
 	bool CreateConnection(UEdGraphPin* FromPin, UEdGraphPin* ToPin, FString& OutError);
@@ -149,9 +192,6 @@ private:
 	/** Get node type display name */
 	FString GetNodeTypeName(UEdGraphNode* Node) const;
 
-	/** Calculate smart position for a new node - finds empty space near existing nodes */
-	FVector2D CalculateSmartPosition(UEdGraph* Graph, const TMap<FString, UEdGraphNode*>& NewNodesThisCall) const;
-
 	/** Format results to output string */
 	FString FormatResults(const FString& AssetName, const FString& GraphName,
 	                      const TArray<FAddedNode>& AddedNodes,
@@ -159,4 +199,7 @@ private:
 	                      const TArray<FString>& Disconnections,
 	                      const TArray<FString>& SetPinsResults,
 	                      const TArray<FString>& Errors) const;
+
+	/** Material whose one deferred compile the last Execute started, for FMaterialCompileTask */
+	TWeakObjectPtr<UMaterial> PendingShaderCompile;
 };
@@ -4,12 +4,17 @@
 
 #include "CoreMinimal.h"
 #include "Tools/NeoStackToolBase.h"
+#include "Tools/GitIgnoreMatcher.h"
 
 /**
  * Tool for exploring and searching project files and assets
  * - List directories (files, folders, or both)
  * - Search code with regex/text
  * - Find Blueprints by criteria (parent, component, interface, etc.)
+ * - Walk an asset's dependencies and referencers to a given depth
+ *
+ * Asynchronous file-system calls walk and search on a worker thread; asset searches run on
+ * the game thread as usual.
  */
 class NEOSTACK_API FExploreTool : public FNeoStackToolBase
 {
@@ -21,8 +26,13 @@ public:
 	}
 
 	virtual FToolResult Execute(const TSharedPtr<FJsonObject>& Args) override;
+	virtual TSharedRef<FNeoStackToolTask> CreateTask(const TSharedPtr<FJsonObject>& Args) override;
+	virtual bool IsReadOnly() const override { return true; }
+	virtual bool IsCacheable(const TSharedPtr<FJsonObject>& Args) const override;
 
 private:
+	class FFilesTask;
+
 	/** Filter options for Blueprint searches */
 	struct FBlueprintFilter
 	{
@@ -33,21 +43,59 @@ private:
 		FString ReferencedBy;
 	};
 
+	/** Parsed and clamped arguments of one call */
+	struct FExploreRequest
+	{
+		FString Path;
+		FString Pattern;
+		FString Query;
+		FString Type;
+		int32 Offset = 0;
+		int32 Limit = 50;
+		int32 Context = 0;
+		bool bRecursive = true;
+		FBlueprintFilter Filter;
+
+		/** Dependencies mode: "dependencies", "referencers" or "both", and the edges to follow */
+		FString Direction;
+		int32 Depth = 1;
+
+		/** Routed to ExploreAssets or ExploreDependencies rather than ExploreFiles */
+		bool IsAssetSearch() const;
+
+		/** Routed to ExploreDependencies */
+		bool IsDependencyQuery() const;
+	};
+
+	static FExploreRequest ParseRequest(const TSharedPtr<FJsonObject>& Args);
+
 	/** Explore filesystem (files/folders) */
-	FToolResult ExploreFiles(const FString& Path, const FString& Pattern, const FString& Query,
-		const FString& Type, bool bRecursive, int32 Context, int32 Offset, int32 Limit);
+	FToolResult ExploreFiles(const FExploreRequest& Request);
+
+	/**
+	 * Game-thread half of ExploreFiles: resolve the directory and, for code searches, ask the
+	 * code search index for candidate files (bOutIndexed is false if it can't answer)
+	 */
+	bool PrepareFiles(const FExploreRequest& Request, FString& OutFullPath, TArray<FString>& OutIndexCandidates,
+		bool& bOutIndexed, FString& OutError);
+
+	/** File-system half of ExploreFiles; touches no UObjects or shared state, so it may run on any thread */
+	FToolResult ScanFiles(const FExploreRequest& Request, const FString& FullPath, const TArray<FString>* IndexCandidates);
 
 	/** Explore UE assets */
 	FToolResult ExploreAssets(const FString& Path, const FString& Pattern, const FString& Query,
 		const FString& Type, const FBlueprintFilter& Filter, int32 Offset, int32 Limit);
 
+	/** Walk the dependency graph from the asset at Request.Path */
+	FToolResult ExploreDependencies(const FExploreRequest& Request);
+
 	/** List directory contents */
 	FString ListDirectory(const FString& FullPath, const FString& Pattern, const FString& Type,
 		bool bRecursive, int32 Offset, int32 Limit);
 
-	/** Search code in files */
+	/** Search code in files (IndexCandidates narrows the search, null walks FullPath) */
 	FString SearchCode(const FString& FullPath, const FString& Pattern, const FString& Query,
-		bool bRecursive, int32 Context, int32 Offset, int32 Limit);
+		bool bRecursive, int32 Context, int32 Offset, int32 Limit, const TArray<FString>* IndexCandidates);
 
 	/** List assets in path */
 	FString ListAssets(const FString& AssetPath, const FString& Pattern, const FString& Type, int32 Offset, int32 Limit);
@@ -56,17 +104,20 @@ private:
 	FString SearchBlueprints(const FString& AssetPath, const FString& Pattern, const FString& Query,
 		const FBlueprintFilter& Filter, int32 Offset, int32 Limit);
 
-	/** Check if Blueprint matches filter */
-	bool MatchesFilter(class UBlueprint* Blueprint, const FString& Query, const FBlueprintFilter& Filter);
+	/** Check if a Blueprint summary matches filter (references are checked on the dependency graph) */
+	bool MatchesFilter(const struct FBlueprintSummary& Summary, const FString& Query, const FBlueprintFilter& Filter);
 
 	/** Check if Blueprint has component */
-	bool HasComponent(class UBlueprint* Blueprint, const FString& ComponentName);
+	bool HasComponent(const struct FBlueprintSummary& Summary, const FString& ComponentName);
+
+	/** Check if any interface name contains InterfaceName */
+	bool HasInterface(const TArray<FString>& Interfaces, const FString& InterfaceName);
 
-	/** Check if Blueprint implements interface */
-	bool HasInterface(class UBlueprint* Blueprint, const FString& InterfaceName);
+	/** Check if package depends on a package whose name contains AssetName */
+	bool ReferencesAsset(FName PackageName, const FString& AssetName);
 
-	/** Check if Blueprint references asset */
-	bool ReferencesAsset(class UBlueprint* Blueprint, const FString& AssetName);
+	/** Packages that a /Game package whose name contains AssetName depends on */
+	TSet<FName> CollectReferencedBy(const FString& AssetName);
 
 	/** Check if text matches query (case-insensitive) */
 	bool MatchesQuery(const FString& Text, const FString& Query);
@@ -74,13 +125,15 @@ private:
 	/** Match glob pattern */
 	bool MatchesPattern(const FString& Name, const FString& Pattern);
 
-	/** Load .gitignore patterns from project root */
-	void LoadGitIgnorePatterns();
-
 	/** Check if path should be ignored based on gitignore */
 	bool IsIgnoredByGitignore(const FString& RelativePath, bool bIsDirectory);
 
-	/** Cached gitignore patterns */
-	TArray<FString> GitIgnorePatterns;
-	bool bGitIgnoreLoaded = false;
+	/**
+	 * Walk a directory, skipping gitignored entries and never descending into ignored directories
+	 * Returning false from the visitor for a directory prunes that directory too.
+	 */
+	void IterateProjectDirectory(const FString& FullPath, bool bRecursive, IPlatformFile::FDirectoryVisitor& Visitor);
+
+	/** Compiled root and nested .gitignore rules, reset per call */
+	FGitIgnoreMatcher GitIgnore;
 };
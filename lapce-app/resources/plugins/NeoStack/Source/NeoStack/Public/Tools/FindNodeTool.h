@@ -29,6 +29,9 @@ public:
 	}
 
 	virtual FToolResult Execute(const TSharedPtr<FJsonObject>& Args) override;
+	virtual bool IsReadOnly() const override { return true; }
+	virtual bool IsCacheable(const TSharedPtr<FJsonObject>& Args) const override { return true; }
+	virtual void GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const override;
 
 private:
 	/** Result entry for a found node */
@@ -67,6 +70,13 @@ private:
 		const TArray<FString>& Queries, const FString& CategoryFilter,
 		const FString& InputTypeFilter, const FString& OutputTypeFilter);
 
+	/**
+	 * Regenerate the skeleton class when it is missing variables or functions the Blueprint
+	 * declares, so the action database can offer them without a full compile
+	 * @return true if the skeleton was regenerated
+	 */
+	bool RefreshSkeletonIfStale(UBlueprint* Blueprint) const;
+
 	/** Find nodes in a Behavior Tree */
 	TArray<FNodeInfo> FindNodesInBehaviorTree(UObject* BehaviorTree,
 		const TArray<FString>& Queries, const FString& CategoryFilter);
@@ -85,7 +95,7 @@ private:
 	FString PinTypeToString(const struct FEdGraphPinType& PinType) const;
 
 	/** Check if node matches any query and compute relevance score */
-	bool MatchesQuery(const FString& NodeName, const FString& Keywords, const TArray<FString>& Queries, FString& OutMatchedQuery, int32& OutScore) const;
+	bool MatchesQuery(const FString& NodeName, const FString& Keywords, const TArray<struct FFuzzyQuery>& Queries, FString& OutMatchedQuery, int32& OutScore) const;
 
 	/** Check if node matches category filter */
 	bool MatchesCategory(const FString& NodeCategory, const FString& CategoryFilter) const;
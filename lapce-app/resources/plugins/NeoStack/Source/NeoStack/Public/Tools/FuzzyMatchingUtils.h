@@ -4,6 +4,101 @@
 
 #include "CoreMinimal.h"
 #include "Algo/LevenshteinDistance.h"
+#include "String/Find.h"
+
+/**
+ * A search query normalized once, for scoring against many candidates
+ *
+ * Holds the lowercased query, its space-free form, word ranges and the character bit masks
+ * used by the bit-parallel edit distance, so the FFuzzyQuery overloads in FFuzzyMatchingUtils
+ * never lowercase, split or allocate per candidate.
+ */
+struct FFuzzyQuery
+{
+	/** Lowercased query */
+	FString Lower;
+
+	/** Lowercased query with spaces removed */
+	FString Compact;
+
+	/** Alphanumeric words of Lower as (start, length) */
+	TArray<TPair<int32, int32>, TInlineAllocator<8>> Words;
+
+	/** Bit i set in AsciiMasks[c] when Lower[i] == c (first 64 characters only) */
+	uint64 AsciiMasks[128];
+
+	FFuzzyQuery()
+	{
+		FMemory::Memzero(AsciiMasks, sizeof(AsciiMasks));
+	}
+
+	explicit FFuzzyQuery(const FString& Query)
+		: Lower(Query.ToLower())
+	{
+		FMemory::Memzero(AsciiMasks, sizeof(AsciiMasks));
+
+		Compact.Reserve(Lower.Len());
+		int32 WordStart = INDEX_NONE;
+		for (int32 i = 0; i < Lower.Len(); ++i)
+		{
+			const TCHAR Ch = Lower[i];
+			if (Ch != TEXT(' '))
+			{
+				Compact.AppendChar(Ch);
+			}
+
+			if (FChar::IsAlnum(Ch))
+			{
+				if (WordStart == INDEX_NONE)
+				{
+					WordStart = i;
+				}
+			}
+			else if (WordStart != INDEX_NONE)
+			{
+				Words.Emplace(WordStart, i - WordStart);
+				WordStart = INDEX_NONE;
+			}
+
+			if (i < 64 && (uint32)Ch < 128)
+			{
+				AsciiMasks[Ch] |= (1ull << i);
+			}
+		}
+		if (WordStart != INDEX_NONE)
+		{
+			Words.Emplace(WordStart, Lower.Len() - WordStart);
+		}
+	}
+
+	bool IsEmpty() const { return Lower.IsEmpty(); }
+	int32 Len() const { return Lower.Len(); }
+
+	FStringView GetWord(int32 Index) const
+	{
+		return FStringView(*Lower + Words[Index].Key, Words[Index].Value);
+	}
+
+	/** Positions in the first 64 query characters where the query equals a (lowercased) character */
+	uint64 GetMask(TCHAR LowerChar) const
+	{
+		if ((uint32)LowerChar < 128)
+		{
+			return AsciiMasks[LowerChar];
+		}
+
+		uint64 Mask = 0;
+		const int32 Count = FMath::Min(Lower.Len(), 64);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			if (Lower[i] == LowerChar)
+			{
+				Mask |= (1ull << i);
+			}
+		}
+		return Mask;
+	}
+};
 
 /**
  * Enhanced fuzzy matching utilities for node searching
@@ -242,7 +337,261 @@ public:
 		return FMath::Clamp(FinalScore, 0.0f, 1.0f);
 	}
 
+	/**
+	 * Levenshtein similarity against a prepared query, without allocation
+	 * Uses a bit-parallel (Myers/Hyyrö) edit distance for queries up to 64 characters and stops
+	 * as soon as the score can no longer reach MinScore.
+	 * @param Query The prepared search query
+	 * @param Text The text to match against (any case)
+	 * @param MinScore Scores below this are reported as 0.0
+	 * @return Same score as CalculateLevenshteinScore, or 0.0 if below MinScore
+	 */
+	static float CalculateLevenshteinScore(const FFuzzyQuery& Query, FStringView Text, float MinScore = 0.0f)
+	{
+		const int32 QueryLen = Query.Len();
+		const int32 TextLen = Text.Len();
+		if (QueryLen == 0 || TextLen == 0)
+		{
+			return 0.0f;
+		}
+
+		const int32 MaxLen = FMath::Max(QueryLen, TextLen);
+		const int32 MaxDistance = FMath::CeilToInt((1.0f - MinScore) * (float)MaxLen);
+		if (FMath::Abs(TextLen - QueryLen) > MaxDistance)
+		{
+			return 0.0f;
+		}
+
+		int32 Distance = 0;
+		if (QueryLen <= 64)
+		{
+			Distance = BitParallelDistance(Query, Text, MaxDistance);
+			if (Distance == INDEX_NONE)
+			{
+				return 0.0f;
+			}
+		}
+		else
+		{
+			// Rare: queries this long take the allocating DP path
+			Distance = Algo::LevenshteinDistance(Query.Lower, FString(Text).ToLower());
+		}
+
+		const float Score = 1.0f - (float)Distance / (float)MaxLen;
+		return Score >= MinScore ? Score : 0.0f;
+	}
+
+	/**
+	 * Acronym/sequence match against a prepared query, without allocation
+	 * Same rules and scores as MatchesAsAcronym(const FString&, const FString&, float&).
+	 */
+	static bool MatchesAsAcronym(const FFuzzyQuery& Query, FStringView Text, float& OutScore)
+	{
+		OutScore = 0.0f;
+
+		const int32 QueryLen = Query.Len();
+		if (QueryLen == 0 || Text.IsEmpty() || QueryLen >= Text.Len())
+		{
+			return false;
+		}
+
+		int32 QueryIdx = 0;
+		float PositionBonus = 0.0f;
+		int32 LastMatchIdx = -1;
+
+		for (int32 TextIdx = 0; TextIdx < Text.Len() && QueryIdx < QueryLen; ++TextIdx)
+		{
+			if (FChar::ToLower(Text[TextIdx]) != Query.Lower[QueryIdx])
+			{
+				continue;
+			}
+
+			if (LastMatchIdx == -1 || TextIdx == LastMatchIdx + 1)
+			{
+				PositionBonus += 0.15f;
+			}
+			else if (TextIdx > 0)
+			{
+				const TCHAR PrevChar = Text[TextIdx - 1];
+				const TCHAR CurrChar = Text[TextIdx];
+				if (!FChar::IsAlnum(PrevChar) ||
+					(FChar::IsLower(PrevChar) && FChar::IsUpper(CurrChar)))
+				{
+					PositionBonus += 0.1f;
+				}
+			}
+
+			LastMatchIdx = TextIdx;
+			QueryIdx++;
+		}
+
+		if (QueryIdx < QueryLen)
+		{
+			return false;
+		}
+
+		// Every query character matched, so coverage is 1
+		OutScore = 0.7f + FMath::Min(PositionBonus, 0.3f);
+		return OutScore >= 0.5f;
+	}
+
+	/**
+	 * Word-based match against a prepared query, without heap allocation for texts of up to
+	 * 16 words. Same scores as CalculateWordMatchScore(const FString&, const FString&).
+	 */
+	static float CalculateWordMatchScore(const FFuzzyQuery& Query, FStringView Text)
+	{
+		TArray<FStringView, TInlineAllocator<16>> TextWords;
+		int32 WordStart = INDEX_NONE;
+		for (int32 i = 0; i <= Text.Len(); ++i)
+		{
+			const bool bAlnum = i < Text.Len() && FChar::IsAlnum(Text[i]);
+			if (bAlnum && WordStart == INDEX_NONE)
+			{
+				WordStart = i;
+			}
+			else if (!bAlnum && WordStart != INDEX_NONE)
+			{
+				TextWords.Add(Text.Mid(WordStart, i - WordStart));
+				WordStart = INDEX_NONE;
+			}
+		}
+
+		if (Query.Words.Num() == 0 || TextWords.Num() == 0)
+		{
+			return 0.0f;
+		}
+
+		int32 MatchedWords = 0;
+		float TotalWordScore = 0.0f;
+
+		for (int32 QueryWordIdx = 0; QueryWordIdx < Query.Words.Num(); ++QueryWordIdx)
+		{
+			const FStringView QueryWord = Query.GetWord(QueryWordIdx);
+			float BestWordScore = 0.0f;
+
+			for (const FStringView& TextWord : TextWords)
+			{
+				if (QueryWord.Equals(TextWord, ESearchCase::IgnoreCase))
+				{
+					BestWordScore = 1.0f;
+					break;
+				}
+				else if (UE::String::FindFirst(TextWord, QueryWord, ESearchCase::IgnoreCase) != INDEX_NONE)
+				{
+					BestWordScore = FMath::Max(BestWordScore, 0.8f);
+				}
+				else if (UE::String::FindFirst(QueryWord, TextWord, ESearchCase::IgnoreCase) != INDEX_NONE)
+				{
+					BestWordScore = FMath::Max(BestWordScore, 0.6f);
+				}
+			}
+
+			if (BestWordScore > 0.5f)
+			{
+				MatchedWords++;
+			}
+			TotalWordScore += BestWordScore;
+		}
+
+		const float Coverage = (float)MatchedWords / (float)Query.Words.Num();
+		const float AverageScore = TotalWordScore / (float)Query.Words.Num();
+
+		return Coverage * 0.6f + AverageScore * 0.4f;
+	}
+
+	/**
+	 * Case-insensitive substring test that ignores spaces in Text
+	 * Equivalent to Text.ToLower().Replace(" ", "").Contains(Query.Compact) without the copies.
+	 */
+	static bool ContainsIgnoringSpaces(FStringView Text, const FFuzzyQuery& Query)
+	{
+		const FString& Needle = Query.Compact;
+		if (Needle.IsEmpty())
+		{
+			return false;
+		}
+
+		for (int32 Start = 0; Start < Text.Len(); ++Start)
+		{
+			if (Text[Start] == TEXT(' '))
+			{
+				continue;
+			}
+
+			int32 NeedleIdx = 0;
+			for (int32 TextIdx = Start; TextIdx < Text.Len() && NeedleIdx < Needle.Len(); ++TextIdx)
+			{
+				const TCHAR Ch = Text[TextIdx];
+				if (Ch == TEXT(' '))
+				{
+					continue;
+				}
+				if (FChar::ToLower(Ch) != Needle[NeedleIdx])
+				{
+					break;
+				}
+				NeedleIdx++;
+			}
+
+			if (NeedleIdx == Needle.Len())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
 private:
+	/**
+	 * Edit distance between the (lowercased) query and Text, one machine word per text character
+	 * Query length must be 1..64.
+	 * @return The distance, or INDEX_NONE once it is known to exceed MaxDistance
+	 */
+	static int32 BitParallelDistance(const FFuzzyQuery& Query, FStringView Text, int32 MaxDistance)
+	{
+		const int32 QueryLen = Query.Len();
+		const int32 TextLen = Text.Len();
+		const uint64 LastBit = 1ull << (QueryLen - 1);
+
+		// Vertical positive/negative deltas of the DP column
+		uint64 PositiveV = ~0ull;
+		uint64 NegativeV = 0;
+		int32 Distance = QueryLen;
+
+		for (int32 TextIdx = 0; TextIdx < TextLen; ++TextIdx)
+		{
+			const uint64 Eq = Query.GetMask(FChar::ToLower(Text[TextIdx]));
+			const uint64 Xv = Eq | NegativeV;
+			const uint64 Xh = (((Eq & PositiveV) + PositiveV) ^ PositiveV) | Eq;
+			uint64 PositiveH = NegativeV | ~(Xh | PositiveV);
+			uint64 NegativeH = PositiveV & Xh;
+
+			if (PositiveH & LastBit)
+			{
+				Distance++;
+			}
+			else if (NegativeH & LastBit)
+			{
+				Distance--;
+			}
+
+			// Global alignment: the first DP row grows by one per text character
+			PositiveH = (PositiveH << 1) | 1;
+			NegativeH <<= 1;
+			PositiveV = NegativeH | ~(Xv | PositiveH);
+			NegativeV = PositiveH & Xv;
+
+			// Each remaining character can lower the distance by at most one
+			if (Distance - (TextLen - TextIdx - 1) > MaxDistance)
+			{
+				return INDEX_NONE;
+			}
+		}
+
+		return Distance <= MaxDistance ? Distance : INDEX_NONE;
+	}
+
 	/**
 	 * Split string into words (handles CamelCase, snake_case, spaces)
 	 */
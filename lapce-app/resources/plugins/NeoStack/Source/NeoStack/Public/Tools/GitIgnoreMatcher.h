@@ -0,0 +1,72 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Compiled .gitignore rules for the project tree
+ *
+ * Patterns are parsed once per .gitignore into per-segment globs (anchored or basename,
+ * directory-only, negated, "**" spanning any number of directories). The root .gitignore and
+ * every nested one on the way to a path apply, deeper files and later lines winning, and a path
+ * inside an ignored directory is ignored, as in git. Answers for directories are cached, so a
+ * walk that prunes ignored subtrees costs one rule evaluation per visited entry.
+ *
+ * Paths are relative to the project directory with forward slashes; paths outside it are
+ * never ignored. Matching is case-insensitive, as git is on Windows by default.
+ */
+class NEOSTACK_API FGitIgnoreMatcher
+{
+public:
+	/** Forget cached rules and answers so edited .gitignore files are picked up (call per operation) */
+	void Reset();
+
+	/** True if git would ignore RelativePath */
+	bool IsIgnored(const FString& RelativePath, bool bIsDirectory);
+
+	/** Number of rules loaded so far, across all .gitignore files */
+	int32 GetRuleCount() const;
+
+	/** Glob match of one path segment: *, ? and [...] classes, never crossing '/' */
+	static bool MatchSegment(const TCHAR* Pattern, int32 PatternLen, const TCHAR* Text, int32 TextLen);
+
+private:
+	struct FRule
+	{
+		/** Pattern split at '/'; "**" entries match any number of segments */
+		TArray<FString> Segments;
+
+		/** Contains a '/' other than a trailing one: matched from the .gitignore's directory */
+		bool bAnchored = false;
+		bool bDirectoryOnly = false;
+		bool bNegated = false;
+	};
+
+	/** Rules of the .gitignore in one directory (possibly none) */
+	struct FDirectoryRules
+	{
+		/** Directory of the .gitignore relative to the project, "" for the root, else with trailing '/' */
+		FString BaseDir;
+		TArray<FRule> Rules;
+	};
+
+	/** Parse one .gitignore line; false for blanks and comments */
+	static bool CompileRule(const FString& Line, FRule& OutRule);
+
+	static bool MatchSegments(const TArray<FString>& Pattern, int32 PatternIdx, const TArray<FStringView>& Path, int32 PathIdx);
+
+	/** Rules for Directory ("" or "a/b/"), loaded on first use */
+	const FDirectoryRules& GetRules(const FString& Directory);
+
+	/** Evaluate the rules of the path's own ancestors, without the "parent is ignored" check */
+	bool IsIgnoredByRules(const FString& RelativePath, bool bIsDirectory);
+
+	bool IsDirectoryIgnored(const FString& Directory);
+
+	/** Directory ("" or "a/b/") -> its .gitignore rules */
+	TMap<FString, FDirectoryRules> RulesByDirectory;
+
+	/** Directory (no trailing '/') -> ignored, including by an ancestor */
+	TMap<FString, bool> DirectoryIgnored;
+};
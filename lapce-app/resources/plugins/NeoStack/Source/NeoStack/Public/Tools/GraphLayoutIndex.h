@@ -0,0 +1,65 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraph;
+class UEdGraphNode;
+
+/**
+ * Uniform-grid spatial index of node bounds, used to place nodes during one edit call
+ *
+ * Built once from the graph's nodes; every node placed afterwards is added to it, so a
+ * free-slot query only tests the boxes in the grid cells it touches instead of every node in
+ * the graph. Also provides a layered layout for large batches of new nodes.
+ */
+class NEOSTACK_API FGraphLayoutIndex
+{
+public:
+	static constexpr float DefaultNodeWidth = 250.0f;
+	static constexpr float DefaultNodeHeight = 100.0f;
+	static constexpr float SpacingX = 50.0f;
+	static constexpr float SpacingY = 30.0f;
+
+	explicit FGraphLayoutIndex(const UEdGraph* Graph);
+
+	/** Estimated on-screen size of a node (K2 height estimate, stored width if any) */
+	static FVector2D EstimateNodeSize(const UEdGraphNode* Node);
+
+	/** Record a node at its current position */
+	void AddNode(const UEdGraphNode* Node);
+
+	void AddBounds(const FBox2D& Bounds);
+
+	/** True if Bounds touches or intersects any indexed box */
+	bool Overlaps(const FBox2D& Bounds) const;
+
+	/**
+	 * Position for a new node of the default size: right of everything indexed, stepping down
+	 * past overlaps, or further right if no gap is found
+	 */
+	FVector2D FindFreeSlot() const;
+
+	/**
+	 * Lay Nodes out in columns by their longest link path from a source among Nodes, starting
+	 * at Origin. Each column is ordered by the average row of its linked predecessors to keep
+	 * wires short. Links to nodes outside the set are ignored.
+	 */
+	static void LayoutLayered(const TArray<UEdGraphNode*>& Nodes, const FVector2D& Origin);
+
+private:
+	static constexpr float CellSize = 512.0f;
+	static constexpr int32 MaxSlotAttempts = 20;
+
+	static FIntPoint ToCell(const FVector2D& Point);
+
+	TArray<FBox2D> Boxes;
+
+	/** Cell -> indices into Boxes of every box touching the cell */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	float MaxX = 0.0f;
+	float MinY = 0.0f;
+	bool bHasBounds = false;
+};
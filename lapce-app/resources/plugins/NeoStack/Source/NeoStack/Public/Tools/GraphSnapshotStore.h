@@ -0,0 +1,94 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+#include "UObject/ObjectKey.h"
+
+class UEdGraph;
+class UEdGraphNode;
+
+/**
+ * Versioned snapshots of graphs for delta reads
+ *
+ * Every graph read captures a snapshot (a hash per node of its title, pins and pin defaults,
+ * plus the set of links) and hands out a version token for it. A later read that passes the
+ * token back gets only the nodes and links that were added, removed or changed since. Reading
+ * an unchanged graph returns the same token. Only the most recent snapshots are kept; an
+ * evicted or foreign token makes the caller fall back to a full read. Game thread only.
+ */
+class NEOSTACK_API FGraphSnapshotStore
+{
+public:
+	struct FLink
+	{
+		FGuid FromNode;
+		FName FromPin;
+		FGuid ToNode;
+		FName ToPin;
+
+		bool operator==(const FLink& Other) const
+		{
+			return FromNode == Other.FromNode && FromPin == Other.FromPin && ToNode == Other.ToNode && ToPin == Other.ToPin;
+		}
+
+		friend uint32 GetTypeHash(const FLink& Link)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Link.FromNode), GetTypeHash(Link.FromPin)),
+				HashCombine(GetTypeHash(Link.ToNode), GetTypeHash(Link.ToPin)));
+		}
+	};
+
+	struct FDelta
+	{
+		TArray<UEdGraphNode*> AddedNodes;
+		TArray<UEdGraphNode*> ChangedNodes;
+		TArray<FGuid> RemovedNodes;
+		TArray<FLink> AddedLinks;
+		TArray<FLink> RemovedLinks;
+	};
+
+	static FGraphSnapshotStore& Get();
+
+	/** Snapshot the graph and return its version token */
+	FString Capture(const UEdGraph* Graph);
+
+	/**
+	 * Changes to Graph since the snapshot SinceToken was issued for
+	 * @param OutVersion - Token for the graph's current state
+	 * @return False if the token is unknown, evicted or was issued for another graph
+	 */
+	bool Diff(const UEdGraph* Graph, const FString& SinceToken, FDelta& OutDelta, FString& OutVersion);
+
+	/** True if Token was issued for Graph and is still held */
+	bool IsTokenFor(const UEdGraph* Graph, const FString& Token) const;
+
+private:
+	static constexpr int32 MaxSnapshots = 64;
+
+	struct FSnapshot
+	{
+		FObjectKey Graph;
+		TMap<FGuid, uint32> NodeHashes;
+		TSet<FLink> Links;
+		uint64 LastUsed = 0;
+	};
+
+	FGraphSnapshotStore() = default;
+
+	static void Build(const UEdGraph* Graph, FSnapshot& OutSnapshot);
+	static uint32 HashNode(const UEdGraphNode* Node);
+	static bool ParseToken(const FString& Token, uint32& OutVersion);
+
+	/** Store a fresh snapshot (or reuse the graph's latest if unchanged) and return its version */
+	uint32 Commit(const UEdGraph* Graph, FSnapshot&& Snapshot);
+
+	TMap<uint32, FSnapshot> Snapshots;
+
+	/** Graph -> version of its most recent snapshot */
+	TMap<FObjectKey, uint32> LatestVersions;
+
+	uint32 NextVersion = 1;
+	uint64 UseCounter = 0;
+};
@@ -3,6 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
+#include <atomic>
+
+struct FNeoStackProcessedImage;
 
 /**
  * Tool execution result - plain text output, not JSON
@@ -12,6 +16,13 @@ struct NEOSTACK_API FToolResult
 	bool bSuccess = false;
 	FString Output;
 
+	/** Served by FToolResultCache; CachedDurationMs is how long the original call took */
+	bool bFromCache = false;
+	float CachedDurationMs = 0.0f;
+
+	/** Images sent to the agent along with Output (e.g. capture_viewport) */
+	TArray<TSharedPtr<const FNeoStackProcessedImage>> Images;
+
 	static FToolResult Ok(const FString& Message)
 	{
 		FToolResult R;
@@ -29,6 +40,78 @@ struct NEOSTACK_API FToolResult
 	}
 };
 
+/**
+ * Asks an execution to stop early. Cancel may be called from any thread; the work polls
+ * IsCancelled between slices and stops at the next point where that is safe.
+ */
+class FNeoStackCancellationToken
+{
+public:
+	void Cancel() { bCancelled.store(true, std::memory_order_relaxed); }
+	bool IsCancelled() const { return bCancelled.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<bool> bCancelled{false};
+};
+
+/** Progress of an asynchronous tool: Fraction in [0, 1] (negative if unknown) and a short status line */
+DECLARE_DELEGATE_TwoParams(FOnToolProgress, float /*Fraction*/, const FString& /*Status*/);
+
+/**
+ * One asynchronous tool execution, stepped on the game thread by FNeoStackToolRegistry
+ *
+ * Step does a slice of game-thread (UObject) work and returns once it is finished or the
+ * deadline has passed. Work that touches no UObjects can be handed to the thread pool with
+ * RunOnWorker; the task is not stepped again until that work returns. The task must stay
+ * alive until then, which the registry guarantees for the tasks it runs.
+ *
+ * Once the caller cancels, the registry stops stepping read-only tasks, and tasks that haven't
+ * started, on its own. Mutating tasks that have started are stepped until they finish, so they
+ * should check IsCancelled between slices and stop where that leaves things consistent.
+ */
+class NEOSTACK_API FNeoStackToolTask
+{
+public:
+	virtual ~FNeoStackToolTask() = default;
+
+	/**
+	 * Do game-thread work until FPlatformTime::Seconds() reaches Deadline
+	 * @return True once Result holds the final result
+	 */
+	virtual bool Step(double Deadline) = 0;
+
+	/** True while work started with RunOnWorker is still running */
+	bool IsWaitingForWorker() const { return WorkerDone.IsValid() && !WorkerDone.IsReady(); }
+
+	/** Block until worker-thread work has returned (shutdown only) */
+	void WaitForWorker() const;
+
+	/** Final result; read by the scheduler once Step returns true */
+	FToolResult Result;
+
+	/** Latest reported progress (see FOnToolProgress) */
+	float Progress = -1.0f;
+	FString Status;
+
+	/** Set by the registry when the caller passed a token */
+	TSharedPtr<FNeoStackCancellationToken> CancelToken;
+
+	bool IsCancelled() const { return CancelToken.IsValid() && CancelToken->IsCancelled(); }
+
+protected:
+	void ReportProgress(float Fraction, const FString& InStatus)
+	{
+		Progress = Fraction;
+		Status = InStatus;
+	}
+
+	/** Run Work on the thread pool; it must not touch UObjects */
+	void RunOnWorker(TUniqueFunction<void()>&& Work);
+
+private:
+	TFuture<void> WorkerDone;
+};
+
 /**
  * Base class for all NeoStack tools
  * Each tool should inherit from this and implement the virtual methods
@@ -46,4 +129,27 @@ public:
 
 	/** Execute the tool with JSON arguments, return plain text result */
 	virtual FToolResult Execute(const TSharedPtr<class FJsonObject>& Args) = 0;
+
+	/**
+	 * Start an asynchronous execution (see FNeoStackToolRegistry::ExecuteAsync)
+	 * The default task runs Execute in a single step; tools with slow work override this to
+	 * move it to worker threads or split it into budgeted slices.
+	 */
+	virtual TSharedRef<FNeoStackToolTask> CreateTask(const TSharedPtr<class FJsonObject>& Args);
+
+	/** True if the tool never modifies assets or files; read-only calls never wait for each other */
+	virtual bool IsReadOnly() const { return false; }
+
+	/**
+	 * Opt in to FToolResultCache for a call: the result depends only on the arguments and the
+	 * resources reported by GetTouchedResources. Only honoured for read-only tools.
+	 */
+	virtual bool IsCacheable(const TSharedPtr<class FJsonObject>& Args) const { return false; }
+
+	/**
+	 * Assets or files a call reads or modifies, as NeoStackToolUtils::GetResourceKey keys
+	 * Calls touching the same key are run in order if either one mutates. A mutating call
+	 * that reports nothing is run only after everything before it, and before anything after it.
+	 */
+	virtual void GetTouchedResources(const TSharedPtr<class FJsonObject>& Args, TArray<FString>& OutKeys) const {}
 };
@@ -4,10 +4,35 @@
 
 #include "CoreMinimal.h"
 #include "Tools/NeoStackToolBase.h"
+#include "Containers/Ticker.h"
 
 /**
  * Central registry for all NeoStack tools
  * Singleton that manages tool registration and execution
+ *
+ * Execute runs a tool to completion on the calling thread. ExecuteAsync hands it to a
+ * scheduler that steps the tool's task on the core ticker, sharing the "Tool Frame Budget"
+ * between all running tasks, so a slow tool no longer stalls Slate for its whole duration.
+ *
+ * Asynchronous calls run side by side unless they conflict: read-only calls never wait,
+ * while a call that mutates an asset or file (see FNeoStackToolBase::GetTouchedResources)
+ * only starts once every earlier call touching the same resource has finished, and later
+ * calls touching it wait for it in turn. Calls therefore observe each other's changes in
+ * the order they were made.
+ *
+ * Both paths serve repeated calls of cacheable tools from FToolResultCache ("Cache Tool
+ * Results" setting), and tell it about every finished mutating call. Every call is recorded
+ * in FNeoStackToolStats and traced on NeoStackToolsChannel. Mutating calls run inside an
+ * FTurnCheckpoint::FEditScope, which with "Turn Checkpoints" on snapshots what they change
+ * instead of filling the undo buffer.
+ *
+ * An asynchronous call's assets are prefetched (FAssetPrefetcher) when it is made, and it is
+ * not stepped until they have loaded, so the loads of a batch overlap.
+ *
+ * Blueprint compiles the tools ask for (FBlueprintCompileScheduler) run once the last
+ * running call has finished, so a batch of edits compiles each Blueprint once. Calls that
+ * asked for one are held back until then and get its diagnostics added to their output; one
+ * held back for MaxCompileHoldSeconds while other calls keep running has its compiles run early.
  */
 class NEOSTACK_API FNeoStackToolRegistry
 {
@@ -15,6 +40,9 @@ public:
 	/** Get singleton instance */
 	static FNeoStackToolRegistry& Get();
 
+	/** True once Get() has been called */
+	static bool IsCreated();
+
 	/** Register a tool (takes shared ownership) */
 	void Register(TSharedPtr<FNeoStackToolBase> Tool);
 
@@ -24,6 +52,25 @@ public:
 	/** Execute a tool by name with parsed JSON args */
 	FToolResult Execute(const FString& ToolName, const TSharedPtr<class FJsonObject>& Args);
 
+	/**
+	 * Run a tool without blocking the caller
+	 * The future is fulfilled on the game thread, so continuations attached with Next run there.
+	 * @param OnProgress - Called on the game thread whenever the task reports new progress
+	 * @param CancelToken - Cancelling fails the call with "Cancelled" as soon as the task can stop (see FNeoStackToolTask)
+	 */
+	TFuture<FToolResult> ExecuteAsync(const FString& ToolName, const TSharedPtr<class FJsonObject>& Args,
+		FOnToolProgress OnProgress = FOnToolProgress(), TSharedPtr<FNeoStackCancellationToken> CancelToken = nullptr);
+
+	/** Parse ArgsJson, then ExecuteAsync */
+	TFuture<FToolResult> ExecuteAsync(const FString& ToolName, const FString& ArgsJson,
+		FOnToolProgress OnProgress = FOnToolProgress());
+
+	/** Number of asynchronous executions not yet finished */
+	int32 GetRunningTaskCount() const { return Running.Num(); }
+
+	/** Fail pending asynchronous executions and stop the scheduler (module shutdown) */
+	void Shutdown();
+
 	/** Check if a tool exists */
 	bool HasTool(const FString& ToolName) const;
 
@@ -43,6 +90,91 @@ private:
 	/** Register all built-in tools */
 	void RegisterBuiltInTools();
 
+	/** Parse a JSON args string; empty means no arguments */
+	static TSharedPtr<class FJsonObject> ParseArgs(const FString& ArgsJson);
+
+	static void LogResult(const FString& ToolName, const FToolResult& Result);
+
+	/** FToolResultCache key for a call, or empty if its results aren't cached */
+	static FString GetCacheKey(const FNeoStackToolBase& Tool, const FString& ToolName, const TSharedPtr<class FJsonObject>& Args);
+
+	/** Cache a read-only result under CacheKey, or invalidate what a mutating call touched */
+	static void RecordResult(bool bReadOnly, const FString& CacheKey, const TArray<FString>& Resources,
+		const FToolResult& Result, double DurationMs);
+
+	/** An ExecuteAsync call in progress */
+	struct FRunningTask
+	{
+		FString ToolName;
+		TSharedPtr<FNeoStackToolTask> Task;
+		TPromise<FToolResult> Promise;
+		FOnToolProgress OnProgress;
+
+		/** Scheduling declarations, captured when the call was made */
+		bool bReadOnly = false;
+		TArray<FString> Resources;
+		FString CacheKey;
+
+		/** Packages being loaded for the call; it starts once they are in */
+		TArray<FName> PrefetchPackages;
+
+		/** Stepped at least once; never blocked again */
+		bool bStarted = false;
+
+		/** Spent in Step so far, for FNeoStackToolStats */
+		double GameThreadSeconds = 0.0;
+		int64 MemoryDeltaBytes = 0;
+
+		float LastProgress = -1.0f;
+		FString LastStatus;
+		double StartTime = 0.0;
+
+		/** Attributes the task's compile requests to it (FBlueprintCompileScheduler) */
+		uint32 CompileCallerId = 0;
+
+		/** When the task finished and was held back for its compiles */
+		double HeldSince = 0.0;
+	};
+
+	/** Ticker callback - steps running tasks within the frame budget */
+	bool HandleTick(float DeltaTime);
+
+	/** True if A and B may not run at the same time */
+	static bool Conflicts(const FRunningTask& A, const FRunningTask& B);
+
+	/** True while an earlier running task conflicts with Running[Index] */
+	bool IsBlocked(int32 Index) const;
+
+	/** Remove a finished task, then fulfil its promise or hold it back until its compiles ran */
+	void CompleteTask(int32 Index);
+
+	/** Add the task's compile diagnostics, record and fulfil its promise */
+	void FinishTask(TUniquePtr<FRunningTask> Entry);
+
+	/** Run the batch's Blueprint compiles and fulfil the tasks that waited for them */
+	void FlushCompiles();
+
+	/** Run the compiles of tasks held back longer than MaxCompileHoldSeconds and fulfil them */
+	void FlushOverdueCompiles();
+
+	/** Longest a finished call waits for the end of its batch to compile */
+	static constexpr double MaxCompileHoldSeconds = 2.0;
+
+	/** Fail a cancelled task that can stop now and remove it; nothing is cached or invalidated */
+	void CancelTask(int32 Index);
+
 	/** Map of tool name -> tool instance */
 	TMap<FString, TSharedPtr<FNeoStackToolBase>> Tools;
+
+	/** Asynchronous executions in start order */
+	TArray<TUniquePtr<FRunningTask>> Running;
+
+	/** Finished tasks waiting for the end of the batch to compile */
+	TArray<TUniquePtr<FRunningTask>> AwaitingCompile;
+
+	/** Running task stepped first next tick, so tasks left over when the budget runs out go first */
+	int32 NextTaskIndex = 0;
+
+	FTSTicker::FDelegateHandle TickHandle;
+	bool bShutdown = false;
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Misc/StringBuilder.h"
 
 class UBlueprint;
 class UEdGraph;
@@ -27,6 +28,15 @@ namespace NeoStackToolUtils
 	/** Build asset path in /Game/ format */
 	FString BuildAssetPath(const FString& Name, const FString& Path);
 
+	/**
+	 * Case-insensitive key for the asset (package path) or file a Name/Path pair refers to,
+	 * so two spellings of the same target compare equal. Empty if Name is empty.
+	 */
+	FString GetResourceKey(const FString& Name, const FString& Path);
+
+	/** GetResourceKey for the "name" and "path" arguments most tools take */
+	void AddNamePathResource(const TSharedPtr<class FJsonObject>& Args, TArray<FString>& OutKeys);
+
 	/** Ensure directory exists, create if needed */
 	bool EnsureDirectoryExists(const FString& FilePath, FString& OutError);
 
@@ -69,4 +79,79 @@ namespace NeoStackToolUtils
 
 	/** Find pin by name on a node */
 	UEdGraphPin* FindPinByName(UEdGraphNode* Node, const FString& PinName, EEdGraphPinDirection Direction = EGPD_MAX);
+
+	//--------------------------------------------------------------------
+	// Output Utilities
+	//--------------------------------------------------------------------
+
+	/**
+	 * Builds tool output in one growing buffer instead of FString += FString::Printf chains,
+	 * which allocate a temporary per line and reallocate the result as it grows.
+	 *
+	 * Construct with a size hint close to the expected output. Once MaxChars is reached further
+	 * writes are dropped, and ToString() cuts back to the last complete line and appends a
+	 * "# TRUNCATED" marker, so a huge graph or directory can't produce an unbounded reply.
+	 */
+	class NEOSTACK_API FToolOutputWriter
+	{
+	public:
+		static constexpr int32 DefaultMaxChars = 512 * 1024;
+
+		explicit FToolOutputWriter(int32 SizeHint = 1024, int32 InMaxChars = DefaultMaxChars);
+
+		template <typename FmtType, typename... Types>
+		FToolOutputWriter& Appendf(const FmtType& Fmt, Types... Args)
+		{
+			if (HasRoom())
+			{
+				Builder.Appendf(Fmt, Args...);
+			}
+			return *this;
+		}
+
+		FToolOutputWriter& Append(FStringView Text);
+		FToolOutputWriter& AppendChar(TCHAR Char);
+		FToolOutputWriter& AppendInt(int64 Value);
+
+		FToolOutputWriter& Tab() { return AppendChar(TEXT('\t')); }
+		FToolOutputWriter& Newline() { return AppendChar(TEXT('\n')); }
+
+		/** Write cells separated by tabs and end the line */
+		FToolOutputWriter& Row(std::initializer_list<FStringView> Cells);
+
+		/** Write Items separated by Separator */
+		FToolOutputWriter& Join(const TArray<FString>& Items, FStringView Separator);
+
+		/** True once writes have been dropped because the output hit MaxChars */
+		bool IsTruncated() const { return bTruncated; }
+
+		int32 Len() const { return Builder.Len(); }
+		bool IsEmpty() const { return Builder.Len() == 0; }
+		FStringView ToView() const { return Builder.ToView(); }
+
+		/** Finished output, with a truncation marker if writes were dropped */
+		FString ToString() const;
+
+	private:
+		bool HasRoom()
+		{
+			if (Builder.Len() < MaxChars)
+			{
+				return true;
+			}
+			bTruncated = true;
+			return false;
+		}
+
+		TStringBuilder<512> Builder;
+		int32 MaxChars;
+		bool bTruncated = false;
+	};
+
+	/**
+	 * Output cut back to the last complete line within MaxChars, with the same "# TRUNCATED"
+	 * marker FToolOutputWriter adds. For replies assembled from several writers, each of which
+	 * only caps its own part.
+	 */
+	NEOSTACK_API FString CapToolOutput(FString Output, int32 MaxChars = FToolOutputWriter::DefaultMaxChars);
 }
@@ -4,17 +4,27 @@
 
 #include "CoreMinimal.h"
 #include "Misc/Guid.h"
+#include "Containers/Ticker.h"
+#include "Async/Future.h"
+
+class UEdGraph;
 
 /**
  * Session-persistent registry mapping node names to GUIDs.
  * Allows AI to reference nodes by friendly names across multiple tool calls.
  *
- * Key format: "AssetPath|GraphName|NodeName"
+ * Stored as Asset -> Graph -> Name maps keyed by FName, so lookups don't build keys and
+ * clearing a graph or asset only touches its own entries. Names are case-insensitive.
  *
  * Behavior:
  * - New name: Registers name -> GUID mapping
  * - Existing name: Replaces with new GUID (handles AI retries)
  * - Lookup: Returns GUID for name, or invalid GUID if not found
+ *
+ * With "Persist Node Names" enabled the registry is saved to Saved/NeoStack/node_names.json
+ * shortly after changes and reloaded on first use. Loaded entries for assets that no longer
+ * exist are dropped; the rest are checked against the graph's nodes by ValidateGraph the
+ * first time the graph is edited.
  */
 class NEOSTACK_API FNodeNameRegistry
 {
@@ -54,6 +64,12 @@ public:
 	void Unregister(const FString& AssetPath, const FString& GraphName,
 	                const FString& NodeName);
 
+	/**
+	 * Drop names loaded from disk whose GUID no longer matches a node in Graph.
+	 * Cheap after the first call for a graph.
+	 */
+	void ValidateGraph(const FString& AssetPath, const UEdGraph* Graph);
+
 	/**
 	 * Clear all registrations for a specific graph
 	 */
@@ -72,18 +88,48 @@ public:
 	/**
 	 * Get count of registered names
 	 */
-	int32 GetCount() const { return Registry.Num(); }
+	int32 GetCount() const { return Count; }
+
+	/** Write pending changes and stop the save timer (module shutdown) */
+	void Shutdown();
 
 private:
+	static constexpr float SaveDelaySeconds = 2.0f;
+
+	struct FGraphNames
+	{
+		TMap<FName, FGuid> Names;
+
+		/** False for names loaded from disk until checked against the graph */
+		bool bValidated = true;
+	};
+
+	typedef TMap<FName, FGraphNames> FAssetNames;
+
 	FNodeNameRegistry() = default;
 	~FNodeNameRegistry() = default;
 
-	/** Build registry key from components */
-	static FString MakeKey(const FString& AssetPath, const FString& GraphName, const FString& NodeName);
+	/** Existing FName for Text, or NAME_None without adding it to the name table */
+	static FName FindName(const FString& Text);
+
+	const FGraphNames* FindGraph(const FString& AssetPath, const FString& GraphName) const;
+
+	static FString GetSaveFilePath();
+
+	void LoadIfNeeded() const;
+	void MarkDirty();
+	bool HandleSaveTick(float DeltaTime);
+	void Save(bool bAsync);
+	static void WriteFile(const TSharedRef<class FJsonObject>& Root);
+
+	/** Asset path -> graph name -> node name -> GUID; mutable so const lookups can load lazily */
+	mutable TMap<FName, FAssetNames> Assets;
+
+	mutable int32 Count = 0;
+	mutable bool bLoaded = false;
 
-	/** Parse key back to components (for iteration/clearing) */
-	static bool ParseKey(const FString& Key, FString& OutAssetPath, FString& OutGraphName, FString& OutNodeName);
+	FTSTicker::FDelegateHandle SaveTickerHandle;
 
-	/** The registry: Key -> GUID */
-	TMap<FString, FGuid> Registry;
+	/** The last save on the thread pool; a later save waits for it, as they write the same .tmp file */
+	TFuture<void> PendingSave;
 };
@@ -0,0 +1,132 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UBlueprint;
+class UBlueprintNodeSpawner;
+class UEdGraph;
+
+/**
+ * Session-persistent search index over the Blueprint action database.
+ *
+ * find_node used to prime the UI spec of every spawner and score all of them on each call.
+ * This index extracts title, keywords, category and spawner ID once, and maps them to the
+ * spawners through trigram and initials posting lists, so a query only visits spawners
+ * that share text with it. Queries the postings can't answer as well as a scan (shorter
+ * than a trigram, or typos that leave too few candidates) still visit every spawner. Pin signatures and flags are filled in the first time a spawner
+ * shows up in results and reused afterwards.
+ *
+ * Entries are grouped by their action-database key (usually the owning asset or class).
+ * OnEntryUpdated/OnEntryRemoved from the database and OnChanged from queried Blueprints mark
+ * a key dirty, and only that key's spawners are re-read on the next query.
+ */
+class NEOSTACK_API FNodeSpawnerIndex
+{
+public:
+	/** One indexed spawner */
+	struct FEntry
+	{
+		TWeakObjectPtr<UBlueprintNodeSpawner> Spawner;
+		FObjectKey Owner;
+
+		FString Name;
+		FString Category;
+		FString Keywords;
+		FString Tooltip;
+		FString SpawnerId;
+
+		/** Cached from the template node the first time the entry is a hit */
+		bool bPinsCached = false;
+		TArray<FString> InputPins;
+		TArray<FString> OutputPins;
+		TArray<FString> Flags;
+
+		/** Replaced by a re-index of its owner; skipped until the next compaction */
+		bool bRemoved = false;
+	};
+
+	/** Get singleton instance */
+	static FNodeSpawnerIndex& Get();
+
+	/**
+	 * Bring the index up to date: full build on first use, otherwise re-read dirty owners
+	 * @param ContextGraph - Graph used to prime the UI spec of newly indexed spawners
+	 */
+	void Sync(UEdGraph* ContextGraph);
+
+	/** Re-index this Blueprint's spawners whenever it changes */
+	void WatchBlueprint(UBlueprint* Blueprint);
+
+	/**
+	 * Entries that could match a (lowercased) query
+	 * Candidates share enough trigrams with the query or have initials starting with it. When
+	 * the query is shorter than a trigram, or fewer than MinCandidates entries qualify, every
+	 * live entry is a candidate, as in a full scan. Exact scoring is left to the caller.
+	 */
+	void FindCandidates(const FString& LowerQuery, TSet<int32>& OutCandidates) const;
+
+	/** Entry by index (from FindCandidates) */
+	FEntry& GetEntry(int32 Index) { return Entries[Index]; }
+
+	/** Live (not removed) entry count */
+	int32 GetCount() const { return Entries.Num() - RemovedCount; }
+
+	/** Drop delegate registrations (module shutdown) */
+	void Shutdown();
+
+	/** Below this many candidates a query falls back to all entries, so typos keep their matches */
+	static constexpr int32 MinCandidates = 64;
+
+	/** Stable ID a spawner is referred to by in find_node results and edit_graph */
+	static FString MakeSpawnerId(UBlueprintNodeSpawner* Spawner);
+
+private:
+	FNodeSpawnerIndex() = default;
+	~FNodeSpawnerIndex() = default;
+
+	/** Index every spawner in the action database */
+	void BuildAll(UEdGraph* ContextGraph);
+
+	/** Replace the entries of one owner with what the database holds for it now */
+	void ReindexOwner(const FObjectKey& Owner, UEdGraph* ContextGraph);
+
+	/** Index one spawner under Owner */
+	void AddSpawner(UBlueprintNodeSpawner* Spawner, const FObjectKey& Owner, UEdGraph* ContextGraph);
+
+	/** Add an entry's text to the posting lists */
+	void AddPostings(int32 EntryIndex);
+
+	void HandleEntryChanged(UObject* ActionKey);
+	void HandleBlueprintChanged(UBlueprint* Blueprint);
+
+	/** Pack three characters into one posting key */
+	static uint64 MakeTrigram(TCHAR A, TCHAR B, TCHAR C);
+
+	/** Trigrams of a string, spaces removed */
+	static void CollectTrigrams(const FString& LowerText, TSet<uint64>& OutTrigrams);
+
+	TArray<FEntry> Entries;
+
+	/** Owner -> indices of its entries */
+	TMap<FObjectKey, TArray<int32>> EntriesByOwner;
+
+	/** Trigram -> entries containing it in the name or keywords */
+	TMap<uint64, TArray<int32>> TrigramPostings;
+
+	/** First two word initials -> entries (for acronym queries) */
+	TMap<FString, TArray<int32>> InitialsPostings;
+
+	/** Owners whose entries must be re-read on the next Sync */
+	TSet<FObjectKey> DirtyOwners;
+
+	/** Blueprints with an OnChanged registration */
+	TArray<TWeakObjectPtr<UBlueprint>> WatchedBlueprints;
+
+	int32 RemovedCount = 0;
+	bool bBuilt = false;
+	bool bDelegatesRegistered = false;
+};
@@ -0,0 +1,88 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/**
+ * A property path resolved against a class or struct: "bReplicates",
+ * "BodyInstance.CollisionProfileName", "Points[2].X". Every segment names a property; array
+ * segments also carry the element index.
+ */
+struct FResolvedPropertyPath
+{
+	struct FSegment
+	{
+		FProperty* Property = nullptr;
+
+		/** Element of an array property, or INDEX_NONE for the property itself */
+		int32 ArrayIndex = INDEX_NONE;
+	};
+
+	TArray<FSegment> Segments;
+
+	/** The path spelled with the real property names */
+	FString DisplayPath;
+
+	/** Property the path ends on (an array's inner property when it ends on an element) */
+	FProperty* GetLeafProperty() const;
+
+	/** Outermost property; the one PreEditChange and PostEditChangeProperty are told about */
+	FProperty* GetMemberProperty() const { return Segments[0].Property; }
+
+	/** Address of the leaf value inside Container, or null if an array index is out of range */
+	void* GetValuePtr(void* Container) const;
+};
+
+/**
+ * Property lookups cached per class or struct.
+ *
+ * Each struct's properties are indexed by lowercase name once, and every path resolved against
+ * it is kept, so repeated get/set calls skip the field walk. An entry is rebuilt when the
+ * struct's property chain changes (a Blueprint class or User Defined Struct was recompiled),
+ * and everything is dropped whenever a Blueprint compiles. Game thread only.
+ */
+class NEOSTACK_API FPropertyPathCache
+{
+public:
+	static FPropertyPathCache& Get();
+
+	/**
+	 * Resolve a dotted path against Struct, case-insensitive, with "[N]" for array elements
+	 * @return False with OutError if a segment names no property or indexes a non-array
+	 */
+	bool Resolve(const UStruct* Struct, const FString& Path, FResolvedPropertyPath& OutPath, FString& OutError);
+
+	/** Editable, non-deprecated properties of a class or struct, including inherited ones */
+	TArray<FProperty*> GetEditableProperties(const UStruct* Struct);
+
+	/** Unregister delegates and drop all entries (module shutdown) */
+	void Shutdown();
+
+private:
+	struct FStructEntry
+	{
+		/** Lowercase name -> property; the most derived one wins */
+		TMap<FString, FProperty*> ByName;
+
+		TArray<FProperty*> Editable;
+
+		/** Lowercase path -> resolved path */
+		TMap<FString, FResolvedPropertyPath> Paths;
+
+		/** Head of the struct's own property chain when built; replaced when it recompiles */
+		const FField* ChildProperties = nullptr;
+	};
+
+	FPropertyPathCache() = default;
+
+	/** Entry for Struct, built or rebuilt as needed; stays valid while other entries are added */
+	FStructEntry& GetEntry(const UStruct* Struct);
+
+	void HandleBlueprintCompiled();
+
+	TMap<TWeakObjectPtr<const UStruct>, TUniquePtr<FStructEntry>> Entries;
+
+	bool bDelegatesRegistered = false;
+};
@@ -12,22 +12,28 @@ class UAnimBlueprint;
 class UEdGraph;
 class UBehaviorTree;
 class UBTCompositeNode;
+class UBTTaskNode;
+struct FBTCompositeChild;
 class UBlackboardData;
 class UUserDefinedStruct;
 class UUserDefinedEnum;
 class UDataTable;
 
+namespace NeoStackToolUtils { class FToolOutputWriter; }
+
 /**
  * Tool for reading files and UE assets (Blueprint, Material, WidgetBlueprint, AnimBlueprint, BehaviorTree, etc.)
  * - Text files: returns content with pagination
  * - Graph assets: returns nodes and connections using shared UEdGraph reading
- * - Widget Blueprints: returns widget tree hierarchy
+ * - Widget Blueprints: returns widget tree hierarchy, from any widget down and paged
  * - Animation Blueprints: returns state machines, states, transitions, and their subgraphs
- * - Behavior Trees: returns node hierarchy with composites, tasks, decorators, and services
+ * - Behavior Trees: returns node hierarchy with composites, tasks, decorators, and services,
+ *   from any node path down and paged
  * - Blackboards: returns keys with types and inheritance
  * - User Defined Structs: returns fields with names, types, and default values
  * - User Defined Enums: returns values with names and display names
- * - DataTables: returns row struct info and row data
+ * - DataTables: returns row struct info and row data, optionally projected to a few columns
+ *   and filtered by "column op value" predicates
  */
 class NEOSTACK_API FReadFileTool : public FNeoStackToolBase
 {
@@ -39,11 +45,66 @@ public:
 	}
 
 	virtual FToolResult Execute(const TSharedPtr<FJsonObject>& Args) override;
+	virtual bool IsReadOnly() const override { return true; }
+	/** Text files only; asset reads are cached per package by FAssetReadCache */
+	virtual bool IsCacheable(const TSharedPtr<FJsonObject>& Args) const override;
+	virtual void GetTouchedResources(const TSharedPtr<FJsonObject>& Args, TArray<FString>& OutKeys) const override;
 
 private:
+	/** Column projection and row filters for DataTable reads */
+	struct FDataTableQuery
+	{
+		/** Columns to output, in order; empty for all */
+		TArray<FString> Columns;
+
+		/** "column op value" predicates a row must all pass */
+		TArray<FString> Where;
+	};
+
+	/** Subtree addressing for widget tree and behavior tree reads; offset/limit page the listed nodes */
+	struct FTreeQuery
+	{
+		/** Widget name or behavior tree node path ("/1/0", "/Combat/Attack") to start at; empty for the whole tree */
+		FString Root;
+
+		/** Levels below the start node to list; INDEX_NONE for all */
+		int32 MaxDepth = INDEX_NONE;
+	};
+
+	/** One widget of a tree listing */
+	struct FWidgetListEntry
+	{
+		UWidget* Widget = nullptr;
+		int32 Depth = 0;
+
+		/** Children left out by the depth limit */
+		int32 HiddenChildren = 0;
+	};
+
+	/** One behavior tree node of a listing, with the decorators on the link from its parent */
+	struct FBTListEntry
+	{
+		UBTCompositeNode* Composite = nullptr;
+		UBTTaskNode* Task = nullptr;
+		const FBTCompositeChild* Link = nullptr;
+		int32 Depth = 0;
+		int32 HiddenChildren = 0;
+
+		/** Child-index path from the tree root, "/" for the root */
+		FString Path;
+	};
+
 	/** Read a text file with pagination */
 	FToolResult ReadTextFile(const FString& Name, const FString& Path, int32 Offset, int32 Limit);
 
+	/** Render the requested sections of a loaded asset */
+	FToolResult ReadAsset(UObject* Asset, const TArray<FString>& Include, const FString& GraphName,
+		const TArray<FString>& SinceTokens, int32 Offset, int32 Limit, bool bCompact, const FDataTableQuery& TableQuery,
+		const FTreeQuery& TreeQuery);
+
+	/** False when the rendered output could change without the asset's package changing */
+	bool IsReadCacheable(UObject* Asset) const;
+
 	/** Get Blueprint summary with graph list */
 	FString GetBlueprintSummary(class UBlueprint* Blueprint);
 
@@ -62,23 +123,42 @@ private:
 	/** Get graph type string */
 	FString GetGraphType(class UEdGraph* Graph, class UBlueprint* Blueprint);
 
+	/** Get a graph in the requested form: a delta if a since-token matches it, else compact or full */
+	FString GetGraphOutput(class UEdGraph* Graph, const FString& GraphType, const FString& AssetPath,
+		const TArray<FString>& SinceTokens, int32 Offset, int32 Limit, bool bCompact);
+
+	/** Get the nodes and connections added, removed or changed since a version token */
+	FString GetGraphDelta(class UEdGraph* Graph, const FString& GraphType, const FString& SinceToken);
+
 	/** Get single graph with nodes in UNIX format */
 	FString GetGraphWithNodes(class UEdGraph* Graph, const FString& GraphType, const FString& ParentGraph, int32 Offset, int32 Limit);
 
 	/** Get connections for a graph */
 	FString GetGraphConnections(class UEdGraph* Graph);
 
+	/**
+	 * Get a graph with nodes and connections in compact form: nodes as "@N" aliases registered
+	 * with FNodeNameRegistry (so edit_graph accepts them), pins as indices into a PINS table
+	 */
+	FString GetCompactGraph(class UEdGraph* Graph, const FString& GraphType, const FString& AssetPath, int32 Offset, int32 Limit);
+
 	/** Get pin names for a node */
 	FString GetNodePins(class UEdGraphNode* Node);
 
 	/** Get Widget Blueprint summary */
 	FString GetWidgetBlueprintSummary(UWidgetBlueprint* WidgetBlueprint);
 
-	/** Get widget tree structure */
-	FString GetWidgetTree(UWidgetBlueprint* WidgetBlueprint);
+	/**
+	 * Get widget tree structure from the query's root widget down. Widgets are collected first
+	 * and only the Offset/Limit page is written, with a "# MORE" marker when more follow.
+	 */
+	FString GetWidgetTree(UWidgetBlueprint* WidgetBlueprint, const FTreeQuery& Query, int32 Offset, int32 Limit, FString& OutError);
+
+	/** Depth-first list of Widget and its descendants down to MaxDepth levels below it */
+	static void CollectWidgetEntries(UWidget* Widget, int32 Depth, int32 MaxDepth, TArray<FWidgetListEntry>& OutEntries);
 
-	/** Recursively get widget hierarchy */
-	FString GetWidgetHierarchy(UWidget* Widget, int32 Depth);
+	/** Write one widget line */
+	static void AppendWidgetLine(NeoStackToolUtils::FToolOutputWriter& Output, const FWidgetListEntry& Entry);
 
 	// Animation Blueprint support
 
@@ -99,11 +179,20 @@ private:
 	/** Count nodes recursively in the behavior tree */
 	void CountBTNodes(UBTCompositeNode* Node, int32& OutTasks, int32& OutComposites, int32& OutDecorators, int32& OutServices);
 
-	/** Get behavior tree node hierarchy */
-	FString GetBehaviorTreeNodes(UBehaviorTree* BehaviorTree);
+	/** Get behavior tree node hierarchy from the query's root node down, paged like GetWidgetTree */
+	FString GetBehaviorTreeNodes(UBehaviorTree* BehaviorTree, const FTreeQuery& Query, int32 Offset, int32 Limit, FString& OutError);
+
+	/**
+	 * Resolve a node path: segments are child indices or node names (case-insensitive)
+	 * @return False with OutError naming the segment that matched no child
+	 */
+	static bool FindBTNodeByPath(UBehaviorTree* BehaviorTree, const FString& Path, FBTListEntry& OutEntry, FString& OutError);
+
+	/** Depth-first list of Entry's subtree down to MaxDepth levels below it */
+	static void CollectBTEntries(const FBTListEntry& Entry, int32 MaxDepth, TArray<FBTListEntry>& OutEntries);
 
-	/** Recursively get BT node hierarchy with decorators and services */
-	FString GetBTNodeHierarchy(UBTCompositeNode* Node, int32 Depth);
+	/** Write one node with the decorators on its link and its services */
+	static void AppendBTNodeLines(NeoStackToolUtils::FToolOutputWriter& Output, const FBTListEntry& Entry);
 
 	// Blackboard support
 
@@ -134,6 +223,10 @@ private:
 	/** Get DataTable summary with row struct and row count */
 	FString GetDataTableSummary(UDataTable* DataTable);
 
-	/** Get DataTable rows with values */
-	FString GetDataTableRows(UDataTable* DataTable, int32 Offset, int32 Limit);
+	/**
+	 * Get DataTable rows with values. Offset and Limit page through the rows that pass the
+	 * query's filters; only the projected columns are exported.
+	 * @param OutError - Set when the query names an unknown column or has a bad filter
+	 */
+	FString GetDataTableRows(UDataTable* DataTable, int32 Offset, int32 Limit, const FDataTableQuery& Query, FString& OutError);
 };
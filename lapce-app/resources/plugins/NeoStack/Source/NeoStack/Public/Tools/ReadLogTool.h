@@ -0,0 +1,29 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tools/NeoStackToolBase.h"
+
+/**
+ * Reads the editor log from FNeoStackLogCapture's in-memory ring, never from Saved/Logs
+ * - Filters by category, minimum verbosity and a regular expression on the message
+ * - "since" takes the cursor a previous call returned and lists only lines logged after it,
+ *   so following a compile or a PIE session costs one call per new batch of lines
+ * - Without "since" the last "limit" matching lines are listed
+ */
+class NEOSTACK_API FReadLogTool : public FNeoStackToolBase
+{
+public:
+	virtual FString GetName() const override { return TEXT("read_log"); }
+	virtual FString GetDescription() const override
+	{
+		return TEXT("Read recent editor log lines, filtered by category, verbosity and regex, incrementally from a cursor");
+	}
+
+	virtual FToolResult Execute(const TSharedPtr<FJsonObject>& Args) override;
+	virtual bool IsReadOnly() const override { return true; }
+
+	static constexpr int32 DefaultLimit = 200;
+	static constexpr int32 MaxLimit = 2000;
+};
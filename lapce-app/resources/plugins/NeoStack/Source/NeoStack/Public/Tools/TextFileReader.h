@@ -0,0 +1,62 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Ranged line reads over large text files
+ *
+ * The first read of a file streams it once to record the byte offset of every
+ * CheckpointInterval-th line; subsequent reads seek to the checkpoint before the window and
+ * decode only the requested lines, so paging through a big header or log costs O(window).
+ * Indexes are dropped when the file's timestamp or size changes.
+ *
+ * Lines are split on '\n' with a trailing '\r' removed, and blank lines count, so line numbers
+ * match what editors show. UTF-16 files are read whole. Game thread only.
+ */
+class NEOSTACK_API FTextFileReader
+{
+public:
+	static FTextFileReader& Get();
+
+	/**
+	 * Read lines [StartIndex, StartIndex + Count) of a file
+	 * @param StartIndex - 0-based first line
+	 * @param OutTotalLines - Line count of the whole file
+	 * @return False if the file could not be opened
+	 */
+	bool ReadLines(const FString& FilePath, int32 StartIndex, int32 Count, TArray<FString>& OutLines, int32& OutTotalLines);
+
+private:
+	static constexpr int32 CheckpointInterval = 64;
+	static constexpr int32 MaxCachedFiles = 16;
+
+	struct FLineIndex
+	{
+		FDateTime TimeStamp;
+		int64 FileSize = 0;
+		int32 TotalLines = 0;
+
+		/** Bytes to skip at the start (UTF-8 BOM) */
+		int64 DataStart = 0;
+
+		/** Byte offset of line i * CheckpointInterval */
+		TArray<int64> Checkpoints;
+
+		bool bUtf16 = false;
+		uint64 LastUsed = 0;
+	};
+
+	FTextFileReader() = default;
+
+	/** Cached index for the file, rebuilt if it changed on disk */
+	const FLineIndex* GetIndex(const FString& FilePath);
+
+	static bool BuildIndex(const FString& FilePath, FLineIndex& OutIndex);
+
+	static bool ReadUtf16Lines(const FString& FilePath, int32 StartIndex, int32 Count, TArray<FString>& OutLines, int32& OutTotalLines);
+
+	TMap<FString, FLineIndex> Indexes;
+	uint64 UseCounter = 0;
+};
@@ -0,0 +1,111 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tools/NeoStackToolBase.h"
+#include "UObject/ObjectSaveContext.h"
+
+class FTransactionObjectEvent;
+struct FAssetData;
+
+/**
+ * Memoized results of read-only tool calls, used by FNeoStackToolRegistry for tools that opt in
+ *
+ * Keyed by tool name plus the call's arguments with object keys sorted, so argument order
+ * doesn't matter. An entry also records the generation of every resource the call touched
+ * (FNeoStackToolBase::GetTouchedResources) and is only returned while all of them are
+ * unchanged. A resource's generation is bumped when a mutating tool reports touching it and
+ * when its package is modified, undone/redone or saved. Calls that touch no specific resource
+ * (explore asset searches, find_node without an asset) depend on a global generation instead, which moves on
+ * any mutating tool call and any asset registry change. Blueprint compiles invalidate
+ * everything. A touched text file's modification time and size are recorded with the entry
+ * and checked on every hit, as FTextFileReader::GetIndex does, so edits made outside the
+ * editor are seen at once. Asset files replaced on disk (a source control sync) aren't
+ * observed, so entries also expire after MaxAgeSeconds. Game thread only.
+ */
+class NEOSTACK_API FToolResultCache
+{
+public:
+	static FToolResultCache& Get();
+
+	/** Cache key for a call */
+	static FString MakeKey(const FString& ToolName, const TSharedPtr<class FJsonObject>& Args);
+
+	/** Cached result for Key (with bFromCache set), or null if missing or stale */
+	const FToolResult* Find(const FString& Key);
+
+	/** Remember a successful result of a call that touched Resources */
+	void Store(const FString& Key, const TArray<FString>& Resources, const FToolResult& Result, double DurationMs);
+
+	/** A mutating tool call finished; Resources are what it reported touching */
+	void NotifyMutation(const TArray<FString>& Resources);
+
+	/** Unregister delegates and drop all entries (module shutdown) */
+	void Shutdown();
+
+private:
+	static constexpr int32 MaxEntries = 256;
+	static constexpr int32 MaxTotalChars = 8 * 1024 * 1024;
+	static constexpr double MaxAgeSeconds = 60.0;
+
+	struct FFileStamp
+	{
+		FString Filename;
+		FDateTime TimeStamp;
+		int64 FileSize = 0;
+	};
+
+	struct FEntry
+	{
+		FToolResult Result;
+
+		/** Resource -> its generation when the result was stored */
+		TArray<TPair<FName, uint32>> ResourceGenerations;
+
+		/** Touched text files as they were on disk when the result was stored */
+		TArray<FFileStamp> Files;
+
+		/** Global generation when stored; only checked for entries without resources */
+		uint32 GlobalGeneration = 0;
+		uint32 CompileGeneration = 0;
+
+		double StoredTime = 0.0;
+		uint64 LastUsed = 0;
+	};
+
+	FToolResultCache() = default;
+
+	void RegisterDelegates();
+
+	bool IsValid(const FEntry& Entry) const;
+
+	void Remove(const FString& Key);
+	void EvictOldest();
+
+	/** Bump the generation of Object's package if a cached entry depends on it */
+	void BumpGeneration(const UObject* Object);
+
+	void HandleObjectModified(UObject* Object);
+	void HandleObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
+	void HandlePackageSaved(const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext);
+	void HandleBlueprintCompiled();
+	void HandleAssetAdded(const FAssetData& AssetData);
+	void HandleAssetRemoved(const FAssetData& AssetData);
+	void HandleAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	TMap<FString, FEntry> Entries;
+
+	/**
+	 * Resource -> generation, for resources an entry depends on. FName compares
+	 * case-insensitively, so lowercased resource keys match package names as they are.
+	 */
+	TMap<FName, uint32> Generations;
+
+	uint32 GlobalGeneration = 0;
+	uint32 CompileGeneration = 0;
+
+	int64 TotalChars = 0;
+	uint64 UseCounter = 0;
+	bool bDelegatesRegistered = false;
+};
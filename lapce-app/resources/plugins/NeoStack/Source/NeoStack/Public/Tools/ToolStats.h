@@ -0,0 +1,88 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FToolResult;
+
+/**
+ * Rolling per-tool execution statistics, recorded by FNeoStackToolRegistry
+ *
+ * Keeps the last SamplesPerTool calls of every tool: wall-clock latency (for asynchronous
+ * calls, from the call until the result), game-thread time spent in the tool, output size
+ * in UTF-8 bytes and the change in the process's used memory across the call. The memory
+ * delta is what allocations the call kept alive, not an allocation count, and other editor
+ * work running at the same time shows up in it too. Game thread only.
+ *
+ * Console: NeoStack.ToolStats prints the table, NeoStack.ToolStats.Export [File] writes it
+ * as CSV (default Saved/NeoStack/tool_stats.csv), NeoStack.ToolStats.Reset clears it.
+ */
+class NEOSTACK_API FNeoStackToolStats
+{
+public:
+	static FNeoStackToolStats& Get();
+
+	/** One finished call */
+	struct FSample
+	{
+		float LatencyMs = 0.0f;
+		float GameThreadMs = 0.0f;
+		int64 OutputBytes = 0;
+		int64 MemoryDeltaBytes = 0;
+	};
+
+	/** Summary of one tool's recent calls */
+	struct FSummary
+	{
+		FString ToolName;
+		int64 Calls = 0;
+		int64 Failures = 0;
+		int64 CacheHits = 0;
+		/** Over the retained samples */
+		float P50Ms = 0.0f;
+		float P95Ms = 0.0f;
+		float MaxMs = 0.0f;
+		float AvgGameThreadMs = 0.0f;
+		int64 AvgOutputBytes = 0;
+		int64 MaxOutputBytes = 0;
+		int64 AvgMemoryDeltaBytes = 0;
+	};
+
+	/** Process memory in use; call before and after a tool for FSample::MemoryDeltaBytes */
+	static int64 GetUsedMemory();
+
+	/** UTF-8 size of a tool's output */
+	static int64 GetOutputBytes(const FToolResult& Result);
+
+	void Record(const FString& ToolName, const FToolResult& Result, const FSample& Sample);
+
+	/** One summary per tool that has been called, slowest p95 first */
+	TArray<FSummary> Summarize() const;
+
+	/** Log the table */
+	void Dump() const;
+
+	/** Write the table as CSV; false if the file couldn't be written */
+	bool ExportCsv(const FString& FilePath) const;
+
+	void Reset() { Tools.Reset(); }
+
+	static constexpr int32 SamplesPerTool = 256;
+
+private:
+	FNeoStackToolStats() = default;
+
+	struct FToolEntry
+	{
+		/** Ring buffer of the most recent samples */
+		TArray<FSample> Samples;
+		int32 NextSample = 0;
+
+		int64 Calls = 0;
+		int64 Failures = 0;
+		int64 CacheHits = 0;
+	};
+
+	TMap<FString, FToolEntry> Tools;
+};
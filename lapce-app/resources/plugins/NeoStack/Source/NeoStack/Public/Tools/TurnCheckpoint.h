@@ -0,0 +1,110 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+
+class UPackage;
+
+/**
+ * One rollback point per agent turn instead of an undo transaction per edit ("Turn Checkpoints")
+ *
+ * While a mutating tool call runs inside an FEditScope, the first Modify() of an object in a
+ * package snapshots every object of that package once for the whole turn, serialized the way
+ * the undo buffer would, and the editor's transaction buffer stores nothing. Tools skip their
+ * own transactions. Packages a call creates are remembered by the resources it declares.
+ *
+ * Rollback puts every snapshotted object back (outer, name and state, including objects the
+ * turn removed), drops objects the turn added to those packages, deletes the packages the
+ * turn created and restores each package's dirty flag. Only the latest turn can be rolled
+ * back; the next turn's first edit replaces the checkpoint. Game thread only.
+ */
+class NEOSTACK_API FTurnCheckpoint
+{
+public:
+	/** Marks the edits of one tool call as part of the current turn's checkpoint */
+	class NEOSTACK_API FEditScope
+	{
+	public:
+		/**
+		 * @param bMutating - False for read-only calls, which leave everything untouched
+		 * @param Resources - The call's GetTouchedResources keys; packages that don't exist yet are recorded as created
+		 */
+		FEditScope(bool bMutating, const TArray<FString>& Resources);
+		~FEditScope();
+
+	private:
+		bool bActive = false;
+	};
+
+	static FTurnCheckpoint& Get();
+
+	/** True when the "Turn Checkpoints" setting is on */
+	static bool IsEnabled();
+
+	/** True inside an FEditScope; tools skip their FScopedTransaction then */
+	bool IsCapturing() const { return ScopeDepth > 0; }
+
+	/** A new agent turn starts; its first edit replaces the current checkpoint */
+	void BeginTurn();
+
+	/** True if there is a turn to roll back */
+	bool HasCheckpoint() const { return Packages.Num() > 0 || CreatedPackages.Num() > 0; }
+
+	/**
+	 * Put every package the last turn changed back to its state before the turn
+	 * @param OutReport - One line per package
+	 * @return Number of packages restored or deleted
+	 */
+	int32 Rollback(FString& OutReport);
+
+	/** Bytes held by the current checkpoint */
+	int64 GetSnapshotBytes() const;
+
+	/** Drop the checkpoint and unregister delegates (module shutdown) */
+	void Shutdown();
+
+private:
+	struct FObjectSnapshot
+	{
+		TStrongObjectPtr<UObject> Object;
+		UObject* Outer = nullptr;
+		FName Name;
+		TArray<uint8> Data;
+	};
+
+	struct FPackageSnapshot
+	{
+		TStrongObjectPtr<UPackage> Package;
+		bool bWasDirty = false;
+		TArray<FObjectSnapshot> Objects;
+	};
+
+	FTurnCheckpoint() = default;
+
+	/** Start a new checkpoint if a turn began since the last capture */
+	void PrepareCapture();
+
+	/** Snapshot a package unless this turn already did */
+	void CapturePackage(UPackage* Package, bool bWasDirty);
+
+	/** Objects of a package that a snapshot covers (no classes, CDOs or transient objects) */
+	static void GatherObjects(UPackage* Package, TArray<UObject*>& OutObjects);
+
+	bool RestorePackage(FPackageSnapshot& Snapshot);
+	bool DeleteCreatedPackage(FName PackageName);
+
+	void HandleObjectModified(UObject* Object);
+	void HandlePackageMarkedDirty(UPackage* Package, bool bWasDirty);
+
+	/** Packages snapshotted this turn, by name */
+	TMap<FName, FPackageSnapshot> Packages;
+
+	/** Packages that did not exist before this turn */
+	TSet<FName> CreatedPackages;
+
+	int32 ScopeDepth = 0;
+	bool bTurnPending = true;
+	bool bDelegatesRegistered = false;
+};
@@ -0,0 +1,74 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Markdown -> Slate rich text conversion
+ *
+ * # Heading  -> <Credits.H2>Heading</>
+ * ## Heading -> <RichTextBlock.Bold>Heading</>
+ * **bold**   -> <RichTextBlock.Bold>bold</>
+ * *italic*   -> <RichTextBlock.Italic>italic</>
+ * `code`     -> plain text (rich text has no good inline code style)
+ *
+ * Every conversion is a single pass over the text plus one counting pass, so cost is
+ * linear in the input no matter how many markers it contains.
+ */
+class NEOSTACK_API FNeoStackMarkdown
+{
+public:
+	/** Convert a markdown fragment to rich text markup */
+	static FString ToRichText(const FString& Markdown);
+
+	/** Strip the fence lines of a fenced code block, leaving the code */
+	static FString StripCodeFence(const FString& CodeBlock);
+
+	/** True if the line opens or closes a fenced code block */
+	static bool IsFenceLine(const TCHAR* Line, int32 Len);
+};
+
+/**
+ * Splits streamed markdown into blocks as it arrives.
+ *
+ * Paragraphs end at a blank line and fenced code blocks at their closing fence. Once a
+ * block has ended it never changes again, so the chat area renders it once and only the
+ * trailing open block is re-converted on each delta. Each character is scanned once.
+ */
+class NEOSTACK_API FNeoStackMarkdownStream
+{
+public:
+	struct FBlock
+	{
+		FString Text;
+		bool bCode = false;
+	};
+
+	/** Add a delta; blocks that were completed by it are appended to OutFinished */
+	void Append(const FString& Delta, TArray<FBlock>& OutFinished);
+
+	/** Text of the block that is still open (may be empty) */
+	const FString& GetOpenBlock() const { return Pending; }
+
+	/** True if the open block is inside a code fence */
+	bool IsInCodeBlock() const { return bInCodeBlock; }
+
+	/** Forget everything */
+	void Reset();
+
+private:
+	/** Move Pending[0, End) out as a finished block */
+	void FinishBlock(int32 End, bool bCode, TArray<FBlock>& OutFinished);
+
+	/** Text not yet part of a finished block */
+	FString Pending;
+
+	/** Start of the line currently being received, in Pending */
+	int32 LineStart = 0;
+
+	/** First character of Pending not scanned yet */
+	int32 ScanPos = 0;
+
+	bool bInCodeBlock = false;
+};
@@ -48,6 +48,12 @@ public:
 	/** Mark tool as executing (after approval) */
 	void SetExecuting();
 
+	/** Show a progress line from an asynchronous tool while it is executing */
+	void SetProgress(float Fraction, const FString& Status);
+
+	/** Note that the coming result was served from the tool result cache, saving SavedMs */
+	void SetCached(float SavedMs);
+
 	/** Get the tool name */
 	FString GetToolName() const { return ToolName; }
 
@@ -57,6 +63,12 @@ public:
 	/** Global set of always-allowed tools */
 	static TSet<FString>& GetAlwaysAllowedTools();
 
+	/** Result text is shown in chunks of at most this many lines... */
+	static constexpr int32 ResultChunkLines = 200;
+
+	/** ...and at most this many characters, so one huge line cannot stall a frame either */
+	static constexpr int32 ResultChunkChars = 16 * 1024;
+
 private:
 	FReply OnToggleExpand();
 	FReply OnAcceptClicked();
@@ -69,19 +81,38 @@ private:
 	FText GetStatusText() const;
 	EVisibility GetApprovalButtonsVisibility() const;
 
+	/** Build the result section (first expand after the result arrived) */
+	void BuildResultSection();
+
+	/** Show the next chunk of the result */
+	void AppendResultChunk();
+
+	FReply OnShowMoreClicked();
+	EVisibility GetShowMoreVisibility() const;
+	FText GetShowMoreText() const;
+
 	bool bIsExpanded = true;
 	bool bResultSet = false;  // Guard against duplicate result display
+	bool bResultSuccess = true;
+	bool bResultBuilt = false; // Result widgets are only created once the section is expanded
+	int32 ResultShownChars = 0;
+	int32 ResultShownLines = 0;
+	int32 ResultTotalLines = 0;
 	EToolExecutionState ExecutionState = EToolExecutionState::PendingApproval;
 	FString ToolName;
 	FString Args;
 	FString CallID;
 	FString Result;
+	FString ProgressText;
+	bool bResultCached = false;
+	float CachedSavedMs = 0.0f;
 
 	FOnToolApproved OnApprovedDelegate;
 	FOnToolRejected OnRejectedDelegate;
 
 	TSharedPtr<SWidget> DetailsContainer;
 	TSharedPtr<SVerticalBox> DetailsBox;
+	TSharedPtr<SVerticalBox> ResultChunksBox;
 	TSharedPtr<SHorizontalBox> ApprovalButtons;
 	TSharedPtr<SImage> StatusIcon;
 	TSharedPtr<STextBlock> StatusText;
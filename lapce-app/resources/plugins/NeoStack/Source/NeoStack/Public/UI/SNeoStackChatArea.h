@@ -6,6 +6,7 @@
 #include "Widgets/DeclarativeSyntaxSupport.h"
 #include "Widgets/SCompoundWidget.h"
 #include "UObject/StrongObjectPtr.h"
+#include "UI/NeoStackMarkdown.h"
 
 /**
  * Message part types
@@ -51,18 +52,24 @@ public:
 		{}
 		SLATE_EVENT(FOnUE5ToolApproved, OnToolApproved)
 		SLATE_EVENT(FOnUE5ToolRejected, OnToolRejected)
+		/** Fired when the user scrolls to the top and older history could be shown */
+		SLATE_EVENT(FSimpleDelegate, OnLoadOlderMessages)
 	SLATE_END_ARGS()
 
 	/** Constructs this widget with InArgs */
 	void Construct(const FArguments& InArgs);
 
+	//~ Begin SWidget Interface
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+	//~ End SWidget Interface
+
 	/** Add a user message to the chat */
 	void AddUserMessage(const FString& Message);
 
 	/** Add a user message with images to the chat */
 	void AddUserMessageWithImages(const FString& Message, const TArray<struct FConversationImage>& Images);
 
-	/** Start a new assistant message */
+	/** Start a new assistant message (history replay / single-stream use) */
 	void StartAssistantMessage(const FString& AgentName, const FString& ModelName);
 
 	/** Append content to current assistant message */
@@ -83,45 +90,176 @@ public:
 	/** Mark current assistant message as complete */
 	void CompleteAssistantMessage();
 
+	/**
+	 * Streaming API for concurrent assistant messages.
+	 * Each stream is keyed by a caller-chosen ID and owns its own message container,
+	 * so several agent sessions can stream into the chat at the same time.
+	 */
+
+	/** Start a new streamed assistant message */
+	void StartAssistantStream(const FString& StreamID, const FString& AgentName, const FString& ModelName);
+
+	/** Append content to a streamed assistant message */
+	void AppendStreamContent(const FString& StreamID, const FString& Content);
+
+	/** Append reasoning to a streamed assistant message */
+	void AppendStreamReasoning(const FString& StreamID, const FString& Reasoning);
+
+	/** Append a backend tool call to a streamed assistant message */
+	void AppendStreamToolCall(const FString& StreamID, const FString& ToolName, const FString& Args, const FString& CallID);
+
+	/** Append a UE5 tool call (with session ID for result submission) to a streamed assistant message */
+	void AppendStreamUE5ToolCall(const FString& StreamID, const FString& SessionID, const FString& ToolName, const FString& Args, const FString& CallID,
+		const TSharedPtr<class FJsonObject>& ArgsObject = nullptr);
+
+	/** Mark a streamed assistant message as complete */
+	void CompleteAssistantStream(const FString& StreamID);
+
+	/**
+	 * Coalesced variants for SSE callbacks: deltas are collected and pushed into the stream
+	 * once per frame. Tool calls and completion on the same stream flush what is queued first,
+	 * so the order of the message is kept.
+	 */
+	void QueueStreamContent(const FString& StreamID, const FString& Content);
+	void QueueStreamReasoning(const FString& StreamID, const FString& Reasoning);
+
+	/**
+	 * Play a recorded backend stream into a new assistant message through the same parser and
+	 * coalesced updates as a live response. Tool calls are shown but never executed.
+	 * @param Speed - 1 keeps the recorded timing, 0 or less decodes everything at once
+	 */
+	void ReplayRecording(const TSharedRef<const struct FNeoStackStreamRecording>& Recording, float Speed);
+
+	/** Number of assistant messages currently streaming */
+	int32 GetActiveStreamCount() const { return ActiveStreams.Num(); }
+
 	/** Clear all messages */
 	void ClearMessages();
 
+	/** Messages added between BeginPrepend and EndPrepend go above the existing ones */
+	void BeginPrepend();
+
+	/** Insert the prepended messages at the top, keeping the current view in place */
+	void EndPrepend();
+
 	/** Get tool widget by CallID for external updates */
 	TSharedPtr<class SCollapsibleToolWidget> GetToolWidget(const FString& CallID) const;
 
 	/** Get session ID for a tool call */
 	FString GetSessionIDForTool(const FString& CallID) const;
 
+	/** Get the already-parsed args for a tool call (null if only the text form is known) */
+	TSharedPtr<class FJsonObject> GetToolArgsObject(const FString& CallID) const;
+
+	/** The open chat area, if the NeoStack tab has been built */
+	static TSharedPtr<SNeoStackChatArea> Get();
+
 private:
+	/** Last constructed chat area, for console commands */
+	static TWeakPtr<SNeoStackChatArea> Instance;
+
 	/** Container for all messages */
 	TSharedPtr<class SVerticalBox> MessageContainer;
 
 	/** Scroll box for messages */
 	TSharedPtr<class SScrollBox> MessageScrollBox;
 
-	/** Current assistant message container (for appending parts) */
-	TSharedPtr<SVerticalBox> CurrentAssistantContainer;
+	/**
+	 * One message in the list. Its widget is kept alive for the life of the chat, but only
+	 * parented into the list while it is near the viewport; otherwise the slot holds an empty
+	 * box with the message's last measured height
+	 */
+	struct FChatMessageItem
+	{
+		/** Slot content: the message, or nothing while off screen */
+		TSharedPtr<class SBox> Box;
+
+		/** The message widget */
+		TSharedPtr<SWidget> Content;
+
+		/** Last measured height (including the spacing below the message) */
+		float CachedHeight = 0.0f;
+
+		/** True while Content is parented into Box */
+		bool bRealized = true;
+
+		/** Never swapped out (message still streaming) */
+		bool bPinned = false;
+	};
 
-	/** Track if we're currently in an assistant message */
-	bool bInAssistantMessage;
+	/** All messages, in display order */
+	TArray<TSharedPtr<FChatMessageItem>> MessageItems;
 
-	/** Current assistant agent name */
-	FString CurrentAgentName;
+	/** Messages collected between BeginPrepend and EndPrepend */
+	TArray<TSharedPtr<FChatMessageItem>> PrependItems;
 
-	/** Current assistant model name */
-	FString CurrentModelName;
+	/** True between BeginPrepend and EndPrepend */
+	bool bPrepending = false;
 
-	/** Current streaming content text block (for live updates) */
-	TSharedPtr<class SRichTextBlock> CurrentStreamingTextBlock;
+	/** Padding around the message list */
+	static constexpr float MessageListPadding = 16.0f;
 
-	/** Accumulated content for current streaming block */
-	FString CurrentStreamingContent;
+	/** Delegate fired when older messages should be loaded */
+	FSimpleDelegate OnLoadOlderMessagesDelegate;
 
-	/** Current streaming reasoning widget (for live updates) */
-	TSharedPtr<class SCollapsibleReasoningWidget> CurrentStreamingReasoningWidget;
+	/** Scroll offset (slate units from the top) below which older messages are requested */
+	static constexpr float LoadOlderScrollThreshold = 40.0f;
 
-	/** Accumulated reasoning for current streaming block */
-	FString CurrentStreamingReasoning;
+	/** Live state of one assistant message that is still streaming */
+	struct FAssistantStreamState
+	{
+		/** Container for this message's parts */
+		TSharedPtr<SVerticalBox> Container;
+
+		/** List entry of this message */
+		TSharedPtr<FChatMessageItem> Item;
+
+		/** Agent name shown in the header */
+		FString AgentName;
+
+		/** Model name shown in the header */
+		FString ModelName;
+
+		/** Current streaming content text block (for live updates) */
+		TSharedPtr<class SRichTextBlock> StreamingTextBlock;
+
+		/** Splits the streamed content into finished blocks and the open trailing block */
+		FNeoStackMarkdownStream Markdown;
+
+		/** Current streaming reasoning widget (for live updates) */
+		TSharedPtr<class SCollapsibleReasoningWidget> StreamingReasoningWidget;
+
+		/** Accumulated reasoning for current streaming block */
+		FString StreamingReasoning;
+	};
+
+	/** A run of queued text of one kind */
+	struct FPendingDelta
+	{
+		bool bReasoning = false;
+		FString Text;
+	};
+
+	/** Deltas received since the last frame, per stream, in arrival order */
+	TMap<FString, TArray<FPendingDelta>> PendingDeltas;
+
+	/** Per-frame flush timer while deltas are queued */
+	TSharedPtr<FActiveTimerHandle> FlushTimerHandle;
+
+	/** Queue a delta and make sure a flush is scheduled */
+	void QueueStreamDelta(const FString& StreamID, const FString& Text, bool bReasoning);
+
+	/** Push the queued deltas of one stream into it */
+	void FlushStream(const FString& StreamID);
+
+	/** Active timer: flush queued deltas within the frame budget */
+	EActiveTimerReturnType OnFlushPendingDeltas(double InCurrentTime, float InDeltaTime);
+
+	/** Assistant messages currently streaming, keyed by stream ID */
+	TMap<FString, FAssistantStreamState> ActiveStreams;
+
+	/** Stream ID used by the single-stream API (history replay) */
+	static const FString DefaultStreamID;
 
 	/** Map of Call ID to Tool Widget (for updating with results) */
 	TMap<FString, TSharedPtr<class SCollapsibleToolWidget>> ToolWidgets;
@@ -132,6 +270,9 @@ private:
 	/** Map of Call ID to Session ID (for UE5 tools that need result submission) */
 	TMap<FString, FString> ToolSessionIDs; // CallID -> SessionID
 
+	/** Map of Call ID to parsed args (so approved tools execute without re-parsing) */
+	TMap<FString, TSharedPtr<class FJsonObject>> ToolArgsObjects;
+
 	/** Delegates for tool approval/rejection */
 	FOnUE5ToolApproved OnToolApprovedDelegate;
 	FOnUE5ToolRejected OnToolRejectedDelegate;
@@ -160,9 +301,21 @@ private:
 	/** Create a tool result widget */
 	TSharedRef<SWidget> CreateToolResultWidget(const FString& Result);
 
+	/** Create a fenced code block widget */
+	TSharedRef<SWidget> CreateCodeBlockWidget(const FString& Code);
+
 	/** Parse markdown and create rich text widget */
 	TSharedRef<SWidget> CreateMarkdownWidget(const FString& Text, const FSlateFontInfo& Font, const FLinearColor& Color);
 
+	/** Add a message widget to the list (or to the pending prepend) */
+	TSharedPtr<FChatMessageItem> AddMessageItem(const TSharedRef<SWidget>& Content);
+
+	/** Realize messages near the viewport and swap the rest for placeholders */
+	void UpdateRealizedMessages();
+
+	/** Scroll box scrolled by the user */
+	void OnMessagesScrolled(float ScrollOffset);
+
 	/** Scroll to bottom of chat */
 	void ScrollToBottom();
 };
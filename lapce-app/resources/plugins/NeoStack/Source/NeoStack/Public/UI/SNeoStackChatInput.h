@@ -35,6 +35,9 @@ struct FAttachedImage
 	/** MIME type (e.g., "image/png") */
 	FString MimeType = TEXT("image/png");
 
+	/** SHA-1 of the PNG bytes, used to dedupe attachments and reference uploaded images */
+	FString Hash;
+
 	/** Thumbnail brush for display */
 	TSharedPtr<FSlateBrush> ThumbnailBrush;
 
@@ -90,6 +93,12 @@ private:
 	/** Currently attached images */
 	TArray<FAttachedImage> AttachedImages;
 
+	/** Images still being processed on worker threads (sending waits for them) */
+	int32 PendingImageCount = 0;
+
+	/** Send was requested while images were processing; sent once the last one arrives */
+	bool bSendWhenImagesReady = false;
+
 	/** Currently attached context files */
 	TArray<FAttachedContext> AttachedContexts;
 
@@ -120,8 +129,20 @@ private:
 	/** Try to paste image from clipboard */
 	bool TryPasteImageFromClipboard();
 
-	/** Add an image attachment */
-	void AddImageAttachment(const TArray<uint8>& ImageData);
+	/** Add an encoded image file as attachment (processed on a worker thread) */
+	void AddImageAttachment(TArray<uint8>&& ImageData);
+
+	/** Add raw BGRA8 pixels as attachment (processed on a worker thread) */
+	void AddRawImageAttachment(TArray<uint8>&& BGRA, int32 Width, int32 Height);
+
+	/** Receive a processed image from the pipeline (game thread) */
+	void OnImageProcessed(TSharedPtr<const struct FNeoStackProcessedImage> Image);
+
+	/** Add a processed image to AttachedImages unless the same image is already attached */
+	void AttachProcessedImage(const struct FNeoStackProcessedImage& Image);
+
+	/** "Send", or what the send button is waiting for */
+	FText GetSendButtonText() const;
 
 	/** Remove an image attachment by index */
 	void RemoveImageAttachment(int32 Index);
@@ -129,11 +150,8 @@ private:
 	/** Update the image preview UI */
 	void UpdateImagePreviewUI();
 
-	/** Create thumbnail texture from image data */
-	UTexture2D* CreateThumbnailTexture(const TArray<uint8>& ImageData);
-
-	/** Convert image data to base64 */
-	static FString ImageDataToBase64(const TArray<uint8>& ImageData);
+	/** Create thumbnail texture from BGRA8 pixels */
+	UTexture2D* CreateThumbnailTexture(const TArray<uint8>& BGRA, int32 Width, int32 Height);
 
 	/** Get visibility of image preview container */
 	EVisibility GetImagePreviewVisibility() const;
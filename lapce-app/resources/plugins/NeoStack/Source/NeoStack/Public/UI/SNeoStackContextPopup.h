@@ -87,8 +87,11 @@ public:
 	bool HasItems() const { return FilteredItems.Num() > 0; }
 
 private:
-	/** All available context items */
-	TArray<FContextItem> AllItems;
+	/** Items listed before anything is typed */
+	static constexpr int32 MaxUnfilteredItems = 50;
+
+	/** Best matches listed while filtering */
+	static constexpr int32 MaxFilteredItems = 30;
 
 	/** Filtered items based on current search */
 	TArray<FContextItem> FilteredItems;
@@ -108,16 +111,10 @@ private:
 	/** Callback for item selection */
 	FOnContextItemSelected OnItemSelectedDelegate;
 
-	/** Scan project for files and assets */
-	void ScanProjectFiles();
-
-	/** Scan directory for C++ files */
-	void ScanCppDirectory(const FString& Directory);
-
-	/** Scan for Blueprint assets */
-	void ScanBlueprintAssets();
+	/** Re-run the filter when the context index changes */
+	void OnIndexUpdated();
 
-	/** Apply filter to items */
+	/** Query the context index with the current filter */
 	void ApplyFilter();
 
 	/** Update the list view items */
@@ -6,26 +6,7 @@
 #include "Widgets/DeclarativeSyntaxSupport.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Views/SListView.h"
-#include "Http.h"
-
-// Forward declaration
-struct FModelInfo;
-
-/** Structure to hold OpenRouter model data */
-struct FOpenRouterModelInfo
-{
-	FString ID;
-	FString Name;
-	FString Description;
-	int32 ContextLength;
-	FString PromptCost;      // Cost per token as string
-	FString CompletionCost;  // Cost per token as string
-	FString Provider;        // Extracted from ID (e.g., "anthropic" from "anthropic/claude-3")
-
-	FOpenRouterModelInfo()
-		: ContextLength(0)
-	{}
-};
+#include "NeoStackModelCatalog.h"
 
 /** Delegate for when a model is selected */
 DECLARE_DELEGATE_OneParam(FOnModelBrowserSelected, TSharedPtr<FOpenRouterModelInfo>);
@@ -45,7 +26,9 @@ public:
 	/** Constructs this widget with InArgs */
 	void Construct(const FArguments& InArgs);
 
-	/** Fetch models from backend */
+	virtual ~SNeoStackModelBrowser();
+
+	/** Show the cached catalog and ask for a background refresh */
 	void FetchModels();
 
 private:
@@ -58,11 +41,8 @@ private:
 	/** Current search text */
 	FString SearchText;
 
-	/** Whether we're currently loading */
-	bool bIsLoading;
-
-	/** Error message if any */
-	FString ErrorMessage;
+	/** Lowercased search that produced FilteredModels */
+	FString AppliedSearch;
 
 	/** The list view widget */
 	TSharedPtr<SListView<TSharedPtr<FOpenRouterModelInfo>>> ModelListView;
@@ -92,12 +72,11 @@ private:
 	/** Get currently selected model */
 	TSharedPtr<FOpenRouterModelInfo> GetSelectedModel() const;
 
-	/** HTTP request callbacks */
-	void OnModelsResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+	/** Catalog changed: rebuild the list from scratch */
+	void OnCatalogUpdated();
+
+	FDelegateHandle CatalogUpdatedHandle;
 
 	/** Format cost for display (converts per-token to per-million) */
 	static FString FormatCost(const FString& PerTokenCost);
-
-	/** Extract provider from model ID */
-	static FString ExtractProvider(const FString& ModelID);
 };
@@ -146,6 +146,15 @@ private:
 	/** Generates a row widget for a conversation */
 	TSharedRef<ITableRow> OnGenerateConversationRow(TSharedPtr<struct FConversationMetadata> Item, const TSharedRef<STableViewBase>& OwnerTable);
 
+	/** Current search query (empty = list all conversations) */
+	FString SearchQuery;
+
+	/** Conversation ID -> matching text, for the rows of the current search */
+	TMap<int32, FString> SearchSnippets;
+
+	/** Called when the search text changes */
+	void OnSearchTextChanged(const FText& NewText);
+
 	/** Called when a conversation is clicked */
 	void OnConversationClicked(TSharedPtr<struct FConversationMetadata> Item);
 };
@@ -41,6 +41,7 @@ public class NeoStackBridge : ModuleRules
 					"UnrealEd",
 					"AssetRegistry",
 					"Kismet",
+					"BlueprintGraph",
 				}
 			);
 
@@ -2,6 +2,11 @@
 
 #include "NeoStackBlueprintCommands.h"
 #include "NeoStackBridgeProtocol.h"
+#include "NeoStackBlueprintIndex.h"
+#include "NeoStackFunctionUsageIndex.h"
+#include "NeoStackPropertyOverrideCache.h"
+#include "NeoStackBridgeRequests.h"
+#include "NeoStackProjectCatalog.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
@@ -9,30 +14,6 @@
 #include "Misc/Paths.h"
 #include "Misc/PackageName.h"
 
-// Helper to convert UE content path to full filesystem path
-static FString ContentPathToFullPath(const FString& ContentPath)
-{
-	// Convert /Game/Path/Asset to full filesystem path
-	FString PackagePath = ContentPath;
-
-	// Remove object name suffix if present (e.g., /Game/Test34.Test34 -> /Game/Test34)
-	int32 DotIndex;
-	if (PackagePath.FindLastChar('.', DotIndex))
-	{
-		PackagePath = PackagePath.Left(DotIndex);
-	}
-
-	// Convert to filesystem path
-	FString FilePath;
-	if (FPackageName::TryConvertLongPackageNameToFilename(PackagePath, FilePath, FPackageName::GetAssetPackageExtension()))
-	{
-		return FPaths::ConvertRelativePathToFull(FilePath);
-	}
-
-	// Fallback: return original path
-	return ContentPath;
-}
-
 FNeoStackEvent FNeoStackBlueprintCommands::HandleFindDerivedBlueprints(const TSharedPtr<FJsonObject>& Args)
 {
 	if (!Args.IsValid())
@@ -40,85 +21,7 @@ FNeoStackEvent FNeoStackBlueprintCommands::HandleFindDerivedBlueprints(const TSh
 		return MakeError(NeoStackProtocol::MessageType::FindDerivedBlueprints, TEXT("Missing arguments"));
 	}
 
-	FString ClassName = Args->GetStringField(TEXT("className"));
-	if (ClassName.IsEmpty())
-	{
-		return MakeError(NeoStackProtocol::MessageType::FindDerivedBlueprints, TEXT("Missing 'className' argument"));
-	}
-
-	// Resolve the C++ class
-	UClass* ParentClass = ResolveClassName(ClassName);
-	if (!ParentClass)
-	{
-		return MakeError(NeoStackProtocol::MessageType::FindDerivedBlueprints,
-			FString::Printf(TEXT("Class not found: %s"), *ClassName));
-	}
-
-	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Finding Blueprints derived from: %s"), *ParentClass->GetName());
-
-	// Query Asset Registry for all Blueprint assets
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	TArray<FAssetData> BlueprintAssets;
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-	Filter.bRecursiveClasses = true;
-
-	AssetRegistry.GetAssets(Filter, BlueprintAssets);
-
-	// Filter to only those that derive from our class
-	TArray<TSharedPtr<FJsonValue>> ResultArray;
-
-	for (const FAssetData& AssetData : BlueprintAssets)
-	{
-		// Get the parent class from asset metadata
-		FAssetTagValueRef ParentClassTag = AssetData.TagsAndValues.FindTag(FBlueprintTags::ParentClassPath);
-		if (!ParentClassTag.IsSet())
-		{
-			continue;
-		}
-
-		FString ParentClassPath = ParentClassTag.GetValue();
-
-		// Load the parent class to check inheritance
-		// The tag value is like: /Script/Engine.Actor or /Game/Blueprints/BP_Base.BP_Base_C
-		UClass* BlueprintParentClass = nullptr;
-
-		// Try to find the class without loading the Blueprint
-		FSoftClassPath SoftClassPath(ParentClassPath);
-		BlueprintParentClass = SoftClassPath.ResolveClass();
-
-		if (!BlueprintParentClass)
-		{
-			// If it's a Blueprint parent, we might need to load it
-			// Skip for now to avoid loading all blueprints
-			continue;
-		}
-
-		// Check if this Blueprint's parent derives from our target class
-		if (BlueprintParentClass->IsChildOf(ParentClass))
-		{
-			TSharedPtr<FJsonObject> BlueprintInfo = MakeShareable(new FJsonObject());
-			// Use full filesystem path instead of UE content path
-			BlueprintInfo->SetStringField(TEXT("path"), ContentPathToFullPath(AssetData.GetObjectPathString()));
-			BlueprintInfo->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
-			BlueprintInfo->SetStringField(TEXT("parentClass"), BlueprintParentClass->GetName());
-
-			ResultArray.Add(MakeShareable(new FJsonValueObject(BlueprintInfo)));
-
-			UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Found derived Blueprint: %s"), *AssetData.AssetName.ToString());
-		}
-	}
-
-	// Build response
-	TSharedPtr<FJsonObject> ResponseData = MakeShareable(new FJsonObject());
-	ResponseData->SetArrayField(TEXT("blueprints"), ResultArray);
-	ResponseData->SetNumberField(TEXT("count"), ResultArray.Num());
-
-	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Found %d Blueprints derived from %s"), ResultArray.Num(), *ClassName);
-
-	return MakeSuccess(NeoStackProtocol::MessageType::FindDerivedBlueprints, ResponseData);
+	return FindDerivedBlueprintsInIndex(Args, *FNeoStackBlueprintIndex::Get().GetOrBuildSnapshot());
 }
 
 FNeoStackEvent FNeoStackBlueprintCommands::HandleFindBlueprintReferences(const TSharedPtr<FJsonObject>& Args)
@@ -151,24 +54,31 @@ FNeoStackEvent FNeoStackBlueprintCommands::HandleFindBlueprintReferences(const T
 	TArray<FAssetIdentifier> Referencers;
 	AssetRegistry.GetReferencers(FAssetIdentifier(ClassPackageName), Referencers);
 
+	// Referencing packages are resolved against the shared catalog rather than one registry lookup each
+	FNeoStackProjectCatalog& Catalog = FNeoStackProjectCatalog::Get();
+	Catalog.EnsureBuilt();
+	const FTopLevelAssetPath BlueprintClassPath = UBlueprint::StaticClass()->GetClassPathName();
+
 	TArray<TSharedPtr<FJsonValue>> ResultArray;
 
 	for (const FAssetIdentifier& Identifier : Referencers)
 	{
-		FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(Identifier.PackageName.ToString()));
-		if (AssetData.IsValid())
+		const int32 Row = Catalog.FindByPackage(Identifier.PackageName);
+		if (Row == INDEX_NONE)
 		{
-			// Check if it's a Blueprint
-			if (AssetData.AssetClassPath == UBlueprint::StaticClass()->GetClassPathName())
-			{
-				TSharedPtr<FJsonObject> RefInfo = MakeShareable(new FJsonObject());
-				// Use full filesystem path instead of UE content path
-				RefInfo->SetStringField(TEXT("path"), ContentPathToFullPath(AssetData.GetObjectPathString()));
-				RefInfo->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
-				RefInfo->SetStringField(TEXT("usageType"), TEXT("Reference"));
+			continue;
+		}
 
-				ResultArray.Add(MakeShareable(new FJsonValueObject(RefInfo)));
-			}
+		// Check if it's a Blueprint
+		if (Catalog.GetClassPath(Row) == BlueprintClassPath)
+		{
+			TSharedPtr<FJsonObject> RefInfo = MakeShareable(new FJsonObject());
+			// Use full filesystem path instead of UE content path
+			RefInfo->SetStringField(TEXT("path"), FNeoStackBlueprintIndex::ContentPathToFullPath(Catalog.GetObjectPath(Row)));
+			RefInfo->SetStringField(TEXT("name"), Catalog.GetAssetName(Row).ToString());
+			RefInfo->SetStringField(TEXT("usageType"), TEXT("Reference"));
+
+			ResultArray.Add(MakeShareable(new FJsonValueObject(RefInfo)));
 		}
 	}
 
@@ -192,54 +102,22 @@ FNeoStackEvent FNeoStackBlueprintCommands::HandleGetBlueprintPropertyOverrides(c
 		return MakeError(NeoStackProtocol::MessageType::GetBlueprintPropertyOverrides, TEXT("Missing 'blueprintPath' argument"));
 	}
 
-	// Load the Blueprint
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-	if (!Blueprint)
+	// Diffed against the parent defaults once, then served from the cache until it changes
+	TSharedPtr<const FNeoStackPropertyOverrideCache::FEntry> Entry = FNeoStackPropertyOverrideCache::Get().FindOrCompute(BlueprintPath);
+	if (!Entry.IsValid())
 	{
 		return MakeError(NeoStackProtocol::MessageType::GetBlueprintPropertyOverrides,
-			FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintPath));
+			FString::Printf(TEXT("Blueprint not found or has no generated class: %s"), *BlueprintPath));
 	}
 
-	UClass* GeneratedClass = Blueprint->GeneratedClass;
-	if (!GeneratedClass)
-	{
-		return MakeError(NeoStackProtocol::MessageType::GetBlueprintPropertyOverrides, TEXT("Blueprint has no generated class"));
-	}
-
-	UClass* ParentClass = GeneratedClass->GetSuperClass();
-	UObject* CDO = GeneratedClass->GetDefaultObject();
-	UObject* ParentCDO = ParentClass ? ParentClass->GetDefaultObject() : nullptr;
-
 	TArray<TSharedPtr<FJsonValue>> OverridesArray;
-
-	// Iterate properties and compare values
-	for (TFieldIterator<FProperty> PropIt(GeneratedClass); PropIt; ++PropIt)
+	for (const FNeoStackPropertyOverrideCache::FDirectOverride& DirectOverride : Entry->DirectOverrides)
 	{
-		FProperty* Property = *PropIt;
-
-		// Only check properties defined in parent class
-		if (Property->GetOwnerClass() != GeneratedClass)
-		{
-			// Compare values
-			void* CDOValue = Property->ContainerPtrToValuePtr<void>(CDO);
-			void* ParentCDOValue = ParentCDO ? Property->ContainerPtrToValuePtr<void>(ParentCDO) : nullptr;
-
-			if (ParentCDOValue && !Property->Identical(CDOValue, ParentCDOValue))
-			{
-				TSharedPtr<FJsonObject> Override = MakeShareable(new FJsonObject());
-				Override->SetStringField(TEXT("property"), Property->GetName());
-
-				// Get string representation of values
-				FString DefaultValue, BlueprintValue;
-				Property->ExportTextItem_Direct(DefaultValue, ParentCDOValue, nullptr, nullptr, PPF_None);
-				Property->ExportTextItem_Direct(BlueprintValue, CDOValue, nullptr, nullptr, PPF_None);
-
-				Override->SetStringField(TEXT("defaultValue"), DefaultValue);
-				Override->SetStringField(TEXT("blueprintValue"), BlueprintValue);
-
-				OverridesArray.Add(MakeShareable(new FJsonValueObject(Override)));
-			}
-		}
+		TSharedPtr<FJsonObject> Override = MakeShareable(new FJsonObject());
+		Override->SetStringField(TEXT("property"), DirectOverride.Property);
+		Override->SetStringField(TEXT("defaultValue"), DirectOverride.DefaultValue);
+		Override->SetStringField(TEXT("blueprintValue"), DirectOverride.BlueprintValue);
+		OverridesArray.Add(MakeShareable(new FJsonValueObject(Override)));
 	}
 
 	TSharedPtr<FJsonObject> ResponseData = MakeShareable(new FJsonObject());
@@ -287,41 +165,46 @@ FNeoStackEvent FNeoStackBlueprintCommands::HandleFindBlueprintFunctionUsages(con
 	TArray<TSharedPtr<FJsonValue>> ImplementationsArray;
 	TArray<TSharedPtr<FJsonValue>> CallSitesArray;
 
-	// For BlueprintImplementableEvent, find implementations
-	if (bIsBlueprintImplementable)
+	// Call sites and overrides found in scanned Blueprint graphs
+	const FNeoStackFunctionUsageIndex& UsageIndex = FNeoStackFunctionUsageIndex::Get();
+	for (const FNeoStackFunctionUsageIndex::FUsage& Usage : UsageIndex.FindUsages(FNeoStackFunctionUsageIndex::MakeFunctionKey(TargetFunction)))
 	{
-		// Query blueprints that derive from this class
-		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-		IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
+		TSharedPtr<FJsonObject> UsageInfo = MakeShareable(new FJsonObject());
+		UsageInfo->SetStringField(TEXT("path"), FNeoStackBlueprintIndex::ContentPathToFullPath(Usage.BlueprintPath));
+		UsageInfo->SetStringField(TEXT("name"), FPackageName::ObjectPathToObjectName(Usage.BlueprintPath));
+		UsageInfo->SetStringField(TEXT("graph"), Usage.GraphName);
+		UsageInfo->SetStringField(TEXT("nodeGuid"), Usage.NodeGuid.ToString());
 
-		TArray<FAssetData> BlueprintAssets;
-		FARFilter Filter;
-		Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-		Filter.bRecursiveClasses = true;
-		AssetRegistry.GetAssets(Filter, BlueprintAssets);
-
-		for (const FAssetData& AssetData : BlueprintAssets)
+		if (Usage.Kind == FNeoStackFunctionUsageIndex::EUsageKind::Override)
 		{
-			// Check parent class
-			FAssetTagValueRef ParentClassTag = AssetData.TagsAndValues.FindTag(FBlueprintTags::ParentClassPath);
-			if (!ParentClassTag.IsSet()) continue;
-
-			FSoftClassPath SoftClassPath(ParentClassTag.GetValue());
-			UClass* BlueprintParentClass = SoftClassPath.ResolveClass();
+			UsageInfo->SetStringField(TEXT("type"), TEXT("Override"));
+			ImplementationsArray.Add(MakeShareable(new FJsonValueObject(UsageInfo)));
+		}
+		else
+		{
+			CallSitesArray.Add(MakeShareable(new FJsonValueObject(UsageInfo)));
+		}
+	}
 
-			if (BlueprintParentClass && BlueprintParentClass->IsChildOf(TargetClass))
+	// For BlueprintImplementableEvent, derived Blueprints that haven't been scanned yet are
+	// potential implementations
+	if (bIsBlueprintImplementable)
+	{
+		FNeoStackBlueprintIndex::FSnapshotPtr Snapshot = FNeoStackBlueprintIndex::Get().GetOrBuildSnapshot();
+		Snapshot->ForEachDerivedBlueprint(TargetClass->GetPathName(), [&ImplementationsArray, &UsageIndex](const FNeoStackBlueprintIndex::FBlueprintEntry& Blueprint, int32)
+		{
+			if (UsageIndex.IsScanned(Blueprint.ObjectPath))
 			{
-				// This Blueprint might implement the function
-				// Note: Full check would require loading the Blueprint
-				TSharedPtr<FJsonObject> ImplInfo = MakeShareable(new FJsonObject());
-				// Use full filesystem path instead of UE content path
-				ImplInfo->SetStringField(TEXT("path"), ContentPathToFullPath(AssetData.GetObjectPathString()));
-				ImplInfo->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
-				ImplInfo->SetStringField(TEXT("type"), TEXT("PotentialImplementation"));
-
-				ImplementationsArray.Add(MakeShareable(new FJsonValueObject(ImplInfo)));
+				return;
 			}
-		}
+
+			TSharedPtr<FJsonObject> ImplInfo = MakeShareable(new FJsonObject());
+			ImplInfo->SetStringField(TEXT("path"), Blueprint.FullPath);
+			ImplInfo->SetStringField(TEXT("name"), Blueprint.Name);
+			ImplInfo->SetStringField(TEXT("type"), TEXT("PotentialImplementation"));
+
+			ImplementationsArray.Add(MakeShareable(new FJsonValueObject(ImplInfo)));
+		});
 	}
 
 	TSharedPtr<FJsonObject> ResponseData = MakeShareable(new FJsonObject());
@@ -329,6 +212,7 @@ FNeoStackEvent FNeoStackBlueprintCommands::HandleFindBlueprintFunctionUsages(con
 	ResponseData->SetBoolField(TEXT("isBlueprintCallable"), bIsBlueprintCallable);
 	ResponseData->SetArrayField(TEXT("implementations"), ImplementationsArray);
 	ResponseData->SetArrayField(TEXT("callSites"), CallSitesArray);
+	ResponseData->SetNumberField(TEXT("pendingBlueprints"), UsageIndex.GetNumPending());
 
 	return MakeSuccess(NeoStackProtocol::MessageType::FindBlueprintFunctionUsages, ResponseData);
 }
@@ -371,69 +255,10 @@ FNeoStackEvent FNeoStackBlueprintCommands::HandleGetPropertyOverridesAcrossBluep
 	FString DefaultValue;
 	TargetProperty->ExportTextItem_Direct(DefaultValue, ParentValue, nullptr, nullptr, PPF_None);
 
-	// Query Asset Registry for all Blueprint assets
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	TArray<FAssetData> BlueprintAssets;
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-	Filter.bRecursiveClasses = true;
-	AssetRegistry.GetAssets(Filter, BlueprintAssets);
-
-	// Collect overrides
-	TArray<TSharedPtr<FJsonValue>> OverridesArray;
-	int32 OverrideCount = 0;
-
-	for (const FAssetData& AssetData : BlueprintAssets)
-	{
-		// Get the parent class from asset metadata
-		FAssetTagValueRef ParentClassTag = AssetData.TagsAndValues.FindTag(FBlueprintTags::ParentClassPath);
-		if (!ParentClassTag.IsSet())
-		{
-			continue;
-		}
-
-		FSoftClassPath SoftClassPath(ParentClassTag.GetValue());
-		UClass* BlueprintParentClass = SoftClassPath.ResolveClass();
-
-		if (!BlueprintParentClass || !BlueprintParentClass->IsChildOf(ParentClass))
-		{
-			continue;
-		}
-
-		// Load the Blueprint to check property value
-		UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
-		if (!Blueprint || !Blueprint->GeneratedClass)
-		{
-			continue;
-		}
-
-		UObject* BlueprintCDO = Blueprint->GeneratedClass->GetDefaultObject();
-		if (!BlueprintCDO)
-		{
-			continue;
-		}
-
-		// Get the property value from Blueprint CDO
-		void* BlueprintValue = TargetProperty->ContainerPtrToValuePtr<void>(BlueprintCDO);
-
-		// Compare with parent default
-		if (!TargetProperty->Identical(BlueprintValue, ParentValue))
-		{
-			FString ValueStr;
-			TargetProperty->ExportTextItem_Direct(ValueStr, BlueprintValue, nullptr, nullptr, PPF_None);
-
-			TSharedPtr<FJsonObject> OverrideInfo = MakeShareable(new FJsonObject());
-			OverrideInfo->SetStringField(TEXT("blueprintName"), AssetData.AssetName.ToString());
-			// Use full filesystem path instead of UE content path
-			OverrideInfo->SetStringField(TEXT("blueprintPath"), ContentPathToFullPath(AssetData.GetObjectPathString()));
-			OverrideInfo->SetStringField(TEXT("value"), ValueStr);
-
-			OverridesArray.Add(MakeShareable(new FJsonValueObject(OverrideInfo)));
-			OverrideCount++;
-		}
-	}
+	// Compare against every derived Blueprint
+	TArray<TSharedPtr<FJsonValue>> OverridesArray = CollectPropertyOverrides(
+		*FNeoStackBlueprintIndex::Get().GetOrBuildSnapshot(), ParentClass, TargetProperty, ParentValue, DefaultValue);
+	const int32 OverrideCount = OverridesArray.Num();
 
 	// Build response
 	TSharedPtr<FJsonObject> ResponseData = MakeShareable(new FJsonObject());
@@ -452,154 +277,306 @@ FNeoStackEvent FNeoStackBlueprintCommands::HandleGetBlueprintHintsBatch(const TS
 		return MakeError(NeoStackProtocol::MessageType::GetBlueprintHintsBatch, TEXT("Missing arguments"));
 	}
 
-	// Get Asset Registry once for all queries
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	// Pre-fetch all Blueprint assets once
-	TArray<FAssetData> AllBlueprintAssets;
-	FARFilter Filter;
-	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
-	Filter.bRecursiveClasses = true;
-	AssetRegistry.GetAssets(Filter, AllBlueprintAssets);
+	// Class and function hints are index lookups; property hints also load the derived Blueprints
+	FNeoStackBlueprintIndex::FSnapshotPtr Snapshot = FNeoStackBlueprintIndex::Get().GetOrBuildSnapshot();
+	FNeoStackEvent Response = GetBlueprintHintsBatchFromIndex(Args, *Snapshot);
 
-	// Build a map of parent class -> derived blueprints for quick lookup
-	TMap<FString, TArray<FAssetData>> DerivedBlueprintsMap;
-	for (const FAssetData& AssetData : AllBlueprintAssets)
+	// Process property hints
+	const TArray<TSharedPtr<FJsonValue>>* PropertiesArray;
+	if (Args->TryGetArrayField(TEXT("properties"), PropertiesArray))
 	{
-		FAssetTagValueRef ParentClassTag = AssetData.TagsAndValues.FindTag(FBlueprintTags::ParentClassPath);
-		if (ParentClassTag.IsSet())
+		TSharedPtr<FJsonObject> PropertyResults = MakeShareable(new FJsonObject());
+		const FNeoStackPropertyOverrideCache& OverrideCache = FNeoStackPropertyOverrideCache::Get();
+		const uint64 SinceGeneration = GetSinceGeneration(Args);
+		int32 ChangedCount = static_cast<int32>(Response.Data->GetNumberField(TEXT("changedCount")));
+
+		for (const TSharedPtr<FJsonValue>& PropValue : *PropertiesArray)
 		{
-			FSoftClassPath SoftClassPath(ParentClassTag.GetValue());
-			UClass* ParentClass = SoftClassPath.ResolveClass();
-			if (ParentClass)
+			if (FNeoStackBridgeRequests::IsCurrentCancelled())
 			{
-				DerivedBlueprintsMap.FindOrAdd(ParentClass->GetName()).Add(AssetData);
+				break;
 			}
-		}
-	}
 
-	TSharedPtr<FJsonObject> ResponseData = MakeShareable(new FJsonObject());
+			const TSharedPtr<FJsonObject>* PropObj;
+			if (!PropValue->TryGetObject(PropObj)) continue;
 
-	// Process class hints
-	const TArray<TSharedPtr<FJsonValue>>* ClassesArray;
-	if (Args->TryGetArrayField(TEXT("classes"), ClassesArray))
-	{
-		TSharedPtr<FJsonObject> ClassResults = MakeShareable(new FJsonObject());
+			FString ClassName = (*PropObj)->GetStringField(TEXT("className"));
+			FString PropertyName = (*PropObj)->GetStringField(TEXT("name"));
+			FString Key = ClassName + TEXT("::") + PropertyName;
 
-		for (const TSharedPtr<FJsonValue>& ClassValue : *ClassesArray)
-		{
-			FString ClassName = ClassValue->AsString();
 			UClass* ParentClass = ResolveClassName(ClassName);
 
-			TArray<TSharedPtr<FJsonValue>> BlueprintsArray;
+			// A property hint changes with the hierarchy below the class and with any of its
+			// Blueprints' values
+			if (SinceGeneration > 0)
+			{
+				uint64 HintGeneration = Snapshot->ClassTableGeneration;
+				if (ParentClass)
+				{
+					HintGeneration = Snapshot->GetDerivedGeneration(ParentClass->GetPathName());
+					Snapshot->ForEachDerivedBlueprint(ParentClass->GetPathName(), [&HintGeneration, &OverrideCache](const FNeoStackBlueprintIndex::FBlueprintEntry& Blueprint, int32)
+					{
+						HintGeneration = FMath::Max(HintGeneration, OverrideCache.GetChangeGeneration(Blueprint.ObjectPath));
+					});
+				}
+				if (HintGeneration <= SinceGeneration)
+				{
+					continue;
+				}
+			}
+			ChangedCount++;
+
+			TSharedPtr<FJsonObject> PropResult = MakeShareable(new FJsonObject());
 
 			if (ParentClass)
 			{
-				// Find all Blueprints derived from this class
-				for (const FAssetData& AssetData : AllBlueprintAssets)
+				FProperty* TargetProperty = ParentClass->FindPropertyByName(*PropertyName);
+				if (TargetProperty)
 				{
-					FAssetTagValueRef ParentClassTag = AssetData.TagsAndValues.FindTag(FBlueprintTags::ParentClassPath);
-					if (!ParentClassTag.IsSet()) continue;
+					UObject* ParentCDO = ParentClass->GetDefaultObject();
+					void* ParentValue = TargetProperty->ContainerPtrToValuePtr<void>(ParentCDO);
+					FString DefaultValue;
+					TargetProperty->ExportTextItem_Direct(DefaultValue, ParentValue, nullptr, nullptr, PPF_None);
 
-					FSoftClassPath SoftClassPath(ParentClassTag.GetValue());
-					UClass* BlueprintParentClass = SoftClassPath.ResolveClass();
+					// Check derived blueprints for overrides
+					TArray<TSharedPtr<FJsonValue>> OverridesArray = CollectPropertyOverrides(*Snapshot, ParentClass, TargetProperty, ParentValue, DefaultValue);
+					const int32 OverrideCount = OverridesArray.Num();
 
-					if (BlueprintParentClass && BlueprintParentClass->IsChildOf(ParentClass))
-					{
-						TSharedPtr<FJsonObject> BpInfo = MakeShareable(new FJsonObject());
-						BpInfo->SetStringField(TEXT("path"), ContentPathToFullPath(AssetData.GetObjectPathString()));
-						BpInfo->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
-						BlueprintsArray.Add(MakeShareable(new FJsonValueObject(BpInfo)));
-					}
+					PropResult->SetNumberField(TEXT("overrideCount"), OverrideCount);
+					PropResult->SetBoolField(TEXT("unchanged"), OverrideCount == 0);
+					PropResult->SetStringField(TEXT("defaultValue"), DefaultValue);
+					PropResult->SetArrayField(TEXT("overrides"), OverridesArray);
 				}
 			}
 
-			TSharedPtr<FJsonObject> ClassResult = MakeShareable(new FJsonObject());
-			ClassResult->SetArrayField(TEXT("blueprints"), BlueprintsArray);
-			ClassResult->SetNumberField(TEXT("count"), BlueprintsArray.Num());
-			ClassResults->SetObjectField(ClassName, ClassResult);
+			PropertyResults->SetObjectField(Key, PropResult);
 		}
 
-		ResponseData->SetObjectField(TEXT("classes"), ClassResults);
+		Response.Data->SetObjectField(TEXT("properties"), PropertyResults);
+
+		// Override changes are newer than the snapshot when they happened after its publish
+		const uint64 Generation = FMath::Max(Snapshot->Generation, OverrideCache.GetLatestGeneration());
+		Response.Data->SetNumberField(TEXT("generation"), static_cast<double>(Generation));
+		Response.Data->SetNumberField(TEXT("changedCount"), ChangedCount);
+		Response.Data->SetBoolField(TEXT("notModified"), SinceGeneration > 0 && ChangedCount == 0);
 	}
 
-	// Process property hints
-	const TArray<TSharedPtr<FJsonValue>>* PropertiesArray;
-	if (Args->TryGetArrayField(TEXT("properties"), PropertiesArray))
+	return Response;
+}
+
+bool FNeoStackBlueprintCommands::IsIndexQuery(const FNeoStackCommand& Command)
+{
+	if (Command.Command == NeoStackProtocol::MessageType::FindDerivedBlueprints)
 	{
-		TSharedPtr<FJsonObject> PropertyResults = MakeShareable(new FJsonObject());
+		return true;
+	}
 
-		for (const TSharedPtr<FJsonValue>& PropValue : *PropertiesArray)
+	// Property hints compare CDO values, which means loading Blueprints
+	if (Command.Command == NeoStackProtocol::MessageType::GetBlueprintHintsBatch)
+	{
+		return !Command.Args.IsValid() || !Command.Args->HasField(TEXT("properties"));
+	}
+
+	return false;
+}
+
+FNeoStackEvent FNeoStackBlueprintCommands::HandleIndexQuery(const FNeoStackCommand& Command, const FNeoStackBlueprintIndex::FSnapshot& Snapshot)
+{
+	if (!Command.Args.IsValid())
+	{
+		return MakeError(Command.Command, TEXT("Missing arguments"));
+	}
+
+	if (Command.Command == NeoStackProtocol::MessageType::FindDerivedBlueprints)
+	{
+		return FindDerivedBlueprintsInIndex(Command.Args, Snapshot);
+	}
+	if (Command.Command == NeoStackProtocol::MessageType::GetBlueprintHintsBatch)
+	{
+		return GetBlueprintHintsBatchFromIndex(Command.Args, Snapshot);
+	}
+
+	return MakeError(Command.Command, FString::Printf(TEXT("Not an index query: %s"), *Command.Command));
+}
+
+TArray<TSharedPtr<FJsonValue>> FNeoStackBlueprintCommands::CollectDerivedBlueprints(const FNeoStackBlueprintIndex::FSnapshot& Snapshot,
+	int32 ClassIndex, bool bIncludeParentClass)
+{
+	TArray<TSharedPtr<FJsonValue>> ResultArray;
+	Snapshot.ForEachDerivedBlueprint(Snapshot.GetClass(ClassIndex).PathName, [&](const FNeoStackBlueprintIndex::FBlueprintEntry& Blueprint, int32 Depth)
+	{
+		TSharedPtr<FJsonObject> BlueprintInfo = MakeShareable(new FJsonObject());
+		BlueprintInfo->SetStringField(TEXT("path"), Blueprint.FullPath);
+		BlueprintInfo->SetStringField(TEXT("name"), Blueprint.Name);
+		BlueprintInfo->SetNumberField(TEXT("depth"), Depth);
+		if (bIncludeParentClass)
 		{
-			const TSharedPtr<FJsonObject>* PropObj;
-			if (!PropValue->TryGetObject(PropObj)) continue;
+			BlueprintInfo->SetStringField(TEXT("parentClass"), Blueprint.ParentClassName);
+		}
+		ResultArray.Add(MakeShareable(new FJsonValueObject(BlueprintInfo)));
+	});
+	return ResultArray;
+}
 
-			FString ClassName = (*PropObj)->GetStringField(TEXT("className"));
-			FString PropertyName = (*PropObj)->GetStringField(TEXT("name"));
-			FString Key = ClassName + TEXT("::") + PropertyName;
+TArray<TSharedPtr<FJsonValue>> FNeoStackBlueprintCommands::CollectPropertyOverrides(const FNeoStackBlueprintIndex::FSnapshot& Snapshot,
+	UClass* ParentClass, FProperty* TargetProperty, const void* ParentValue, const FString& DefaultValue)
+{
+	TArray<TSharedPtr<FJsonValue>> OverridesArray;
+	FNeoStackPropertyOverrideCache& OverrideCache = FNeoStackPropertyOverrideCache::Get();
 
-			UClass* ParentClass = ResolveClassName(ClassName);
-			TSharedPtr<FJsonObject> PropResult = MakeShareable(new FJsonObject());
+	// Snapshots never change, so these entries stay valid while the Blueprints load
+	TArray<const FNeoStackBlueprintIndex::FBlueprintEntry*> DerivedBlueprints;
+	Snapshot.ForEachDerivedBlueprint(ParentClass->GetPathName(), [&DerivedBlueprints](const FNeoStackBlueprintIndex::FBlueprintEntry& Blueprint, int32)
+	{
+		DerivedBlueprints.Add(&Blueprint);
+	});
 
-			if (ParentClass)
+	// The cache diffs against native defaults, so it covers native properties only
+	const bool bNativeProperty = !TargetProperty->GetOwnerClass()->HasAnyClassFlags(CLASS_CompiledFromBlueprint);
+
+	for (const FNeoStackBlueprintIndex::FBlueprintEntry* Entry : DerivedBlueprints)
+	{
+		// Each Blueprint may have to load; the partial result is discarded for a cancelled request
+		if (FNeoStackBridgeRequests::IsCurrentCancelled())
+		{
+			break;
+		}
+
+		FString ValueStr;
+		bool bOverridden = false;
+
+		if (bNativeProperty)
+		{
+			// Cached diffs only load Blueprints that haven't been diffed yet
+			TSharedPtr<const FNeoStackPropertyOverrideCache::FEntry> Diff = OverrideCache.FindOrCompute(Entry->ObjectPath);
+			UClass* NativeParent = Diff.IsValid() ? Diff->NativeParent.Get() : nullptr;
+			if (!NativeParent)
 			{
-				FProperty* TargetProperty = ParentClass->FindPropertyByName(*PropertyName);
-				if (TargetProperty)
+				continue;
+			}
+
+			// The Blueprint's value is its recorded override, or else its native parent's
+			// default; either may still match the queried class's default
+			if (const FString* OverrideValue = Diff->NativeOverrides.Find(TargetProperty->GetFName()))
+			{
+				ValueStr = *OverrideValue;
+				bOverridden = ValueStr != DefaultValue;
+			}
+			else if (NativeParent != ParentClass)
+			{
+				const void* NativeValue = TargetProperty->ContainerPtrToValuePtr<void>(NativeParent->GetDefaultObject());
+				if (!TargetProperty->Identical(NativeValue, ParentValue))
 				{
-					UObject* ParentCDO = ParentClass->GetDefaultObject();
-					void* ParentValue = TargetProperty->ContainerPtrToValuePtr<void>(ParentCDO);
-					FString DefaultValue;
-					TargetProperty->ExportTextItem_Direct(DefaultValue, ParentValue, nullptr, nullptr, PPF_None);
+					TargetProperty->ExportTextItem_Direct(ValueStr, NativeValue, nullptr, nullptr, PPF_None);
+					bOverridden = true;
+				}
+			}
+		}
+		else
+		{
+			// Load the Blueprint to check property value
+			UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *Entry->ObjectPath);
+			UObject* BlueprintCDO = Blueprint && Blueprint->GeneratedClass ? Blueprint->GeneratedClass->GetDefaultObject() : nullptr;
+			if (!BlueprintCDO)
+			{
+				continue;
+			}
 
-					TArray<TSharedPtr<FJsonValue>> OverridesArray;
-					int32 OverrideCount = 0;
+			const void* BlueprintValue = TargetProperty->ContainerPtrToValuePtr<void>(BlueprintCDO);
+			if (!TargetProperty->Identical(BlueprintValue, ParentValue))
+			{
+				TargetProperty->ExportTextItem_Direct(ValueStr, BlueprintValue, nullptr, nullptr, PPF_None);
+				bOverridden = true;
+			}
+		}
 
-					// Check derived blueprints for overrides
-					for (const FAssetData& AssetData : AllBlueprintAssets)
-					{
-						FAssetTagValueRef ParentClassTag = AssetData.TagsAndValues.FindTag(FBlueprintTags::ParentClassPath);
-						if (!ParentClassTag.IsSet()) continue;
+		if (bOverridden)
+		{
+			TSharedPtr<FJsonObject> OverrideInfo = MakeShareable(new FJsonObject());
+			OverrideInfo->SetStringField(TEXT("blueprintName"), Entry->Name);
+			OverrideInfo->SetStringField(TEXT("blueprintPath"), Entry->FullPath);
+			OverrideInfo->SetStringField(TEXT("value"), ValueStr);
+			OverridesArray.Add(MakeShareable(new FJsonValueObject(OverrideInfo)));
+		}
+	}
+
+	return OverridesArray;
+}
 
-						FSoftClassPath SoftClassPath(ParentClassTag.GetValue());
-						UClass* BlueprintParentClass = SoftClassPath.ResolveClass();
+FNeoStackEvent FNeoStackBlueprintCommands::FindDerivedBlueprintsInIndex(const TSharedPtr<FJsonObject>& Args,
+	const FNeoStackBlueprintIndex::FSnapshot& Snapshot)
+{
+	FString ClassName = Args->GetStringField(TEXT("className"));
+	if (ClassName.IsEmpty())
+	{
+		return MakeError(NeoStackProtocol::MessageType::FindDerivedBlueprints, TEXT("Missing 'className' argument"));
+	}
 
-						if (!BlueprintParentClass || !BlueprintParentClass->IsChildOf(ParentClass)) continue;
+	const int32 ClassIndex = Snapshot.FindClass(ClassName);
+	if (ClassIndex == INDEX_NONE)
+	{
+		return MakeError(NeoStackProtocol::MessageType::FindDerivedBlueprints,
+			FString::Printf(TEXT("Class not found: %s"), *ClassName));
+	}
 
-						// Load Blueprint to check property value
-						UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
-						if (!Blueprint || !Blueprint->GeneratedClass) continue;
+	TArray<TSharedPtr<FJsonValue>> ResultArray = CollectDerivedBlueprints(Snapshot, ClassIndex, true);
 
-						UObject* BlueprintCDO = Blueprint->GeneratedClass->GetDefaultObject();
-						if (!BlueprintCDO) continue;
+	TSharedPtr<FJsonObject> ResponseData = MakeShareable(new FJsonObject());
+	ResponseData->SetArrayField(TEXT("blueprints"), ResultArray);
+	ResponseData->SetNumberField(TEXT("count"), ResultArray.Num());
 
-						void* BlueprintValue = TargetProperty->ContainerPtrToValuePtr<void>(BlueprintCDO);
+	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Found %d Blueprints derived from %s (index)"), ResultArray.Num(), *ClassName);
 
-						if (!TargetProperty->Identical(BlueprintValue, ParentValue))
-						{
-							FString ValueStr;
-							TargetProperty->ExportTextItem_Direct(ValueStr, BlueprintValue, nullptr, nullptr, PPF_None);
+	return MakeSuccess(NeoStackProtocol::MessageType::FindDerivedBlueprints, ResponseData);
+}
 
-							TSharedPtr<FJsonObject> OverrideInfo = MakeShareable(new FJsonObject());
-							OverrideInfo->SetStringField(TEXT("blueprintName"), AssetData.AssetName.ToString());
-							OverrideInfo->SetStringField(TEXT("blueprintPath"), ContentPathToFullPath(AssetData.GetObjectPathString()));
-							OverrideInfo->SetStringField(TEXT("value"), ValueStr);
-							OverridesArray.Add(MakeShareable(new FJsonValueObject(OverrideInfo)));
-							OverrideCount++;
-						}
-					}
+FNeoStackEvent FNeoStackBlueprintCommands::GetBlueprintHintsBatchFromIndex(const TSharedPtr<FJsonObject>& Args,
+	const FNeoStackBlueprintIndex::FSnapshot& Snapshot)
+{
+	TSharedPtr<FJsonObject> ResponseData = MakeShareable(new FJsonObject());
 
-					PropResult->SetNumberField(TEXT("overrideCount"), OverrideCount);
-					PropResult->SetBoolField(TEXT("unchanged"), OverrideCount == 0);
-					PropResult->SetStringField(TEXT("defaultValue"), DefaultValue);
-					PropResult->SetArrayField(TEXT("overrides"), OverridesArray);
-				}
+	// Hints that haven't changed since the generation the IDE last saw are left out
+	const uint64 SinceGeneration = GetSinceGeneration(Args);
+	int32 ChangedCount = 0;
+
+	// Process class hints
+	const TArray<TSharedPtr<FJsonValue>>* ClassesArray;
+	if (Args->TryGetArrayField(TEXT("classes"), ClassesArray))
+	{
+		TSharedPtr<FJsonObject> ClassResults = MakeShareable(new FJsonObject());
+
+		for (const TSharedPtr<FJsonValue>& ClassValue : *ClassesArray)
+		{
+			if (FNeoStackBridgeRequests::IsCurrentCancelled())
+			{
+				break;
 			}
 
-			PropertyResults->SetObjectField(Key, PropResult);
+			FString ClassName = ClassValue->AsString();
+			const int32 ClassIndex = Snapshot.FindClass(ClassName);
+
+			const uint64 HintGeneration = ClassIndex != INDEX_NONE
+				? Snapshot.GetDerivedGeneration(Snapshot.GetClass(ClassIndex).PathName)
+				: Snapshot.ClassTableGeneration;
+			if (HintGeneration <= SinceGeneration)
+			{
+				continue;
+			}
+			ChangedCount++;
+
+			TArray<TSharedPtr<FJsonValue>> BlueprintsArray;
+			if (ClassIndex != INDEX_NONE)
+			{
+				BlueprintsArray = CollectDerivedBlueprints(Snapshot, ClassIndex, false);
+			}
+
+			TSharedPtr<FJsonObject> ClassResult = MakeShareable(new FJsonObject());
+			ClassResult->SetArrayField(TEXT("blueprints"), BlueprintsArray);
+			ClassResult->SetNumberField(TEXT("count"), BlueprintsArray.Num());
+			ClassResults->SetObjectField(ClassName, ClassResult);
 		}
 
-		ResponseData->SetObjectField(TEXT("properties"), PropertyResults);
+		ResponseData->SetObjectField(TEXT("classes"), ClassResults);
 	}
 
 	// Process function hints
@@ -617,35 +594,23 @@ FNeoStackEvent FNeoStackBlueprintCommands::HandleGetBlueprintHintsBatch(const TS
 			FString FunctionName = (*FuncObj)->GetStringField(TEXT("name"));
 			FString Key = ClassName + TEXT("::") + FunctionName;
 
-			UClass* TargetClass = ResolveClassName(ClassName);
-			TSharedPtr<FJsonObject> FuncResult = MakeShareable(new FJsonObject());
-			TArray<TSharedPtr<FJsonValue>> ImplementationsArray;
+			const int32 ClassIndex = Snapshot.FindClass(ClassName);
+			const uint64 HintGeneration = ClassIndex != INDEX_NONE
+				? Snapshot.GetDerivedGeneration(Snapshot.GetClass(ClassIndex).PathName)
+				: Snapshot.ClassTableGeneration;
+			if (HintGeneration <= SinceGeneration)
+			{
+				continue;
+			}
+			ChangedCount++;
 
-			if (TargetClass)
+			TArray<TSharedPtr<FJsonValue>> ImplementationsArray;
+			if (ClassIndex != INDEX_NONE && Snapshot.HasBlueprintEvent(ClassIndex, FunctionName))
 			{
-				UFunction* TargetFunction = TargetClass->FindFunctionByName(*FunctionName);
-				if (TargetFunction && TargetFunction->HasAnyFunctionFlags(FUNC_BlueprintEvent))
-				{
-					// Find potential implementations
-					for (const FAssetData& AssetData : AllBlueprintAssets)
-					{
-						FAssetTagValueRef ParentClassTag = AssetData.TagsAndValues.FindTag(FBlueprintTags::ParentClassPath);
-						if (!ParentClassTag.IsSet()) continue;
-
-						FSoftClassPath SoftClassPath(ParentClassTag.GetValue());
-						UClass* BlueprintParentClass = SoftClassPath.ResolveClass();
-
-						if (BlueprintParentClass && BlueprintParentClass->IsChildOf(TargetClass))
-						{
-							TSharedPtr<FJsonObject> ImplInfo = MakeShareable(new FJsonObject());
-							ImplInfo->SetStringField(TEXT("path"), ContentPathToFullPath(AssetData.GetObjectPathString()));
-							ImplInfo->SetStringField(TEXT("name"), AssetData.AssetName.ToString());
-							ImplementationsArray.Add(MakeShareable(new FJsonValueObject(ImplInfo)));
-						}
-					}
-				}
+				ImplementationsArray = CollectDerivedBlueprints(Snapshot, ClassIndex, false);
 			}
 
+			TSharedPtr<FJsonObject> FuncResult = MakeShareable(new FJsonObject());
 			FuncResult->SetArrayField(TEXT("implementations"), ImplementationsArray);
 			FuncResult->SetNumberField(TEXT("count"), ImplementationsArray.Num());
 			FunctionResults->SetObjectField(Key, FuncResult);
@@ -654,9 +619,27 @@ FNeoStackEvent FNeoStackBlueprintCommands::HandleGetBlueprintHintsBatch(const TS
 		ResponseData->SetObjectField(TEXT("functions"), FunctionResults);
 	}
 
+	ResponseData->SetStringField(TEXT("epoch"), FNeoStackBlueprintIndex::GetGenerationEpoch());
+	ResponseData->SetNumberField(TEXT("generation"), static_cast<double>(Snapshot.Generation));
+	ResponseData->SetNumberField(TEXT("changedCount"), ChangedCount);
+	ResponseData->SetBoolField(TEXT("notModified"), SinceGeneration > 0 && ChangedCount == 0);
+
 	return MakeSuccess(NeoStackProtocol::MessageType::GetBlueprintHintsBatch, ResponseData);
 }
 
+uint64 FNeoStackBlueprintCommands::GetSinceGeneration(const TSharedPtr<FJsonObject>& Args)
+{
+	// Generations only compare within one editor session
+	FString Epoch;
+	double Generation = 0.0;
+	if (!Args->TryGetStringField(TEXT("epoch"), Epoch) || Epoch != FNeoStackBlueprintIndex::GetGenerationEpoch()
+		|| !Args->TryGetNumberField(TEXT("generation"), Generation) || Generation < 0.0)
+	{
+		return 0;
+	}
+	return static_cast<uint64>(Generation);
+}
+
 UClass* FNeoStackBlueprintCommands::ResolveClassName(const FString& ClassName)
 {
 	// Try direct lookup first (for full path like /Script/Engine.Actor)
@@ -0,0 +1,638 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackBlueprintIndex.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UObjectGlobals.h"
+#include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+#include "Editor.h"
+#include <atomic>
+
+namespace
+{
+	/** Coalesces bursts of registry events (a save, a folder import) into one publish */
+	constexpr float PublishDelay = 0.25f;
+
+	std::atomic<uint64> GGeneration{ 0 };
+
+	/** Only Blueprint assets carry a parent class tag; other asset changes leave the index alone */
+	bool IsBlueprintAsset(const FAssetData& Asset)
+	{
+		return Asset.TagsAndValues.FindTag(FBlueprintTags::ParentClassPath).IsSet();
+	}
+
+	/** Class path tags hold export text (/Script/Engine.BlueprintGeneratedClass'/Game/BP.BP_C'); keep the object path */
+	FString ClassPathFromTag(const FString& TagValue)
+	{
+		return FPackageName::ExportTextPathToObjectPath(TagValue);
+	}
+}
+
+int32 FNeoStackBlueprintIndex::FSnapshot::FindClass(const FString& ClassName) const
+{
+	// Full path (/Script/Engine.Actor), then the name as given or without its A/U/F prefix
+	if (const int32* Index = ClassTable->ByPath.Find(ClassName))
+	{
+		return *Index;
+	}
+	if (const int32* Index = ClassTable->ByName.Find(ClassName))
+	{
+		return *Index;
+	}
+	if (const int32* Index = ClassTable->ByName.Find(ClassName.Mid(1)))
+	{
+		return *Index;
+	}
+	return INDEX_NONE;
+}
+
+void FNeoStackBlueprintIndex::FSnapshot::ForEachDerivedBlueprint(const FString& ClassPath,
+	TFunctionRef<void(const FBlueprintEntry&, int32 Depth)> Visitor) const
+{
+	ForEachDerivedClass(ClassPath, [this, &Visitor](const FString& Path, int32 Depth)
+	{
+		if (const FBucketPtr* Bucket = BlueprintsByParent.Find(Path))
+		{
+			for (const FBlueprintEntry& Entry : **Bucket)
+			{
+				Visitor(Entry, Depth + 1);
+			}
+		}
+	});
+}
+
+uint64 FNeoStackBlueprintIndex::FSnapshot::GetDerivedGeneration(const FString& ClassPath) const
+{
+	uint64 Latest = ClassTableGeneration;
+	ForEachDerivedClass(ClassPath, [this, &Latest](const FString& Path, int32)
+	{
+		if (const uint64* BucketGeneration = BucketGenerations.Find(Path))
+		{
+			Latest = FMath::Max(Latest, *BucketGeneration);
+		}
+	});
+	return Latest;
+}
+
+void FNeoStackBlueprintIndex::FSnapshot::ForEachDerivedClass(const FString& ClassPath,
+	TFunctionRef<void(const FString& Path, int32 Depth)> Visitor) const
+{
+	struct FPendingClass
+	{
+		const FString* Path;
+		int32 Depth;
+	};
+
+	// Each class is visited, then queues the classes its Blueprints generate and its native
+	// subclasses. Loaded Blueprint classes are skipped in the class table since
+	// their asset entries already lead to them; the visited set guards against cyclic tags.
+	TArray<FPendingClass, TInlineAllocator<64>> Pending;
+	TSet<FString> Visited;
+	Pending.Add({ &ClassPath, 0 });
+	while (Pending.Num() > 0)
+	{
+		const FPendingClass Current = Pending.Pop(EAllowShrinking::No);
+		Visitor(*Current.Path, Current.Depth);
+
+		if (const FBucketPtr* Bucket = BlueprintsByParent.Find(*Current.Path))
+		{
+			for (const FBlueprintEntry& Entry : **Bucket)
+			{
+				if (BlueprintsByParent.Contains(Entry.GeneratedClassPath))
+				{
+					bool bAlreadyVisited = false;
+					Visited.Add(Entry.GeneratedClassPath, &bAlreadyVisited);
+					if (!bAlreadyVisited)
+					{
+						Pending.Add({ &Entry.GeneratedClassPath, Current.Depth + 1 });
+					}
+				}
+			}
+		}
+
+		if (const int32* ClassIndex = ClassTable->ByPath.Find(*Current.Path))
+		{
+			for (const int32 SubClass : GetClass(*ClassIndex).SubClasses)
+			{
+				const FClassEntry& SubEntry = GetClass(SubClass);
+				if (!SubEntry.bBlueprintClass)
+				{
+					Pending.Add({ &SubEntry.PathName, Current.Depth + 1 });
+				}
+			}
+		}
+	}
+}
+
+bool FNeoStackBlueprintIndex::FSnapshot::HasBlueprintEvent(int32 ClassIndex, const FString& FunctionName) const
+{
+	const FString LowerName = FunctionName.ToLower();
+	for (int32 Current = ClassIndex; Current != INDEX_NONE; Current = GetClass(Current).SuperClass)
+	{
+		if (GetClass(Current).BlueprintEvents.Contains(LowerName))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+FNeoStackBlueprintIndex& FNeoStackBlueprintIndex::Get()
+{
+	static FNeoStackBlueprintIndex Instance;
+	return Instance;
+}
+
+void FNeoStackBlueprintIndex::Initialize()
+{
+	check(IsInGameThread());
+
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FNeoStackBlueprintIndex::HandleAssetAdded);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FNeoStackBlueprintIndex::HandleAssetRemoved);
+	AssetRegistry.OnAssetUpdated().AddRaw(this, &FNeoStackBlueprintIndex::HandleAssetUpdated);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FNeoStackBlueprintIndex::HandleAssetRenamed);
+	AssetRegistry.OnFilesLoaded().AddRaw(this, &FNeoStackBlueprintIndex::HandleFilesLoaded);
+
+	// New, reloaded or recompiled classes change names, supers and functions; the Blueprint
+	// buckets are keyed by path and come from tags, so only the class table is rebuilt
+	auto HandleClassesChanged = [this]()
+	{
+		bClassesDirty = true;
+		SchedulePublish(false);
+	};
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([HandleClassesChanged](EReloadCompleteReason)
+	{
+		HandleClassesChanged();
+	});
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([HandleClassesChanged](FName, EModuleChangeReason)
+	{
+		HandleClassesChanged();
+	});
+	if (GEditor)
+	{
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddLambda(HandleClassesChanged);
+	}
+
+	// Built on the first tick rather than during module startup
+	bClassesDirty = true;
+	SchedulePublish(true);
+}
+
+void FNeoStackBlueprintIndex::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetUpdated().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+		AssetRegistry.OnFilesLoaded().RemoveAll(this);
+	}
+
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+
+	if (PublishTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PublishTickHandle);
+		PublishTickHandle.Reset();
+	}
+
+	{
+		FScopeLock Lock(&SnapshotLock);
+		Snapshot.Reset();
+	}
+	ClassTable.Reset();
+	ClassTableGeneration = 0;
+	PendingGeneration = 0;
+	Buckets.Empty();
+	BucketGenerations.Empty();
+	ParentByObjectPath.Empty();
+	UnpublishedBuckets.Empty();
+	bFullRebuildQueued = true;
+	bClassesDirty = true;
+	bPublishQueued = false;
+}
+
+FNeoStackBlueprintIndex::FSnapshotPtr FNeoStackBlueprintIndex::GetSnapshot() const
+{
+	FScopeLock Lock(&SnapshotLock);
+	return Snapshot;
+}
+
+FNeoStackBlueprintIndex::FSnapshotPtr FNeoStackBlueprintIndex::GetOrBuildSnapshot()
+{
+	check(IsInGameThread());
+
+	if (bClassesDirty || !ClassTable.IsValid())
+	{
+		RebuildClassTable();
+	}
+	if (bFullRebuildQueued)
+	{
+		RebuildAll();
+	}
+	if (bPublishQueued || !GetSnapshot().IsValid())
+	{
+		Publish();
+	}
+	return GetSnapshot();
+}
+
+uint64 FNeoStackBlueprintIndex::AllocateGeneration()
+{
+	return ++GGeneration;
+}
+
+const FString& FNeoStackBlueprintIndex::GetGenerationEpoch()
+{
+	static const FString Epoch = FGuid::NewGuid().ToString();
+	return Epoch;
+}
+
+FString FNeoStackBlueprintIndex::ContentPathToFullPath(const FString& ContentPath)
+{
+	// Convert /Game/Path/Asset to full filesystem path
+	FString PackagePath = ContentPath;
+
+	// Remove object name suffix if present (e.g., /Game/Test34.Test34 -> /Game/Test34)
+	int32 DotIndex;
+	if (PackagePath.FindLastChar('.', DotIndex))
+	{
+		PackagePath = PackagePath.Left(DotIndex);
+	}
+
+	// Convert to filesystem path
+	FString FilePath;
+	if (FPackageName::TryConvertLongPackageNameToFilename(PackagePath, FilePath, FPackageName::GetAssetPackageExtension()))
+	{
+		return FPaths::ConvertRelativePathToFull(FilePath);
+	}
+
+	// Fallback: return original path
+	return ContentPath;
+}
+
+void FNeoStackBlueprintIndex::SchedulePublish(bool bFull)
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+
+	bFullRebuildQueued |= bFull;
+	bPublishQueued = true;
+	if (!PublishTickHandle.IsValid())
+	{
+		PublishTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FNeoStackBlueprintIndex::HandlePublishTick), PublishDelay);
+	}
+}
+
+bool FNeoStackBlueprintIndex::HandlePublishTick(float DeltaTime)
+{
+	// The initial discovery fires an event per asset; wait for it to settle (OnFilesLoaded
+	// queues the full build that covers it), unless there is nothing to answer from yet
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.IsLoadingAssets() && GetSnapshot().IsValid())
+	{
+		return true;
+	}
+
+	PublishTickHandle.Reset();
+	if (bClassesDirty || !ClassTable.IsValid())
+	{
+		RebuildClassTable();
+	}
+	if (bFullRebuildQueued)
+	{
+		RebuildAll();
+	}
+	if (bPublishQueued)
+	{
+		Publish();
+	}
+	return false;
+}
+
+void FNeoStackBlueprintIndex::RebuildClassTable()
+{
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+	TSharedPtr<const FClassTable, ESPMode::ThreadSafe> NewTable = BuildClassTable();
+
+	// Recompiles that change no names, supers or events leave hints as they were
+	if (!ClassTable.IsValid() || ClassTable->ContentHash != NewTable->ContentHash)
+	{
+		ClassTableGeneration = GetChangeGeneration();
+	}
+	ClassTable = NewTable;
+	bClassesDirty = false;
+	bPublishQueued = true;
+
+	UE_LOG(LogTemp, Verbose, TEXT("[NeoStackBridge] Blueprint index: %d classes in %.1f ms"),
+		ClassTable->Classes.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FNeoStackBlueprintIndex::RebuildAll()
+{
+	check(IsInGameThread());
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	TArray<FAssetData> BlueprintAssets;
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	AssetRegistry.GetAssets(Filter, BlueprintAssets);
+
+	TMap<FString, TSharedPtr<TArray<FBlueprintEntry>, ESPMode::ThreadSafe>> PreviousBuckets = MoveTemp(Buckets);
+	TMap<FString, uint64> PreviousGenerations = BucketGenerations;
+
+	Buckets.Reset();
+	ParentByObjectPath.Reset();
+	UnpublishedBuckets.Reset();
+	for (const FAssetData& AssetData : BlueprintAssets)
+	{
+		AddBlueprint(AssetData);
+	}
+
+	// Only buckets whose contents differ count as changed
+	auto SameBlueprints = [](const TArray<FBlueprintEntry>& A, const TArray<FBlueprintEntry>& B)
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < A.Num(); Index++)
+		{
+			if (A[Index].ObjectPath != B[Index].ObjectPath || A[Index].GeneratedClassPath != B[Index].GeneratedClassPath)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+	for (const auto& Pair : Buckets)
+	{
+		const TSharedPtr<TArray<FBlueprintEntry>, ESPMode::ThreadSafe>* Previous = PreviousBuckets.Find(Pair.Key);
+		const uint64* PreviousGeneration = PreviousGenerations.Find(Pair.Key);
+		if (Previous && PreviousGeneration && SameBlueprints(**Previous, *Pair.Value))
+		{
+			BucketGenerations.Add(Pair.Key, *PreviousGeneration);
+		}
+	}
+	for (const auto& Pair : PreviousBuckets)
+	{
+		if (!Buckets.Contains(Pair.Key))
+		{
+			BucketGenerations.Add(Pair.Key, GetChangeGeneration());
+		}
+	}
+
+	bFullRebuildQueued = false;
+	bPublishQueued = true;
+
+	UE_LOG(LogTemp, Verbose, TEXT("[NeoStackBridge] Blueprint index: %d Blueprints under %d parent classes in %.1f ms"),
+		ParentByObjectPath.Num(), Buckets.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FNeoStackBlueprintIndex::Publish()
+{
+	TSharedRef<FSnapshot, ESPMode::ThreadSafe> NewSnapshot = MakeShared<FSnapshot, ESPMode::ThreadSafe>();
+	NewSnapshot->ClassTable = ClassTable;
+	NewSnapshot->ClassTableGeneration = ClassTableGeneration;
+	NewSnapshot->BucketGenerations = BucketGenerations;
+
+	// Everything changed so far is older than the snapshot; later changes get newer generations
+	NewSnapshot->Generation = AllocateGeneration();
+	PendingGeneration = 0;
+	NewSnapshot->BlueprintsByParent.Reserve(Buckets.Num());
+	for (const auto& Pair : Buckets)
+	{
+		NewSnapshot->BlueprintsByParent.Add(Pair.Key, Pair.Value);
+		NewSnapshot->NumBlueprints += Pair.Value->Num();
+	}
+
+	// Every bucket is shared with the snapshot from here on
+	UnpublishedBuckets.Reset();
+	bPublishQueued = false;
+
+	FScopeLock Lock(&SnapshotLock);
+	Snapshot = NewSnapshot;
+}
+
+void FNeoStackBlueprintIndex::AddBlueprint(const FAssetData& Asset)
+{
+	FAssetTagValueRef ParentClassTag = Asset.TagsAndValues.FindTag(FBlueprintTags::ParentClassPath);
+	if (!ParentClassTag.IsSet())
+	{
+		return;
+	}
+
+	const FString ParentClassPath = ClassPathFromTag(ParentClassTag.GetValue());
+	if (ParentClassPath.IsEmpty())
+	{
+		return;
+	}
+
+	const FString ObjectPath = Asset.GetObjectPathString();
+
+	FBlueprintEntry Entry;
+	Entry.Name = Asset.AssetName.ToString();
+	Entry.ObjectPath = ObjectPath;
+	Entry.FullPath = ContentPathToFullPath(ObjectPath);
+	Entry.ParentClassPath = ParentClassPath;
+	Entry.ParentClassName = FPackageName::ObjectPathToObjectName(ParentClassPath);
+
+	// Saved Blueprints record their generated class; older ones follow the Name_C convention
+	FAssetTagValueRef GeneratedClassTag = Asset.TagsAndValues.FindTag(FBlueprintTags::GeneratedClassPath);
+	if (GeneratedClassTag.IsSet())
+	{
+		Entry.GeneratedClassPath = ClassPathFromTag(GeneratedClassTag.GetValue());
+	}
+	if (Entry.GeneratedClassPath.IsEmpty())
+	{
+		Entry.GeneratedClassPath = ObjectPath + TEXT("_C");
+	}
+
+	GetMutableBucket(ParentClassPath).Add(MoveTemp(Entry));
+	ParentByObjectPath.Add(ObjectPath, ParentClassPath);
+}
+
+void FNeoStackBlueprintIndex::RemoveBlueprint(const FString& ObjectPath)
+{
+	FString ParentClassPath;
+	if (!ParentByObjectPath.RemoveAndCopyValue(ObjectPath, ParentClassPath))
+	{
+		return;
+	}
+
+	// Emptied buckets are kept so their generation still shows the removal
+	TArray<FBlueprintEntry>& Bucket = GetMutableBucket(ParentClassPath);
+	Bucket.RemoveAll([&ObjectPath](const FBlueprintEntry& Entry)
+	{
+		return Entry.ObjectPath == ObjectPath;
+	});
+}
+
+TArray<FNeoStackBlueprintIndex::FBlueprintEntry>& FNeoStackBlueprintIndex::GetMutableBucket(const FString& ParentClassPath)
+{
+	BucketGenerations.Add(ParentClassPath, GetChangeGeneration());
+
+	TSharedPtr<TArray<FBlueprintEntry>, ESPMode::ThreadSafe>& Bucket = Buckets.FindOrAdd(ParentClassPath);
+	if (!Bucket.IsValid())
+	{
+		Bucket = MakeShared<TArray<FBlueprintEntry>, ESPMode::ThreadSafe>();
+		UnpublishedBuckets.Add(ParentClassPath);
+	}
+	else if (!UnpublishedBuckets.Contains(ParentClassPath))
+	{
+		// Readers may still hold the published array
+		Bucket = MakeShared<TArray<FBlueprintEntry>, ESPMode::ThreadSafe>(*Bucket);
+		UnpublishedBuckets.Add(ParentClassPath);
+	}
+	return *Bucket;
+}
+
+uint64 FNeoStackBlueprintIndex::GetChangeGeneration()
+{
+	// One generation per publish cycle, however many buckets change in it
+	if (PendingGeneration == 0)
+	{
+		PendingGeneration = AllocateGeneration();
+	}
+	return PendingGeneration;
+}
+
+TSharedPtr<const FNeoStackBlueprintIndex::FClassTable, ESPMode::ThreadSafe> FNeoStackBlueprintIndex::BuildClassTable()
+{
+	TSharedRef<FClassTable, ESPMode::ThreadSafe> Table = MakeShared<FClassTable, ESPMode::ThreadSafe>();
+
+	// Stale copies left behind by recompiles and reinstancing are never anyone's parent
+	TArray<const UClass*> Classes;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (!It->HasAnyClassFlags(CLASS_NewerVersionExists))
+		{
+			Classes.Add(*It);
+		}
+	}
+
+	TMap<const UClass*, int32> IndexByClass;
+	IndexByClass.Reserve(Classes.Num());
+	Table->Classes.Reserve(Classes.Num());
+	for (const UClass* Class : Classes)
+	{
+		const int32 Index = Table->Classes.AddDefaulted();
+		FClassEntry& Entry = Table->Classes[Index];
+		Entry.Name = Class->GetName();
+		Entry.PathName = Class->GetPathName();
+		Entry.bBlueprintClass = Class->HasAnyClassFlags(CLASS_CompiledFromBlueprint);
+		IndexByClass.Add(Class, Index);
+		Table->ByName.FindOrAdd(Entry.Name, Index);
+		Table->ByPath.Add(Entry.PathName, Index);
+
+		// Summed so the hash doesn't depend on iteration order
+		uint32 ClassHash = HashCombine(GetTypeHash(Entry.PathName), GetTypeHash(Class->GetSuperClass() ? Class->GetSuperClass()->GetPathName() : FString()));
+		for (TFieldIterator<UFunction> FuncIt(Class, EFieldIteratorFlags::ExcludeSuper); FuncIt; ++FuncIt)
+		{
+			if (FuncIt->HasAnyFunctionFlags(FUNC_BlueprintEvent))
+			{
+				const FString EventName = FuncIt->GetName().ToLower();
+				ClassHash += GetTypeHash(EventName);
+				Entry.BlueprintEvents.Add(EventName);
+			}
+		}
+		Table->ContentHash += ClassHash;
+	}
+
+	for (int32 Index = 0; Index < Classes.Num(); Index++)
+	{
+		if (const int32* SuperIndex = IndexByClass.Find(Classes[Index]->GetSuperClass()))
+		{
+			Table->Classes[Index].SuperClass = *SuperIndex;
+			Table->Classes[*SuperIndex].SubClasses.Add(Index);
+		}
+	}
+
+	return Table;
+}
+
+void FNeoStackBlueprintIndex::HandleAssetAdded(const FAssetData& Asset)
+{
+	// The initial discovery reports every asset; the full build after OnFilesLoaded covers those
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (bFullRebuildQueued || AssetRegistry.IsLoadingAssets() || !IsBlueprintAsset(Asset))
+	{
+		return;
+	}
+
+	AddBlueprint(Asset);
+	SchedulePublish(false);
+}
+
+void FNeoStackBlueprintIndex::HandleAssetRemoved(const FAssetData& Asset)
+{
+	if (bFullRebuildQueued || !ParentByObjectPath.Contains(Asset.GetObjectPathString()))
+	{
+		return;
+	}
+
+	RemoveBlueprint(Asset.GetObjectPathString());
+	SchedulePublish(false);
+}
+
+void FNeoStackBlueprintIndex::HandleAssetUpdated(const FAssetData& Asset)
+{
+	// A reparented Blueprint moves to another bucket
+	if (bFullRebuildQueued || !IsBlueprintAsset(Asset))
+	{
+		return;
+	}
+
+	RemoveBlueprint(Asset.GetObjectPathString());
+	AddBlueprint(Asset);
+	SchedulePublish(false);
+}
+
+void FNeoStackBlueprintIndex::HandleAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath)
+{
+	if (bFullRebuildQueued || !IsBlueprintAsset(Asset))
+	{
+		return;
+	}
+
+	RemoveBlueprint(OldObjectPath);
+	AddBlueprint(Asset);
+	SchedulePublish(false);
+}
+
+void FNeoStackBlueprintIndex::HandleFilesLoaded()
+{
+	SchedulePublish(true);
+}
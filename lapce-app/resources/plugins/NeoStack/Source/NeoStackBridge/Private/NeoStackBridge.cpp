@@ -4,6 +4,12 @@
 #include "NeoStackBridgeClient.h"
 #include "NeoStackBridgeProtocol.h"
 #include "NeoStackBridgeCommands.h"
+#include "NeoStackBridgeRequests.h"
+#include "NeoStackEventPublisher.h"
+#include "NeoStackBlueprintIndex.h"
+#include "NeoStackFunctionUsageIndex.h"
+#include "NeoStackPropertyOverrideCache.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Misc/App.h"
 #include "Misc/CommandLine.h"
 #include "Misc/Paths.h"
@@ -15,12 +21,165 @@
 static TUniquePtr<FNeoStackBridgeClient> GBridgeClient;
 static FString GProjectId;
 
+/** Commands running on worker threads; shutdown waits for them before destroying the client */
+static FThreadSafeCounter GOffGameThreadCommands;
+
+/**
+ * Reply to a command; the client serializes sends, so this works from any thread.
+ * Large results are streamed in chunks, and sent as MessagePack, when the IDE supports it.
+ */
+static void SendResponse(const FNeoStackCommand& Command, FNeoStackEvent& Response)
+{
+	Response.RequestId = Command.RequestId;
+
+	if (!GBridgeClient.IsValid())
+	{
+		return;
+	}
+
+	const bool bChunked = GBridgeClient->HasCapability(NeoStackProtocol::Capability::ChunkedResponses);
+
+	// While reconnecting, replies go through the text queue, which any IDE build accepts
+	if (GBridgeClient->IsConnected() && GBridgeClient->HasCapability(NeoStackProtocol::Capability::MessagePack))
+	{
+		const bool bCompress = GBridgeClient->HasCapability(NeoStackProtocol::Capability::Zlib);
+		if (bChunked)
+		{
+			Response.ToBinaryChunks(NeoStackProtocol::MaxChunkChars, bCompress, [](const TArray<uint8>& Frame)
+			{
+				GBridgeClient->SendBinary(Frame);
+			});
+		}
+		else
+		{
+			GBridgeClient->SendBinary(Response.ToBinary(bCompress));
+		}
+		return;
+	}
+
+	if (bChunked)
+	{
+		Response.ToJsonChunks(NeoStackProtocol::MaxChunkChars, [](const FString& Chunk)
+		{
+			GBridgeClient->SendMessage(Chunk);
+		});
+	}
+	else
+	{
+		GBridgeClient->SendMessage(Response.ToJson());
+	}
+}
+
+/** Answer a request and let the next queued one start */
+static void CompleteRequest(const FNeoStackCommand& Command, FNeoStackEvent& Response)
+{
+	SendResponse(Command, Response);
+	FNeoStackBridgeRequests::Get().Finish(Command.RequestId);
+}
+
+/** Run a command on the game thread, where everything that touches UObjects has to run */
+static void ProcessOnGameThread(const FNeoStackCommand& Command)
+{
+	AsyncTask(ENamedThreads::GameThread, [Command]()
+	{
+		// Tools run over several frames and answer once they are done
+		if (FNeoStackBridgeCommands::TryProcessAsync(Command, [Command](FNeoStackEvent& Response)
+		{
+			CompleteRequest(Command, Response);
+		}))
+		{
+			return;
+		}
+
+		FNeoStackEvent Response;
+		{
+			FNeoStackBridgeRequests::FScope RequestScope(Command.RequestId);
+			Response = FNeoStackBridgeCommands::ProcessCommand(Command);
+		}
+		// A query that stopped early has only a partial result; anything else did all its work
+		if (FNeoStackBridgeCommands::StopsWhenCancelled(Command) && FNeoStackBridgeRequests::Get().IsCancelled(Command.RequestId))
+		{
+			Response = FNeoStackBridgeRequests::MakeCancelledResponse(Command);
+		}
+		CompleteRequest(Command, Response);
+	});
+}
+
+/** Run an admitted command, off the game thread when it allows that */
+static void StartCommand(const FNeoStackCommand& Command)
+{
+	// Cancelled while it was queued
+	if (FNeoStackBridgeRequests::Get().IsCancelled(Command.RequestId))
+	{
+		FNeoStackEvent Response = FNeoStackBridgeRequests::MakeCancelledResponse(Command);
+		CompleteRequest(Command, Response);
+		return;
+	}
+
+	if (!FNeoStackBridgeCommands::CanRunOffGameThread(Command))
+	{
+		ProcessOnGameThread(Command);
+		return;
+	}
+
+	// Registry-only queries skip the wait for the next frame and don't compete with PIE
+	GOffGameThreadCommands.Increment();
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Command]()
+	{
+		FNeoStackEvent Response;
+		bool bAnswered;
+		{
+			FNeoStackBridgeRequests::FScope RequestScope(Command.RequestId);
+			bAnswered = FNeoStackBridgeCommands::TryProcessOffGameThread(Command, Response);
+		}
+		if (bAnswered)
+		{
+			// Index queries are read-only, so a cancelled one has nothing to report
+			if (FNeoStackBridgeRequests::Get().IsCancelled(Command.RequestId))
+			{
+				Response = FNeoStackBridgeRequests::MakeCancelledResponse(Command);
+			}
+			CompleteRequest(Command, Response);
+		}
+		else
+		{
+			ProcessOnGameThread(Command);
+		}
+		GOffGameThreadCommands.Decrement();
+	});
+}
+
+/** Handle a message received from the IDE: cancel a request, or admit a command */
+static void DispatchCommand(const FNeoStackCommand& Command)
+{
+	if (Command.Command == NeoStackProtocol::MessageType::Cancel)
+	{
+		FString TargetId;
+		if (Command.Args.IsValid() && Command.Args->TryGetStringField(TEXT("requestId"), TargetId)
+			&& !FNeoStackBridgeRequests::Get().Cancel(TargetId))
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("[NeoStackBridge] Cancel for %s arrived after it was answered"), *TargetId);
+		}
+		return;
+	}
+
+	FNeoStackBridgeRequests::Get().Submit(Command, [](const FNeoStackCommand& Admitted)
+	{
+		StartCommand(Admitted);
+	});
+}
+
 void FNeoStackBridgeModule::StartupModule()
 {
 	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Module starting up..."));
+	TRACE_CPUPROFILER_EVENT_SCOPE(NeoStackBridge_StartupModule);
+	const double StartTime = FPlatformTime::Seconds();
 
-	// Initialize immediately since we're loaded PostEngineInit anyway
+	// Initialize immediately since we're loaded PostEngineInit anyway. Only the connection is set
+	// up here; the tool registry is created by the first command that needs it.
 	InitializeBridge();
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Module startup took %.1f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 }
 
 void FNeoStackBridgeModule::ShutdownModule()
@@ -71,18 +230,40 @@ void FNeoStackBridgeModule::InitializeBridge()
 	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Project: %s"), FApp::GetProjectName());
 	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Project ID: %s"), *GProjectId);
 
+	// Registry-only queries are answered from this index on worker threads
+	FNeoStackBlueprintIndex::Get().Initialize();
+
+	// Blueprint call sites and overrides for find_blueprint_function_usages, scanned in the background
+	FNeoStackFunctionUsageIndex::Get().Initialize();
+
+	// Per-Blueprint default overrides for the property override queries
+	FNeoStackPropertyOverrideCache::Get().Initialize();
+
 	// Create WebSocket client
 	GBridgeClient = MakeUnique<FNeoStackBridgeClient>();
 
+	// Editor events the IDE subscribes to, for as long as the session that subscribed lasts
+	FNeoStackEventPublisher::Get().Initialize([](const FNeoStackEvent& Event)
+	{
+		if (GBridgeClient.IsValid())
+		{
+			GBridgeClient->SendEvent(Event);
+		}
+	});
+
 	// Set up callbacks
 	GBridgeClient->OnConnected.BindLambda([](const FString& SessionId)
 	{
 		UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Connected to IDE, session: %s"), *SessionId);
+
+		// Disconnect() doesn't report OnDisconnected; a new session starts with no subscriptions either way
+		FNeoStackEventPublisher::Get().UnsubscribeAll();
 	});
 
 	GBridgeClient->OnDisconnected.BindLambda([](const FString& Reason)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Disconnected from IDE: %s"), *Reason);
+		FNeoStackEventPublisher::Get().UnsubscribeAll();
 	});
 
 	GBridgeClient->OnReconnecting.BindLambda([]()
@@ -96,20 +277,24 @@ void FNeoStackBridgeModule::InitializeBridge()
 
 		// Parse and handle command
 		FNeoStackCommand Command;
-		if (FNeoStackCommand::FromJson(Message, Command))
+		if (!FNeoStackCommand::FromJson(Message, Command))
 		{
-			// Process on game thread
-			AsyncTask(ENamedThreads::GameThread, [Command]()
-			{
-				FNeoStackEvent Response = FNeoStackBridgeCommands::ProcessCommand(Command);
-				Response.RequestId = Command.RequestId;
+			return;
+		}
 
-				if (GBridgeClient.IsValid() && GBridgeClient->IsConnected())
-				{
-					GBridgeClient->SendMessage(Response.ToJson());
-				}
-			});
+		DispatchCommand(Command);
+	});
+
+	GBridgeClient->OnBinaryMessage.BindLambda([](TArrayView<const uint8> Frame)
+	{
+		FNeoStackCommand Command;
+		if (!FNeoStackCommand::FromBinary(Frame, Command))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Ignoring malformed binary message (%d bytes)"), Frame.Num());
+			return;
 		}
+
+		DispatchCommand(Command);
 	});
 
 	// Connect to IDE
@@ -127,6 +312,18 @@ void FNeoStackBridgeModule::InitializeBridge()
 
 void FNeoStackBridgeModule::ShutdownBridge()
 {
+	// Workers reply through the client, so let in-flight queries finish first; cancelling
+	// everything makes them stop at their next check
+	FNeoStackBridgeRequests::Get().Reset();
+	while (GOffGameThreadCommands.GetValue() > 0)
+	{
+		FPlatformProcess::Sleep(0.001f);
+	}
+	FNeoStackEventPublisher::Get().Shutdown();
+	FNeoStackBlueprintIndex::Get().Shutdown();
+	FNeoStackFunctionUsageIndex::Get().Shutdown();
+	FNeoStackPropertyOverrideCache::Get().Shutdown();
+
 	if (GBridgeClient.IsValid())
 	{
 		GBridgeClient->Disconnect();
@@ -43,12 +43,16 @@ bool FNeoStackBridgeClient::Connect(const FString& Url)
 	FModuleManager::LoadModuleChecked<FWebSocketsModule>("WebSockets");
 
 	// Create WebSocket (no subprotocol needed)
-	WebSocket = FWebSocketsModule::Get().CreateWebSocket(Url);
+	{
+		FScopeLock Lock(&SendLock);
+		WebSocket = FWebSocketsModule::Get().CreateWebSocket(Url);
+	}
 
 	if (!WebSocket.IsValid())
 	{
 		UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] Failed to create WebSocket"));
 		bIsConnecting = false;
+		StopReconnecting();
 		return false;
 	}
 
@@ -79,12 +83,19 @@ void FNeoStackBridgeClient::SetupHandlers()
 	{
 		OnWsMessageReceived(Message);
 	});
+
+	WebSocket->OnBinaryMessage().AddLambda([this](const void* Data, SIZE_T Size, bool bIsLastFragment)
+	{
+		OnWsBinaryReceived(Data, Size, bIsLastFragment);
+	});
 }
 
 void FNeoStackBridgeClient::Disconnect()
 {
 	ClearReconnectTimer();
 
+	FScopeLock Lock(&SendLock);
+
 	if (WebSocket.IsValid())
 	{
 		if (WebSocket->IsConnected())
@@ -95,9 +106,12 @@ void FNeoStackBridgeClient::Disconnect()
 	}
 
 	bIsConnecting = false;
+	bReconnectPending = false;
 	bHandshakeComplete = false;
 	SessionId.Empty();
-	PendingMessages.Empty();
+	AcceptedCapabilities.Empty();
+	BinaryFragments.Empty();
+	ResetPendingMessages();
 
 	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Disconnected from IDE"));
 }
@@ -107,16 +121,22 @@ bool FNeoStackBridgeClient::IsConnected() const
 	return WebSocket.IsValid() && WebSocket->IsConnected() && bHandshakeComplete;
 }
 
+bool FNeoStackBridgeClient::HasCapability(const FString& Capability) const
+{
+	FScopeLock Lock(&SendLock);
+	return AcceptedCapabilities.Contains(Capability);
+}
+
 bool FNeoStackBridgeClient::SendMessage(const FString& Message)
 {
+	FScopeLock Lock(&SendLock);
+
 	if (!IsConnected())
 	{
 		// Queue message if we're reconnecting
-		if (bIsConnecting && PendingMessages.Num() < MaxPendingMessages)
+		if (bIsConnecting || bReconnectPending)
 		{
-			PendingMessages.Add(Message);
-			UE_LOG(LogTemp, Verbose, TEXT("[NeoStackBridge] Queued message for later delivery"));
-			return true;
+			return QueueResponse(Message);
 		}
 		UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Cannot send message - not connected"));
 		return false;
@@ -126,6 +146,150 @@ bool FNeoStackBridgeClient::SendMessage(const FString& Message)
 	return true;
 }
 
+bool FNeoStackBridgeClient::SendEvent(const FNeoStackEvent& Event)
+{
+	FString Message = Event.ToJson();
+
+	FScopeLock Lock(&SendLock);
+
+	if (!IsConnected())
+	{
+		if (bIsConnecting || bReconnectPending)
+		{
+			return QueueEvent(Event, MoveTemp(Message));
+		}
+		// Warn once per lost connection; the publisher sends until it notices the disconnect
+		if (!bReportedEventNotSent)
+		{
+			bReportedEventNotSent = true;
+			UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Cannot send events - not connected"));
+		}
+		return false;
+	}
+
+	WebSocket->Send(Message);
+	return true;
+}
+
+FNeoStackBridgeClient::FQueueStats FNeoStackBridgeClient::GetQueueStats() const
+{
+	FScopeLock Lock(&SendLock);
+	return QueueStats;
+}
+
+bool FNeoStackBridgeClient::QueueResponse(const FString& Message)
+{
+	FPendingMessage Pending;
+	Pending.Message = Message;
+
+	if (!MakeRoom(Pending.GetSize()))
+	{
+		QueueStats.DroppedResponses++;
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Dropped response while reconnecting - queue full"));
+		return false;
+	}
+
+	PendingBytes += Pending.GetSize();
+	PendingResponses.Add(MoveTemp(Pending));
+	UE_LOG(LogTemp, Verbose, TEXT("[NeoStackBridge] Queued message for later delivery"));
+	return true;
+}
+
+bool FNeoStackBridgeClient::QueueEvent(const FNeoStackEvent& Event, FString&& Message)
+{
+	FPendingMessage Pending;
+	Pending.Message = MoveTemp(Message);
+
+	FString AssetPath;
+	if (Event.Event == NeoStackProtocol::MessageType::AssetModified && Event.Data.IsValid()
+		&& Event.Data->TryGetStringField(TEXT("path"), AssetPath))
+	{
+		// Only the asset's latest state matters; it goes to the back, after what it may depend on
+		Pending.CoalesceKey = Event.Event + TEXT("|") + AssetPath;
+		const int32 Index = PendingEvents.IndexOfByPredicate([&Pending](const FPendingMessage& Queued)
+		{
+			return Queued.CoalesceKey == Pending.CoalesceKey;
+		});
+		if (Index != INDEX_NONE)
+		{
+			PendingBytes -= PendingEvents[Index].GetSize();
+			PendingEvents.RemoveAt(Index);
+			QueueStats.CoalescedEvents++;
+		}
+	}
+	else if (Event.Event == NeoStackProtocol::MessageType::LogMessage)
+	{
+		FPendingMessage* Run = PendingEvents.Num() > 0 ? &PendingEvents.Last() : nullptr;
+		if (Run && Run->LogEvent.IsSet() && Run->CoalesceKey == Pending.Message)
+		{
+			// The same line again: count it into the queued one
+			Run->RepeatCount++;
+
+			FNeoStackEvent Collapsed = Run->LogEvent.GetValue();
+			Collapsed.Data = Collapsed.Data.IsValid() ? MakeShared<FJsonObject>(*Collapsed.Data) : MakeShared<FJsonObject>();
+			Collapsed.Data->SetNumberField(TEXT("repeatCount"), Run->RepeatCount);
+
+			PendingBytes -= Run->GetSize();
+			Run->Message = Collapsed.ToJson();
+			PendingBytes += Run->GetSize();
+			QueueStats.CoalescedEvents++;
+			return true;
+		}
+
+		// The line as first seen identifies its run
+		Pending.CoalesceKey = Pending.Message;
+		Pending.LogEvent = Event;
+	}
+
+	if (!MakeRoom(Pending.GetSize()))
+	{
+		QueueStats.DroppedEvents++;
+		return false;
+	}
+
+	PendingBytes += Pending.GetSize();
+	PendingEvents.Add(MoveTemp(Pending));
+	return true;
+}
+
+bool FNeoStackBridgeClient::MakeRoom(int64 Incoming)
+{
+	if (Incoming > MaxPendingBytes)
+	{
+		return false;
+	}
+
+	// Events only describe state the IDE can query again; responses have someone waiting for them
+	int32 NumDropped = 0;
+	while (PendingBytes + Incoming > MaxPendingBytes && NumDropped < PendingEvents.Num())
+	{
+		PendingBytes -= PendingEvents[NumDropped].GetSize();
+		NumDropped++;
+	}
+	if (NumDropped > 0)
+	{
+		PendingEvents.RemoveAt(0, NumDropped);
+		QueueStats.DroppedEvents += NumDropped;
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Dropped %d queued events while reconnecting - queue full"), NumDropped);
+	}
+
+	return PendingBytes + Incoming <= MaxPendingBytes;
+}
+
+bool FNeoStackBridgeClient::SendBinary(const TArray<uint8>& Frame)
+{
+	FScopeLock Lock(&SendLock);
+
+	if (!IsConnected())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Cannot send binary message - not connected"));
+		return false;
+	}
+
+	WebSocket->Send(Frame.GetData(), Frame.Num(), true);
+	return true;
+}
+
 void FNeoStackBridgeClient::OnWsConnectedInternal()
 {
 	bIsConnecting = false;
@@ -154,6 +318,12 @@ void FNeoStackBridgeClient::SendHandshake()
 	HandshakeObj->SetStringField(TEXT("engineVersion"), EngineVersion);
 	HandshakeObj->SetNumberField(TEXT("pid"), FPlatformProcess::GetCurrentProcessId());
 
+	TArray<TSharedPtr<FJsonValue>> Capabilities;
+	Capabilities.Add(MakeShared<FJsonValueString>(NeoStackProtocol::Capability::ChunkedResponses));
+	Capabilities.Add(MakeShared<FJsonValueString>(NeoStackProtocol::Capability::MessagePack));
+	Capabilities.Add(MakeShared<FJsonValueString>(NeoStackProtocol::Capability::Zlib));
+	HandshakeObj->SetArrayField(TEXT("capabilities"), Capabilities);
+
 	FString HandshakeJson;
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&HandshakeJson);
 	FJsonSerializer::Serialize(HandshakeObj.ToSharedRef(), Writer);
@@ -189,6 +359,10 @@ void FNeoStackBridgeClient::OnWsClosed(int32 StatusCode, const FString& Reason,
 	{
 		AttemptReconnect();
 	}
+	else
+	{
+		StopReconnecting();
+	}
 }
 
 void FNeoStackBridgeClient::OnWsMessageReceived(const FString& Message)
@@ -206,6 +380,29 @@ void FNeoStackBridgeClient::OnWsMessageReceived(const FString& Message)
 	OnMessage.ExecuteIfBound(Message);
 }
 
+void FNeoStackBridgeClient::OnWsBinaryReceived(const void* Data, SIZE_T Size, bool bIsLastFragment)
+{
+	if (BinaryFragments.Num() + Size > static_cast<SIZE_T>(NeoStackProtocol::MaxDecodedFrameBytes))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Dropping oversized binary message"));
+		BinaryFragments.Empty();
+		return;
+	}
+
+	BinaryFragments.Append(static_cast<const uint8*>(Data), Size);
+	if (!bIsLastFragment)
+	{
+		return;
+	}
+
+	// Binary frames are only valid once the handshake accepted them
+	if (bHandshakeComplete)
+	{
+		OnBinaryMessage.ExecuteIfBound(BinaryFragments);
+	}
+	BinaryFragments.Reset();
+}
+
 void FNeoStackBridgeClient::ProcessHandshakeAck(const FString& Message)
 {
 	TSharedPtr<FJsonObject> JsonObject;
@@ -237,7 +434,26 @@ void FNeoStackBridgeClient::ProcessHandshakeAck(const FString& Message)
 	}
 
 	JsonObject->TryGetStringField(TEXT("sessionId"), SessionId);
+
+	// IDEs that predate capabilities send none, so every optional feature stays off
+	{
+		FScopeLock Lock(&SendLock);
+		AcceptedCapabilities.Empty();
+		const TArray<TSharedPtr<FJsonValue>>* Capabilities;
+		if (JsonObject->TryGetArrayField(TEXT("capabilities"), Capabilities))
+		{
+			for (const TSharedPtr<FJsonValue>& Capability : *Capabilities)
+			{
+				AcceptedCapabilities.Add(Capability->AsString());
+			}
+		}
+	}
 	bHandshakeComplete = true;
+	{
+		FScopeLock Lock(&SendLock);
+		bReconnectPending = false;
+		bReportedEventNotSent = false;
+	}
 
 	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Handshake complete, session: %s"), *SessionId);
 
@@ -253,12 +469,14 @@ void FNeoStackBridgeClient::AttemptReconnect()
 	if (ServerUrl.IsEmpty())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] No server URL for reconnection"));
+		StopReconnecting();
 		return;
 	}
 
 	if (ReconnectAttempts >= MaxReconnectAttempts && MaxReconnectAttempts > 0)
 	{
 		UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] Max reconnection attempts (%d) reached"), MaxReconnectAttempts);
+		StopReconnecting();
 		return;
 	}
 
@@ -270,10 +488,11 @@ void FNeoStackBridgeClient::AttemptReconnect()
 
 	OnReconnecting.ExecuteIfBound();
 
-	// Clear existing socket
-	if (WebSocket.IsValid())
+	// Clear existing socket; sends queue until the reconnect succeeds or gives up
 	{
+		FScopeLock Lock(&SendLock);
 		WebSocket.Reset();
+		bReconnectPending = true;
 	}
 
 	// Schedule reconnection on game thread
@@ -310,16 +529,48 @@ float FNeoStackBridgeClient::CalculateBackoffDelay() const
 
 void FNeoStackBridgeClient::FlushPendingMessages()
 {
-	if (PendingMessages.Num() > 0)
+	FScopeLock Lock(&SendLock);
+
+	if (!IsConnected() || (PendingResponses.Num() == 0 && PendingEvents.Num() == 0))
+	{
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Flushing %d pending responses and %d pending events (%llu events coalesced, %llu responses and %llu events dropped so far)"),
+		PendingResponses.Num(), PendingEvents.Num(), QueueStats.CoalescedEvents, QueueStats.DroppedResponses, QueueStats.DroppedEvents);
+
+	// Replies first: the IDE is blocked on them, while events only refresh its view
+	for (const FPendingMessage& Pending : PendingResponses)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Flushing %d pending messages"), PendingMessages.Num());
+		WebSocket->Send(Pending.Message);
+	}
+	for (const FPendingMessage& Pending : PendingEvents)
+	{
+		WebSocket->Send(Pending.Message);
+	}
+	ResetPendingMessages();
+}
 
-		for (const FString& Message : PendingMessages)
-		{
-			SendMessage(Message);
-		}
-		PendingMessages.Empty();
+void FNeoStackBridgeClient::ResetPendingMessages()
+{
+	PendingResponses.Empty();
+	PendingEvents.Empty();
+	PendingBytes = 0;
+}
+
+void FNeoStackBridgeClient::StopReconnecting()
+{
+	FScopeLock Lock(&SendLock);
+
+	if (PendingResponses.Num() > 0 || PendingEvents.Num() > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Not reconnecting - dropping %d queued responses and %d queued events"),
+			PendingResponses.Num(), PendingEvents.Num());
+		QueueStats.DroppedResponses += PendingResponses.Num();
+		QueueStats.DroppedEvents += PendingEvents.Num();
 	}
+	bReconnectPending = false;
+	ResetPendingMessages();
 }
 
 void FNeoStackBridgeClient::ClearReconnectTimer()
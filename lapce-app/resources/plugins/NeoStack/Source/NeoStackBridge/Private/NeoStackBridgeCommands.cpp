@@ -4,7 +4,12 @@
 #include "NeoStackBridgeProtocol.h"
 #include "NeoStackBlueprintCommands.h"
 #include "NeoStackBridgeDiscovery.h"
+#include "NeoStackBridgeRequests.h"
+#include "NeoStackEventPublisher.h"
 #include "Tools/NeoStackToolRegistry.h"
+#include "Tools/TurnCheckpoint.h"
+#include "NeoStackImagePipeline.h"
+#include "NeoStackTrace.h"
 #include "Editor.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Subsystems/AssetEditorSubsystem.h"
@@ -20,6 +25,9 @@
 
 FNeoStackEvent FNeoStackBridgeCommands::ProcessCommand(const FNeoStackCommand& Command)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("NeoStackBridge_ProcessCommand", NeoStackToolsChannel);
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*Command.Command, NeoStackToolsChannel);
+
 	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Processing command: %s"), *Command.Command);
 
 	if (Command.Command == NeoStackProtocol::MessageType::OpenBlueprint)
@@ -54,6 +62,10 @@ FNeoStackEvent FNeoStackBridgeCommands::ProcessCommand(const FNeoStackCommand& C
 	{
 		return HandleExecuteTool(Command.Args);
 	}
+	else if (Command.Command == NeoStackProtocol::MessageType::BeginTurn)
+	{
+		return HandleBeginTurn(Command.Args);
+	}
 	// Blueprint query commands
 	else if (Command.Command == NeoStackProtocol::MessageType::FindDerivedBlueprints)
 	{
@@ -92,10 +104,88 @@ FNeoStackEvent FNeoStackBridgeCommands::ProcessCommand(const FNeoStackCommand& C
 	{
 		return HandleGetStreamInfo(Command.Args);
 	}
+	// Event stream
+	else if (Command.Command == NeoStackProtocol::MessageType::SubscribeEvents)
+	{
+		return HandleSubscribeEvents(Command.Args);
+	}
+	else if (Command.Command == NeoStackProtocol::MessageType::UnsubscribeEvents)
+	{
+		return HandleUnsubscribeEvents(Command.Args);
+	}
 
 	return MakeError(Command.Command, FString::Printf(TEXT("Unknown command: %s"), *Command.Command));
 }
 
+bool FNeoStackBridgeCommands::TryProcessAsync(const FNeoStackCommand& Command, TFunction<void(FNeoStackEvent&)>&& OnComplete)
+{
+	if (Command.Command != NeoStackProtocol::MessageType::ExecuteTool)
+	{
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Processing command: %s"), *Command.Command);
+
+	FString ToolName;
+	TSharedPtr<FJsonObject> ToolArgs;
+	FNeoStackEvent Response;
+	if (!ParseToolArgs(Command.Args, ToolName, ToolArgs, Response))
+	{
+		OnComplete(Response);
+		return true;
+	}
+
+	// The registry steps the tool over as many frames as it needs and drops it once the IDE cancels.
+	// A cancel that came too late to stop the tool (an edit already under way) gets its real result.
+	TSharedPtr<FNeoStackCancellationToken> CancelToken = FNeoStackBridgeRequests::Get().GetToken(Command.RequestId);
+	FNeoStackToolRegistry::Get().ExecuteAsync(ToolName, ToolArgs, FOnToolProgress(), CancelToken)
+		.Next([Command, CancelToken, OnComplete = MoveTemp(OnComplete)](FToolResult Result)
+		{
+			const bool bStopped = CancelToken.IsValid() && CancelToken->IsCancelled()
+				&& !Result.bSuccess && Result.Output == TEXT("Cancelled");
+			FNeoStackEvent ToolResponse = bStopped ? FNeoStackBridgeRequests::MakeCancelledResponse(Command) : MakeToolResponse(Result);
+			OnComplete(ToolResponse);
+		});
+	return true;
+}
+
+bool FNeoStackBridgeCommands::StopsWhenCancelled(const FNeoStackCommand& Command)
+{
+	return Command.Command == NeoStackProtocol::MessageType::FindDerivedBlueprints
+		|| Command.Command == NeoStackProtocol::MessageType::FindBlueprintReferences
+		|| Command.Command == NeoStackProtocol::MessageType::GetBlueprintPropertyOverrides
+		|| Command.Command == NeoStackProtocol::MessageType::FindBlueprintFunctionUsages
+		|| Command.Command == NeoStackProtocol::MessageType::GetPropertyOverridesAcrossBlueprints
+		|| Command.Command == NeoStackProtocol::MessageType::GetBlueprintHintsBatch;
+}
+
+bool FNeoStackBridgeCommands::CanRunOffGameThread(const FNeoStackCommand& Command)
+{
+	return FNeoStackBlueprintCommands::IsIndexQuery(Command);
+}
+
+bool FNeoStackBridgeCommands::TryProcessOffGameThread(const FNeoStackCommand& Command, FNeoStackEvent& OutResponse)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("NeoStackBridge_ProcessCommandOffGameThread", NeoStackToolsChannel);
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*Command.Command, NeoStackToolsChannel);
+
+	if (!CanRunOffGameThread(Command))
+	{
+		return false;
+	}
+
+	// The snapshot stays valid for this call even if a rebuild replaces it meanwhile
+	FNeoStackBlueprintIndex::FSnapshotPtr Snapshot = FNeoStackBlueprintIndex::Get().GetSnapshot();
+	if (!Snapshot.IsValid())
+	{
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Processing command off the game thread: %s"), *Command.Command);
+	OutResponse = FNeoStackBlueprintCommands::HandleIndexQuery(Command, *Snapshot);
+	return true;
+}
+
 FNeoStackEvent FNeoStackBridgeCommands::HandleOpenBlueprint(const TSharedPtr<FJsonObject>& Args)
 {
 	if (!Args.IsValid())
@@ -302,34 +392,77 @@ FNeoStackEvent FNeoStackBridgeCommands::HandleExecuteCommand(const TSharedPtr<FJ
 }
 
 FNeoStackEvent FNeoStackBridgeCommands::HandleExecuteTool(const TSharedPtr<FJsonObject>& Args)
+{
+	FString ToolName;
+	TSharedPtr<FJsonObject> ToolArgsObj;
+	FNeoStackEvent Response;
+	if (!ParseToolArgs(Args, ToolName, ToolArgsObj, Response))
+	{
+		return Response;
+	}
+
+	// Execute via tool registry
+	return MakeToolResponse(FNeoStackToolRegistry::Get().Execute(ToolName, ToolArgsObj));
+}
+
+FNeoStackEvent FNeoStackBridgeCommands::HandleBeginTurn(const TSharedPtr<FJsonObject>& Args)
+{
+	// Tool calls from the IDE have no chat input to mark their turns; without this the
+	// checkpoint would cover every edit since the session's first
+	FTurnCheckpoint::Get().BeginTurn();
+	return MakeSuccess(NeoStackProtocol::MessageType::BeginTurn);
+}
+
+bool FNeoStackBridgeCommands::ParseToolArgs(const TSharedPtr<FJsonObject>& Args, FString& OutToolName,
+	TSharedPtr<FJsonObject>& OutToolArgs, FNeoStackEvent& OutError)
 {
 	if (!Args.IsValid())
 	{
-		return MakeError(NeoStackProtocol::MessageType::ExecuteTool, TEXT("Missing arguments"));
+		OutError = MakeError(NeoStackProtocol::MessageType::ExecuteTool, TEXT("Missing arguments"));
+		return false;
 	}
 
-	FString ToolName = Args->GetStringField(TEXT("tool"));
-	if (ToolName.IsEmpty())
+	OutToolName = Args->GetStringField(TEXT("tool"));
+	if (OutToolName.IsEmpty())
 	{
-		return MakeError(NeoStackProtocol::MessageType::ExecuteTool, TEXT("Missing 'tool' argument"));
+		OutError = MakeError(NeoStackProtocol::MessageType::ExecuteTool, TEXT("Missing 'tool' argument"));
+		return false;
 	}
 
 	// Get tool args (optional)
 	const TSharedPtr<FJsonObject>* ToolArgs = nullptr;
-	TSharedPtr<FJsonObject> ToolArgsObj = MakeShared<FJsonObject>();
+	OutToolArgs = MakeShared<FJsonObject>();
 	if (Args->TryGetObjectField(TEXT("args"), ToolArgs))
 	{
-		ToolArgsObj = *ToolArgs;
+		OutToolArgs = *ToolArgs;
 	}
+	return true;
+}
 
-	// Execute via tool registry
-	FToolResult Result = FNeoStackToolRegistry::Get().Execute(ToolName, ToolArgsObj);
-
+FNeoStackEvent FNeoStackBridgeCommands::MakeToolResponse(const FToolResult& Result)
+{
 	if (Result.bSuccess)
 	{
 		// Return plain text output in data.output
 		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 		Data->SetStringField(TEXT("output"), Result.Output);
+
+		// Attached images (capture_viewport) as base64 PNGs, keyed by content hash
+		if (Result.Images.Num() > 0)
+		{
+			TArray<TSharedPtr<FJsonValue>> Images;
+			for (const TSharedPtr<const FNeoStackProcessedImage>& Image : Result.Images)
+			{
+				TSharedPtr<FJsonObject> ImageObject = MakeShared<FJsonObject>();
+				ImageObject->SetStringField(TEXT("hash"), Image->Hash);
+				ImageObject->SetStringField(TEXT("mimeType"), Image->MimeType);
+				ImageObject->SetNumberField(TEXT("width"), Image->Width);
+				ImageObject->SetNumberField(TEXT("height"), Image->Height);
+				ImageObject->SetStringField(TEXT("data"), Image->Base64Data);
+				Images.Add(MakeShared<FJsonValueObject>(ImageObject));
+			}
+			Data->SetArrayField(TEXT("images"), Images);
+		}
 		return MakeSuccess(NeoStackProtocol::MessageType::ExecuteTool, Data);
 	}
 	else
@@ -338,6 +471,36 @@ FNeoStackEvent FNeoStackBridgeCommands::HandleExecuteTool(const TSharedPtr<FJson
 	}
 }
 
+FNeoStackEvent FNeoStackBridgeCommands::HandleSubscribeEvents(const TSharedPtr<FJsonObject>& Args)
+{
+	FNeoStackEventPublisher::FSubscription Subscription;
+	FString Error;
+	if (!FNeoStackEventPublisher::ParseSubscription(Args, Subscription, Error))
+	{
+		return MakeError(NeoStackProtocol::MessageType::SubscribeEvents, Error);
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetStringField(TEXT("subscriptionId"), FNeoStackEventPublisher::Get().Subscribe(MoveTemp(Subscription)));
+	return MakeSuccess(NeoStackProtocol::MessageType::SubscribeEvents, Data);
+}
+
+FNeoStackEvent FNeoStackBridgeCommands::HandleUnsubscribeEvents(const TSharedPtr<FJsonObject>& Args)
+{
+	FString SubscriptionId;
+	if (!Args.IsValid() || !Args->TryGetStringField(TEXT("subscriptionId"), SubscriptionId))
+	{
+		return MakeError(NeoStackProtocol::MessageType::UnsubscribeEvents, TEXT("Missing 'subscriptionId' argument"));
+	}
+
+	if (!FNeoStackEventPublisher::Get().Unsubscribe(SubscriptionId))
+	{
+		return MakeError(NeoStackProtocol::MessageType::UnsubscribeEvents,
+			FString::Printf(TEXT("Unknown subscription: %s"), *SubscriptionId));
+	}
+	return MakeSuccess(NeoStackProtocol::MessageType::UnsubscribeEvents);
+}
+
 FNeoStackEvent FNeoStackBridgeCommands::MakeSuccess(const FString& Event, TSharedPtr<FJsonObject> Data)
 {
 	FNeoStackEvent Response;
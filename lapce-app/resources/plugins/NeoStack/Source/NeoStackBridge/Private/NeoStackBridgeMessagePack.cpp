@@ -0,0 +1,498 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackBridgeMessagePack.h"
+#include "NeoStackBridgeProtocol.h"
+#include "Misc/Compression.h"
+
+namespace NeoStackMessagePack
+{
+	void FWriter::WriteBigEndian(uint64 Value, int32 NumBytes)
+	{
+		for (int32 Shift = (NumBytes - 1) * 8; Shift >= 0; Shift -= 8)
+		{
+			WriteByte(static_cast<uint8>(Value >> Shift));
+		}
+	}
+
+	void FWriter::WriteHeader(uint8 FixFormat, uint32 FixMax, uint8 Format8, uint8 Format16, uint8 Format32, uint32 Count)
+	{
+		if (Count <= FixMax)
+		{
+			WriteByte(FixFormat | static_cast<uint8>(Count));
+		}
+		else if (Format8 != 0 && Count <= MAX_uint8)
+		{
+			WriteByte(Format8);
+			WriteBigEndian(Count, 1);
+		}
+		else if (Count <= MAX_uint16)
+		{
+			WriteByte(Format16);
+			WriteBigEndian(Count, 2);
+		}
+		else
+		{
+			WriteByte(Format32);
+			WriteBigEndian(Count, 4);
+		}
+	}
+
+	void FWriter::WriteNil()
+	{
+		WriteByte(0xc0);
+	}
+
+	void FWriter::WriteBool(bool bValue)
+	{
+		WriteByte(bValue ? 0xc3 : 0xc2);
+	}
+
+	void FWriter::WriteNumber(double Value)
+	{
+		// 2^64 and -2^63, the bounds of the integer formats
+		constexpr double UInt64End = 18446744073709551616.0;
+		constexpr double Int64Min = -9223372036854775808.0;
+
+		if (FMath::IsFinite(Value) && Value == FMath::TruncToDouble(Value) && Value >= Int64Min && Value < UInt64End)
+		{
+			if (Value >= 0.0)
+			{
+				const uint64 Unsigned = static_cast<uint64>(Value);
+				if (Unsigned <= 0x7f)
+				{
+					WriteByte(static_cast<uint8>(Unsigned));
+				}
+				else if (Unsigned <= MAX_uint8)
+				{
+					WriteByte(0xcc);
+					WriteBigEndian(Unsigned, 1);
+				}
+				else if (Unsigned <= MAX_uint16)
+				{
+					WriteByte(0xcd);
+					WriteBigEndian(Unsigned, 2);
+				}
+				else if (Unsigned <= MAX_uint32)
+				{
+					WriteByte(0xce);
+					WriteBigEndian(Unsigned, 4);
+				}
+				else
+				{
+					WriteByte(0xcf);
+					WriteBigEndian(Unsigned, 8);
+				}
+				return;
+			}
+
+			const int64 Signed = static_cast<int64>(Value);
+			if (Signed >= -32)
+			{
+				WriteByte(static_cast<uint8>(Signed));
+			}
+			else if (Signed >= MIN_int8)
+			{
+				WriteByte(0xd0);
+				WriteBigEndian(static_cast<uint64>(Signed), 1);
+			}
+			else if (Signed >= MIN_int16)
+			{
+				WriteByte(0xd1);
+				WriteBigEndian(static_cast<uint64>(Signed), 2);
+			}
+			else if (Signed >= MIN_int32)
+			{
+				WriteByte(0xd2);
+				WriteBigEndian(static_cast<uint64>(Signed), 4);
+			}
+			else
+			{
+				WriteByte(0xd3);
+				WriteBigEndian(static_cast<uint64>(Signed), 8);
+			}
+			return;
+		}
+
+		WriteByte(0xcb);
+		WriteBigEndian(BitCast<uint64>(Value), 8);
+	}
+
+	void FWriter::WriteString(const FString& Value)
+	{
+		const FTCHARToUTF8 Utf8(*Value, Value.Len());
+		WriteHeader(0xa0, 31, 0xd9, 0xda, 0xdb, static_cast<uint32>(Utf8.Length()));
+		Buffer.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+	}
+
+	void FWriter::WriteArrayHeader(uint32 Count)
+	{
+		WriteHeader(0x90, 15, 0, 0xdc, 0xdd, Count);
+	}
+
+	void FWriter::WriteMapHeader(uint32 Count)
+	{
+		WriteHeader(0x80, 15, 0, 0xde, 0xdf, Count);
+	}
+
+	void FWriter::WriteValue(const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			WriteNil();
+			return;
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::Boolean:
+			WriteBool(Value->AsBool());
+			break;
+
+		case EJson::Number:
+			WriteNumber(Value->AsNumber());
+			break;
+
+		case EJson::String:
+			WriteString(Value->AsString());
+			break;
+
+		case EJson::Array:
+		{
+			const TArray<TSharedPtr<FJsonValue>>& Items = Value->AsArray();
+			WriteArrayHeader(Items.Num());
+			for (const TSharedPtr<FJsonValue>& Item : Items)
+			{
+				WriteValue(Item);
+			}
+			break;
+		}
+
+		case EJson::Object:
+		{
+			const TSharedPtr<FJsonObject> Object = Value->AsObject();
+			if (Object.IsValid())
+			{
+				WriteObject(*Object);
+			}
+			else
+			{
+				WriteNil();
+			}
+			break;
+		}
+
+		default:
+			WriteNil();
+			break;
+		}
+	}
+
+	void FWriter::WriteObject(const FJsonObject& Object)
+	{
+		WriteMapHeader(Object.Values.Num());
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+		{
+			WriteString(Field.Key);
+			WriteValue(Field.Value);
+		}
+	}
+
+	void FWriter::WriteRaw(TArrayView<const uint8> Bytes)
+	{
+		Buffer.Append(Bytes.GetData(), Bytes.Num());
+	}
+
+	namespace
+	{
+		/** Bridge messages nest a handful of levels; anything deeper is malformed or hostile */
+		constexpr int32 MaxDepth = 64;
+
+		class FReader
+		{
+		public:
+			explicit FReader(TArrayView<const uint8> InData)
+				: Data(InData)
+			{
+			}
+
+			bool IsAtEnd() const { return Pos == Data.Num(); }
+
+			TSharedPtr<FJsonValue> ReadValue(int32 Depth)
+			{
+				uint8 Format = 0;
+				if (Depth > MaxDepth || !ReadByte(Format))
+				{
+					return nullptr;
+				}
+
+				if (Format <= 0x7f)
+				{
+					return MakeShared<FJsonValueNumber>(Format);
+				}
+				if (Format >= 0xe0)
+				{
+					return MakeShared<FJsonValueNumber>(static_cast<int8>(Format));
+				}
+				if ((Format & 0xf0) == 0x80)
+				{
+					return ReadMap(Format & 0x0f, Depth);
+				}
+				if ((Format & 0xf0) == 0x90)
+				{
+					return ReadArray(Format & 0x0f, Depth);
+				}
+				if ((Format & 0xe0) == 0xa0)
+				{
+					return ReadString(Format & 0x1f);
+				}
+
+				uint64 Value = 0;
+				switch (Format)
+				{
+				case 0xc0: return MakeShared<FJsonValueNull>();
+				case 0xc2: return MakeShared<FJsonValueBoolean>(false);
+				case 0xc3: return MakeShared<FJsonValueBoolean>(true);
+
+				case 0xca:
+					return ReadBigEndian(4, Value) ? MakeNumber(BitCast<float>(static_cast<uint32>(Value))) : nullptr;
+				case 0xcb:
+					return ReadBigEndian(8, Value) ? MakeNumber(BitCast<double>(Value)) : nullptr;
+
+				case 0xcc: return ReadBigEndian(1, Value) ? MakeNumber(static_cast<double>(Value)) : nullptr;
+				case 0xcd: return ReadBigEndian(2, Value) ? MakeNumber(static_cast<double>(Value)) : nullptr;
+				case 0xce: return ReadBigEndian(4, Value) ? MakeNumber(static_cast<double>(Value)) : nullptr;
+				case 0xcf: return ReadBigEndian(8, Value) ? MakeNumber(static_cast<double>(Value)) : nullptr;
+
+				case 0xd0: return ReadBigEndian(1, Value) ? MakeNumber(static_cast<int8>(Value)) : nullptr;
+				case 0xd1: return ReadBigEndian(2, Value) ? MakeNumber(static_cast<int16>(Value)) : nullptr;
+				case 0xd2: return ReadBigEndian(4, Value) ? MakeNumber(static_cast<int32>(Value)) : nullptr;
+				case 0xd3: return ReadBigEndian(8, Value) ? MakeNumber(static_cast<double>(static_cast<int64>(Value))) : nullptr;
+
+				case 0xd9: return ReadBigEndian(1, Value) ? ReadString(Value) : nullptr;
+				case 0xda: return ReadBigEndian(2, Value) ? ReadString(Value) : nullptr;
+				case 0xdb: return ReadBigEndian(4, Value) ? ReadString(Value) : nullptr;
+
+				case 0xdc: return ReadBigEndian(2, Value) ? ReadArray(Value, Depth) : nullptr;
+				case 0xdd: return ReadBigEndian(4, Value) ? ReadArray(Value, Depth) : nullptr;
+
+				case 0xde: return ReadBigEndian(2, Value) ? ReadMap(Value, Depth) : nullptr;
+				case 0xdf: return ReadBigEndian(4, Value) ? ReadMap(Value, Depth) : nullptr;
+
+				default:
+					// bin and ext have no JSON counterpart
+					return nullptr;
+				}
+			}
+
+		private:
+			static TSharedPtr<FJsonValue> MakeNumber(double Value)
+			{
+				return MakeShared<FJsonValueNumber>(Value);
+			}
+
+			bool ReadByte(uint8& OutByte)
+			{
+				if (Pos >= Data.Num())
+				{
+					return false;
+				}
+				OutByte = Data[Pos++];
+				return true;
+			}
+
+			bool ReadBigEndian(int32 NumBytes, uint64& OutValue)
+			{
+				if (Data.Num() - Pos < NumBytes)
+				{
+					return false;
+				}
+
+				OutValue = 0;
+				for (int32 Index = 0; Index < NumBytes; ++Index)
+				{
+					OutValue = (OutValue << 8) | Data[Pos++];
+				}
+				return true;
+			}
+
+			TSharedPtr<FJsonValue> ReadString(uint64 Length)
+			{
+				FString Text;
+				return ReadStringBody(Length, Text) ? MakeShared<FJsonValueString>(MoveTemp(Text)) : nullptr;
+			}
+
+			bool ReadStringBody(uint64 Length, FString& OutText)
+			{
+				if (static_cast<uint64>(Data.Num() - Pos) < Length)
+				{
+					return false;
+				}
+
+				const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data.GetData() + Pos), static_cast<int32>(Length));
+				OutText = FString(Converted.Length(), Converted.Get());
+				Pos += static_cast<int32>(Length);
+				return true;
+			}
+
+			TSharedPtr<FJsonValue> ReadArray(uint64 Count, int32 Depth)
+			{
+				// Every element takes at least a byte, which bounds the reservation
+				if (static_cast<uint64>(Data.Num() - Pos) < Count)
+				{
+					return nullptr;
+				}
+
+				TArray<TSharedPtr<FJsonValue>> Items;
+				Items.Reserve(static_cast<int32>(Count));
+				for (uint64 Index = 0; Index < Count; ++Index)
+				{
+					TSharedPtr<FJsonValue> Item = ReadValue(Depth + 1);
+					if (!Item.IsValid())
+					{
+						return nullptr;
+					}
+					Items.Add(MoveTemp(Item));
+				}
+				return MakeShared<FJsonValueArray>(MoveTemp(Items));
+			}
+
+			TSharedPtr<FJsonValue> ReadMap(uint64 Count, int32 Depth)
+			{
+				if (static_cast<uint64>(Data.Num() - Pos) < Count * 2)
+				{
+					return nullptr;
+				}
+
+				TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+				for (uint64 Index = 0; Index < Count; ++Index)
+				{
+					FString Key;
+					if (!ReadKey(Key))
+					{
+						return nullptr;
+					}
+
+					TSharedPtr<FJsonValue> Value = ReadValue(Depth + 1);
+					if (!Value.IsValid())
+					{
+						return nullptr;
+					}
+					Object->SetField(Key, Value);
+				}
+				return MakeShared<FJsonValueObject>(Object);
+			}
+
+			/** Map keys have to be strings, as in JSON */
+			bool ReadKey(FString& OutKey)
+			{
+				uint8 Format = 0;
+				if (!ReadByte(Format))
+				{
+					return false;
+				}
+
+				uint64 Length = 0;
+				if ((Format & 0xe0) == 0xa0)
+				{
+					Length = Format & 0x1f;
+				}
+				else if (!(Format == 0xd9 && ReadBigEndian(1, Length))
+					&& !(Format == 0xda && ReadBigEndian(2, Length))
+					&& !(Format == 0xdb && ReadBigEndian(4, Length)))
+				{
+					return false;
+				}
+				return ReadStringBody(Length, OutKey);
+			}
+
+			TArrayView<const uint8> Data;
+			int32 Pos = 0;
+		};
+	}
+
+	TSharedPtr<FJsonValue> Read(TArrayView<const uint8> Data)
+	{
+		FReader Reader(Data);
+		TSharedPtr<FJsonValue> Value = Reader.ReadValue(0);
+		return Reader.IsAtEnd() ? Value : nullptr;
+	}
+}
+
+namespace NeoStackBinaryFrame
+{
+	/** Flags byte plus the uncompressed size of zlib frames */
+	constexpr int32 CompressedHeaderSize = 1 + sizeof(uint32);
+
+	void Begin(TArray<uint8>& Frame)
+	{
+		Frame.Reset();
+		Frame.Add(0);
+	}
+
+	void Finish(TArray<uint8>& Frame, bool bAllowCompression)
+	{
+		const int32 PayloadSize = Frame.Num() - 1;
+		if (!bAllowCompression || PayloadSize <= NeoStackProtocol::CompressionThreshold)
+		{
+			return;
+		}
+
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, PayloadSize);
+		TArray<uint8> Compressed;
+		Compressed.SetNumUninitialized(CompressedHeaderSize + CompressedSize);
+		if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData() + CompressedHeaderSize, CompressedSize, Frame.GetData() + 1, PayloadSize)
+			|| CompressedSize >= PayloadSize)
+		{
+			// Incompressible; the plain frame is already complete
+			return;
+		}
+
+		Compressed[0] = FlagZlib;
+		for (int32 Index = 0; Index < static_cast<int32>(sizeof(uint32)); ++Index)
+		{
+			Compressed[1 + Index] = static_cast<uint8>(static_cast<uint32>(PayloadSize) >> (Index * 8));
+		}
+		Compressed.SetNum(CompressedHeaderSize + CompressedSize, EAllowShrinking::No);
+		Frame = MoveTemp(Compressed);
+	}
+
+	bool Decode(TArrayView<const uint8> Frame, TArray<uint8>& Storage, TArrayView<const uint8>& OutPayload)
+	{
+		if (Frame.Num() < 1)
+		{
+			return false;
+		}
+
+		const uint8 Flags = Frame[0];
+		if (Flags == 0)
+		{
+			OutPayload = Frame.Slice(1, Frame.Num() - 1);
+			return true;
+		}
+
+		if (Flags != FlagZlib || Frame.Num() < CompressedHeaderSize)
+		{
+			return false;
+		}
+
+		uint32 PayloadSize = 0;
+		for (int32 Index = 0; Index < static_cast<int32>(sizeof(uint32)); ++Index)
+		{
+			PayloadSize |= static_cast<uint32>(Frame[1 + Index]) << (Index * 8);
+		}
+		if (PayloadSize > static_cast<uint32>(NeoStackProtocol::MaxDecodedFrameBytes))
+		{
+			return false;
+		}
+
+		Storage.SetNumUninitialized(PayloadSize);
+		if (!FCompression::UncompressMemory(NAME_Zlib, Storage.GetData(), PayloadSize,
+			Frame.GetData() + CompressedHeaderSize, Frame.Num() - CompressedHeaderSize))
+		{
+			return false;
+		}
+
+		OutPayload = Storage;
+		return true;
+	}
+}
@@ -1,10 +1,102 @@
 // Copyright NeoStack. All Rights Reserved.
 
 #include "NeoStackBridgeProtocol.h"
+#include "NeoStackBridgeMessagePack.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 #include "Dom/JsonObject.h"
 
+namespace
+{
+	using FCondensedJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+	using FCondensedJsonWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	FString SerializeCondensed(const TSharedRef<FJsonObject>& Object)
+	{
+		FString Out;
+		TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&Out);
+		FJsonSerializer::Serialize(Object, Writer);
+		return Out;
+	}
+
+	FString SerializeCondensed(const TSharedPtr<FJsonValue>& Value)
+	{
+		FString Out;
+		TSharedRef<FCondensedJsonWriter> Writer = FCondensedJsonWriterFactory::Create(&Out);
+		FJsonSerializer::Serialize(Value, FString(), Writer);
+		return Out;
+	}
+
+	FString QuoteJson(const FString& Text)
+	{
+		return SerializeCondensed(MakeShared<FJsonValueString>(Text));
+	}
+
+	/** Everything an event holds except data, left open with "data": so a data object can follow */
+	FString MakeChunkPrefix(const FNeoStackEvent& Event, int32 Seq, bool bFinal)
+	{
+		TSharedRef<FJsonObject> Envelope = MakeShared<FJsonObject>();
+		Envelope->SetStringField(TEXT("event"), Event.Event);
+		Envelope->SetBoolField(TEXT("success"), Event.bSuccess);
+		if (!Event.RequestId.IsEmpty())
+		{
+			Envelope->SetStringField(TEXT("requestId"), Event.RequestId);
+		}
+		if (!Event.Error.IsEmpty())
+		{
+			Envelope->SetStringField(TEXT("error"), Event.Error);
+		}
+
+		TSharedPtr<FJsonObject> Chunk = MakeShared<FJsonObject>();
+		Chunk->SetNumberField(TEXT("seq"), Seq);
+		Chunk->SetBoolField(TEXT("final"), bFinal);
+		Envelope->SetObjectField(TEXT("chunk"), Chunk);
+
+		FString Prefix = SerializeCondensed(Envelope);
+		Prefix.LeftChopInline(1, EAllowShrinking::No);
+		Prefix += TEXT(",\"data\":");
+		return Prefix;
+	}
+
+	/** The field worth splitting: a string longer than one chunk, else the array with the most elements */
+	FString FindChunkField(const FJsonObject& Data, int32 MaxChunkChars)
+	{
+		FString StringField;
+		int32 LongestString = MaxChunkChars;
+		FString ArrayField;
+		int32 LargestArray = 1;
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Data.Values)
+		{
+			if (!Field.Value.IsValid())
+			{
+				continue;
+			}
+
+			if (Field.Value->Type == EJson::String)
+			{
+				const int32 Len = Field.Value->AsString().Len();
+				if (Len > LongestString)
+				{
+					LongestString = Len;
+					StringField = Field.Key;
+				}
+			}
+			else if (Field.Value->Type == EJson::Array)
+			{
+				const int32 Num = Field.Value->AsArray().Num();
+				if (Num > LargestArray)
+				{
+					LargestArray = Num;
+					ArrayField = Field.Key;
+				}
+			}
+		}
+
+		return StringField.IsEmpty() ? ArrayField : StringField;
+	}
+}
+
 FString FNeoStackPresenceMessage::ToJson() const
 {
 	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
@@ -66,6 +158,29 @@ bool FNeoStackCommand::FromJson(const FString& JsonString, FNeoStackCommand& Out
 		return false;
 	}
 
+	return FromJsonObject(JsonObject, OutCommand);
+}
+
+bool FNeoStackCommand::FromBinary(TArrayView<const uint8> Frame, FNeoStackCommand& OutCommand)
+{
+	TArray<uint8> Storage;
+	TArrayView<const uint8> Payload;
+	if (!NeoStackBinaryFrame::Decode(Frame, Storage, Payload))
+	{
+		return false;
+	}
+
+	const TSharedPtr<FJsonValue> Value = NeoStackMessagePack::Read(Payload);
+	return Value.IsValid() && Value->Type == EJson::Object && FromJsonObject(Value->AsObject(), OutCommand);
+}
+
+bool FNeoStackCommand::FromJsonObject(const TSharedPtr<FJsonObject>& JsonObject, FNeoStackCommand& OutCommand)
+{
+	if (!JsonObject.IsValid())
+	{
+		return false;
+	}
+
 	OutCommand.Command = JsonObject->GetStringField(TEXT("cmd"));
 	OutCommand.RequestId = JsonObject->GetStringField(TEXT("requestId"));
 
@@ -78,9 +193,9 @@ bool FNeoStackCommand::FromJson(const FString& JsonString, FNeoStackCommand& Out
 	return true;
 }
 
-FString FNeoStackEvent::ToJson() const
+TSharedRef<FJsonObject> FNeoStackEvent::ToJsonObject() const
 {
-	TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
+	TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
 
 	JsonObject->SetStringField(TEXT("event"), Event);
 	JsonObject->SetBoolField(TEXT("success"), bSuccess);
@@ -100,11 +215,223 @@ FString FNeoStackEvent::ToJson() const
 		JsonObject->SetObjectField(TEXT("data"), Data);
 	}
 
+	return JsonObject;
+}
+
+FString FNeoStackEvent::ToJson() const
+{
 	FString OutputString;
 	// Use condensed writer (no newlines) for TCP protocol - read_line expects single line
 	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
 		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
-	FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
+	FJsonSerializer::Serialize(ToJsonObject(), Writer);
 
 	return OutputString;
 }
+
+TArray<uint8> FNeoStackEvent::ToBinary(bool bAllowCompression) const
+{
+	TArray<uint8> Frame;
+	NeoStackBinaryFrame::Begin(Frame);
+	NeoStackMessagePack::FWriter(Frame).WriteObject(*ToJsonObject());
+	NeoStackBinaryFrame::Finish(Frame, bAllowCompression);
+	return Frame;
+}
+
+void FNeoStackEvent::ToJsonChunks(int32 MaxChunkChars, TFunctionRef<void(const FString&)> Emit) const
+{
+	const FString ChunkField = Data.IsValid() ? FindChunkField(*Data, MaxChunkChars) : FString();
+	if (ChunkField.IsEmpty())
+	{
+		Emit(ToJson());
+		return;
+	}
+
+	const TSharedPtr<FJsonValue>& FieldValue = Data->Values.FindChecked(ChunkField);
+	const FString QuotedField = QuoteJson(ChunkField);
+	int32 Seq = 0;
+
+	// Slice of the field that goes into the next event, as JSON ready to follow "field":
+	FString Slice;
+
+	if (FieldValue->Type == EJson::String)
+	{
+		const FString& Text = FieldValue->AsString();
+		int32 Start = 0;
+		while (Text.Len() - Start > MaxChunkChars)
+		{
+			int32 Count = MaxChunkChars;
+			if (Count > 1 && StringConv::IsHighSurrogate(Text[Start + Count - 1]))
+			{
+				// Don't split a surrogate pair across events
+				--Count;
+			}
+
+			Emit(MakeChunkPrefix(*this, Seq++, false) + TEXT("{") + QuotedField + TEXT(":")
+				+ QuoteJson(Text.Mid(Start, Count)) + TEXT("}}"));
+			Start += Count;
+		}
+		Slice = QuoteJson(Text.Mid(Start));
+	}
+	else
+	{
+		FString Items;
+		for (const TSharedPtr<FJsonValue>& Item : FieldValue->AsArray())
+		{
+			const FString ItemJson = SerializeCondensed(Item);
+			if (!Items.IsEmpty() && Items.Len() + ItemJson.Len() > MaxChunkChars)
+			{
+				Emit(MakeChunkPrefix(*this, Seq++, false) + TEXT("{") + QuotedField + TEXT(":[") + Items + TEXT("]}}"));
+				Items.Reset();
+			}
+
+			if (!Items.IsEmpty())
+			{
+				Items += TEXT(",");
+			}
+			Items += ItemJson;
+		}
+		Slice = TEXT("[") + Items + TEXT("]");
+	}
+
+	if (Seq == 0)
+	{
+		// Everything fit in one event
+		Emit(ToJson());
+		return;
+	}
+
+	// The final event carries the last slice and every other field
+	TSharedRef<FJsonObject> Rest = MakeShared<FJsonObject>();
+	Rest->Values = Data->Values;
+	Rest->Values.Remove(ChunkField);
+
+	FString RestJson = SerializeCondensed(Rest);
+	RestJson.LeftChopInline(1, EAllowShrinking::No);
+	if (Rest->Values.Num() > 0)
+	{
+		RestJson += TEXT(",");
+	}
+
+	Emit(MakeChunkPrefix(*this, Seq, true) + RestJson + QuotedField + TEXT(":") + Slice + TEXT("}}"));
+}
+
+void FNeoStackEvent::ToBinaryChunks(int32 MaxChunkBytes, bool bAllowCompression, TFunctionRef<void(const TArray<uint8>&)> Emit) const
+{
+	const FString ChunkField = Data.IsValid() ? FindChunkField(*Data, MaxChunkBytes) : FString();
+	if (ChunkField.IsEmpty())
+	{
+		Emit(ToBinary(bAllowCompression));
+		return;
+	}
+
+	// Writes one event whose data holds the chunk field's slice, plus every other field when bWithRest
+	auto EmitChunk = [this, &ChunkField, bAllowCompression, &Emit](int32 Seq, bool bFinal, bool bWithRest, TFunctionRef<void(NeoStackMessagePack::FWriter&)> WriteSlice)
+	{
+		TArray<uint8> Frame;
+		NeoStackBinaryFrame::Begin(Frame);
+		NeoStackMessagePack::FWriter Writer(Frame);
+
+		// event, success, data, then the optional fields
+		const bool bChunked = Seq != INDEX_NONE;
+		Writer.WriteMapHeader(3 + (RequestId.IsEmpty() ? 0 : 1) + (Error.IsEmpty() ? 0 : 1) + (bChunked ? 1 : 0));
+		Writer.WriteString(TEXT("event"));
+		Writer.WriteString(Event);
+		Writer.WriteString(TEXT("success"));
+		Writer.WriteBool(bSuccess);
+		if (!RequestId.IsEmpty())
+		{
+			Writer.WriteString(TEXT("requestId"));
+			Writer.WriteString(RequestId);
+		}
+		if (!Error.IsEmpty())
+		{
+			Writer.WriteString(TEXT("error"));
+			Writer.WriteString(Error);
+		}
+		if (bChunked)
+		{
+			Writer.WriteString(TEXT("chunk"));
+			Writer.WriteMapHeader(2);
+			Writer.WriteString(TEXT("seq"));
+			Writer.WriteNumber(Seq);
+			Writer.WriteString(TEXT("final"));
+			Writer.WriteBool(bFinal);
+		}
+
+		Writer.WriteString(TEXT("data"));
+		Writer.WriteMapHeader(bWithRest ? Data->Values.Num() : 1);
+		if (bWithRest)
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Data->Values)
+			{
+				if (Field.Key != ChunkField)
+				{
+					Writer.WriteString(Field.Key);
+					Writer.WriteValue(Field.Value);
+				}
+			}
+		}
+		Writer.WriteString(ChunkField);
+		WriteSlice(Writer);
+
+		NeoStackBinaryFrame::Finish(Frame, bAllowCompression);
+		Emit(Frame);
+	};
+
+	const TSharedPtr<FJsonValue>& FieldValue = Data->Values.FindChecked(ChunkField);
+	int32 Seq = 0;
+
+	if (FieldValue->Type == EJson::String)
+	{
+		const FString& Text = FieldValue->AsString();
+		int32 Start = 0;
+		while (Text.Len() - Start > MaxChunkBytes)
+		{
+			int32 Count = MaxChunkBytes;
+			if (Count > 1 && StringConv::IsHighSurrogate(Text[Start + Count - 1]))
+			{
+				--Count;
+			}
+
+			EmitChunk(Seq++, false, false, [&Text, Start, Count](NeoStackMessagePack::FWriter& Writer)
+			{
+				Writer.WriteString(Text.Mid(Start, Count));
+			});
+			Start += Count;
+		}
+
+		EmitChunk(Seq == 0 ? INDEX_NONE : Seq, true, true, [&Text, Start](NeoStackMessagePack::FWriter& Writer)
+		{
+			Writer.WriteString(Start == 0 ? Text : Text.Mid(Start));
+		});
+		return;
+	}
+
+	// Items are encoded once into a running slice, flushed whenever the next one would overflow it
+	TArray<uint8> Items;
+	int32 NumItems = 0;
+	TArray<uint8> Item;
+	auto WriteItems = [&Items, &NumItems](NeoStackMessagePack::FWriter& Writer)
+	{
+		Writer.WriteArrayHeader(NumItems);
+		Writer.WriteRaw(Items);
+	};
+
+	for (const TSharedPtr<FJsonValue>& Value : FieldValue->AsArray())
+	{
+		Item.Reset();
+		NeoStackMessagePack::FWriter(Item).WriteValue(Value);
+		if (NumItems > 0 && Items.Num() + Item.Num() > MaxChunkBytes)
+		{
+			EmitChunk(Seq++, false, false, WriteItems);
+			Items.Reset();
+			NumItems = 0;
+		}
+
+		Items.Append(Item);
+		++NumItems;
+	}
+
+	EmitChunk(Seq == 0 ? INDEX_NONE : Seq, true, true, WriteItems);
+}
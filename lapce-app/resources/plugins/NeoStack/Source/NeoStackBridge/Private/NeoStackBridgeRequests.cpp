@@ -0,0 +1,271 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackBridgeRequests.h"
+#include "Dom/JsonObject.h"
+
+namespace
+{
+	/** Request the handler on this thread works for, set by FNeoStackBridgeRequests::FScope */
+	thread_local TSharedPtr<FNeoStackCancellationToken>* GCurrentToken = nullptr;
+
+	/** Requests of commands without a limit of their own that may run at the same time */
+	constexpr int32 DefaultMaxConcurrent = 4;
+}
+
+FNeoStackBridgeRequests& FNeoStackBridgeRequests::Get()
+{
+	static FNeoStackBridgeRequests Instance;
+	return Instance;
+}
+
+int32 FNeoStackBridgeRequests::GetMaxConcurrent(const FString& Command)
+{
+	// Whole-registry scans: extra copies only compete with the one the IDE is waiting for
+	if (Command == NeoStackProtocol::MessageType::GetPropertyOverridesAcrossBlueprints)
+	{
+		return 1;
+	}
+	if (Command == NeoStackProtocol::MessageType::GetBlueprintHintsBatch
+		|| Command == NeoStackProtocol::MessageType::FindBlueprintFunctionUsages)
+	{
+		return 2;
+	}
+	// Editor state changes; a second one only makes sense once the first is done
+	if (Command == NeoStackProtocol::MessageType::TriggerHotReload
+		|| Command == NeoStackProtocol::MessageType::PlayInEditor
+		|| Command == NeoStackProtocol::MessageType::StopPIE)
+	{
+		return 1;
+	}
+	return DefaultMaxConcurrent;
+}
+
+bool FNeoStackBridgeRequests::CanSupersede(const FString& Command)
+{
+	return Command == NeoStackProtocol::MessageType::FindDerivedBlueprints
+		|| Command == NeoStackProtocol::MessageType::FindBlueprintReferences
+		|| Command == NeoStackProtocol::MessageType::GetBlueprintPropertyOverrides
+		|| Command == NeoStackProtocol::MessageType::FindBlueprintFunctionUsages
+		|| Command == NeoStackProtocol::MessageType::GetPropertyOverridesAcrossBlueprints
+		|| Command == NeoStackProtocol::MessageType::GetBlueprintHintsBatch
+		|| Command == NeoStackProtocol::MessageType::GetStreamInfo;
+}
+
+void FNeoStackBridgeRequests::Submit(const FNeoStackCommand& Command, FStartRequest&& Start)
+{
+	// Nothing can refer to a request without an ID, so there is nothing to track
+	if (Command.RequestId.IsEmpty())
+	{
+		Start(Command);
+		return;
+	}
+
+	FToStartList ToStart;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		if (Requests.Contains(Command.RequestId))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Ignoring duplicate request %s (%s)"), *Command.RequestId, *Command.Command);
+			return;
+		}
+
+		TUniquePtr<FRequest> Request = MakeUnique<FRequest>();
+		Request->Command = Command;
+		Request->Start = MoveTemp(Start);
+
+		FString Key;
+		if (CanSupersede(Command.Command) && Command.Args.IsValid() && Command.Args->TryGetStringField(TEXT("supersedeKey"), Key) && !Key.IsEmpty())
+		{
+			Request->SupersedeKey = Command.Command + TEXT("|") + Key;
+			if (const FString* Previous = LatestBySupersedeKey.Find(Request->SupersedeKey))
+			{
+				const FString PreviousId = *Previous;
+				UE_LOG(LogTemp, Verbose, TEXT("[NeoStackBridge] Request %s supersedes %s"), *Command.RequestId, *PreviousId);
+				CancelLocked(PreviousId, ToStart);
+			}
+			LatestBySupersedeKey.Add(Request->SupersedeKey, Command.RequestId);
+		}
+
+		int32& RunningCount = RunningCounts.FindOrAdd(Command.Command);
+		if (RunningCount < GetMaxConcurrent(Command.Command))
+		{
+			RunningCount++;
+			Request->bRunning = true;
+			ToStart.Emplace(Command, MoveTemp(Request->Start));
+		}
+		else
+		{
+			Queued.FindOrAdd(Command.Command).Add(Command.RequestId);
+		}
+
+		Requests.Add(Command.RequestId, MoveTemp(Request));
+	}
+	StartAll(ToStart);
+}
+
+void FNeoStackBridgeRequests::Finish(const FString& RequestId)
+{
+	if (RequestId.IsEmpty())
+	{
+		return;
+	}
+
+	FToStartList ToStart;
+	{
+		FScopeLock ScopeLock(&Lock);
+
+		TUniquePtr<FRequest>* Found = Requests.Find(RequestId);
+		if (!Found)
+		{
+			return;
+		}
+		TUniquePtr<FRequest> Request = MoveTemp(*Found);
+		Requests.Remove(RequestId);
+
+		if (!Request->SupersedeKey.IsEmpty())
+		{
+			const FString* Latest = LatestBySupersedeKey.Find(Request->SupersedeKey);
+			if (Latest && *Latest == RequestId)
+			{
+				LatestBySupersedeKey.Remove(Request->SupersedeKey);
+			}
+		}
+
+		if (Request->bRunning)
+		{
+			RunningCounts.FindChecked(Request->Command.Command)--;
+		}
+
+		while (FRequest* Next = PopStartable(Request->Command.Command))
+		{
+			ToStart.Emplace(Next->Command, MoveTemp(Next->Start));
+		}
+	}
+	StartAll(ToStart);
+}
+
+bool FNeoStackBridgeRequests::Cancel(const FString& RequestId)
+{
+	FToStartList ToStart;
+	bool bFound;
+	{
+		FScopeLock ScopeLock(&Lock);
+		bFound = CancelLocked(RequestId, ToStart);
+	}
+	StartAll(ToStart);
+	return bFound;
+}
+
+bool FNeoStackBridgeRequests::CancelLocked(const FString& RequestId, FToStartList& ToStart)
+{
+	TUniquePtr<FRequest>* Found = Requests.Find(RequestId);
+	if (!Found)
+	{
+		return false;
+	}
+
+	FRequest& Request = **Found;
+	Request.Token->Cancel();
+
+	// A queued request is started right away, without taking a slot, only to answer as cancelled
+	if (!Request.bRunning)
+	{
+		if (TArray<FString>* Waiting = Queued.Find(Request.Command.Command))
+		{
+			if (Waiting->RemoveSingle(RequestId) > 0)
+			{
+				ToStart.Emplace(Request.Command, MoveTemp(Request.Start));
+			}
+		}
+	}
+	return true;
+}
+
+void FNeoStackBridgeRequests::StartAll(FToStartList& ToStart)
+{
+	for (TPair<FNeoStackCommand, FStartRequest>& Entry : ToStart)
+	{
+		Entry.Value(Entry.Key);
+	}
+}
+
+FNeoStackBridgeRequests::FRequest* FNeoStackBridgeRequests::PopStartable(const FString& Command)
+{
+	TArray<FString>* Waiting = Queued.Find(Command);
+	if (!Waiting || Waiting->Num() == 0)
+	{
+		return nullptr;
+	}
+
+	int32& RunningCount = RunningCounts.FindOrAdd(Command);
+	if (RunningCount >= GetMaxConcurrent(Command))
+	{
+		return nullptr;
+	}
+
+	const FString RequestId = (*Waiting)[0];
+	Waiting->RemoveAt(0);
+
+	FRequest& Request = *Requests.FindChecked(RequestId);
+	Request.bRunning = true;
+	RunningCount++;
+	return &Request;
+}
+
+TSharedPtr<FNeoStackCancellationToken> FNeoStackBridgeRequests::GetToken(const FString& RequestId) const
+{
+	FScopeLock ScopeLock(&Lock);
+	const TUniquePtr<FRequest>* Found = Requests.Find(RequestId);
+	return Found ? TSharedPtr<FNeoStackCancellationToken>((*Found)->Token) : nullptr;
+}
+
+bool FNeoStackBridgeRequests::IsCancelled(const FString& RequestId) const
+{
+	TSharedPtr<FNeoStackCancellationToken> Token = GetToken(RequestId);
+	return Token.IsValid() && Token->IsCancelled();
+}
+
+void FNeoStackBridgeRequests::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	for (const TPair<FString, TUniquePtr<FRequest>>& Entry : Requests)
+	{
+		Entry.Value->Token->Cancel();
+	}
+	Requests.Reset();
+	Queued.Reset();
+	RunningCounts.Reset();
+	LatestBySupersedeKey.Reset();
+}
+
+FNeoStackEvent FNeoStackBridgeRequests::MakeCancelledResponse(const FNeoStackCommand& Command)
+{
+	FNeoStackEvent Response;
+	Response.Event = Command.Command;
+	Response.RequestId = Command.RequestId;
+	Response.bSuccess = false;
+	Response.Error = TEXT("Cancelled");
+
+	// Lets the IDE tell a cancellation from a failure without matching the message
+	Response.Data = MakeShared<FJsonObject>();
+	Response.Data->SetBoolField(TEXT("cancelled"), true);
+	return Response;
+}
+
+bool FNeoStackBridgeRequests::IsCurrentCancelled()
+{
+	return GCurrentToken && GCurrentToken->IsValid() && (*GCurrentToken)->IsCancelled();
+}
+
+FNeoStackBridgeRequests::FScope::FScope(const FString& RequestId)
+	: Token(FNeoStackBridgeRequests::Get().GetToken(RequestId))
+	, Previous(GCurrentToken)
+{
+	GCurrentToken = &Token;
+}
+
+FNeoStackBridgeRequests::FScope::~FScope()
+{
+	GCurrentToken = Previous;
+}
@@ -6,6 +6,15 @@
 #include "IPAddress.h"
 #include "Async/Async.h"
 
+namespace
+{
+	/** Bytes read per Recv; a message larger than this is framed across several reads */
+	constexpr int32 ReceiveChunkSize = 64 * 1024;
+
+	/** Upper bound on how long a thread waits before re-checking for shutdown and closed clients */
+	const FTimespan SocketWaitTimeout = FTimespan::FromSeconds(1.0);
+}
+
 // FAcceptConnectionsRunnable implementation
 FAcceptConnectionsRunnable::FAcceptConnectionsRunnable(FNeoStackBridgeServer* InServer)
 	: Server(InServer)
@@ -25,15 +34,16 @@ void FAcceptConnectionsRunnable::Stop()
 }
 
 // FReceiveDataRunnable implementation
-FReceiveDataRunnable::FReceiveDataRunnable(FNeoStackBridgeServer* InServer)
+FReceiveDataRunnable::FReceiveDataRunnable(FNeoStackBridgeServer* InServer, const FString& InClientId)
 	: Server(InServer)
+	, ClientId(InClientId)
 	, bShouldStop(false)
 {
 }
 
 uint32 FReceiveDataRunnable::Run()
 {
-	Server->ReceiveData();
+	Server->ReceiveData(ClientId);
 	return 0;
 }
 
@@ -47,7 +57,6 @@ FNeoStackBridgeServer::FNeoStackBridgeServer()
 	: ListenSocket(nullptr)
 	, ListenPort(0)
 	, AcceptThread(nullptr)
-	, ReceiveThread(nullptr)
 	, bIsRunning(false)
 {
 }
@@ -113,14 +122,10 @@ bool FNeoStackBridgeServer::Start(int32 Port)
 	ListenPort = Port;
 	bIsRunning = true;
 
-	// Create and start accept thread
+	// Create and start accept thread; each accepted client gets its own receive thread
 	AcceptRunnable = MakeUnique<FAcceptConnectionsRunnable>(this);
 	AcceptThread = FRunnableThread::Create(AcceptRunnable.Get(), TEXT("NeoStackBridge_Accept"));
 
-	// Create and start receive thread
-	ReceiveRunnable = MakeUnique<FReceiveDataRunnable>(this);
-	ReceiveThread = FRunnableThread::Create(ReceiveRunnable.Get(), TEXT("NeoStackBridge_Receive"));
-
 	return true;
 }
 
@@ -128,46 +133,51 @@ void FNeoStackBridgeServer::Stop()
 {
 	bIsRunning = false;
 
-	// Stop threads
+	// Stop the accept thread; the wakeup connection ends its wait right away
 	if (AcceptRunnable.IsValid())
 	{
 		AcceptRunnable->Stop();
 	}
-	if (ReceiveRunnable.IsValid())
-	{
-		ReceiveRunnable->Stop();
-	}
-
-	// Wait for threads to finish
 	if (AcceptThread)
 	{
+		FSocket* WakeupSocket = WakeAcceptThread();
 		AcceptThread->WaitForCompletion();
 		delete AcceptThread;
 		AcceptThread = nullptr;
-	}
-	if (ReceiveThread)
-	{
-		ReceiveThread->WaitForCompletion();
-		delete ReceiveThread;
-		ReceiveThread = nullptr;
-	}
 
-	// Clear runnables
+		if (WakeupSocket)
+		{
+			WakeupSocket->Close();
+			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(WakeupSocket);
+		}
+	}
 	AcceptRunnable.Reset();
-	ReceiveRunnable.Reset();
 
-	// Close all client connections
+	// Take every client out of the map, then release them without holding the lock
+	TArray<TSharedPtr<FClientConnection>> ClientsToRelease;
 	{
 		FScopeLock Lock(&ClientsLock);
-		for (auto& Pair : Clients)
+		Clients.GenerateValueArray(ClientsToRelease);
+		ClientsToRelease.Append(MoveTemp(ClosedClients));
+		Clients.Empty();
+		ClosedClients.Empty();
+	}
+
+	// Shutting the sockets down wakes every receive thread blocked in its wait
+	for (const TSharedPtr<FClientConnection>& Client : ClientsToRelease)
+	{
+		if (Client->ReceiveRunnable.IsValid())
 		{
-			if (Pair.Value->Socket)
-			{
-				Pair.Value->Socket->Close();
-				ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Pair.Value->Socket);
-			}
+			Client->ReceiveRunnable->Stop();
 		}
-		Clients.Empty();
+		if (Client->Socket)
+		{
+			Client->Socket->Shutdown(ESocketShutdownMode::ReadWrite);
+		}
+	}
+	for (const TSharedPtr<FClientConnection>& Client : ClientsToRelease)
+	{
+		ReleaseClient(*Client);
 	}
 
 	// Close listen socket
@@ -181,6 +191,64 @@ void FNeoStackBridgeServer::Stop()
 	ListenPort = 0;
 }
 
+FSocket* FNeoStackBridgeServer::WakeAcceptThread()
+{
+	if (!ListenSocket || ListenPort == 0)
+	{
+		return nullptr;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	FSocket* WakeupSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("NeoStackBridge_Wakeup"), false);
+	if (!WakeupSocket)
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr();
+	Addr->SetLoopbackAddress();
+	Addr->SetPort(ListenPort);
+	if (!WakeupSocket->Connect(*Addr))
+	{
+		// The accept wait still ends at its timeout
+		UE_LOG(LogTemp, Verbose, TEXT("[NeoStackBridge] Wakeup connection failed; accept thread will stop on timeout"));
+	}
+	return WakeupSocket;
+}
+
+void FNeoStackBridgeServer::ReleaseClient(FClientConnection& Client)
+{
+	if (Client.ReceiveThread)
+	{
+		Client.ReceiveThread->WaitForCompletion();
+		delete Client.ReceiveThread;
+		Client.ReceiveThread = nullptr;
+	}
+	Client.ReceiveRunnable.Reset();
+
+	if (Client.Socket)
+	{
+		Client.Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Client.Socket);
+		Client.Socket = nullptr;
+	}
+}
+
+void FNeoStackBridgeServer::ReapClosedClients()
+{
+	TArray<TSharedPtr<FClientConnection>> ClientsToRelease;
+	{
+		FScopeLock Lock(&ClientsLock);
+		ClientsToRelease = MoveTemp(ClosedClients);
+		ClosedClients.Reset();
+	}
+
+	for (const TSharedPtr<FClientConnection>& Client : ClientsToRelease)
+	{
+		ReleaseClient(*Client);
+	}
+}
+
 bool FNeoStackBridgeServer::IsRunning() const
 {
 	return bIsRunning;
@@ -234,134 +302,160 @@ void FNeoStackBridgeServer::AcceptConnections()
 			break;
 		}
 
+		// Blocks until a client connects, Stop() sends the wakeup connection, or the timeout passes
 		bool bPending = false;
-		if (ListenSocket->WaitForPendingConnection(bPending, FTimespan::FromMilliseconds(100)))
+		const bool bWaited = ListenSocket->WaitForPendingConnection(bPending, SocketWaitTimeout);
+
+		// Threads of clients that went away are joined here, off the receive threads themselves
+		ReapClosedClients();
+
+		if (!bIsRunning)
 		{
-			if (bPending)
-			{
-				FSocket* ClientSocket = ListenSocket->Accept(TEXT("NeoStackClient"));
-				if (ClientSocket)
-				{
-					ClientSocket->SetNonBlocking(true);
-
-					TSharedPtr<FClientConnection> NewClient = MakeShareable(new FClientConnection);
-					NewClient->Id = GenerateClientId();
-					NewClient->Socket = ClientSocket;
-
-					TSharedRef<FInternetAddr> RemoteAddr = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
-					ClientSocket->GetPeerAddress(*RemoteAddr);
-					NewClient->Endpoint = FIPv4Endpoint(RemoteAddr);
-
-					{
-						FScopeLock Lock(&ClientsLock);
-						Clients.Add(NewClient->Id, NewClient);
-					}
-
-					// Notify on game thread
-					AsyncTask(ENamedThreads::GameThread, [this, Id = NewClient->Id, Endpoint = NewClient->Endpoint]()
-					{
-						OnClientConnected.ExecuteIfBound(Id, Endpoint);
-					});
-				}
-			}
+			break;
+		}
+		if (!bWaited || !bPending)
+		{
+			continue;
+		}
+
+		FSocket* ClientSocket = ListenSocket->Accept(TEXT("NeoStackClient"));
+		if (!ClientSocket)
+		{
+			continue;
 		}
 
-		FPlatformProcess::Sleep(0.01f);
+		ClientSocket->SetNonBlocking(true);
+
+		TSharedPtr<FClientConnection> NewClient = MakeShareable(new FClientConnection);
+		NewClient->Id = GenerateClientId();
+		NewClient->Socket = ClientSocket;
+
+		TSharedRef<FInternetAddr> RemoteAddr = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
+		ClientSocket->GetPeerAddress(*RemoteAddr);
+		NewClient->Endpoint = FIPv4Endpoint(RemoteAddr);
+
+		{
+			FScopeLock Lock(&ClientsLock);
+			Clients.Add(NewClient->Id, NewClient);
+
+			// Started under the lock so a thread that exits at once finds its entry
+			NewClient->ReceiveRunnable = MakeUnique<FReceiveDataRunnable>(this, NewClient->Id);
+			NewClient->ReceiveThread = FRunnableThread::Create(NewClient->ReceiveRunnable.Get(),
+				*FString::Printf(TEXT("NeoStackBridge_Receive_%s"), *NewClient->Id.Left(8)));
+		}
+
+		// Notify on game thread
+		AsyncTask(ENamedThreads::GameThread, [this, Id = NewClient->Id, Endpoint = NewClient->Endpoint]()
+		{
+			OnClientConnected.ExecuteIfBound(Id, Endpoint);
+		});
 	}
 }
 
-void FNeoStackBridgeServer::ReceiveData()
+void FNeoStackBridgeServer::ReceiveData(const FString& ClientId)
 {
-	TArray<uint8> ReceiveBuffer;
-	ReceiveBuffer.SetNumUninitialized(4096);
-
-	while (bIsRunning)
+	TSharedPtr<FClientConnection> Client;
+	{
+		FScopeLock Lock(&ClientsLock);
+		Client = Clients.FindRef(ClientId);
+	}
+	if (!Client.IsValid() || !Client->Socket)
 	{
-		TArray<FString> DisconnectedClients;
+		return;
+	}
+
+	TArray<uint8> Chunk;
+	Chunk.SetNumUninitialized(ReceiveChunkSize);
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
 
+	bool bConnected = true;
+	while (bIsRunning && bConnected)
+	{
+		// Sleeps in the kernel until data or a close arrives; no lock is held while waiting
+		if (!Client->Socket->Wait(ESocketWaitConditions::WaitForRead, SocketWaitTimeout))
 		{
-			FScopeLock Lock(&ClientsLock);
+			bConnected = Client->Socket->GetConnectionState() == ESocketConnectionState::SCS_Connected;
+			continue;
+		}
 
-			for (auto& Pair : Clients)
+		// Drain everything that is ready before waiting again
+		while (bIsRunning)
+		{
+			int32 BytesRead = 0;
+			if (!Client->Socket->Recv(Chunk.GetData(), Chunk.Num(), BytesRead))
 			{
-				TSharedPtr<FClientConnection>& Client = Pair.Value;
-				if (!Client->Socket)
-				{
-					continue;
-				}
-
-				uint32 PendingDataSize = 0;
-				if (Client->Socket->HasPendingData(PendingDataSize))
-				{
-					int32 BytesRead = 0;
-					if (Client->Socket->Recv(ReceiveBuffer.GetData(), ReceiveBuffer.Num() - 1, BytesRead))
-					{
-						if (BytesRead > 0)
-						{
-							ReceiveBuffer[BytesRead] = 0;
-							FUTF8ToTCHAR Converter((const ANSICHAR*)ReceiveBuffer.GetData());
-							Client->ReceiveBuffer += FString(Converter.Get());
-
-							ProcessReceivedData(Client);
-						}
-					}
-					else
-					{
-						// Connection error
-						DisconnectedClients.Add(Client->Id);
-					}
-				}
-
-				// Check connection state
-				ESocketConnectionState State = Client->Socket->GetConnectionState();
-				if (State != ESocketConnectionState::SCS_Connected)
-				{
-					DisconnectedClients.Add(Client->Id);
-				}
+				bConnected = SocketSubsystem->GetLastErrorCode() == SE_EWOULDBLOCK;
+				break;
+			}
+			if (BytesRead <= 0)
+			{
+				// Readable with nothing to read: the peer closed the connection
+				bConnected = false;
+				break;
 			}
-		}
 
-		// Handle disconnections
-		for (const FString& ClientId : DisconnectedClients)
-		{
-			FScopeLock Lock(&ClientsLock);
-			TSharedPtr<FClientConnection>* ClientPtr = Clients.Find(ClientId);
-			if (ClientPtr)
+			Client->ReceiveBuffer.Append(Chunk.GetData(), BytesRead);
+			ProcessReceivedData(*Client);
+
+			if (BytesRead < Chunk.Num())
 			{
-				if ((*ClientPtr)->Socket)
-				{
-					(*ClientPtr)->Socket->Close();
-					ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket((*ClientPtr)->Socket);
-				}
-				Clients.Remove(ClientId);
-
-				AsyncTask(ENamedThreads::GameThread, [this, ClientId]()
-				{
-					OnOnClientDisconnected.ExecuteIfBound(ClientId);
-				});
+				break;
 			}
 		}
+	}
 
-		FPlatformProcess::Sleep(0.01f);
+	// On Stop() the server releases every client itself
+	if (!bIsRunning)
+	{
+		return;
 	}
+
+	// Hand the connection to the accept thread to be joined and destroyed
+	{
+		FScopeLock Lock(&ClientsLock);
+		if (Clients.Remove(ClientId) == 0)
+		{
+			return;
+		}
+		ClosedClients.Add(Client);
+	}
+
+	AsyncTask(ENamedThreads::GameThread, [this, ClientId]()
+	{
+		OnOnClientDisconnected.ExecuteIfBound(ClientId);
+	});
 }
 
-void FNeoStackBridgeServer::ProcessReceivedData(TSharedPtr<FClientConnection> Client)
+void FNeoStackBridgeServer::ProcessReceivedData(FClientConnection& Client)
 {
-	// Messages are newline-delimited
-	int32 NewlineIndex;
-	while (Client->ReceiveBuffer.FindChar(TEXT('\n'), NewlineIndex))
+	// Messages are newline-delimited. Framing on bytes means a multi-byte UTF-8 character split
+	// across reads is only decoded once its message is complete.
+	TArray<uint8>& Buffer = Client.ReceiveBuffer;
+	int32 MessageStart = 0;
+	for (int32 i = 0; i < Buffer.Num(); i++)
 	{
-		FString Message = Client->ReceiveBuffer.Left(NewlineIndex);
-		Client->ReceiveBuffer = Client->ReceiveBuffer.Mid(NewlineIndex + 1);
+		if (Buffer[i] != '\n')
+		{
+			continue;
+		}
 
-		if (!Message.IsEmpty())
+		const int32 MessageLength = i - MessageStart;
+		if (MessageLength > 0)
 		{
-			AsyncTask(ENamedThreads::GameThread, [this, ClientId = Client->Id, Message]()
+			FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + MessageStart), MessageLength);
+			FString Message(Converter.Length(), Converter.Get());
+
+			AsyncTask(ENamedThreads::GameThread, [this, ClientId = Client.Id, Message = MoveTemp(Message)]()
 			{
 				OnMessageReceived.ExecuteIfBound(ClientId, Message);
 			});
 		}
+		MessageStart = i + 1;
+	}
+
+	if (MessageStart > 0)
+	{
+		Buffer.RemoveAt(0, MessageStart, EAllowShrinking::No);
 	}
 }
 
@@ -0,0 +1,495 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackEventPublisher.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "UObject/Package.h"
+#include "UObject/ObjectSaveContext.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+#include "Dom/JsonObject.h"
+#include "Editor.h"
+
+namespace
+{
+	/** Our own lines would otherwise feed back into the stream they report on */
+	const TCHAR* const OwnLogPrefix = TEXT("[NeoStackBridge]");
+
+	const TCHAR* StatusToString(EBlueprintStatus Status)
+	{
+		switch (Status)
+		{
+		case BS_UpToDate: return TEXT("UpToDate");
+		case BS_UpToDateWithWarnings: return TEXT("UpToDateWithWarnings");
+		case BS_Error: return TEXT("Error");
+		case BS_Dirty: return TEXT("Dirty");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	bool ParseVerbosity(const FString& Name, ELogVerbosity::Type& OutVerbosity)
+	{
+		static const TPair<const TCHAR*, ELogVerbosity::Type> Levels[] = {
+			{ TEXT("Error"), ELogVerbosity::Error },
+			{ TEXT("Warning"), ELogVerbosity::Warning },
+			{ TEXT("Display"), ELogVerbosity::Display },
+			{ TEXT("Log"), ELogVerbosity::Log },
+			{ TEXT("Verbose"), ELogVerbosity::Verbose },
+		};
+		for (const TPair<const TCHAR*, ELogVerbosity::Type>& Level : Levels)
+		{
+			if (Name.Equals(Level.Key, ESearchCase::IgnoreCase))
+			{
+				OutVerbosity = Level.Value;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool ReadStringArray(const TSharedPtr<FJsonObject>& Args, const TCHAR* Field, TArray<FString>& OutValues, FString& OutError)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Values;
+		if (!Args->TryGetArrayField(Field, Values))
+		{
+			return true;
+		}
+		for (const TSharedPtr<FJsonValue>& Value : *Values)
+		{
+			FString String;
+			if (!Value->TryGetString(String))
+			{
+				OutError = FString::Printf(TEXT("'%s' must be an array of strings"), Field);
+				return false;
+			}
+			OutValues.Add(MoveTemp(String));
+		}
+		return true;
+	}
+}
+
+FNeoStackEventPublisher& FNeoStackEventPublisher::Get()
+{
+	static FNeoStackEventPublisher Instance;
+	return Instance;
+}
+
+void FNeoStackEventPublisher::Initialize(FSendEvent&& InSend)
+{
+	check(IsInGameThread());
+	Send = MoveTemp(InSend);
+}
+
+void FNeoStackEventPublisher::Shutdown()
+{
+	check(IsInGameThread());
+
+	UnsubscribeAll();
+	Send = nullptr;
+}
+
+void FNeoStackEventPublisher::UnsubscribeAll()
+{
+	check(IsInGameThread());
+
+	int32 NumRemoved;
+	{
+		FScopeLock ScopeLock(&Lock);
+		NumRemoved = Subscriptions.Num();
+		Subscriptions.Empty();
+		Pending.Empty();
+		DroppedEvents = 0;
+		MaxLogVerbosity = ELogVerbosity::NoLogging;
+	}
+	Unhook();
+
+	if (NumRemoved > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Removed %d event subscription(s)"), NumRemoved);
+	}
+}
+
+bool FNeoStackEventPublisher::ParseSubscription(const TSharedPtr<FJsonObject>& Args, FSubscription& OutSubscription, FString& OutError)
+{
+	if (!Args.IsValid())
+	{
+		return true;
+	}
+
+	TArray<FString> Events;
+	TArray<FString> Classes;
+	if (!ReadStringArray(Args, TEXT("events"), Events, OutError)
+		|| !ReadStringArray(Args, TEXT("paths"), OutSubscription.PathPrefixes, OutError)
+		|| !ReadStringArray(Args, TEXT("classes"), Classes, OutError))
+	{
+		return false;
+	}
+	OutSubscription.Events.Append(Events);
+	OutSubscription.Classes.Append(Classes);
+
+	FString Verbosity;
+	if (Args->TryGetStringField(TEXT("minVerbosity"), Verbosity) && !ParseVerbosity(Verbosity, OutSubscription.MaxVerbosity))
+	{
+		OutError = FString::Printf(TEXT("Unknown verbosity: %s"), *Verbosity);
+		return false;
+	}
+	return true;
+}
+
+FString FNeoStackEventPublisher::Subscribe(FSubscription&& Subscription)
+{
+	check(IsInGameThread());
+
+	FString SubscriptionId;
+	{
+		FScopeLock ScopeLock(&Lock);
+		SubscriptionId = FString::Printf(TEXT("events-%d"), NextSubscriptionId++);
+
+		const bool bWantsLogs = Subscription.Events.Num() == 0 || Subscription.Events.Contains(NeoStackProtocol::MessageType::LogMessage);
+		if (bWantsLogs && Subscription.MaxVerbosity > MaxLogVerbosity)
+		{
+			MaxLogVerbosity = Subscription.MaxVerbosity;
+		}
+		Subscriptions.Add(SubscriptionId, MoveTemp(Subscription));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Event subscription %s added"), *SubscriptionId);
+	Hook();
+	return SubscriptionId;
+}
+
+bool FNeoStackEventPublisher::Unsubscribe(const FString& SubscriptionId)
+{
+	check(IsInGameThread());
+
+	bool bEmpty;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (Subscriptions.Remove(SubscriptionId) == 0)
+		{
+			return false;
+		}
+
+		int32 Verbosity = ELogVerbosity::NoLogging;
+		for (const TPair<FString, FSubscription>& Entry : Subscriptions)
+		{
+			if (Entry.Value.Events.Num() == 0 || Entry.Value.Events.Contains(NeoStackProtocol::MessageType::LogMessage))
+			{
+				Verbosity = FMath::Max<int32>(Verbosity, Entry.Value.MaxVerbosity);
+			}
+		}
+		MaxLogVerbosity = Verbosity;
+
+		bEmpty = Subscriptions.Num() == 0;
+		if (bEmpty)
+		{
+			Pending.Empty();
+			DroppedEvents = 0;
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Event subscription %s removed"), *SubscriptionId);
+	if (bEmpty)
+	{
+		Unhook();
+	}
+	return true;
+}
+
+bool FNeoStackEventPublisher::IsWanted(const FPendingEvent& Event) const
+{
+	const bool bIsLog = Event.Event.Event == NeoStackProtocol::MessageType::LogMessage;
+	for (const TPair<FString, FSubscription>& Entry : Subscriptions)
+	{
+		const FSubscription& Subscription = Entry.Value;
+		if (Subscription.Events.Num() > 0 && !Subscription.Events.Contains(Event.Event.Event))
+		{
+			continue;
+		}
+
+		if (bIsLog)
+		{
+			if (Event.Verbosity <= Subscription.MaxVerbosity)
+			{
+				return true;
+			}
+			continue;
+		}
+
+		if (Subscription.Classes.Num() > 0 && !Subscription.Classes.Contains(Event.Class))
+		{
+			continue;
+		}
+		if (Subscription.PathPrefixes.Num() == 0 || Subscription.PathPrefixes.ContainsByPredicate([&Event](const FString& Prefix)
+		{
+			return Event.Path.StartsWith(Prefix);
+		}))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FNeoStackEventPublisher::Publish(FPendingEvent&& Event)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (!IsWanted(Event))
+	{
+		return;
+	}
+
+	// Only an asset's latest state matters; the queued event keeps its place
+	if (Event.Event.Event == NeoStackProtocol::MessageType::AssetModified)
+	{
+		FPendingEvent* Queued = Pending.FindByPredicate([&Event](const FPendingEvent& Existing)
+		{
+			return Existing.Event.Event == NeoStackProtocol::MessageType::AssetModified && Existing.Path == Event.Path;
+		});
+		if (Queued)
+		{
+			*Queued = MoveTemp(Event);
+			return;
+		}
+	}
+
+	if (Pending.Num() >= MaxPendingEvents)
+	{
+		DroppedEvents++;
+		return;
+	}
+	Pending.Add(MoveTemp(Event));
+}
+
+void FNeoStackEventPublisher::Hook()
+{
+	if (bHooked)
+	{
+		return;
+	}
+	bHooked = true;
+
+	LogDevice = MakeUnique<FLogDevice>(*this);
+	GLog->AddOutputDevice(LogDevice.Get());
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FNeoStackEventPublisher::HandleAssetAdded);
+
+	PackageDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddRaw(this, &FNeoStackEventPublisher::HandlePackageMarkedDirty);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FNeoStackEventPublisher::HandlePackageSaved);
+
+	if (GEditor)
+	{
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FNeoStackEventPublisher::HandleBlueprintPreCompile);
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FNeoStackEventPublisher::HandleBlueprintCompiled);
+	}
+
+	SendBudget = MaxEventsPerSecond;
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FNeoStackEventPublisher::HandleTick));
+}
+
+void FNeoStackEventPublisher::Unhook()
+{
+	if (!bHooked)
+	{
+		return;
+	}
+	bHooked = false;
+
+	if (GLog)
+	{
+		GLog->RemoveOutputDevice(LogDevice.Get());
+	}
+	LogDevice.Reset();
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnAssetAdded().RemoveAll(this);
+	}
+
+	UPackage::PackageMarkedDirtyEvent.Remove(PackageDirtyHandle);
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+
+	Compiling.Empty();
+}
+
+bool FNeoStackEventPublisher::HandleTick(float DeltaTime)
+{
+	SendBudget = FMath::Min(SendBudget + DeltaTime * MaxEventsPerSecond, MaxEventsPerSecond);
+
+	TArray<FPendingEvent> Batch;
+	int32 Dropped;
+	{
+		FScopeLock ScopeLock(&Lock);
+		const int32 NumToSend = FMath::Min(Pending.Num(), FMath::FloorToInt32(SendBudget));
+		if (NumToSend > 0)
+		{
+			Batch.Append(Pending.GetData(), NumToSend);
+			Pending.RemoveAt(0, NumToSend);
+		}
+		Dropped = DroppedEvents;
+		DroppedEvents = 0;
+	}
+	SendBudget -= Batch.Num();
+
+	if (!Send)
+	{
+		return true;
+	}
+
+	for (const FPendingEvent& Event : Batch)
+	{
+		Send(Event.Event);
+	}
+
+	if (Dropped > 0)
+	{
+		// Reported outside the filters: it's about the stream itself
+		FNeoStackEvent Report;
+		Report.Event = NeoStackProtocol::MessageType::LogMessage;
+		Report.bSuccess = true;
+		Report.Data = MakeShared<FJsonObject>();
+		Report.Data->SetStringField(TEXT("message"), FString::Printf(TEXT("%d editor events dropped: more arrived than could be sent"), Dropped));
+		Report.Data->SetStringField(TEXT("category"), TEXT("NeoStackBridge"));
+		Report.Data->SetStringField(TEXT("verbosity"), TEXT("Warning"));
+		Report.Data->SetNumberField(TEXT("dropped"), Dropped);
+		Send(Report);
+	}
+	return true;
+}
+
+void FNeoStackEventPublisher::FLogDevice::Serialize(const TCHAR* Message, ELogVerbosity::Type Verbosity, const FName& Category)
+{
+	Publisher.HandleLog(Message, Verbosity, Category);
+}
+
+void FNeoStackEventPublisher::HandleLog(const TCHAR* Message, ELogVerbosity::Type Verbosity, const FName& Category)
+{
+	const ELogVerbosity::Type Level = static_cast<ELogVerbosity::Type>(Verbosity & ELogVerbosity::VerbosityMask);
+	if (Level > MaxLogVerbosity.load(std::memory_order_relaxed) || FCString::Strstr(Message, OwnLogPrefix))
+	{
+		return;
+	}
+
+	FPendingEvent Event;
+	Event.Event.Event = NeoStackProtocol::MessageType::LogMessage;
+	Event.Event.bSuccess = true;
+	Event.Event.Data = MakeShared<FJsonObject>();
+	Event.Event.Data->SetStringField(TEXT("message"), Message);
+	Event.Event.Data->SetStringField(TEXT("category"), Category.ToString());
+	Event.Event.Data->SetStringField(TEXT("verbosity"), ToString(Level));
+	Event.Verbosity = Level;
+	Publish(MoveTemp(Event));
+}
+
+void FNeoStackEventPublisher::PublishAssetEvent(const FString& EventName, const FString& PackageName, const FString& ClassName, const TCHAR* Reason)
+{
+	FPendingEvent Event;
+	Event.Event.Event = EventName;
+	Event.Event.bSuccess = true;
+	Event.Event.Data = MakeShared<FJsonObject>();
+	Event.Event.Data->SetStringField(TEXT("path"), PackageName);
+	Event.Event.Data->SetStringField(TEXT("class"), ClassName);
+	if (Reason)
+	{
+		Event.Event.Data->SetStringField(TEXT("reason"), Reason);
+	}
+	Event.Path = PackageName;
+	Event.Class = ClassName;
+	Publish(MoveTemp(Event));
+}
+
+void FNeoStackEventPublisher::HandleAssetAdded(const FAssetData& Asset)
+{
+	// The initial discovery reports every asset in the project
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		return;
+	}
+
+	PublishAssetEvent(NeoStackProtocol::MessageType::AssetCreated, Asset.PackageName.ToString(),
+		Asset.AssetClassPath.GetAssetName().ToString(), nullptr);
+}
+
+void FNeoStackEventPublisher::HandlePackageMarkedDirty(UPackage* Package, bool bWasDirty)
+{
+	// Only the first edit since the last save; later ones don't change what the IDE shows
+	if (bWasDirty || !Package || Package == GetTransientPackage() || !FPackageName::IsValidLongPackageName(Package->GetName()))
+	{
+		return;
+	}
+
+	UObject* Asset = Package->FindAssetInPackage();
+	PublishAssetEvent(NeoStackProtocol::MessageType::AssetModified, Package->GetName(),
+		Asset ? Asset->GetClass()->GetName() : FString(), TEXT("dirty"));
+}
+
+void FNeoStackEventPublisher::HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	if (!Package || SaveContext.IsProceduralSave())
+	{
+		return;
+	}
+
+	UObject* Asset = Package->FindAssetInPackage();
+	PublishAssetEvent(NeoStackProtocol::MessageType::AssetModified, Package->GetName(),
+		Asset ? Asset->GetClass()->GetName() : FString(), TEXT("saved"));
+}
+
+void FNeoStackEventPublisher::HandleBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	if (!Blueprint)
+	{
+		return;
+	}
+	Compiling.AddUnique(Blueprint);
+
+	FPendingEvent Event;
+	Event.Event.Event = NeoStackProtocol::MessageType::CompileStarted;
+	Event.Event.bSuccess = true;
+	Event.Event.Data = MakeShared<FJsonObject>();
+	Event.Event.Data->SetStringField(TEXT("path"), Blueprint->GetPackage()->GetName());
+	Event.Event.Data->SetStringField(TEXT("class"), Blueprint->GetClass()->GetName());
+	Event.Path = Blueprint->GetPackage()->GetName();
+	Event.Class = Blueprint->GetClass()->GetName();
+	Publish(MoveTemp(Event));
+}
+
+void FNeoStackEventPublisher::HandleBlueprintCompiled()
+{
+	// Fired once for a whole batch of compiles, without saying which
+	TArray<TWeakObjectPtr<UBlueprint>> Compiled = MoveTemp(Compiling);
+	for (const TWeakObjectPtr<UBlueprint>& WeakBlueprint : Compiled)
+	{
+		UBlueprint* Blueprint = WeakBlueprint.Get();
+		if (!Blueprint)
+		{
+			continue;
+		}
+
+		FPendingEvent Event;
+		Event.Event.Event = NeoStackProtocol::MessageType::CompileFinished;
+		Event.Event.bSuccess = Blueprint->Status != BS_Error;
+		Event.Event.Data = MakeShared<FJsonObject>();
+		Event.Event.Data->SetStringField(TEXT("path"), Blueprint->GetPackage()->GetName());
+		Event.Event.Data->SetStringField(TEXT("class"), Blueprint->GetClass()->GetName());
+		Event.Event.Data->SetStringField(TEXT("status"), StatusToString(Blueprint->Status));
+		Event.Path = Blueprint->GetPackage()->GetName();
+		Event.Class = Blueprint->GetClass()->GetName();
+		Publish(MoveTemp(Event));
+	}
+}
@@ -0,0 +1,597 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackFunctionUsageIndex.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/AssetData.h"
+#include "IO/IoHash.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Event.h"
+#include "K2Node_FunctionEntry.h"
+#include "UObject/Package.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/UObjectHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Editor.h"
+
+namespace
+{
+	/** Bumped whenever the cache file layout or what gets recorded changes */
+	constexpr int32 CacheVersion = 1;
+
+	/** Game thread time spent scanning per tick; at least one Blueprint is scanned each tick */
+	constexpr double ScanBudgetSeconds = 0.005;
+
+	/** Loads between garbage collections in commandlets, so a full build doesn't keep every Blueprint resident */
+	constexpr int32 LoadsPerCollection = 64;
+
+	bool IsBlueprintAsset(const FAssetData& Asset)
+	{
+		return Asset.TagsAndValues.FindTag(FBlueprintTags::ParentClassPath).IsSet();
+	}
+
+	const TCHAR* KindToString(FNeoStackFunctionUsageIndex::EUsageKind Kind)
+	{
+		return Kind == FNeoStackFunctionUsageIndex::EUsageKind::Override ? TEXT("override") : TEXT("call");
+	}
+}
+
+FNeoStackFunctionUsageIndex& FNeoStackFunctionUsageIndex::Get()
+{
+	static FNeoStackFunctionUsageIndex Instance;
+	return Instance;
+}
+
+void FNeoStackFunctionUsageIndex::Initialize()
+{
+	check(IsInGameThread());
+
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	LoadFromDisk();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FNeoStackFunctionUsageIndex::HandleAssetAdded);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FNeoStackFunctionUsageIndex::HandleAssetRemoved);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FNeoStackFunctionUsageIndex::HandleAssetRenamed);
+	AssetRegistry.OnFilesLoaded().AddRaw(this, &FNeoStackFunctionUsageIndex::HandleFilesLoaded);
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FNeoStackFunctionUsageIndex::HandlePackageSaved);
+	AssetLoadedHandle = FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FNeoStackFunctionUsageIndex::HandleAssetLoaded);
+
+	if (!AssetRegistry.IsLoadingAssets())
+	{
+		QueueChangedBlueprints();
+	}
+}
+
+void FNeoStackFunctionUsageIndex::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+		AssetRegistry.OnFilesLoaded().RemoveAll(this);
+	}
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	FCoreUObjectDelegates::OnAssetLoaded.Remove(AssetLoadedHandle);
+
+	if (ScanTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(ScanTickHandle);
+		ScanTickHandle.Reset();
+	}
+
+	// Whatever was scanned is kept; the rest is rescanned next session
+	if (bDirty)
+	{
+		SaveToDisk();
+	}
+
+	Records.Empty();
+	BlueprintsByFunction.Empty();
+	PendingScans.Empty();
+	PendingSet.Empty();
+	UnloadedScans.Empty();
+}
+
+FString FNeoStackFunctionUsageIndex::MakeFunctionKey(const UFunction* Function)
+{
+	// Overrides are separate UFunctions whose super is the declaration
+	while (const UFunction* SuperFunction = Function->GetSuperFunction())
+	{
+		Function = SuperFunction;
+	}
+
+	// Nodes in a Blueprint's own graphs reference its skeleton class
+	const UClass* OwnerClass = Function->GetOwnerClass();
+	const FString OwnerPath = OwnerClass ? OwnerClass->GetAuthoritativeClass()->GetPathName() : Function->GetOuter()->GetPathName();
+	return OwnerPath + TEXT(":") + Function->GetName();
+}
+
+TArray<FNeoStackFunctionUsageIndex::FUsage> FNeoStackFunctionUsageIndex::FindUsages(const FString& FunctionKey) const
+{
+	TArray<FUsage> Usages;
+
+	const TSet<FString>* BlueprintPaths = BlueprintsByFunction.Find(FunctionKey);
+	if (!BlueprintPaths)
+	{
+		return Usages;
+	}
+
+	for (const FString& BlueprintPath : *BlueprintPaths)
+	{
+		for (const FRecordedUsage& Recorded : Records.FindChecked(BlueprintPath).Usages)
+		{
+			if (Recorded.FunctionKey == FunctionKey)
+			{
+				Usages.Add({ BlueprintPath, Recorded.GraphName, Recorded.NodeGuid, Recorded.Kind });
+			}
+		}
+	}
+	return Usages;
+}
+
+bool FNeoStackFunctionUsageIndex::IsScanned(const FString& BlueprintPath) const
+{
+	return Records.Contains(BlueprintPath) && !PendingSet.Contains(BlueprintPath) && !UnloadedScans.Contains(BlueprintPath);
+}
+
+void FNeoStackFunctionUsageIndex::QueueChangedBlueprints()
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	TArray<FAssetData> BlueprintAssets;
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	AssetRegistry.GetAssets(Filter, BlueprintAssets);
+
+	TSet<FString> Existing;
+	Existing.Reserve(BlueprintAssets.Num());
+	for (const FAssetData& Asset : BlueprintAssets)
+	{
+		const FString BlueprintPath = Asset.GetObjectPathString();
+		Existing.Add(BlueprintPath);
+
+		FBlueprintRecord* Record = Records.Find(BlueprintPath);
+		if (!Record)
+		{
+			QueueScan(BlueprintPath);
+			continue;
+		}
+
+		const FDateTime Stamp = GetPackageStamp(BlueprintPath);
+		if (Record->Stamp == Stamp)
+		{
+			continue;
+		}
+
+		// Checkouts stamp files differently; the same contents need no rescan
+		if (!Record->Hash.IsEmpty() && Record->Hash == GetPackageHash(BlueprintPath))
+		{
+			Record->Stamp = Stamp;
+			bDirty = true;
+			continue;
+		}
+		QueueScan(BlueprintPath);
+	}
+
+	TArray<FString> Deleted;
+	for (const auto& Pair : Records)
+	{
+		if (!Existing.Contains(Pair.Key))
+		{
+			Deleted.Add(Pair.Key);
+		}
+	}
+	for (const FString& BlueprintPath : Deleted)
+	{
+		RemoveRecord(BlueprintPath);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Function usage index: %d Blueprints, %d to scan"),
+		BlueprintAssets.Num(), GetNumPending());
+}
+
+bool FNeoStackFunctionUsageIndex::HandleScanTick(float DeltaTime)
+{
+	// Stay out of the way of PIE and the initial registry scan
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.IsLoadingAssets() || (GEditor && GEditor->PlayWorld))
+	{
+		return true;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	while (PendingScans.Num() > 0)
+	{
+		// Most recently queued first, so a just-saved Blueprint doesn't wait behind the backlog
+		const FString BlueprintPath = PendingScans.Pop(EAllowShrinking::No);
+		if (!PendingSet.Remove(BlueprintPath))
+		{
+			continue;
+		}
+
+		// A load can't be time-sliced and stays resident, so only commandlets load for the index
+		UBlueprint* Blueprint = FindObject<UBlueprint>(nullptr, *BlueprintPath);
+		bool bLoaded = false;
+		if (!Blueprint && IsRunningCommandlet())
+		{
+			Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath, nullptr, LOAD_NoWarn);
+			bLoaded = Blueprint != nullptr;
+			if (!Blueprint)
+			{
+				RemoveRecord(BlueprintPath);
+			}
+		}
+		else if (!Blueprint)
+		{
+			UnloadedScans.Add(BlueprintPath);
+		}
+
+		if (Blueprint)
+		{
+			ScanBlueprint(BlueprintPath, Blueprint);
+		}
+
+		if (bLoaded && ++LoadsSinceCollection >= LoadsPerCollection)
+		{
+			// Only the usages are kept, so the scanned Blueprints are unreferenced
+			LoadsSinceCollection = 0;
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		if (FPlatformTime::Seconds() - StartTime >= ScanBudgetSeconds)
+		{
+			return true;
+		}
+	}
+
+	ScanTickHandle.Reset();
+	if (bDirty)
+	{
+		SaveToDisk();
+	}
+	return false;
+}
+
+void FNeoStackFunctionUsageIndex::ScanBlueprint(const FString& BlueprintPath, UBlueprint* Blueprint)
+{
+	FBlueprintRecord Record;
+	Record.Stamp = GetPackageStamp(BlueprintPath);
+	Record.Hash = GetPackageHash(BlueprintPath);
+
+	auto AddUsage = [&Record](const UFunction* Function, const UEdGraph* Graph, const UEdGraphNode* Node, EUsageKind Kind)
+	{
+		if (Function)
+		{
+			Record.Usages.Add({ MakeFunctionKey(Function), Graph->GetName(), Node->NodeGuid, Kind });
+		}
+	};
+
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+	for (const UEdGraph* Graph : Graphs)
+	{
+		if (!Graph)
+		{
+			continue;
+		}
+
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			// Parent calls are call function nodes too
+			if (const UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+			{
+				AddUsage(CallNode->GetTargetFunction(), Graph, Node, EUsageKind::Call);
+			}
+			else if (const UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+			{
+				if (EventNode->bOverrideFunction)
+				{
+					AddUsage(EventNode->FindEventSignatureFunction(), Graph, Node, EUsageKind::Override);
+				}
+			}
+			else if (Node && Node->IsA<UK2Node_FunctionEntry>() && Blueprint->ParentClass)
+			{
+				// A function graph named after an inherited function overrides it
+				AddUsage(Blueprint->ParentClass->FindFunctionByName(Graph->GetFName()), Graph, Node, EUsageKind::Override);
+			}
+		}
+	}
+
+	SetRecord(BlueprintPath, MoveTemp(Record));
+}
+
+void FNeoStackFunctionUsageIndex::SetRecord(const FString& BlueprintPath, FBlueprintRecord&& Record)
+{
+	RemoveRecord(BlueprintPath);
+
+	for (const FRecordedUsage& Usage : Record.Usages)
+	{
+		BlueprintsByFunction.FindOrAdd(Usage.FunctionKey).Add(BlueprintPath);
+	}
+	Records.Add(BlueprintPath, MoveTemp(Record));
+	bDirty = true;
+}
+
+void FNeoStackFunctionUsageIndex::RemoveRecord(const FString& BlueprintPath)
+{
+	FBlueprintRecord Record;
+	if (!Records.RemoveAndCopyValue(BlueprintPath, Record))
+	{
+		return;
+	}
+
+	for (const FRecordedUsage& Usage : Record.Usages)
+	{
+		if (TSet<FString>* BlueprintPaths = BlueprintsByFunction.Find(Usage.FunctionKey))
+		{
+			BlueprintPaths->Remove(BlueprintPath);
+			if (BlueprintPaths->Num() == 0)
+			{
+				BlueprintsByFunction.Remove(Usage.FunctionKey);
+			}
+		}
+	}
+	bDirty = true;
+}
+
+void FNeoStackFunctionUsageIndex::QueueScan(const FString& BlueprintPath)
+{
+	UnloadedScans.Remove(BlueprintPath);
+
+	bool bAlreadyPending = false;
+	PendingSet.Add(BlueprintPath, &bAlreadyPending);
+	if (bAlreadyPending)
+	{
+		// Move it to the front of the queue
+		PendingScans.RemoveSingle(BlueprintPath);
+	}
+	PendingScans.Add(BlueprintPath);
+	EnsureScanTicker();
+}
+
+void FNeoStackFunctionUsageIndex::EnsureScanTicker()
+{
+	if (bInitialized && !ScanTickHandle.IsValid())
+	{
+		ScanTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FNeoStackFunctionUsageIndex::HandleScanTick));
+	}
+}
+
+FDateTime FNeoStackFunctionUsageIndex::GetPackageStamp(const FString& BlueprintPath)
+{
+	FString FilePath;
+	if (!FPackageName::TryConvertLongPackageNameToFilename(FPackageName::ObjectPathToPackageName(BlueprintPath),
+		FilePath, FPackageName::GetAssetPackageExtension()))
+	{
+		return FDateTime::MinValue();
+	}
+	return IFileManager::Get().GetTimeStamp(*FilePath);
+}
+
+FString FNeoStackFunctionUsageIndex::GetPackageHash(const FString& BlueprintPath)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	const TOptional<FAssetPackageData> PackageData =
+		AssetRegistry.GetAssetPackageDataCopy(FName(*FPackageName::ObjectPathToPackageName(BlueprintPath)));
+	if (!PackageData.IsSet() || PackageData->GetPackageSavedHash().IsZero())
+	{
+		return FString();
+	}
+	return LexToString(PackageData->GetPackageSavedHash());
+}
+
+FString FNeoStackFunctionUsageIndex::GetCacheFilePath()
+{
+	return FPaths::ProjectIntermediateDir() / TEXT("NeoStack") / TEXT("FunctionUsages.json");
+}
+
+void FNeoStackFunctionUsageIndex::LoadFromDisk()
+{
+	FString Contents;
+	if (!FFileHelper::LoadFileToString(Contents, *GetCacheFilePath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Contents);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || Root->GetIntegerField(TEXT("version")) != CacheVersion)
+	{
+		UE_LOG(LogTemp, Log, TEXT("[NeoStackBridge] Function usage cache is missing or outdated, rescanning"));
+		return;
+	}
+
+	const TSharedPtr<FJsonObject>* Blueprints;
+	if (!Root->TryGetObjectField(TEXT("blueprints"), Blueprints))
+	{
+		return;
+	}
+
+	for (const auto& Pair : (*Blueprints)->Values)
+	{
+		const TSharedPtr<FJsonObject>* BlueprintObj;
+		if (!Pair.Value->TryGetObject(BlueprintObj))
+		{
+			continue;
+		}
+
+		// Stamps are stored as ticks; text formats round off the file system's precision
+		FBlueprintRecord Record;
+		Record.Stamp = FDateTime(FCString::Atoi64(*(*BlueprintObj)->GetStringField(TEXT("stamp"))));
+		(*BlueprintObj)->TryGetStringField(TEXT("hash"), Record.Hash);
+
+		const TArray<TSharedPtr<FJsonValue>>* UsagesArray;
+		if ((*BlueprintObj)->TryGetArrayField(TEXT("usages"), UsagesArray))
+		{
+			for (const TSharedPtr<FJsonValue>& UsageValue : *UsagesArray)
+			{
+				const TSharedPtr<FJsonObject>* UsageObj;
+				if (!UsageValue->TryGetObject(UsageObj))
+				{
+					continue;
+				}
+
+				FRecordedUsage Usage;
+				Usage.FunctionKey = (*UsageObj)->GetStringField(TEXT("function"));
+				Usage.GraphName = (*UsageObj)->GetStringField(TEXT("graph"));
+				FGuid::Parse((*UsageObj)->GetStringField(TEXT("node")), Usage.NodeGuid);
+				Usage.Kind = (*UsageObj)->GetStringField(TEXT("kind")) == TEXT("override") ? EUsageKind::Override : EUsageKind::Call;
+				Record.Usages.Add(MoveTemp(Usage));
+			}
+		}
+
+		SetRecord(Pair.Key, MoveTemp(Record));
+	}
+
+	bDirty = false;
+}
+
+void FNeoStackFunctionUsageIndex::SaveToDisk()
+{
+	TSharedPtr<FJsonObject> Blueprints = MakeShareable(new FJsonObject());
+	for (const auto& Pair : Records)
+	{
+		// Pending Blueprints are rescanned next session anyway
+		if (PendingSet.Contains(Pair.Key) || UnloadedScans.Contains(Pair.Key))
+		{
+			continue;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> UsagesArray;
+		for (const FRecordedUsage& Usage : Pair.Value.Usages)
+		{
+			TSharedPtr<FJsonObject> UsageObj = MakeShareable(new FJsonObject());
+			UsageObj->SetStringField(TEXT("function"), Usage.FunctionKey);
+			UsageObj->SetStringField(TEXT("graph"), Usage.GraphName);
+			UsageObj->SetStringField(TEXT("node"), Usage.NodeGuid.ToString());
+			UsageObj->SetStringField(TEXT("kind"), KindToString(Usage.Kind));
+			UsagesArray.Add(MakeShareable(new FJsonValueObject(UsageObj)));
+		}
+
+		TSharedPtr<FJsonObject> BlueprintObj = MakeShareable(new FJsonObject());
+		BlueprintObj->SetStringField(TEXT("stamp"), FString::Printf(TEXT("%lld"), Pair.Value.Stamp.GetTicks()));
+		if (!Pair.Value.Hash.IsEmpty())
+		{
+			BlueprintObj->SetStringField(TEXT("hash"), Pair.Value.Hash);
+		}
+		BlueprintObj->SetArrayField(TEXT("usages"), UsagesArray);
+		Blueprints->SetObjectField(Pair.Key, BlueprintObj);
+	}
+
+	TSharedPtr<FJsonObject> Root = MakeShareable(new FJsonObject());
+	Root->SetNumberField(TEXT("version"), CacheVersion);
+	Root->SetObjectField(TEXT("blueprints"), Blueprints);
+
+	FString Contents;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+		TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Contents);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+
+	if (FFileHelper::SaveStringToFile(Contents, *GetCacheFilePath()))
+	{
+		bDirty = false;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Failed to write %s"), *GetCacheFilePath());
+	}
+}
+
+void FNeoStackFunctionUsageIndex::HandleFilesLoaded()
+{
+	QueueChangedBlueprints();
+}
+
+void FNeoStackFunctionUsageIndex::HandleAssetAdded(const FAssetData& Asset)
+{
+	// The initial discovery reports every asset; HandleFilesLoaded covers those
+	IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	if (AssetRegistry.IsLoadingAssets() || !IsBlueprintAsset(Asset))
+	{
+		return;
+	}
+
+	QueueScan(Asset.GetObjectPathString());
+}
+
+void FNeoStackFunctionUsageIndex::HandleAssetRemoved(const FAssetData& Asset)
+{
+	const FString BlueprintPath = Asset.GetObjectPathString();
+	PendingSet.Remove(BlueprintPath);
+	UnloadedScans.Remove(BlueprintPath);
+	RemoveRecord(BlueprintPath);
+}
+
+void FNeoStackFunctionUsageIndex::HandleAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath)
+{
+	if (!IsBlueprintAsset(Asset))
+	{
+		return;
+	}
+
+	PendingSet.Remove(OldObjectPath);
+	UnloadedScans.Remove(OldObjectPath);
+	RemoveRecord(OldObjectPath);
+	QueueScan(Asset.GetObjectPathString());
+}
+
+void FNeoStackFunctionUsageIndex::HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	if (!Package || SaveContext.IsProceduralSave())
+	{
+		return;
+	}
+
+	// The Blueprint is still loaded, so the next tick scans it without touching the disk
+	ForEachObjectWithPackage(Package, [this](UObject* Object)
+	{
+		if (const UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+		{
+			QueueScan(Blueprint->GetPathName());
+			return false;
+		}
+		return true;
+	}, false);
+}
+
+void FNeoStackFunctionUsageIndex::HandleAssetLoaded(UObject* Object)
+{
+	if (UnloadedScans.Num() == 0)
+	{
+		return;
+	}
+
+	if (const UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+	{
+		const FString BlueprintPath = Blueprint->GetPathName();
+		if (UnloadedScans.Contains(BlueprintPath))
+		{
+			QueueScan(BlueprintPath);
+		}
+	}
+}
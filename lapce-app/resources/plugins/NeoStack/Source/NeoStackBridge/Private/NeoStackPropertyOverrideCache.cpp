@@ -0,0 +1,351 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackPropertyOverrideCache.h"
+#include "NeoStackBlueprintIndex.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/Blueprint.h"
+#include "UObject/Package.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UnrealType.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+#include "Editor.h"
+
+namespace
+{
+	/** Game thread time spent diffing loaded Blueprints per tick; at least one is diffed each tick */
+	constexpr double DiffBudgetSeconds = 0.002;
+}
+
+FNeoStackPropertyOverrideCache& FNeoStackPropertyOverrideCache::Get()
+{
+	static FNeoStackPropertyOverrideCache Instance;
+	return Instance;
+}
+
+void FNeoStackPropertyOverrideCache::Initialize()
+{
+	check(IsInGameThread());
+
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FNeoStackPropertyOverrideCache::HandleAssetRemoved);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FNeoStackPropertyOverrideCache::HandleAssetRenamed);
+
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FNeoStackPropertyOverrideCache::HandlePackageSaved);
+	PackageReloadedHandle = FCoreUObjectDelegates::OnPackageReloaded.AddRaw(this, &FNeoStackPropertyOverrideCache::HandlePackageReloaded);
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FNeoStackPropertyOverrideCache::HandleObjectPropertyChanged);
+
+	// Hot reload and Live Coding can change any native default
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+	{
+		InvalidateAll();
+	});
+
+	if (GEditor)
+	{
+		BlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FNeoStackPropertyOverrideCache::HandleBlueprintPreCompile);
+	}
+
+	QueueLoadedBlueprints();
+}
+
+void FNeoStackPropertyOverrideCache::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+	bInitialized = false;
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+	}
+
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	FCoreUObjectDelegates::OnPackageReloaded.Remove(PackageReloadedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	if (GEditor)
+	{
+		GEditor->OnBlueprintPreCompile().Remove(BlueprintPreCompileHandle);
+	}
+
+	if (DiffTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(DiffTickHandle);
+		DiffTickHandle.Reset();
+	}
+
+	Entries.Empty();
+	ChangedAt.Empty();
+	PendingDiffs.Empty();
+}
+
+TSharedPtr<const FNeoStackPropertyOverrideCache::FEntry> FNeoStackPropertyOverrideCache::FindOrCompute(const FString& BlueprintPath)
+{
+	check(IsInGameThread());
+
+	const FString ObjectPath = ToObjectPath(BlueprintPath);
+	if (const TSharedPtr<const FEntry>* Cached = Entries.Find(ObjectPath))
+	{
+		return *Cached;
+	}
+
+	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *ObjectPath);
+	TSharedPtr<const FEntry> Entry = Blueprint ? Compute(Blueprint) : nullptr;
+	if (Entry.IsValid())
+	{
+		Entries.Add(ObjectPath, Entry);
+	}
+	return Entry;
+}
+
+FString FNeoStackPropertyOverrideCache::ToObjectPath(const FString& BlueprintPath)
+{
+	if (BlueprintPath.Contains(TEXT(".")))
+	{
+		return BlueprintPath;
+	}
+	return BlueprintPath + TEXT(".") + FPackageName::GetShortName(BlueprintPath);
+}
+
+TSharedPtr<const FNeoStackPropertyOverrideCache::FEntry> FNeoStackPropertyOverrideCache::Compute(UBlueprint* Blueprint)
+{
+	UClass* GeneratedClass = Blueprint->GeneratedClass;
+	UObject* CDO = GeneratedClass ? GeneratedClass->GetDefaultObject() : nullptr;
+	if (!CDO)
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FEntry> Entry = MakeShared<FEntry>();
+
+	// Against the direct parent, which may be another Blueprint
+	UClass* ParentClass = GeneratedClass->GetSuperClass();
+	UObject* ParentCDO = ParentClass ? ParentClass->GetDefaultObject() : nullptr;
+	if (ParentCDO)
+	{
+		for (TFieldIterator<FProperty> PropIt(ParentClass); PropIt; ++PropIt)
+		{
+			FProperty* Property = *PropIt;
+			const void* CDOValue = Property->ContainerPtrToValuePtr<void>(CDO);
+			const void* ParentCDOValue = Property->ContainerPtrToValuePtr<void>(ParentCDO);
+			if (!Property->Identical(CDOValue, ParentCDOValue))
+			{
+				FDirectOverride& Override = Entry->DirectOverrides.AddDefaulted_GetRef();
+				Override.Property = Property->GetName();
+				Property->ExportTextItem_Direct(Override.DefaultValue, ParentCDOValue, nullptr, nullptr, PPF_None);
+				Property->ExportTextItem_Direct(Override.BlueprintValue, CDOValue, nullptr, nullptr, PPF_None);
+			}
+		}
+	}
+
+	// Against the closest native class, so queries on any native ancestor can be answered
+	// without the Blueprint parents in between
+	UClass* NativeParent = ParentClass;
+	while (NativeParent && NativeParent->HasAnyClassFlags(CLASS_CompiledFromBlueprint))
+	{
+		NativeParent = NativeParent->GetSuperClass();
+	}
+	UObject* NativeCDO = NativeParent ? NativeParent->GetDefaultObject() : nullptr;
+	if (NativeCDO)
+	{
+		Entry->NativeParent = NativeParent;
+		for (TFieldIterator<FProperty> PropIt(NativeParent); PropIt; ++PropIt)
+		{
+			FProperty* Property = *PropIt;
+			const void* CDOValue = Property->ContainerPtrToValuePtr<void>(CDO);
+			if (!Property->Identical(CDOValue, Property->ContainerPtrToValuePtr<void>(NativeCDO)))
+			{
+				FString Value;
+				Property->ExportTextItem_Direct(Value, CDOValue, nullptr, nullptr, PPF_None);
+				Entry->NativeOverrides.Add(Property->GetFName(), MoveTemp(Value));
+			}
+		}
+	}
+
+	return Entry;
+}
+
+uint64 FNeoStackPropertyOverrideCache::GetChangeGeneration(const FString& ObjectPath) const
+{
+	const uint64* Changed = ChangedAt.Find(ObjectPath);
+	return Changed ? FMath::Max(*Changed, ClearedGeneration) : ClearedGeneration;
+}
+
+void FNeoStackPropertyOverrideCache::MarkChanged(const FString& ObjectPath, uint64 Generation)
+{
+	ChangedAt.Add(ObjectPath, Generation);
+	LatestGeneration = Generation;
+}
+
+void FNeoStackPropertyOverrideCache::Invalidate(UBlueprint* Blueprint)
+{
+	const uint64 Generation = FNeoStackBlueprintIndex::AllocateGeneration();
+	const FString ObjectPath = Blueprint->GetPathName();
+	Entries.Remove(ObjectPath);
+	MarkChanged(ObjectPath, Generation);
+	QueueDiff(Blueprint);
+
+	// Descendants inherit its values, so their diffs against it change too
+	FNeoStackBlueprintIndex::FSnapshotPtr Snapshot = FNeoStackBlueprintIndex::Get().GetSnapshot();
+	if (Snapshot.IsValid() && Blueprint->GeneratedClass)
+	{
+		Snapshot->ForEachDerivedBlueprint(Blueprint->GeneratedClass->GetPathName(), [this, Generation](const FNeoStackBlueprintIndex::FBlueprintEntry& Derived, int32)
+		{
+			MarkChanged(Derived.ObjectPath, Generation);
+			if (Entries.Remove(Derived.ObjectPath) > 0)
+			{
+				if (UBlueprint* Loaded = FindObject<UBlueprint>(nullptr, *Derived.ObjectPath))
+				{
+					QueueDiff(Loaded);
+				}
+			}
+		});
+	}
+}
+
+void FNeoStackPropertyOverrideCache::InvalidateAll()
+{
+	ClearedGeneration = FNeoStackBlueprintIndex::AllocateGeneration();
+	LatestGeneration = ClearedGeneration;
+	Entries.Empty();
+	ChangedAt.Empty();
+	QueueLoadedBlueprints();
+}
+
+void FNeoStackPropertyOverrideCache::QueueLoadedBlueprints()
+{
+	for (TObjectIterator<UBlueprint> It; It; ++It)
+	{
+		QueueDiff(*It);
+	}
+}
+
+void FNeoStackPropertyOverrideCache::QueueDiff(UBlueprint* Blueprint)
+{
+	// Only assets; transient Blueprints (previews, reinstancing leftovers) are never queried
+	if (!bInitialized || !Blueprint->IsAsset())
+	{
+		return;
+	}
+
+	PendingDiffs.Add(Blueprint);
+	if (!DiffTickHandle.IsValid())
+	{
+		DiffTickHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FNeoStackPropertyOverrideCache::HandleDiffTick));
+	}
+}
+
+bool FNeoStackPropertyOverrideCache::HandleDiffTick(float DeltaTime)
+{
+	if (GEditor && GEditor->PlayWorld)
+	{
+		return true;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	while (PendingDiffs.Num() > 0)
+	{
+		UBlueprint* Blueprint = PendingDiffs.Pop(EAllowShrinking::No).Get();
+		if (!Blueprint || Blueprint->bBeingCompiled)
+		{
+			continue;
+		}
+
+		const FString ObjectPath = Blueprint->GetPathName();
+		if (!Entries.Contains(ObjectPath))
+		{
+			if (TSharedPtr<const FEntry> Entry = Compute(Blueprint))
+			{
+				Entries.Add(ObjectPath, Entry);
+			}
+		}
+
+		if (FPlatformTime::Seconds() - StartTime >= DiffBudgetSeconds)
+		{
+			return true;
+		}
+	}
+
+	DiffTickHandle.Reset();
+	return false;
+}
+
+void FNeoStackPropertyOverrideCache::HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext)
+{
+	if (!Package || SaveContext.IsProceduralSave())
+	{
+		return;
+	}
+
+	ForEachObjectWithPackage(Package, [this](UObject* Object)
+	{
+		if (UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+		{
+			Invalidate(Blueprint);
+			return false;
+		}
+		return true;
+	}, false);
+}
+
+void FNeoStackPropertyOverrideCache::HandlePackageReloaded(EPackageReloadPhase Phase, FPackageReloadedEvent* Event)
+{
+	// Reloads repoint objects wholesale; rare enough to start over
+	if (Phase == EPackageReloadPhase::PostBatchPostGC)
+	{
+		InvalidateAll();
+	}
+}
+
+void FNeoStackPropertyOverrideCache::HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// Edits in a Blueprint's Class Defaults change its CDO without a compile
+	if (!Object || !Object->HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	if (UBlueprint* Blueprint = UBlueprint::GetBlueprintFromClass(Object->GetClass()))
+	{
+		Invalidate(Blueprint);
+	}
+}
+
+void FNeoStackPropertyOverrideCache::HandleBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	if (Blueprint)
+	{
+		Invalidate(Blueprint);
+	}
+}
+
+void FNeoStackPropertyOverrideCache::HandleAssetRemoved(const FAssetData& Asset)
+{
+	if (Entries.Remove(Asset.GetObjectPathString()) > 0)
+	{
+		MarkChanged(Asset.GetObjectPathString(), FNeoStackBlueprintIndex::AllocateGeneration());
+	}
+}
+
+void FNeoStackPropertyOverrideCache::HandleAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath)
+{
+	// The loaded Blueprint moved with it; the next query diffs it under its new path
+	if (Entries.Remove(OldObjectPath) > 0)
+	{
+		MarkChanged(OldObjectPath, FNeoStackBlueprintIndex::AllocateGeneration());
+	}
+}
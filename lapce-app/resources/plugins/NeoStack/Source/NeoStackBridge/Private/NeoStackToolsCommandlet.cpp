@@ -0,0 +1,636 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#include "NeoStackToolsCommandlet.h"
+#include "NeoStackBridgeCommands.h"
+#include "NeoStackBridgeProtocol.h"
+#include "NeoStackBlueprintIndex.h"
+#include "NeoStackFunctionUsageIndex.h"
+#include "NeoStackPropertyOverrideCache.h"
+#include "NeoStackIndexArtifacts.h"
+#include "NeoStackProjectCatalog.h"
+#include "Tools/CodeSearchIndex.h"
+#include "Tools/NeoStackToolRegistry.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Containers/Ticker.h"
+#include "FileHelpers.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/SavePackage.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	constexpr int32 ExitSucceeded = 0;
+	constexpr int32 ExitCallsFailed = 1;
+	constexpr int32 ExitError = 2;
+
+	/** A script line, expanded to one asset when it has forEachAsset */
+	struct FToolCall
+	{
+		/** Position in the expanded script; results are merged in this order */
+		int32 Index = 0;
+		FString Id;
+		FString Tool;
+		FString Command;
+		FString Asset;
+		TSharedPtr<FJsonObject> Args;
+	};
+
+	FString ToCondensedJson(const TSharedRef<FJsonObject>& Object)
+	{
+		FString Json;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+		FJsonSerializer::Serialize(Object, Writer);
+		return Json;
+	}
+
+	/** Copy of Value with every placeholder in its strings replaced */
+	TSharedPtr<FJsonValue> Substitute(const TSharedPtr<FJsonValue>& Value, const TMap<FString, FString>& Replacements)
+	{
+		switch (Value->Type)
+		{
+		case EJson::String:
+		{
+			FString String = Value->AsString();
+			for (const TPair<FString, FString>& Replacement : Replacements)
+			{
+				String.ReplaceInline(*Replacement.Key, *Replacement.Value, ESearchCase::CaseSensitive);
+			}
+			return MakeShared<FJsonValueString>(String);
+		}
+		case EJson::Array:
+		{
+			TArray<TSharedPtr<FJsonValue>> Items;
+			for (const TSharedPtr<FJsonValue>& Item : Value->AsArray())
+			{
+				Items.Add(Substitute(Item, Replacements));
+			}
+			return MakeShared<FJsonValueArray>(Items);
+		}
+		case EJson::Object:
+		{
+			TSharedPtr<FJsonObject> Object = MakeShared<FJsonObject>();
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Value->AsObject()->Values)
+			{
+				Object->SetField(Field.Key, Substitute(Field.Value, Replacements));
+			}
+			return MakeShared<FJsonValueObject>(Object);
+		}
+		default:
+			return Value;
+		}
+	}
+
+	/** Assets a forEachAsset object selects, sorted by object path so every shard sees the same order */
+	TArray<FAssetData> SelectAssets(const FJsonObject& ForEach)
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+		FARFilter Filter;
+		Filter.PackagePaths.Add(FName(*ForEach.GetStringField(TEXT("path"))));
+		Filter.bRecursivePaths = true;
+		ForEach.TryGetBoolField(TEXT("recursive"), Filter.bRecursivePaths);
+
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssets(Filter, Assets);
+
+		FString ClassName;
+		if (ForEach.TryGetStringField(TEXT("class"), ClassName) && !ClassName.IsEmpty())
+		{
+			Assets.RemoveAll([&ClassName](const FAssetData& Asset)
+			{
+				return Asset.AssetClassPath.GetAssetName().ToString() != ClassName;
+			});
+		}
+
+		Assets.Sort([](const FAssetData& A, const FAssetData& B)
+		{
+			return A.GetObjectPathString() < B.GetObjectPathString();
+		});
+		return Assets;
+	}
+
+	bool LoadScript(const FString& ScriptFile, TArray<FToolCall>& OutCalls, FString& OutError)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *ScriptFile))
+		{
+			OutError = FString::Printf(TEXT("Can't read script %s"), *ScriptFile);
+			return false;
+		}
+
+		for (int32 LineIndex = 0; LineIndex < Lines.Num(); LineIndex++)
+		{
+			const FString Line = Lines[LineIndex].TrimStartAndEnd();
+			if (Line.IsEmpty() || Line.StartsWith(TEXT("#")) || Line.StartsWith(TEXT("//")))
+			{
+				continue;
+			}
+
+			TSharedPtr<FJsonObject> Entry;
+			if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Line), Entry) || !Entry.IsValid())
+			{
+				OutError = FString::Printf(TEXT("Line %d is not a JSON object"), LineIndex + 1);
+				return false;
+			}
+
+			FToolCall Call;
+			Entry->TryGetStringField(TEXT("id"), Call.Id);
+			Entry->TryGetStringField(TEXT("tool"), Call.Tool);
+			Entry->TryGetStringField(TEXT("command"), Call.Command);
+			if (Call.Tool.IsEmpty() == Call.Command.IsEmpty())
+			{
+				OutError = FString::Printf(TEXT("Line %d needs exactly one of 'tool' and 'command'"), LineIndex + 1);
+				return false;
+			}
+
+			const TSharedPtr<FJsonObject>* Args;
+			Call.Args = Entry->TryGetObjectField(TEXT("args"), Args) ? *Args : MakeShared<FJsonObject>();
+
+			const TSharedPtr<FJsonObject>* ForEach;
+			if (!Entry->TryGetObjectField(TEXT("forEachAsset"), ForEach))
+			{
+				Call.Index = OutCalls.Num();
+				OutCalls.Add(MoveTemp(Call));
+				continue;
+			}
+
+			if (!(*ForEach)->HasTypedField<EJson::String>(TEXT("path")))
+			{
+				OutError = FString::Printf(TEXT("Line %d: forEachAsset needs a 'path'"), LineIndex + 1);
+				return false;
+			}
+
+			const TSharedRef<FJsonValueObject> ArgsValue = MakeShared<FJsonValueObject>(Call.Args);
+			for (const FAssetData& Asset : SelectAssets(**ForEach))
+			{
+				TMap<FString, FString> Replacements;
+				Replacements.Add(TEXT("{asset}"), Asset.GetObjectPathString());
+				Replacements.Add(TEXT("{package}"), Asset.PackageName.ToString());
+
+				FToolCall& Expanded = OutCalls.Add_GetRef(Call);
+				Expanded.Index = OutCalls.Num() - 1;
+				Expanded.Asset = Asset.GetObjectPathString();
+				Expanded.Args = Substitute(ArgsValue, Replacements)->AsObject();
+			}
+		}
+		return true;
+	}
+
+	/** Scan every Blueprint the function usage index has no current record of */
+	void BuildFunctionUsages()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		FNeoStackFunctionUsageIndex& UsageIndex = FNeoStackFunctionUsageIndex::Get();
+		while (UsageIndex.GetNumPending() > 0)
+		{
+			FTSTicker::GetCoreTicker().Tick(0.0f);
+		}
+		UE_LOG(LogTemp, Display, TEXT("[NeoStackBridge] Function usage index built in %.1f s"), FPlatformTime::Seconds() - StartTime);
+	}
+
+	/** Bridge command handlers answer from these; the commandlet has nothing else ticking them */
+	void InitializeIndexes(const TArray<FToolCall>& Calls)
+	{
+		FNeoStackBlueprintIndex::Get().Initialize();
+		FNeoStackPropertyOverrideCache::Get().Initialize();
+		FNeoStackFunctionUsageIndex::Get().Initialize();
+
+		const bool bNeedsUsages = Calls.ContainsByPredicate([](const FToolCall& Call)
+		{
+			return Call.Command == NeoStackProtocol::MessageType::FindBlueprintFunctionUsages;
+		});
+		if (bNeedsUsages)
+		{
+			// Scan every Blueprint now rather than answering with pendingBlueprints
+			BuildFunctionUsages();
+		}
+	}
+
+	void ShutdownIndexes()
+	{
+		FNeoStackFunctionUsageIndex::Get().Shutdown();
+		FNeoStackPropertyOverrideCache::Get().Shutdown();
+		FNeoStackBlueprintIndex::Get().Shutdown();
+	}
+
+	TSharedRef<FJsonObject> RunCall(const FToolCall& Call)
+	{
+		TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+		Result->SetNumberField(TEXT("index"), Call.Index);
+		if (!Call.Id.IsEmpty())
+		{
+			Result->SetStringField(TEXT("id"), Call.Id);
+		}
+		if (!Call.Asset.IsEmpty())
+		{
+			Result->SetStringField(TEXT("asset"), Call.Asset);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		if (!Call.Tool.IsEmpty())
+		{
+			Result->SetStringField(TEXT("tool"), Call.Tool);
+
+			const FToolResult ToolResult = FNeoStackToolRegistry::Get().Execute(Call.Tool, Call.Args);
+			Result->SetBoolField(TEXT("success"), ToolResult.bSuccess);
+			Result->SetStringField(ToolResult.bSuccess ? TEXT("output") : TEXT("error"), ToolResult.Output);
+		}
+		else
+		{
+			Result->SetStringField(TEXT("command"), Call.Command);
+
+			FNeoStackCommand Command;
+			Command.Command = Call.Command;
+			Command.RequestId = FString::FromInt(Call.Index);
+			Command.Args = Call.Args;
+
+			const FNeoStackEvent Response = FNeoStackBridgeCommands::ProcessCommand(Command);
+			Result->SetBoolField(TEXT("success"), Response.bSuccess);
+			if (Response.Data.IsValid())
+			{
+				Result->SetObjectField(TEXT("data"), Response.Data);
+			}
+			if (!Response.Error.IsEmpty())
+			{
+				Result->SetStringField(TEXT("error"), Response.Error);
+			}
+		}
+		Result->SetNumberField(TEXT("durationMs"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		return Result;
+	}
+
+	/**
+	 * Shard each call runs in
+	 * Mutating tool calls, and every call touching a resource one of them touches, go to shard 0
+	 * so they keep their script order in one process; the rest are dealt round-robin. A mutating
+	 * call that reports no resources may touch anything, so the whole script then runs in shard 0.
+	 * Every child computes the same assignment from the same script.
+	 */
+	TArray<int32> AssignShards(const TArray<FToolCall>& Calls, int32 NumShards)
+	{
+		TArray<int32> Shards;
+		Shards.Init(0, Calls.Num());
+		if (NumShards <= 1)
+		{
+			return Shards;
+		}
+
+		FNeoStackToolRegistry& Registry = FNeoStackToolRegistry::Get();
+		TArray<TArray<FString>> Resources;
+		Resources.SetNum(Calls.Num());
+		TArray<bool> Mutates;
+		Mutates.Init(false, Calls.Num());
+		TSet<FString> Mutated;
+		for (int32 Index = 0; Index < Calls.Num(); Index++)
+		{
+			const FNeoStackToolBase* Tool = Calls[Index].Tool.IsEmpty() ? nullptr : Registry.GetTool(Calls[Index].Tool);
+			if (!Tool)
+			{
+				continue;
+			}
+
+			Tool->GetTouchedResources(Calls[Index].Args, Resources[Index]);
+			if (!Tool->IsReadOnly())
+			{
+				if (Resources[Index].Num() == 0)
+				{
+					UE_LOG(LogTemp, Display, TEXT("[NeoStackBridge] Call %d (%s) may touch anything; running the script in one worker"), Index, *Calls[Index].Tool);
+					return Shards;
+				}
+				Mutates[Index] = true;
+				Mutated.Append(Resources[Index]);
+			}
+		}
+
+		int32 NextShard = 0;
+		for (int32 Index = 0; Index < Calls.Num(); Index++)
+		{
+			const bool bSerial = Mutates[Index] || Resources[Index].ContainsByPredicate([&Mutated](const FString& Key)
+			{
+				return Mutated.Contains(Key);
+			});
+			if (!bSerial)
+			{
+				Shards[Index] = NextShard;
+				NextShard = (NextShard + 1) % NumShards;
+			}
+		}
+		return Shards;
+	}
+
+	/** Save every dirty content package; returns the number that failed */
+	int32 SaveDirtyPackages()
+	{
+		TArray<UPackage*> DirtyPackages;
+		FEditorFileUtils::GetDirtyContentPackages(DirtyPackages);
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError;
+		SaveArgs.Error = GWarn;
+
+		int32 NumFailed = 0;
+		for (UPackage* Package : DirtyPackages)
+		{
+			const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(),
+				Package->ContainsMap() ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension());
+			if (!UPackage::SavePackage(Package, nullptr, *Filename, SaveArgs))
+			{
+				UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] Failed to save %s"), *Package->GetName());
+				NumFailed++;
+			}
+		}
+		UE_LOG(LogTemp, Display, TEXT("[NeoStackBridge] Saved %d of %d dirty packages"), DirtyPackages.Num() - NumFailed, DirtyPackages.Num());
+		return NumFailed;
+	}
+
+	/** Run the calls AssignShards gives Shard, save what they changed if bSave, and write the results to OutFile */
+	int32 RunShard(const TArray<FToolCall>& Calls, int32 Shard, int32 NumShards, bool bSave, const FString& OutFile)
+	{
+		InitializeIndexes(Calls);
+
+		const TArray<int32> Shards = AssignShards(Calls, NumShards);
+		FString Output;
+		int32 NumRun = 0;
+		int32 NumFailed = 0;
+		for (int32 Index = 0; Index < Calls.Num(); Index++)
+		{
+			if (Shards[Index] != Shard)
+			{
+				continue;
+			}
+
+			const TSharedRef<FJsonObject> Result = RunCall(Calls[Index]);
+			Output += ToCondensedJson(Result);
+			Output += TEXT("\n");
+
+			NumRun++;
+			if (!Result->GetBoolField(TEXT("success")))
+			{
+				NumFailed++;
+				FString Error;
+				Result->TryGetStringField(TEXT("error"), Error);
+				UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Call %d failed: %s"), Index, *Error.Left(300));
+			}
+		}
+
+		ShutdownIndexes();
+
+		int32 NumSaveFailures = 0;
+		if (bSave)
+		{
+			NumSaveFailures = SaveDirtyPackages();
+		}
+		else
+		{
+			TArray<UPackage*> DirtyPackages;
+			FEditorFileUtils::GetDirtyContentPackages(DirtyPackages);
+			if (DirtyPackages.Num() > 0)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] %d packages were modified but not saved; pass -save to keep the changes"), DirtyPackages.Num());
+			}
+		}
+
+		if (!FFileHelper::SaveStringToFile(Output, *OutFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] Can't write %s"), *OutFile);
+			return ExitError;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("[NeoStackBridge] Shard %d/%d: %d calls, %d failed"), Shard, NumShards, NumRun, NumFailed);
+		if (NumSaveFailures > 0)
+		{
+			return ExitError;
+		}
+		return NumFailed > 0 ? ExitCallsFailed : ExitSucceeded;
+	}
+
+	/**
+	 * Bring the shareable indexes up to date and publish them to SharedDir
+	 * Starts from whatever Intermediate/NeoStack holds (pulled at startup or left by the
+	 * previous run), so a CI machine that keeps its workspace only re-reads what changed.
+	 */
+	int32 PublishIndexes(const FString& SharedDir)
+	{
+		if (SharedDir.IsEmpty())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] -publishIndexes needs a directory (-publishIndexes=Dir or the Shared Index Path setting)"));
+			return ExitError;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		FNeoStackProjectCatalog::Get().EnsureBuilt();
+		FCodeSearchIndex::Get().Prebuild(FPaths::ProjectDir());
+		FNeoStackFunctionUsageIndex::Get().Initialize();
+		BuildFunctionUsages();
+
+		// Each index writes its pending save on shutdown
+		FNeoStackFunctionUsageIndex::Get().Shutdown();
+		FCodeSearchIndex::Get().Shutdown();
+		FNeoStackProjectCatalog::Get().Shutdown();
+		UE_LOG(LogTemp, Display, TEXT("[NeoStackBridge] Indexes built in %.1f s"), FPlatformTime::Seconds() - StartTime);
+
+		return FNeoStackIndexArtifacts::Publish(SharedDir) > 0 ? ExitSucceeded : ExitError;
+	}
+
+	/** This process's command line for a child running one shard */
+	FString MakeShardCommandLine(int32 Shard, int32 NumShards, const FString& ShardFile)
+	{
+		FString CommandLine;
+		const TCHAR* Remaining = FCommandLine::Get();
+		FString Token;
+		while (FParse::Token(Remaining, Token, false))
+		{
+			if (Token.StartsWith(TEXT("-workers="), ESearchCase::IgnoreCase)
+				|| Token.StartsWith(TEXT("-shard="), ESearchCase::IgnoreCase)
+				|| Token.StartsWith(TEXT("-out="), ESearchCase::IgnoreCase))
+			{
+				continue;
+			}
+
+			// The tokenizer drops quotes; -key=value with spaces gets them back around the value
+			int32 EqualsIndex;
+			if (Token.Contains(TEXT(" ")) && Token.FindChar(TEXT('='), EqualsIndex))
+			{
+				Token = Token.Left(EqualsIndex + 1) + TEXT("\"") + Token.Mid(EqualsIndex + 1) + TEXT("\"");
+			}
+			else if (Token.Contains(TEXT(" ")))
+			{
+				Token = TEXT("\"") + Token + TEXT("\"");
+			}
+			CommandLine += Token + TEXT(" ");
+		}
+		return CommandLine + FString::Printf(TEXT("-shard=%d/%d -out=\"%s\""), Shard, NumShards, *ShardFile);
+	}
+
+	/** Run the script in NumWorkers child processes and merge their results into OutFile */
+	int32 RunWorkers(int32 NumWorkers, const FString& OutFile)
+	{
+		const FString ShardDir = FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("ToolShards");
+		IFileManager::Get().MakeDirectory(*ShardDir, true);
+
+		TArray<FProcHandle> Workers;
+		TArray<FString> ShardFiles;
+		for (int32 Shard = 0; Shard < NumWorkers; Shard++)
+		{
+			const FString ShardFile = FPaths::ConvertRelativePathToFull(ShardDir / FString::Printf(TEXT("shard_%d.jsonl"), Shard));
+			IFileManager::Get().Delete(*ShardFile, false, true, true);
+			ShardFiles.Add(ShardFile);
+
+			const FString CommandLine = MakeShardCommandLine(Shard, NumWorkers, ShardFile);
+			FProcHandle Worker = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *CommandLine,
+				false, true, true, nullptr, 0, nullptr, nullptr);
+			if (!Worker.IsValid())
+			{
+				UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] Failed to start worker %d"), Shard);
+				for (FProcHandle& Started : Workers)
+				{
+					FPlatformProcess::TerminateProc(Started, true);
+					FPlatformProcess::CloseProc(Started);
+				}
+				return ExitError;
+			}
+			Workers.Add(Worker);
+		}
+		UE_LOG(LogTemp, Display, TEXT("[NeoStackBridge] Started %d workers"), NumWorkers);
+
+		int32 ExitCode = ExitSucceeded;
+		for (int32 Shard = 0; Shard < Workers.Num(); Shard++)
+		{
+			FPlatformProcess::WaitForProc(Workers[Shard]);
+			int32 ReturnCode = ExitError;
+			FPlatformProcess::GetProcReturnCode(Workers[Shard], &ReturnCode);
+			FPlatformProcess::CloseProc(Workers[Shard]);
+
+			if (ReturnCode != ExitSucceeded)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[NeoStackBridge] Worker %d exited with %d"), Shard, ReturnCode);
+				ExitCode = FMath::Max(ExitCode, ReturnCode == ExitCallsFailed ? ExitCallsFailed : ExitError);
+			}
+		}
+
+		// Shards hold interleaved calls, so ordering by index restores the script order
+		TArray<TPair<int32, FString>> Results;
+		for (const FString& ShardFile : ShardFiles)
+		{
+			TArray<FString> Lines;
+			if (!FFileHelper::LoadFileToStringArray(Lines, *ShardFile))
+			{
+				UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] Missing worker results %s"), *ShardFile);
+				ExitCode = ExitError;
+				continue;
+			}
+			for (FString& Line : Lines)
+			{
+				TSharedPtr<FJsonObject> Result;
+				if (!Line.IsEmpty() && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Line), Result) && Result.IsValid())
+				{
+					Results.Emplace(static_cast<int32>(Result->GetNumberField(TEXT("index"))), MoveTemp(Line));
+				}
+			}
+		}
+		Results.Sort([](const TPair<int32, FString>& A, const TPair<int32, FString>& B)
+		{
+			return A.Key < B.Key;
+		});
+
+		FString Output;
+		for (const TPair<int32, FString>& Result : Results)
+		{
+			Output += Result.Value;
+			Output += TEXT("\n");
+		}
+		if (!FFileHelper::SaveStringToFile(Output, *OutFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] Can't write %s"), *OutFile);
+			return ExitError;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("[NeoStackBridge] Merged %d results from %d workers into %s"), Results.Num(), NumWorkers, *OutFile);
+		return ExitCode;
+	}
+}
+
+UNeoStackToolsCommandlet::UNeoStackToolsCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UNeoStackToolsCommandlet::Main(const FString& Params)
+{
+	FString SharedRoot;
+	if (FParse::Value(*Params, TEXT("-publishIndexes="), SharedRoot) || FParse::Param(*Params, TEXT("publishIndexes")))
+	{
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().SearchAllAssets(true);
+		return PublishIndexes(FNeoStackIndexArtifacts::GetSharedDir(SharedRoot));
+	}
+
+	FString ScriptFile;
+	if (!FParse::Value(*Params, TEXT("-script="), ScriptFile))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] Usage: -run=NeoStackTools -script=Calls.jsonl [-out=Results.jsonl] [-workers=N] [-save] | -publishIndexes[=Dir]"));
+		return ExitError;
+	}
+
+	FString OutFile;
+	if (!FParse::Value(*Params, TEXT("-out="), OutFile))
+	{
+		OutFile = FPaths::ProjectSavedDir() / TEXT("NeoStack") / TEXT("tools_results.jsonl");
+	}
+
+	int32 NumWorkers = 1;
+	FParse::Value(*Params, TEXT("-workers="), NumWorkers);
+	NumWorkers = FMath::Clamp(NumWorkers, 1, 64);
+
+	int32 Shard = 0;
+	int32 NumShards = 1;
+	FString ShardSpec;
+	if (FParse::Value(*Params, TEXT("-shard="), ShardSpec))
+	{
+		FString ShardText, NumShardsText;
+		if (!ShardSpec.Split(TEXT("/"), &ShardText, &NumShardsText) || !ShardText.IsNumeric() || !NumShardsText.IsNumeric())
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] -shard must be I/N, got %s"), *ShardSpec);
+			return ExitError;
+		}
+		Shard = FCString::Atoi(*ShardText);
+		NumShards = FCString::Atoi(*NumShardsText);
+		if (NumShards < 1 || Shard < 0 || Shard >= NumShards)
+		{
+			UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] Invalid shard %s"), *ShardSpec);
+			return ExitError;
+		}
+	}
+	else if (NumWorkers > 1)
+	{
+		return RunWorkers(NumWorkers, OutFile);
+	}
+
+	// forEachAsset selects from the asset registry, which has to know every asset first
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FToolCall> Calls;
+	FString Error;
+	if (!LoadScript(ScriptFile, Calls, Error))
+	{
+		UE_LOG(LogTemp, Error, TEXT("[NeoStackBridge] %s"), *Error);
+		return ExitError;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("[NeoStackBridge] Running %d calls from %s (shard %d/%d)"), Calls.Num(), *ScriptFile, Shard, NumShards);
+	return RunShard(Calls, Shard, NumShards, FParse::Param(*Params, TEXT("save")), OutFile);
+}
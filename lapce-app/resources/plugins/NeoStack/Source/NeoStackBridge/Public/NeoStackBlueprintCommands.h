@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "NeoStackBridgeProtocol.h"
+#include "NeoStackBlueprintIndex.h"
 
 /**
  * Blueprint-related commands for IDE integration
@@ -49,12 +50,43 @@ public:
 
 	/**
 	 * Batch fetch all Blueprint hints for a file in one request
-	 * Args: { "classes": ["AMyActor"], "properties": [{"className": "AMyActor", "name": "Health"}, ...], "functions": [...] }
-	 * Returns: { "classes": {...}, "properties": {...}, "functions": {...} }
+	 * Args: { "classes": ["AMyActor"], "properties": [{"className": "AMyActor", "name": "Health"}, ...], "functions": [...],
+	 *         "epoch": "...", "generation": 42 }
+	 * Returns: { "classes": {...}, "properties": {...}, "functions": {...}, "epoch": "...", "generation": 57,
+	 *            "changedCount": 1, "notModified": false }
+	 * With the epoch and generation of an earlier response, only hints that changed since are included
 	 */
 	static FNeoStackEvent HandleGetBlueprintHintsBatch(const TSharedPtr<FJsonObject>& Args);
 
+	/**
+	 * True for queries that only need Blueprint parent classes and class reflection data, which
+	 * HandleIndexQuery can answer from an index snapshot: find_derived_blueprints, and
+	 * get_blueprint_hints_batch without property hints
+	 */
+	static bool IsIndexQuery(const FNeoStackCommand& Command);
+
+	/** Answer an IsIndexQuery command from a snapshot; touches no UObjects, so safe on any thread */
+	static FNeoStackEvent HandleIndexQuery(const FNeoStackCommand& Command, const FNeoStackBlueprintIndex::FSnapshot& Snapshot);
+
 private:
+	static FNeoStackEvent FindDerivedBlueprintsInIndex(const TSharedPtr<FJsonObject>& Args, const FNeoStackBlueprintIndex::FSnapshot& Snapshot);
+
+	static FNeoStackEvent GetBlueprintHintsBatchFromIndex(const TSharedPtr<FJsonObject>& Args, const FNeoStackBlueprintIndex::FSnapshot& Snapshot);
+
+	/** { path, name, depth[, parentClass] } for every indexed Blueprint deriving from a class, at any depth */
+	static TArray<TSharedPtr<FJsonValue>> CollectDerivedBlueprints(const FNeoStackBlueprintIndex::FSnapshot& Snapshot,
+		int32 ClassIndex, bool bIncludeParentClass);
+
+	/**
+	 * { blueprintName, blueprintPath, value } for derived Blueprints whose CDO differs from ParentValue
+	 * (exported as DefaultValue), from the override cache; Blueprints it hasn't diffed yet are loaded
+	 */
+	static TArray<TSharedPtr<FJsonValue>> CollectPropertyOverrides(const FNeoStackBlueprintIndex::FSnapshot& Snapshot,
+		UClass* ParentClass, FProperty* TargetProperty, const void* ParentValue, const FString& DefaultValue);
+
+	/** The "generation" a hints request has seen, or 0 if it has none from this session */
+	static uint64 GetSinceGeneration(const TSharedPtr<FJsonObject>& Args);
+
 	/** Helper to resolve class name to UClass */
 	static UClass* ResolveClassName(const FString& ClassName);
 
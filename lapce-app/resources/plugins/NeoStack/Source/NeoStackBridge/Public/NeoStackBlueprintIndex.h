@@ -0,0 +1,205 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+struct FAssetData;
+
+/**
+ * Parent class -> derived Blueprint index, plus the class hierarchy above those Blueprints, as
+ * plain data so Blueprint queries are lookups rather than registry scans, on any thread.
+ *
+ * Blueprints are keyed by the object path in their ParentClassPath tag, and each one's own
+ * generated class path comes from its GeneratedClass tag, so chains of Blueprint parents
+ * resolve from registry data alone without loading a package. Loaded classes supply the native
+ * hierarchy between a queried class and the Blueprints below it.
+ *
+ * Built in full once the Asset Registry has finished loading; the class table alone is rebuilt
+ * when classes may have changed (module load, hot reload, Blueprint compile). Individual Blueprint adds, removes,
+ * renames and updates only touch the bucket of the affected parent class. Readers get immutable
+ * snapshots that share unchanged buckets with the working copy; a new one is published shortly
+ * after a change. Initialize, Shutdown, GetOrBuildSnapshot and the event handlers are game
+ * thread only; GetSnapshot is safe anywhere.
+ */
+class NEOSTACKBRIDGE_API FNeoStackBlueprintIndex
+{
+public:
+	struct FClassEntry
+	{
+		FString Name;
+		FString PathName;
+		int32 SuperClass = INDEX_NONE;
+
+		/** Direct subclasses */
+		TArray<int32> SubClasses;
+
+		/** Generated by a Blueprint; reached through its asset's entry rather than the class table */
+		bool bBlueprintClass = false;
+
+		/** Lowercase names of the BlueprintEvent functions this class declares */
+		TSet<FString> BlueprintEvents;
+	};
+
+	/** Every loaded class, indexed by name and path name */
+	struct FClassTable
+	{
+		TArray<FClassEntry> Classes;
+		TMap<FString, int32> ByName;
+		TMap<FString, int32> ByPath;
+
+		/** Order-independent hash of names, supers and events; equal tables answer queries the same */
+		uint32 ContentHash = 0;
+	};
+
+	struct FBlueprintEntry
+	{
+		FString Name;
+
+		/** Asset object path (/Game/BP_Player.BP_Player), for loading the Blueprint */
+		FString ObjectPath;
+
+		/** Filesystem path of the .uasset, as the IDE expects */
+		FString FullPath;
+
+		/** Object path of the class it generates (/Game/BP_Player.BP_Player_C) */
+		FString GeneratedClassPath;
+
+		/** Object path and name of its direct parent class, native or Blueprint */
+		FString ParentClassPath;
+		FString ParentClassName;
+	};
+
+	typedef TSharedPtr<const TArray<FBlueprintEntry>, ESPMode::ThreadSafe> FBucketPtr;
+
+	struct FSnapshot
+	{
+		TSharedPtr<const FClassTable, ESPMode::ThreadSafe> ClassTable;
+
+		/** Parent class object path -> Blueprints whose direct parent it is */
+		TMap<FString, FBucketPtr> BlueprintsByParent;
+
+		/** Generation each bucket last changed at; emptied buckets stay, so removals count */
+		TMap<FString, uint64> BucketGenerations;
+
+		/** Generation the class table last changed at */
+		uint64 ClassTableGeneration = 0;
+
+		/** Generation this snapshot was published at; nothing in it is newer */
+		uint64 Generation = 0;
+
+		int32 NumBlueprints = 0;
+
+		/** Same rules as FNeoStackBlueprintCommands::ResolveClassName; INDEX_NONE if not found */
+		int32 FindClass(const FString& ClassName) const;
+
+		const FClassEntry& GetClass(int32 ClassIndex) const { return ClassTable->Classes[ClassIndex]; }
+
+		/**
+		 * Visit every Blueprint deriving from a class, directly or through native and Blueprint
+		 * intermediates, with its inheritance depth below that class (1 for a direct child)
+		 */
+		void ForEachDerivedBlueprint(const FString& ClassPath, TFunctionRef<void(const FBlueprintEntry&, int32 Depth)> Visitor) const;
+
+		/** Latest generation at which anything ForEachDerivedBlueprint or HasBlueprintEvent reports for the class changed */
+		uint64 GetDerivedGeneration(const FString& ClassPath) const;
+
+		/** True if the class or one of its supers declares a BlueprintEvent of that name */
+		bool HasBlueprintEvent(int32 ClassIndex, const FString& FunctionName) const;
+
+	private:
+		/** Visit the class and every class deriving from it, native or Blueprint, with its depth */
+		void ForEachDerivedClass(const FString& ClassPath, TFunctionRef<void(const FString& Path, int32 Depth)> Visitor) const;
+	};
+
+	typedef TSharedPtr<const FSnapshot, ESPMode::ThreadSafe> FSnapshotPtr;
+
+	static FNeoStackBlueprintIndex& Get();
+
+	/** Subscribe to registry and class events and schedule the first build */
+	void Initialize();
+
+	/** Drop subscriptions, the working copy and the current snapshot */
+	void Shutdown();
+
+	/** Latest snapshot, or null until the first build has finished */
+	FSnapshotPtr GetSnapshot() const;
+
+	/** Latest snapshot with pending changes applied, building it now if needed */
+	FSnapshotPtr GetOrBuildSnapshot();
+
+	/** /Game/Path/Asset.Asset -> absolute path of the package file (original path if unmapped) */
+	static FString ContentPathToFullPath(const FString& ContentPath);
+
+	/**
+	 * Next value of the process-wide change counter shared by the Bridge's caches, so the IDE
+	 * can ask for what changed since one number. Thread safe.
+	 */
+	static uint64 AllocateGeneration();
+
+	/** This editor session's id; generations from another session mean nothing here */
+	static const FString& GetGenerationEpoch();
+
+private:
+	FNeoStackBlueprintIndex() = default;
+
+	/** Queue publishing the working copy; bFull rebuilds it from the registry first */
+	void SchedulePublish(bool bFull);
+
+	bool HandlePublishTick(float DeltaTime);
+
+	/** Rebuild the class table from the loaded classes */
+	void RebuildClassTable();
+
+	/** Rebuild the working buckets from the registry */
+	void RebuildAll();
+
+	/** Copy the working buckets into a new snapshot and publish it */
+	void Publish();
+
+	/** Add one Blueprint to its parent's bucket, from its registry tags alone */
+	void AddBlueprint(const FAssetData& Asset);
+
+	void RemoveBlueprint(const FString& ObjectPath);
+
+	/** Working bucket of a parent, copied first if a published snapshot still shares it */
+	TArray<FBlueprintEntry>& GetMutableBucket(const FString& ParentClassPath);
+
+	/** Generation for changes made before the next publish */
+	uint64 GetChangeGeneration();
+
+	static TSharedPtr<const FClassTable, ESPMode::ThreadSafe> BuildClassTable();
+
+	void HandleAssetAdded(const FAssetData& Asset);
+	void HandleAssetRemoved(const FAssetData& Asset);
+	void HandleAssetUpdated(const FAssetData& Asset);
+	void HandleAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath);
+	void HandleFilesLoaded();
+
+	mutable FCriticalSection SnapshotLock;
+	FSnapshotPtr Snapshot;
+
+	/** Working copy (game thread) */
+	TSharedPtr<const FClassTable, ESPMode::ThreadSafe> ClassTable;
+	uint64 ClassTableGeneration = 0;
+	TMap<FString, uint64> BucketGenerations;
+	uint64 PendingGeneration = 0;
+	TMap<FString, TSharedPtr<TArray<FBlueprintEntry>, ESPMode::ThreadSafe>> Buckets;
+
+	/** Object path -> parent class path, for removals and renames */
+	TMap<FString, FString> ParentByObjectPath;
+
+	/** Buckets created or copied since the last publish, which nothing else shares yet */
+	TSet<FString> UnpublishedBuckets;
+
+	FTSTicker::FDelegateHandle PublishTickHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+
+	bool bInitialized = false;
+	bool bFullRebuildQueued = true;
+	bool bClassesDirty = true;
+	bool bPublishQueued = false;
+};
@@ -4,10 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "IWebSocket.h"
+#include "NeoStackBridgeProtocol.h"
 
 DECLARE_DELEGATE_OneParam(FOnWsConnected, const FString& /* SessionId */);
 DECLARE_DELEGATE_OneParam(FOnWsDisconnected, const FString& /* Reason */);
 DECLARE_DELEGATE_OneParam(FOnWsMessage, const FString& /* Message */);
+DECLARE_DELEGATE_OneParam(FOnWsBinaryMessage, TArrayView<const uint8> /* Frame */);
 DECLARE_DELEGATE(FOnWsReconnecting);
 
 /**
@@ -32,19 +34,53 @@ public:
 	/** Check if currently attempting to connect */
 	bool IsConnecting() const { return bIsConnecting; }
 
-	/** Send message to server */
+	/**
+	 * Send a message to the server; safe to call from any thread.
+	 * While reconnecting it is queued ahead of all events, as the IDE is waiting for it.
+	 */
 	bool SendMessage(const FString& Message);
 
+	/**
+	 * Send an unsolicited event; safe to call from any thread.
+	 * While reconnecting, a queued event is replaced by a newer one it is superseded by: an
+	 * asset_modified for the same asset, or a repeat of the same log_message (which then
+	 * carries data.repeatCount).
+	 */
+	bool SendEvent(const FNeoStackEvent& Event);
+
+	/** What happened to messages sent while reconnecting */
+	struct FQueueStats
+	{
+		/** Dropped because the queue exceeded MaxPendingBytes */
+		uint64 DroppedResponses = 0;
+		uint64 DroppedEvents = 0;
+
+		/** Merged into a newer event instead of being sent */
+		uint64 CoalescedEvents = 0;
+	};
+
+	FQueueStats GetQueueStats() const;
+
+	/**
+	 * Send a binary frame (NeoStackBinaryFrame); safe to call from any thread.
+	 * Unlike text messages these aren't queued while reconnecting, as the next connection may not accept them.
+	 */
+	bool SendBinary(const TArray<uint8>& Frame);
+
 	/** Get the connection URL */
 	FString GetUrl() const { return ServerUrl; }
 
 	/** Get the session ID assigned by the server */
 	FString GetSessionId() const { return SessionId; }
 
+	/** Whether the IDE accepted an optional feature (NeoStackProtocol::Capability) in its handshake ack */
+	bool HasCapability(const FString& Capability) const;
+
 	/** Callbacks */
 	FOnWsConnected OnConnected;
 	FOnWsDisconnected OnDisconnected;
 	FOnWsMessage OnMessage;
+	FOnWsBinaryMessage OnBinaryMessage;
 	FOnWsReconnecting OnReconnecting;
 
 private:
@@ -57,12 +93,21 @@ private:
 	/** Session ID assigned by server */
 	FString SessionId;
 
+	/** Capabilities accepted in the last handshake ack; guarded by SendLock */
+	TSet<FString> AcceptedCapabilities;
+
 	/** Is currently attempting to connect */
 	bool bIsConnecting;
 
+	/** A reconnect is scheduled or under way; messages queue until it succeeds or gives up. Guarded by SendLock */
+	bool bReconnectPending = false;
+
 	/** Has completed handshake */
 	bool bHandshakeComplete;
 
+	/** An event was dropped for lack of a connection since the last handshake; guarded by SendLock */
+	bool bReportedEventNotSent = false;
+
 	/** Reconnection attempt count */
 	int32 ReconnectAttempts;
 
@@ -72,11 +117,44 @@ private:
 	/** Timer handle for reconnection */
 	FTimerHandle ReconnectTimerHandle;
 
-	/** Message queue for messages during reconnection */
-	TArray<FString> PendingMessages;
+	/** Fragments of the binary message being received */
+	TArray<uint8> BinaryFragments;
+
+	/** A message waiting for the connection to come back */
+	struct FPendingMessage
+	{
+		FString Message;
+
+		/** Events sharing a non-empty key supersede each other */
+		FString CoalesceKey;
+
+		/** log_message only: the event, to count repeats into */
+		TOptional<FNeoStackEvent> LogEvent;
+		int32 RepeatCount = 1;
+
+		/** Memory held by Message */
+		int64 GetSize() const { return Message.Len() * sizeof(TCHAR); }
+	};
+
+	/** Replies to IDE requests queued during reconnection, oldest first; sent before any event */
+	TArray<FPendingMessage> PendingResponses;
 
-	/** Max pending messages to queue */
-	static constexpr int32 MaxPendingMessages = 100;
+	/** Events queued during reconnection, oldest first */
+	TArray<FPendingMessage> PendingEvents;
+
+	/** Memory held by both queues */
+	int64 PendingBytes = 0;
+
+	/** Queued messages may hold this much memory; events are dropped first, oldest first */
+	static constexpr int64 MaxPendingBytes = 16 * 1024 * 1024;
+
+	FQueueStats QueueStats;
+
+	/**
+	 * Guards WebSocket, the pending queues and QueueStats against worker threads sending replies.
+	 * The socket is only created and released on the game thread, under this lock.
+	 */
+	mutable FCriticalSection SendLock;
 
 	/** Setup WebSocket event handlers */
 	void SetupHandlers();
@@ -93,6 +171,9 @@ private:
 	/** Handle received message */
 	void OnWsMessageReceived(const FString& Message);
 
+	/** Collect a binary message fragment, forwarding the message once complete */
+	void OnWsBinaryReceived(const void* Data, SIZE_T Size, bool bIsLastFragment);
+
 	/** Send handshake message to IDE */
 	void SendHandshake();
 
@@ -105,9 +186,24 @@ private:
 	/** Calculate backoff delay in seconds */
 	float CalculateBackoffDelay() const;
 
-	/** Flush pending messages after reconnection */
+	/** Queue a response while reconnecting; caller holds SendLock */
+	bool QueueResponse(const FString& Message);
+
+	/** Queue an event while reconnecting, replacing whatever it supersedes; caller holds SendLock */
+	bool QueueEvent(const FNeoStackEvent& Event, FString&& Message);
+
+	/** Drop queued events, then stop, until Incoming more bytes fit; caller holds SendLock */
+	bool MakeRoom(int64 Incoming);
+
+	/** Flush pending messages after reconnection, responses first */
 	void FlushPendingMessages();
 
+	/** Clear both queues; caller holds SendLock */
+	void ResetPendingMessages();
+
+	/** No reconnect will follow: stop queueing and drop what was queued */
+	void StopReconnecting();
+
 	/** Clear reconnection timer */
 	void ClearReconnectTimer();
 };
@@ -12,9 +12,34 @@
 class NEOSTACKBRIDGE_API FNeoStackBridgeCommands
 {
 public:
-	/** Process incoming command and return response */
+	/** Process incoming command and return response (game thread) */
 	static FNeoStackEvent ProcessCommand(const FNeoStackCommand& Command);
 
+	/**
+	 * True for registry-only queries that may be handed to TryProcessOffGameThread.
+	 * Everything else reads or changes UObjects and must go through ProcessCommand.
+	 */
+	static bool CanRunOffGameThread(const FNeoStackCommand& Command);
+
+	/**
+	 * Answer a CanRunOffGameThread command on the calling thread
+	 * @return False if it can't be answered here yet (no index built); run ProcessCommand on the game thread instead
+	 */
+	static bool TryProcessOffGameThread(const FNeoStackCommand& Command, FNeoStackEvent& OutResponse);
+
+	/**
+	 * True for the read-only Blueprint queries, whose handlers stop at a cancel and return a partial result.
+	 * Every other synchronous command runs to completion, so its result stands even if it was cancelled meanwhile.
+	 */
+	static bool StopsWhenCancelled(const FNeoStackCommand& Command);
+
+	/**
+	 * Start a command that answers over several frames (execute_tool), on the game thread
+	 * @param OnComplete Called on the game thread with the response, possibly before this returns
+	 * @return False if the command answers synchronously; use ProcessCommand instead
+	 */
+	static bool TryProcessAsync(const FNeoStackCommand& Command, TFunction<void(FNeoStackEvent&)>&& OnComplete);
+
 private:
 	/** Open a Blueprint asset in the editor */
 	static FNeoStackEvent HandleOpenBlueprint(const TSharedPtr<FJsonObject>& Args);
@@ -40,6 +65,22 @@ private:
 	/** Execute a tool via the tool registry */
 	static FNeoStackEvent HandleExecuteTool(const TSharedPtr<FJsonObject>& Args);
 
+	/** Start a new agent turn for turn checkpoints */
+	static FNeoStackEvent HandleBeginTurn(const TSharedPtr<FJsonObject>& Args);
+
+	/** Read execute_tool's tool name and arguments; OutError is the response when they are missing */
+	static bool ParseToolArgs(const TSharedPtr<FJsonObject>& Args, FString& OutToolName,
+		TSharedPtr<FJsonObject>& OutToolArgs, FNeoStackEvent& OutError);
+
+	/** Response to execute_tool for a tool's result */
+	static FNeoStackEvent MakeToolResponse(const struct FToolResult& Result);
+
+	/** Start pushing editor events matching the filters in Args */
+	static FNeoStackEvent HandleSubscribeEvents(const TSharedPtr<FJsonObject>& Args);
+
+	/** Stop pushing the events of a subscription */
+	static FNeoStackEvent HandleUnsubscribeEvents(const TSharedPtr<FJsonObject>& Args);
+
 	/** Start PixelStreaming2 and return stream URL */
 	static FNeoStackEvent HandleStartStreaming(const TSharedPtr<FJsonObject>& Args);
 
@@ -0,0 +1,85 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+
+/**
+ * MessagePack encoding of JSON values, used for binary bridge frames when the IDE accepts
+ * NeoStackProtocol::Capability::MessagePack. Messages keep the same fields as their JSON form.
+ */
+namespace NeoStackMessagePack
+{
+	/** Appends MessagePack-encoded values to a byte buffer */
+	class NEOSTACKBRIDGE_API FWriter
+	{
+	public:
+		explicit FWriter(TArray<uint8>& InBuffer)
+			: Buffer(InBuffer)
+		{
+		}
+
+		void WriteNil();
+		void WriteBool(bool bValue);
+
+		/** Integral values are written as integers, everything else as float64 */
+		void WriteNumber(double Value);
+
+		/** Written as UTF-8 */
+		void WriteString(const FString& Value);
+
+		/** Follow with Count values */
+		void WriteArrayHeader(uint32 Count);
+
+		/** Follow with Count key/value pairs */
+		void WriteMapHeader(uint32 Count);
+
+		void WriteValue(const TSharedPtr<FJsonValue>& Value);
+		void WriteObject(const FJsonObject& Object);
+
+		/** Already encoded values */
+		void WriteRaw(TArrayView<const uint8> Bytes);
+
+	private:
+		void WriteByte(uint8 Byte) { Buffer.Add(Byte); }
+		void WriteBigEndian(uint64 Value, int32 NumBytes);
+
+		/** Format byte followed by a 1, 2 or 4 byte length, or a fix format when Count fits in FixMax */
+		void WriteHeader(uint8 FixFormat, uint32 FixMax, uint8 Format8, uint8 Format16, uint8 Format32, uint32 Count);
+
+		TArray<uint8>& Buffer;
+	};
+
+	/**
+	 * Decode a single value
+	 * @return Null if the data is malformed, nests too deeply, uses extension types or has trailing bytes
+	 */
+	NEOSTACKBRIDGE_API TSharedPtr<FJsonValue> Read(TArrayView<const uint8> Data);
+}
+
+/**
+ * Binary WebSocket frame: one flags byte, then the MessagePack payload. With FlagZlib set, the
+ * flags byte is followed by the payload's uncompressed size (uint32, little endian) and the
+ * payload compressed with zlib.
+ */
+namespace NeoStackBinaryFrame
+{
+	constexpr uint8 FlagZlib = 0x01;
+
+	/** Start a frame; append the MessagePack payload to it with an FWriter, then call Finish */
+	NEOSTACKBRIDGE_API void Begin(TArray<uint8>& Frame);
+
+	/**
+	 * Complete a frame started with Begin
+	 * @param bAllowCompression Compress payloads larger than NeoStackProtocol::CompressionThreshold
+	 */
+	NEOSTACKBRIDGE_API void Finish(TArray<uint8>& Frame, bool bAllowCompression);
+
+	/**
+	 * Unwrap a frame into its MessagePack payload
+	 * @param Storage Holds the payload of compressed frames; others are viewed in place
+	 */
+	NEOSTACKBRIDGE_API bool Decode(TArrayView<const uint8> Frame, TArray<uint8>& Storage, TArrayView<const uint8>& OutPayload);
+}
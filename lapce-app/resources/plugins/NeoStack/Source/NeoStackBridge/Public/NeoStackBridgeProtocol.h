@@ -11,12 +11,27 @@
  * - IDE runs WebSocket server, UE connects as client
  * - UE launched with -NeoStackIDE=ws://localhost:{port} argument
  * - Handshake message sent on connect, session ID assigned
+ * - Optional features are negotiated through "capabilities" arrays in handshake/handshake_ack
+ * - Handshake and ack are always JSON text; once MessagePack is accepted, either side may send
+ *   binary frames (see NeoStackBinaryFrame), and text frames are still understood
  */
 namespace NeoStackProtocol
 {
 	/** Protocol version (v2 = WebSocket client mode) */
 	constexpr int32 ProtocolVersion = 2;
 
+	/**
+	 * Responses whose largest array or string field serializes past this many characters are
+	 * streamed as partial events when the IDE accepts Capability::ChunkedResponses
+	 */
+	constexpr int32 MaxChunkChars = 256 * 1024;
+
+	/** Binary frame payloads larger than this many bytes are zlib-compressed when the IDE accepts Capability::Zlib */
+	constexpr int32 CompressionThreshold = 4 * 1024;
+
+	/** Largest uncompressed payload a binary frame may declare */
+	constexpr int32 MaxDecodedFrameBytes = 256 * 1024 * 1024;
+
 	/** Legacy: UDP port for discovery broadcasts (deprecated in v2) */
 	constexpr int32 DiscoveryPort = 27015;
 
@@ -29,6 +44,24 @@ namespace NeoStackProtocol
 	/** Legacy: Discovery broadcast interval in seconds (deprecated in v2) */
 	constexpr float BroadcastInterval = 2.0f;
 
+	/** Optional protocol features, advertised in the handshake and accepted in the ack */
+	namespace Capability
+	{
+		/**
+		 * Large responses arrive as events carrying "chunk": {"seq", "final"} under the same
+		 * requestId. Partial events hold a slice of one array or string field of "data"; the
+		 * final event holds the remaining slice plus every other field. Concatenating the
+		 * slices in seq order restores the full response.
+		 */
+		const FString ChunkedResponses = TEXT("chunked_responses");
+
+		/** Messages may be sent as binary frames holding MessagePack instead of JSON text */
+		const FString MessagePack = TEXT("msgpack");
+
+		/** Binary frames above CompressionThreshold may be zlib-compressed */
+		const FString Zlib = TEXT("zlib");
+	}
+
 	/** Message types */
 	namespace MessageType
 	{
@@ -48,10 +81,20 @@ namespace NeoStackProtocol
 		const FString StopPIE = TEXT("pie_stop");
 		const FString ExecuteCommand = TEXT("execute_command");
 		const FString ExecuteTool = TEXT("execute_tool");
+
+		/** A new agent turn starts: the next edit replaces the turn checkpoint (sent once per prompt) */
+		const FString BeginTurn = TEXT("begin_turn");
 		const FString StartStreaming = TEXT("start_streaming");
 		const FString StopStreaming = TEXT("stop_streaming");
 		const FString GetStreamInfo = TEXT("get_stream_info");
 
+		/** Push editor events (FNeoStackEventPublisher) matching the filters in args; answers data.subscriptionId */
+		const FString SubscribeEvents = TEXT("subscribe_events");
+		const FString UnsubscribeEvents = TEXT("unsubscribe_events");
+
+		/** Stop the request named by args.requestId; it is answered with an error and data.cancelled, the cancel itself is not answered */
+		const FString Cancel = TEXT("cancel");
+
 		// Blueprint queries - IDE -> Plugin
 		const FString FindDerivedBlueprints = TEXT("find_derived_blueprints");
 		const FString FindBlueprintReferences = TEXT("find_blueprint_references");
@@ -135,6 +178,11 @@ struct FNeoStackCommand
 
 	/** Parse from JSON string */
 	static bool FromJson(const FString& JsonString, FNeoStackCommand& OutCommand);
+
+	/** Parse from a binary frame (NeoStackBinaryFrame) */
+	static bool FromBinary(TArrayView<const uint8> Frame, FNeoStackCommand& OutCommand);
+
+	static bool FromJsonObject(const TSharedPtr<FJsonObject>& JsonObject, FNeoStackCommand& OutCommand);
 };
 
 /**
@@ -159,4 +207,21 @@ struct FNeoStackEvent
 
 	/** Convert to JSON string */
 	FString ToJson() const;
+
+	/** Fields as sent over the wire; shares Data */
+	TSharedRef<FJsonObject> ToJsonObject() const;
+
+	/** Convert to a binary frame (NeoStackBinaryFrame) */
+	TArray<uint8> ToBinary(bool bAllowCompression) const;
+
+	/**
+	 * Serialize as a sequence of chunk events (see NeoStackProtocol::Capability::ChunkedResponses),
+	 * splitting the largest top-level array or string field of Data so that no event holds much
+	 * more than MaxChunkChars of it. Responses that fit are emitted as one plain event.
+	 * @param Emit Called with each serialized event, in order
+	 */
+	void ToJsonChunks(int32 MaxChunkChars, TFunctionRef<void(const FString&)> Emit) const;
+
+	/** ToJsonChunks for binary frames; MaxChunkBytes bounds the encoded slice, or the characters of a string slice */
+	void ToBinaryChunks(int32 MaxChunkBytes, bool bAllowCompression, TFunctionRef<void(const TArray<uint8>&)> Emit) const;
 };
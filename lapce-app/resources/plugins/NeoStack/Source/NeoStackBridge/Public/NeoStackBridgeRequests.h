@@ -0,0 +1,113 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NeoStackBridgeProtocol.h"
+#include "Tools/NeoStackToolBase.h"
+
+/**
+ * IDE requests in flight: cancellation, per-command concurrency limits and superseding.
+ *
+ * Every command goes through Submit, which starts it right away or queues it while as many
+ * requests of the same command as its limit allows are already running. A request stops
+ * being wanted when the IDE sends "cancel" for its requestId, or when a later query of the
+ * same command carries the same "supersedeKey" argument (last writer wins). Queued requests
+ * are then started at once so they can be answered as cancelled; running ones see
+ * IsCancelled at their handler's next check and stop early. Only a request that really
+ * stopped is answered as cancelled: one that ran to completion, or a tool that was already
+ * editing when the cancel came, reports its actual result.
+ * Thread-safe.
+ */
+class NEOSTACKBRIDGE_API FNeoStackBridgeRequests
+{
+public:
+	/** Runs an admitted request; it must call Finish once the request is answered */
+	using FStartRequest = TFunction<void(const FNeoStackCommand&)>;
+
+	static FNeoStackBridgeRequests& Get();
+
+	/** Start Command now, or once a slot of its command frees up */
+	void Submit(const FNeoStackCommand& Command, FStartRequest&& Start);
+
+	/** The request was answered; starts the next queued request of its command */
+	void Finish(const FString& RequestId);
+
+	/**
+	 * Ask a request to stop
+	 * @return False if it was already answered
+	 */
+	bool Cancel(const FString& RequestId);
+
+	/** Token shared with work that outlives the handler call, such as asynchronous tools; null once answered */
+	TSharedPtr<FNeoStackCancellationToken> GetToken(const FString& RequestId) const;
+
+	bool IsCancelled(const FString& RequestId) const;
+
+	/** Drop everything in flight without starting queued requests (shutdown) */
+	void Reset();
+
+	/** Answer to a request that was cancelled before it could finish */
+	static FNeoStackEvent MakeCancelledResponse(const FNeoStackCommand& Command);
+
+	/** True once the request whose handler runs on this thread (see FScope) was cancelled */
+	static bool IsCurrentCancelled();
+
+	/** Marks the request a handler on this thread works for, for IsCurrentCancelled */
+	class NEOSTACKBRIDGE_API FScope
+	{
+	public:
+		explicit FScope(const FString& RequestId);
+		~FScope();
+
+	private:
+		TSharedPtr<FNeoStackCancellationToken> Token;
+		TSharedPtr<FNeoStackCancellationToken>* Previous;
+	};
+
+private:
+	FNeoStackBridgeRequests() = default;
+
+	struct FRequest
+	{
+		FNeoStackCommand Command;
+		FStartRequest Start;
+		TSharedRef<FNeoStackCancellationToken> Token = MakeShared<FNeoStackCancellationToken>();
+		FString SupersedeKey;
+
+		/** Holds one of its command's slots */
+		bool bRunning = false;
+	};
+
+	/** Requests of a command that may run at the same time */
+	static int32 GetMaxConcurrent(const FString& Command);
+
+	/** Idempotent queries a later identical request may supersede */
+	static bool CanSupersede(const FString& Command);
+
+	/** Requests to start, with the callbacks taken out of their FRequest */
+	using FToStartList = TArray<TPair<FNeoStackCommand, FStartRequest>>;
+
+	/** Cancel's work; queued requests to start once Lock is released are added to ToStart */
+	bool CancelLocked(const FString& RequestId, FToStartList& ToStart);
+
+	/** Start requests outside Lock, so they may call back into the tracker */
+	static void StartAll(FToStartList& ToStart);
+
+	/** Take the next queued request of Command off its queue if a slot is free; caller holds Lock */
+	FRequest* PopStartable(const FString& Command);
+
+	mutable FCriticalSection Lock;
+
+	/** RequestId -> request, queued or running */
+	TMap<FString, TUniquePtr<FRequest>> Requests;
+
+	/** Command -> request IDs waiting for a slot, oldest first */
+	TMap<FString, TArray<FString>> Queued;
+
+	/** Command -> requests holding a slot */
+	TMap<FString, int32> RunningCounts;
+
+	/** Command and supersedeKey -> latest request carrying them */
+	TMap<FString, FString> LatestBySupersedeKey;
+};
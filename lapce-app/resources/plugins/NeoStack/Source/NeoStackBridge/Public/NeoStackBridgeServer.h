@@ -28,17 +28,19 @@ private:
 };
 
 /**
- * Runnable for receiving data from clients
+ * Runnable for receiving data from one client.
+ * Blocks until the client's socket is readable; shutting the socket down wakes it.
  */
 class FReceiveDataRunnable : public FRunnable
 {
 public:
-	FReceiveDataRunnable(class FNeoStackBridgeServer* InServer);
+	FReceiveDataRunnable(class FNeoStackBridgeServer* InServer, const FString& InClientId);
 	virtual uint32 Run() override;
 	virtual void Stop() override;
 
 private:
 	FNeoStackBridgeServer* Server;
+	FString ClientId;
 	FThreadSafeBool bShouldStop;
 };
 
@@ -95,18 +97,23 @@ private:
 		FString Id;
 		FSocket* Socket;
 		FIPv4Endpoint Endpoint;
-		FString ReceiveBuffer;
+
+		/** Raw bytes not yet framed; only touched by the client's receive thread */
+		TArray<uint8> ReceiveBuffer;
+
+		/** Receive thread for this client */
+		TUniquePtr<FReceiveDataRunnable> ReceiveRunnable;
+		FRunnableThread* ReceiveThread = nullptr;
 	};
 	TMap<FString, TSharedPtr<FClientConnection>> Clients;
 
+	/** Disconnected clients whose thread and socket are waiting to be released */
+	TArray<TSharedPtr<FClientConnection>> ClosedClients;
+
 	/** Runnable for accepting connections */
 	TUniquePtr<FAcceptConnectionsRunnable> AcceptRunnable;
 	FRunnableThread* AcceptThread;
 
-	/** Runnable for receiving data */
-	TUniquePtr<FReceiveDataRunnable> ReceiveRunnable;
-	FRunnableThread* ReceiveThread;
-
 	/** Running flag */
 	FThreadSafeBool bIsRunning;
 
@@ -116,11 +123,20 @@ private:
 	/** Accept new connections (called from runnable) */
 	void AcceptConnections();
 
-	/** Receive data from clients (called from runnable) */
-	void ReceiveData();
+	/** Receive data from one client until it disconnects or the server stops (called from runnable) */
+	void ReceiveData(const FString& ClientId);
+
+	/** Frame complete newline-delimited messages out of a client's receive buffer */
+	void ProcessReceivedData(FClientConnection& Client);
+
+	/** Connect to our own listen socket so a blocked accept wait returns immediately */
+	FSocket* WakeAcceptThread();
+
+	/** Join the receive thread and destroy the socket of a client that is no longer in Clients */
+	static void ReleaseClient(FClientConnection& Client);
 
-	/** Process received data for a client */
-	void ProcessReceivedData(TSharedPtr<FClientConnection> Client);
+	/** Release clients that disconnected since the last call */
+	void ReapClosedClients();
 
 	/** Generate unique client ID */
 	FString GenerateClientId();
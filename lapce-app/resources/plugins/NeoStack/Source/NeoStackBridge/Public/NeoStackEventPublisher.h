@@ -0,0 +1,159 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Misc/OutputDevice.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "NeoStackBridgeProtocol.h"
+#include <atomic>
+
+struct FAssetData;
+class UBlueprint;
+class UPackage;
+class FObjectPostSaveContext;
+
+/**
+ * Pushes editor events to the IDE so it doesn't have to poll: log_message, compile_started and
+ * compile_finished (Blueprint compiles), asset_created and asset_modified.
+ *
+ * Nothing is hooked until the IDE subscribes with subscribe_events, and everything is unhooked
+ * again once the last subscription is gone or the connection drops (the bridge calls
+ * UnsubscribeAll on disconnect and on each new handshake, so the IDE resubscribes per session). Events are collected as they happen and sent from
+ * the next tick: repeated asset_modified for an asset collapse into the latest, and at most
+ * MaxEventsPerSecond go out, the rest waiting for later frames up to MaxPendingEvents.
+ * Log lines may arrive on any thread; everything else runs on the game thread.
+ */
+class NEOSTACKBRIDGE_API FNeoStackEventPublisher
+{
+public:
+	/** What a subscriber wants; an event is sent once if any subscription accepts it */
+	struct FSubscription
+	{
+		/** Event names; empty for all */
+		TSet<FString> Events;
+
+		/** Asset and compile events under one of these package paths (/Game/Characters/); empty for all */
+		TArray<FString> PathPrefixes;
+
+		/** Asset and compile events for these asset classes (Blueprint, Texture2D); empty for all */
+		TSet<FString> Classes;
+
+		/** Log lines at this verbosity or more severe */
+		ELogVerbosity::Type MaxVerbosity = ELogVerbosity::Warning;
+	};
+
+	using FSendEvent = TFunction<void(const FNeoStackEvent&)>;
+
+	static FNeoStackEventPublisher& Get();
+
+	/** Set where events go; nothing is hooked until the first subscription */
+	void Initialize(FSendEvent&& InSend);
+
+	void Shutdown();
+
+	/**
+	 * Read subscribe_events arguments: events, paths and classes (string arrays) and
+	 * minVerbosity (Error, Warning, Display, Log or Verbose)
+	 */
+	static bool ParseSubscription(const TSharedPtr<FJsonObject>& Args, FSubscription& OutSubscription, FString& OutError);
+
+	/** @return The ID to unsubscribe with */
+	FString Subscribe(FSubscription&& Subscription);
+
+	/** @return False if there is no such subscription */
+	bool Unsubscribe(const FString& SubscriptionId);
+
+	/** Drop every subscription; subscriptions belong to one IDE session and end with it */
+	void UnsubscribeAll();
+
+	/** Events sent per second at most */
+	static constexpr double MaxEventsPerSecond = 200.0;
+
+	/** Events waiting to be sent at most; further ones are dropped and reported in one log_message */
+	static constexpr int32 MaxPendingEvents = 2000;
+
+private:
+	FNeoStackEventPublisher() = default;
+
+	/** Forwards log lines from any thread */
+	class FLogDevice : public FOutputDevice
+	{
+	public:
+		explicit FLogDevice(FNeoStackEventPublisher& InPublisher)
+			: Publisher(InPublisher)
+		{
+		}
+
+		virtual void Serialize(const TCHAR* Message, ELogVerbosity::Type Verbosity, const FName& Category) override;
+		virtual bool CanBeUsedOnAnyThread() const override { return true; }
+		virtual bool CanBeUsedOnMultipleThreads() const override { return true; }
+
+	private:
+		FNeoStackEventPublisher& Publisher;
+	};
+
+	struct FPendingEvent
+	{
+		FNeoStackEvent Event;
+
+		/** Package name of the asset, for asset and compile events */
+		FString Path;
+		FString Class;
+
+		/** Log lines only */
+		ELogVerbosity::Type Verbosity = ELogVerbosity::NoLogging;
+	};
+
+	/** Whether a subscription wants the event; caller holds Lock */
+	bool IsWanted(const FPendingEvent& Pending) const;
+
+	/** Queue an event for the next tick if someone wants it; any thread */
+	void Publish(FPendingEvent&& Pending);
+
+	void Hook();
+	void Unhook();
+	bool HandleTick(float DeltaTime);
+
+	void PublishAssetEvent(const FString& EventName, const FString& PackageName, const FString& ClassName, const TCHAR* Reason);
+
+	void HandleLog(const TCHAR* Message, ELogVerbosity::Type Verbosity, const FName& Category);
+	void HandleAssetAdded(const FAssetData& Asset);
+	void HandlePackageMarkedDirty(UPackage* Package, bool bWasDirty);
+	void HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext);
+	void HandleBlueprintPreCompile(UBlueprint* Blueprint);
+	void HandleBlueprintCompiled();
+
+	FSendEvent Send;
+
+	/** Guards Subscriptions, Pending, DroppedEvents and MaxLogVerbosity */
+	mutable FCriticalSection Lock;
+
+	TMap<FString, FSubscription> Subscriptions;
+	int32 NextSubscriptionId = 1;
+
+	/** Most verbose level any subscription wants, so unwanted log lines are skipped without locking */
+	std::atomic<int32> MaxLogVerbosity{ELogVerbosity::NoLogging};
+
+	/** Waiting for the next tick, oldest first */
+	TArray<FPendingEvent> Pending;
+
+	/** Dropped because Pending was full, since the last report */
+	int32 DroppedEvents = 0;
+
+	/** Rate limit tokens, refilled at MaxEventsPerSecond */
+	double SendBudget = MaxEventsPerSecond;
+
+	/** Blueprints that started compiling since the last compile_finished */
+	TArray<TWeakObjectPtr<UBlueprint>> Compiling;
+
+	TUniquePtr<FLogDevice> LogDevice;
+	FTSTicker::FDelegateHandle TickHandle;
+	FDelegateHandle PackageDirtyHandle;
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+
+	bool bHooked = false;
+};
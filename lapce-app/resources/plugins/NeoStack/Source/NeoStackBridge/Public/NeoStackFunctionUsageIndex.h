@@ -0,0 +1,146 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+struct FAssetData;
+class UBlueprint;
+class UFunction;
+class UPackage;
+class FObjectPostSaveContext;
+
+/**
+ * Function -> Blueprint graph nodes that call or override it, gathered by scanning Blueprint
+ * graphs for call function and event nodes.
+ *
+ * Functions are keyed by the class that first declares them (/Script/Engine.Actor:K2_DestroyActor),
+ * so calls and overrides through subclasses land on the same key. Results are persisted under
+ * Intermediate/NeoStack with each package's file timestamp and saved hash; on startup only
+ * Blueprints whose package changed since are rescanned, a few per tick. A record whose
+ * timestamp differs but whose hash matches (another checkout's index, pulled through
+ * FNeoStackIndexArtifacts) is kept. Saved Blueprints are rescanned right away, and added,
+ * removed or renamed ones are picked up from the registry.
+ *
+ * The editor never loads a Blueprint for the index: one that is not in memory waits until
+ * something else loads it, and counts as pending until then. Only commandlets load them
+ * (NeoStackTools -publishIndexes builds the whole index for FNeoStackIndexArtifacts to share),
+ * collecting garbage as they go. Game thread only.
+ */
+class NEOSTACKBRIDGE_API FNeoStackFunctionUsageIndex
+{
+public:
+	enum class EUsageKind : uint8
+	{
+		/** A call function node targeting the function */
+		Call,
+
+		/** An event node or function graph overriding it */
+		Override,
+	};
+
+	struct FUsage
+	{
+		/** Blueprint object path (/Game/BP_Player.BP_Player) */
+		FString BlueprintPath;
+
+		FString GraphName;
+		FGuid NodeGuid;
+		EUsageKind Kind = EUsageKind::Call;
+	};
+
+	static FNeoStackFunctionUsageIndex& Get();
+
+	/** Load the persisted index and start scanning changed Blueprints once the registry is ready */
+	void Initialize();
+
+	/** Persist pending results, drop subscriptions and everything indexed */
+	void Shutdown();
+
+	/** Key usages are stored under: the declaring class of Function's root declaration, and its name */
+	static FString MakeFunctionKey(const UFunction* Function);
+
+	/** Usages recorded for a function key */
+	TArray<FUsage> FindUsages(const FString& FunctionKey) const;
+
+	/** True once the Blueprint has been scanned at its current package contents */
+	bool IsScanned(const FString& BlueprintPath) const;
+
+	/** Blueprints still waiting to be scanned, including those waiting to be loaded */
+	int32 GetNumPending() const { return PendingSet.Num() + UnloadedScans.Num(); }
+
+private:
+	struct FRecordedUsage
+	{
+		FString FunctionKey;
+		FString GraphName;
+		FGuid NodeGuid;
+		EUsageKind Kind = EUsageKind::Call;
+	};
+
+	struct FBlueprintRecord
+	{
+		/** Package file timestamp when scanned */
+		FDateTime Stamp;
+
+		/** Package saved hash from the asset registry when scanned, empty if it had none */
+		FString Hash;
+
+		TArray<FRecordedUsage> Usages;
+	};
+
+	FNeoStackFunctionUsageIndex() = default;
+
+	/** Queue every Blueprint whose package differs from its record and forget deleted ones */
+	void QueueChangedBlueprints();
+
+	bool HandleScanTick(float DeltaTime);
+
+	/** Record the usages found in one Blueprint's graphs, replacing the previous ones */
+	void ScanBlueprint(const FString& BlueprintPath, UBlueprint* Blueprint);
+
+	void SetRecord(const FString& BlueprintPath, FBlueprintRecord&& Record);
+	void RemoveRecord(const FString& BlueprintPath);
+
+	void QueueScan(const FString& BlueprintPath);
+	void EnsureScanTicker();
+
+	static FDateTime GetPackageStamp(const FString& BlueprintPath);
+	static FString GetPackageHash(const FString& BlueprintPath);
+	static FString GetCacheFilePath();
+	void LoadFromDisk();
+	void SaveToDisk();
+
+	void HandleFilesLoaded();
+	void HandleAssetAdded(const FAssetData& Asset);
+	void HandleAssetRemoved(const FAssetData& Asset);
+	void HandleAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath);
+	void HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext);
+	void HandleAssetLoaded(UObject* Object);
+
+	/** Blueprint object path -> what its graphs use */
+	TMap<FString, FBlueprintRecord> Records;
+
+	/** Function key -> Blueprints whose records mention it */
+	TMap<FString, TSet<FString>> BlueprintsByFunction;
+
+	/** Scan order, with a set to keep it free of duplicates */
+	TArray<FString> PendingScans;
+	TSet<FString> PendingSet;
+
+	/** Changed Blueprints that were not in memory; queued again once something loads them */
+	TSet<FString> UnloadedScans;
+
+	/** Blueprints loaded for scanning since the last garbage collection (commandlets only) */
+	int32 LoadsSinceCollection = 0;
+
+	FTSTicker::FDelegateHandle ScanTickHandle;
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle AssetLoadedHandle;
+
+	bool bInitialized = false;
+
+	/** Records changed since the cache file was written */
+	bool bDirty = false;
+};
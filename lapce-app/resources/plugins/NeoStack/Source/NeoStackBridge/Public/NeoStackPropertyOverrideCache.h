@@ -0,0 +1,114 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "UObject/PackageReload.h"
+
+struct FAssetData;
+class UBlueprint;
+class UPackage;
+class FObjectPostSaveContext;
+struct FPropertyChangedEvent;
+
+/**
+ * Per-Blueprint property values that differ from the parent defaults, exported to text, so
+ * override queries don't have to load Blueprints and compare CDOs on every request.
+ *
+ * Blueprints that are already loaded are diffed a few per tick in the background; others are
+ * diffed (and loaded) the first time a query needs them. An entry is dropped, together with
+ * those of Blueprints deriving from it, when its package is saved or reloaded, its class
+ * defaults are edited or it is recompiled; loaded ones are diffed again in the background.
+ * Game thread only.
+ */
+class NEOSTACKBRIDGE_API FNeoStackPropertyOverrideCache
+{
+public:
+	struct FDirectOverride
+	{
+		FString Property;
+		FString DefaultValue;
+		FString BlueprintValue;
+	};
+
+	struct FEntry
+	{
+		/** Inherited properties whose value differs from the direct parent class's defaults */
+		TArray<FDirectOverride> DirectOverrides;
+
+		/** Closest native ancestor of the Blueprint's generated class */
+		TWeakObjectPtr<UClass> NativeParent;
+
+		/** Native properties whose value differs from NativeParent's defaults -> the Blueprint's value */
+		TMap<FName, FString> NativeOverrides;
+	};
+
+	static FNeoStackPropertyOverrideCache& Get();
+
+	/** Subscribe to save, reload and edit events and start diffing loaded Blueprints */
+	void Initialize();
+
+	void Shutdown();
+
+	/**
+	 * Entry for a Blueprint, diffing it (and loading it if needed) on a miss
+	 * @param BlueprintPath Object path (/Game/BP_Player.BP_Player) or package name (/Game/BP_Player)
+	 * @return Null if it can't be loaded or has no generated class
+	 */
+	TSharedPtr<const FEntry> FindOrCompute(const FString& BlueprintPath);
+
+	/** /Game/BP_Player -> /Game/BP_Player.BP_Player; object paths are returned as they are */
+	static FString ToObjectPath(const FString& BlueprintPath);
+
+	/** Generation (FNeoStackBlueprintIndex::AllocateGeneration) at which a Blueprint's values last changed */
+	uint64 GetChangeGeneration(const FString& ObjectPath) const;
+
+	/** Latest generation any Blueprint's values changed at */
+	uint64 GetLatestGeneration() const { return LatestGeneration; }
+
+private:
+	FNeoStackPropertyOverrideCache() = default;
+
+	static TSharedPtr<const FEntry> Compute(UBlueprint* Blueprint);
+
+	/** Drop a Blueprint's entry and those of everything deriving from it, and queue the loaded ones */
+	void Invalidate(UBlueprint* Blueprint);
+
+	/** Drop every entry (native defaults may have changed) and queue the loaded Blueprints */
+	void InvalidateAll();
+
+	void MarkChanged(const FString& ObjectPath, uint64 Generation);
+
+	void QueueLoadedBlueprints();
+	void QueueDiff(UBlueprint* Blueprint);
+	bool HandleDiffTick(float DeltaTime);
+
+	void HandlePackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext SaveContext);
+	void HandlePackageReloaded(EPackageReloadPhase Phase, FPackageReloadedEvent* Event);
+	void HandleObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+	void HandleBlueprintPreCompile(UBlueprint* Blueprint);
+	void HandleAssetRemoved(const FAssetData& Asset);
+	void HandleAssetRenamed(const FAssetData& Asset, const FString& OldObjectPath);
+
+	/** Blueprint object path -> its diff */
+	TMap<FString, TSharedPtr<const FEntry>> Entries;
+
+	/** Object path -> generation its values last changed at, since the last InvalidateAll */
+	TMap<FString, uint64> ChangedAt;
+	uint64 ClearedGeneration = 0;
+	uint64 LatestGeneration = 0;
+
+	/** Loaded Blueprints waiting for a background diff */
+	TArray<TWeakObjectPtr<UBlueprint>> PendingDiffs;
+
+	FTSTicker::FDelegateHandle DiffTickHandle;
+	FDelegateHandle PackageSavedHandle;
+	FDelegateHandle PackageReloadedHandle;
+	FDelegateHandle ObjectPropertyChangedHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle BlueprintPreCompileHandle;
+
+	bool bInitialized = false;
+};
@@ -0,0 +1,48 @@
+// Copyright NeoStack. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "NeoStackToolsCommandlet.generated.h"
+
+/**
+ * UnrealEditor-Cmd Project.uproject -run=NeoStackTools -script=Calls.jsonl [-out=Results.jsonl] [-workers=N] [-save]
+ *
+ * Runs a JSONL script of tool calls headless, for audits, mass refactors and index prebuilds
+ * in CI. Each line is one call:
+ *
+ *   {"id": "bp-audit", "tool": "read_file", "args": {"path": "{asset}"}, "forEachAsset": {"path": "/Game/Characters", "class": "Blueprint"}}
+ *   {"command": "find_derived_blueprints", "args": {"className": "Character"}}
+ *
+ * "tool" calls go through FNeoStackToolRegistry, "command" calls through the bridge command
+ * handlers (the Blueprint queries). "forEachAsset" repeats the call for every asset under
+ * the path (recursive unless "recursive" is false, optionally of one class), replacing
+ * {asset} (object path) and {package} (package name) in the argument strings.
+ *
+ * With -workers=N the expanded calls are sharded across N child processes (-shard=I/N runs
+ * shard I) and their results merged, in script order, into -out (default
+ * Saved/NeoStack/tools_results.jsonl). Read-only calls are spread over the shards; mutating
+ * calls, and reads of what they touch, all run in shard 0 in script order. Each result line
+ * holds the call's index, id, tool or command, asset, success, duration and output or data.
+ *
+ * -save saves every package the calls left dirty when the shard finishes; without it the
+ * changes are discarded.
+ *
+ * UnrealEditor-Cmd Project.uproject -run=NeoStackTools -publishIndexes[=SharedDir] builds the
+ * project catalog, code search and function usage indexes and publishes them for other
+ * machines to pull at startup (see FNeoStackIndexArtifacts); SharedDir defaults to the
+ * Shared Index Path setting.
+ *
+ * Returns 0 when every call succeeded, 1 when any failed and 2 when the script couldn't run.
+ */
+UCLASS()
+class UNeoStackToolsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UNeoStackToolsCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
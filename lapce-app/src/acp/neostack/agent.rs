@@ -283,6 +283,13 @@ async fn prompt(&self, args: PromptRequest) -> Result<PromptResponse> {
 
         tracing::info!("NeoStack agent: {} tools available", tools.len());
 
+        // Every prompt is one turn: UE's turn checkpoint then rolls back only this prompt's edits
+        if let Some(ref url) = mcp_url {
+            if let Err(e) = McpClient::new(url.clone()).begin_turn().await {
+                tracing::warn!("Failed to begin turn: {}", e);
+            }
+        }
+
         // ReAct loop - iterate until done or max iterations
         for iteration in 0..MAX_ITERATIONS {
             tracing::info!("NeoStack agent: ReAct iteration {}", iteration + 1);
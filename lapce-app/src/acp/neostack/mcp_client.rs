@@ -80,6 +80,12 @@ pub async fn list_tools(&self) -> anyhow::Result<Vec<McpToolInfo>> {
         Ok(tools.tools)
     }
 
+    /// Tell the server a new agent turn starts (NeoStack extension method)
+    pub async fn begin_turn(&self) -> anyhow::Result<()> {
+        self.request("neostack/beginTurn", None).await?;
+        Ok(())
+    }
+
     /// Call a tool
     pub async fn call_tool(&self, name: &str, arguments: Value) -> anyhow::Result<ToolCallResponse> {
         let params = json!({
@@ -153,6 +159,8 @@ pub struct ToolCallResponse {
 pub struct ToolContent {
     #[serde(rename = "type")]
     pub content_type: String,
+    /// Empty for image content
+    #[serde(default)]
     pub text: String,
 }
 
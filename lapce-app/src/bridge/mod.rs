@@ -19,10 +19,12 @@
 //! ## Modules
 //!
 //! - [`types`]: Data structures for bridge communication
+//! - [`msgpack`]: Binary MessagePack framing, used when negotiated in the handshake
 //! - [`runtime`]: Background Tokio runtime with WebSocket server
 //! - [`plugin`]: NeoStack plugin installation and version management
 //! - [`view`]: UI components (status indicator, plugin banner)
 
+mod msgpack;
 mod plugin;
 mod runtime;
 mod types;
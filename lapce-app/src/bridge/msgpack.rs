@@ -0,0 +1,359 @@
+//! Binary framing for the bridge protocol
+//!
+//! When the UE plugin and the IDE both accept the `msgpack` capability, messages
+//! may be sent as binary WebSocket frames holding MessagePack instead of JSON
+//! text. Each frame starts with a flags byte; with [`FLAG_ZLIB`] set it is
+//! followed by the uncompressed payload size (u32, little endian) and the
+//! payload compressed with zlib. Messages keep the same fields as their JSON form.
+
+use std::io::{Read, Write};
+
+use flate2::{Compression, read::ZlibDecoder, write::ZlibEncoder};
+use serde_json::{Map, Number, Value};
+
+/// Frame flag: the payload is zlib-compressed
+pub const FLAG_ZLIB: u8 = 0x01;
+
+/// Payloads larger than this many bytes are compressed when `zlib` was negotiated
+pub const COMPRESSION_THRESHOLD: usize = 4 * 1024;
+
+/// Largest uncompressed payload a frame may declare
+pub const MAX_DECODED_FRAME_BYTES: usize = 256 * 1024 * 1024;
+
+/// Bridge messages nest a handful of levels; anything deeper is malformed
+const MAX_DEPTH: usize = 64;
+
+/// Encode a message into a binary frame
+pub fn encode_frame(value: &Value, allow_compression: bool) -> Vec<u8> {
+    let mut frame = vec![0u8];
+    write_value(&mut frame, value);
+
+    let payload_len = frame.len() - 1;
+    if !allow_compression || payload_len <= COMPRESSION_THRESHOLD {
+        return frame;
+    }
+
+    let mut compressed = vec![FLAG_ZLIB];
+    compressed.extend_from_slice(&(payload_len as u32).to_le_bytes());
+    let mut encoder = ZlibEncoder::new(compressed, Compression::fast());
+    if encoder.write_all(&frame[1..]).is_err() {
+        return frame;
+    }
+    match encoder.finish() {
+        Ok(compressed) if compressed.len() < frame.len() => compressed,
+        // Incompressible; the plain frame is already complete
+        _ => frame,
+    }
+}
+
+/// Decode a binary frame into a message
+pub fn decode_frame(frame: &[u8]) -> Result<Value, String> {
+    let (&flags, rest) = frame.split_first().ok_or("Empty binary frame")?;
+    match flags {
+        0 => decode(rest),
+        FLAG_ZLIB => {
+            if rest.len() < 4 {
+                return Err("Truncated compressed frame".to_string());
+            }
+            let size =
+                u32::from_le_bytes([rest[0], rest[1], rest[2], rest[3]]) as usize;
+            if size > MAX_DECODED_FRAME_BYTES {
+                return Err(format!("Compressed frame declares {} bytes", size));
+            }
+
+            let mut payload = Vec::with_capacity(size);
+            ZlibDecoder::new(&rest[4..])
+                .take(size as u64)
+                .read_to_end(&mut payload)
+                .map_err(|e| format!("Failed to decompress frame: {}", e))?;
+            if payload.len() != size {
+                return Err("Compressed frame size mismatch".to_string());
+            }
+            decode(&payload)
+        }
+        _ => Err(format!("Unknown frame flags {:#04x}", flags)),
+    }
+}
+
+/// Decode a single MessagePack value, rejecting trailing bytes
+pub fn decode(data: &[u8]) -> Result<Value, String> {
+    let mut reader = Reader { data, pos: 0 };
+    let value = reader.read_value(0)?;
+    if reader.pos != data.len() {
+        return Err("Trailing bytes after MessagePack value".to_string());
+    }
+    Ok(value)
+}
+
+fn write_header(
+    out: &mut Vec<u8>,
+    fix: (u8, usize),
+    f8: Option<u8>,
+    f16: u8,
+    f32: u8,
+    len: usize,
+) {
+    if len <= fix.1 {
+        out.push(fix.0 | len as u8);
+    } else if let (Some(f8), true) = (f8, len <= u8::MAX as usize) {
+        out.push(f8);
+        out.push(len as u8);
+    } else if len <= u16::MAX as usize {
+        out.push(f16);
+        out.extend_from_slice(&(len as u16).to_be_bytes());
+    } else {
+        out.push(f32);
+        out.extend_from_slice(&(len as u32).to_be_bytes());
+    }
+}
+
+fn write_str(out: &mut Vec<u8>, s: &str) {
+    write_header(out, (0xa0, 31), Some(0xd9), 0xda, 0xdb, s.len());
+    out.extend_from_slice(s.as_bytes());
+}
+
+fn write_value(out: &mut Vec<u8>, value: &Value) {
+    match value {
+        Value::Null => out.push(0xc0),
+        Value::Bool(b) => out.push(if *b { 0xc3 } else { 0xc2 }),
+        Value::Number(n) => {
+            if let Some(u) = n.as_u64() {
+                match u {
+                    0..=0x7f => out.push(u as u8),
+                    0x80..=0xff => out.extend_from_slice(&[0xcc, u as u8]),
+                    0x100..=0xffff => {
+                        out.push(0xcd);
+                        out.extend_from_slice(&(u as u16).to_be_bytes());
+                    }
+                    0x1_0000..=0xffff_ffff => {
+                        out.push(0xce);
+                        out.extend_from_slice(&(u as u32).to_be_bytes());
+                    }
+                    _ => {
+                        out.push(0xcf);
+                        out.extend_from_slice(&u.to_be_bytes());
+                    }
+                }
+            } else if let Some(i) = n.as_i64() {
+                // Only negative values get here
+                if i >= -32 {
+                    out.push(i as u8);
+                } else if i >= i8::MIN as i64 {
+                    out.extend_from_slice(&[0xd0, i as u8]);
+                } else if i >= i16::MIN as i64 {
+                    out.push(0xd1);
+                    out.extend_from_slice(&(i as i16).to_be_bytes());
+                } else if i >= i32::MIN as i64 {
+                    out.push(0xd2);
+                    out.extend_from_slice(&(i as i32).to_be_bytes());
+                } else {
+                    out.push(0xd3);
+                    out.extend_from_slice(&i.to_be_bytes());
+                }
+            } else {
+                out.push(0xcb);
+                out.extend_from_slice(&n.as_f64().unwrap_or(0.0).to_be_bytes());
+            }
+        }
+        Value::String(s) => write_str(out, s),
+        Value::Array(items) => {
+            write_header(out, (0x90, 15), None, 0xdc, 0xdd, items.len());
+            for item in items {
+                write_value(out, item);
+            }
+        }
+        Value::Object(fields) => {
+            write_header(out, (0x80, 15), None, 0xde, 0xdf, fields.len());
+            for (key, value) in fields {
+                write_str(out, key);
+                write_value(out, value);
+            }
+        }
+    }
+}
+
+struct Reader<'a> {
+    data: &'a [u8],
+    pos: usize,
+}
+
+impl Reader<'_> {
+    fn take(&mut self, n: usize) -> Result<&[u8], String> {
+        if self.data.len() - self.pos < n {
+            return Err("Truncated MessagePack value".to_string());
+        }
+        let bytes = &self.data[self.pos..self.pos + n];
+        self.pos += n;
+        Ok(bytes)
+    }
+
+    fn uint(&mut self, n: usize) -> Result<u64, String> {
+        Ok(self
+            .take(n)?
+            .iter()
+            .fold(0u64, |acc, b| (acc << 8) | *b as u64))
+    }
+
+    fn remaining(&self) -> usize {
+        self.data.len() - self.pos
+    }
+
+    fn read_str(&mut self, len: usize) -> Result<String, String> {
+        let bytes = self.take(len)?;
+        String::from_utf8(bytes.to_vec())
+            .map_err(|_| "Invalid UTF-8 in MessagePack string".to_string())
+    }
+
+    fn read_array(&mut self, len: usize, depth: usize) -> Result<Value, String> {
+        // Every element takes at least a byte, which bounds the reservation
+        if len > self.remaining() {
+            return Err("Truncated MessagePack array".to_string());
+        }
+        let mut items = Vec::with_capacity(len);
+        for _ in 0..len {
+            items.push(self.read_value(depth + 1)?);
+        }
+        Ok(Value::Array(items))
+    }
+
+    fn read_map(&mut self, len: usize, depth: usize) -> Result<Value, String> {
+        if len.saturating_mul(2) > self.remaining() {
+            return Err("Truncated MessagePack map".to_string());
+        }
+        let mut fields = Map::new();
+        for _ in 0..len {
+            let key = match self.read_value(depth + 1)? {
+                Value::String(key) => key,
+                _ => return Err("MessagePack map keys must be strings".to_string()),
+            };
+            let value = self.read_value(depth + 1)?;
+            fields.insert(key, value);
+        }
+        Ok(Value::Object(fields))
+    }
+
+    fn float(value: f64) -> Value {
+        Number::from_f64(value)
+            .map(Value::Number)
+            .unwrap_or(Value::Null)
+    }
+
+    fn read_value(&mut self, depth: usize) -> Result<Value, String> {
+        if depth > MAX_DEPTH {
+            return Err("MessagePack value nests too deeply".to_string());
+        }
+
+        let format = self.take(1)?[0];
+        Ok(match format {
+            0x00..=0x7f => Value::from(format),
+            0x80..=0x8f => self.read_map((format & 0x0f) as usize, depth)?,
+            0x90..=0x9f => self.read_array((format & 0x0f) as usize, depth)?,
+            0xa0..=0xbf => Value::String(self.read_str((format & 0x1f) as usize)?),
+            0xc0 => Value::Null,
+            0xc2 => Value::Bool(false),
+            0xc3 => Value::Bool(true),
+            0xca => Self::float(f32::from_bits(self.uint(4)? as u32) as f64),
+            0xcb => Self::float(f64::from_bits(self.uint(8)?)),
+            0xcc => Value::from(self.uint(1)?),
+            0xcd => Value::from(self.uint(2)?),
+            0xce => Value::from(self.uint(4)?),
+            0xcf => Value::from(self.uint(8)?),
+            0xd0 => Value::from(self.uint(1)? as u8 as i8),
+            0xd1 => Value::from(self.uint(2)? as u16 as i16),
+            0xd2 => Value::from(self.uint(4)? as u32 as i32),
+            0xd3 => Value::from(self.uint(8)? as i64),
+            0xd9 => {
+                let len = self.uint(1)? as usize;
+                Value::String(self.read_str(len)?)
+            }
+            0xda => {
+                let len = self.uint(2)? as usize;
+                Value::String(self.read_str(len)?)
+            }
+            0xdb => {
+                let len = self.uint(4)? as usize;
+                Value::String(self.read_str(len)?)
+            }
+            0xdc => {
+                let len = self.uint(2)? as usize;
+                self.read_array(len, depth)?
+            }
+            0xdd => {
+                let len = self.uint(4)? as usize;
+                self.read_array(len, depth)?
+            }
+            0xde => {
+                let len = self.uint(2)? as usize;
+                self.read_map(len, depth)?
+            }
+            0xdf => {
+                let len = self.uint(4)? as usize;
+                self.read_map(len, depth)?
+            }
+            0xe0..=0xff => Value::from(format as i8),
+            // bin and ext have no JSON counterpart
+            _ => {
+                return Err(format!(
+                    "Unsupported MessagePack format {:#04x}",
+                    format
+                ));
+            }
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use serde_json::json;
+
+    fn encode(value: &Value) -> Vec<u8> {
+        let mut out = Vec::new();
+        write_value(&mut out, value);
+        out
+    }
+
+    #[test]
+    fn test_round_trip() {
+        let value = json!({
+            "event": "find_derived_blueprints",
+            "success": true,
+            "data": {
+                "counts": [0, 127, 128, 65536, 4294967296u64, -1, -33, -40000, -3000000000i64],
+                "ratio": 0.25,
+                "name": "BP_Player — ünïcode",
+                "long": "x".repeat(70000),
+                "none": null,
+            }
+        });
+        assert_eq!(decode(&encode(&value)).unwrap(), value);
+    }
+
+    #[test]
+    fn test_known_encoding() {
+        assert_eq!(
+            encode(&json!({"a": [1, -1, true]})),
+            vec![0x81, 0xa1, b'a', 0x93, 0x01, 0xff, 0xc3]
+        );
+        assert!(decode(&[0x93, 0x01]).is_err());
+        assert!(decode(&[0x01, 0x02]).is_err());
+        assert!(decode(&[0x81, 0x01, 0x01]).is_err());
+    }
+
+    #[test]
+    fn test_frames() {
+        let small = json!({"cmd": "pie_start", "requestId": "r1"});
+        let frame = encode_frame(&small, true);
+        assert_eq!(frame[0], 0);
+        assert_eq!(decode_frame(&frame).unwrap(), small);
+
+        let large = json!({"output": "graph ".repeat(4000)});
+        let frame = encode_frame(&large, true);
+        assert_eq!(frame[0], FLAG_ZLIB);
+        assert_eq!(decode_frame(&frame).unwrap(), large);
+        assert_eq!(encode_frame(&large, false)[0], 0);
+
+        assert!(decode_frame(&[]).is_err());
+        assert!(decode_frame(&[0x02, 0xc0]).is_err());
+    }
+}
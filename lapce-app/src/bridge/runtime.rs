@@ -17,6 +17,7 @@
 use tokio_tungstenite::{accept_async, tungstenite::Message};
 use uuid::Uuid;
 
+use super::msgpack;
 use super::types::*;
 
 /// Request ID for tracking pending commands
@@ -42,6 +43,8 @@ pub enum BridgeRpc {
         cmd: String,
         args: Option<serde_json::Value>,
     },
+    /// Cancel a command sent earlier; its handler fails with "Cancelled"
+    Cancel { id: RequestId },
     /// Shutdown the runtime
     Shutdown,
 }
@@ -165,7 +168,11 @@ pub async fn send_command(
                 Ok(BridgeResponse::Started { .. }) => Err("Unexpected response type".to_string()),
                 Err(e) => Err(e),
             },
-            Err(_) => Err("Command timed out".to_string()),
+            Err(_) => {
+                // Nobody waits for the result anymore, so let UE stop working on it
+                self.cancel(id);
+                Err("Command timed out".to_string())
+            }
         }
     }
 
@@ -186,13 +193,15 @@ pub fn stop(&self) {
     }
 
     /// Send a command to a specific client (async with callback)
+    ///
+    /// Returns the ID to pass to [`cancel`](Self::cancel).
     pub fn send_command_async(
         &self,
         session_id: String,
         cmd: String,
         args: Option<serde_json::Value>,
         callback: impl BridgeCallback + 'static,
-    ) {
+    ) -> RequestId {
         let id = self.id.fetch_add(1, Ordering::Relaxed);
         self.pending.lock().insert(id, ResponseHandler::Callback(Box::new(callback)));
 
@@ -202,15 +211,18 @@ pub fn send_command_async(
             cmd,
             args,
         });
+        id
     }
 
     /// Send a command to any connected client (async with callback)
+    ///
+    /// Returns the ID to pass to [`cancel`](Self::cancel).
     pub fn send_command_to_any_async(
         &self,
         cmd: String,
         args: Option<serde_json::Value>,
         callback: impl BridgeCallback + 'static,
-    ) {
+    ) -> RequestId {
         let id = self.id.fetch_add(1, Ordering::Relaxed);
         self.pending.lock().insert(id, ResponseHandler::Callback(Box::new(callback)));
 
@@ -219,6 +231,15 @@ pub fn send_command_to_any_async(
             cmd,
             args,
         });
+        id
+    }
+
+    /// Cancel a command that hasn't completed yet
+    ///
+    /// Its handler fails with "Cancelled" right away, and UE is asked to stop
+    /// working on it; whatever it still sends for the command is ignored.
+    pub fn cancel(&self, id: RequestId) {
+        let _ = self.tx.send(BridgeRpc::Cancel { id });
     }
 
     /// Convenience method: Start Play In Editor
@@ -273,13 +294,19 @@ fn default() -> Self {
 /// State of a connected client
 struct ClientState {
     info: UEClient,
-    tx: mpsc::Sender<String>,
+    tx: mpsc::Sender<Message>,
+    /// Commands are sent as binary MessagePack frames
+    binary: bool,
+    /// Large binary frames are zlib-compressed
+    compress: bool,
 }
 
 /// Pending command waiting for response
 struct PendingCommand {
     request_id: String,
     rpc_id: RequestId,
+    /// Client the command was sent to, which a cancel has to reach
+    session_id: String,
 }
 
 /// The bridge runtime that manages the WebSocket server
@@ -392,6 +419,16 @@ pub fn run(self) {
                     });
                 }
 
+                BridgeRpc::Cancel { id } => {
+                    let clients = self.clients.clone();
+                    let pending = self.pending_commands.clone();
+                    let rpc = self.rpc.clone();
+
+                    rt.block_on(async {
+                        Self::do_cancel(clients, pending, rpc, id).await;
+                    });
+                }
+
                 BridgeRpc::Shutdown => {
                     self.shutdown.store(true, Ordering::SeqCst);
                     *self.port.write() = None;
@@ -554,7 +591,11 @@ async fn handle_connection(
         let session_id = Uuid::new_v4().to_string();
 
         // Send acknowledgment
-        let ack = HandshakeAck::success(session_id.clone());
+        let accepted = handshake_msg.accepted_capabilities();
+        let binary = accepted.iter().any(|c| c == capabilities::MESSAGE_PACK);
+        let compress = accepted.iter().any(|c| c == capabilities::ZLIB);
+        let ack =
+            HandshakeAck::success(session_id.clone()).with_capabilities(accepted);
         let ack_json = serde_json::to_string(&ack).unwrap();
         write.send(Message::Text(ack_json.into()))
             .await
@@ -577,13 +618,18 @@ async fn handle_connection(
         };
 
         // Create channel for sending messages to this client
-        let (tx, mut rx) = mpsc::channel::<String>(32);
+        let (tx, mut rx) = mpsc::channel::<Message>(32);
 
         // Store client state
-        clients.write().insert(session_id.clone(), ClientState {
-            info: client.clone(),
-            tx,
-        });
+        clients.write().insert(
+            session_id.clone(),
+            ClientState {
+                info: client.clone(),
+                tx,
+                binary,
+                compress,
+            },
+        );
 
         // Notify UI
         let project_name_log = client.project_name.clone();
@@ -599,38 +645,41 @@ async fn handle_connection(
                 if shutdown_sender.load(Ordering::SeqCst) {
                     break;
                 }
-                if write.send(Message::Text(msg.into())).await.is_err() {
+                if write.send(msg).await.is_err() {
                     tracing::warn!("Failed to send message to client {}", session_id_sender);
                     break;
                 }
             }
         });
 
+        // Chunked responses being reassembled, by request ID
+        let mut chunked: HashMap<String, ChunkAssembler> = HashMap::new();
+
         // Message receive loop
         while let Some(msg_result) = read.next().await {
             if shutdown.load(Ordering::SeqCst) {
                 break;
             }
 
-            match msg_result {
+            let parsed = match msg_result {
                 Ok(Message::Text(text)) => {
-                    let text = text.to_string();
-                    // Try to parse as BridgeEvent (response)
-                    if let Ok(event) = serde_json::from_str::<BridgeEvent>(&text) {
-                        // Check if this is a response to a pending command
-                        if let Some(request_id) = &event.request_id {
-                            if let Some(pending) = pending_commands.lock().remove(request_id) {
-                                rpc.handle_response(
-                                    pending.rpc_id,
-                                    Ok(BridgeResponse::CommandCompleted(event.clone())),
-                                );
-                            }
-                        }
-
-                        // Also notify UI
-                        let _ = notification_tx.send(BridgeNotification::CommandResponse(event));
-                    }
+                    serde_json::from_str::<BridgeEvent>(&text).ok()
                 }
+                Ok(Message::Binary(frame)) => match msgpack::decode_frame(&frame)
+                    .and_then(|value| {
+                        serde_json::from_value::<BridgeEvent>(value)
+                            .map_err(|e| e.to_string())
+                    }) {
+                    Ok(event) => Some(event),
+                    Err(e) => {
+                        tracing::warn!(
+                            "Ignoring malformed binary message from {}: {}",
+                            session_id,
+                            e
+                        );
+                        None
+                    }
+                },
                 Ok(Message::Close(_)) => {
                     break;
                 }
@@ -638,13 +687,71 @@ async fn handle_connection(
                     // Pong is handled automatically by tungstenite
                     tracing::trace!("Received ping from {}", session_id);
                     let _ = data; // Silence unused warning
+                    None
                 }
                 Err(e) => {
                     tracing::error!("WebSocket error for {}: {}", session_id, e);
                     break;
                 }
-                _ => {}
+                _ => None,
+            };
+
+            let Some(mut event) = parsed else {
+                continue;
+            };
+
+            if let (None, Some(request_id)) = (event.chunk, &event.request_id) {
+                // A cancelled request answers in one piece even after sending chunks
+                chunked.remove(request_id);
+            }
+
+            if let (Some(chunk), Some(request_id)) =
+                (event.chunk, event.request_id.clone())
+            {
+                // Partial results go to the UI right away; the command completes
+                // with the reassembled response once the final chunk arrives
+                if !chunk.is_final {
+                    let _ = notification_tx
+                        .send(BridgeNotification::CommandResponse(event.clone()));
+                }
+
+                let assembled =
+                    chunked.entry(request_id.clone()).or_default().push(event);
+                match assembled {
+                    Ok(None) => continue,
+                    Ok(Some(full)) => {
+                        chunked.remove(&request_id);
+                        event = full;
+                    }
+                    Err(e) => {
+                        chunked.remove(&request_id);
+                        tracing::error!(
+                            "Dropping chunked response {}: {}",
+                            request_id,
+                            e
+                        );
+                        if let Some(pending) =
+                            pending_commands.lock().remove(&request_id)
+                        {
+                            rpc.handle_response(pending.rpc_id, Err(e));
+                        }
+                        continue;
+                    }
+                }
+            }
+
+            // Check if this is a response to a pending command
+            if let Some(request_id) = &event.request_id {
+                if let Some(pending) = pending_commands.lock().remove(request_id) {
+                    rpc.handle_response(
+                        pending.rpc_id,
+                        Ok(BridgeResponse::CommandCompleted(event.clone())),
+                    );
+                }
             }
+
+            // Also notify UI
+            let _ = notification_tx.send(BridgeNotification::CommandResponse(event));
         }
 
         // Client disconnected
@@ -675,36 +782,45 @@ async fn do_send_command(
             args,
         };
 
-        let command_json = match serde_json::to_string(&command) {
-            Ok(json) => json,
-            Err(e) => {
-                rpc.handle_response(rpc_id, Err(format!("Failed to serialize command: {}", e)));
-                return;
-            }
-        };
-
         // Find the client to send to
-        let tx = {
+        let client = {
             let clients_guard = clients.read();
 
-            if let Some(sid) = session_id {
-                clients_guard.get(&sid).map(|c| c.tx.clone())
+            let client = if let Some(sid) = session_id {
+                clients_guard.get_key_value(&sid)
             } else {
                 // Send to first available client
-                clients_guard.values().next().map(|c| c.tx.clone())
-            }
+                clients_guard.iter().next()
+            };
+            client.map(|(sid, c)| (sid.clone(), c.tx.clone(), c.binary, c.compress))
         };
 
-        match tx {
-            Some(tx) => {
+        match client {
+            Some((session_id, tx, binary, compress)) => {
+                let message = match Self::encode_command(&command, binary, compress)
+                {
+                    Ok(message) => message,
+                    Err(e) => {
+                        rpc.handle_response(
+                            rpc_id,
+                            Err(format!("Failed to serialize command: {}", e)),
+                        );
+                        return;
+                    }
+                };
+
                 // Store pending command
-                pending_commands.lock().insert(request_id.clone(), PendingCommand {
-                    request_id,
-                    rpc_id,
-                });
+                pending_commands.lock().insert(
+                    request_id.clone(),
+                    PendingCommand {
+                        request_id,
+                        rpc_id,
+                        session_id,
+                    },
+                );
 
                 // Send command
-                if let Err(e) = tx.send(command_json).await {
+                if let Err(e) = tx.send(message).await {
                     rpc.handle_response(rpc_id, Err(format!("Failed to send command: {}", e)));
                 }
                 // Response will be handled when we receive the event
@@ -714,6 +830,61 @@ async fn do_send_command(
             }
         }
     }
+
+    async fn do_cancel(
+        clients: Arc<RwLock<HashMap<String, ClientState>>>,
+        pending_commands: Arc<Mutex<HashMap<String, PendingCommand>>>,
+        rpc: BridgeRpcHandler,
+        rpc_id: RequestId,
+    ) {
+        // Only a handful of commands are ever in flight
+        let pending = {
+            let mut pending_guard = pending_commands.lock();
+            let request_id = pending_guard
+                .iter()
+                .find(|(_, pending)| pending.rpc_id == rpc_id)
+                .map(|(request_id, _)| request_id.clone());
+            request_id.and_then(|request_id| pending_guard.remove(&request_id))
+        };
+
+        // Not sent yet, or already answered
+        let Some(pending) = pending else {
+            rpc.handle_response(rpc_id, Err("Cancelled".to_string()));
+            return;
+        };
+
+        let client = clients
+            .read()
+            .get(&pending.session_id)
+            .map(|c| (c.tx.clone(), c.binary, c.compress));
+        if let Some((tx, binary, compress)) = client {
+            let command = BridgeCommand {
+                cmd: commands::CANCEL.to_string(),
+                request_id: Uuid::new_v4().to_string(),
+                args: Some(serde_json::json!({ "requestId": pending.request_id })),
+            };
+            if let Ok(message) = Self::encode_command(&command, binary, compress) {
+                let _ = tx.send(message).await;
+            }
+        }
+
+        rpc.handle_response(rpc_id, Err("Cancelled".to_string()));
+    }
+
+    /// Encode a command the way the client negotiated
+    fn encode_command(
+        command: &BridgeCommand,
+        binary: bool,
+        compress: bool,
+    ) -> Result<Message, serde_json::Error> {
+        if binary {
+            serde_json::to_value(command).map(|value| {
+                Message::Binary(msgpack::encode_frame(&value, compress).into())
+            })
+        } else {
+            serde_json::to_string(command).map(|json| Message::Text(json.into()))
+        }
+    }
 }
 
 /// Start the bridge runtime in a background thread
@@ -15,6 +15,19 @@
 /// Number of port fallback attempts (27020-27029)
 pub const WS_PORT_ATTEMPTS: u16 = 10;
 
+/// Optional protocol features, negotiated through the handshake
+pub mod capabilities {
+    /// Large responses arrive as a sequence of chunk events (see [`super::ChunkAssembler`])
+    pub const CHUNKED_RESPONSES: &str = "chunked_responses";
+    /// Messages may be sent as binary MessagePack frames (see [`super::super::msgpack`])
+    pub const MESSAGE_PACK: &str = "msgpack";
+    /// Binary frames above a size threshold may be zlib-compressed
+    pub const ZLIB: &str = "zlib";
+
+    /// Capabilities this IDE accepts
+    pub const SUPPORTED: &[&str] = &[CHUNKED_RESPONSES, MESSAGE_PACK, ZLIB];
+}
+
 /// Bridge connection status
 #[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
 pub enum BridgeStatus {
@@ -85,6 +98,9 @@ pub struct HandshakeMessage {
     pub engine_version: String,
     /// Process ID of the Unreal Editor
     pub pid: i32,
+    /// Optional features the plugin supports (see [`capabilities`])
+    #[serde(default)]
+    pub capabilities: Vec<String>,
 }
 
 impl HandshakeMessage {
@@ -92,6 +108,15 @@ impl HandshakeMessage {
     pub fn is_valid(&self) -> bool {
         self.msg_type == "handshake" && self.version == PROTOCOL_VERSION
     }
+
+    /// Capabilities supported by both the plugin and this IDE
+    pub fn accepted_capabilities(&self) -> Vec<String> {
+        self.capabilities
+            .iter()
+            .filter(|c| capabilities::SUPPORTED.contains(&c.as_str()))
+            .cloned()
+            .collect()
+    }
 }
 
 /// Handshake acknowledgment sent by IDE to UE Plugin
@@ -108,6 +133,9 @@ pub struct HandshakeAck {
     /// Error message if handshake failed
     #[serde(skip_serializing_if = "Option::is_none")]
     pub error: Option<String>,
+    /// Optional features the plugin may use on this connection
+    #[serde(default, skip_serializing_if = "Vec::is_empty")]
+    pub capabilities: Vec<String>,
 }
 
 impl HandshakeAck {
@@ -118,9 +146,16 @@ pub fn success(session_id: String) -> Self {
             session_id,
             success: true,
             error: None,
+            capabilities: Vec::new(),
         }
     }
 
+    /// Accept optional features for this connection
+    pub fn with_capabilities(mut self, capabilities: Vec<String>) -> Self {
+        self.capabilities = capabilities;
+        self
+    }
+
     /// Create a failed handshake acknowledgment
     pub fn failure(error: impl Into<String>) -> Self {
         Self {
@@ -128,6 +163,7 @@ pub fn failure(error: impl Into<String>) -> Self {
             session_id: String::new(),
             success: false,
             error: Some(error.into()),
+            capabilities: Vec::new(),
         }
     }
 }
@@ -162,6 +198,77 @@ pub struct BridgeEvent {
     /// Event data payload
     #[serde(skip_serializing_if = "Option::is_none")]
     pub data: Option<serde_json::Value>,
+    /// Position in a chunked response; absent for responses sent in one event
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub chunk: Option<ChunkInfo>,
+}
+
+/// Chunk marker of a response streamed as several events under one request ID
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Serialize, Deserialize)]
+pub struct ChunkInfo {
+    /// Sequence number, starting at 0
+    pub seq: u32,
+    /// Whether this is the last event of the response
+    #[serde(rename = "final")]
+    pub is_final: bool,
+}
+
+/// Reassembles a chunked response
+///
+/// Partial events carry a slice of one array or string field of `data`; the final
+/// event carries the last slice plus every other field. Slices are concatenated in
+/// sequence order.
+#[derive(Debug, Default)]
+pub struct ChunkAssembler {
+    next_seq: u32,
+    data: serde_json::Map<String, serde_json::Value>,
+}
+
+impl ChunkAssembler {
+    /// Add the next chunk; returns the full response once the final chunk arrives
+    pub fn push(
+        &mut self,
+        event: BridgeEvent,
+    ) -> Result<Option<BridgeEvent>, String> {
+        let chunk = event
+            .chunk
+            .ok_or("Event is not part of a chunked response")?;
+        if chunk.seq != self.next_seq {
+            return Err(format!(
+                "Chunk {} arrived out of order, expected {}",
+                chunk.seq, self.next_seq
+            ));
+        }
+        self.next_seq += 1;
+
+        if let Some(serde_json::Value::Object(fields)) = event.data {
+            for (key, value) in fields {
+                match (self.data.get_mut(&key), value) {
+                    (
+                        Some(serde_json::Value::Array(items)),
+                        serde_json::Value::Array(more),
+                    ) => items.extend(more),
+                    (
+                        Some(serde_json::Value::String(text)),
+                        serde_json::Value::String(more),
+                    ) => text.push_str(&more),
+                    (_, value) => {
+                        self.data.insert(key, value);
+                    }
+                }
+            }
+        }
+
+        if !chunk.is_final {
+            return Ok(None);
+        }
+
+        Ok(Some(BridgeEvent {
+            data: Some(serde_json::Value::Object(std::mem::take(&mut self.data))),
+            chunk: None,
+            ..event
+        }))
+    }
 }
 
 /// Plugin version information from .uplugin file
@@ -225,8 +332,19 @@ pub mod commands {
     pub const STOP_STREAMING: &str = "stop_streaming";
     /// Execute a tool in UE
     pub const EXECUTE_TOOL: &str = "execute_tool";
+    /// Start a new agent turn; the next edit replaces UE's turn checkpoint
+    pub const BEGIN_TURN: &str = "begin_turn";
     /// Open an asset in the editor
     pub const OPEN_ASSET: &str = "OpenAsset";
+    /// Stop the request named by `args.requestId`; it answers with an error and
+    /// `data.cancelled`, the cancel itself gets no response
+    pub const CANCEL: &str = "cancel";
+    /// Push editor events (`log_message`, `compile_started`, `compile_finished`,
+    /// `asset_created`, `asset_modified`) filtered by `events`, `paths`, `classes`
+    /// and `minVerbosity`; answers `data.subscriptionId`
+    pub const SUBSCRIBE_EVENTS: &str = "subscribe_events";
+    /// Stop the events of `args.subscriptionId`
+    pub const UNSUBSCRIBE_EVENTS: &str = "unsubscribe_events";
 }
 
 #[cfg(test)]
@@ -243,7 +361,15 @@ fn test_handshake_validation() {
             project_name: "TestProject".to_string(),
             engine_version: "5.4.0".to_string(),
             pid: 1234,
+            capabilities: vec![
+                capabilities::CHUNKED_RESPONSES.to_string(),
+                "unknown".to_string(),
+            ],
         };
+        assert_eq!(
+            valid.accepted_capabilities(),
+            vec![capabilities::CHUNKED_RESPONSES.to_string()]
+        );
         assert!(valid.is_valid());
 
         let invalid_type = HandshakeMessage {
@@ -269,4 +395,42 @@ fn test_handshake_ack() {
         assert!(!failure.success);
         assert_eq!(failure.error, Some("Version mismatch".to_string()));
     }
+
+    #[test]
+    fn test_chunk_assembly() {
+        let chunk = |json: &str| serde_json::from_str::<BridgeEvent>(json).unwrap();
+        let mut assembler = ChunkAssembler::default();
+
+        let first = chunk(
+            r#"{"event":"find_derived_blueprints","success":true,"requestId":"r1","chunk":{"seq":0,"final":false},"data":{"blueprints":[1,2]}}"#,
+        );
+        assert!(assembler.push(first).unwrap().is_none());
+
+        let out_of_order = chunk(
+            r#"{"event":"find_derived_blueprints","success":true,"requestId":"r1","chunk":{"seq":2,"final":true},"data":{}}"#,
+        );
+        assert!(assembler.push(out_of_order).is_err());
+
+        let last = chunk(
+            r#"{"event":"find_derived_blueprints","success":true,"requestId":"r1","chunk":{"seq":1,"final":true},"data":{"count":3,"blueprints":[3]}}"#,
+        );
+        let full = assembler.push(last).unwrap().unwrap();
+        assert!(full.chunk.is_none());
+        assert_eq!(full.request_id.as_deref(), Some("r1"));
+        assert_eq!(
+            full.data.unwrap(),
+            serde_json::json!({"blueprints": [1, 2, 3], "count": 3})
+        );
+
+        let mut text = ChunkAssembler::default();
+        assert!(text
+            .push(chunk(r#"{"event":"execute_tool","success":true,"chunk":{"seq":0,"final":false},"data":{"output":"ab"}}"#))
+            .unwrap()
+            .is_none());
+        let full = text
+            .push(chunk(r#"{"event":"execute_tool","success":true,"chunk":{"seq":1,"final":true},"data":{"output":"c"}}"#))
+            .unwrap()
+            .unwrap();
+        assert_eq!(full.data.unwrap(), serde_json::json!({"output": "abc"}));
+    }
 }
@@ -13,7 +13,7 @@
 use super::executor::execute_tool;
 use super::tools::get_all_tools;
 use super::types::*;
-use crate::bridge::BridgeRpcHandler;
+use crate::bridge::{commands, BridgeRpcHandler};
 
 /// Global MCP HTTP server port
 static MCP_HTTP_PORT: AtomicU16 = AtomicU16::new(0);
@@ -187,6 +187,7 @@ async fn handle_mcp_request(
         "initialize" => handle_initialize(id),
         "tools/list" => handle_tools_list(id),
         "tools/call" => handle_tools_call(id, request.params, bridge, notification_tx).await,
+        "neostack/beginTurn" => handle_begin_turn(id, bridge).await,
         "ping" => JsonRpcResponse::success(id, json!({ "pong": true })),
         _ => JsonRpcResponse::error(
             id,
@@ -220,6 +221,18 @@ fn handle_tools_list(id: JsonRpcId) -> JsonRpcResponse {
     JsonRpcResponse::success(id, json!({ "tools": tools }))
 }
 
+/// Mark the start of an agent turn so UE's turn checkpoint covers only this turn's edits
+async fn handle_begin_turn(id: JsonRpcId, bridge: &BridgeRpcHandler) -> JsonRpcResponse {
+    if !bridge.is_connected() {
+        return JsonRpcResponse::success(id, json!({ "connected": false }));
+    }
+
+    match bridge.send_command(None, commands::BEGIN_TURN, None).await {
+        Ok(_) => JsonRpcResponse::success(id, json!({ "connected": true })),
+        Err(e) => JsonRpcResponse::error(id, INTERNAL_ERROR, e),
+    }
+}
+
 async fn handle_tools_call(
     id: JsonRpcId,
     params: Option<Value>,
@@ -266,7 +279,12 @@ async fn handle_tools_call(
     tracing::info!("[MCP] execute_tool returned: {:?}", result.is_ok());
 
     match result {
-        Ok(tool_result) => {
+        Ok(mut tool_result) => {
+            let images = if tool_result.success {
+                take_images(&mut tool_result.result)
+            } else {
+                Vec::new()
+            };
             let content = if tool_result.success {
                 serde_json::to_string_pretty(&tool_result.result).unwrap_or_default()
             } else {
@@ -274,11 +292,10 @@ async fn handle_tools_call(
             };
             tracing::info!("[MCP] Tool result - success: {}, content: {}", tool_result.success, &content[..content.len().min(100)]);
 
+            let mut content = vec![ToolContent::text(content)];
+            content.extend(images);
             let call_result = ToolCallResult {
-                content: vec![ToolContent {
-                    content_type: "text".to_string(),
-                    text: content,
-                }],
+                content,
                 is_error: if tool_result.success { None } else { Some(true) },
             };
 
@@ -287,10 +304,7 @@ async fn handle_tools_call(
         Err(e) => {
             tracing::error!("[MCP] Tool execution error: {}", e);
             let call_result = ToolCallResult {
-                content: vec![ToolContent {
-                    content_type: "text".to_string(),
-                    text: e,
-                }],
+                content: vec![ToolContent::text(e)],
                 is_error: Some(true),
             };
 
@@ -299,6 +313,24 @@ async fn handle_tools_call(
     }
 }
 
+/// Move the images a tool attached (`images` in its result) into MCP image content,
+/// so the agent sees them instead of reading base64 as text
+fn take_images(result: &mut Value) -> Vec<ToolContent> {
+    let Some(images) = result.as_object_mut().and_then(|data| data.remove("images")) else {
+        return Vec::new();
+    };
+    images
+        .as_array()
+        .into_iter()
+        .flatten()
+        .filter_map(|image| {
+            let data = image.get("data")?.as_str()?;
+            let mime_type = image.get("mimeType").and_then(Value::as_str).unwrap_or("image/png");
+            Some(ToolContent::image(data, mime_type))
+        })
+        .collect()
+}
+
 /// Send a plain text HTTP response
 async fn send_text_response(
     writer: &mut tokio::net::tcp::WriteHalf<'_>,
@@ -66,9 +66,17 @@ pub fn get_all_tools() -> Vec<McpTool> {
                     "row_struct": {
                         "type": "string",
                         "description": "For DataTable: name or path of the row struct."
+                    },
+                    "assets": {
+                        "type": "array",
+                        "items": { "type": "object" },
+                        "description": "Create several assets in one call. Each item takes the parameters above (name, parent, path, fields, values, row_struct, content). Created in dependency order: enums, structs, DataTables, then Blueprints and other assets."
+                    },
+                    "save": {
+                        "type": "boolean",
+                        "description": "Save the new packages after creating them. Default: false."
                     }
-                },
-                "required": ["name", "parent"]
+                }
             }),
         },
         McpTool {
@@ -84,11 +92,46 @@ pub fn get_all_tools() -> Vec<McpTool> {
                     "include": {
                         "type": "array",
                         "items": { "type": "string" },
-                        "description": "What to include: 'summary', 'components', 'variables', 'functions', 'graphs', 'interfaces'. Default: ['summary']."
+                        "description": "What to include: 'summary', 'components', 'variables', 'functions', 'graphs', 'interfaces', 'rows' (DataTables). Default: ['summary']."
                     },
                     "graph": {
                         "type": "string",
                         "description": "Specific graph to read nodes from (e.g., 'EventGraph')."
+                    },
+                    "compact": {
+                        "type": "boolean",
+                        "description": "Write graphs compactly: nodes as '@N' aliases (usable as node references in edit_graph) and pins as indices into a PINS table. Default: false."
+                    },
+                    "since": {
+                        "type": "array",
+                        "items": { "type": "string" },
+                        "description": "Version tokens from earlier graph reads (the 'version=' in each GRAPH header). Graphs with a matching token return only the nodes (+ added, - removed, ~ changed) and connections that changed since then."
+                    },
+                    "offset": {
+                        "type": "integer",
+                        "description": "1-based index of the first item (DataTable rows, graph nodes, variables, widget and behavior tree nodes). Default: 1."
+                    },
+                    "limit": {
+                        "type": "integer",
+                        "description": "Maximum items to return (1-1000). Default: 100."
+                    },
+                    "root": {
+                        "type": "string",
+                        "description": "Widget and behavior trees (include 'tree'): start at this widget name or behavior tree node path ('/1/0' child indices or '/Combat/Attack' node names, as printed after each composite)."
+                    },
+                    "depth": {
+                        "type": "integer",
+                        "description": "Widget and behavior trees: levels below the start node to list. Nodes with hidden children show '[+N children]'. Default: all."
+                    },
+                    "columns": {
+                        "type": "array",
+                        "items": { "type": "string" },
+                        "description": "DataTables: only output these columns, in this order. Implies include 'rows'."
+                    },
+                    "where": {
+                        "type": "array",
+                        "items": { "type": "string" },
+                        "description": "DataTables: row filters 'column op value', all of which must match. Ops: = != < <= > >= ~ (contains). offset/limit page through the matching rows. Implies include 'rows'."
                     }
                 },
                 "required": ["name"]
@@ -186,6 +229,20 @@ pub fn get_all_tools() -> Vec<McpTool> {
                             "required": ["type", "name"]
                         }
                     },
+                    "widget_tree": {
+                        "type": "object",
+                        "description": "Build a whole widget subtree in one call (Widget Blueprints only). The designer refreshes once at the end. Also accepts an array of subtrees.",
+                        "properties": {
+                            "type": { "type": "string" },
+                            "name": { "type": "string" },
+                            "parent": { "type": "string", "description": "Existing panel to add under (top level only). Default: root." },
+                            "slot": { "type": "object", "description": "Slot settings, same keys as configure_asset's slot." },
+                            "properties": { "type": "object", "description": "Property name -> value, e.g. {\"Text\": \"Play\"}." },
+                            "events": { "type": "array", "items": { "type": "string" }, "description": "Delegates to bind, e.g. ['OnClicked']." },
+                            "children": { "type": "array", "items": { "type": "object" }, "description": "Child widgets, same shape as widget_tree." }
+                        },
+                        "required": ["type"]
+                    },
                     "remove_widgets": {
                         "type": "array",
                         "items": { "type": "string" }
@@ -224,6 +281,47 @@ pub fn get_all_tools() -> Vec<McpTool> {
                             "required": ["state_machine", "from_state", "to_state"]
                         }
                     },
+                    "state_machines": {
+                        "type": "array",
+                        "description": "Build whole state machines in one pass (Animation Blueprints only). An existing machine with the same name is extended.",
+                        "items": {
+                            "type": "object",
+                            "properties": {
+                                "name": { "type": "string" },
+                                "entry": { "type": "string", "description": "Initial state. Default: first new state if the entry is unlinked." },
+                                "connect_output": { "type": "boolean", "description": "Connect the machine to the AnimGraph output pose." },
+                                "states": {
+                                    "type": "array",
+                                    "items": {
+                                        "type": "object",
+                                        "properties": {
+                                            "name": { "type": "string" },
+                                            "animation": { "type": "string", "description": "Sequence to play, e.g. '/Game/Anims/Idle'." }
+                                        },
+                                        "required": ["name"]
+                                    }
+                                },
+                                "transitions": {
+                                    "type": "array",
+                                    "items": {
+                                        "type": "object",
+                                        "properties": {
+                                            "from": { "type": "string" },
+                                            "to": { "type": "string" },
+                                            "rule": { "type": "string", "description": "Boolean variable, '!Var' to negate, or 'auto' to leave when the sequence ends." },
+                                            "blend_time": { "type": "number" },
+                                            "blend_mode": { "type": "string", "description": "Linear, Cubic, HermiteCubic, Sinusoidal, ..." },
+                                            "blend_logic": { "type": "string", "enum": ["Standard", "Inertialization", "Custom"] },
+                                            "priority": { "type": "integer" },
+                                            "bidirectional": { "type": "boolean" }
+                                        },
+                                        "required": ["from", "to"]
+                                    }
+                                }
+                            },
+                            "required": ["name"]
+                        }
+                    },
                     "bind_event": {
                         "type": "object",
                         "properties": {
@@ -232,6 +330,14 @@ pub fn get_all_tools() -> Vec<McpTool> {
                             "handler": { "type": "string" }
                         },
                         "required": ["source", "event", "handler"]
+                    },
+                    "batch": {
+                        "type": "boolean",
+                        "description": "Apply all variable, component, function and widget changes before a single Blueprint refresh. Default: true."
+                    },
+                    "compile": {
+                        "type": "boolean",
+                        "description": "Compile after the edits and report errors under the items they mention. Edits to the same Blueprint made in parallel calls share one compile. Default: false."
                     }
                 },
                 "required": ["name"]
@@ -332,6 +438,14 @@ pub fn get_all_tools() -> Vec<McpTool> {
                             },
                             "required": ["node", "values"]
                         }
+                    },
+                    "batch": {
+                        "type": "boolean",
+                        "description": "Apply the whole call as one undo step with a single refresh and recompile at the end. On Materials, a single shader compile is started after all edits and the call waits for it to finish. Use when adding many nodes at once. Default: false."
+                    },
+                    "auto_layout": {
+                        "type": "boolean",
+                        "description": "Arrange the added nodes in columns following their connections instead of one row. Default: false."
                     }
                 },
                 "required": ["asset"]
@@ -345,7 +459,12 @@ pub fn get_all_tools() -> Vec<McpTool> {
                 "properties": {
                     "name": {
                         "type": "string",
-                        "description": "Asset name (e.g., 'M_BaseMaterial', 'BP_Enemy', 'WBP_MainMenu')."
+                        "description": "Asset name (e.g., 'M_BaseMaterial', 'BP_Enemy', 'WBP_MainMenu'). Wildcards configure every match: 'BP_Enemy*' or '/Game/AI/*' (* also matches subfolders)."
+                    },
+                    "assets": {
+                        "type": "array",
+                        "items": { "type": "string" },
+                        "description": "Several assets to run the same operations on, instead of 'name'. Changes to all of them are one undo step; results are reported per asset."
                     },
                     "path": {
                         "type": "string",
@@ -362,7 +481,7 @@ pub fn get_all_tools() -> Vec<McpTool> {
                     "get": {
                         "type": "array",
                         "items": { "type": "string" },
-                        "description": "Property names to read values from."
+                        "description": "Property names to read values from. Nested paths work: 'BodyInstance.CollisionProfileName', 'Points[2].X'."
                     },
                     "changes": {
                         "type": "array",
@@ -370,14 +489,13 @@ pub fn get_all_tools() -> Vec<McpTool> {
                         "items": {
                             "type": "object",
                             "properties": {
-                                "property": { "type": "string", "description": "Property name." },
+                                "property": { "type": "string", "description": "Property name or path ('Settings.Color', 'Items[0]')." },
                                 "value": { "type": "string", "description": "New value (use UE format: 'BLEND_Translucent', 'True', '(X=1,Y=2,Z=3)')." }
                             },
                             "required": ["property", "value"]
                         }
                     }
-                },
-                "required": ["name"]
+                }
             }),
         },
         McpTool {
@@ -412,6 +530,33 @@ pub fn get_all_tools() -> Vec<McpTool> {
                             "required": ["type"]
                         }
                     },
+                    "add_subtree": {
+                        "type": "array",
+                        "description": "Nested subtrees to build in one pass: each node may carry decorators, services (composites only) and children. Processed after add_composite, before add_task.",
+                        "items": {
+                            "type": "object",
+                            "properties": {
+                                "type": { "type": "string", "description": "Composite (Selector, Sequence, ...) or task class (MoveTo, Wait, ...)." },
+                                "name": { "type": "string" },
+                                "parent": { "type": "string", "description": "Parent composite for the subtree root (empty = tree root, only if the tree has none)." },
+                                "index": { "type": "integer", "description": "Child index (-1 = append)." },
+                                "decorators": {
+                                    "type": "array",
+                                    "items": { "type": "object", "properties": { "type": { "type": "string" }, "name": { "type": "string" } }, "required": ["type"] }
+                                },
+                                "services": {
+                                    "type": "array",
+                                    "items": { "type": "object", "properties": { "type": { "type": "string" }, "name": { "type": "string" } }, "required": ["type"] }
+                                },
+                                "children": {
+                                    "type": "array",
+                                    "description": "Child nodes with the same shape (without parent/index).",
+                                    "items": { "type": "object" }
+                                }
+                            },
+                            "required": ["type"]
+                        }
+                    },
                     "add_task": {
                         "type": "array",
                         "description": "Task nodes to add.",
@@ -455,7 +600,7 @@ pub fn get_all_tools() -> Vec<McpTool> {
                     "remove_node": {
                         "type": "array",
                         "items": { "type": "string" },
-                        "description": "Node names to remove."
+                        "description": "Node names to remove. Removing a composite removes its subtree; decorators on the removed edge go with it."
                     },
                     "add_key": {
                         "type": "array",
@@ -586,11 +731,88 @@ pub fn get_all_tools() -> Vec<McpTool> {
                             },
                             "required": ["row_name", "values"]
                         }
+                    },
+                    "import_rows": {
+                        "type": "object",
+                        "description": "Bulk import DataTable rows from a file (project-relative or absolute). CSV uses the engine layout ('---' name column, one column per field); JSON lines hold one object per row with a 'Name' key.",
+                        "properties": {
+                            "file": { "type": "string" },
+                            "format": { "type": "string", "description": "csv, json or jsonl. Default: from the file extension." },
+                            "mode": { "type": "string", "description": "append (default; rows with existing names are overwritten) or replace." }
+                        },
+                        "required": ["file"]
+                    },
+                    "export_rows": {
+                        "type": "object",
+                        "description": "Write all DataTable rows to a file.",
+                        "properties": {
+                            "file": { "type": "string" },
+                            "format": { "type": "string", "description": "csv or jsonl. Default: from the file extension." }
+                        },
+                        "required": ["file"]
                     }
                 },
                 "required": ["name"]
             }),
         },
+        McpTool {
+            name: "capture_viewport".to_string(),
+            description: "Capture the level viewport or a graph editor panel as an image you can see. Use it to check layouts, graphs and what PIE shows.".to_string(),
+            input_schema: json!({
+                "type": "object",
+                "properties": {
+                    "target": {
+                        "type": "string",
+                        "description": "viewport (default) or graph."
+                    },
+                    "name": {
+                        "type": "string",
+                        "description": "Asset whose graph editor to capture (opened if needed). Implies target graph; without it the focused graph editor is captured."
+                    },
+                    "path": {
+                        "type": "string",
+                        "description": "Asset path. Default: /Game."
+                    },
+                    "graph": {
+                        "type": "string",
+                        "description": "Graph of the asset to show (e.g., 'EventGraph'). Default: the graph already open."
+                    },
+                    "max_edge": {
+                        "type": "integer",
+                        "description": "Longest edge of the image in pixels. Default: the Max Image Edge setting."
+                    }
+                }
+            }),
+        },
+        McpTool {
+            name: "read_log".to_string(),
+            description: "Read recent editor log lines (compile errors, PIE output, warnings) from memory, without opening Saved/Logs. Each call returns a cursor; pass it as 'since' to get only the lines logged after it.".to_string(),
+            input_schema: json!({
+                "type": "object",
+                "properties": {
+                    "category": {
+                        "type": "string",
+                        "description": "Log categories to include, comma-separated (e.g., 'LogBlueprint,LogScript'). Default: all."
+                    },
+                    "verbosity": {
+                        "type": "string",
+                        "description": "Least severe level to include: fatal, error, warning, display, log (default), verbose, veryverbose or all."
+                    },
+                    "regex": {
+                        "type": "string",
+                        "description": "Case-insensitive regular expression the message must contain a match for."
+                    },
+                    "since": {
+                        "type": "integer",
+                        "description": "Cursor from a previous read_log; lists matching lines after it, oldest first. Default: the last 'limit' matching lines."
+                    },
+                    "limit": {
+                        "type": "integer",
+                        "description": "Maximum lines to return. Default: 200, max 2000."
+                    }
+                }
+            }),
+        },
     ]
 }
 
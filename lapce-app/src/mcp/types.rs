@@ -138,7 +138,33 @@ pub struct ToolCallResult {
 pub struct ToolContent {
     #[serde(rename = "type")]
     pub content_type: String,
-    pub text: String,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub text: Option<String>,
+    /// Base64 image bytes, for "image" content
+    #[serde(skip_serializing_if = "Option::is_none")]
+    pub data: Option<String>,
+    #[serde(rename = "mimeType", skip_serializing_if = "Option::is_none")]
+    pub mime_type: Option<String>,
+}
+
+impl ToolContent {
+    pub fn text(text: impl Into<String>) -> Self {
+        Self {
+            content_type: "text".to_string(),
+            text: Some(text.into()),
+            data: None,
+            mime_type: None,
+        }
+    }
+
+    pub fn image(data: impl Into<String>, mime_type: impl Into<String>) -> Self {
+        Self {
+            content_type: "image".to_string(),
+            text: None,
+            data: Some(data.into()),
+            mime_type: Some(mime_type.into()),
+        }
+    }
 }
 
 // =============================================================================